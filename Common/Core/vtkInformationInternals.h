@@ -7,6 +7,13 @@
  * vtkInformationInternals is used in internal implementation of
  * vtkInformation. This should only be accessed by friends
  * and sub-classes of that class.
+ *
+ * The entries are stored in a flat open addressing table indexed by the key
+ * address, with linear probing. The pipeline looks up keys in many small
+ * information objects on every request, for which a single array avoids the
+ * per-entry allocations and the bucket indirection of a node based map.
+ * Removed entries are marked as deleted rather than moved, so that removing
+ * an entry does not invalidate the iterators on the other entries.
  */
 
 #ifndef vtkInformationInternals_h
@@ -16,12 +23,8 @@
 #include "vtkObjectBase.h"
 
 #include <cstdint>
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-#include <unordered_map>
-#else
-#include <map>
-#endif
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -30,26 +33,153 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+
+  class MapType
   {
-    size_t operator()(KeyType key) const
+  public:
+    typedef std::pair<KeyType, DataType> value_type;
+
+    class iterator
+    {
+    public:
+      iterator() = default;
+      iterator(value_type* slot, value_type* end)
+        : Slot(slot)
+        , End(end)
+      {
+        this->SkipFreeSlots();
+      }
+
+      value_type& operator*() const { return *this->Slot; }
+      value_type* operator->() const { return this->Slot; }
+      iterator& operator++()
+      {
+        ++this->Slot;
+        this->SkipFreeSlots();
+        return *this;
+      }
+      bool operator==(const iterator& other) const { return this->Slot == other.Slot; }
+      bool operator!=(const iterator& other) const { return this->Slot != other.Slot; }
+
+    private:
+      void SkipFreeSlots()
+      {
+        while (this->Slot != this->End && !MapType::IsUsed(this->Slot->first))
+        {
+          ++this->Slot;
+        }
+      }
+
+      value_type* Slot = nullptr;
+      value_type* End = nullptr;
+    };
+    typedef iterator const_iterator;
+
+    iterator begin() { return this->MakeIterator(0); }
+    iterator end() { return this->MakeIterator(this->Slots.size()); }
+
+    iterator find(KeyType key)
+    {
+      if (this->Slots.empty())
+      {
+        return this->end();
+      }
+      size_t mask = this->Slots.size() - 1;
+      for (size_t i = MapType::Hash(key) & mask; this->Slots[i].first; i = (i + 1) & mask)
+      {
+        if (this->Slots[i].first == key)
+        {
+          return this->MakeIterator(i);
+        }
+      }
+      return this->end();
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry)
+    {
+      iterator found = this->find(entry.first);
+      if (found != this->end())
+      {
+        return std::make_pair(found, false);
+      }
+      // Keep at least one quarter of the slots free so that probing stays short.
+      if (4 * (this->Size + this->Deleted + 1) > 3 * this->Slots.size())
+      {
+        this->Rehash();
+      }
+      size_t mask = this->Slots.size() - 1;
+      size_t i = MapType::Hash(entry.first) & mask;
+      while (MapType::IsUsed(this->Slots[i].first))
+      {
+        i = (i + 1) & mask;
+      }
+      if (this->Slots[i].first)
+      {
+        --this->Deleted;
+      }
+      this->Slots[i] = entry;
+      ++this->Size;
+      return std::make_pair(this->MakeIterator(i), true);
+    }
+
+    void erase(iterator pos)
     {
-      return reinterpret_cast<uintptr_t>(key) / sizeof(vtkInformationKey);
+      pos->first = MapType::DeletedKey();
+      pos->second = nullptr;
+      --this->Size;
+      ++this->Deleted;
     }
+
+  private:
+    static KeyType DeletedKey() { return reinterpret_cast<KeyType>(std::uintptr_t(1)); }
+    static bool IsUsed(KeyType key) { return key && key != MapType::DeletedKey(); }
+    static size_t Hash(KeyType key)
+    {
+      // Keys are allocated objects, spread their addresses with a Fibonacci hash.
+      std::uint64_t h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+      return static_cast<size_t>((h * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    iterator MakeIterator(size_t i)
+    {
+      value_type* slots = this->Slots.data();
+      return iterator(slots + i, slots + this->Slots.size());
+    }
+
+    void Rehash()
+    {
+      size_t capacity = 16;
+      while (2 * (this->Size + 1) > capacity)
+      {
+        capacity *= 2;
+      }
+      std::vector<value_type> slots(capacity, value_type(nullptr, nullptr));
+      this->Slots.swap(slots);
+      this->Size = 0;
+      this->Deleted = 0;
+      size_t mask = capacity - 1;
+      for (const value_type& entry : slots)
+      {
+        if (MapType::IsUsed(entry.first))
+        {
+          size_t i = MapType::Hash(entry.first) & mask;
+          while (this->Slots[i].first)
+          {
+            i = (i + 1) & mask;
+          }
+          this->Slots[i] = entry;
+          ++this->Size;
+        }
+      }
+    }
+
+    std::vector<value_type> Slots;
+    size_t Size = 0;
+    size_t Deleted = 0;
   };
-  typedef std::unordered_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef std::map<KeyType, DataType> MapType;
-#endif
   MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals()
-    : Map(33)
-  {
-  }
-#endif
+  vtkInformationInternals() = default;
 
   ~vtkInformationInternals()
   {
@@ -62,14 +192,10 @@ public:
     }
   }
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
 private:
   vtkInformationInternals(vtkInformationInternals const&) = delete;
-#endif
 };
 
-#undef VTK_INFORMATION_USE_HASH_MAP
-
 VTK_ABI_NAMESPACE_END
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
@@ -19,7 +19,10 @@
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkBezierInterpolation);
 
-vtkBezierInterpolation::vtkBezierInterpolation() = default;
+vtkBezierInterpolation::vtkBezierInterpolation()
+  : Triangle(vtkSmartPointer<vtkBezierTriangle>::New())
+{
+}
 
 vtkBezierInterpolation::~vtkBezierInterpolation() = default;
 
@@ -335,33 +338,43 @@ void vtkBezierInterpolation::Tensor3EvaluateDerivative(const int order[3], const
 void vtkBezierInterpolation::WedgeShapeFunctions(
   const int order[3], vtkIdType numberOfPoints, const double pcoords[3], double* shape)
 {
-  static vtkNew<vtkBezierTriangle> tri;
+  static thread_local vtkNew<vtkBezierTriangle> tri;
+  vtkBezierInterpolation::WedgeShapeFunctions(order, numberOfPoints, pcoords, shape, *tri);
+}
+
+void vtkBezierInterpolation::WedgeShapeFunctions(const int order[3], vtkIdType numberOfPoints,
+  const double pcoords[3], double* shape, vtkBezierTriangle& tri)
+{
   vtkHigherOrderInterpolation::WedgeShapeFunctions(
-    order, numberOfPoints, pcoords, shape, *tri, vtkBezierInterpolation::EvaluateShapeFunctions);
+    order, numberOfPoints, pcoords, shape, tri, vtkBezierInterpolation::EvaluateShapeFunctions);
 }
 
 /// Wedge shape-function derivative evaluation
 void vtkBezierInterpolation::WedgeShapeDerivatives(
   const int order[3], vtkIdType numberOfPoints, const double pcoords[3], double* derivs)
 {
-  static vtkNew<vtkBezierTriangle> tri;
+  static thread_local vtkNew<vtkBezierTriangle> tri;
+  vtkBezierInterpolation::WedgeShapeDerivatives(order, numberOfPoints, pcoords, derivs, *tri);
+}
+
+void vtkBezierInterpolation::WedgeShapeDerivatives(const int order[3], vtkIdType numberOfPoints,
+  const double pcoords[3], double* derivs, vtkBezierTriangle& tri)
+{
   vtkHigherOrderInterpolation::WedgeShapeDerivatives(
-    order, numberOfPoints, pcoords, derivs, *tri, vtkBezierInterpolation::EvaluateShapeAndGradient);
+    order, numberOfPoints, pcoords, derivs, tri, vtkBezierInterpolation::EvaluateShapeAndGradient);
 }
 
 void vtkBezierInterpolation::WedgeEvaluate(const int order[3], vtkIdType numberOfPoints,
   const double* pcoords, double* fieldVals, int fieldDim, double* fieldAtPCoords)
 {
-  static vtkNew<vtkBezierTriangle> tri;
   this->vtkHigherOrderInterpolation::WedgeEvaluate(order, numberOfPoints, pcoords, fieldVals,
-    fieldDim, fieldAtPCoords, *tri, vtkBezierInterpolation::EvaluateShapeFunctions);
+    fieldDim, fieldAtPCoords, *this->Triangle, vtkBezierInterpolation::EvaluateShapeFunctions);
 }
 
 void vtkBezierInterpolation::WedgeEvaluateDerivative(const int order[3], const double* pcoords,
   vtkPoints* points, const double* fieldVals, int fieldDim, double* fieldDerivs)
 {
-  static vtkNew<vtkBezierTriangle> tri;
   this->vtkHigherOrderInterpolation::WedgeEvaluateDerivative(order, pcoords, points, fieldVals,
-    fieldDim, fieldDerivs, *tri, vtkBezierInterpolation::EvaluateShapeAndGradient);
+    fieldDim, fieldDerivs, *this->Triangle, vtkBezierInterpolation::EvaluateShapeAndGradient);
 }
 VTK_ABI_NAMESPACE_END
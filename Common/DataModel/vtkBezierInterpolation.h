@@ -17,6 +17,7 @@
 #define VTK_21_POINT_WEDGE true
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkBezierTriangle;
 class vtkPoints;
 class vtkVector2i;
 class vtkVector3d;
@@ -57,10 +58,16 @@ public:
   void Tensor3EvaluateDerivative(const int order[3], const double* pcoords, vtkPoints* points,
     const double* fieldVals, int fieldDim, double* fieldDerivs) override;
 
+  // The wedge shape functions evaluate their triangular factor with a scratch
+  // triangle. Callers may pass their own; otherwise a thread-local one is used.
   static void WedgeShapeFunctions(
     const int order[3], vtkIdType numberOfPoints, const double* pcoords, double* shape);
+  static void WedgeShapeFunctions(const int order[3], vtkIdType numberOfPoints,
+    const double* pcoords, double* shape, vtkBezierTriangle& tri);
   static void WedgeShapeDerivatives(
     const int order[3], vtkIdType numberOfPoints, const double* pcoords, double* derivs);
+  static void WedgeShapeDerivatives(const int order[3], vtkIdType numberOfPoints,
+    const double* pcoords, double* derivs, vtkBezierTriangle& tri);
 
   void WedgeEvaluate(const int order[3], vtkIdType numberOfPoints, const double* pcoords,
     double* fieldVals, int fieldDim, double* fieldAtPCoords) override;
@@ -73,6 +80,8 @@ protected:
   ~vtkBezierInterpolation() override;
 
 private:
+  vtkSmartPointer<vtkBezierTriangle> Triangle; // Scratch space for the wedge evaluations.
+
   vtkBezierInterpolation(const vtkBezierInterpolation&) = delete;
   void operator=(const vtkBezierInterpolation&) = delete;
 };
@@ -145,7 +145,7 @@ vtkCell* vtkBezierWedge::GetFace(int faceId)
 void vtkBezierWedge::InterpolateFunctions(const double pcoords[3], double* weights)
 {
   vtkBezierInterpolation::WedgeShapeFunctions(
-    this->GetOrder(), this->GetOrder()[3], pcoords, weights);
+    this->GetOrder(), this->GetOrder()[3], pcoords, weights, *this->ShapeTri);
 
   // If the unit cell has rational weights: weights_i = weights_i * rationalWeights / sum( weights_i
   // * rationalWeights )
@@ -168,7 +168,7 @@ void vtkBezierWedge::InterpolateFunctions(const double pcoords[3], double* weigh
 void vtkBezierWedge::InterpolateDerivs(const double pcoords[3], double* derivs)
 {
   vtkBezierInterpolation::WedgeShapeDerivatives(
-    this->GetOrder(), this->GetOrder()[3], pcoords, derivs);
+    this->GetOrder(), this->GetOrder()[3], pcoords, derivs, *this->ShapeTri);
 }
 
 /**\brief Set the rational weight of the cell, given a vtkDataSet
@@ -75,6 +75,7 @@ protected:
   vtkNew<vtkBezierCurve> BdyEdge;
   vtkNew<vtkBezierInterpolation> Interp;
   vtkNew<vtkBezierCurve> EdgeCell;
+  vtkNew<vtkBezierTriangle> ShapeTri; // Scratch space for the shape functions.
 
 private:
   vtkBezierWedge(const vtkBezierWedge&) = delete;
@@ -298,6 +298,7 @@ vtkOrderedTriangulator::vtkOrderedTriangulator()
   this->UseTwoSortIds = 0;
 
   this->UseTemplates = 0;
+  this->TemplateUsed = 0;
   this->NumberOfCellPoints = 0;
   this->NumberOfCellEdges = 0;
   this->Templates = new vtkOTTemplates;
@@ -1198,6 +1199,7 @@ void vtkOrderedTriangulator::Triangulate()
 void vtkOrderedTriangulator::TemplateTriangulate(int cellType, int numPts, int numEdges)
 {
   this->CellType = cellType;
+  this->TemplateUsed = 0;
   if (!this->UseTemplates || cellType != VTK_HEXAHEDRON)
   {
     this->Triangulate();
@@ -1221,7 +1223,8 @@ void vtkOrderedTriangulator::TemplateTriangulate(int cellType, int numPts, int n
     }
   }
 
-  if (!this->TemplateTriangulation())
+  this->TemplateUsed = this->TemplateTriangulation();
+  if (!this->TemplateUsed)
   { // template triangulation didn't work, triangulate it and add to template cache
     int preSorted = this->PreSorted; // prevents resorting
     this->PreSorted = 1;
@@ -1694,6 +1697,7 @@ void vtkOrderedTriangulator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PreSorted: " << (this->PreSorted ? "On\n" : "Off\n");
   os << indent << "UseTwoSortIds: " << (this->UseTwoSortIds ? "On\n" : "Off\n");
   os << indent << "UseTemplates: " << (this->UseTemplates ? "On\n" : "Off\n");
+  os << indent << "TemplateUsed: " << (this->TemplateUsed ? "On\n" : "Off\n");
   os << indent << "NumberOfPoints: " << this->NumberOfPoints << endl;
 }
 VTK_ABI_NAMESPACE_END
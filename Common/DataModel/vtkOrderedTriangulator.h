@@ -211,6 +211,15 @@ public:
   vtkBooleanMacro(UseTemplates, vtkTypeBool);
   ///@}
 
+  /**
+   * Return whether the last call to TemplateTriangulate() replayed a cached
+   * template. It is false when the cell was triangulated instead, including
+   * when that triangulation was added to the template cache. (Note: a
+   * replayed template adds its tetras in the reverse order of the
+   * triangulation that created it.)
+   */
+  vtkGetMacro(TemplateUsed, vtkTypeBool);
+
   ///@{
   /**
    * Boolean indicates whether the points have been pre-sorted. If
@@ -345,6 +354,7 @@ private:
   vtkHeap* Heap;
 
   vtkTypeBool UseTemplates;
+  vtkTypeBool TemplateUsed;
   int CellType;
   int NumberOfCellPoints;
   int NumberOfCellEdges;
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Measure the fixed cost of pipeline updates on a one-point dataset, for which
+// the executives dominate, and report it as CDash measurements. Also check
+// that every filter of the chain executes once per update and that progress
+// observers still receive the start and end of each execution.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPassThrough.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkTrivialProducer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Number of filters after the producer.
+constexpr int ChainLength = 10;
+// Number of updates over which the time is averaged.
+constexpr int NumberOfUpdates = 20000;
+
+struct Chain
+{
+  vtkNew<vtkTrivialProducer> Producer;
+  std::vector<vtkSmartPointer<vtkPassThrough>> Filters;
+
+  Chain()
+  {
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(0.0, 0.0, 0.0);
+    vtkNew<vtkPolyData> polyData;
+    polyData->SetPoints(points);
+    this->Producer->SetOutput(polyData);
+    vtkAlgorithm* previous = this->Producer;
+    for (int i = 0; i < ChainLength; ++i)
+    {
+      auto filter = vtkSmartPointer<vtkPassThrough>::New();
+      filter->SetInputConnection(previous->GetOutputPort());
+      this->Filters.push_back(filter);
+      previous = filter;
+    }
+  }
+
+  vtkPassThrough* Last() { return this->Filters.back(); }
+};
+
+void CountEvents(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+// Report the time of one update, in microseconds.
+void Report(const std::string& name, double seconds)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">"
+            << 1e6 * seconds / NumberOfUpdates << "</DartMeasurement>" << std::endl;
+}
+}
+
+int TestPipelineUpdatePerformance(int, char*[])
+{
+  ::Chain chain;
+  int numberOfExecutions = 0;
+  vtkNew<vtkCallbackCommand> countExecutions;
+  countExecutions->SetCallback(::CountEvents);
+  countExecutions->SetClientData(&numberOfExecutions);
+  chain.Filters[0]->AddObserver(vtkCommand::EndEvent, countExecutions);
+  chain.Last()->Update();
+
+  vtkNew<vtkTimerLog> timer;
+
+  // Modifying the input of the chain executes every filter.
+  numberOfExecutions = 0;
+  timer->StartTimer();
+  for (int i = 0; i < NumberOfUpdates; ++i)
+  {
+    chain.Producer->Modified();
+    chain.Last()->Update();
+  }
+  timer->StopTimer();
+  ::Report("ModifiedChainUpdate", timer->GetElapsedTime());
+  if (numberOfExecutions != NumberOfUpdates ||
+    chain.Last()->GetOutputDataObject(0)->GetNumberOfElements(vtkDataObject::POINT) != 1)
+  {
+    vtkLog(ERROR,
+      "Expected " << NumberOfUpdates << " executions of the chain, got " << numberOfExecutions);
+    return EXIT_FAILURE;
+  }
+
+  // Updating an up to date chain only checks the modification times.
+  numberOfExecutions = 0;
+  timer->StartTimer();
+  for (int i = 0; i < NumberOfUpdates; ++i)
+  {
+    chain.Last()->Update();
+  }
+  timer->StopTimer();
+  ::Report("UpToDateChainUpdate", timer->GetElapsedTime());
+  if (numberOfExecutions != 0)
+  {
+    vtkLog(ERROR, "An up to date chain should not execute.");
+    return EXIT_FAILURE;
+  }
+
+  // Progress observers still receive the start and the end of each execution.
+  int numberOfProgressEvents = 0;
+  vtkNew<vtkCallbackCommand> countProgress;
+  countProgress->SetCallback(::CountEvents);
+  countProgress->SetClientData(&numberOfProgressEvents);
+  for (vtkPassThrough* filter : chain.Filters)
+  {
+    filter->AddObserver(vtkCommand::ProgressEvent, countProgress);
+  }
+  timer->StartTimer();
+  for (int i = 0; i < NumberOfUpdates; ++i)
+  {
+    chain.Producer->Modified();
+    chain.Last()->Update();
+  }
+  timer->StopTimer();
+  ::Report("ObservedChainUpdate", timer->GetElapsedTime());
+  if (numberOfProgressEvents != 2 * ChainLength * NumberOfUpdates)
+  {
+    vtkLog(ERROR,
+      "Expected " << 2 * ChainLength * NumberOfUpdates << " progress events, got "
+                  << numberOfProgressEvents);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
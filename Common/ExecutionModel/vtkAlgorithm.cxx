@@ -164,7 +164,12 @@ void vtkAlgorithm::UpdateProgress(double amount)
   else
   {
     this->Progress = amount;
-    this->InvokeEvent(vtkCommand::ProgressEvent, static_cast<void*>(&amount));
+    // Skip the observer loops of the event dispatch when no progress observer
+    // is registered but the algorithm is observed for other events.
+    if (this->HasObserver(vtkCommand::ProgressEvent))
+    {
+      this->InvokeEvent(vtkCommand::ProgressEvent, static_cast<void*>(&amount));
+    }
   }
 }
 
@@ -1035,6 +1035,25 @@ int vtkDemandDrivenPipeline ::NeedToExecuteData(
   return 0;
 }
 
+//------------------------------------------------------------------------------
+bool vtkDemandDrivenPipeline::CanReuseInputData(vtkInformation* inInfo)
+{
+  if (!inInfo || !inInfo->Get(vtkDataObject::DATA_OBJECT()))
+  {
+    return false;
+  }
+
+  // Data that is not released once consumed stays cached as the producer
+  // output and must not be modified.
+  if (!vtkDataObject::GetGlobalReleaseDataFlag() && !inInfo->Get(RELEASE_DATA()))
+  {
+    return false;
+  }
+
+  // Any other consumer would see the modified data.
+  return vtkExecutive::CONSUMERS()->Length(inInfo) == 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkDemandDrivenPipeline::SetReleaseDataFlag(int port, vtkTypeBool n)
 {
@@ -146,6 +146,17 @@ public:
    */
   static vtkInformationIntegerKey* DATA_NOT_GENERATED();
 
+  /**
+   * Return true if the data object in the given input information may be
+   * modified in place, or have its buffers moved into an output, by the
+   * algorithm consuming it. This is the case when the producer output has a
+   * single consumer and is released once consumed (see RELEASE_DATA and
+   * vtkDataObject::GetGlobalReleaseDataFlag()), so that no other algorithm
+   * and no cached output can observe the modification. Algorithms must still
+   * check that the buffers they reuse are not shared with other data objects.
+   */
+  static bool CanReuseInputData(vtkInformation* inInfo);
+
   /**
    * Create (New) and return a data object of the given type.
    * This is here for backwards compatibility. Use
@@ -13,8 +13,8 @@
 #include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
-#include "vtkSmartPointer.h"
 
 #include <sstream>
 #include <vector>
@@ -36,6 +36,8 @@ class vtkExecutiveInternals
 {
 public:
   std::vector<vtkInformationVector*> InputInformation;
+  // Reused by CopyDefaultInformation, which runs for every request.
+  vtkNew<vtkInformationIterator> InformationIterator;
   vtkExecutiveInternals();
   ~vtkExecutiveInternals();
   vtkInformationVector** GetInputInformation(int newNumberOfPorts);
@@ -626,8 +628,7 @@ void vtkExecutive::CopyDefaultInformation(vtkInformation* request, int direction
       int length = request->Length(KEYS_TO_COPY());
       vtkInformation* inInfo = inInfoVec[0]->GetInformationObject(0);
 
-      vtkSmartPointer<vtkInformationIterator> infoIter =
-        vtkSmartPointer<vtkInformationIterator>::New();
+      vtkInformationIterator* infoIter = this->ExecutiveInternal->InformationIterator;
       infoIter->SetInformationWeak(inInfo);
 
       int oiobj = outInfoVec->GetNumberOfInformationObjects();
@@ -675,8 +676,7 @@ void vtkExecutive::CopyDefaultInformation(vtkInformation* request, int direction
       int length = request->Length(KEYS_TO_COPY());
       vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
 
-      vtkSmartPointer<vtkInformationIterator> infoIter =
-        vtkSmartPointer<vtkInformationIterator>::New();
+      vtkInformationIterator* infoIter = this->ExecutiveInternal->InformationIterator;
       infoIter->SetInformationWeak(outInfo);
 
       for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
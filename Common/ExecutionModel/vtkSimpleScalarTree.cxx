@@ -382,7 +382,6 @@ vtkIdType vtkSimpleScalarTree::GetNumberOfCellBatches(double scalarValue)
   }
 
   // Basically we do a traversal of the tree and identify potential candidates.
-  // It is essential that InitTraversal() has been called first.
   this->NumCandidates = 0;
   delete[] this->CandidateCells;
   this->CandidateCells = nullptr;
@@ -392,7 +391,8 @@ vtkIdType vtkSimpleScalarTree::GetNumberOfCellBatches(double scalarValue)
   }
   this->CandidateCells = new vtkIdType[this->NumCells];
 
-  // Now begin traversing tree. InitTraversal() sets the first CellId.
+  // Now begin traversing tree from the first leaf overlapping the scalar value.
+  this->FindStartLeaf(0, 0);
   while (this->TreeIndex < this->TreeSize)
   {
     for (; this->ChildNumber < this->BranchingFactor && this->CellId < this->NumCells;
@@ -1152,8 +1152,7 @@ void vtkStreamingDemandDrivenPipeline ::MarkOutputsGenerated(
       // the data object about what update request lead to
       // the last execution. This information can later be
       // used to decide whether an execution is necessary.
-      vtkSmartPointer<vtkInformationIterator> infoIter =
-        vtkSmartPointer<vtkInformationIterator>::New();
+      vtkInformationIterator* infoIter = this->InformationIterator;
       infoIter->SetInformationWeak(outInfo);
       infoIter->InitTraversal();
       while (!infoIter->IsDoneWithTraversal())
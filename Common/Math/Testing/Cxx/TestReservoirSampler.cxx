@@ -192,6 +192,27 @@ int TestReservoirSamplerArraySizeSequence()
   return result;
 }
 
+int TestReservoirSamplerSeededSequence()
+{
+  constexpr int kk = 10;
+  constexpr int nn = 1000;
+  int result = 0;
+  std::cout << "seeded subsequences\n";
+  vtkReservoirSampler<int> sampler;
+  std::vector<int> sequence = sampler(kk, nn, 42);
+  if (static_cast<int>(sequence.size()) != kk || sequence != sampler(kk, nn, 42))
+  {
+    std::cerr << "Subsequences with the same seed differ.\n";
+    ++result;
+  }
+  if (!std::is_sorted(sequence.begin(), sequence.end()))
+  {
+    std::cerr << "Seeded subsequence is not monotonic.\n";
+    ++result;
+  }
+  return result;
+}
+
 int TestReservoirSamplerBenchmark()
 {
   constexpr vtkIdType kk = 128;
@@ -226,6 +247,7 @@ int TestReservoirSampler(int, char*[])
   retVal += TestReservoirSamplerExceptions();
   retVal += TestReservoirSamplerPlainSequence();
   retVal += TestReservoirSamplerArraySizeSequence();
+  retVal += TestReservoirSamplerSeededSequence();
   retVal += TestReservoirSamplerBenchmark();
 
   return retVal;
@@ -13,6 +13,11 @@
  * "Algorithm L" and documented in the article "Reservoir-Sampling Algorithms of
  * Time Complexity O(n(1+log(N/n)))". ACM Transactions on Mathematical Software.
  * 20 (4): 481–493. doi:10.1145/198429.198435.
+ *
+ * By default, the random number generator is seeded from std::random_device,
+ * so that each sample differs. A seed may also be passed to obtain the same
+ * sample on every run, for instance when several threads sample disjoint
+ * parts of a sequence.
  */
 
 #ifndef vtkReservoirSampler_h
@@ -32,9 +37,10 @@ VTK_ABI_NAMESPACE_BEGIN
 
 class VTKCOMMONMATH_EXPORT vtkReservoirSamplerBase
 {
-protected:
+public:
   using SeedType = typename std::random_device::result_type;
 
+protected:
   static SeedType RandomSeed();
 };
 
@@ -70,8 +76,24 @@ public:
     return data;
   }
 
+  /// Choose kk items from a sequence of (0, nn - 1), seeding the random
+  /// number generator with \a seed so that the sample is reproducible.
+  ///
+  /// This will throw an exception if kk <= 0.
+  const std::vector<Integer>& operator()(Integer kk, Integer nn, SeedType seed) const
+  {
+    VTK_THREAD_LOCAL static std::vector<Integer> data;
+    this->GenerateSample(kk, nn, seed, data);
+    return data;
+  }
+
 protected:
   void GenerateSample(Integer kk, Integer nn, std::vector<Integer>& data) const
+  {
+    this->GenerateSample(kk, nn, vtkReservoirSampler::RandomSeed(), data);
+  }
+
+  void GenerateSample(Integer kk, Integer nn, SeedType seed, std::vector<Integer>& data) const
   {
     if (nn < kk)
     {
@@ -98,7 +120,7 @@ protected:
       return;
     }
 
-    std::mt19937 generator(vtkReservoirSampler::RandomSeed());
+    std::mt19937 generator(seed);
     std::uniform_real_distribution<> unitUniform(0., 1.);
     std::uniform_int_distribution<Integer> randomIndex(0, kk - 1);
     double w = exp(log(unitUniform(generator)) / kk);
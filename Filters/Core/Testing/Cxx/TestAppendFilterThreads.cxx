@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel vtkAppendFilter does not depend on the number of
+// threads, and that the parallel merging of coincident points numbers the
+// points as the incremental merging does.
+
+#include "vtkAppendFilter.h"
+#include "vtkIdFilter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+int TestAppendFilterThreads(int, char*[])
+{
+  // Three planes sharing their edges, and a sphere.
+  vtkNew<vtkAppendFilter> append;
+  for (int i = 0; i < 3; ++i)
+  {
+    vtkNew<vtkPlaneSource> plane;
+    plane->SetResolution(10, 10);
+    plane->SetOrigin(i, 0.0, 0.0);
+    plane->SetPoint1(i + 1.0, 0.0, 0.0);
+    plane->SetPoint2(i, 1.0, 0.0);
+    vtkNew<vtkIdFilter> ids;
+    ids->SetInputConnection(plane->GetOutputPort());
+    ids->SetPointIdsArrayName("PointIds");
+    ids->SetCellIdsArrayName("CellIds");
+    append->AddInputConnection(ids->GetOutputPort());
+  }
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(0.0, 0.0, 2.0);
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkIdFilter> sphereIds;
+  sphereIds->SetInputConnection(sphere->GetOutputPort());
+  sphereIds->SetPointIdsArrayName("PointIds");
+  sphereIds->SetCellIdsArrayName("CellIds");
+  append->AddInputConnection(sphereIds->GetOutputPort());
+
+  bool success = true;
+
+  // 3 planes of 11 x 11 points, and a sphere of 32 x 30 points and 2 poles.
+  const vtkIdType numPts = 3 * 11 * 11 + 32 * 30 + 2;
+  append->MergePointsOff();
+  vtkNew<vtkUnstructuredGrid> output;
+  if (!vtkTestUtilities::CompareThreadedOutputs(append, 4, output) ||
+    output->GetNumberOfPoints() != numPts)
+  {
+    vtkLog(ERROR, "Appending differs with 1 and 4 threads.");
+    success = false;
+  }
+
+  // A small nonzero tolerance keeps the incremental merging. The planes
+  // share 2 edges of 11 points.
+  append->MergePointsOn();
+  append->ToleranceIsAbsoluteOn();
+  append->SetTolerance(1e-6);
+  vtkNew<vtkUnstructuredGrid> serialMerged;
+  success &= vtkTestUtilities::CompareThreadedOutputs(append, 4, serialMerged);
+  const vtkIdType numMergedPts = numPts - 2 * 11;
+  if (serialMerged->GetNumberOfPoints() != numMergedPts)
+  {
+    vtkLog(ERROR,
+      "Expected " << numMergedPts << " merged points, got "
+                  << serialMerged->GetNumberOfPoints());
+    success = false;
+  }
+
+  append->SetTolerance(0.0);
+  vtkNew<vtkUnstructuredGrid> merged;
+  if (!vtkTestUtilities::CompareThreadedOutputs(append, 4, merged) ||
+    !vtkTestUtilities::CompareDataObjectsExactly(serialMerged, merged))
+  {
+    vtkLog(ERROR, "Parallel merging differs from the incremental merging.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel merging of vtkCleanPolyData produces the same
+// output as the incremental insertion, including the degenerate cells
+// conversions, whatever the number of threads, and that subclasses are only
+// cleaned in parallel when they opt in.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCleanPolyData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <set>
+
+namespace
+{
+// Random cells over a small set of points, each point being duplicated
+// several times, so that many cells degenerate once points are merged.
+vtkSmartPointer<vtkPolyData> MakePolyData()
+{
+  unsigned int seed = 12345;
+  auto random = [&seed](int n) {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<int>((seed >> 16) % n);
+  };
+
+  const int numDistinct = 40;
+  const int numPts = 3 * numDistinct;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(numPts);
+  for (int i = 0; i < numPts; ++i)
+  {
+    const int p = random(numDistinct);
+    points->SetPoint(i, p % 4, (p / 4) % 5, p / 20);
+    pointIds->SetValue(i, i);
+  }
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(pointIds);
+
+  vtkNew<vtkCellArray> cells[4];
+  vtkIdType ids[8];
+  const int minSizes[4] = { 1, 2, 3, 4 };
+  for (int type = 0; type < 4; ++type)
+  {
+    for (int cell = 0; cell < 200; ++cell)
+    {
+      const int npts = minSizes[type] + random(3);
+      for (int i = 0; i < npts; ++i)
+      {
+        ids[i] = random(numPts);
+      }
+      cells[type]->InsertNextCell(npts, ids);
+    }
+  }
+  polyData->SetVerts(cells[0]);
+  polyData->SetLines(cells[1]);
+  polyData->SetPolys(cells[2]);
+  polyData->SetStrips(cells[3]);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfValues(polyData->GetNumberOfCells());
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->SetValue(cellId, cellId);
+  }
+  polyData->GetCellData()->AddArray(cellIds);
+  return polyData;
+}
+
+// Number of distinct coordinates among the points used by the cells.
+size_t CountDistinctUsedPoints(vtkPolyData* polyData)
+{
+  std::set<std::array<double, 3>> coordinates;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < polyData->GetNumberOfCells(); ++cellId)
+  {
+    polyData->GetCellPoints(cellId, ptIds);
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      std::array<double, 3> p;
+      polyData->GetPoint(ptIds->GetId(i), p.data());
+      coordinates.insert(p);
+    }
+  }
+  return coordinates.size();
+}
+
+// Flattens the points on the z = 0 plane, without overriding OperatesOnPoints
+// like the subclasses written before it.
+class vtkFlatteningCleanPolyData : public vtkCleanPolyData
+{
+public:
+  static vtkFlatteningCleanPolyData* New();
+  vtkTypeMacro(vtkFlatteningCleanPolyData, vtkCleanPolyData);
+
+  void OperateOnPoint(double in[3], double out[3]) override
+  {
+    out[0] = in[0];
+    out[1] = in[1];
+    out[2] = 0.0;
+  }
+
+  void OperateOnBounds(double in[6], double out[6]) override
+  {
+    std::copy(in, in + 4, out);
+    out[4] = out[5] = 0.0;
+  }
+
+protected:
+  vtkFlatteningCleanPolyData() = default;
+};
+vtkStandardNewMacro(vtkFlatteningCleanPolyData);
+
+// Counts the points going through OperateOnPoint, opting in to the parallel
+// merging or not.
+class vtkCountingCleanPolyData : public vtkCleanPolyData
+{
+public:
+  static vtkCountingCleanPolyData* New();
+  vtkTypeMacro(vtkCountingCleanPolyData, vtkCleanPolyData);
+
+  void OperateOnPoint(double in[3], double out[3]) override
+  {
+    ++this->NumberOfOperatedPoints;
+    std::copy(in, in + 3, out);
+  }
+
+  bool ParallelMerging = false;
+  vtkIdType NumberOfOperatedPoints = 0;
+
+protected:
+  vtkCountingCleanPolyData() = default;
+  bool OperatesOnPoints() override { return !this->ParallelMerging; }
+};
+vtkStandardNewMacro(vtkCountingCleanPolyData);
+}
+
+int TestCleanPolyDataParallel(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> input = MakePolyData();
+
+  bool success = true;
+  for (int conversions = 0; conversions < 2; ++conversions)
+  {
+    // A vtkPointLocator keeps the incremental insertion.
+    vtkNew<vtkCleanPolyData> serialClean;
+    serialClean->SetInputData(input);
+    serialClean->SetConvertLinesToPoints(conversions);
+    serialClean->SetConvertPolysToLines(conversions);
+    serialClean->SetConvertStripsToPolys(conversions);
+    vtkNew<vtkPointLocator> locator;
+    serialClean->SetLocator(locator);
+    serialClean->Update();
+    vtkPolyData* expected = serialClean->GetOutput();
+
+    vtkNew<vtkCleanPolyData> clean;
+    clean->SetInputData(input);
+    clean->SetConvertLinesToPoints(conversions);
+    clean->SetConvertPolysToLines(conversions);
+    clean->SetConvertStripsToPolys(conversions);
+    vtkNew<vtkPolyData> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(clean, 4, output) ||
+      !vtkTestUtilities::CompareDataObjectsExactly(expected, output))
+    {
+      vtkLog(ERROR,
+        "Parallel merging differs with conversions " << (conversions ? "on" : "off"));
+      success = false;
+    }
+
+    // Degenerate cells are converted instead of removed, so every distinct
+    // coordinate used by the input cells is kept once.
+    if (conversions &&
+      static_cast<size_t>(output->GetNumberOfPoints()) != ::CountDistinctUsedPoints(input))
+    {
+      vtkLog(ERROR,
+        "Expected " << ::CountDistinctUsedPoints(input) << " merged points, got "
+                    << output->GetNumberOfPoints());
+      success = false;
+    }
+  }
+
+  // Subclasses operating on the points keep the incremental insertion, the
+  // points of the 2 layers of the input being merged once flattened.
+  vtkNew<vtkFlatteningCleanPolyData> flatten;
+  flatten->SetInputData(input);
+  flatten->Update();
+  double bounds[6];
+  flatten->GetOutput()->GetBounds(bounds);
+  if (flatten->GetOutput()->GetNumberOfPoints() != 20 || bounds[4] != 0.0 || bounds[5] != 0.0)
+  {
+    vtkLog(ERROR,
+      "OperateOnPoint was not applied: " << flatten->GetOutput()->GetNumberOfPoints()
+                                         << " points.");
+    success = false;
+  }
+
+  // Subclasses opting in merge the points in parallel without calling
+  // OperateOnPoint, with the same output.
+  vtkNew<vtkCleanPolyData> clean;
+  clean->SetInputData(input);
+  clean->Update();
+  for (bool parallelMerging : { false, true })
+  {
+    vtkNew<vtkCountingCleanPolyData> counting;
+    counting->ParallelMerging = parallelMerging;
+    counting->SetInputData(input);
+    counting->Update();
+    if ((counting->NumberOfOperatedPoints == 0) != parallelMerging ||
+      !vtkTestUtilities::CompareDataObjectsExactly(clean->GetOutput(), counting->GetOutput()))
+    {
+      vtkLog(ERROR,
+        "Subclass " << (parallelMerging ? "opting in" : "not opting in") << " operated on "
+                    << counting->NumberOfOperatedPoints << " points.");
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
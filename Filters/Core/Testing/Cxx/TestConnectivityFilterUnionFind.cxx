@@ -0,0 +1,286 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the union-find labeling of the connectivity filters finds the
+// same regions as the wave propagation, whatever the number of threads,
+// including with scalar connectivity where cells that are not scalar
+// connected still seed regions.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+struct Extraction
+{
+  int NumberOfRegions;
+  vtkSmartPointer<vtkPointSet> Output;
+};
+
+// Extract with the wave propagation, and with the union-find checking that
+// it does not depend on the number of threads.
+template <typename TFilter>
+bool Extract(TFilter* filter, Extraction& wave, Extraction& unionFind)
+{
+  filter->SetLabelingModeToWavePropagation();
+  filter->Update();
+  wave.NumberOfRegions = filter->GetNumberOfExtractedRegions();
+  wave.Output.TakeReference(vtkPointSet::SafeDownCast(filter->GetOutput()->NewInstance()));
+  wave.Output->DeepCopy(filter->GetOutput());
+
+  filter->SetLabelingModeToUnionFind();
+  unionFind.Output.TakeReference(vtkPointSet::SafeDownCast(filter->GetOutput()->NewInstance()));
+  if (!vtkTestUtilities::CompareThreadedOutputs(filter, 4, unionFind.Output))
+  {
+    return false;
+  }
+  unionFind.NumberOfRegions = filter->GetNumberOfExtractedRegions();
+  return true;
+}
+
+bool SameRegions(const Extraction& wave, const Extraction& unionFind, const char* name)
+{
+  if (wave.NumberOfRegions != unionFind.NumberOfRegions)
+  {
+    vtkLog(ERROR,
+      << name << ": " << wave.NumberOfRegions << " regions with the wave propagation but "
+      << unionFind.NumberOfRegions << " with the union-find.");
+    return false;
+  }
+  if (wave.Output->GetNumberOfPoints() != unionFind.Output->GetNumberOfPoints() ||
+    wave.Output->GetNumberOfCells() != unionFind.Output->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      << name << ": " << wave.Output->GetNumberOfCells() << " cells extracted with the "
+      << "wave propagation but " << unionFind.Output->GetNumberOfCells()
+      << " with the union-find.");
+    return false;
+  }
+  // Cells are extracted in the input order in both cases, but points are in
+  // the traversal order with the wave propagation. A point is given the
+  // lowest region of its cells in both cases.
+  vtkIdTypeArray* waveIds =
+    vtkArrayDownCast<vtkIdTypeArray>(wave.Output->GetPointData()->GetArray("RegionId"));
+  vtkIdTypeArray* unionFindIds =
+    vtkArrayDownCast<vtkIdTypeArray>(unionFind.Output->GetPointData()->GetArray("RegionId"));
+  vtkNew<vtkIdList> wavePts;
+  vtkNew<vtkIdList> unionFindPts;
+  for (vtkIdType cellId = 0; cellId < wave.Output->GetNumberOfCells(); ++cellId)
+  {
+    wave.Output->GetCellPoints(cellId, wavePts);
+    unionFind.Output->GetCellPoints(cellId, unionFindPts);
+    for (vtkIdType i = 0; i < wavePts->GetNumberOfIds(); ++i)
+    {
+      if (waveIds->GetValue(wavePts->GetId(i)) != unionFindIds->GetValue(unionFindPts->GetId(i)))
+      {
+        vtkLog(ERROR, << name << ": different region id for cell " << cellId);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Run every extraction mode with both labelings and compare the results.
+template <typename TFilter>
+bool TestFilter(TFilter* filter, vtkIdType seedCell, vtkIdType seedPoint, const char* name)
+{
+  bool success = true;
+  filter->ColorRegionsOn();
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS; mode <= VTK_EXTRACT_CLOSEST_POINT_REGION;
+       ++mode)
+  {
+    filter->SetExtractionMode(mode);
+    filter->InitializeSeedList();
+    if (mode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+    {
+      filter->AddSeed(seedPoint);
+    }
+    else if (mode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      filter->AddSeed(seedCell);
+    }
+    filter->InitializeSpecifiedRegionList();
+    filter->AddSpecifiedRegion(1);
+    filter->AddSpecifiedRegion(3);
+    filter->SetClosestPoint(10.0, 0.0, 0.0);
+
+    Extraction wave, unionFind;
+    if (!Extract(filter, wave, unionFind) || !SameRegions(wave, unionFind, name))
+    {
+      vtkLog(ERROR, << name << ": failure with extraction mode " << mode);
+      success = false;
+    }
+  }
+  return success;
+}
+
+// Two strips of quads, whose points have a scalar of 1 except for the third
+// and fourth columns where it is 5. With a scalar range of [0.5, 1.5], only
+// the third quad of each strip is not scalar connected.
+// The first strip has 6 quads, its third quad comes first: it seeds region 0
+// and joins the 2 quads before it and the 3 quads after it.
+// The second strip has 4 quads in order: quads 1 and 2 are region 1, and the
+// third quad, reached by none of them, seeds region 2 and joins the fourth.
+vtkSmartPointer<vtkPolyData> MakeStrips()
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkCellArray> quads;
+  const int numQuads[2] = { 6, 4 };
+  const std::vector<int> orders[2] = { { 2, 0, 1, 3, 4, 5 }, { 0, 1, 2, 3 } };
+  for (int strip = 0; strip < 2; ++strip)
+  {
+    const vtkIdType firstPt = points->GetNumberOfPoints();
+    for (int column = 0; column <= numQuads[strip]; ++column)
+    {
+      for (int row = 0; row < 2; ++row)
+      {
+        points->InsertNextPoint(column, 3.0 * strip + row, 0.0);
+        scalars->InsertNextValue(column == 2 || column == 3 ? 5.0 : 1.0);
+      }
+    }
+    for (int quad : orders[strip])
+    {
+      const vtkIdType pts[4] = { firstPt + 2 * quad, firstPt + 2 * quad + 2,
+        firstPt + 2 * quad + 3, firstPt + 2 * quad + 1 };
+      quads->InsertNextCell(4, pts);
+    }
+  }
+  vtkSmartPointer<vtkPolyData> strips = vtkSmartPointer<vtkPolyData>::New();
+  strips->SetPoints(points);
+  strips->SetPolys(quads);
+  strips->GetPointData()->SetScalars(scalars);
+  return strips;
+}
+
+// Check the regions of the strips with both labelings.
+template <typename TFilter>
+bool TestScalarConnectivity(TFilter* filter, const char* name)
+{
+  filter->ScalarConnectivityOn();
+  filter->SetScalarRange(0.5, 1.5);
+  filter->ColorRegionsOff();
+
+  // Extracting each region on its own gives its size.
+  const vtkIdType expectedSizes[3] = { 6, 2, 2 };
+  filter->SetExtractionModeToSpecifiedRegions();
+  for (int regionId = 0; regionId < 3; ++regionId)
+  {
+    filter->InitializeSpecifiedRegionList();
+    filter->AddSpecifiedRegion(regionId);
+    Extraction wave, unionFind;
+    if (!Extract(filter, wave, unionFind) || wave.NumberOfRegions != 3 ||
+      unionFind.NumberOfRegions != 3 ||
+      wave.Output->GetNumberOfCells() != expectedSizes[regionId] ||
+      unionFind.Output->GetNumberOfCells() != expectedSizes[regionId])
+    {
+      vtkLog(ERROR,
+        << name << ": region " << regionId << " has " << wave.Output->GetNumberOfCells()
+        << " cells with the wave propagation and " << unionFind.Output->GetNumberOfCells()
+        << " with the union-find among " << wave.NumberOfRegions << " and "
+        << unionFind.NumberOfRegions << " regions, expected " << expectedSizes[regionId]
+        << " cells among 3 regions.");
+      return false;
+    }
+  }
+
+  // Growing from the third quad of the second strip reaches the whole strip,
+  // growing from the fourth one stops at the third one.
+  const vtkIdType seeds[2] = { 8, 9 };
+  const vtkIdType expectedCells[2] = { 4, 1 };
+  filter->SetExtractionModeToCellSeededRegions();
+  for (int i = 0; i < 2; ++i)
+  {
+    filter->InitializeSeedList();
+    filter->AddSeed(seeds[i]);
+    Extraction wave, unionFind;
+    if (!Extract(filter, wave, unionFind) ||
+      wave.Output->GetNumberOfCells() != expectedCells[i] ||
+      unionFind.Output->GetNumberOfCells() != expectedCells[i])
+    {
+      vtkLog(ERROR,
+        << name << ": seeding cell " << seeds[i] << " extracts "
+        << wave.Output->GetNumberOfCells() << " cells with the wave propagation and "
+        << unionFind.Output->GetNumberOfCells() << " with the union-find, expected "
+        << expectedCells[i] << ".");
+      return false;
+    }
+  }
+
+  filter->SetExtractionModeToLargestRegion();
+  filter->ColorRegionsOn();
+  Extraction wave, unionFind;
+  if (!Extract(filter, wave, unionFind) || unionFind.Output->GetNumberOfCells() != 6 ||
+    !SameRegions(wave, unionFind, name))
+  {
+    vtkLog(ERROR, << name << ": wrong largest region.");
+    return false;
+  }
+
+  filter->ScalarConnectivityOff();
+  return true;
+}
+}
+
+int TestConnectivityFilterUnionFind(int, char*[])
+{
+  // Disjoint spheres of various sizes
+  vtkNew<vtkAppendPolyData> spheres;
+  for (int i = 0; i < 5; ++i)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetCenter(3.0 * i, 0.0, 0.0);
+    sphere->SetThetaResolution(8 + 4 * ((i * 3) % 5));
+    sphere->SetPhiResolution(8 + 4 * ((i * 2) % 5));
+    spheres->AddInputConnection(sphere->GetOutputPort());
+  }
+  spheres->Update();
+  vtkPolyData* input = spheres->GetOutput();
+  const vtkIdType seedCell = input->GetNumberOfCells() / 2;
+  const vtkIdType seedPoint = input->GetNumberOfPoints() - 1;
+
+  vtkNew<vtkAppendFilter> grid;
+  grid->SetInputConnection(spheres->GetOutputPort());
+
+  bool success = true;
+
+  vtkNew<vtkPolyDataConnectivityFilter> polyDataConnectivity;
+  polyDataConnectivity->SetInputConnection(spheres->GetOutputPort());
+  success &= TestFilter<vtkPolyDataConnectivityFilter>(
+    polyDataConnectivity, seedCell, seedPoint, "vtkPolyDataConnectivityFilter");
+
+  vtkNew<vtkConnectivityFilter> gridConnectivity;
+  gridConnectivity->SetInputConnection(grid->GetOutputPort());
+  success &= TestFilter<vtkConnectivityFilter>(
+    gridConnectivity, seedCell, seedPoint, "vtkConnectivityFilter");
+
+  vtkSmartPointer<vtkPolyData> strips = ::MakeStrips();
+  polyDataConnectivity->SetInputData(strips);
+  success &=
+    TestScalarConnectivity<vtkPolyDataConnectivityFilter>(polyDataConnectivity, "strips");
+  grid->SetInputData(strips);
+  success &= TestScalarConnectivity<vtkConnectivityFilter>(gridConnectivity, "strip grid");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkContourGrid does not depend on the number of
+// threads, that it produces the output of the serial contouring, and that it
+// interpolates the point data exactly, for grids mixing linear, quadratic,
+// higher order, polyhedral and 2D cells.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkContourGrid.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdFilter.h"
+#include "vtkLogger.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// The "Other" field is linear, so it is interpolated exactly at the points
+// of the contours.
+bool InterpolatesOther(vtkPolyData* output)
+{
+  vtkDataArray* other = output->GetPointData()->GetArray("Other");
+  if (!other)
+  {
+    vtkLog(ERROR, "Missing the Other array.");
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    if (std::abs(other->GetComponent(ptId, 0) - (x[0] - x[1])) > 1e-9 ||
+      std::abs(other->GetComponent(ptId, 1) - x[2]) > 1e-9)
+    {
+      vtkLog(ERROR, "Wrong interpolation at point " << ptId);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Each output point must be unique.
+bool HasUniquePoints(vtkPolyData* output)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataType(output->GetPoints()->GetDataType());
+  vtkNew<vtkMergePoints> locator;
+  locator->InitPointInsertion(points, output->GetBounds());
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    vtkIdType id;
+    if (!locator->InsertUniquePoint(output->GetPoint(ptId), id))
+    {
+      vtkLog(ERROR, "Point " << ptId << " is duplicated.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Blocks of cells of the given types side by side, with a nonlinear field to
+// contour and another field to interpolate.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(const std::vector<int>& cellTypes)
+{
+  vtkNew<vtkAppendFilter> append;
+  double shift = 0.0;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(6, 5, 4);
+    source->Update();
+    vtkNew<vtkUnstructuredGrid> block;
+    block->DeepCopy(source->GetOutput());
+    vtkPoints* points = block->GetPoints();
+    for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+    {
+      double x[3];
+      points->GetPoint(ptId, x);
+      x[0] += shift;
+      points->SetPoint(ptId, x);
+    }
+    shift += 7.0;
+    append->AddInputData(block);
+  }
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(append->GetOutputPort());
+  ids->SetCellIdsArrayName("CellIds");
+  ids->PointIdsOff();
+  ids->Update();
+
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->ShallowCopy(ids->GetOutput());
+  vtkNew<vtkDoubleArray> field;
+  field->SetName("Field");
+  field->SetNumberOfTuples(grid->GetNumberOfPoints());
+  vtkNew<vtkDoubleArray> other;
+  other->SetName("Other");
+  other->SetNumberOfComponents(2);
+  other->SetNumberOfTuples(grid->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < grid->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    grid->GetPoint(ptId, x);
+    field->SetValue(ptId, std::sin(x[0]) * x[1] + 0.5 * x[2] * x[2]);
+    other->SetTypedComponent(ptId, 0, x[0] - x[1]);
+    other->SetTypedComponent(ptId, 1, x[2]);
+  }
+  grid->GetPointData()->SetScalars(field);
+  grid->GetPointData()->AddArray(other);
+  return grid;
+}
+}
+
+int TestContourGridThreads(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid =
+    MakeGrid({ VTK_HEXAHEDRON, VTK_TETRA, VTK_QUADRATIC_WEDGE, VTK_POLYHEDRON,
+      VTK_LAGRANGE_HEXAHEDRON, VTK_QUAD, VTK_QUADRATIC_TRIANGLE, VTK_LINE });
+
+  // The serial contouring orients the polygons of polyhedra after the point
+  // ids, and gives the contours of higher order cells the cell data of other
+  // cells, so it is compared on the other cells only.
+  vtkSmartPointer<vtkUnstructuredGrid> serialGrid = MakeGrid(
+    { VTK_HEXAHEDRON, VTK_TETRA, VTK_QUADRATIC_WEDGE, VTK_QUAD, VTK_QUADRATIC_TRIANGLE, VTK_LINE });
+
+  bool success = true;
+  for (int configuration = 0; configuration < 8; ++configuration)
+  {
+    vtkNew<vtkContourGrid> contour;
+    contour->SetInputData(grid);
+    contour->SetValue(0, 0.5);
+    contour->SetValue(1, 2.0);
+    contour->SetValue(2, 4.0);
+    contour->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
+    contour->SetGenerateTriangles(configuration % 2);
+    contour->SetComputeScalars((configuration / 2) % 2);
+    contour->SetUseScalarTree((configuration / 4) % 2);
+
+    vtkNew<vtkPolyData> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(contour, 4, output) ||
+      output->GetNumberOfPolys() == 0 || output->GetNumberOfLines() == 0 ||
+      !HasUniquePoints(output) || !InterpolatesOther(output))
+    {
+      vtkLog(ERROR, "Wrong contours with 1 and 4 threads, configuration " << configuration);
+      success = false;
+    }
+
+    // With double precision points, a vtkPointLocator without tolerance
+    // merges the points as vtkMergePoints, but inserts them serially. With a
+    // scalar tree, the serial contouring mixes up the cell data of the lines
+    // and of the polygons, so it is not compared.
+    contour->SetInputData(serialGrid);
+    contour->Update();
+    vtkNew<vtkPolyData> parallelOutput;
+    parallelOutput->DeepCopy(contour->GetOutput());
+    vtkNew<vtkPointLocator> locator;
+    locator->SetTolerance(0.0);
+    contour->SetLocator(locator);
+    contour->Update();
+    vtkNew<vtkPolyData> serialOutput;
+    serialOutput->DeepCopy(contour->GetOutput());
+    if (contour->GetUseScalarTree())
+    {
+      parallelOutput->GetCellData()->RemoveArray("CellIds");
+      serialOutput->GetCellData()->RemoveArray("CellIds");
+    }
+    if (!vtkTestUtilities::CompareDataObjectsExactly(serialOutput, parallelOutput))
+    {
+      vtkLog(ERROR, "Contours differ from the serial contouring, configuration " << configuration);
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the output of vtkDecimatePro does not depend on the number of
+// threads used to compact it, and that it reaches the target reduction
+// without degenerate triangles. Check the same for the decimation of
+// partitions in parallel, and that the partitions of a closed surface
+// still match in the output.
+
+#include "vtkCellArray.h"
+#include "vtkDecimatePro.h"
+#include "vtkFeatureEdges.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Every output triangle uses 3 distinct points.
+bool NoDegenerateTriangles(vtkPolyData* output)
+{
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfPolys(); ++cellId)
+  {
+    output->GetPolys()->GetCellAtId(cellId, pts);
+    if (pts->GetNumberOfIds() != 3 || pts->GetId(0) == pts->GetId(1) ||
+      pts->GetId(1) == pts->GetId(2) || pts->GetId(2) == pts->GetId(0))
+    {
+      vtkLog(ERROR, "Degenerate triangle " << cellId);
+      return false;
+    }
+  }
+  return true;
+}
+
+// The output has no boundary edge.
+bool IsClosed(vtkPolyData* output)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(output);
+  edges->BoundaryEdgesOn();
+  edges->FeatureEdgesOff();
+  edges->NonManifoldEdgesOff();
+  edges->ManifoldEdgesOff();
+  edges->Update();
+  if (edges->GetOutput()->GetNumberOfLines() != 0)
+  {
+    vtkLog(ERROR, "Found " << edges->GetOutput()->GetNumberOfLines() << " boundary edges.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDecimateProThreads(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(40);
+  sphere->SetEndTheta(300.0);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+  vtkNew<vtkFloatArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    pointIds->SetValue(ptId, ptId);
+  }
+  input->GetPointData()->AddArray(pointIds);
+
+  bool success = true;
+  for (int split = 0; split < 2; ++split)
+  {
+    vtkNew<vtkDecimatePro> decimate;
+    decimate->SetInputData(input);
+    decimate->SetTargetReduction(0.8);
+    decimate->SetPreserveTopology(!split);
+    decimate->SetSplitting(split);
+    decimate->SetBoundaryVertexDeletion(split);
+
+    vtkNew<vtkPolyData> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(decimate, 4, output) ||
+      output->GetNumberOfPolys() >= input->GetNumberOfPolys() || !::NoDegenerateTriangles(output))
+    {
+      vtkLog(ERROR, "Wrong decimation with splitting " << (split ? "on" : "off"));
+      success = false;
+    }
+
+    // Splitting the mesh lets the decimation reach the target reduction.
+    if (split && output->GetNumberOfPolys() > 0.2 * input->GetNumberOfPolys())
+    {
+      vtkLog(ERROR,
+        "Target reduction not reached: " << output->GetNumberOfPolys() << " of "
+                                         << input->GetNumberOfPolys() << " triangles left.");
+      success = false;
+    }
+  }
+
+  // Partitions decimated in parallel, on a closed sphere.
+  vtkNew<vtkSphereSource> closedSphere;
+  closedSphere->SetThetaResolution(80);
+  closedSphere->SetPhiResolution(60);
+  closedSphere->Update();
+  vtkPolyData* closedInput = closedSphere->GetOutput();
+  for (int split = 0; split < 2; ++split)
+  {
+    vtkNew<vtkDecimatePro> decimate;
+    decimate->SetInputData(closedInput);
+    decimate->SetTargetReduction(0.8);
+    decimate->SetPreserveTopology(!split);
+    decimate->SetSplitting(split);
+    decimate->SetNumberOfPartitions(6);
+
+    vtkNew<vtkPolyData> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(decimate, 4, output) ||
+      !::NoDegenerateTriangles(output))
+    {
+      vtkLog(ERROR, "Wrong partitioned decimation with splitting " << (split ? "on" : "off"));
+      success = false;
+    }
+
+    // The locked points between the partitions keep them connected.
+    if (!split && !::IsClosed(output))
+    {
+      vtkLog(ERROR, "The partitions do not match.");
+      success = false;
+    }
+    if (output->GetNumberOfPolys() > 0.3 * closedInput->GetNumberOfPolys())
+    {
+      vtkLog(ERROR,
+        "Partitioned reduction too small: " << output->GetNumberOfPolys() << " of "
+                                            << closedInput->GetNumberOfPolys()
+                                            << " triangles left.");
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
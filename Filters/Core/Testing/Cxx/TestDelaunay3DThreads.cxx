@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel generation of the vtkDelaunay3D output, alpha
+// shapes included, and the insertion of the points in batches do not depend
+// on the number of threads, and that the tetrahedra meet the Delaunay
+// criterion.
+
+#include "vtkDelaunay3D.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTetra.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Check the Delaunay criterion: no input point lies strictly inside the
+// circumsphere of a tetrahedron.
+bool EmptyCircumspheres(vtkUnstructuredGrid* output, vtkPolyData* input)
+{
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, ptIds);
+    double x[4][3], center[3];
+    for (int i = 0; i < 4; ++i)
+    {
+      output->GetPoint(ptIds->GetId(i), x[i]);
+    }
+    const double radius2 = vtkTetra::Circumsphere(x[0], x[1], x[2], x[3], center);
+    for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+    {
+      double p[3];
+      input->GetPoint(ptId, p);
+      if (vtkMath::Distance2BetweenPoints(p, center) < radius2 * (1.0 - 1e-6))
+      {
+        vtkLog(ERROR, "Point " << ptId << " lies inside the circumsphere of tetra " << cellId);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestDelaunay3DThreads(int, char*[])
+{
+  vtkNew<vtkPointSource> pointSource;
+  pointSource->SetNumberOfPoints(2000);
+  pointSource->SetRadius(1.0);
+  pointSource->SetDistributionToUniform();
+
+  struct Configuration
+  {
+    double Alpha;
+    bool AlphaTets;
+    bool BoundingTriangulation;
+    int InsertionBatchSize;
+  };
+  const Configuration configurations[] = { { 0.0, true, false, 1 }, { 0.0, true, true, 1 },
+    { 0.15, true, false, 1 }, { 0.15, false, false, 1 }, { 0.15, true, true, 1 },
+    { 0.0, true, false, 64 }, { 0.15, true, true, 64 } };
+
+  bool success = true;
+  for (const Configuration& configuration : configurations)
+  {
+    vtkNew<vtkDelaunay3D> delaunay;
+    delaunay->SetInputConnection(pointSource->GetOutputPort());
+    delaunay->SetAlpha(configuration.Alpha);
+    delaunay->SetAlphaTets(configuration.AlphaTets);
+    delaunay->SetBoundingTriangulation(configuration.BoundingTriangulation);
+    delaunay->SetInsertionBatchSize(configuration.InsertionBatchSize);
+
+    vtkNew<vtkUnstructuredGrid> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(delaunay, 4, output) ||
+      output->GetNumberOfCells() == 0)
+    {
+      vtkLog(ERROR,
+        "Triangulation differs with alpha "
+          << configuration.Alpha << ", alpha tets " << configuration.AlphaTets
+          << ", bounding triangulation " << configuration.BoundingTriangulation
+          << " and insertion batch size " << configuration.InsertionBatchSize);
+      success = false;
+    }
+
+    // Without alpha nor bounding points, the tetrahedra are the Delaunay
+    // triangulation of the input points.
+    if (configuration.Alpha == 0.0 && !configuration.BoundingTriangulation &&
+      !::EmptyCircumspheres(output, pointSource->GetOutput()))
+    {
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkElevationFilter.h"
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStdFunctionArray.h"
+
+#include <cstdlib>
+#include <string>
+
+int TestElevationFilterImplicitArray(int, char*[])
+{
+  const vtkIdType numPts = 1000;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(-1.0, 2.0);
+    }
+    points->SetPoint(i, x);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  vtkNew<vtkElevationFilter> explicitElevation;
+  explicitElevation->SetInputData(input);
+  explicitElevation->SetLowPoint(0.0, 0.0, 0.0);
+  explicitElevation->SetHighPoint(1.0, 1.0, 1.0);
+  explicitElevation->SetScalarRange(-5.0, 5.0);
+  explicitElevation->Update();
+
+  vtkNew<vtkElevationFilter> implicitElevation;
+  implicitElevation->SetInputData(input);
+  implicitElevation->SetLowPoint(0.0, 0.0, 0.0);
+  implicitElevation->SetHighPoint(1.0, 1.0, 1.0);
+  implicitElevation->SetScalarRange(-5.0, 5.0);
+  implicitElevation->UseImplicitArraysOn();
+  implicitElevation->Update();
+
+  vtkDataArray* expected =
+    vtkDataSet::SafeDownCast(explicitElevation->GetOutput())->GetPointData()->GetScalars();
+  vtkDataArray* result =
+    vtkDataSet::SafeDownCast(implicitElevation->GetOutput())->GetPointData()->GetScalars();
+  if (!vtkFloatArray::SafeDownCast(expected))
+  {
+    vtkLog(ERROR, "Expected a vtkFloatArray when UseImplicitArrays is off.");
+    return EXIT_FAILURE;
+  }
+  if (!vtkStdFunctionArray<float>::SafeDownCast(result))
+  {
+    vtkLog(ERROR, "Expected a vtkStdFunctionArray when UseImplicitArrays is on.");
+    return EXIT_FAILURE;
+  }
+  if (result->GetNumberOfTuples() != numPts || std::string(result->GetName()) != "Elevation")
+  {
+    vtkLog(ERROR, "Wrong implicit elevation array size or name.");
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (expected->GetComponent(i, 0) != result->GetComponent(i, 0))
+    {
+      vtkLog(ERROR,
+        "Value mismatch at " << i << ": " << result->GetComponent(i, 0) << " instead of "
+                             << expected->GetComponent(i, 0));
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Inputs smaller than the threshold are materialized.
+  implicitElevation->SetImplicitArrayThreshold(numPts + 1);
+  implicitElevation->Update();
+  result = vtkDataSet::SafeDownCast(implicitElevation->GetOutput())->GetPointData()->GetScalars();
+  if (!vtkFloatArray::SafeDownCast(result))
+  {
+    vtkLog(ERROR, "Expected a vtkFloatArray below the implicit array threshold.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkExtractCells reuses its topology when only the input
+// attributes change, and rebuilds it when the input mesh changes.
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractCells.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+void FillScalars(vtkDoubleArray* pointScalars, vtkDoubleArray* cellScalars, double shift)
+{
+  for (vtkIdType i = 0; i < pointScalars->GetNumberOfValues(); ++i)
+  {
+    pointScalars->SetValue(i, i + shift);
+  }
+  for (vtkIdType i = 0; i < cellScalars->GetNumberOfValues(); ++i)
+  {
+    cellScalars->SetValue(i, -i - shift);
+  }
+  pointScalars->Modified();
+  cellScalars->Modified();
+}
+
+bool CheckAttributes(vtkUnstructuredGrid* output, vtkPolyData* input, double shift)
+{
+  auto pointScalars = output->GetPointData()->GetArray("PointScalars");
+  auto cellScalars = output->GetCellData()->GetArray("CellScalars");
+  auto cellIds = vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!pointScalars || !cellScalars || !cellIds)
+  {
+    vtkLog(ERROR, "Missing output arrays.");
+    return false;
+  }
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inCellId = cellIds->GetValue(cellId);
+    if (cellScalars->GetComponent(cellId, 0) != -inCellId - shift)
+    {
+      vtkLog(ERROR, "Wrong cell scalar for cell " << cellId);
+      return false;
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    // Points are not merged, so the input point can be found from its scalar
+    // and must match the output point coordinates.
+    const auto inPtId = static_cast<vtkIdType>(pointScalars->GetComponent(ptId, 0) - shift);
+    double inPt[3], outPt[3];
+    input->GetPoint(inPtId, inPt);
+    output->GetPoint(ptId, outPt);
+    if (inPt[0] != outPt[0] || inPt[1] != outPt[1] || inPt[2] != outPt[2])
+    {
+      vtkLog(ERROR, "Wrong point scalar for point " << ptId);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestExtractCellsReuseTopology(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(16);
+  sphere->SetPhiResolution(16);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfTuples(input->GetNumberOfPoints());
+  input->GetPointData()->AddArray(pointScalars);
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  cellScalars->SetNumberOfTuples(input->GetNumberOfCells());
+  input->GetCellData()->AddArray(cellScalars);
+  FillScalars(pointScalars, cellScalars, 0.0);
+
+  vtkNew<vtkExtractCells> extractor;
+  extractor->SetInputData(input);
+  extractor->AddCellRange(10, 100);
+  extractor->ReuseTopologyOn();
+  extractor->Update();
+  vtkSmartPointer<vtkPoints> extractedPoints = extractor->GetOutput()->GetPoints();
+  if (extractor->GetOutput()->GetNumberOfCells() != 91 ||
+    !CheckAttributes(extractor->GetOutput(), input, 0.0))
+  {
+    vtkLog(ERROR, "Wrong output on first execution.");
+    return EXIT_FAILURE;
+  }
+
+  // Only the attributes change: the topology must be reused.
+  FillScalars(pointScalars, cellScalars, 10.0);
+  extractor->Update();
+  if (extractor->GetOutput()->GetPoints() != extractedPoints ||
+    extractor->GetOutput()->GetNumberOfCells() != 91 ||
+    !CheckAttributes(extractor->GetOutput(), input, 10.0))
+  {
+    vtkLog(ERROR, "Topology was not reused when only attributes changed.");
+    return EXIT_FAILURE;
+  }
+
+  // The mesh changes: the topology must be rebuilt.
+  double pt[3];
+  input->GetPoints()->GetPoint(0, pt);
+  pt[0] += 1.0;
+  input->GetPoints()->SetPoint(0, pt);
+  input->GetPoints()->Modified();
+  extractor->Update();
+  if (extractor->GetOutput()->GetPoints() == extractedPoints ||
+    !CheckAttributes(extractor->GetOutput(), input, 10.0))
+  {
+    vtkLog(ERROR, "Topology was reused although the mesh changed.");
+    return EXIT_FAILURE;
+  }
+
+  // The cell selection changes: the topology must be rebuilt.
+  extractedPoints = extractor->GetOutput()->GetPoints();
+  extractor->AddCellRange(200, 210);
+  extractor->Update();
+  if (extractor->GetOutput()->GetPoints() == extractedPoints ||
+    extractor->GetOutput()->GetNumberOfCells() != 102)
+  {
+    vtkLog(ERROR, "Topology was reused although the cell list changed.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
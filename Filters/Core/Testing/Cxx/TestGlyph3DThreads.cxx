@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkGlyph3D produces the same glyphs whatever the number of
+// threads, that the parallel path matches the serial one and that the
+// instances it generates transform the source onto the glyphs, with and
+// without a source transform.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkElevationFilter.h"
+#include "vtkGlyph3D.h"
+#include "vtkLogger.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// The serial code path orders and fills the attributes differently, only
+// the geometry can be compared.
+vtkSmartPointer<vtkPolyData> Geometry(vtkPolyData* glyphs)
+{
+  auto geometry = vtkSmartPointer<vtkPolyData>::New();
+  geometry->SetPoints(glyphs->GetPoints());
+  geometry->SetPolys(glyphs->GetPolys());
+  return geometry;
+}
+
+// Check that the matrices of the instances transform the source points onto
+// the points of the copied glyphs.
+bool InstancesMatchGlyphs(vtkPolyData* instances, vtkPolyData* source, vtkPolyData* glyphs)
+{
+  vtkDataArray* transforms = instances->GetPointData()->GetArray("GlyphTransform");
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  if (!transforms || transforms->GetNumberOfComponents() != 16 ||
+    glyphs->GetNumberOfPoints() != instances->GetNumberOfPoints() * numSourcePts)
+  {
+    vtkLog(ERROR, "Instances and glyphs do not match in size.");
+    return false;
+  }
+  vtkNew<vtkMatrix4x4> matrix;
+  for (vtkIdType instanceId = 0; instanceId < instances->GetNumberOfPoints(); ++instanceId)
+  {
+    transforms->GetTuple(instanceId, &matrix->Element[0][0]);
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+    {
+      double p[4] = { 0.0, 0.0, 0.0, 1.0 }, expected[3];
+      source->GetPoint(i, p);
+      matrix->MultiplyPoint(p, p);
+      glyphs->GetPoint(instanceId * numSourcePts + i, expected);
+      if (std::abs(p[0] - expected[0]) > 1e-6 || std::abs(p[1] - expected[1]) > 1e-6 ||
+        std::abs(p[2] - expected[2]) > 1e-6)
+      {
+        vtkLog(ERROR, "Instance " << instanceId << " does not match its glyph.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestGlyph3DThreads(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(40);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0.0, 0.0, -0.5);
+  elevation->SetHighPoint(0.0, 0.0, 0.5);
+
+  vtkNew<vtkSphereSource> glyphSource;
+  glyphSource->SetRadius(0.05);
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputConnection(elevation->GetOutputPort());
+  glyph->SetSourceConnection(glyphSource->GetOutputPort());
+  glyph->SetVectorModeToUseNormal();
+  glyph->SetScaleModeToScaleByScalar();
+  glyph->SetColorModeToColorByScalar();
+  glyph->SetRange(0.0, 1.0);
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+
+  vtkNew<vtkPolyData> serial;
+  if (!vtkTestUtilities::CompareThreadedOutputs(glyph, 4, serial))
+  {
+    vtkLog(ERROR, "Threaded glyphing differs from the single threaded one.");
+    return EXIT_FAILURE;
+  }
+  vtkPolyData* threaded = glyph->GetOutput();
+
+  // One copy of the source per input point, centered on that point since the
+  // source sphere is symmetric about the origin.
+  vtkDataSet* input = elevation->GetOutput();
+  vtkPolyData* source = glyphSource->GetOutput();
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  vtkDataArray* inputIds = threaded->GetPointData()->GetArray("InputPointIds");
+  if (threaded->GetNumberOfPoints() != input->GetNumberOfPoints() * numSourcePts ||
+    threaded->GetNumberOfCells() != input->GetNumberOfPoints() * source->GetNumberOfCells() ||
+    !inputIds || !threaded->GetCellData()->GetScalars() || !threaded->GetPointData()->GetNormals())
+  {
+    vtkLog(ERROR, "Unexpected glyph output size or attributes.");
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType inPtId = 0; inPtId < input->GetNumberOfPoints(); ++inPtId)
+  {
+    double center[3] = { 0.0, 0.0, 0.0 }, p[3], expected[3];
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+    {
+      threaded->GetPoint(inPtId * numSourcePts + i, p);
+      for (int c = 0; c < 3; ++c)
+      {
+        center[c] += p[c] / numSourcePts;
+      }
+    }
+    input->GetPoint(inPtId, expected);
+    if (inputIds->GetTuple1(inPtId * numSourcePts) != inPtId ||
+      std::abs(center[0] - expected[0]) > 1e-6 || std::abs(center[1] - expected[1]) > 1e-6 ||
+      std::abs(center[2] - expected[2]) > 1e-6)
+    {
+      vtkLog(ERROR, "Glyph " << inPtId << " is not centered on its input point.");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Indexing into a table with a single glyph always goes through the
+  // serial code path and must produce the same geometry.
+  glyph->SetIndexModeToScalar();
+  vtkNew<vtkPolyData> indexed;
+  if (!vtkTestUtilities::CompareThreadedOutputs(glyph, 4, indexed) ||
+    !vtkTestUtilities::CompareDataObjectsExactly(::Geometry(indexed), ::Geometry(serial)))
+  {
+    vtkLog(ERROR, "Parallel glyphing differs from the serial code path.");
+    return EXIT_FAILURE;
+  }
+
+  // Instances must transform the source points onto the glyph points.
+  glyph->SetIndexModeToOff();
+  glyph->GenerateInstancesOn();
+  vtkNew<vtkPolyData> instances;
+  if (!vtkTestUtilities::CompareThreadedOutputs(glyph, 4, instances))
+  {
+    vtkLog(ERROR, "Threaded instancing differs from the single threaded one.");
+    return EXIT_FAILURE;
+  }
+  if (instances->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    instances->GetNumberOfVerts() != instances->GetNumberOfPoints() ||
+    !instances->GetPointData()->GetScalars() ||
+    !::InstancesMatchGlyphs(instances, source, serial))
+  {
+    vtkLog(ERROR, "Unexpected instance output.");
+    return EXIT_FAILURE;
+  }
+
+  // The source transform is part of the instance matrices. The transform is
+  // not symmetric so that applying it after the glyph transform would fail.
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->Translate(0.1, 0.0, 0.02);
+  sourceTransform->RotateY(30.0);
+  sourceTransform->Scale(2.0, 0.5, 1.0);
+  glyph->SetSourceTransform(sourceTransform);
+  glyph->GenerateInstancesOff();
+  glyph->Update();
+  vtkNew<vtkPolyData> transformedGlyphs;
+  transformedGlyphs->ShallowCopy(glyph->GetOutput());
+  glyph->GenerateInstancesOn();
+  glyph->Update();
+  if (!::InstancesMatchGlyphs(glyph->GetOutput(), source, transformedGlyphs))
+  {
+    vtkLog(ERROR, "Instances do not include the source transform.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkMaskPoints does not depend on the number of
+// threads in the strided and seeded modes, that the strided mode masks the
+// expected points, and that the chunked reservoir sampling gives the samples
+// of vtkReservoirSampler seeded for each chunk.
+
+#include "vtkDataArray.h"
+#include "vtkIdFilter.h"
+#include "vtkLogger.h"
+#include "vtkMaskPoints.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkReservoirSampler.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+// The seed vtkMaskPoints gives to the sampler of a chunk of 65536 points.
+vtkReservoirSamplerBase::SeedType GetChunkSeed(int seed, vtkIdType chunk)
+{
+  const unsigned long long chunkBits = static_cast<unsigned long long>(chunk);
+  std::seed_seq sequence{ static_cast<unsigned int>(seed), static_cast<unsigned int>(chunkBits),
+    static_cast<unsigned int>(chunkBits >> 32) };
+  vtkReservoirSamplerBase::SeedType chunkSeed;
+  sequence.generate(&chunkSeed, &chunkSeed + 1);
+  return chunkSeed;
+}
+
+// The masked points must carry the attributes of their input point.
+bool HasInputAttributes(vtkPolyData* output, vtkDataSet* input)
+{
+  vtkDataArray* ids = output->GetPointData()->GetArray("PointIds");
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    double y[3];
+    output->GetPoint(ptId, x);
+    input->GetPoint(static_cast<vtkIdType>(ids->GetComponent(ptId, 0)), y);
+    if (vtkMath::Distance2BetweenPoints(x, y) > 1e-10)
+    {
+      vtkLog(ERROR, "Point " << ptId << " has the attributes of another point.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestMaskPointsThreads(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -20, 20);
+  vtkNew<vtkIdFilter> waveletIds;
+  waveletIds->SetInputConnection(wavelet->GetOutputPort());
+  waveletIds->SetPointIdsArrayName("PointIds");
+  waveletIds->CellIdsOff();
+  waveletIds->Update();
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(100);
+  sphere->SetPhiResolution(100);
+  vtkNew<vtkIdFilter> sphereIds;
+  sphereIds->SetInputConnection(sphere->GetOutputPort());
+  sphereIds->SetPointIdsArrayName("PointIds");
+  sphereIds->CellIdsOff();
+  sphereIds->Update();
+
+  bool success = true;
+  for (int mode = -1; mode <= vtkMaskPoints::CHUNKED_RESERVOIR_SAMPLING; ++mode)
+  {
+    vtkDataSet* input = mode == vtkMaskPoints::UNIFORM_SPATIAL_SURFACE
+      ? sphereIds->GetOutput()
+      : vtkDataSet::SafeDownCast(waveletIds->GetOutput());
+    for (int singleVertexPerCell = 0; singleVertexPerCell < 2; ++singleVertexPerCell)
+    {
+      vtkNew<vtkMaskPoints> mask;
+      mask->SetInputData(input);
+      mask->SetRandomMode(mode >= 0);
+      mask->SetRandomModeType(mode >= 0 ? mode : 0);
+      mask->SetOnRatio(3);
+      mask->SetOffset(5);
+      mask->SetMaximumNumberOfPoints(5000);
+      mask->SetRandomSeed(37);
+      mask->GenerateVerticesOn();
+      mask->SetSingleVertexPerCell(singleVertexPerCell);
+
+      // The randomized strides, the random sampling and the spatially
+      // stratified sampling draw from the global random generators, so their
+      // samples differ from one run to the next.
+      vtkNew<vtkPolyData> output;
+      bool reproducible = true;
+      if (mode >= 0 && mode <= vtkMaskPoints::SPATIALLY_STRATIFIED)
+      {
+        mask->Update();
+        output->ShallowCopy(mask->GetOutput());
+      }
+      else
+      {
+        reproducible = vtkTestUtilities::CompareThreadedOutputs(mask, 4, output);
+      }
+      if (!reproducible || output->GetNumberOfPoints() == 0 ||
+        output->GetNumberOfVerts() != (singleVertexPerCell ? output->GetNumberOfPoints() : 1) ||
+        !HasInputAttributes(output, input))
+      {
+        vtkLog(ERROR, "Masks differ with 1 and 4 threads, mode " << mode);
+        success = false;
+      }
+      else if (mode < 0)
+      {
+        // The stride loop stops once more than MaximumNumberOfPoints points are masked.
+        vtkDataArray* ids = output->GetPointData()->GetArray("PointIds");
+        bool strided = output->GetNumberOfPoints() == 5001;
+        for (vtkIdType ptId = 0; strided && ptId < output->GetNumberOfPoints(); ++ptId)
+        {
+          strided = ids->GetComponent(ptId, 0) == 5 + 3 * ptId;
+        }
+        if (!strided)
+        {
+          vtkLog(ERROR, "Wrong strided points.");
+          success = false;
+        }
+      }
+    }
+  }
+
+  // The chunked reservoir sampling concatenates the samples of the chunks of
+  // 65536 points, each drawn by a sampler seeded from the chunk and sharing
+  // the requested size in proportion to the chunk sizes.
+  vtkNew<vtkMaskPoints> mask;
+  mask->SetInputConnection(waveletIds->GetOutputPort());
+  mask->RandomModeOn();
+  mask->SetRandomModeType(vtkMaskPoints::CHUNKED_RESERVOIR_SAMPLING);
+  mask->SetMaximumNumberOfPoints(12345);
+  mask->SetRandomSeed(5);
+  mask->Update();
+  const vtkIdType numPts = 41 * 41 * 41;
+  const vtkIdType firstChunkSampleSize = 12345 * 65536 / numPts;
+  vtkReservoirSampler<vtkIdType> sampler;
+  std::vector<vtkIdType> expected = sampler(firstChunkSampleSize, 65536, ::GetChunkSeed(5, 0));
+  for (vtkIdType ptId : sampler(12345 - firstChunkSampleSize, numPts - 65536, ::GetChunkSeed(5, 1)))
+  {
+    expected.push_back(65536 + ptId);
+  }
+  vtkPolyData* sample = mask->GetOutput();
+  vtkDataArray* ids = sample->GetPointData()->GetArray("PointIds");
+  bool sameIds = sample->GetNumberOfPoints() == static_cast<vtkIdType>(expected.size());
+  for (vtkIdType ptId = 0; sameIds && ptId < sample->GetNumberOfPoints(); ++ptId)
+  {
+    sameIds = ids->GetComponent(ptId, 0) == expected[ptId];
+  }
+  if (sample->GetNumberOfPoints() != 12345 || !sameIds)
+  {
+    vtkLog(ERROR, "Unexpected chunked reservoir sample.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkQuadricDecimation produces the same output whatever the
+// number of threads, both when only the quadrics and the edge costs are
+// computed in parallel and with ParallelCollapses on, and that both modes
+// produce valid meshes with the target reduction.
+
+#include "vtkCellArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace
+{
+constexpr double TargetReduction = 0.8;
+
+// Check that the output only has non degenerate triangles facing outward from
+// the center of the sphere, each edge being used by at most two of them.
+bool IsValidMesh(vtkPolyData* output)
+{
+  std::map<std::pair<vtkIdType, vtkIdType>, int> edgeUses;
+  std::set<std::set<vtkIdType>> triangles;
+  vtkCellArray* polys = output->GetPolys();
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < polys->GetNumberOfCells(); ++cellId)
+  {
+    polys->GetCellAtId(cellId, pts);
+    if (pts->GetNumberOfIds() != 3 || pts->GetId(0) == pts->GetId(1) ||
+      pts->GetId(1) == pts->GetId(2) || pts->GetId(0) == pts->GetId(2))
+    {
+      vtkLog(ERROR, "Cell " << cellId << " is not a triangle.");
+      return false;
+    }
+    if (!triangles.insert({ pts->GetId(0), pts->GetId(1), pts->GetId(2) }).second)
+    {
+      vtkLog(ERROR, "Cell " << cellId << " is duplicated.");
+      return false;
+    }
+
+    double p[3][3], e1[3], e2[3], normal[3], center[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      output->GetPoint(pts->GetId(i), p[i]);
+      vtkIdType edge[2] = { pts->GetId(i), pts->GetId((i + 1) % 3) };
+      if (++edgeUses[std::make_pair(std::min(edge[0], edge[1]), std::max(edge[0], edge[1]))] > 2)
+      {
+        vtkLog(ERROR, "Edge of cell " << cellId << " is used by more than two triangles.");
+        return false;
+      }
+    }
+    vtkMath::Subtract(p[1], p[0], e1);
+    vtkMath::Subtract(p[2], p[0], e2);
+    vtkMath::Cross(e1, e2, normal);
+    for (int i = 0; i < 3; ++i)
+    {
+      center[i] = (p[0][i] + p[1][i] + p[2][i]) / 3.0;
+    }
+    if (vtkMath::Dot(normal, center) <= 0.0)
+    {
+      vtkLog(ERROR, "Cell " << cellId << " is degenerate or flipped.");
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestQuadricDecimationThreads(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(60);
+  sphere->SetStartTheta(30.0); // open the sphere to have boundary constraints
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  sphere->Update();
+  const vtkIdType numTris = sphere->GetOutput()->GetNumberOfPolys();
+
+  for (bool parallelCollapses : { false, true })
+  {
+    for (bool attributes : { false, true })
+    {
+      vtkNew<vtkQuadricDecimation> decimator;
+      decimator->SetInputConnection(elevation->GetOutputPort());
+      decimator->SetTargetReduction(::TargetReduction);
+      decimator->SetAttributeErrorMetric(attributes);
+      decimator->SetVolumePreservation(true);
+      decimator->SetParallelCollapses(parallelCollapses);
+      vtkNew<vtkPolyData> serial;
+      if (!vtkTestUtilities::CompareThreadedOutputs(decimator, 4, serial))
+      {
+        vtkLog(ERROR,
+          "Threaded decimation differs, parallel collapses: "
+            << parallelCollapses << ", attribute error metric: " << attributes);
+        return EXIT_FAILURE;
+      }
+
+      // Most collapses delete two triangles, the last one may exceed the target.
+      const vtkIdType numOutputTris = serial->GetNumberOfPolys();
+      if (decimator->GetActualReduction() < ::TargetReduction ||
+        numOutputTris > (1.0 - ::TargetReduction) * numTris + 0.5 ||
+        numOutputTris < (1.0 - ::TargetReduction) * numTris - 2.5)
+      {
+        vtkLog(ERROR,
+          "Unexpected reduction " << decimator->GetActualReduction() << ": " << numOutputTris
+                                  << " of " << numTris << " triangles, parallel collapses: "
+                                  << parallelCollapses << ", attribute error metric: "
+                                  << attributes);
+        return EXIT_FAILURE;
+      }
+      if (!::IsValidMesh(serial))
+      {
+        vtkLog(ERROR,
+          "Invalid decimated mesh, parallel collapses: "
+            << parallelCollapses << ", attribute error metric: " << attributes);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkSmoothPolyDataFilter gives the same result whatever the
+// number of threads, with Gauss-Seidel and Jacobi iterations, constrained
+// to a source surface or not, and that constrained points stay on the
+// source surface.
+
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+
+namespace
+{
+bool PointsMoved(vtkPoints* input, vtkPoints* output)
+{
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double p1[3], p2[3];
+    input->GetPoint(ptId, p1);
+    output->GetPoint(ptId, p2);
+    if (p1[0] != p2[0] || p1[1] != p2[1] || p1[2] != p2[2])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Points constrained to the source sphere stay on its facets.
+bool OnSphereFacets(vtkPoints* points, double minRadius, double maxRadius)
+{
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3];
+    points->GetPoint(ptId, p);
+    const double radius = vtkMath::Norm(p);
+    if (radius < minRadius || radius > maxRadius)
+    {
+      vtkLog(ERROR, "Point " << ptId << " is off the source surface, at radius " << radius);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSmoothPolyDataFilterThreads(int, char*[])
+{
+  // An open sphere, so that there are boundary edges, with noisy points
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->SetEndTheta(270.0);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+  unsigned int seed = 4321;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3];
+    input->GetPoint(ptId, p);
+    for (int i = 0; i < 3; ++i)
+    {
+      seed = seed * 1103515245u + 12345u;
+      p[i] += 0.02 * (static_cast<double>((seed >> 16) % 1000) / 1000.0 - 0.5);
+    }
+    input->GetPoints()->SetPoint(ptId, p);
+  }
+
+  bool success = true;
+  for (int mode : { vtkSmoothPolyDataFilter::GAUSS_SEIDEL_ITERATIONS,
+         vtkSmoothPolyDataFilter::JACOBI_ITERATIONS })
+  {
+    for (int constrained = 0; constrained < 2; ++constrained)
+    {
+      vtkNew<vtkSmoothPolyDataFilter> smooth;
+      smooth->SetInputData(input);
+      smooth->SetIterationMode(mode);
+      smooth->SetNumberOfIterations(30);
+      smooth->SetRelaxationFactor(0.2);
+      smooth->FeatureEdgeSmoothingOn();
+      smooth->SetFeatureAngle(30.0);
+      if (constrained)
+      {
+        smooth->SetSourceData(sphere->GetOutput());
+      }
+
+      vtkNew<vtkPolyData> output;
+      if (!vtkTestUtilities::CompareThreadedOutputs(smooth, 4, output) ||
+        !::PointsMoved(input->GetPoints(), output->GetPoints()) ||
+        (constrained && !::OnSphereFacets(output->GetPoints(), 0.49, 0.5 + 1e-6)))
+      {
+        vtkLog(ERROR,
+          "Wrong smoothing with iteration mode " << mode << (constrained ? ", constrained" : ""));
+        success = false;
+      }
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel vtkFeatureEdges, vtkTriangleFilter and vtkStripper
+// produce the same output whatever the number of threads, and that the
+// triangles and strips cover the expected number of triangles.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkIdFilter.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkRegularPolygonSource.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkTestUtilities.h"
+#include "vtkTriangleFilter.h"
+
+#include <cstdlib>
+
+namespace
+{
+bool TestFilter(vtkPolyDataAlgorithm* filter, vtkPolyData* output, const char* name)
+{
+  if (!vtkTestUtilities::CompareThreadedOutputs(filter, 4, output) ||
+    output->GetNumberOfCells() == 0)
+  {
+    vtkLog(ERROR, << name << " differs with 1 and 4 threads.");
+    return false;
+  }
+  return true;
+}
+
+// Number of triangles of the polygons and strips.
+vtkIdType CountTriangles(vtkPolyData* output)
+{
+  vtkIdType numTriangles = 0;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    switch (output->GetCellType(cellId))
+    {
+      case VTK_TRIANGLE:
+        ++numTriangles;
+        break;
+      case VTK_TRIANGLE_STRIP:
+        output->GetCellPoints(cellId, pts);
+        numTriangles += pts->GetNumberOfIds() - 2;
+        break;
+      case VTK_VERTEX:
+      case VTK_POLY_VERTEX:
+      case VTK_LINE:
+      case VTK_POLY_LINE:
+        break;
+      default:
+        vtkLog(ERROR, "Unexpected cell type " << output->GetCellType(cellId));
+        return -1;
+    }
+  }
+  return numTriangles;
+}
+}
+
+int TestSurfaceFiltersThreads(int, char*[])
+{
+  // Triangles, quads, a polygon and strips, with their cell ids.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(20, 20);
+  plane->SetOrigin(2.0, 0.0, 0.0);
+  plane->SetPoint1(3.0, 0.0, 0.0);
+  plane->SetPoint2(2.0, 1.0, 0.0);
+
+  vtkNew<vtkRegularPolygonSource> polygon;
+  polygon->SetNumberOfSides(12);
+  polygon->SetCenter(-2.0, 0.0, 0.0);
+
+  vtkNew<vtkSphereSource> stripSphere;
+  stripSphere->SetCenter(0.0, 2.0, 0.0);
+  stripSphere->SetThetaResolution(32);
+  stripSphere->SetPhiResolution(32);
+  vtkNew<vtkStripper> sphereStrips;
+  sphereStrips->SetInputConnection(stripSphere->GetOutputPort());
+
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(sphere->GetOutputPort());
+  append->AddInputConnection(plane->GetOutputPort());
+  append->AddInputConnection(polygon->GetOutputPort());
+  append->AddInputConnection(sphereStrips->GetOutputPort());
+
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(append->GetOutputPort());
+  ids->PointIdsOff();
+  ids->SetCellIdsArrayName("CellIds");
+
+  bool success = true;
+
+  vtkNew<vtkFeatureEdges> featureEdges;
+  featureEdges->SetInputConnection(ids->GetOutputPort());
+  featureEdges->SetFeatureAngle(5.0);
+  featureEdges->ManifoldEdgesOn();
+  vtkNew<vtkPolyData> edges;
+  success &= TestFilter(featureEdges, edges, "vtkFeatureEdges");
+
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(ids->GetOutputPort());
+  vtkNew<vtkPolyData> triangulated;
+  success &= TestFilter(triangles, triangulated, "vtkTriangleFilter");
+
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(triangles->GetOutputPort());
+  stripper->PassCellDataAsFieldDataOn();
+  vtkNew<vtkPolyData> stripped;
+  success &= TestFilter(stripper, stripped, "vtkStripper");
+
+  // A sphere of theta and phi resolutions n and m has 2 * n * (m - 2)
+  // triangles, the plane has 400 quads and the polygon 12 sides.
+  const vtkIdType expectedTriangles = 2 * 64 * 62 + 2 * 32 * 30 + 400 * 2 + 10;
+  const vtkIdType numTriangulated = ::CountTriangles(triangulated);
+  const vtkIdType numStripped = ::CountTriangles(stripped);
+  if (numTriangulated != expectedTriangles || numStripped != expectedTriangles)
+  {
+    vtkLog(ERROR,
+      "Expected " << expectedTriangles << " triangles, got " << numTriangulated
+                  << " from vtkTriangleFilter and " << numStripped << " from vtkStripper.");
+    success = false;
+  }
+
+  // The segments of the polygon outline, the only input line and so cell 0,
+  // come first and keep its id.
+  vtkDataArray* cellIds = triangulated->GetCellData()->GetArray("CellIds");
+  for (vtkIdType cellId = 0; cellId < triangulated->GetNumberOfLines(); ++cellId)
+  {
+    if (cellIds->GetTuple1(cellId) != 0)
+    {
+      vtkLog(ERROR, "Wrong cell id " << cellIds->GetTuple1(cellId) << " for segment " << cellId);
+      success = false;
+      break;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkTubeFilter produces the same output whatever the number of
+// threads, on polylines sharing points and with degenerate segments, and that
+// the tubes are placed around the polylines.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Helices starting from a shared seed point, optionally with a repeated
+// point in each of them, plus a polyline made of a single point.
+vtkSmartPointer<vtkPolyData> MakeLines(
+  vtkIdType numLines, vtkIdType numPtsPerLine, bool repeatPoint)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> lineIds;
+  lineIds->SetName("LineIds");
+
+  const vtkIdType seedId = points->InsertNextPoint(0.0, 0.0, 0.0);
+  scalars->InsertNextValue(1.0);
+  for (vtkIdType lineId = 0; lineId < numLines; lineId++)
+  {
+    const double angle = 2.0 * vtkMath::Pi() * lineId / numLines;
+    lines->InsertNextCell(numPtsPerLine + (repeatPoint ? 2 : 1));
+    lines->InsertCellPoint(seedId);
+    for (vtkIdType i = 1; i <= numPtsPerLine; i++)
+    {
+      const double t = 0.1 * i;
+      const vtkIdType ptId = points->InsertNextPoint(
+        t * std::cos(angle) + 0.05 * std::cos(5.0 * t), t * std::sin(angle), 0.2 * std::sin(t));
+      scalars->InsertNextValue(1.0 + t);
+      lines->InsertCellPoint(ptId);
+      if (repeatPoint && i == numPtsPerLine / 2)
+      {
+        lines->InsertCellPoint(ptId);
+      }
+    }
+    lineIds->InsertNextValue(static_cast<int>(lineId));
+  }
+  lines->InsertNextCell(1, &seedId);
+  lineIds->InsertNextValue(static_cast<int>(numLines));
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetLines(lines);
+  polyData->GetPointData()->SetScalars(scalars);
+  polyData->GetCellData()->AddArray(lineIds);
+  return polyData;
+}
+
+// Each of the `numLines` helices of `numPtsPerLine + 1` distinct points gets
+// `pointsPerLinePoint` points around each of its points, at `distance` from it.
+bool CheckPlacement(vtkPolyData* lines, vtkPolyData* output, vtkIdType numLines,
+  vtkIdType numPtsPerLine, int pointsPerLinePoint, double distance)
+{
+  if (output->GetNumberOfPoints() != numLines * (numPtsPerLine + 1) * pointsPerLinePoint)
+  {
+    vtkLog(ERROR, "Unexpected number of tube points: " << output->GetNumberOfPoints());
+    return false;
+  }
+  vtkIdType outPtId = 0;
+  for (vtkIdType lineId = 0; lineId < numLines; lineId++)
+  {
+    for (vtkIdType i = 0; i <= numPtsPerLine; i++)
+    {
+      double center[3];
+      lines->GetPoint(i == 0 ? 0 : 1 + lineId * numPtsPerLine + i - 1, center);
+      for (int j = 0; j < pointsPerLinePoint; j++, outPtId++)
+      {
+        double p[3];
+        output->GetPoint(outPtId, p);
+        if (std::abs(std::sqrt(vtkMath::Distance2BetweenPoints(p, center)) - distance) > 1e-6)
+        {
+          vtkLog(ERROR, "Point " << outPtId << " is not at the expected distance of its line.");
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestTubeFilterThreads(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> lines = ::MakeLines(200, 50, true);
+
+  vtkNew<vtkTubeFilter> tubes;
+  tubes->SetInputData(lines);
+  tubes->SetRadius(0.01);
+  tubes->SetNumberOfSides(7);
+  tubes->SetOnRatio(2);
+  tubes->SetVaryRadiusToVaryRadiusByScalar();
+  tubes->SetGenerateTCoordsToUseLength();
+  for (bool capping : { false, true })
+  {
+    for (bool shareVertices : { true, false })
+    {
+      tubes->SetCapping(capping);
+      tubes->SetSidesShareVertices(shareVertices);
+      if (!vtkTestUtilities::CompareThreadedOutputs(tubes) ||
+        tubes->GetOutput()->GetNumberOfStrips() == 0)
+      {
+        vtkLog(ERROR,
+          "Threaded tubes differ, capping: " << capping << ", sides share vertices: "
+                                             << shareVertices);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // With a constant radius, the repeated points skipped and the single point
+  // polyline ignored, the sides are at the radius of the polyline points.
+  tubes->SetVaryRadiusToVaryRadiusOff();
+  tubes->SetOnRatio(1);
+  tubes->CappingOff();
+  tubes->SidesShareVerticesOn();
+  vtkNew<vtkPolyData> output;
+  if (!vtkTestUtilities::CompareThreadedOutputs(tubes, 4, output) ||
+    output->GetNumberOfStrips() != 200 * 7 ||
+    !::CheckPlacement(lines, output, 200, 50, 7, 0.01))
+  {
+    vtkLog(ERROR, "Unexpected tubes.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
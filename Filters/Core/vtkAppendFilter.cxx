@@ -4,8 +4,10 @@
 
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataSetCollection.h"
+#include "vtkGenericCell.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalOctreePointLocator.h"
 #include "vtkInformation.h"
@@ -13,12 +15,21 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkAppendFilter);
@@ -112,6 +123,89 @@ struct RenumberingVisitor
     }
   }
 };
+
+// Index of the input holding an element, given the offsets of the elements
+// of the inputs.
+vtkIdType FindInput(const std::vector<vtkIdType>& offsets, vtkIdType id)
+{
+  return static_cast<vtkIdType>(
+           std::upper_bound(offsets.begin(), offsets.end(), id) - offsets.begin()) -
+    1;
+}
+
+// Atomically raise value to candidate if candidate is larger.
+void AtomicMax(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate > current && !value.compare_exchange_weak(current, candidate))
+  {
+  }
+}
+
+// Merge the exactly coincident points of allPts in parallel into newPts.
+// Points are numbered as with an incremental locator inserting them in
+// order: each group of coincident points gets the rank of its lowest point
+// id. ptMap maps the points of allPts to the points of newPts.
+void MergeCoincidentPoints(vtkPoints* allPts, vtkPoints* newPts, std::vector<vtkIdType>& ptMap)
+{
+  const vtkIdType numPts = allPts->GetNumberOfPoints();
+  vtkNew<vtkPolyData> pointSet;
+  pointSet->SetPoints(allPts);
+
+  // Map each point to a representative of its group of coincident points.
+  std::vector<vtkIdType> mergeMap(numPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(pointSet);
+  locator->BuildLocator();
+  locator->MergePoints(0.0, mergeMap.data());
+
+  // Find the lowest point of each group.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstIds(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstIds[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      std::atomic<vtkIdType>& firstId = firstIds[mergeMap[ptId]];
+      vtkIdType current = firstId.load(std::memory_order_relaxed);
+      while (ptId < current && !firstId.compare_exchange_weak(current, ptId))
+      {
+      }
+    }
+  });
+
+  // Number the groups in the order of their lowest point, then map the
+  // other points of the groups.
+  vtkIdType numNewPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (firstIds[mergeMap[ptId]].load(std::memory_order_relaxed) == ptId)
+    {
+      ptMap[ptId] = numNewPts++;
+    }
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType firstId = firstIds[mergeMap[ptId]].load(std::memory_order_relaxed);
+      if (firstId == ptId)
+      {
+        allPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptMap[ptId], x);
+      }
+      else
+      {
+        ptMap[ptId] = ptMap[firstId];
+      }
+    }
+  });
+}
 }
 
 //------------------------------------------------------------------------------
@@ -236,39 +330,96 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  // If we aren't merging points, we need to allocate the points here.
-  if (!reallyMergePoints)
+  // Gather the inputs with the offsets of their points and cells in the
+  // output, so that they can be copied in parallel.
+  std::vector<vtkDataSet*> dataSets;
+  std::vector<vtkIdType> ptOffsets(1, 0);
+  std::vector<vtkIdType> cellOffsets(1, 0);
+  bool hasPolyhedra = false;
+  inputs->InitTraversal(iter);
+  while ((dataSet = inputs->GetNextDataSet(iter)))
   {
-    newPts->SetNumberOfPoints(totalNumPts);
+    dataSets.push_back(dataSet);
+    ptOffsets.push_back(ptOffsets.back() + dataSet->GetNumberOfPoints());
+    cellOffsets.push_back(cellOffsets.back() + dataSet->GetNumberOfCells());
+    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
+    hasPolyhedra |= ug && ug->GetPolyhedronFaces();
+    if (dataSet->GetNumberOfCells() > 0)
+    {
+      // Make the cell API of the input thread safe.
+      vtkNew<vtkGenericCell> cell;
+      dataSet->GetCell(0, cell);
+    }
   }
 
-  vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
-  ptIds->Allocate(VTK_CELL_SIZE);
-  vtkSmartPointer<vtkIdList> newPtIds = vtkSmartPointer<vtkIdList>::New();
-  newPtIds->Allocate(VTK_CELL_SIZE);
-
-  vtkIdType twentieth = (totalNumPts + totalNumCells) / 20 + 1;
+  // Exactly coincident points are merged in parallel, with the numbering of
+  // the incremental insertion, as long as the input coordinates are stored
+  // without conversion in the output points.
+  bool mergeInParallel = reallyMergePoints && !globalIdsArray && this->Tolerance == 0.0;
+  if (mergeInParallel && newPts->GetDataType() != VTK_DOUBLE)
+  {
+    for (vtkDataSet* ds : dataSets)
+    {
+      vtkPointSet* ps = vtkPointSet::SafeDownCast(ds);
+      if (ds->GetNumberOfPoints() > 0 &&
+        (!ps || ps->GetPoints()->GetDataType() != newPts->GetDataType()))
+      {
+        mergeInParallel = false;
+        break;
+      }
+    }
+  }
 
   // For optionally merging duplicate points
-  vtkIdType* globalIndices = new vtkIdType[totalNumPts];
+  std::vector<vtkIdType> globalIndices(totalNumPts);
 
-  vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter;
-  if (reallyMergePoints)
+  bool abort = false;
+  if (!reallyMergePoints || mergeInParallel)
+  {
+    vtkSmartPointer<vtkPoints> allPts = newPts;
+    if (reallyMergePoints)
+    {
+      allPts = vtkSmartPointer<vtkPoints>::New();
+      allPts->SetDataType(newPts->GetDataType());
+    }
+    allPts->SetNumberOfPoints(totalNumPts);
+    vtkSMPTools::For(0, totalNumPts, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType idx = ::FindInput(ptOffsets, begin);
+      double p[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        while (ptId >= ptOffsets[idx + 1])
+        {
+          ++idx;
+        }
+        dataSets[idx]->GetPoint(ptId - ptOffsets[idx], p);
+        allPts->SetPoint(ptId, p);
+        globalIndices[ptId] = ptId;
+      }
+    });
+    if (reallyMergePoints)
+    {
+      ::MergeCoincidentPoints(allPts, newPts, globalIndices);
+    }
+    this->UpdateProgress(0.25);
+    abort = this->CheckAbort();
+  }
+  else
   {
     vtkBoundingBox outputBB;
-    inputs->InitTraversal(iter);
-    while ((dataSet = inputs->GetNextDataSet(iter)))
+    for (vtkDataSet* ds : dataSets)
     {
       // Union of bounding boxes
       double localBox[6];
-      dataSet->GetBounds(localBox);
+      ds->GetBounds(localBox);
       outputBB.AddBounds(localBox);
     }
 
     double outputBounds[6];
     outputBB.GetBounds(outputBounds);
 
-    ptInserter = vtkSmartPointer<vtkIncrementalOctreePointLocator>::New();
+    vtkSmartPointer<vtkIncrementalOctreePointLocator> ptInserter =
+      vtkSmartPointer<vtkIncrementalOctreePointLocator>::New();
     if (this->ToleranceIsAbsolute)
     {
       ptInserter->SetTolerance(this->Tolerance);
@@ -279,28 +430,19 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
 
     ptInserter->InitPointInsertion(newPts, outputBounds);
-  }
 
-  // append the blocks / pieces in terms of the geometry and topology
-  std::unordered_map<vtkIdType, vtkIdType> addedPointsMap;
-  vtkIdType count = 0;
-  vtkIdType ptOffset = 0;
-  float decimal = 0.0;
-  inputs->InitTraversal(iter);
-  bool abort = false;
-  double p[3];
-  while (!abort && (dataSet = inputs->GetNextDataSet(iter)))
-  {
-    vtkIdType dataSetNumPts = dataSet->GetNumberOfPoints();
-    vtkIdType dataSetNumCells = dataSet->GetNumberOfCells();
-    vtkIdTypeArray* dataSetGlobalIdsArray = globalIdsArray
-      ? vtkIdTypeArray::SafeDownCast(dataSet->GetPointData()->GetGlobalIds())
-      : nullptr;
-
-    // copy points
-    for (vtkIdType ptId = 0; ptId < dataSetNumPts && !abort; ++ptId)
+    // Merge the points of the inputs, in order.
+    std::unordered_map<vtkIdType, vtkIdType> addedPointsMap;
+    vtkIdType twentieth = totalNumPts / 5 + 1;
+    double p[3];
+    for (size_t idx = 0; idx < dataSets.size() && !abort; ++idx)
     {
-      if (reallyMergePoints)
+      vtkDataSet* ds = dataSets[idx];
+      const vtkIdType ptOffset = ptOffsets[idx];
+      vtkIdTypeArray* dataSetGlobalIdsArray = globalIdsArray
+        ? vtkIdTypeArray::SafeDownCast(ds->GetPointData()->GetGlobalIds())
+        : nullptr;
+      for (vtkIdType ptId = 0; ptId < ds->GetNumberOfPoints() && !abort; ++ptId)
       {
         if (dataSetGlobalIdsArray)
         {
@@ -309,7 +451,7 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
           if (it == addedPointsMap.end())
           {
             globalIndices[ptId + ptOffset] = newPts->GetNumberOfPoints();
-            dataSet->GetPoint(ptId, p);
+            ds->GetPoint(ptId, p);
             vtkIdType newPtId = newPts->InsertNextPoint(p);
             addedPointsMap.emplace(globalId, newPtId);
           }
@@ -321,67 +463,124 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
         else
         {
           vtkIdType globalPtId = 0;
-          dataSet->GetPoint(ptId, p);
+          ds->GetPoint(ptId, p);
           ptInserter->InsertUniquePoint(p, globalPtId);
           globalIndices[ptId + ptOffset] = globalPtId;
           // The point inserter puts the point into newPts, so we don't have to do that here.
         }
-      }
-      else
-      {
-        globalIndices[ptId + ptOffset] = ptId + ptOffset;
-        dataSet->GetPoint(ptId, p);
-        newPts->SetPoint(ptId + ptOffset, p);
-      }
 
-      // Update progress
-      count++;
-      if (!(count % twentieth))
-      {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->CheckAbort();
+        // Update progress
+        if (!((ptId + ptOffset + 1) % twentieth))
+        {
+          this->UpdateProgress(0.05 * (ptId + ptOffset + 1) / twentieth);
+          abort = this->CheckAbort();
+        }
       }
     }
+  }
 
-    // copy cell
-    vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(dataSet);
-    for (vtkIdType cellId = 0; cellId < dataSetNumCells && !abort; ++cellId)
-    {
-      newPtIds->Reset();
-      if (ug && dataSet->GetCellType(cellId) == VTK_POLYHEDRON)
+  // append the blocks / pieces in terms of the topology
+  if (!abort && !hasPolyhedra)
+  {
+    // Count the points of the cells, then copy them in parallel with their
+    // point ids renumbered.
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(totalNumCells + 1);
+    vtkNew<vtkUnsignedCharArray> types;
+    types->SetNumberOfValues(totalNumCells);
+    vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+    vtkSMPTools::For(0, totalNumCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = tlPtIds.Local();
+      vtkIdType idx = ::FindInput(cellOffsets, begin);
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
       {
-        vtkNew<vtkCellArray> faces;
-        ug->GetPolyhedronFaces(cellId, faces);
-        faces->Visit(RenumberingVisitor{}, globalIndices, ptOffset);
-        dataSet->GetCellPoints(cellId, ptIds);
-        for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+        while (cellId >= cellOffsets[idx + 1])
         {
-          newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          ++idx;
         }
-        output->InsertNextCell(
-          VTK_POLYHEDRON, newPtIds->GetNumberOfIds(), newPtIds->GetPointer(0), faces);
+        const vtkIdType inCellId = cellId - cellOffsets[idx];
+        dataSets[idx]->GetCellPoints(inCellId, ptIds);
+        offsets->SetValue(cellId, ptIds->GetNumberOfIds());
+        types->SetValue(cellId, static_cast<unsigned char>(dataSets[idx]->GetCellType(inCellId)));
       }
-      else
+    });
+    vtkIdType connSize = 0;
+    for (vtkIdType cellId = 0; cellId < totalNumCells; ++cellId)
+    {
+      const vtkIdType npts = offsets->GetValue(cellId);
+      offsets->SetValue(cellId, connSize);
+      connSize += npts;
+    }
+    offsets->SetValue(totalNumCells, connSize);
+    this->UpdateProgress(0.5);
+
+    vtkNew<vtkIdTypeArray> conn;
+    conn->SetNumberOfValues(connSize);
+    vtkSMPTools::For(0, totalNumCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = tlPtIds.Local();
+      vtkIdType idx = ::FindInput(cellOffsets, begin);
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
       {
-        dataSet->GetCellPoints(cellId, ptIds);
+        while (cellId >= cellOffsets[idx + 1])
+        {
+          ++idx;
+        }
+        dataSets[idx]->GetCellPoints(cellId - cellOffsets[idx], ptIds);
+        vtkIdType connId = offsets->GetValue(cellId);
         for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
         {
-          newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          conn->SetValue(connId++, globalIndices[ptIds->GetId(id) + ptOffsets[idx]]);
         }
-        output->InsertNextCell(dataSet->GetCellType(cellId), newPtIds);
       }
+    });
+    vtkNew<vtkCellArray> cells;
+    cells->SetData(offsets, conn);
+    output->SetCells(types, cells);
+    this->UpdateProgress(0.6);
+  }
+  else
+  {
+    vtkSmartPointer<vtkIdList> ptIds = vtkSmartPointer<vtkIdList>::New();
+    ptIds->Allocate(VTK_CELL_SIZE);
+    vtkSmartPointer<vtkIdList> newPtIds = vtkSmartPointer<vtkIdList>::New();
+    newPtIds->Allocate(VTK_CELL_SIZE);
+
+    for (size_t idx = 0; idx < dataSets.size() && !abort; ++idx)
+    {
+      vtkDataSet* ds = dataSets[idx];
+      const vtkIdType ptOffset = ptOffsets[idx];
 
-      // Update progress
-      count++;
-      if (!(count % twentieth))
+      // copy cell
+      vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(ds);
+      for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
       {
-        decimal += 0.05;
-        this->UpdateProgress(decimal);
-        abort = this->CheckAbort();
+        newPtIds->Reset();
+        if (ug && ds->GetCellType(cellId) == VTK_POLYHEDRON)
+        {
+          vtkNew<vtkCellArray> faces;
+          ug->GetPolyhedronFaces(cellId, faces);
+          faces->Visit(RenumberingVisitor{}, globalIndices.data(), ptOffset);
+          ds->GetCellPoints(cellId, ptIds);
+          for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+          {
+            newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          }
+          output->InsertNextCell(
+            VTK_POLYHEDRON, newPtIds->GetNumberOfIds(), newPtIds->GetPointer(0), faces);
+        }
+        else
+        {
+          ds->GetCellPoints(cellId, ptIds);
+          for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+          {
+            newPtIds->InsertId(id, globalIndices[ptIds->GetId(id) + ptOffset]);
+          }
+          output->InsertNextCell(ds->GetCellType(cellId), newPtIds);
+        }
       }
+      this->UpdateProgress(0.25 + 0.35 * (idx + 1) / dataSets.size());
+      abort = this->CheckAbort();
     }
-    ptOffset += dataSetNumPts;
   }
 
   // this filter can copy global ids except for global point ids when merging
@@ -396,8 +595,8 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
+  this->AppendArrays(vtkDataObject::POINT, inputVector,
+    reallyMergePoints ? globalIndices.data() : nullptr, output, newPts->GetNumberOfPoints());
   this->UpdateProgress(0.75);
   this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
   this->UpdateProgress(1.0);
@@ -406,8 +605,6 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPoints(newPts);
   output->Squeeze();
 
-  delete[] globalIndices;
-
   return 1;
 }
 
@@ -464,6 +661,51 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
   vtkDataSetAttributes* outputData = output->GetAttributes(attributesType);
   outputData->CopyAllocate(fieldList, totalNumberOfElements);
 
+  if (globalIds != nullptr)
+  {
+    // Each output tuple gets the data of the last input tuple mapped to it,
+    // as when copying the input tuples in order, so the tuples are copied
+    // in parallel.
+    std::vector<vtkDataSetAttributes*> inputsData;
+    std::vector<vtkIdType> offsets(1, 0);
+    for (dataSet = nullptr, inputs->InitTraversal(iter); (dataSet = inputs->GetNextDataSet(iter));)
+    {
+      if (auto inputData = dataSet->GetAttributes(attributesType))
+      {
+        inputsData.push_back(inputData);
+        offsets.push_back(offsets.back() + inputData->GetNumberOfTuples());
+      }
+    }
+    std::unique_ptr<std::atomic<vtkIdType>[]> sourceIds(
+      new std::atomic<vtkIdType>[totalNumberOfElements]);
+    vtkSMPTools::For(0, totalNumberOfElements, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        sourceIds[id].store(-1, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, offsets.back(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        ::AtomicMax(sourceIds[globalIds[id]], id);
+      }
+    });
+    outputData->SetNumberOfTuples(totalNumberOfElements);
+    vtkSMPTools::For(0, totalNumberOfElements, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType id = begin; id < end; ++id)
+      {
+        const vtkIdType sourceId = sourceIds[id].load(std::memory_order_relaxed);
+        if (sourceId >= 0)
+        {
+          const vtkIdType inputIndex = ::FindInput(offsets, sourceId);
+          fieldList.CopyData(static_cast<int>(inputIndex), inputsData[inputIndex],
+            sourceId - offsets[inputIndex], outputData, id);
+        }
+      }
+    });
+    return;
+  }
+
   // copy arrays.
   int inputIndex;
   vtkIdType offset = 0;
@@ -473,17 +715,7 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
     if (auto inputData = dataSet->GetAttributes(attributesType))
     {
       const auto numberOfInputTuples = inputData->GetNumberOfTuples();
-      if (globalIds != nullptr)
-      {
-        for (vtkIdType id = 0; id < numberOfInputTuples; ++id)
-        {
-          fieldList.CopyData(inputIndex, inputData, id, outputData, globalIds[offset + id]);
-        }
-      }
-      else
-      {
-        fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
-      }
+      fieldList.CopyData(inputIndex, inputData, 0, numberOfInputTuples, outputData, offset);
       offset += numberOfInputTuples;
       ++inputIndex;
     }
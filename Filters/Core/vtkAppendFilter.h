@@ -17,6 +17,12 @@
  * "GlobalPointIds"), then two points are merged if they share the same point global id,
  * without checking for coincident point.
  *
+ * Points, cells and attributes are copied in parallel, each input being written
+ * at offsets computed beforehand. When the tolerance is 0, coincident points are
+ * merged in parallel with a vtkStaticPointLocator and numbered as the incremental
+ * merging would number them. Merging with a nonzero tolerance or with global ids,
+ * and appending polyhedra, remain serial.
+ *
  * @sa
  * vtkAppendPolyData
  */
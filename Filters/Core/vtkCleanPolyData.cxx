@@ -3,6 +3,7 @@
 #include "vtkCleanPolyData.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
@@ -13,9 +14,17 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCleanPolyData);
@@ -36,6 +45,78 @@ bool InsertPointUsingGlobalId(vtkIdType globalId, vtkPoints* newPts,
   ptId = it->second;
   return false;
 }
+
+// Types of the polydata cells, in the order of the output cells.
+enum CellTypes : signed char
+{
+  NO_CELL = -1,
+  VERT_CELL,
+  LINE_CELL,
+  POLY_CELL,
+  STRIP_CELL
+};
+
+// Map the points of a cell to the merged points, dropping the duplicates the
+// same way the incremental cleaning does. Returns the type of the cleaned cell,
+// or NO_CELL if the cell is removed.
+signed char CleanCell(signed char inType, vtkIdType npts, const vtkIdType* pts,
+  const vtkIdType* pointMap, bool convertLinesToPoints, bool convertPolysToLines,
+  bool convertStripsToPolys, vtkIdType* updatedPts, vtkIdType& numNewPts)
+{
+  numNewPts = 0;
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    const vtkIdType ptId = pointMap[pts[i]];
+    if (inType == VERT_CELL || i == 0 || ptId != updatedPts[numNewPts - 1])
+    {
+      updatedPts[numNewPts++] = ptId;
+    }
+  }
+  if (((inType == POLY_CELL && numNewPts > 2) || (inType == STRIP_CELL && numNewPts > 1)) &&
+    updatedPts[0] == updatedPts[numNewPts - 1])
+  {
+    numNewPts--;
+  }
+
+  if (inType == VERT_CELL)
+  {
+    return numNewPts > 0 ? VERT_CELL : NO_CELL;
+  }
+  if (inType == STRIP_CELL && numNewPts > 3)
+  {
+    return STRIP_CELL;
+  }
+  if (inType == STRIP_CELL && numNewPts == 3 && (npts == 3 || convertStripsToPolys))
+  {
+    return POLY_CELL;
+  }
+  if (inType == POLY_CELL && numNewPts > 2)
+  {
+    return POLY_CELL;
+  }
+  if (inType == LINE_CELL && numNewPts >= 2)
+  {
+    return LINE_CELL;
+  }
+  if (inType != LINE_CELL && numNewPts == 2 && (npts == 2 || convertPolysToLines))
+  {
+    return LINE_CELL;
+  }
+  if (numNewPts == 1 && (npts == 1 || convertLinesToPoints))
+  {
+    return VERT_CELL;
+  }
+  return NO_CELL;
+}
+
+// Atomically lower value to candidate if candidate is smaller.
+void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current && !value.compare_exchange_weak(current, candidate))
+  {
+  }
+}
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -84,6 +165,14 @@ void vtkCleanPolyData::OperateOnBounds(double in[6], double out[6])
   out[5] = in[5];
 }
 
+//------------------------------------------------------------------------------
+bool vtkCleanPolyData::OperatesOnPoints()
+{
+  // Subclasses may redefine OperateOnPoint without knowing about this method,
+  // they keep the incremental insertion unless they opt in.
+  return strcmp(this->GetClassName(), "vtkCleanPolyData") != 0;
+}
+
 //------------------------------------------------------------------------------
 int vtkCleanPolyData::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -140,6 +229,29 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     vtkDebugMacro(<< "No data to Operate On!");
     return 1;
   }
+
+  // Merging exactly coincident points does not depend on the order in which
+  // the points are inserted, so it is done in parallel with the same output.
+  // Subclasses modifying the points in OperateOnPoint, global ids and
+  // non-zero tolerances need the incremental insertion.
+  int outputPointsType = inPts->GetDataType();
+  if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    outputPointsType = VTK_FLOAT;
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    outputPointsType = VTK_DOUBLE;
+  }
+  const double tol =
+    this->ToleranceIsAbsolute ? this->AbsoluteTolerance : this->Tolerance * input->GetLength();
+  if (this->PointMerging && tol == 0.0 && !input->GetPointData()->GetGlobalIds() &&
+    (!this->Locator || this->Locator->IsA("vtkMergePoints")) &&
+    outputPointsType == inPts->GetDataType() && !this->OperatesOnPoints())
+  {
+    return this->CleanInParallel(input, output);
+  }
+
   vtkIdType* updatedPts = new vtkIdType[input->GetMaxCellSize()];
 
   vtkIdType numNewPts;
@@ -666,6 +778,270 @@ int vtkCleanPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Clean the polydata merging exactly coincident points. The merged points are
+// numbered in the order of their first use by the cells, and their data are
+// copied from that first use, as the incremental insertion does.
+int vtkCleanPolyData::CleanInParallel(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  vtkPointData* inputPD = input->GetPointData();
+  vtkCellData* inputCD = input->GetCellData();
+  vtkPointData* outputPD = output->GetPointData();
+  vtkCellData* outputCD = output->GetCellData();
+
+  // Cells are numbered verts first, then lines, polys and strips. Connectivity
+  // positions are numbered the same way.
+  vtkCellArray* inCells[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+    input->GetStrips() };
+  vtkIdType cellsBegin[5] = { 0, 0, 0, 0, 0 };
+  vtkIdType connBegin[5] = { 0, 0, 0, 0, 0 };
+  for (int type = 0; type < 4; ++type)
+  {
+    cellsBegin[type + 1] = cellsBegin[type] + inCells[type]->GetNumberOfCells();
+    connBegin[type + 1] = connBegin[type] + inCells[type]->GetNumberOfConnectivityIds();
+  }
+  const vtkIdType numCells = cellsBegin[4];
+  const vtkIdType maxCellSize = input->GetMaxCellSize();
+
+  // Merge the coincident points, each point is mapped to a representative.
+  std::vector<vtkIdType> mergeMap(numPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  locator->MergePoints(0.0, mergeMap.data());
+  this->UpdateProgress(0.25);
+
+  // Find the first use of each representative by the cells.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstUses(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstUses[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  for (int type = 0; type < 4; ++type)
+  {
+    vtkCellArray* cells = inCells[type];
+    vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType begin, vtkIdType end) {
+      vtkSmartPointer<vtkCellArrayIterator> iter;
+      iter.TakeReference(cells->NewIterator());
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        iter->GetCellAtId(cellId, npts, pts);
+        const vtkIdType position = connBegin[type] + cells->GetOffset(cellId);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          ::AtomicMin(firstUses[mergeMap[pts[i]]], position + i);
+        }
+      }
+    });
+  }
+
+  // Number the used representatives in the order of their first use.
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localFirstUses;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<vtkIdType>& uses = localFirstUses.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType firstUse = firstUses[ptId].load(std::memory_order_relaxed);
+      if (mergeMap[ptId] == ptId && firstUse != VTK_ID_MAX)
+      {
+        uses.push_back(firstUse);
+      }
+    }
+  });
+  std::vector<vtkIdType> sortedFirstUses;
+  for (const auto& uses : localFirstUses)
+  {
+    sortedFirstUses.insert(sortedFirstUses.end(), uses.begin(), uses.end());
+  }
+  vtkSMPTools::Sort(sortedFirstUses.begin(), sortedFirstUses.end());
+  const vtkIdType numNewPts = static_cast<vtkIdType>(sortedFirstUses.size());
+
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType firstUse = firstUses[mergeMap[ptId]].load(std::memory_order_relaxed);
+      pointMap[ptId] = firstUse == VTK_ID_MAX
+        ? -1
+        : std::lower_bound(sortedFirstUses.begin(), sortedFirstUses.end(), firstUse) -
+          sortedFirstUses.begin();
+    }
+  });
+  firstUses.reset();
+  this->UpdateProgress(0.5);
+
+  // The new points and their data come from the first use.
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(inPts->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyAllocate(inputPD, numNewPts);
+  outputPD->SetNumberOfTuples(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType newId = begin; newId < end; ++newId)
+    {
+      const vtkIdType position = sortedFirstUses[newId];
+      const int type =
+        static_cast<int>(std::upper_bound(connBegin, connBegin + 5, position) - connBegin) - 1;
+      vtkCellArray* cells = inCells[type];
+      const vtkIdType connId = position - connBegin[type];
+      const vtkIdType ptId = cells->IsStorage64Bit()
+        ? static_cast<vtkIdType>(cells->GetConnectivityArray64()->GetValue(connId))
+        : static_cast<vtkIdType>(cells->GetConnectivityArray32()->GetValue(connId));
+      inPts->GetPoint(ptId, x);
+      newPts->SetPoint(newId, x);
+      outputPD->CopyData(inputPD, ptId, newId);
+    }
+  });
+  output->SetPoints(newPts);
+  this->UpdateProgress(0.6);
+
+  // Classify the cleaned cells.
+  std::vector<signed char> outTypes(numCells);
+  std::vector<vtkIdType> outSizes(numCells);
+  for (signed char type = VERT_CELL; type <= STRIP_CELL; ++type)
+  {
+    vtkCellArray* cells = inCells[type];
+    vtkSMPThreadLocal<std::vector<vtkIdType>> localUpdatedPts;
+    vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& updatedPts = localUpdatedPts.Local();
+      updatedPts.resize(maxCellSize);
+      vtkSmartPointer<vtkCellArrayIterator> iter;
+      iter.TakeReference(cells->NewIterator());
+      vtkIdType npts;
+      const vtkIdType* pts;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (isFirst && !(cellId % 10000))
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        iter->GetCellAtId(cellId, npts, pts);
+        const vtkIdType inCellId = cellsBegin[type] + cellId;
+        outTypes[inCellId] = ::CleanCell(type, npts, pts, pointMap.data(),
+          this->ConvertLinesToPoints, this->ConvertPolysToLines, this->ConvertStripsToPolys,
+          updatedPts.data(), outSizes[inCellId]);
+      }
+    });
+  }
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+
+  // Number the output cells of each type in the order of the input cells.
+  std::vector<vtkIdType> outCellIds(numCells);
+  vtkNew<vtkIdTypeArray> outOffsets[4];
+  vtkIdType numOutCells[4] = { 0, 0, 0, 0 };
+  vtkIdType numOutConn[4] = { 0, 0, 0, 0 };
+  for (vtkIdType inCellId = 0; inCellId < numCells; ++inCellId)
+  {
+    const signed char outType = outTypes[inCellId];
+    if (outType != NO_CELL)
+    {
+      outCellIds[inCellId] = numOutCells[outType]++;
+      numOutConn[outType] += outSizes[inCellId];
+    }
+  }
+  vtkNew<vtkIdTypeArray> outConn[4];
+  for (int type = 0; type < 4; ++type)
+  {
+    outOffsets[type]->SetNumberOfValues(numOutCells[type] + 1);
+    outOffsets[type]->SetValue(numOutCells[type], numOutConn[type]);
+    outConn[type]->SetNumberOfValues(numOutConn[type]);
+  }
+  vtkIdType offsets[4] = { 0, 0, 0, 0 };
+  for (vtkIdType inCellId = 0; inCellId < numCells; ++inCellId)
+  {
+    const signed char outType = outTypes[inCellId];
+    if (outType != NO_CELL)
+    {
+      outOffsets[outType]->SetValue(outCellIds[inCellId], offsets[outType]);
+      offsets[outType] += outSizes[inCellId];
+    }
+  }
+  const vtkIdType outCellsBegin[4] = { 0, numOutCells[0], numOutCells[0] + numOutCells[1],
+    numOutCells[0] + numOutCells[1] + numOutCells[2] };
+  const vtkIdType numCellsOut = outCellsBegin[3] + numOutCells[3];
+  this->UpdateProgress(0.75);
+
+  // Write the cleaned cells and their data.
+  outputCD->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
+  outputCD->CopyAllocate(inputCD, numCellsOut);
+  outputCD->SetNumberOfTuples(numCellsOut);
+  for (signed char type = VERT_CELL; type <= STRIP_CELL; ++type)
+  {
+    vtkCellArray* cells = inCells[type];
+    vtkSMPThreadLocal<std::vector<vtkIdType>> localUpdatedPts;
+    vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType begin, vtkIdType end) {
+      std::vector<vtkIdType>& updatedPts = localUpdatedPts.Local();
+      updatedPts.resize(maxCellSize);
+      vtkSmartPointer<vtkCellArrayIterator> iter;
+      iter.TakeReference(cells->NewIterator());
+      vtkIdType npts, numNewPts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType inCellId = cellsBegin[type] + cellId;
+        const signed char outType = outTypes[inCellId];
+        if (outType == NO_CELL)
+        {
+          continue;
+        }
+        iter->GetCellAtId(cellId, npts, pts);
+        ::CleanCell(type, npts, pts, pointMap.data(), this->ConvertLinesToPoints,
+          this->ConvertPolysToLines, this->ConvertStripsToPolys, updatedPts.data(), numNewPts);
+        const vtkIdType outCellId = outCellIds[inCellId];
+        std::copy(updatedPts.begin(), updatedPts.begin() + numNewPts,
+          outConn[outType]->GetPointer(outOffsets[outType]->GetValue(outCellId)));
+        outputCD->CopyData(inputCD, inCellId, outCellsBegin[outType] + outCellId);
+      }
+    });
+  }
+
+  vtkDebugMacro(<< "Removed " << numPts - numNewPts << " points");
+
+  // Cell arrays are set as the incremental cleaning does: when the input
+  // has cells of that type or when some cells were converted to it.
+  for (int type = 0; type < 4; ++type)
+  {
+    if (numOutCells[type] == 0 && inCells[type]->GetNumberOfCells() == 0)
+    {
+      continue;
+    }
+    vtkNew<vtkCellArray> newCells;
+    newCells->SetData(outOffsets[type], outConn[type]);
+    switch (type)
+    {
+      case VERT_CELL:
+        output->SetVerts(newCells);
+        break;
+      case LINE_CELL:
+        output->SetLines(newCells);
+        break;
+      case POLY_CELL:
+        output->SetPolys(newCells);
+        break;
+      default:
+        output->SetStrips(newCells);
+        break;
+    }
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Method manages creation of locators. It takes into account the potential
 // change of tolerance (zero to non-zero).
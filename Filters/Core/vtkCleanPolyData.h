@@ -37,6 +37,13 @@
  * In addition, if a point global id array is available, then two points are merged
  * if and only if they share the same global id.
  *
+ * When points are merged with a zero tolerance and no global ids, the
+ * merging, the point renumbering and the cell rewriting are done in parallel
+ * with vtkSMPTools and a vtkStaticPointLocator, producing the same output as
+ * the incremental insertion. The incremental locator is still used for
+ * non-zero tolerances, global ids, locators other than vtkMergePoints, and
+ * subclasses, unless they override OperatesOnPoints to return false.
+ *
  * Note that merging of points can be disabled. In this case, a point locator
  * will not be used, and points that are not used by any cells will be
  * eliminated, but never merged.
@@ -46,7 +53,8 @@
  * forms. The tolerance should be chosen carefully to avoid these problems.
  * Subclasses should handle OperateOnBounds as well as OperateOnPoint
  * to ensure that the locator is correctly initialized (i.e. all modified
- * points must lie inside modified bounds).
+ * points must lie inside modified bounds). Subclasses that do not modify
+ * the points may override OperatesOnPoints to return false.
  *
  * @warning
  * If you wish to operate on a set of point coordinates that has no cells,
@@ -210,6 +218,18 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
+  /**
+   * Return true if OperateOnPoint and OperateOnBounds may modify the points.
+   * The parallel merging of coincident points does not call them, so it is
+   * only used when this returns false. This is the case for vtkCleanPolyData
+   * itself, subclasses must opt in by overriding it to return false.
+   */
+  virtual bool OperatesOnPoints();
+
+  // Clean the polydata in parallel when points are merged with a zero
+  // tolerance, since the result does not depend on the insertion order.
+  int CleanInParallel(vtkPolyData* input, vtkPolyData* output);
+
   vtkTypeBool PointMerging;
   double Tolerance;
   double AbsoluteTolerance;
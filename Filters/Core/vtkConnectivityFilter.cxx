@@ -4,6 +4,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -16,9 +17,11 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
@@ -30,6 +33,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->ExtractionMode = VTK_EXTRACT_LARGEST_REGION;
   this->ColorRegions = 0;
   this->RegionIdAssignmentMode = UNSPECIFIED;
+  this->LabelingMode = WAVE_PROPAGATION;
 
   this->ScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
@@ -226,7 +230,12 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
   this->PointIds = vtkIdList::New();
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (this->LabelingMode == UNION_FIND)
+  {
+    largestRegionId = this->LabelRegionsInParallel(input);
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -620,6 +629,137 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+// Label all the regions at once with a parallel union-find, or only the region
+// grown from the seeds if regions are seeded.
+//
+vtkIdType vtkConnectivityFilter::LabelRegionsInParallel(vtkDataSet* input)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Make sure the cells are built before accessing them from several threads
+  input->GetCellPoints(0, this->PointIds);
+  auto cellPoints = [input](vtkIdType cellId, vtkIdList* ptIds) {
+    input->GetCellPoints(cellId, ptIds);
+  };
+  vtkDataArray* inScalars = this->InScalars;
+  auto connectable = [this, inScalars](vtkIdType, vtkIdList* ptIds) {
+    if (!inScalars)
+    {
+      return true;
+    }
+    double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+    {
+      const double s = inScalars->GetComponent(ptIds->GetId(i), 0);
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+    }
+    return range[1] >= this->ScalarRange[0] && range[0] <= this->ScalarRange[1];
+  };
+
+  vtkIdType largestRegionId = 0;
+  if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    // Gather the seed cells
+    std::vector<char> seedCells(numCells, 0);
+    if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      for (vtkIdType i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        const vtkIdType seedId = this->Seeds->GetId(i);
+        if (seedId >= 0 && seedId < numCells)
+        {
+          seedCells[seedId] = 1;
+        }
+      }
+    }
+    else
+    {
+      std::vector<char> seedPoints(numPts, 0);
+      if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+      {
+        for (vtkIdType i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+        {
+          const vtkIdType seedId = this->Seeds->GetId(i);
+          if (seedId >= 0 && seedId < numPts)
+          {
+            seedPoints[seedId] = 1;
+          }
+        }
+      }
+      else
+      {
+        double minDist2 = VTK_DOUBLE_MAX, x[3];
+        vtkIdType minId = 0;
+        for (vtkIdType i = 0; i < numPts; i++)
+        {
+          input->GetPoint(i, x);
+          const double dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
+          if (dist2 < minDist2)
+          {
+            minId = i;
+            minDist2 = dist2;
+          }
+        }
+        seedPoints[minId] = 1;
+      }
+
+      ::MarkCellsUsingPoints(numCells, cellPoints, seedPoints, seedCells);
+    }
+
+    // Everything connected to the seeds is in the same region
+    const vtkIdType numCellsInRegion = ::LabelSeededRegion(
+      numPts, numCells, cellPoints, connectable, seedCells, this->Visited);
+    this->RegionNumber = 0;
+    this->RegionSizes->InsertValue(0, numCellsInRegion);
+  }
+  else
+  {
+    std::vector<vtkIdType> regionSizes;
+    const vtkIdType numRegions = ::LabelConnectedRegions(
+      numPts, numCells, cellPoints, connectable, this->Visited, regionSizes);
+    vtkIdType maxCellsInRegion = 0;
+    this->RegionSizes->SetNumberOfValues(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; regionId++)
+    {
+      this->RegionSizes->SetValue(regionId, regionSizes[regionId]);
+      if (regionSizes[regionId] > maxCellsInRegion)
+      {
+        maxCellsInRegion = regionSizes[regionId];
+        largestRegionId = regionId;
+      }
+    }
+    this->RegionNumber = numRegions;
+  }
+
+  // Points used by the labeled cells are kept in their input order. A point
+  // shared by several regions is given the lowest one.
+  std::vector<vtkIdType> pointRegions(numPts);
+  ::ComputePointRegions(numPts, numCells, cellPoints, this->Visited, pointRegions.data());
+  std::copy(pointRegions.begin(), pointRegions.end(), this->PointMap);
+  this->PointNumber = ::NumberNonNegativeIds(numPts, this->PointMap);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      if (this->PointMap[ptId] >= 0)
+      {
+        this->NewScalars->SetValue(this->PointMap[ptId], pointRegions[ptId]);
+      }
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+    }
+  });
+
+  return largestRegionId;
+}
+
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
 {
@@ -778,5 +918,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Labeling Mode: "
+     << (this->LabelingMode == UNION_FIND ? "UNION_FIND" : "WAVE_PROPAGATION") << "\n";
 }
 VTK_ABI_NAMESPACE_END
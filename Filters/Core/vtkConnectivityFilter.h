@@ -194,6 +194,33 @@ public:
   vtkSetMacro(RegionIdAssignmentMode, int);
   vtkGetMacro(RegionIdAssignmentMode, int);
 
+  /**
+   * Enumeration of the algorithms labeling the connected regions.
+   */
+  enum LabelingModes
+  {
+    WAVE_PROPAGATION,
+    UNION_FIND
+  };
+
+  ///@{
+  /**
+   * Set/get the algorithm labeling the connected regions. WAVE_PROPAGATION
+   * (the default) grows each region from a seed cell serially. UNION_FIND
+   * joins the points of the cells in parallel with a lock-free union-find
+   * and does not need the cell links. Both find the same regions, with the
+   * same sizes and ids, including with ScalarConnectivity on, where a cell
+   * that is not scalar connected is never reached from its neighbors but
+   * still seeds a region grown to its scalar connected neighbors. With
+   * UNION_FIND, the output points keep their input order instead of the
+   * traversal order.
+   */
+  vtkSetClampMacro(LabelingMode, int, WAVE_PROPAGATION, UNION_FIND);
+  vtkGetMacro(LabelingMode, int);
+  void SetLabelingModeToWavePropagation() { this->SetLabelingMode(WAVE_PROPAGATION); }
+  void SetLabelingModeToUnionFind() { this->SetLabelingMode(UNION_FIND); }
+  ///@}
+
   ///@{
   /**
    * Set/get the desired precision for the output types. See the documentation
@@ -231,9 +258,14 @@ protected:
   double ScalarRange[2];
 
   int RegionIdAssignmentMode;
+  int LabelingMode;
 
   void TraverseAndMark(vtkDataSet* input);
 
+  // Label the regions with a parallel union-find, filling the same
+  // execution data as TraverseAndMark. Returns the largest region id.
+  vtkIdType LabelRegionsInParallel(vtkDataSet* input);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
 private:
@@ -0,0 +1,404 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkConnectivityFilterInternal
+ * @brief   parallel labeling of connected regions with a union-find
+ *
+ * vtkConnectivityFilterInternal labels the connected regions of a set of
+ * cells with a lock-free union-find over the points, driven by vtkSMPTools.
+ * Two cells are joined if they share a point and are both connectable (e.g.
+ * they meet a scalar criterion). The regions are the ones the serial wave
+ * propagation of the connectivity filters grows: the wave propagation seeds a
+ * region at each cell it has not visited yet, in increasing cell id order, and
+ * grows it to the connectable cells using its points. A non connectable cell
+ * is never reached by a wave, so it always seeds a region of its own, which
+ * also takes the sets of joined cells using its points that no lower cell
+ * reached. Regions are numbered in the order of their seed cell id, so the
+ * labels do not depend on the number of threads.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication
+ * between vtkConnectivityFilter and vtkPolyDataConnectivityFilter. It is not
+ * meant to define a public API.
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityFilterInternal_h
+#define vtkConnectivityFilterInternal_h
+
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Atomically lower value to candidate if candidate is smaller.
+inline void AtomicMin(std::atomic<vtkIdType>& value, vtkIdType candidate)
+{
+  vtkIdType current = value.load(std::memory_order_relaxed);
+  while (candidate < current && !value.compare_exchange_weak(current, candidate))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+// Lock-free disjoint sets. Roots are always linked below smaller roots, so the
+// root of a set is its smallest element. Find() halves the paths it walks.
+class UnionFind
+{
+public:
+  UnionFind(vtkIdType size)
+    : Parent(new std::atomic<vtkIdType>[size])
+  {
+    vtkSMPTools::For(0, size, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType id = begin; id < end; id++)
+      {
+        this->Parent[id].store(id, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  vtkIdType Find(vtkIdType id)
+  {
+    vtkIdType parent = this->Parent[id].load(std::memory_order_relaxed);
+    while (parent != id)
+    {
+      vtkIdType grandParent = this->Parent[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        this->Parent[id].compare_exchange_weak(parent, grandParent);
+      }
+      id = grandParent;
+      parent = this->Parent[id].load(std::memory_order_relaxed);
+    }
+    return id;
+  }
+
+  void Union(vtkIdType id1, vtkIdType id2)
+  {
+    while (true)
+    {
+      id1 = this->Find(id1);
+      id2 = this->Find(id2);
+      if (id1 == id2)
+      {
+        return;
+      }
+      if (id1 < id2)
+      {
+        std::swap(id1, id2);
+      }
+      // id1 is the larger root, link it below id2 unless another thread
+      // linked it meanwhile.
+      vtkIdType expected = id1;
+      if (this->Parent[id1].compare_exchange_strong(expected, id2))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parent;
+};
+
+//------------------------------------------------------------------------------
+// Replace the non negative entries of ids by their rank among the non
+// negative entries. Returns the number of such entries.
+inline vtkIdType NumberNonNegativeIds(vtkIdType numIds, vtkIdType* ids)
+{
+  const vtkIdType chunkSize = 65536;
+  const vtkIdType numChunks = (numIds + chunkSize - 1) / chunkSize;
+  std::vector<vtkIdType> chunkOffsets(numChunks + 1, 0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+    {
+      const vtkIdType last = std::min(numIds, (chunk + 1) * chunkSize);
+      chunkOffsets[chunk + 1] = std::count_if(
+        ids + chunk * chunkSize, ids + last, [](vtkIdType id) { return id >= 0; });
+    }
+  });
+  for (vtkIdType chunk = 0; chunk < numChunks; chunk++)
+  {
+    chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+  }
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; chunk++)
+    {
+      vtkIdType rank = chunkOffsets[chunk];
+      const vtkIdType last = std::min(numIds, (chunk + 1) * chunkSize);
+      for (vtkIdType id = chunk * chunkSize; id < last; id++)
+      {
+        if (ids[id] >= 0)
+        {
+          ids[id] = rank++;
+        }
+      }
+    }
+  });
+  return chunkOffsets[numChunks];
+}
+
+//------------------------------------------------------------------------------
+// Join the points of each connectable cell. cellPoints(cellId, ptIds) fills
+// ptIds with the points of a cell and connectable(cellId, ptIds) tells if the
+// cell may be connected to its neighbors. Fills cellRoots (of size numCells)
+// with the root point of the connectable cells and -1 for the others, and
+// pointRoots with the root of each point.
+template <typename TCellPoints, typename TConnectable>
+void JoinConnectableCells(vtkIdType numPts, vtkIdType numCells, TCellPoints&& cellPoints,
+  TConnectable&& connectable, vtkIdType* cellRoots, std::vector<vtkIdType>& pointRoots)
+{
+  // cellRoots temporarily holds the first point of the connectable cells.
+  UnionFind sets(numPts);
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      cellPoints(cellId, ptIds);
+      const vtkIdType npts = ptIds->GetNumberOfIds();
+      if (npts == 0 || !connectable(cellId, ptIds))
+      {
+        cellRoots[cellId] = -1;
+        continue;
+      }
+      cellRoots[cellId] = ptIds->GetId(0);
+      for (vtkIdType i = 1; i < npts; i++)
+      {
+        sets.Union(ptIds->GetId(0), ptIds->GetId(i));
+      }
+    }
+  });
+
+  pointRoots.resize(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      pointRoots[ptId] = sets.Find(ptId);
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      if (cellRoots[cellId] >= 0)
+      {
+        cellRoots[cellId] = pointRoots[cellRoots[cellId]];
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Label the connected regions of the cells, see JoinConnectableCells for the
+// arguments. Fills cellRegions (of size numCells) and regionSizes, and returns
+// the number of regions.
+template <typename TCellPoints, typename TConnectable>
+vtkIdType LabelConnectedRegions(vtkIdType numPts, vtkIdType numCells, TCellPoints&& cellPoints,
+  TConnectable&& connectable, vtkIdType* cellRegions, std::vector<vtkIdType>& regionSizes)
+{
+  // cellRegions temporarily holds the root of the connectable cells.
+  std::vector<vtkIdType> pointRoots;
+  ::JoinConnectableCells(numPts, numCells, cellPoints, connectable, cellRegions, pointRoots);
+
+  // Find the seed of the region of each set of joined cells: its lowest cell,
+  // unless a lower non connectable cell uses one of its points.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstCells(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      firstCells[ptId].store(numCells, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      if (cellRegions[cellId] >= 0)
+      {
+        ::AtomicMin(firstCells[cellRegions[cellId]], cellId);
+        continue;
+      }
+      cellPoints(cellId, ptIds);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+      {
+        ::AtomicMin(firstCells[pointRoots[ptIds->GetId(i)]], cellId);
+      }
+    }
+  });
+
+  // Number the regions from their seed cell. Non connectable cells are seeds.
+  std::vector<vtkIdType> regionIds(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      const vtkIdType root = cellRegions[cellId];
+      regionIds[cellId] =
+        (root < 0 || firstCells[root].load(std::memory_order_relaxed) == cellId) ? 0 : -1;
+    }
+  });
+  const vtkIdType numRegions = ::NumberNonNegativeIds(numCells, regionIds.data());
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      const vtkIdType root = cellRegions[cellId];
+      cellRegions[cellId] = regionIds[cellId] >= 0
+        ? regionIds[cellId]
+        : regionIds[firstCells[root].load(std::memory_order_relaxed)];
+    }
+  });
+
+  // Count the cells of the regions. Neighboring cells often belong to the
+  // same region, so counts are accumulated over runs of cells.
+  std::unique_ptr<std::atomic<vtkIdType>[]> sizes(new std::atomic<vtkIdType>[numRegions]);
+  vtkSMPTools::For(0, numRegions, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType regionId = begin; regionId < end; regionId++)
+    {
+      sizes[regionId].store(0, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType runStart = begin;
+    for (vtkIdType cellId = begin + 1; cellId <= end; cellId++)
+    {
+      if (cellId == end || cellRegions[cellId] != cellRegions[runStart])
+      {
+        sizes[cellRegions[runStart]].fetch_add(cellId - runStart, std::memory_order_relaxed);
+        runStart = cellId;
+      }
+    }
+  });
+  regionSizes.resize(numRegions);
+  for (vtkIdType regionId = 0; regionId < numRegions; regionId++)
+  {
+    regionSizes[regionId] = sizes[regionId].load(std::memory_order_relaxed);
+  }
+
+  return numRegions;
+}
+
+//------------------------------------------------------------------------------
+// Set pointRegions (of size numPts) to the lowest region of the cells using
+// each point, considering only the cells with a non negative region, and to
+// -1 for the points not used by these cells.
+template <typename TCellPoints>
+void ComputePointRegions(vtkIdType numPts, vtkIdType numCells, TCellPoints&& cellPoints,
+  const vtkIdType* cellRegions, vtkIdType* pointRegions)
+{
+  std::unique_ptr<std::atomic<vtkIdType>[]> regions(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      regions[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      if (cellRegions[cellId] < 0)
+      {
+        continue;
+      }
+      cellPoints(cellId, ptIds);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+      {
+        ::AtomicMin(regions[ptIds->GetId(i)], cellRegions[cellId]);
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      const vtkIdType region = regions[ptId].load(std::memory_order_relaxed);
+      pointRegions[ptId] = region == VTK_ID_MAX ? -1 : region;
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Set seedCells to 1 for the cells using a seed point, i.e. a point whose
+// seedPoints entry is not zero.
+template <typename TCellPoints>
+void MarkCellsUsingPoints(vtkIdType numCells, TCellPoints&& cellPoints,
+  const std::vector<char>& seedPoints, std::vector<char>& seedCells)
+{
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = localPtIds.Local();
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      cellPoints(cellId, ptIds);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+      {
+        if (seedPoints[ptIds->GetId(i)])
+        {
+          seedCells[cellId] = 1;
+          break;
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Label the region grown from seed cells, i.e. cells whose seedCells entry is
+// not zero, see JoinConnectableCells for the other arguments. As with the wave
+// propagation, the region holds the seed cells, connectable or not, and the
+// sets of joined cells using their points. Sets cellRegions (of size
+// numCells) to 0 for the cells of the region and -1 for the others, and
+// returns the number of cells of the region.
+template <typename TCellPoints, typename TConnectable>
+vtkIdType LabelSeededRegion(vtkIdType numPts, vtkIdType numCells, TCellPoints&& cellPoints,
+  TConnectable&& connectable, const std::vector<char>& seedCells, vtkIdType* cellRegions)
+{
+  // cellRegions temporarily holds the root of the connectable cells.
+  std::vector<vtkIdType> pointRoots;
+  ::JoinConnectableCells(numPts, numCells, cellPoints, connectable, cellRegions, pointRoots);
+
+  // Seeds are usually few, their sets are marked serially.
+  std::vector<char> seedRoots(numPts, 0);
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    if (seedCells[cellId])
+    {
+      cellPoints(cellId, ptIds);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+      {
+        seedRoots[pointRoots[ptIds->GetId(i)]] = 1;
+      }
+    }
+  }
+
+  std::atomic<vtkIdType> numCellsInRegion(0);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType numMarked = 0;
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      const vtkIdType root = cellRegions[cellId];
+      const bool marked = seedCells[cellId] || (root >= 0 && seedRoots[root]);
+      cellRegions[cellId] = marked ? 0 : -1;
+      numMarked += marked ? 1 : 0;
+    }
+    numCellsInRegion.fetch_add(numMarked, std::memory_order_relaxed);
+  });
+  return numCellsInRegion.load();
+}
+
+} // anonymous namespace
+
+#endif // vtkConnectivityFilterInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectivityFilterInternal.h
@@ -2,10 +2,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkContourGrid.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkBoundingBox.h"
 #include "vtkCell.h"
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkCellTypes.h"
 #include "vtkContourHelper.h"
 #include "vtkContourValues.h"
 #include "vtkCutter.h"
@@ -13,6 +17,9 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdListCollection.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -23,14 +30,23 @@
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
+#include "vtkPolygonBuilder.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSimpleScalarTree.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnstructuredGridBase.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkContourGrid);
@@ -97,6 +113,649 @@ vtkMTimeType vtkContourGrid::GetMTime()
   return mTime;
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// We don't want to change the active scalars in the input, but we need to set
+// the active scalars to match the input array to process so that the point
+// data copying works as expected. Create a shallow copy of point data so that
+// we can do this without changing the input.
+vtkSmartPointer<vtkPointData> GetPointDataToInterpolate(vtkDataSet* input, vtkDataArray* inScalars)
+{
+  vtkSmartPointer<vtkPointData> inPd = vtkSmartPointer<vtkPointData>::New();
+  inPd->ShallowCopy(input->GetPointData());
+
+  // Keep track of the old active scalars because when we set the new
+  // scalars, the old scalars are removed from the point data entirely
+  // and we have to add them back.
+  vtkAbstractArray* oldScalars = inPd->GetScalars();
+  inPd->SetScalars(inScalars);
+  if (oldScalars)
+  {
+    inPd->AddArray(oldScalars);
+  }
+  return inPd;
+}
+
+// The type of the output points, following the output points precision.
+int GetOutputPointsType(vtkContourGrid* self, vtkPointSet* input)
+{
+  switch (self->GetOutputPointsPrecision())
+  {
+    case vtkAlgorithm::DEFAULT_PRECISION:
+      return input->GetPoints()->GetDataType();
+    case vtkAlgorithm::DOUBLE_PRECISION:
+      return VTK_DOUBLE;
+    default:
+      return VTK_FLOAT;
+  }
+}
+
+// The range of the scalar values of a cell, over all the components.
+void ComputeCellRange(vtkDoubleArray* cellScalars, double range[2])
+{
+  range[0] = std::numeric_limits<double>::max();
+  range[1] = std::numeric_limits<double>::lowest();
+  for (const double val : vtk::DataArrayValueRange(cellScalars))
+  {
+    range[0] = std::min(range[0], val);
+    range[1] = std::max(range[1], val);
+  }
+}
+
+// Number of cells, or of candidate cells of a scalar tree, per batch of the
+// parallel contouring.
+constexpr vtkIdType ContourGridBatchSize = 1024;
+
+// The contour of a batch of cells: the points, merged within the batch, and
+// their attributes, the vertices, lines and polygons, and the input cell of
+// each of them. Without GenerateTriangles, the triangles of each contour of a
+// 3D cell are merged into polygons once the points of all the batches are
+// merged, since vtkPolygonBuilder depends on the point ids: TriangleGroups
+// holds the range of polygons of each of these contours.
+struct vtkContourGridBatch
+{
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkPointData> PointData;
+  vtkSmartPointer<vtkCellArray> Cells[3];
+  std::vector<vtkIdType> CellIds[3];
+  std::vector<std::pair<vtkIdType, vtkIdType>> TriangleGroups;
+};
+
+// Contour batches of cells in parallel. Without candidate cells, a batch
+// covers consecutive cells, of which it contours the cells of the given
+// dimension. With the candidate cells of a scalar tree, a batch covers
+// consecutive candidates.
+struct ContourCells
+{
+  vtkContourGrid* Filter;
+  vtkUnstructuredGridBase* Input;
+  vtkDataArray* InScalars;
+  vtkPointData* InPd;
+  int PointsType;
+  vtkTypeBool ComputeScalars;
+  bool GenerateTriangles;
+
+  // What the current batches contour.
+  vtkContourGridBatch* Batches = nullptr;
+  vtkIdType NumberOfCells = 0;
+  const vtkIdType* CandidateCells = nullptr;
+  const unsigned char* CellTypeDimensions = nullptr;
+  int Dimension = 0;
+  const double* Values = nullptr;
+  vtkIdType NumberOfValues = 0;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkDoubleArray> CellScalars;
+  vtkSMPThreadLocalObject<vtkIdList> CellPointIds;
+  vtkSMPThreadLocalObject<vtkMergePoints> Locator;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> ContouredCells;
+  // The cell data is copied afterwards, from the input cell of each output cell.
+  vtkSMPThreadLocalObject<vtkCellData> NoCellData;
+
+  ContourCells(vtkContourGrid* filter, vtkUnstructuredGridBase* input, vtkDataArray* inScalars,
+    vtkPointData* inPd, int pointsType, vtkTypeBool computeScalars, bool generateTriangles)
+    : Filter(filter)
+    , Input(input)
+    , InScalars(inScalars)
+    , InPd(inPd)
+    , PointsType(pointsType)
+    , ComputeScalars(computeScalars)
+    , GenerateTriangles(generateTriangles)
+  {
+  }
+
+  void Initialize()
+  {
+    this->CellScalars.Local()->SetNumberOfComponents(this->InScalars->GetNumberOfComponents());
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = begin; batchId < end; ++batchId)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      this->ContourBatch(batchId, this->Batches[batchId]);
+    }
+  }
+
+  void Reduce() {}
+
+  bool SpansContourValue(const double range[2]) const
+  {
+    for (vtkIdType i = 0; i < this->NumberOfValues; i++)
+    {
+      if (this->Values[i] >= range[0] && this->Values[i] <= range[1])
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void ContourBatch(vtkIdType batchId, vtkContourGridBatch& batch)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkDoubleArray* cellScalars = this->CellScalars.Local();
+    vtkIdList* cellPtIds = this->CellPointIds.Local();
+    std::vector<vtkIdType>& contouredCells = this->ContouredCells.Local();
+
+    // Find the cells spanning a contour value and the bounds of their points,
+    // which the locator of the batch covers.
+    const vtkIdType first = batchId * ContourGridBatchSize;
+    const vtkIdType last = std::min(first + ContourGridBatchSize, this->NumberOfCells);
+    contouredCells.clear();
+    vtkBoundingBox bbox;
+    double range[2], x[3];
+    for (vtkIdType i = first; i < last; i++)
+    {
+      vtkIdType cellId = i;
+      if (this->CandidateCells)
+      {
+        cellId = this->CandidateCells[i];
+      }
+      else
+      {
+        const int cellType = this->Input->GetCellType(cellId);
+        if (cellType >= VTK_NUMBER_OF_CELL_TYPES ||
+          this->CellTypeDimensions[cellType] != this->Dimension)
+        {
+          continue;
+        }
+      }
+      this->Input->GetCellPoints(cellId, cellPtIds);
+      cellScalars->SetNumberOfTuples(cellPtIds->GetNumberOfIds());
+      this->InScalars->GetTuples(cellPtIds, cellScalars);
+      ::ComputeCellRange(cellScalars, range);
+      if (this->SpansContourValue(range))
+      {
+        contouredCells.push_back(cellId);
+        for (vtkIdType j = 0; j < cellPtIds->GetNumberOfIds(); j++)
+        {
+          this->Input->GetPoint(cellPtIds->GetId(j), x);
+          bbox.AddPoint(x);
+        }
+      }
+    }
+    if (contouredCells.empty())
+    {
+      return;
+    }
+
+    const vtkIdType estimatedSize = 4 * static_cast<vtkIdType>(contouredCells.size());
+    batch.Points = vtkSmartPointer<vtkPoints>::New();
+    batch.Points->SetDataType(this->PointsType);
+    batch.Points->Allocate(estimatedSize);
+    batch.PointData = vtkSmartPointer<vtkPointData>::New();
+    if (!this->ComputeScalars)
+    {
+      batch.PointData->CopyScalarsOff();
+    }
+    batch.PointData->InterpolateAllocate(this->InPd, estimatedSize);
+    for (vtkSmartPointer<vtkCellArray>& cells : batch.Cells)
+    {
+      cells = vtkSmartPointer<vtkCellArray>::New();
+    }
+    double bounds[6];
+    bbox.GetBounds(bounds);
+    vtkMergePoints* locator = this->Locator.Local();
+    locator->InitPointInsertion(batch.Points, bounds, estimatedSize);
+
+    // The helper outputs the triangles of 3D cells as they are, see TriangleGroups.
+    vtkCellData* noCellData = this->NoCellData.Local();
+    vtkContourHelper helper(locator, batch.Cells[0], batch.Cells[1], batch.Cells[2], this->InPd,
+      noCellData, batch.PointData, noCellData, VTK_CELL_SIZE, true);
+    for (vtkIdType cellId : contouredCells)
+    {
+      this->Input->GetCell(cellId, cell);
+      this->Input->SetCellOrderAndRationalWeights(cellId, cell);
+      cellScalars->SetNumberOfTuples(cell->GetNumberOfPoints());
+      this->InScalars->GetTuples(cell->GetPointIds(), cellScalars);
+      ::ComputeCellRange(cellScalars, range);
+      for (vtkIdType i = 0; i < this->NumberOfValues; i++)
+      {
+        if (this->Values[i] >= range[0] && this->Values[i] <= range[1])
+        {
+          const vtkIdType firstPoly = batch.Cells[2]->GetNumberOfCells();
+          helper.Contour(cell, this->Values[i], cellScalars, cellId);
+          const vtkIdType endPoly = batch.Cells[2]->GetNumberOfCells();
+          if (!this->GenerateTriangles && cell->GetCellDimension() == 3 && endPoly > firstPoly)
+          {
+            batch.TriangleGroups.emplace_back(firstPoly, endPoly);
+          }
+          for (int type = 0; type < 3; type++)
+          {
+            batch.CellIds[type].resize(batch.Cells[type]->GetNumberOfCells(), cellId);
+          }
+        }
+      }
+    }
+    locator->Initialize(); // releases the points and the buckets
+  }
+};
+
+// Merge the exactly coincident points of allPts in parallel into newPts.
+// Points are numbered as with an incremental locator inserting them in
+// order: each group of coincident points gets the rank of its lowest point
+// id. ptMap maps the points of allPts to the points of newPts, and firstPtIds
+// maps the points of newPts to their lowest point in allPts.
+void MergeCoincidentPoints(vtkPoints* allPts, vtkPoints* newPts, std::vector<vtkIdType>& ptMap,
+  std::vector<vtkIdType>& firstPtIds)
+{
+  const vtkIdType numPts = allPts->GetNumberOfPoints();
+  vtkNew<vtkPolyData> pointSet;
+  pointSet->SetPoints(allPts);
+
+  // Map each point to a representative of its group of coincident points.
+  std::vector<vtkIdType> mergeMap(numPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(pointSet);
+  locator->BuildLocator();
+  locator->MergePoints(0.0, mergeMap.data());
+
+  // Find the lowest point of each group.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstIds(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstIds[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      std::atomic<vtkIdType>& firstId = firstIds[mergeMap[ptId]];
+      vtkIdType current = firstId.load(std::memory_order_relaxed);
+      while (ptId < current && !firstId.compare_exchange_weak(current, ptId))
+      {
+      }
+    }
+  });
+
+  // Number the groups in the order of their lowest point, then map the
+  // other points of the groups.
+  firstPtIds.clear();
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (firstIds[mergeMap[ptId]].load(std::memory_order_relaxed) == ptId)
+    {
+      ptMap[ptId] = static_cast<vtkIdType>(firstPtIds.size());
+      firstPtIds.push_back(ptId);
+    }
+  }
+  newPts->SetNumberOfPoints(static_cast<vtkIdType>(firstPtIds.size()));
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType firstId = firstIds[mergeMap[ptId]].load(std::memory_order_relaxed);
+      if (firstId == ptId)
+      {
+        allPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptMap[ptId], x);
+      }
+      else
+      {
+        ptMap[ptId] = ptMap[firstId];
+      }
+    }
+  });
+}
+
+// Replace the polygons of a batch by polygons of merged point ids, where the
+// triangles of each group are merged into polygons as vtkContourHelper does.
+void MergeTriangles(vtkContourGridBatch& batch, const vtkIdType* ptMap)
+{
+  vtkCellArray* polys = batch.Cells[2];
+  const std::vector<vtkIdType>& polyCellIds = batch.CellIds[2];
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->AllocateExact(polys->GetNumberOfCells(), polys->GetNumberOfConnectivityIds());
+  std::vector<vtkIdType> newPolyCellIds;
+  newPolyCellIds.reserve(polyCellIds.size());
+  vtkNew<vtkIdList> pts;
+  vtkPolygonBuilder polyBuilder;
+  vtkNew<vtkIdListCollection> polyCollection;
+
+  auto insertPoly = [&](vtkIdType polyId) {
+    polys->GetCellAtId(polyId, pts);
+    for (vtkIdType j = 0; j < pts->GetNumberOfIds(); j++)
+    {
+      pts->SetId(j, ptMap[pts->GetId(j)]);
+    }
+    newPolys->InsertNextCell(pts);
+    newPolyCellIds.push_back(polyCellIds[polyId]);
+  };
+
+  vtkIdType polyId = 0;
+  for (const auto& group : batch.TriangleGroups)
+  {
+    for (; polyId < group.first; polyId++)
+    {
+      insertPoly(polyId);
+    }
+    polyBuilder.Reset();
+    for (; polyId < group.second; polyId++)
+    {
+      polys->GetCellAtId(polyId, pts);
+      if (pts->GetNumberOfIds() == 3)
+      {
+        const vtkIdType triangle[3] = { ptMap[pts->GetId(0)], ptMap[pts->GetId(1)],
+          ptMap[pts->GetId(2)] };
+        polyBuilder.InsertTriangle(triangle);
+      }
+      else
+      {
+        insertPoly(polyId);
+      }
+    }
+    polyBuilder.GetPolygons(polyCollection);
+    for (int i = 0; i < polyCollection->GetNumberOfItems(); ++i)
+    {
+      vtkIdList* poly = polyCollection->GetItem(i);
+      if (poly->GetNumberOfIds() != 0)
+      {
+        newPolys->InsertNextCell(poly);
+        newPolyCellIds.push_back(polyCellIds[group.first]);
+      }
+      poly->Delete();
+    }
+    polyCollection->RemoveAllItems();
+  }
+  for (; polyId < polys->GetNumberOfCells(); polyId++)
+  {
+    insertPoly(polyId);
+  }
+
+  batch.Cells[2] = newPolys;
+  batch.CellIds[2] = std::move(newPolyCellIds);
+}
+
+// Concatenate the contours of the batches into the output, merging their
+// coincident points. The output point data must have been allocated from the
+// same point data as the point data of the batches.
+void BuildOutput(std::vector<vtkContourGridBatch>& batches, int pointsType,
+  bool generateTriangles, vtkCellData* inCd, vtkPolyData* output)
+{
+  const vtkIdType numBatches = static_cast<vtkIdType>(batches.size());
+  std::vector<vtkIdType> pointOffsets(numBatches + 1, 0);
+  for (vtkIdType i = 0; i < numBatches; i++)
+  {
+    const vtkContourGridBatch& batch = batches[i];
+    pointOffsets[i + 1] =
+      pointOffsets[i] + (batch.Points ? batch.Points->GetNumberOfPoints() : 0);
+  }
+  const vtkIdType numPts = pointOffsets[numBatches];
+
+  // Gather the points of the batches and merge the coincident ones.
+  vtkNew<vtkPoints> allPts;
+  allPts->SetDataType(pointsType);
+  allPts->SetNumberOfPoints(numPts);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      for (vtkIdType j = 0; j < pointOffsets[i + 1] - pointOffsets[i]; j++)
+      {
+        batches[i].Points->GetPoint(j, x);
+        allPts->SetPoint(pointOffsets[i] + j, x);
+      }
+    }
+  });
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(pointsType);
+  std::vector<vtkIdType> ptMap(numPts);
+  std::vector<vtkIdType> firstPtIds;
+  if (numPts > 0)
+  {
+    ::MergeCoincidentPoints(allPts, newPts, ptMap, firstPtIds);
+  }
+  const vtkIdType numNewPts = newPts->GetNumberOfPoints();
+  output->SetPoints(newPts);
+
+  // Without GenerateTriangles, the polygons refer to the merged points.
+  if (!generateTriangles)
+  {
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        if (batches[i].Points)
+        {
+          ::MergeTriangles(batches[i], ptMap.data() + pointOffsets[i]);
+        }
+      }
+    });
+  }
+
+  // Each point takes the attributes interpolated by its first occurrence.
+  vtkPointData* outPd = output->GetPointData();
+  const int numArrays = outPd->GetNumberOfArrays();
+  for (int a = 0; a < numArrays; a++)
+  {
+    outPd->GetAbstractArray(a)->SetNumberOfTuples(numNewPts);
+  }
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType firstPtId = firstPtIds[ptId];
+      const vtkIdType batchId =
+        std::upper_bound(pointOffsets.begin(), pointOffsets.end(), firstPtId) -
+        pointOffsets.begin() - 1;
+      vtkPointData* batchPd = batches[batchId].PointData;
+      for (int a = 0; a < numArrays; a++)
+      {
+        outPd->GetAbstractArray(a)->SetTuple(
+          ptId, firstPtId - pointOffsets[batchId], batchPd->GetAbstractArray(a));
+      }
+    }
+  });
+
+  std::vector<vtkIdType> cellOffsets[3];
+  std::vector<vtkIdType> connOffsets[3];
+  for (int type = 0; type < 3; type++)
+  {
+    cellOffsets[type].assign(numBatches + 1, 0);
+    connOffsets[type].assign(numBatches + 1, 0);
+    for (vtkIdType i = 0; i < numBatches; i++)
+    {
+      const vtkCellArray* cells = batches[i].Cells[type];
+      cellOffsets[type][i + 1] = cellOffsets[type][i] + (cells ? cells->GetNumberOfCells() : 0);
+      connOffsets[type][i + 1] =
+        connOffsets[type][i] + (cells ? cells->GetNumberOfConnectivityIds() : 0);
+    }
+  }
+
+  // Vertices, lines and polygons are numbered in this order by the cell data.
+  vtkIdType numCells = 0;
+  for (int type = 0; type < 3; type++)
+  {
+    numCells += cellOffsets[type][numBatches];
+  }
+  vtkCellData* outCd = output->GetCellData();
+  outCd->CopyAllocate(inCd, numCells);
+  ArrayList arrays;
+  arrays.AddArrays(numCells, inCd, outCd, 0.0, false);
+
+  vtkIdType firstCellId = 0;
+  for (int type = 0; type < 3; type++)
+  {
+    const vtkIdType numTypeCells = cellOffsets[type][numBatches];
+    const vtkIdType connSize = connOffsets[type][numBatches];
+    if (numTypeCells == 0)
+    {
+      continue;
+    }
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numTypeCells + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(connSize);
+    const bool mergedIds = type == 2 && !generateTriangles;
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        const vtkContourGridBatch& batch = batches[i];
+        if (!batch.Points)
+        {
+          continue;
+        }
+        vtkIdType cellId = cellOffsets[type][i];
+        vtkIdType connId = connOffsets[type][i];
+        auto iter = vtk::TakeSmartPointer(batch.Cells[type]->NewIterator());
+        for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+        {
+          iter->GetCurrentCell(npts, pts);
+          offsets->SetValue(cellId, connId);
+          for (vtkIdType j = 0; j < npts; j++)
+          {
+            const vtkIdType ptId = mergedIds ? pts[j] : ptMap[pointOffsets[i] + pts[j]];
+            connectivity->SetValue(connId++, ptId);
+          }
+          arrays.Copy(batch.CellIds[type][cellId - cellOffsets[type][i]], firstCellId + cellId);
+          cellId++;
+        }
+      }
+    });
+    offsets->SetValue(numTypeCells, connSize);
+    firstCellId += numTypeCells;
+
+    vtkNew<vtkCellArray> cells;
+    cells->SetData(offsets, connectivity);
+    if (type == 0)
+    {
+      output->SetVerts(cells);
+    }
+    else if (type == 1)
+    {
+      output->SetLines(cells);
+    }
+    else
+    {
+      output->SetPolys(cells);
+    }
+  }
+}
+
+// Contour the cells in parallel by batches, in the order of the serial
+// contouring, see vtkContourGridExecute.
+void ContourInParallel(vtkContourGrid* self, vtkUnstructuredGridBase* input, vtkPolyData* output,
+  vtkDataArray* inScalars, vtkIdType numContours, double* values, vtkTypeBool computeScalars,
+  int useScalarTree, vtkScalarTree* scalarTree, bool generateTriangles)
+{
+  vtkSmartPointer<vtkPointData> inPd = ::GetPointDataToInterpolate(input, inScalars);
+  vtkPointData* outPd = output->GetPointData();
+  if (!computeScalars)
+  {
+    outPd->CopyScalarsOff();
+  }
+  outPd->InterpolateAllocate(inPd, 0);
+  const int pointsType = ::GetOutputPointsType(self, input);
+
+  // The first call to GetCell() is not thread safe.
+  vtkNew<vtkGenericCell> cell;
+  input->GetCell(0, cell);
+
+  ContourCells contour(
+    self, input, inScalars, inPd, pointsType, computeScalars, generateTriangles);
+  std::vector<vtkContourGridBatch> batches;
+  auto contourBatches = [&](vtkIdType numCells) {
+    const vtkIdType numBatches = (numCells - 1) / ContourGridBatchSize + 1;
+    const size_t firstBatch = batches.size();
+    batches.resize(firstBatch + numBatches);
+    contour.Batches = batches.data() + firstBatch;
+    contour.NumberOfCells = numCells;
+    vtkSMPTools::For(0, numBatches, contour);
+  };
+
+  if (!useScalarTree)
+  {
+    // Process the lower dimensional cells first, as the serial contouring.
+    unsigned char cellTypeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    vtkCutter::GetCellTypeDimensions(cellTypeDimensions);
+    bool hasDimension[4] = { false, false, false, false };
+    vtkNew<vtkCellTypes> cellTypes;
+    input->GetCellTypes(cellTypes);
+    for (vtkIdType i = 0; i < cellTypes->GetNumberOfTypes(); i++)
+    {
+      const unsigned char cellType = cellTypes->GetCellType(i);
+      if (cellType >= VTK_NUMBER_OF_CELL_TYPES)
+      { // Protect against new cell types added.
+        vtkGenericWarningMacro("Unknown cell type " << static_cast<int>(cellType));
+        continue;
+      }
+      hasDimension[cellTypeDimensions[cellType]] = true;
+    }
+
+    contour.CellTypeDimensions = cellTypeDimensions;
+    contour.Values = values;
+    contour.NumberOfValues = numContours;
+    // We skip 0d cells (points), because they cannot be cut (generate no data).
+    for (int dimensionality = 1; dimensionality <= 3 && !self->GetAbortOutput(); ++dimensionality)
+    {
+      if (hasDimension[dimensionality])
+      {
+        contour.Dimension = dimensionality;
+        contourBatches(input->GetNumberOfCells());
+      }
+    }
+  }
+  else
+  {
+    // Contour the candidate cells of the scalar tree for each contour value.
+    std::vector<vtkIdType> candidateCells;
+    for (vtkIdType i = 0; i < numContours && !self->GetAbortOutput(); i++)
+    {
+      candidateCells.clear();
+      const vtkIdType numTreeBatches = scalarTree->GetNumberOfCellBatches(values[i]);
+      for (vtkIdType treeBatch = 0; treeBatch < numTreeBatches; treeBatch++)
+      {
+        vtkIdType numCells;
+        const vtkIdType* cellIds = scalarTree->GetCellBatch(treeBatch, numCells);
+        candidateCells.insert(candidateCells.end(), cellIds, cellIds + numCells);
+      }
+      if (!candidateCells.empty())
+      {
+        contour.CandidateCells = candidateCells.data();
+        contour.Values = values + i;
+        contour.NumberOfValues = 1;
+        contourBatches(static_cast<vtkIdType>(candidateCells.size()));
+      }
+    }
+  }
+
+  ::BuildOutput(batches, pointsType, generateTriangles, input->GetCellData(), output);
+  output->Squeeze();
+}
+}
+
 //------------------------------------------------------------------------------
 void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData* output,
   vtkDataArray* inScalars, vtkIdType numContours, double* values, vtkTypeBool computeScalars,
@@ -111,25 +770,7 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
   vtkIdType numCells, estimatedSize;
   vtkNew<vtkDoubleArray> cellScalars;
 
-  vtkPointData* inPdOriginal = input->GetPointData();
-
-  // We don't want to change the active scalars in the input, but we
-  // need to set the active scalars to match the input array to
-  // process so that the point data copying works as expected. Create
-  // a shallow copy of point data so that we can do this without
-  // changing the input.
-  vtkSmartPointer<vtkPointData> inPd = vtkSmartPointer<vtkPointData>::New();
-  inPd->ShallowCopy(inPdOriginal);
-
-  // Keep track of the old active scalars because when we set the new
-  // scalars, the old scalars are removed from the point data entirely
-  // and we have to add them back.
-  vtkAbstractArray* oldScalars = inPd->GetScalars();
-  inPd->SetScalars(inScalars);
-  if (oldScalars)
-  {
-    inPd->AddArray(oldScalars);
-  }
+  vtkSmartPointer<vtkPointData> inPd = ::GetPointDataToInterpolate(input, inScalars);
   vtkPointData* outPd = output->GetPointData();
 
   vtkCellData* inCd = input->GetCellData();
@@ -158,18 +799,7 @@ void vtkContourGridExecute(vtkContourGrid* self, vtkDataSet* input, vtkPolyData*
   newPts = vtkPoints::New();
 
   // set precision for the points in the output
-  if (self->GetOutputPointsPrecision() == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(grid->GetPoints()->GetDataType());
-  }
-  else if (self->GetOutputPointsPrecision() == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if (self->GetOutputPointsPrecision() == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
+  newPts->SetDataType(::GetOutputPointsType(self, grid));
 
   newPts->Allocate(estimatedSize, estimatedSize);
   newVerts = vtkCellArray::New();
@@ -410,8 +1040,18 @@ int vtkContourGrid::RequestData(vtkInformation* vtkNotUsed(request),
     scalarTree->SetScalars(inScalars);
   }
 
-  vtkContourGridExecute(this, input, output, inScalars, numContours, values, computeScalars,
-    useScalarTree, scalarTree, this->GenerateTriangles != 0);
+  if (this->Locator->IsA("vtkMergePoints") && input->IsA("vtkUnstructuredGrid"))
+  {
+    // vtkMergePoints merges the points whose coordinates are the same, which
+    // the parallel contouring reproduces.
+    ::ContourInParallel(this, input, output, inScalars, numContours, values, computeScalars,
+      useScalarTree, scalarTree, this->GenerateTriangles != 0);
+  }
+  else
+  {
+    vtkContourGridExecute(this, input, output, inScalars, numContours, values, computeScalars,
+      useScalarTree, scalarTree, this->GenerateTriangles != 0);
+  }
 
   if (this->ComputeNormals)
   {
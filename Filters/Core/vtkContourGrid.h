@@ -22,6 +22,15 @@
  * contours are being extracted. If you want to use a scalar tree,
  * invoke the method UseScalarTreeOn().
  *
+ * When the input is a vtkUnstructuredGrid and the locator is a
+ * vtkMergePoints (the default), the cells are contoured in parallel with
+ * vtkSMPTools, by batches, and the coincident points of the batches are
+ * merged afterwards. The output does not depend on the number of threads,
+ * and its points and cells are numbered as with the serial contouring, with
+ * the exception of the orientation of the polygons of polyhedra, which
+ * depends on the point ids. With other locators, the cells are contoured
+ * serially.
+ *
  * @warning
  * If the input vtkUnstructuredGrid contains 3D linear cells, the class
  * vtkContour3DLinearGrid is much faster and may be preferred in certain
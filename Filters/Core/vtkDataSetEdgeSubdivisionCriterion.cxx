@@ -11,6 +11,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -23,6 +24,7 @@ vtkDataSetEdgeSubdivisionCriterion::vtkDataSetEdgeSubdivisionCriterion()
   this->CurrentMesh = nullptr;
   this->CurrentCellId = -1;
   this->CurrentCellData = nullptr;
+  this->GenericCell = vtkGenericCell::New();
   this->ChordError2 = 1e-6;
   // We require this->FieldError2 to be a valid address at all times -- it
   // may never be null
@@ -36,6 +38,7 @@ vtkDataSetEdgeSubdivisionCriterion::~vtkDataSetEdgeSubdivisionCriterion()
 {
   if (this->CurrentMesh)
     this->CurrentMesh->UnRegister(this);
+  this->GenericCell->Delete();
   delete[] this->FieldError2;
 }
 
@@ -57,12 +60,13 @@ void vtkDataSetEdgeSubdivisionCriterion::SetMesh(vtkDataSet* mesh)
     this->CurrentMesh->UnRegister(this);
 
   this->CurrentMesh = mesh;
+  this->CurrentCellId = -1;
+  this->CurrentCellData = nullptr;
   this->Modified();
 
   if (this->CurrentMesh)
   {
     this->CurrentMesh->Register(this);
-    this->CurrentMesh->Modified();
   }
 }
 
@@ -78,7 +82,10 @@ void vtkDataSetEdgeSubdivisionCriterion::SetCellId(vtkIdType cell)
 
   if (this->CurrentMesh)
   {
-    this->CurrentCellData = this->CurrentMesh->GetCell(this->CurrentCellId);
+    // The cell is owned by the criterion rather than the mesh so that
+    // criteria working on the same mesh may be used by concurrent threads.
+    this->CurrentMesh->GetCell(this->CurrentCellId, this->GenericCell);
+    this->CurrentCellData = this->GenericCell;
     this->CurrentCellData->Modified();
   }
 
@@ -113,11 +120,12 @@ void vtkDataSetEdgeSubdivisionCriterion::EvaluatePointDataField(
   int npts = ptIds->GetNumberOfIds();
   int nc = array->GetNumberOfComponents();
   int i, j;
+  std::vector<double> tuple(nc);
   for (j = 0; j < nc; ++j)
     result[j] = 0.;
   for (i = 0; i < npts; ++i)
   {
-    double* tuple = array->GetTuple(ptIds->GetId(i));
+    array->GetTuple(ptIds->GetId(i), tuple.data());
     for (j = 0; j < nc; ++j)
       result[j] += weights[i] * tuple[j];
   }
@@ -133,16 +141,12 @@ void vtkDataSetEdgeSubdivisionCriterion::EvaluateCellDataField(
   // not constant over the cell. There's no real way to represent this in VTK,
   // so at the moment, this code punts and assumes cell-constant data.
   vtkDataArray* array = this->CurrentMesh->GetCellData()->GetArray(field);
-  int nc = array->GetNumberOfComponents();
-  int j;
-  double* tuple = array->GetTuple(this->CurrentCellId);
-  for (j = 0; j < nc; ++j)
-    result[j] = tuple[j];
+  array->GetTuple(this->CurrentCellId, result);
 }
 
 bool vtkDataSetEdgeSubdivisionCriterion::EvaluateLocationAndFields(double* midpt, int field_start)
 {
-  static int dummySubId = -1;
+  int dummySubId = -1;
   double realMidPt[3];
 
   std::vector<double> weights(this->CurrentCellData->GetNumberOfPoints());
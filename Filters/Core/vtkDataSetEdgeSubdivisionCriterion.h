@@ -31,6 +31,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCell;
 class vtkDataSet;
+class vtkGenericCell;
 
 class VTKFILTERSCORE_EXPORT vtkDataSetEdgeSubdivisionCriterion : public vtkEdgeSubdivisionCriterion
 {
@@ -152,6 +153,7 @@ protected:
   vtkDataSet* CurrentMesh;
   vtkIdType CurrentCellId;
   vtkCell* CurrentCellData;
+  vtkGenericCell* GenericCell; // Holds the current cell
 
   double ChordError2;
   double* FieldError2;
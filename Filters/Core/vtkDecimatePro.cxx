@@ -3,18 +3,28 @@
 #include "vtkDecimatePro.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangle.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDecimatePro);
@@ -73,9 +83,11 @@ vtkDecimatePro::vtkDecimatePro()
   this->BoundaryVertexDeletion = 1;
   this->InflectionPointRatio = 10.0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->NumberOfPartitions = 1;
 
   this->Queue = nullptr;
   this->VertexError = nullptr;
+  this->LockedPoints = nullptr;
 
   this->Mesh = nullptr;
 }
@@ -113,20 +125,11 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPolyData* input = vtkPolyData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkIdType i, ptId, numPts, numTris, collapseId;
-  vtkPoints* inPts;
+  vtkIdType i, ptId, numPts, numTris;
   vtkPoints* newPts;
-  vtkCellArray* inPolys;
   vtkCellArray* newPolys;
-  double error, previousError = 0.0, reduction;
-  int type;
-  vtkIdType npts;
-  const vtkIdType* pts;
-  vtkIdType totalEliminated, numRecycles, numPops;
-  vtkIdType ncells;
-  vtkIdType pt1, pt2, cellId, fedges[2];
-  vtkIdType* cells;
-  vtkIdList* CollapseTris;
+  vtkIdType totalEliminated;
+  vtkIdType cellId;
   double max;
   if (!input)
   {
@@ -134,11 +137,8 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
   vtkPointData* outputPD = output->GetPointData();
-  vtkPointData* inPD = input->GetPointData();
   vtkPointData* meshPD = nullptr;
   vtkIdType *map, numNewPts, totalPts;
-  vtkIdType newCellPts[3];
-  bool abortExecute = false;
 
   vtkDebugMacro(<< "Executing progressive decimation...");
 
@@ -185,61 +185,192 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  if (this->TargetReduction <= 0.0)
+  {
+    output->CopyStructure(input);
+    output->GetPointData()->PassData(input->GetPointData());
+    output->GetCellData()->PassData(input->GetCellData());
+    // vtkWarningMacro(<<"Reduction == 0: passing data through unchanged");
+    return 1;
+  }
+
+  if (this->NumberOfPartitions > 1)
+  {
+    this->DecimatePartitions(input, output);
+    return 1;
+  }
+
   // Build cell data structure. Need to copy triangle connectivity data
   // so we can modify it.
-  if (this->TargetReduction > 0.0)
-  {
-    inPts = input->GetPoints();
-    inPolys = input->GetPolys();
+  this->InitializeMesh(input);
+  newPts = this->Mesh->GetPoints();
+  meshPD = this->Mesh->GetPointData();
+
+  totalEliminated = this->DecimateMesh(numTris);
 
-    // this static should be eliminated
-    if (this->Mesh != nullptr)
+  //
+  // Create output and release memory
+  //
+  vtkDebugMacro(<< "Creating output...");
+  totalPts = this->Mesh->GetNumberOfPoints();
+
+  // Grab the points that are left; copy point data. Remember that splitting
+  // data may have added new points. The used points are flagged in
+  // parallel, numbered in order, then copied in parallel.
+  map = new vtkIdType[totalPts];
+  vtkPolyData* mesh = this->Mesh;
+  vtkSMPTools::For(0, totalPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType nPtCells;
+    vtkIdType* ptCells;
+    for (vtkIdType id = begin; id < end; id++)
+    {
+      mesh->GetPointCells(id, nPtCells, ptCells);
+      map[id] = (nPtCells > 0 ? 0 : -1);
+    }
+  });
+  numNewPts = 0;
+  for (ptId = 0; ptId < totalPts; ptId++)
+  {
+    if (map[ptId] > -1)
     {
-      this->Mesh->Delete();
-      this->Mesh = nullptr;
+      map[ptId] = numNewPts++;
     }
-    this->Mesh = vtkPolyData::New();
+  }
 
-    newPts = vtkPoints::New();
+  vtkNew<vtkPoints> outPts;
+  outPts->SetDataType(newPts->GetDataType());
+  outPts->SetNumberOfPoints(numNewPts);
+  outputPD->CopyAllocate(meshPD, numNewPts);
+  outputPD->SetNumberOfTuples(numNewPts);
 
-    if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  vtkSMPTools::For(0, totalPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType id = begin; id < end; id++)
     {
-      newPts->SetDataType(inPts->GetDataType());
+      if (map[id] > -1)
+      {
+        newPts->GetPoint(id, x);
+        outPts->SetPoint(map[id], x);
+        outputPD->CopyData(meshPD, id, map[id]);
+      }
     }
-    else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  });
+
+  // Now renumber connectivity. Deleted triangles are no longer of type
+  // VTK_TRIANGLE; the remaining ones are renumbered in parallel.
+  std::vector<vtkIdType> keptTris;
+  keptTris.reserve(numTris - totalEliminated);
+  for (cellId = 0; cellId < numTris; cellId++)
+  {
+    if (this->Mesh->GetCellType(cellId) == VTK_TRIANGLE) // non-null element
     {
-      newPts->SetDataType(VTK_FLOAT);
+      keptTris.push_back(cellId);
     }
-    else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  }
+  vtkIdType numKeptTris = static_cast<vtkIdType>(keptTris.size());
+
+  vtkNew<vtkIdTypeArray> newConn;
+  newConn->SetNumberOfValues(3 * numKeptTris);
+  vtkIdType* conn = newConn->GetPointer(0);
+  vtkCellArray* meshPolys = this->Mesh->GetPolys();
+  vtkSMPTools::For(0, numKeptTris, [&](vtkIdType begin, vtkIdType end) {
+    vtkSmartPointer<vtkCellArrayIterator> iter;
+    iter.TakeReference(meshPolys->NewIterator());
+    vtkIdType nTriPts;
+    const vtkIdType* triPts;
+    for (vtkIdType id = begin; id < end; id++)
     {
-      newPts->SetDataType(VTK_DOUBLE);
+      iter->GetCellAtId(keptTris[id], nTriPts, triPts);
+      for (vtkIdType j = 0; j < 3; j++)
+      {
+        conn[3 * id + j] = map[triPts[j]];
+      }
     }
+  });
+  newPolys = vtkCellArray::New();
+  newPolys->SetData(3, newConn);
 
-    newPts->SetNumberOfPoints(numPts);
-    newPts->DeepCopy(inPts);
-    this->Mesh->SetPoints(newPts);
-    newPts->Delete(); // registered by Mesh and preserved
+  delete[] map;
+  output->SetPoints(outPts);
+  output->SetPolys(newPolys);
+  if (this->Mesh != nullptr)
+  {
+    this->Mesh->Delete();
+    this->Mesh = nullptr;
+  }
+  newPolys->Delete();
 
-    newPolys = vtkCellArray::New();
-    newPolys->DeepCopy(inPolys);
-    this->Mesh->SetPolys(newPolys);
-    newPolys->Delete(); // registered by Mesh and preserved
+  return 1;
+}
 
-    meshPD = this->Mesh->GetPointData();
-    meshPD->DeepCopy(inPD);
-    meshPD->CopyAllocate(meshPD, input->GetNumberOfPoints());
+//------------------------------------------------------------------------------
+// Copy the input into the mesh that is decimated, with editable links.
+void vtkDecimatePro::InitializeMesh(vtkPolyData* input)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inPolys = input->GetPolys();
 
-    this->Mesh->EditableOn();
-    this->Mesh->BuildLinks();
+  // this static should be eliminated
+  if (this->Mesh != nullptr)
+  {
+    this->Mesh->Delete();
+    this->Mesh = nullptr;
   }
-  else
+  this->Mesh = vtkPolyData::New();
+
+  vtkPoints* newPts = vtkPoints::New();
+
+  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
   {
-    output->CopyStructure(input);
-    output->GetPointData()->PassData(input->GetPointData());
-    output->GetCellData()->PassData(input->GetCellData());
-    // vtkWarningMacro(<<"Reduction == 0: passing data through unchanged");
-    return 1;
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
   }
+  else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
+
+  newPts->SetNumberOfPoints(input->GetNumberOfPoints());
+  newPts->DeepCopy(inPts);
+  this->Mesh->SetPoints(newPts);
+  newPts->Delete(); // registered by Mesh and preserved
+
+  vtkCellArray* newPolys = vtkCellArray::New();
+  newPolys->DeepCopy(inPolys);
+  this->Mesh->SetPolys(newPolys);
+  newPolys->Delete(); // registered by Mesh and preserved
+
+  vtkPointData* meshPD = this->Mesh->GetPointData();
+  meshPD->DeepCopy(input->GetPointData());
+  meshPD->CopyAllocate(meshPD, input->GetNumberOfPoints());
+
+  this->Mesh->EditableOn();
+  this->Mesh->BuildLinks();
+}
+
+//------------------------------------------------------------------------------
+// Decimate the mesh, whose numTris cells are triangles, until the target
+// reduction or the maximum error is reached. Return the number of deleted
+// triangles.
+vtkIdType vtkDecimatePro::DecimateMesh(vtkIdType numTris)
+{
+  vtkIdType i, ptId, numPts, collapseId;
+  double error, previousError = 0.0, reduction;
+  int type;
+  vtkIdType npts;
+  vtkIdType totalEliminated, numRecycles, numPops;
+  vtkIdType ncells;
+  vtkIdType pt1, pt2, fedges[2];
+  vtkIdType* cells;
+  vtkIdList* CollapseTris;
+  vtkIdType totalPts;
+  bool abortExecute = false;
+
+  numPts = this->Mesh->GetNumberOfPoints();
+  this->NumberOfRemainingTris = numTris;
 
   // Initialize data structures: priority queue and errors.
   this->InitializeQueue(numPts);
@@ -357,72 +488,238 @@ int vtkDecimatePro::RequestData(vtkInformation* vtkNotUsed(request),
                 << "\n\tAdded " << totalPts - numPts << " points (" << numPts << " to " << totalPts
                 << " points)");
 
-  //
-  // Create output and release memory
-  //
-  vtkDebugMacro(<< "Creating output...");
   this->DeleteQueue();
 
-  // Grab the points that are left; copy point data. Remember that splitting
-  // data may have added new points.
-  map = new vtkIdType[totalPts];
-  for (i = 0; i < totalPts; i++)
+  return totalEliminated;
+}
+
+//------------------------------------------------------------------------------
+// Decimate slabs of the mesh in parallel, with their shared vertices locked,
+// then merge them into the output.
+void vtkDecimatePro::DecimatePartitions(vtkPolyData* input, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inPolys = input->GetPolys();
+  vtkPointData* inPD = input->GetPointData();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numTris = inPolys->GetNumberOfCells();
+  int numPartitions = this->NumberOfPartitions;
+
+  // Bin the triangles into slabs along the longest axis, by their centers.
+  const double* bounds = input->GetBounds();
+  int axis = 0;
+  for (int i = 1; i < 3; i++)
   {
-    map[i] = -1;
+    if (bounds[2 * i + 1] - bounds[2 * i] > bounds[2 * axis + 1] - bounds[2 * axis])
+    {
+      axis = i;
+    }
   }
-  numNewPts = 0;
-  for (ptId = 0; ptId < totalPts; ptId++)
+  double origin = bounds[2 * axis];
+  double length = bounds[2 * axis + 1] - origin;
+  std::vector<int> triPartitions(numTris);
+  vtkSMPThreadLocalObject<vtkIdList> localTriPts;
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* triPts = localTriPts.Local();
+    double x[3];
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      inPolys->GetCellAtId(cellId, triPts);
+      double center = 0.0;
+      for (vtkIdType j = 0; j < 3; j++)
+      {
+        inPts->GetPoint(triPts->GetId(j), x);
+        center += x[axis] / 3.0;
+      }
+      int partition =
+        (length > 0.0 ? static_cast<int>((center - origin) / length * numPartitions) : 0);
+      triPartitions[cellId] = std::min(std::max(partition, 0), numPartitions - 1);
+    }
+  });
+
+  // Lock the points used by the triangles of several slabs.
+  std::vector<std::vector<vtkIdType>> partitionTris(numPartitions);
+  std::vector<int> ptPartitions(numPts, -1);
+  std::vector<unsigned char> locked(numPts, 0);
+  vtkSmartPointer<vtkCellArrayIterator> iter;
+  iter.TakeReference(inPolys->NewIterator());
+  for (vtkIdType cellId = 0; cellId < numTris; cellId++)
   {
-    this->Mesh->GetPointCells(ptId, ncells, cells);
-    if (ncells > 0)
+    int partition = triPartitions[cellId];
+    partitionTris[partition].push_back(cellId);
+    vtkIdType nTriPts;
+    const vtkIdType* triPts;
+    iter->GetCellAtId(cellId, nTriPts, triPts);
+    for (vtkIdType j = 0; j < nTriPts; j++)
     {
-      map[ptId] = numNewPts++;
+      if (ptPartitions[triPts[j]] < 0)
+      {
+        ptPartitions[triPts[j]] = partition;
+      }
+      else if (ptPartitions[triPts[j]] != partition)
+      {
+        locked[triPts[j]] = 1;
+      }
     }
   }
 
-  outputPD->CopyAllocate(meshPD, numNewPts);
-
-  // Copy points in place
-  for (ptId = 0; ptId < totalPts; ptId++)
+  // Decimate the slabs in parallel, each with its own copy of the
+  // parameters and state of this filter.
+  std::vector<vtkSmartPointer<vtkDecimatePro>> decimators(numPartitions);
+  std::vector<std::vector<vtkIdType>> partitionPts(numPartitions);
+  for (int partition = 0; partition < numPartitions; partition++)
   {
-    if (map[ptId] > -1)
-    {
-      newPts->SetPoint(map[ptId], newPts->GetPoint(ptId));
-      outputPD->CopyData(meshPD, ptId, map[ptId]);
-    }
+    vtkDecimatePro* decimator = vtkDecimatePro::New();
+    decimators[partition].TakeReference(decimator);
+    decimator->TargetReduction = this->TargetReduction;
+    decimator->FeatureAngle = this->FeatureAngle;
+    decimator->MaximumError = this->MaximumError;
+    decimator->AbsoluteError = this->AbsoluteError;
+    decimator->ErrorIsAbsolute = this->ErrorIsAbsolute;
+    decimator->AccumulateError = this->AccumulateError;
+    decimator->SplitAngle = this->SplitAngle;
+    decimator->Splitting = this->Splitting;
+    decimator->PreSplitMesh = this->PreSplitMesh;
+    decimator->BoundaryVertexDeletion = this->BoundaryVertexDeletion;
+    decimator->PreserveTopology = this->PreserveTopology;
+    decimator->Degree = this->Degree;
+    decimator->InflectionPointRatio = this->InflectionPointRatio;
+    decimator->OutputPointsPrecision = this->OutputPointsPrecision;
+    decimator->Error = this->Error;
+    decimator->Tolerance = this->Tolerance;
+    decimator->CosAngle = this->CosAngle;
+    decimator->Split = this->Split;
+    decimator->VertexDegree = this->VertexDegree;
+    decimator->TheSplitAngle = this->TheSplitAngle;
+    decimator->SplitState = this->SplitState;
   }
+  vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+    bool isFirst = !vtkSMPTools::IsParallelScope() || vtkSMPTools::GetSingleThread();
+    vtkNew<vtkIdList> triPts;
+    for (vtkIdType partition = begin; partition < end; partition++)
+    {
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      const std::vector<vtkIdType>& tris = partitionTris[partition];
+      if (tris.empty())
+      {
+        continue;
+      }
 
-  newPts->SetNumberOfPoints(numNewPts);
-  newPts->Squeeze();
+      // Gather the points of the slab, in the order of the input.
+      std::vector<vtkIdType>& pts = partitionPts[partition];
+      for (vtkIdType cellId : tris)
+      {
+        inPolys->GetCellAtId(cellId, triPts);
+        pts.insert(pts.end(), triPts->begin(), triPts->end());
+      }
+      std::sort(pts.begin(), pts.end());
+      pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+      vtkIdType numPartPts = static_cast<vtkIdType>(pts.size());
+
+      vtkNew<vtkPolyData> part;
+      vtkNew<vtkPoints> partPts;
+      partPts->SetDataType(inPts->GetDataType());
+      partPts->SetNumberOfPoints(numPartPts);
+      vtkPointData* partPD = part->GetPointData();
+      partPD->CopyAllocate(inPD, numPartPts);
+      vtkNew<vtkUnsignedCharArray> lockedPts;
+      lockedPts->SetNumberOfValues(numPartPts);
+      double x[3];
+      for (vtkIdType ptId = 0; ptId < numPartPts; ptId++)
+      {
+        inPts->GetPoint(pts[ptId], x);
+        partPts->SetPoint(ptId, x);
+        partPD->CopyData(inPD, pts[ptId], ptId);
+        lockedPts->SetValue(ptId, locked[pts[ptId]]);
+      }
+      vtkNew<vtkCellArray> partPolys;
+      partPolys->AllocateExact(static_cast<vtkIdType>(tris.size()), 3 * tris.size());
+      for (vtkIdType cellId : tris)
+      {
+        inPolys->GetCellAtId(cellId, triPts);
+        partPolys->InsertNextCell(3);
+        for (vtkIdType j = 0; j < 3; j++)
+        {
+          partPolys->InsertCellPoint(
+            std::lower_bound(pts.begin(), pts.end(), triPts->GetId(j)) - pts.begin());
+        }
+      }
+      part->SetPoints(partPts);
+      part->SetPolys(partPolys);
 
-  // Now renumber connectivity
-  newPolys = vtkCellArray::New();
-  newPolys->AllocateEstimate(numTris - totalEliminated, 3);
+      // Only one thread checks for abort through this filter.
+      vtkDecimatePro* decimator = decimators[partition];
+      if (isFirst)
+      {
+        decimator->SetContainerAlgorithm(this);
+      }
+      decimator->InitializeMesh(part);
+      decimator->LockedPoints = lockedPts;
+      decimator->DecimateMesh(static_cast<vtkIdType>(tris.size()));
+      decimator->LockedPoints = nullptr;
+      decimator->SetContainerAlgorithm(nullptr);
+    }
+  });
+  this->InflectionPoints->Reset();
 
-  for (cellId = 0; cellId < numTris; cellId++)
+  // Merge the slabs in order. The locked points are shared by the slabs
+  // using them, the other points belong to a single slab.
+  vtkNew<vtkPoints> outPts;
+  vtkPointData* outputPD = output->GetPointData();
+  bool allocated = false;
+  std::vector<vtkIdType> lockedMap(numPts, -1);
+  vtkNew<vtkIdTypeArray> newConn;
+  newConn->Allocate(3 * numTris);
+  for (int partition = 0; partition < numPartitions; partition++)
   {
-    if (this->Mesh->GetCellType(cellId) == VTK_TRIANGLE) // non-null element
+    vtkPolyData* mesh = decimators[partition]->Mesh;
+    if (mesh == nullptr)
     {
-      this->Mesh->GetCellPoints(cellId, npts, pts);
-      for (i = 0; i < 3; i++)
+      continue;
+    }
+    vtkPointData* meshPD = mesh->GetPointData();
+    if (!allocated)
+    {
+      outPts->SetDataType(mesh->GetPoints()->GetDataType());
+      outputPD->CopyAllocate(meshPD, numPts);
+      allocated = true;
+    }
+    const std::vector<vtkIdType>& pts = partitionPts[partition];
+    vtkIdType numPartPts = static_cast<vtkIdType>(pts.size());
+    std::vector<vtkIdType> map(mesh->GetNumberOfPoints(), -1);
+    vtkIdType numPartTris = static_cast<vtkIdType>(partitionTris[partition].size());
+    vtkIdType nTriPts;
+    const vtkIdType* triPts;
+    for (vtkIdType cellId = 0; cellId < numPartTris; cellId++)
+    {
+      if (mesh->GetCellType(cellId) != VTK_TRIANGLE) // deleted element
       {
-        newCellPts[i] = map[pts[i]];
+        continue;
+      }
+      mesh->GetCellPoints(cellId, nTriPts, triPts);
+      for (vtkIdType j = 0; j < 3; j++)
+      {
+        vtkIdType ptId = triPts[j];
+        vtkIdType& outId =
+          (ptId < numPartPts && locked[pts[ptId]] ? lockedMap[pts[ptId]] : map[ptId]);
+        if (outId < 0)
+        {
+          outId = outPts->InsertNextPoint(mesh->GetPoint(ptId));
+          outputPD->CopyData(meshPD, ptId, outId);
+        }
+        newConn->InsertNextValue(outId);
       }
-      newPolys->InsertNextCell(npts, newCellPts);
     }
+    decimators[partition]->Mesh->Delete();
+    decimators[partition]->Mesh = nullptr;
   }
-
-  delete[] map;
-  output->SetPoints(newPts);
+  output->SetPoints(outPts);
+  vtkNew<vtkCellArray> newPolys;
+  newPolys->SetData(3, newConn);
   output->SetPolys(newPolys);
-  if (this->Mesh != nullptr)
-  {
-    this->Mesh->Delete();
-    this->Mesh = nullptr;
-  }
-  newPolys->Delete();
-
-  return 1;
 }
 
 //------------------------------------------------------------------------------
@@ -471,6 +768,8 @@ void vtkDecimatePro::SplitMesh()
     this->Mesh->GetPointCells(ptId, ncells, cells);
 
     if (ncells > 0 &&
+      !(this->LockedPoints && ptId < this->LockedPoints->GetNumberOfValues() &&
+        this->LockedPoints->GetValue(ptId)) &&
       ((type = this->EvaluateVertex(ptId, ncells, cells, fedges)) == VTK_CORNER_VERTEX ||
         type == VTK_INTERIOR_EDGE_VERTEX || type == VTK_NON_MANIFOLD_VERTEX))
     {
@@ -1592,6 +1891,13 @@ void vtkDecimatePro::Insert(vtkIdType ptId, double error)
   vtkIdType fedges[2];
   vtkIdType ncells;
 
+  // locked points are never deleted or split
+  if (this->LockedPoints && ptId < this->LockedPoints->GetNumberOfValues() &&
+    this->LockedPoints->GetValue(ptId))
+  {
+    return;
+  }
+
   // on value of error, we need to compute it or just insert the point
   if (error < -this->Tolerance)
   {
@@ -1735,5 +2041,6 @@ void vtkDecimatePro::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Inflection Points: " << this->GetNumberOfInflectionPoints() << "\n";
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Number Of Partitions: " << this->NumberOfPartitions << "\n";
 }
 VTK_ABI_NAMESPACE_END
@@ -49,6 +49,12 @@
  * is a conservative global error bounds and decimation error, but requires
  * additional memory and time to compute.
  *
+ * The vertices are removed one at a time, in the global order of the
+ * priority queue, so the decimation itself is serial. The compaction of
+ * the remaining points and triangles into the output is threaded with
+ * vtkSMPTools. Setting NumberOfPartitions above 1 decimates separate parts
+ * of the mesh in parallel instead, see NumberOfPartitions.
+ *
  * @warning
  * To guarantee a given level of reduction, the ivar PreserveTopology must
  * be off; the ivar Splitting is on; the ivar BoundaryVertexDeletion is on;
@@ -76,6 +82,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 class vtkDoubleArray;
 class vtkPriorityQueue;
+class vtkUnsignedCharArray;
 
 class VTKFILTERSCORE_EXPORT vtkDecimatePro : public vtkPolyDataAlgorithm
 {
@@ -264,6 +271,24 @@ public:
    */
   double* GetInflectionPoints();
 
+  ///@{
+  /**
+   * Specify the number of partitions decimated in parallel. If larger than
+   * 1, the triangles are binned into this number of slabs along the longest
+   * axis of the input bounds, according to their centers. Each slab is
+   * decimated separately, with vtkSMPTools, to the target reduction and with
+   * the same error bounds. The vertices shared by two slabs are locked: they
+   * are never deleted, moved or split, so the slabs still match once they
+   * are merged into the output. The locked vertices limit the reduction
+   * near the slab boundaries, the output differs from the serial one, and no
+   * inflection points are computed. The output does not depend on the number
+   * of threads. By default, NumberOfPartitions is 1 and the whole mesh is
+   * decimated serially.
+   */
+  vtkSetClampMacro(NumberOfPartitions, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPartitions, int);
+  ///@}
+
   ///@{
   /**
    * Set/get the desired precision for the output types. See the documentation
@@ -295,6 +320,7 @@ protected:
   double InflectionPointRatio;
   vtkDoubleArray* InflectionPoints;
   int OutputPointsPrecision;
+  int NumberOfPartitions;
 
   // to replace a static object
   vtkIdList* Neighbors;
@@ -383,6 +409,9 @@ protected:
   };
 
 private:
+  void InitializeMesh(vtkPolyData* input);
+  vtkIdType DecimateMesh(vtkIdType numTris);
+  void DecimatePartitions(vtkPolyData* input, vtkPolyData* output);
   void InitializeQueue(vtkIdType numPts);
   void DeleteQueue();
   void Insert(vtkIdType id, double error = -1.0);
@@ -392,6 +421,7 @@ private:
 
   vtkPriorityQueue* Queue;
   vtkDoubleArray* VertexError;
+  vtkUnsignedCharArray* LockedPoints; // Points never deleted or split, if any
 
   VertexArray* V;
   TriArray* T;
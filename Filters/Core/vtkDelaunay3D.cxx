@@ -3,20 +3,29 @@
 
 #include "vtkDelaunay3D.h"
 
+#include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDelaunay3D);
 
@@ -127,6 +136,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->BoundingTriangulation = 0;
   this->Offset = 2.5;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->InsertionBatchSize = 1;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
   this->References = nullptr;
@@ -160,60 +170,100 @@ vtkDelaunay3D::~vtkDelaunay3D()
 static int GetTetraFaceNeighbor(vtkUnstructuredGrid* Mesh, vtkIdType tetraId, vtkIdType p1,
   vtkIdType p2, vtkIdType p3, vtkIdType& nei);
 
+namespace
+{
 //------------------------------------------------------------------------------
-// Find all faces that enclose a point. (Enclosure means not satisfying
-// Delaunay criterion.) This method works in two distinct parts. First, the
-// tetrahedra containing the point are found (there may be more than one if
-// the point falls on an edge or face). Next, face neighbors of these points
-// are visited to see whether they satisfy the Delaunay criterion. Face
-// neighbors are visited repeatedly until no more tetrahedron are found.
-// Enclosing tetras are returned in the tetras list; the enclosing faces
-// are returned in the faces list.
-vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Mesh,
-  vtkIdList* tetras, vtkIdList* faces, vtkIncrementalPointLocator* locator)
+// See whether point is in sphere of tetrahedron
+bool InSphere(const double x[3], const vtkDelaunayTetra* tetra)
 {
-  vtkIdType tetraId, i, numTetras;
-  int j, insertFace;
-  vtkIdType p1, p2, p3, nei;
-  int hasNei;
-  const vtkIdType* tetraPts;
+  double dist2 = (x[0] - tetra->center[0]) * (x[0] - tetra->center[0]) +
+    (x[1] - tetra->center[1]) * (x[1] - tetra->center[1]) +
+    (x[2] - tetra->center[2]) * (x[2] - tetra->center[2]);
+
+  return dist2 < (0.9999999999L * tetra->r2);
+}
+
+//------------------------------------------------------------------------------
+// Walk from tetraId towards the tetrahedron containing x, crossing the face
+// opposite to the most negative barycentric coordinate. Return -1 if the
+// walk leaves the triangulation or wanders. The mesh is only read, so this
+// can be called from several threads.
+vtkIdType WalkToTetra(vtkUnstructuredGrid* Mesh, double x[3], vtkIdType tetraId, int depth)
+{
+  double p[4][3];
+  double b[4];
   vtkIdType npts;
-  vtkIdType closestPoint;
-  double xd[3];
-  xd[0] = x[0];
-  xd[1] = x[1];
-  xd[2] = x[2];
+  vtkIdType tetraPts[4];
+  vtkPoints* points = Mesh->GetPoints();
+  vtkCellArray* cells = Mesh->GetCells();
 
-  // Start off by finding closest point and tetras that use the point.
-  // This will serve as the starting point to determine an enclosing
-  // tetrahedron. (We just need a starting point
-  if (locator->IsInsertedPoint(x) >= 0)
+  // prevent aimless wandering and death by recursion
+  for (; depth <= 200; ++depth)
   {
-    this->NumberOfDuplicatePoints++;
-    return 0;
-  }
+    cells->GetCellAtId(tetraId, npts, tetraPts);
+    for (int j = 0; j < 4; j++) // load the points
+    {
+      points->GetPoint(tetraPts[j], p[j]);
+    }
 
-  closestPoint = locator->FindClosestInsertedPoint(x);
-  vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
-  int numCells = links->GetNcells(closestPoint);
-  vtkIdType* cells = links->GetCells(closestPoint);
-  if (numCells <= 0) // shouldn't happen
-  {
-    this->NumberOfDegeneracies++;
-    return 0;
-  }
-  else
-  {
-    tetraId = cells[0];
-  }
+    vtkTetra::BarycentricCoords(x, p[0], p[1], p[2], p[3], b);
 
-  // Okay, walk towards the containing tetrahedron
-  tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
-  if (tetraId < 0)
-  {
-    this->NumberOfDegeneracies++;
-    return 0;
+    // find the most negative face
+    int neg = 0;
+    int numNeg = 0;
+    double negValue = VTK_DOUBLE_MAX;
+    for (int j = 0; j < 4; j++)
+    {
+      if (b[j] < 0.0)
+      {
+        numNeg++;
+        if (b[j] < negValue)
+        {
+          negValue = b[j];
+          neg = j;
+        }
+      }
+    }
+
+    // if no negatives, then inside this tetra
+    if (numNeg <= 0)
+    {
+      return tetraId;
+    }
+
+    // okay, march towards the most negative direction
+    vtkIdType facePts[3];
+    for (int j = 0, k = 0; j < 4; j++)
+    {
+      if (j != neg)
+      {
+        facePts[k++] = tetraPts[j];
+      }
+    }
+    if (!GetTetraFaceNeighbor(Mesh, tetraId, facePts[0], facePts[1], facePts[2], tetraId))
+    {
+      return -1;
+    }
   }
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+// Starting from the tetrahedron tetraId containing x, visit the face
+// neighbors to gather the tetras whose circumsphere contains x and the faces
+// bounding them. All visited tetras are listed in checkedTetras. The mesh
+// is only read, so this can be called from several threads.
+void FindInsertionPolyhedron(vtkUnstructuredGrid* Mesh, vtkTetraArray* tetraArray,
+  const double x[3], vtkIdType tetraId, vtkIdList* tetras, vtkIdList* faces,
+  vtkIdList* checkedTetras)
+{
+  vtkIdType i, numTetras;
+  int j, insertFace;
+  vtkIdType p1, p2, p3, nei;
+  int hasNei;
+  vtkIdType npts;
+  vtkIdType tetraPts[4];
+  vtkCellArray* cells = Mesh->GetCells();
 
   // Initialize the list of tetras who contain the point according
   // to the Delaunay criterion.
@@ -222,9 +272,9 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
   // Okay, check neighbors for Delaunay criterion. Purpose is to find
   // list of enclosing faces and deleted tetras.
   numTetras = tetras->GetNumberOfIds();
-  for (this->CheckedTetras->Reset(), i = 0; i < numTetras; i++)
+  for (checkedTetras->Reset(), i = 0; i < numTetras; i++)
   {
-    this->CheckedTetras->InsertId(i, tetras->GetId(i));
+    checkedTetras->InsertId(i, tetras->GetId(i));
   }
 
   p1 = 0;
@@ -233,7 +283,7 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
   for (i = 0; i < numTetras; i++)
   {
     tetraId = tetras->GetId(i);
-    Mesh->GetCellPoints(tetraId, npts, tetraPts);
+    cells->GetCellAtId(tetraId, npts, tetraPts);
     for (j = 0; j < 4; j++)
     {
       insertFace = 0;
@@ -273,9 +323,9 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
       }
       else
       {
-        if (this->CheckedTetras->IsId(nei) == -1) // if not checked
+        if (checkedTetras->IsId(nei) == -1) // if not checked
         {
-          if (this->InSphere(xd, nei)) // if point inside circumsphere
+          if (::InSphere(x, tetraArray->GetTetra(nei))) // if point inside circumsphere
           {
             numTetras++;
             tetras->InsertNextId(nei); // delete this tetra
@@ -284,7 +334,7 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
           {
             insertFace = 1; // this is a boundary face
           }
-          this->CheckedTetras->InsertNextId(nei); // okay, we've checked it
+          checkedTetras->InsertNextId(nei); // okay, we've checked it
         }
         else
         {
@@ -304,102 +354,108 @@ vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Me
 
     } // for each tetra face
   }   // for all deleted tetras
+}
 
-  // Okay, let's delete the tetras and prepare the data structure
-  for (i = 0; i < tetras->GetNumberOfIds(); i++)
+// Insertion polyhedron of a point of a batch, searched in parallel
+struct BatchPolyhedron
+{
+  enum StatusType
   {
-    tetraId = tetras->GetId(i);
-    Mesh->GetCellPoints(tetraId, npts, tetraPts);
-    for (j = 0; j < 4; j++)
-    {
-      this->References[tetraPts[j]]--;
-      Mesh->RemoveReferenceToCell(tetraPts[j], tetraId);
-    }
-  }
-
-  return (faces->GetNumberOfIds() / 3);
+    DUPLICATE, // the point was already inserted
+    FOUND,     // the polyhedron is listed below
+    NOT_FOUND  // no enclosing tetra found, search again when inserting
+  };
+
+  StatusType Status = NOT_FOUND;
+  vtkNew<vtkIdList> Tetras;
+  vtkNew<vtkIdList> Faces;
+  vtkNew<vtkIdList> CheckedTetras;
+};
 }
 
 //------------------------------------------------------------------------------
-int vtkDelaunay3D::FindTetra(vtkUnstructuredGrid* Mesh, double x[3], vtkIdType tetraId, int depth)
+// Find all faces that enclose a point. (Enclosure means not satisfying
+// Delaunay criterion.) This method works in two distinct parts. First, the
+// tetrahedra containing the point are found (there may be more than one if
+// the point falls on an edge or face). Next, face neighbors of these points
+// are visited to see whether they satisfy the Delaunay criterion. Face
+// neighbors are visited repeatedly until no more tetrahedron are found.
+// Enclosing tetras are returned in the tetras list; the enclosing faces
+// are returned in the faces list.
+vtkIdType vtkDelaunay3D::FindEnclosingFaces(double x[3], vtkUnstructuredGrid* Mesh,
+  vtkIdList* tetras, vtkIdList* faces, vtkIncrementalPointLocator* locator)
 {
-  double p[4][3];
-  double b[4];
-  vtkTetra* tetra;
-  int neg = 0;
-  int j, numNeg;
-  double negValue;
+  vtkIdType tetraId;
+  vtkIdType closestPoint;
+  double xd[3];
+  xd[0] = x[0];
+  xd[1] = x[1];
+  xd[2] = x[2];
 
-  // prevent aimless wandering and death by recursion
-  if (depth > 200)
+  // Start off by finding closest point and tetras that use the point.
+  // This will serve as the starting point to determine an enclosing
+  // tetrahedron. (We just need a starting point
+  if (locator->IsInsertedPoint(x) >= 0)
   {
-    return -1;
+    this->NumberOfDuplicatePoints++;
+    return 0;
   }
 
-  tetra = static_cast<vtkTetra*>(Mesh->GetCell(tetraId));
-  for (j = 0; j < 4; j++) // load the points
+  closestPoint = locator->FindClosestInsertedPoint(x);
+  vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
+  int numCells = links->GetNcells(closestPoint);
+  vtkIdType* cells = links->GetCells(closestPoint);
+  if (numCells <= 0) // shouldn't happen
   {
-    tetra->Points->GetPoint(j, p[j]);
+    this->NumberOfDegeneracies++;
+    return 0;
   }
-
-  vtkTetra::BarycentricCoords(x, p[0], p[1], p[2], p[3], b);
-
-  // find the most negative face
-  for (negValue = VTK_DOUBLE_MAX, numNeg = j = 0; j < 4; j++)
+  else
   {
-    if (b[j] < 0.0)
-    {
-      numNeg++;
-      if (b[j] < negValue)
-      {
-        negValue = b[j];
-        neg = j;
-      }
-    }
+    tetraId = cells[0];
   }
 
-  // if no negatives, then inside this tetra
-  if (numNeg <= 0)
+  // Okay, walk towards the containing tetrahedron
+  tetraId = this->FindTetra(Mesh, xd, tetraId, 0);
+  if (tetraId < 0)
   {
-    return tetraId;
+    this->NumberOfDegeneracies++;
+    return 0;
   }
 
-  // okay, march towards the most negative direction
-  int p1 = 0, p2 = 0, p3 = 0;
-  switch (neg)
-  {
-    case 0:
-      p1 = tetra->PointIds->GetId(1);
-      p2 = tetra->PointIds->GetId(2);
-      p3 = tetra->PointIds->GetId(3);
-      break;
-    case 1:
-      p1 = tetra->PointIds->GetId(0);
-      p2 = tetra->PointIds->GetId(2);
-      p3 = tetra->PointIds->GetId(3);
-      break;
-    case 2:
-      p1 = tetra->PointIds->GetId(0);
-      p2 = tetra->PointIds->GetId(1);
-      p3 = tetra->PointIds->GetId(3);
-      break;
-    case 3:
-      p1 = tetra->PointIds->GetId(0);
-      p2 = tetra->PointIds->GetId(1);
-      p3 = tetra->PointIds->GetId(2);
-      break;
-  }
-  vtkIdType nei;
-  if (GetTetraFaceNeighbor(Mesh, tetraId, p1, p2, p3, nei))
-  {
-    return this->FindTetra(Mesh, x, nei, ++depth);
-  }
-  else
+  // Gather the tetras violating the Delaunay criterion and their boundary
+  ::FindInsertionPolyhedron(
+    Mesh, this->TetraArray, xd, tetraId, tetras, faces, this->CheckedTetras);
+
+  // Okay, let's delete the tetras and prepare the data structure
+  this->DeleteTetras(Mesh, tetras);
+
+  return (faces->GetNumberOfIds() / 3);
+}
+
+//------------------------------------------------------------------------------
+void vtkDelaunay3D::DeleteTetras(vtkUnstructuredGrid* Mesh, vtkIdList* tetras)
+{
+  vtkIdType npts;
+  const vtkIdType* tetraPts;
+  for (vtkIdType i = 0; i < tetras->GetNumberOfIds(); i++)
   {
-    return -1;
+    vtkIdType tetraId = tetras->GetId(i);
+    Mesh->GetCellPoints(tetraId, npts, tetraPts);
+    for (int j = 0; j < 4; j++)
+    {
+      this->References[tetraPts[j]]--;
+      Mesh->RemoveReferenceToCell(tetraPts[j], tetraId);
+    }
   }
 }
 
+//------------------------------------------------------------------------------
+int vtkDelaunay3D::FindTetra(vtkUnstructuredGrid* Mesh, double x[3], vtkIdType tetraId, int depth)
+{
+  return static_cast<int>(::WalkToTetra(Mesh, x, tetraId, depth));
+}
+
 //------------------------------------------------------------------------------
 // 3D Delaunay triangulation. Steps are as follows:
 //   1. For each point
@@ -485,23 +541,30 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   // of tetra cause tetra to be deleted, leaving a void with bounding
   // faces. Combination of point and each face is used to form new
   // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  if (this->InsertionBatchSize > 1 && vtkPointLocator::SafeDownCast(this->Locator))
   {
-    inPoints->GetPoint(ptId, x);
+    this->InsertPointBatches(Mesh, inPoints, points, holeTetras);
+  }
+  else
+  {
+    for (ptId = 0; ptId < numPoints; ptId++)
+    {
+      inPoints->GetPoint(ptId, x);
 
-    this->InsertPoint(Mesh, points, ptId, x, holeTetras);
+      this->InsertPoint(Mesh, points, ptId, x, holeTetras);
 
-    if (!(ptId % 250))
-    {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
-      if (this->CheckAbort())
+      if (!(ptId % 250))
       {
-        break;
+        vtkDebugMacro(<< "point #" << ptId);
+        this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+        if (this->CheckAbort())
+        {
+          break;
+        }
       }
-    }
 
-  } // for all points
+    } // for all points
+  }
 
   this->EndPointInsertion();
 
@@ -520,10 +583,7 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   numTetras = Mesh->GetNumberOfCells();
   tetraUse = new char[numTetras];
 
-  for (i = 0; i < numTetras; i++)
-  {
-    tetraUse[i] = 2; // mark as non-deleted
-  }
+  vtkSMPTools::Fill(tetraUse, tetraUse + numTetras, 2); // mark as non-deleted
   for (i = 0; i < holeTetras->GetNumberOfIds(); i++)
   {
     tetraUse[holeTetras->GetId(i)] = 0; // mark as deleted
@@ -551,10 +611,8 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     double alpha2 = this->Alpha * this->Alpha;
     vtkEdgeTable* edges;
     char* pointUse = new char[numPoints + 6];
-    vtkIdType p1, p2, p3, nei;
-    int hasNei, j, k;
-    double x1[3], x2[3], x3[3];
-    vtkDelaunayTetra* tetra;
+    vtkIdType p1, p2;
+    int j, k;
     static const int edge[6][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 0, 3 }, { 1, 3 }, { 2, 3 } };
 
     edges = vtkEdgeTable::New();
@@ -568,110 +626,157 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     // Output tetrahedra if requested
     if (this->AlphaTets)
     {
-      // traverse all tetras, checking against alpha radius
+      // check tetras against alpha radius; only the circumspheres are read,
+      // so this can be done in parallel
+      vtkTetraArray* tetraArray = this->TetraArray;
+      vtkSMPTools::For(0, numTetras, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+        {
+          if (tetraUse[tetraId] == 2 && tetraArray->GetTetra(tetraId)->r2 > alpha2)
+          {
+            tetraUse[tetraId] = 1; // mark as visited and discarded
+          }
+        }
+      });
+
+      // traverse all kept tetras, recording their points and edges
       for (i = 0; i < numTetras; i++)
       {
-        // check tetras
-        if (tetraUse[i] == 2) // if not deleted
+        if (tetraUse[i] == 2) // if not deleted nor discarded
         {
-          tetra = this->TetraArray->GetTetra(i);
-          if (tetra->r2 > alpha2)
+          Mesh->GetCellPoints(i, npts, tetraPts);
+          for (j = 0; j < 4; j++)
           {
-            tetraUse[i] = 1; // mark as visited and discarded
+            pointUse[tetraPts[j]] = 1;
           }
-          else
+          for (j = 0; j < 6; j++)
           {
-            Mesh->GetCellPoints(i, npts, tetraPts);
-            for (j = 0; j < 4; j++)
-            {
-              pointUse[tetraPts[j]] = 1;
-            }
-            for (j = 0; j < 6; j++)
+            p1 = tetraPts[edge[j][0]];
+            p2 = tetraPts[edge[j][1]];
+            if (edges->IsEdge(p1, p2) == -1)
             {
-              p1 = tetraPts[edge[j][0]];
-              p2 = tetraPts[edge[j][1]];
-              if (edges->IsEdge(p1, p2) == -1)
-              {
-                edges->InsertEdge(p1, p2);
-              }
+              edges->InsertEdge(p1, p2);
             }
           }
-        } // if non-deleted tetra
-      }   // for all tetras
-    }     // if AlphaTets are to be output
+        }
+      } // for all tetras
+    }   // if AlphaTets are to be output
 
     // traverse tetras again, this time examining faces
     // used tetras have already been output, so we look at those that haven't
     if (this->AlphaTris)
     {
+      // The tetra classification is final at this point, so the candidate
+      // faces are tested in parallel. Faces passing the test are flagged
+      // with one bit per face, and output afterwards in tetra order.
+      std::vector<unsigned char> faceMasks(numTetras, 0);
+      vtkCellArray* meshCells = Mesh->GetCells();
+      vtkTypeBool boundingTriangulation = this->BoundingTriangulation;
+      vtkSMPTools::For(0, numTetras, [&](vtkIdType begin, vtkIdType end) {
+        vtkIdType tPts[4], tNpts, neighbor;
+        double dx1[3], dx2[3], dx3[3], dv1[3], dv2[3], dv3[3], dcenter[3];
+        for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+        {
+          if (tetraUse[tetraId] != 1) // if not visited and discarded
+          {
+            continue;
+          }
+          meshCells->GetCellAtId(tetraId, tNpts, tPts);
+          for (int face = 0; face < 4; face++)
+          {
+            vtkIdType q1 = tPts[face];
+            vtkIdType q2 = tPts[(face + 1) % 4];
+            vtkIdType q3 = tPts[(face + 2) % 4];
+
+            // make sure face is okay to create
+            if (!boundingTriangulation && (q1 >= numPoints || q2 >= numPoints || q3 >= numPoints))
+            {
+              continue;
+            }
+            if (GetTetraFaceNeighbor(Mesh, tetraId, q1, q2, q3, neighbor) &&
+              (neighbor <= tetraId || tetraUse[neighbor] == 2))
+            {
+              continue; // not a candidate face
+            }
+            points->GetPoint(q1, dx1);
+            points->GetPoint(q2, dx2);
+            points->GetPoint(q3, dx3);
+            vtkTriangle::ProjectTo2D(dx1, dx2, dx3, dv1, dv2, dv3);
+            if (vtkTriangle::Circumcircle(dv1, dv2, dv3, dcenter) <= alpha2)
+            {
+              faceMasks[tetraId] |= (1 << face);
+            }
+          }
+        }
+      });
+
       for (i = 0; i < numTetras; i++)
       {
-        if (tetraUse[i] == 1) // if visited and discarded
+        if (faceMasks[i]) // if some faces are within the alpha radius
         {
           Mesh->GetCellPoints(i, npts, tetraPts);
           for (j = 0; j < 4; j++)
           {
-            p1 = tetraPts[j];
-            p2 = tetraPts[(j + 1) % 4];
-            p3 = tetraPts[(j + 2) % 4];
-
-            // make sure face is okay to create
-            if (this->BoundingTriangulation || (p1 < numPoints && p2 < numPoints && p3 < numPoints))
+            if (faceMasks[i] & (1 << j))
             {
-              hasNei = GetTetraFaceNeighbor(Mesh, i, p1, p2, p3, nei);
-
-              if (!hasNei || (nei > i && tetraUse[nei] != 2))
+              pts[0] = tetraPts[j];
+              pts[1] = tetraPts[(j + 1) % 4];
+              pts[2] = tetraPts[(j + 2) % 4];
+              output->InsertNextCell(VTK_TRIANGLE, 3, pts);
+              for (k = 0; k < 3; k++)
               {
-                double dx1[3], dx2[3], dx3[3], dv1[3], dv2[3], dv3[3], dcenter[3];
-                points->GetPoint(p1, x1);
-                dx1[0] = x1[0];
-                dx1[1] = x1[1];
-                dx1[2] = x1[2];
-                points->GetPoint(p2, x2);
-                dx2[0] = x2[0];
-                dx2[1] = x2[1];
-                dx2[2] = x2[2];
-                points->GetPoint(p3, x3);
-                dx3[0] = x3[0];
-                dx3[1] = x3[1];
-                dx3[2] = x3[2];
-                vtkTriangle::ProjectTo2D(dx1, dx2, dx3, dv1, dv2, dv3);
-                if (vtkTriangle::Circumcircle(dv1, dv2, dv3, dcenter) <= alpha2)
+                p1 = pts[k];
+                p2 = pts[(k + 1) % 3];
+                if (edges->IsEdge(p1, p2) == -1)
                 {
-                  pts[0] = p1;
-                  pts[1] = p2;
-                  pts[2] = p3;
-                  output->InsertNextCell(VTK_TRIANGLE, 3, pts);
-                  if (edges->IsEdge(p1, p2) == -1)
-                  {
-                    edges->InsertEdge(p1, p2);
-                  }
-                  if (edges->IsEdge(p2, p3) == -1)
-                  {
-                    edges->InsertEdge(p2, p3);
-                  }
-                  if (edges->IsEdge(p3, p1) == -1)
-                  {
-                    edges->InsertEdge(p3, p1);
-                  }
-                  for (k = 0; k < 3; k++)
-                  {
-                    pointUse[pts[k]] = 1;
-                  }
+                  edges->InsertEdge(p1, p2);
                 }
-              } // if candidate face
-            }   // if not boundary face or boundary faces requested
-          }     // if tetra isn't being output
-        }       // if tetra not output
-      }         // for all tetras
-    }           // if output alpha triangles
+                pointUse[p1] = 1;
+              }
+            }
+          } // for all faces of tetra
+        }   // if tetra has alpha faces
+      }     // for all tetras
+    }       // if output alpha triangles
 
     // traverse tetras again, this time examining edges
     if (this->AlphaLines)
     {
+      // as for the faces, the length of the candidate edges is tested in
+      // parallel, then the edges are output in tetra order
+      std::vector<unsigned char> edgeMasks(numTetras, 0);
+      vtkCellArray* meshCells = Mesh->GetCells();
+      vtkTypeBool boundingTriangulation = this->BoundingTriangulation;
+      vtkSMPTools::For(0, numTetras, [&](vtkIdType begin, vtkIdType end) {
+        vtkIdType tPts[4], tNpts;
+        double dx1[3], dx2[3];
+        for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+        {
+          if (tetraUse[tetraId] != 1) // one means visited and discarded
+          {
+            continue;
+          }
+          meshCells->GetCellAtId(tetraId, tNpts, tPts);
+          for (int e = 0; e < 6; e++)
+          {
+            vtkIdType q1 = tPts[edge[e][0]];
+            vtkIdType q2 = tPts[edge[e][1]];
+            if (boundingTriangulation || (q1 < numPoints && q2 < numPoints))
+            {
+              points->GetPoint(q1, dx1);
+              points->GetPoint(q2, dx2);
+              if ((vtkMath::Distance2BetweenPoints(dx1, dx2) * 0.25) <= alpha2)
+              {
+                edgeMasks[tetraId] |= (1 << e);
+              }
+            }
+          }
+        }
+      });
+
       for (i = 0; i < numTetras; i++)
       {
-        if (tetraUse[i] == 1) // one means visited and discarded
+        if (edgeMasks[i]) // if some edges are within the alpha radius
         {
           Mesh->GetCellPoints(i, npts, tetraPts);
 
@@ -680,23 +785,17 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
             p1 = tetraPts[edge[j][0]];
             p2 = tetraPts[edge[j][1]];
 
-            if ((this->BoundingTriangulation || (p1 < numPoints && p2 < numPoints)) &&
-              (edges->IsEdge(p1, p2) == -1))
+            if ((edgeMasks[i] & (1 << j)) && (edges->IsEdge(p1, p2) == -1))
             {
-              points->GetPoint(p1, x1);
-              points->GetPoint(p2, x2);
-              if ((vtkMath::Distance2BetweenPoints(x1, x2) * 0.25) <= alpha2)
-              {
-                edges->InsertEdge(p1, p2);
-                pts[0] = p1;
-                pts[1] = p2;
-                output->InsertNextCell(VTK_LINE, 2, pts);
-                pointUse[p1] = 1;
-                pointUse[p2] = 1;
-              }
+              edges->InsertEdge(p1, p2);
+              pts[0] = p1;
+              pts[1] = p2;
+              output->InsertNextCell(VTK_LINE, 2, pts);
+              pointUse[p1] = 1;
+              pointUse[p2] = 1;
             } // if edge a candidate
           }   // for all edges of tetra
-        }     // if tetra not output
+        }     // if tetra has alpha edges
       }       // for all tetras
     }         // if output alpha lines
 
@@ -738,13 +837,49 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->PassData(input->GetPointData());
   }
 
+  // Gather the tetras to output, then copy their connectivity in parallel.
+  std::vector<vtkIdType> outTetras;
+  outTetras.reserve(numTetras);
   for (i = 0; i < numTetras; i++)
   {
     if (tetraUse[i] == 2)
     {
-      Mesh->GetCellPoints(i, npts, tetraPts);
-      output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      outTetras.push_back(i);
+    }
+  }
+  vtkIdType numOutTetras = static_cast<vtkIdType>(outTetras.size());
+
+  vtkNew<vtkIdTypeArray> tetraConn;
+  tetraConn->SetNumberOfValues(4 * numOutTetras);
+  vtkIdType* conn = tetraConn->GetPointer(0);
+  vtkCellArray* meshCells = Mesh->GetCells();
+  vtkSMPTools::For(0, numOutTetras, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType tNpts;
+    for (vtkIdType tetraId = begin; tetraId < end; ++tetraId)
+    {
+      meshCells->GetCellAtId(outTetras[tetraId], tNpts, conn + 4 * tetraId);
     }
+  });
+  vtkNew<vtkCellArray> tetras;
+  tetras->SetData(4, tetraConn);
+
+  vtkIdType numAlphaCells = output->GetNumberOfCells();
+  if (numAlphaCells == 0)
+  {
+    output->SetCells(VTK_TETRA, tetras);
+  }
+  else
+  {
+    // the tetras follow the triangles, lines and verts of the alpha shape
+    vtkNew<vtkCellArray> outCells;
+    outCells->DeepCopy(output->GetCells());
+    outCells->Append(tetras);
+    vtkNew<vtkUnsignedCharArray> outTypes;
+    outTypes->SetNumberOfValues(numAlphaCells + numOutTetras);
+    unsigned char* alphaTypes = output->GetCellTypesArray()->GetPointer(0);
+    std::copy(alphaTypes, alphaTypes + numAlphaCells, outTypes->GetPointer(0));
+    std::fill_n(outTypes->GetPointer(numAlphaCells), numOutTetras, VTK_TETRA);
+    output->SetCells(outTypes, outCells);
   }
   vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
                 << output->GetNumberOfCells() << " tetrahedra");
@@ -894,11 +1029,6 @@ vtkUnstructuredGrid* vtkDelaunay3D::InitPointInsertion(
 void vtkDelaunay3D::InsertPoint(
   vtkUnstructuredGrid* Mesh, vtkPoints* points, vtkIdType ptId, double x[3], vtkIdList* holeTetras)
 {
-  vtkIdType tetraId, numFaces;
-  int i;
-  vtkIdType nodes[4];
-  vtkIdType tetraNum, numTetras;
-
   this->Tetras->Reset();
   this->Faces->Reset();
 
@@ -908,61 +1038,213 @@ void vtkDelaunay3D::InsertPoint(
   // a point if the point is on or near an edge or face.) For each face,
   // create a tetrahedron. (The locator helps speed search of points
   // in tetras.)
-  if ((numFaces = this->FindEnclosingFaces(x, Mesh, this->Tetras, this->Faces, this->Locator)) > 0)
+  if (this->FindEnclosingFaces(x, Mesh, this->Tetras, this->Faces, this->Locator) > 0)
   {
-    this->Locator->InsertPoint(ptId, x); // point is part of mesh now
-    numTetras = this->Tetras->GetNumberOfIds();
+    this->CreateTetras(Mesh, points, ptId, x, this->Tetras, this->Faces, holeTetras);
+  } // if enclosing faces found
+}
 
-    // create new tetra for each face
-    for (tetraNum = 0; tetraNum < numFaces; tetraNum++)
+//------------------------------------------------------------------------------
+void vtkDelaunay3D::CreateTetras(vtkUnstructuredGrid* Mesh, vtkPoints* points, vtkIdType ptId,
+  double x[3], vtkIdList* tetras, vtkIdList* faces, vtkIdList* holeTetras)
+{
+  vtkIdType tetraId;
+  int i;
+  vtkIdType nodes[4];
+  vtkIdType tetraNum;
+  vtkIdType numFaces = faces->GetNumberOfIds() / 3;
+  vtkIdType numTetras = tetras->GetNumberOfIds();
+
+  this->Locator->InsertPoint(ptId, x); // point is part of mesh now
+
+  // create new tetra for each face
+  for (tetraNum = 0; tetraNum < numFaces; tetraNum++)
+  {
+    // Define tetrahedron.  The order of the points matters: points
+    // 0, 1, and 2 must appear in counterclockwise order when seen
+    // from point 3.  When we get here, point ptId is inside the
+    // tetrahedron whose faces we're considering and we've
+    // guaranteed that the 3 points in this face are
+    // counterclockwise wrt the new point.  That lets us create a
+    // new tetrahedron with the right ordering.
+    nodes[0] = faces->GetId(3 * tetraNum);
+    nodes[1] = faces->GetId(3 * tetraNum + 1);
+    nodes[2] = faces->GetId(3 * tetraNum + 2);
+    nodes[3] = ptId;
+
+    // either replace previously deleted tetra or create new one
+    if (tetraNum < numTetras)
+    {
+      tetraId = tetras->GetId(tetraNum);
+      Mesh->ReplaceCell(tetraId, 4, nodes);
+    }
+    else
     {
-      // Define tetrahedron.  The order of the points matters: points
-      // 0, 1, and 2 must appear in counterclockwise order when seen
-      // from point 3.  When we get here, point ptId is inside the
-      // tetrahedron whose faces we're considering and we've
-      // guaranteed that the 3 points in this face are
-      // counterclockwise wrt the new point.  That lets us create a
-      // new tetrahedron with the right ordering.
-      nodes[0] = this->Faces->GetId(3 * tetraNum);
-      nodes[1] = this->Faces->GetId(3 * tetraNum + 1);
-      nodes[2] = this->Faces->GetId(3 * tetraNum + 2);
-      nodes[3] = ptId;
-
-      // either replace previously deleted tetra or create new one
-      if (tetraNum < numTetras)
+      tetraId = Mesh->InsertNextCell(VTK_TETRA, 4, nodes);
+    }
+
+    // Update data structures
+    for (i = 0; i < 4; i++)
+    {
+      if (this->References[nodes[i]] >= 0)
       {
-        tetraId = this->Tetras->GetId(tetraNum);
-        Mesh->ReplaceCell(tetraId, 4, nodes);
+        Mesh->ResizeCellList(nodes[i], 5);
+        this->References[nodes[i]] -= 5;
       }
-      else
+      this->References[nodes[i]]++;
+      Mesh->AddReferenceToCell(nodes[i], tetraId);
+    }
+
+    this->InsertTetra(Mesh, points, tetraId);
+
+  } // for each face
+
+  // Sometimes there are more tetras deleted than created. These
+  // have to be accounted for because they leave a "hole" in the
+  // data structure. Keep track of them here...mark them deleted later.
+  for (tetraNum = numFaces; tetraNum < numTetras; tetraNum++)
+  {
+    holeTetras->InsertNextId(tetras->GetId(tetraNum));
+  }
+}
+
+//------------------------------------------------------------------------------
+// Insert the points in batches. The insertion polyhedra of the points of a
+// batch are searched in parallel in the current triangulation, which is only
+// read. The points are then inserted serially in their input order. The
+// polyhedron of a point is still valid if none of the tetras visited to find
+// it (the polyhedron and its face neighbors) has been replaced by an earlier
+// point of the batch; otherwise the point is inserted with InsertPoint().
+void vtkDelaunay3D::InsertPointBatches(
+  vtkUnstructuredGrid* Mesh, vtkPoints* inPoints, vtkPoints* points, vtkIdList* holeTetras)
+{
+  vtkIdType numPoints = inPoints->GetNumberOfPoints();
+  vtkIdType maxBatchSize = std::min(static_cast<vtkIdType>(this->InsertionBatchSize), numPoints);
+  std::vector<::BatchPolyhedron> polyhedra(maxBatchSize);
+  vtkIncrementalPointLocator* locator = this->Locator;
+  vtkTetraArray* tetraArray = this->TetraArray;
+
+  // Batch in which each tetra was last replaced or deleted
+  std::vector<vtkIdType> modifiedTetras;
+  // Points inserted so far in the batch, which the locator queries of the
+  // parallel search did not see. vtkMergePoints only merges equal points.
+  std::vector<double> batchPoints;
+  double tol = vtkMergePoints::SafeDownCast(locator) ? 0.0 : locator->GetTolerance();
+  double tol2 = tol * tol;
+  vtkIdType numBatches = 0;
+  vtkIdType numSearchedAgain = 0;
+  double x[3];
+
+  vtkIdType ptId = 0;
+  while (ptId < numPoints)
+  {
+    // The polyhedra of a batch overlap more as the batch grows with respect
+    // to the triangulation. A point replaces a few tens of tetras and visits
+    // about as many neighbors, so with scattered points, batches of one point
+    // per 4000 tetras leave a few percent of the polyhedra to search again.
+    vtkIdType batchStart = ptId;
+    vtkIdType batchSize = std::min(maxBatchSize, numPoints - batchStart);
+    batchSize = std::min(batchSize, 1 + Mesh->GetNumberOfCells() / 4000);
+    vtkIdType batch = numBatches++;
+    modifiedTetras.resize(Mesh->GetNumberOfCells(), -1);
+    batchPoints.clear();
+
+    vtkSMPTools::For(0, batchSize, [&](vtkIdType begin, vtkIdType end) {
+      vtkCellLinks* links = static_cast<vtkCellLinks*>(Mesh->GetLinks());
+      double xp[3];
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        tetraId = Mesh->InsertNextCell(VTK_TETRA, 4, nodes);
+        ::BatchPolyhedron& polyhedron = polyhedra[i];
+        polyhedron.Status = ::BatchPolyhedron::NOT_FOUND;
+        polyhedron.Tetras->Reset();
+        polyhedron.Faces->Reset();
+        inPoints->GetPoint(batchStart + i, xp);
+        if (locator->IsInsertedPoint(xp) >= 0)
+        {
+          polyhedron.Status = ::BatchPolyhedron::DUPLICATE;
+          continue;
+        }
+        vtkIdType closestPoint = locator->FindClosestInsertedPoint(xp);
+        if (links->GetNcells(closestPoint) <= 0)
+        {
+          continue;
+        }
+        vtkIdType tetraId = ::WalkToTetra(Mesh, xp, links->GetCells(closestPoint)[0], 0);
+        if (tetraId < 0)
+        {
+          continue;
+        }
+        ::FindInsertionPolyhedron(Mesh, tetraArray, xp, tetraId, polyhedron.Tetras,
+          polyhedron.Faces, polyhedron.CheckedTetras);
+        polyhedron.Status = ::BatchPolyhedron::FOUND;
       }
+    });
 
-      // Update data structures
-      for (i = 0; i < 4; i++)
+    for (vtkIdType i = 0; i < batchSize; ++i, ++ptId)
+    {
+      ::BatchPolyhedron& polyhedron = polyhedra[i];
+      if (polyhedron.Status == ::BatchPolyhedron::DUPLICATE)
       {
-        if (this->References[nodes[i]] >= 0)
+        this->NumberOfDuplicatePoints++;
+        continue;
+      }
+
+      bool valid = polyhedron.Status == ::BatchPolyhedron::FOUND;
+      for (vtkIdType j = 0; valid && j < polyhedron.CheckedTetras->GetNumberOfIds(); ++j)
+      {
+        valid = modifiedTetras[polyhedron.CheckedTetras->GetId(j)] != batch;
+      }
+
+      inPoints->GetPoint(ptId, x);
+      for (size_t j = 0; valid && j < batchPoints.size(); j += 3)
+      {
+        if (vtkMath::Distance2BetweenPoints(x, batchPoints.data() + j) <= tol2)
         {
-          Mesh->ResizeCellList(nodes[i], 5);
-          this->References[nodes[i]] -= 5;
+          valid = false; // let InsertPoint() discard the duplicate
         }
-        this->References[nodes[i]]++;
-        Mesh->AddReferenceToCell(nodes[i], tetraId);
       }
 
-      this->InsertTetra(Mesh, points, tetraId);
+      vtkIdList* tetras = polyhedron.Tetras;
+      if (!valid)
+      {
+        numSearchedAgain++;
+        this->InsertPoint(Mesh, points, ptId, x, holeTetras);
+        tetras = this->Tetras;
+      }
+      else
+      {
+        this->DeleteTetras(Mesh, tetras);
+        this->CreateTetras(Mesh, points, ptId, x, tetras, polyhedron.Faces, holeTetras);
+      }
+      if (tetras->GetNumberOfIds() > 0) // if inserted
+      {
+        batchPoints.insert(batchPoints.end(), x, x + 3);
+      }
 
-    } // for each face
+      // Tetras created during this batch are not known to its polyhedra.
+      for (vtkIdType j = 0; j < tetras->GetNumberOfIds(); ++j)
+      {
+        vtkIdType tetraId = tetras->GetId(j);
+        if (tetraId < static_cast<vtkIdType>(modifiedTetras.size()))
+        {
+          modifiedTetras[tetraId] = batch;
+        }
+      }
+    }
 
-    // Sometimes there are more tetras deleted than created. These
-    // have to be accounted for because they leave a "hole" in the
-    // data structure. Keep track of them here...mark them deleted later.
-    for (tetraNum = numFaces; tetraNum < numTetras; tetraNum++)
+    if (batchStart / 250 != ptId / 250)
     {
-      holeTetras->InsertNextId(this->Tetras->GetId(tetraNum));
+      vtkDebugMacro(<< "point #" << ptId);
+      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      if (this->CheckAbort())
+      {
+        break;
+      }
     }
-  } // if enclosing faces found
+  }
+
+  vtkDebugMacro(<< "Inserted " << numPoints << " points in " << numBatches << " batches, "
+                << numSearchedAgain << " insertion polyhedra searched again");
 }
 
 //------------------------------------------------------------------------------
@@ -1002,22 +1284,7 @@ void vtkDelaunay3D::CreateDefaultLocator()
 // See whether point is in sphere of tetrahedron
 int vtkDelaunay3D::InSphere(double x[3], vtkIdType tetraId)
 {
-  double dist2;
-  vtkDelaunayTetra* tetra = this->TetraArray->GetTetra(tetraId);
-
-  // check if inside/outside circumcircle
-  dist2 = (x[0] - tetra->center[0]) * (x[0] - tetra->center[0]) +
-    (x[1] - tetra->center[1]) * (x[1] - tetra->center[1]) +
-    (x[2] - tetra->center[2]) * (x[2] - tetra->center[2]);
-
-  if (dist2 < (0.9999999999L * tetra->r2))
-  {
-    return 1;
-  }
-  else
-  {
-    return 0;
-  }
+  return ::InSphere(x, this->TetraArray->GetTetra(tetraId)) ? 1 : 0;
 }
 
 //------------------------------------------------------------------------------
@@ -1062,6 +1329,7 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Insertion Batch Size: " << this->InsertionBatchSize << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -1095,14 +1363,15 @@ static int GetTetraFaceNeighbor(vtkUnstructuredGrid* Mesh, vtkIdType tetraId, vt
   vtkIdType* cells = links->GetCells(p1);
   int i;
   vtkIdType npts;
-  const vtkIdType* pts;
+  vtkIdType pts[4];
 
-  // perform set operation
+  // perform set operation; the points are copied so that this can be
+  // called from several threads
   for (i = 0; i < numCells; i++)
   {
     if (cells[i] != tetraId)
     {
-      Mesh->GetCellPoints(cells[i], npts, pts);
+      Mesh->GetCells()->GetCellAtId(cells[i], npts, pts);
       if ((p2 == pts[0] || p2 == pts[1] || p2 == pts[2] || p2 == pts[3]) &&
         (p3 == pts[0] || p3 == pts[1] || p3 == pts[2] || p3 == pts[3]))
       {
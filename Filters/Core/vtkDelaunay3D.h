@@ -42,6 +42,16 @@
  * see a warning message to this effect at the end of the
  * triangulation process.
  *
+ * By default, the points are inserted incrementally, one after the other.
+ * When InsertionBatchSize is larger than one, the points are inserted in
+ * batches instead: the insertion polyhedra of the points of a batch are
+ * searched in parallel, then applied one point after the other. The
+ * polyhedra overlapping the ones of earlier points of the batch are searched
+ * again at that time. Once the triangulation is built, the tests against the
+ * alpha radius and the generation of the output tetrahedra are performed in
+ * parallel with vtkSMPTools. The output does not depend on the number of
+ * threads.
+ *
  * @warning
  * Points arranged on a regular lattice (termed degenerate cases) can be
  * triangulated in more than one way (at least according to the Delaunay
@@ -201,6 +211,29 @@ public:
    */
   void CreateDefaultLocator();
 
+  ///@{
+  /**
+   * Specify the maximum number of points inserted as one batch. With the
+   * default value of 1, the points are inserted one after the other. With
+   * larger values, the insertion polyhedra (the tetrahedra whose
+   * circumsphere contains the point) of the points of a batch are searched
+   * concurrently in the triangulation built so far, then the points are
+   * inserted in their input order. A polyhedron is only reused if none of
+   * the tetrahedra it was found from has been modified by an earlier point
+   * of the batch; otherwise it is searched again. Batches are smaller while
+   * the triangulation has few tetrahedra, as most polyhedra would overlap.
+   * The result does not depend on the number of threads, but degenerate
+   * point sets may be triangulated differently than with one point per
+   * batch. Input points that are sorted spatially overlap more, so they
+   * benefit less from batches than scattered points. Batches require the
+   * locator to be a vtkPointLocator (the default) or a subclass, whose
+   * queries can run concurrently; with other locators the points are
+   * inserted one after the other.
+   */
+  vtkSetClampMacro(InsertionBatchSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(InsertionBatchSize, int);
+  ///@}
+
   /**
    * This is a helper method used with InsertPoint() to create
    * tetrahedronalizations of points. Its purpose is construct an initial
@@ -267,6 +300,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  int InsertionBatchSize;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -291,6 +325,18 @@ private:                    // members added for performance
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
 
+  // Insert the points of inPoints in batches, see InsertionBatchSize.
+  void InsertPointBatches(
+    vtkUnstructuredGrid* Mesh, vtkPoints* inPoints, vtkPoints* points, vtkIdList* holeTetras);
+
+  // Remove the tetras of an insertion polyhedron from the point links.
+  void DeleteTetras(vtkUnstructuredGrid* Mesh, vtkIdList* tetras);
+
+  // Insert point ptId and fill the insertion polyhedron made of the tetras
+  // and bounded by the faces with new tetras.
+  void CreateTetras(vtkUnstructuredGrid* Mesh, vtkPoints* points, vtkIdType ptId, double x[3],
+    vtkIdList* tetras, vtkIdList* faces, vtkIdList* holeTetras);
+
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
 };
@@ -10,11 +10,16 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStdFunctionArray.h"
+
+#include <functional>
+#include <memory>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkElevationFilter);
@@ -110,6 +115,51 @@ struct Elevate
   }
 };
 
+//------------------------------------------------------------------------------
+// Evaluates a single elevation value on demand. This is the backend of the
+// implicit elevation array; it keeps a reference to the input points.
+template <class PointArrayT>
+struct vtkElevationFunctor
+{
+  using PointType = vtk::GetAPIType<PointArrayT>;
+  vtkSmartPointer<PointArrayT> PointArray;
+  double LowPoint[3];
+  double V[3];
+  double L2;
+  double Range[2];
+
+  float operator()(int pointId) const
+  {
+    const auto points = vtk::DataArrayTupleRange<3>(this->PointArray.Get());
+    PointType point[3];
+    points.GetTuple(pointId, point);
+    const double vec[3] = { point[0] - this->LowPoint[0], point[1] - this->LowPoint[1],
+      point[2] - this->LowPoint[2] };
+    const double ns = vtkMath::ClampValue(vtkMath::Dot(vec, this->V) / this->L2, 0., 1.);
+    return static_cast<float>(this->Range[0] + ns * (this->Range[1] - this->Range[0]));
+  }
+};
+
+//------------------------------------------------------------------------------
+// Build the backend of the implicit elevation array for the given points.
+struct MakeElevationFunction
+{
+  template <typename PointArrayT>
+  void operator()(PointArrayT* pointArray, vtkElevationFilter* filter, double* v, double l2,
+    std::function<float(int)>& function)
+  {
+    vtkElevationFunctor<PointArrayT> functor;
+    functor.PointArray = pointArray;
+    filter->GetLowPoint(functor.LowPoint);
+    filter->GetScalarRange(functor.Range);
+    functor.V[0] = v[0];
+    functor.V[1] = v[1];
+    functor.V[2] = v[2];
+    functor.L2 = l2;
+    function = functor;
+  }
+};
+
 } // end anon namespace
 
 //------------------------------------------------------------------------------
@@ -141,6 +191,8 @@ void vtkElevationFilter::PrintSelf(ostream& os, vtkIndent indent)
      << this->HighPoint[2] << ")\n";
   os << indent << "Scalar Range: (" << this->ScalarRange[0] << ", " << this->ScalarRange[1]
      << ")\n";
+  os << indent << "Use Implicit Arrays: " << (this->UseImplicitArrays ? "On\n" : "Off\n");
+  os << indent << "Implicit Array Threshold: " << this->ImplicitArrayThreshold << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -159,10 +211,6 @@ int vtkElevationFilter::RequestData(
     return 1;
   }
 
-  // Allocate space for the elevation scalar data.
-  vtkSmartPointer<vtkFloatArray> newScalars = vtkSmartPointer<vtkFloatArray>::New();
-  newScalars->SetNumberOfTuples(numPts);
-
   // Set up 1D parametric system and make sure it is valid.
   double diffVector[3] = { this->HighPoint[0] - this->LowPoint[0],
     this->HighPoint[1] - this->LowPoint[1], this->HighPoint[2] - this->LowPoint[2] };
@@ -178,17 +226,41 @@ int vtkElevationFilter::RequestData(
 
   vtkDebugMacro("Generating elevation scalars!");
 
-  float* scalars = newScalars->GetPointer(0);
   vtkDataArray* pointsArray = input->GetPoints()->GetData();
-
-  Elevate worker; // Entry point to vtkElevationAlgorithm
+  vtkSmartPointer<vtkDataArray> newScalars;
 
   // Generate an optimized fast-path for float/double
   using Dispatcher = vtkArrayDispatch::DispatchByValueTypeUsingArrays<vtkArrayDispatch::AllArrays,
     vtkArrayDispatch::Reals>;
-  if (!Dispatcher::Execute(pointsArray, worker, this, diffVector, length2, scalars))
-  { // fallback for unknown arrays and integral value types:
-    worker(pointsArray, this, diffVector, length2, scalars);
+  if (this->UseImplicitArrays && numPts >= this->ImplicitArrayThreshold &&
+    numPts <= VTK_INT_MAX)
+  {
+    // Defer the computation: values are evaluated per tuple when accessed.
+    std::function<float(int)> function;
+    MakeElevationFunction maker;
+    if (!Dispatcher::Execute(pointsArray, maker, this, diffVector, length2, function))
+    { // fallback for unknown arrays and integral value types:
+      maker(pointsArray, this, diffVector, length2, function);
+    }
+    vtkNew<vtkStdFunctionArray<float>> implicitScalars;
+    implicitScalars->SetBackend(std::make_shared<std::function<float(int)>>(function));
+    implicitScalars->SetNumberOfComponents(1);
+    implicitScalars->SetNumberOfTuples(numPts);
+    newScalars = implicitScalars;
+  }
+  else
+  {
+    // Allocate space for the elevation scalar data.
+    vtkNew<vtkFloatArray> explicitScalars;
+    explicitScalars->SetNumberOfTuples(numPts);
+    float* scalars = explicitScalars->GetPointer(0);
+
+    Elevate worker; // Entry point to vtkElevationAlgorithm
+    if (!Dispatcher::Execute(pointsArray, worker, this, diffVector, length2, scalars))
+    { // fallback for unknown arrays and integral value types:
+      worker(pointsArray, this, diffVector, length2, scalars);
+    }
+    newScalars = explicitScalars;
   }
 
   // Copy all the input geometry and data to the output.
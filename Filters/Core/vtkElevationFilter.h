@@ -15,6 +15,12 @@
  * compute vertical elevation above zero z-point.
  *
  * @warning
+ * When UseImplicitArrays is on, the output elevation scalars are a
+ * vtkStdFunctionArray<float> which computes each value on demand from the
+ * input points. This avoids allocating and filling the full array when
+ * downstream filters only access a subset of the points.
+ *
+ * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
  * non-sequential type (set in the CMake variable
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
@@ -63,6 +69,30 @@ public:
   vtkGetVectorMacro(ScalarRange, double, 2);
   ///@}
 
+  ///@{
+  /**
+   * Specify whether to generate the elevation scalars as an implicit array
+   * (a vtkStdFunctionArray<float>) that evaluates values per tuple on demand
+   * instead of computing and storing them all up front. The implicit array
+   * holds a reference to the input points. Note that calling GetVoidPointer()
+   * on it materializes the full array. Default is off.
+   */
+  vtkSetMacro(UseImplicitArrays, bool);
+  vtkGetMacro(UseImplicitArrays, bool);
+  vtkBooleanMacro(UseImplicitArrays, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Specify the minimum number of input points for which an implicit array
+   * is generated when UseImplicitArrays is on. Smaller inputs are always
+   * materialized, since the per-access overhead of the implicit array is not
+   * worth the memory savings. Default is 0.
+   */
+  vtkSetClampMacro(ImplicitArrayThreshold, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(ImplicitArrayThreshold, vtkIdType);
+  ///@}
+
 protected:
   vtkElevationFilter();
   ~vtkElevationFilter() override;
@@ -72,6 +102,8 @@ protected:
   double LowPoint[3];
   double HighPoint[3];
   double ScalarRange[2];
+  bool UseImplicitArrays = false;
+  vtkIdType ImplicitArrayThreshold = 0;
 
 private:
   vtkElevationFilter(const vtkElevationFilter&) = delete;
@@ -22,6 +22,7 @@
 #include "vtkTimeStamp.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
 #include <numeric>
@@ -506,6 +507,47 @@ private:
   vtkTimeStamp SortTime;
 };
 
+//=============================================================================
+// Topology extracted during the last execution, reused when only the input
+// attributes change (see ReuseTopology).
+struct vtkExtractCells::vtkTopologyCache
+{
+  vtkWeakPointer<vtkDataSet> Input;
+  vtkMTimeType InputMeshMTime = 0;
+  vtkIdType InputNumberOfPoints = 0;
+  vtkIdType InputNumberOfCells = 0;
+  vtkMTimeType FilterMTime = 0;
+
+  vtkSmartPointer<vtkIdList> PointIds;
+  vtkSmartPointer<vtkPoints> Points;
+  ExtractedCellsT Cells;
+
+  // Only vtkPolyData and vtkUnstructuredGrid track the modification time of
+  // their mesh independently of their attributes.
+  static vtkMTimeType GetMeshMTime(vtkDataSet* input)
+  {
+    if (auto polyData = vtkPolyData::SafeDownCast(input))
+    {
+      return polyData->GetMeshMTime();
+    }
+    if (auto ugrid = vtkUnstructuredGrid::SafeDownCast(input))
+    {
+      return ugrid->GetMeshMTime();
+    }
+    return 0;
+  }
+
+  bool IsValid(vtkDataSet* input, vtkExtractCells* self, vtkIdType outputNumCells) const
+  {
+    return this->Input == input && this->InputMeshMTime != 0 &&
+      this->InputMeshMTime == GetMeshMTime(input) &&
+      this->InputNumberOfPoints == input->GetNumberOfPoints() &&
+      this->InputNumberOfCells == input->GetNumberOfCells() &&
+      this->FilterMTime == self->GetMTime() &&
+      this->Cells.CellTypes->GetNumberOfValues() == outputNumCells;
+  }
+};
+
 //=============================================================================
 vtkStandardNewMacro(vtkExtractCells);
 //------------------------------------------------------------------------------
@@ -643,6 +685,29 @@ int vtkExtractCells::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  // Only the attributes changed since the last execution: reuse the cached
+  // topology and map the new attributes through it.
+  if (this->ReuseTopology && this->TopologyCache &&
+    this->TopologyCache->IsValid(input, this, outputNumbCells))
+  {
+    auto& cache = *this->TopologyCache;
+    outCD->CopyAllocate(inCD, outputNumbCells);
+    outCD->CopyData(inCD, this->CellList);
+    outPD->CopyAllocate(inPD, cache.PointIds->GetNumberOfIds());
+    outPD->CopyData(inPD, cache.PointIds);
+    if (this->PassThroughCellIds)
+    {
+      ::AddOriginalCellIds(
+        outCD, SubsetCellsWork{ this->CellList->GetPointer(0), nullptr, outputNumbCells });
+    }
+    output->SetPoints(cache.Points);
+    output->SetPolyhedralCells(cache.Cells.CellTypes, cache.Cells.Connectivity,
+      cache.Cells.PolyFaceLocations, cache.Cells.PolyFaces);
+    this->UpdateProgress(1.00);
+    return 1;
+  }
+  this->TopologyCache.reset();
+
   // Build point map for selected cells.
   vtkIdType outputNumPoints;
   const auto pointMap = ::GeneratePointMap(input, this->CellList, outputNumPoints);
@@ -697,6 +762,21 @@ int vtkExtractCells::RequestData(vtkInformation* vtkNotUsed(request),
   }
   output->SetPolyhedralCells(
     cells.CellTypes, cells.Connectivity, cells.PolyFaceLocations, cells.PolyFaces);
+
+  const vtkMTimeType meshMTime = vtkTopologyCache::GetMeshMTime(input);
+  if (this->ReuseTopology && meshMTime != 0)
+  {
+    this->TopologyCache.reset(new vtkTopologyCache());
+    auto& cache = *this->TopologyCache;
+    cache.Input = input;
+    cache.InputMeshMTime = meshMTime;
+    cache.InputNumberOfPoints = input->GetNumberOfPoints();
+    cache.InputNumberOfCells = inputNumCells;
+    cache.FilterMTime = this->GetMTime();
+    cache.PointIds = chosenPtIds;
+    cache.Points = pts;
+    cache.Cells = cells;
+  }
   this->UpdateProgress(1.00);
 
   return 1;
@@ -761,5 +841,6 @@ void vtkExtractCells::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "ExtractAllCells: " << this->ExtractAllCells << endl;
   os << indent << "AssumeSortedAndUniqueIds: " << this->AssumeSortedAndUniqueIds << endl;
+  os << indent << "ReuseTopology: " << this->ReuseTopology << endl;
 }
 VTK_ABI_NAMESPACE_END
@@ -28,6 +28,8 @@
 #include "vtkSmartPointer.h"      // For vtkSmartPointer
 #include "vtkUnstructuredGridAlgorithm.h"
 
+#include <memory> // For std::unique_ptr
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkIdList;
 class vtkExtractCellsIdList;
@@ -127,6 +129,22 @@ public:
   vtkSetClampMacro(BatchSize, unsigned int, 1, VTK_INT_MAX);
   vtkGetMacro(BatchSize, unsigned int);
   ///@}
+
+  ///@{
+  /**
+   * If on, the topology extracted from the input (output points and cells,
+   * and the output to input point map) is kept between executions. When the
+   * filter re-executes while neither the filter nor the input mesh were
+   * modified (see vtkPolyData::GetMeshMTime() and
+   * vtkUnstructuredGrid::GetMeshMTime()), e.g. when only the input point or
+   * cell data change over time, the cached topology is reused and only the
+   * attributes are copied through the cached map. This is only supported for
+   * vtkPolyData and vtkUnstructuredGrid inputs. Default is off.
+   */
+  vtkSetMacro(ReuseTopology, bool);
+  vtkGetMacro(ReuseTopology, bool);
+  vtkBooleanMacro(ReuseTopology, bool);
+  ///@}
 protected:
   vtkExtractCells();
   ~vtkExtractCells() override;
@@ -141,8 +159,12 @@ protected:
   bool PassThroughCellIds = true;
   int OutputPointsPrecision = DEFAULT_PRECISION;
   unsigned int BatchSize = 1000;
+  bool ReuseTopology = false;
 
 private:
+  struct vtkTopologyCache;
+  std::unique_ptr<vtkTopologyCache> TopologyCache;
+
   vtkExtractCells(const vtkExtractCells&) = delete;
   void operator=(const vtkExtractCells&) = delete;
 };
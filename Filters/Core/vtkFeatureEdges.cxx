@@ -5,6 +5,7 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -15,11 +16,14 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <map>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkFeatureEdges);
@@ -79,17 +83,15 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   vtkCellArray* newLines;
   vtkPolyData* Mesh;
   int i;
-  vtkIdType j, numNei;
   vtkIdType numBEdges, numNonManifoldEdges, numFedges, numManifoldEdges;
-  double scalar, n[3], x1[3], x2[3];
+  double scalar, x1[3], x2[3];
   double cosAngle = 0;
   vtkIdType lineIds[2];
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
   vtkCellArray *inPolys, *inStrips, *newPolys;
   vtkFloatArray* polyNormals = nullptr;
-  vtkIdType numPts, numCells, numPolys, numStrips, numLines, nei;
-  vtkIdList* neighbors;
+  vtkIdType numPts, numCells, numPolys, numStrips, numLines;
   vtkIdType p1, p2, newId;
   vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
   vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
@@ -253,28 +255,30 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   // Loop over all polygons generating boundary, non-manifold,
   // and feature edges
   //
+  const vtkIdType numNewPolys = newPolys->GetNumberOfCells();
   if (this->FeatureEdges)
   {
     polyNormals = vtkFloatArray::New();
     polyNormals->SetNumberOfComponents(3);
-    polyNormals->Allocate(3 * newPolys->GetNumberOfCells());
-
-    vtkIdType cellId;
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-    {
-      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-      polyNormals->InsertTuple(cellId, n);
-    }
+    polyNormals->SetNumberOfTuples(numNewPolys);
+
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+    vtkSMPTools::For(0, numNewPolys, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdType nCellPts;
+      const vtkIdType* cellPtIds;
+      double normal[3];
+      for (vtkIdType polyId = beginCellId; polyId < endCellId; ++polyId)
+      {
+        newPolys->GetCellAtId(polyId, nCellPts, cellPtIds, cellPts);
+        vtkPolygon::ComputeNormal(inPts, nCellPts, cellPtIds, normal);
+        polyNormals->SetTuple(polyId, normal);
+      }
+    });
 
     cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
   }
 
-  neighbors = vtkIdList::New();
-  neighbors->Allocate(VTK_CELL_SIZE);
-
-  bool abort = false;
-  vtkIdType progressInterval = newPolys->GetNumberOfCells() / 20 + 1;
-
   numBEdges = numNonManifoldEdges = numFedges = numManifoldEdges = 0;
   vtkIdType newCellId, cellId;
 
@@ -322,142 +326,185 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  for (newCellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts) && !abort;
-       newCellId++)
-  {
-    if (!(newCellId % progressInterval)) // manage progress / early abort
-    {
-      this->UpdateProgress(static_cast<double>(newCellId) / numCells);
-      abort = this->CheckAbort();
-    }
-
+  // Map a cell of the triangulated mesh to its cell in the input
+  auto inputCellId = [&](vtkIdType meshCellId) {
     if (numPolys == numCells) // Input only has Polys
     {
-      cellId = newCellId;
-    }
-    else if (newCellId < numPolys) // Input has mixed types, and we currently are on a Poly
-    {
-      cellId = polyIdToCellIdMap->GetId(newCellId);
+      return meshCellId;
     }
-    else // Input has mixed types and we are dealing with triangle strips
-    {
-      auto it = decomposedStripIdToStripIdMap.lower_bound(newCellId + 1);
-      cellId = stripIdToCellIdMap->GetId(it->second);
-    }
-
-    if (ghosts && ghosts[cellId] & CELL_NOT_VISIBLE)
+    else if (meshCellId < numPolys) // Input has mixed types, and we are on a Poly
     {
-      continue;
+      return polyIdToCellIdMap->GetId(meshCellId);
     }
-
+    // Input has mixed types and we are dealing with triangle strips
+    auto it = decomposedStripIdToStripIdMap.lower_bound(meshCellId + 1);
+    return stripIdToCellIdMap->GetId(it->second);
+  };
+
+  // The edges are classified in parallel. Each polygon edge is given the
+  // type of the output line it generates, if any. The lines are then
+  // generated serially in the polygon order, so that the point merging and
+  // the output ordering do not depend on the number of threads.
+  enum EdgeType : signed char
+  {
+    NO_EDGE = -1,
+    BOUNDARY_EDGE,
+    NON_MANIFOLD_EDGE,
+    FEATURE_EDGE,
+    MANIFOLD_EDGE
+  };
+  std::vector<signed char> edgeTypes(newPolys->GetNumberOfConnectivityIds(), NO_EDGE);
+
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+  vtkSMPThreadLocalObject<vtkIdList> tlEdgesRemapping;
+  vtkSMPTools::For(0, numNewPolys, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    vtkIdList* neighbors = tlNeighbors.Local();
     // Used with non manifold edges when there are ghost cells in the input
-    vtkNew<vtkIdList> edgesRemapping;
+    vtkIdList* edgesRemapping = tlEdgesRemapping.Local();
+    vtkIdType nCellPts;
+    const vtkIdType* cellPtIds;
+    bool isFirst = vtkSMPTools::GetSingleThread();
 
-    for (i = 0; i < npts; i++)
+    for (vtkIdType polyId = beginCellId; polyId < endCellId; ++polyId)
     {
-      p1 = pts[i];
-      p2 = pts[(i + 1) % npts];
-
-      Mesh->GetCellEdgeNeighbors(newCellId, p1, p2, neighbors);
-      numNei = neighbors->GetNumberOfIds();
-
-      vtkIdType numNeiWithoutGhosts = numNei;
-      vtkIdType firstNeighbor = 0;
-      if (ghosts)
+      if (isFirst)
       {
-        for (j = 0; j < numNei; ++j)
-        {
-          vtkIdType neiId = neighbors->GetId(j);
-          vtkIdType neighborCellIdInInput;
-          if (numPolys == numCells)
-          {
-            neighborCellIdInInput = neiId;
-          }
-          else if (neiId < numPolys)
-          {
-            neighborCellIdInInput = polyIdToCellIdMap->GetId(neiId);
-          }
-          else
-          {
-            auto it = decomposedStripIdToStripIdMap.lower_bound(neiId + 1);
-            neighborCellIdInInput = stripIdToCellIdMap->GetId(it->second);
-          }
-          if (ghosts[neighborCellIdInInput] & CELL_NOT_VISIBLE)
-          {
-            if (this->NonManifoldEdges)
-            {
-              edgesRemapping->InsertNextId(j);
-            }
-            if (j == firstNeighbor)
-            {
-              ++firstNeighbor;
-            }
-            --numNeiWithoutGhosts;
-          }
-        }
+        this->CheckAbort();
       }
-      // Ignoring edges that are not visible
-      if (numNeiWithoutGhosts != numNei && this->RemoveGhostInterfaces)
+      if (this->GetAbortOutput())
       {
-        continue;
+        break;
       }
 
-      if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
+      if (ghosts && ghosts[inputCellId(polyId)] & CELL_NOT_VISIBLE)
       {
-        numBEdges++;
-        scalar = 0.0;
+        continue;
       }
 
-      else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
+      newPolys->GetCellAtId(polyId, nCellPts, cellPtIds, cellPts);
+      signed char* cellEdgeTypes = edgeTypes.data() + newPolys->GetOffset(polyId);
+      edgesRemapping->Reset();
+
+      for (vtkIdType edgeId = 0; edgeId < nCellPts; ++edgeId)
       {
-        // check to make sure that this edge hasn't been created before
-        for (j = 0; j < (ghosts ? edgesRemapping->GetNumberOfIds() : numNei); j++)
+        const vtkIdType edgePt1 = cellPtIds[edgeId];
+        const vtkIdType edgePt2 = cellPtIds[(edgeId + 1) % nCellPts];
+
+        Mesh->GetCellEdgeNeighbors(polyId, edgePt1, edgePt2, neighbors);
+        const vtkIdType numNeighbors = neighbors->GetNumberOfIds();
+
+        vtkIdType numNeiWithoutGhosts = numNeighbors;
+        vtkIdType firstNeighbor = 0;
+        if (ghosts)
         {
-          if (neighbors->GetId(ghosts ? edgesRemapping->GetId(j) : j) < newCellId)
+          for (vtkIdType k = 0; k < numNeighbors; ++k)
           {
-            break;
+            if (ghosts[inputCellId(neighbors->GetId(k))] & CELL_NOT_VISIBLE)
+            {
+              if (this->NonManifoldEdges)
+              {
+                edgesRemapping->InsertNextId(k);
+              }
+              if (k == firstNeighbor)
+              {
+                ++firstNeighbor;
+              }
+              --numNeiWithoutGhosts;
+            }
           }
         }
-        edgesRemapping->Reset();
-        if (j >= numNeiWithoutGhosts)
+        // Ignoring edges that are not visible
+        if (numNeiWithoutGhosts != numNeighbors && this->RemoveGhostInterfaces)
         {
-          numNonManifoldEdges++;
-          scalar = 0.222222;
+          continue;
         }
-        else
+
+        if (this->BoundaryEdges && numNeiWithoutGhosts < 1)
         {
-          continue;
+          cellEdgeTypes[edgeId] = BOUNDARY_EDGE;
         }
-      }
-      else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
-        (nei = neighbors->GetId(firstNeighbor)) > newCellId)
-      {
-        double neiTuple[3];
-        double cellTuple[3];
-        polyNormals->GetTuple(nei, neiTuple);
-        polyNormals->GetTuple(newCellId, cellTuple);
-        if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
+        else if (this->NonManifoldEdges && numNeiWithoutGhosts > 1)
         {
-          numFedges++;
-          scalar = 0.444444;
+          // check to make sure that this edge hasn't been created before
+          vtkIdType k;
+          for (k = 0; k < (ghosts ? edgesRemapping->GetNumberOfIds() : numNeighbors); k++)
+          {
+            if (neighbors->GetId(ghosts ? edgesRemapping->GetId(k) : k) < polyId)
+            {
+              break;
+            }
+          }
+          edgesRemapping->Reset();
+          if (k >= numNeiWithoutGhosts)
+          {
+            cellEdgeTypes[edgeId] = NON_MANIFOLD_EDGE;
+          }
         }
-        else
+        else if (this->FeatureEdges && numNeiWithoutGhosts == 1 &&
+          neighbors->GetId(firstNeighbor) > polyId)
         {
-          continue;
+          double neiTuple[3];
+          double cellTuple[3];
+          polyNormals->GetTuple(neighbors->GetId(firstNeighbor), neiTuple);
+          polyNormals->GetTuple(polyId, cellTuple);
+          if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
+          {
+            cellEdgeTypes[edgeId] = FEATURE_EDGE;
+          }
         }
+        else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
+          neighbors->GetId(firstNeighbor) > polyId)
+        {
+          cellEdgeTypes[edgeId] = MANIFOLD_EDGE;
+        }
+      }
+    }
+  });
+
+  const double edgeScalars[4] = { 0.0, 0.222222, 0.444444, 0.666667 };
+  vtkIdType progressInterval = numNewPolys / 20 + 1;
+  for (newCellId = 0, newPolys->InitTraversal();
+       !this->GetAbortOutput() && newPolys->GetNextCell(npts, pts); newCellId++)
+  {
+    if (!(newCellId % progressInterval)) // manage progress
+    {
+      this->UpdateProgress(static_cast<double>(newCellId) / numCells);
+    }
+
+    const signed char* cellEdgeTypes = edgeTypes.data() + newPolys->GetOffset(newCellId);
+    cellId = -1;
+    for (i = 0; i < npts; i++)
+    {
+      if (cellEdgeTypes[i] == NO_EDGE)
+      {
+        continue;
       }
-      else if (this->ManifoldEdges && numNeiWithoutGhosts == 1 &&
-        neighbors->GetId(firstNeighbor) > newCellId)
+      switch (cellEdgeTypes[i])
       {
-        numManifoldEdges++;
-        scalar = 0.666667;
+        case BOUNDARY_EDGE:
+          numBEdges++;
+          break;
+        case NON_MANIFOLD_EDGE:
+          numNonManifoldEdges++;
+          break;
+        case FEATURE_EDGE:
+          numFedges++;
+          break;
+        default:
+          numManifoldEdges++;
+          break;
       }
-      else
+      scalar = edgeScalars[static_cast<int>(cellEdgeTypes[i])];
+      if (cellId < 0)
       {
-        continue;
+        cellId = inputCellId(newCellId);
       }
 
       // Add edge to output
+      p1 = pts[i];
+      p2 = pts[(i + 1) % npts];
       Mesh->GetPoint(p1, x1);
       Mesh->GetPoint(p2, x2);
 
@@ -497,7 +544,6 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
 
   output->SetPoints(newPts);
   newPts->Delete();
-  neighbors->Delete();
 
   output->SetLines(newLines);
   newLines->Delete();
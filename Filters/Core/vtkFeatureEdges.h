@@ -15,6 +15,10 @@
  * based on edge type. The cell coloring is assigned to the cell data of
  * the extracted edges.
  *
+ * The polygon normals and the classification of the polygon edges are
+ * computed in parallel with vtkSMPTools. The edges are then inserted in the
+ * polygon order, so the output does not depend on the number of threads.
+ *
  * @warning
  * To see the coloring of the lines you may have to set the ScalarMode
  * instance variable of the mapper to SetScalarModeToUseCellData(). (This
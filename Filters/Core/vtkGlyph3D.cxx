@@ -3,17 +3,24 @@
 #include "vtkGlyph3D.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -21,7 +28,64 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
+namespace
+{
+//------------------------------------------------------------------------------
+// Return the cell array holding all the cells of the source if the cells of
+// the glyphs can be written directly into a cell array of the output: all the
+// cells must be of one kind (verts, lines, polys or strips) and have the type
+// vtkPolyData deduces from their size.
+vtkCellArray* GetReplicableCells(vtkPolyData* source)
+{
+  const vtkIdType numCells = source->GetNumberOfCells();
+  if (numCells == 0)
+  {
+    return nullptr;
+  }
+  vtkCellArray* cellArrays[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+    source->GetStrips() };
+  int kind = 0;
+  while (kind < 4 && cellArrays[kind]->GetNumberOfCells() != numCells)
+  {
+    kind++;
+  }
+  if (kind == 4)
+  {
+    return nullptr;
+  }
+
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    const vtkIdType size = cellArrays[kind]->GetCellSize(cellId);
+    int type;
+    switch (kind)
+    {
+      case 0:
+        type = size == 1 ? VTK_VERTEX : VTK_POLY_VERTEX;
+        break;
+      case 1:
+        type = size == 2 ? VTK_LINE : VTK_POLY_LINE;
+        break;
+      case 2:
+        type = size == 3 ? VTK_TRIANGLE : (size == 4 ? VTK_QUAD : VTK_POLYGON);
+        break;
+      default:
+        type = VTK_TRIANGLE_STRIP;
+    }
+    if (source->GetCellType(cellId) != type)
+    {
+      return nullptr;
+    }
+  }
+  return cellArrays[kind];
+}
+}
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
@@ -52,6 +116,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->GenerateInstances = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
@@ -135,7 +200,7 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkDataArray* newVectors = nullptr;
   vtkDataArray* newNormals = nullptr;
   vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
+  double x[3], v[3], s = 0.0, vMag = 0.0, tc[3];
   vtkTransform* trans = vtkTransform::New();
   vtkNew<vtkIdList> pointIdList;
   vtkIdList* cellPts;
@@ -143,7 +208,7 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkIdList* pts;
   vtkIdType ptIncr, cellIncr, cellId;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
@@ -249,6 +314,338 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  vtkDataArray* array3D = nullptr;
+  if (haveVectors && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      pts->Delete();
+      trans->Delete();
+      return false;
+    }
+  }
+
+  // Compute the data scale of the glyph at a point from its scalar or
+  // vector, and the vector used to orient it.
+  auto computeDataScale = [&](vtkIdType ptId, double scale[3], double vec[3], double& scalar,
+                            double& mag) {
+    scale[0] = scale[1] = scale[2] = 1.0;
+    if (inSScalars)
+    {
+      scalar = inSScalars->GetComponent(ptId, 0);
+      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        scale[0] = scale[1] = scale[2] = scalar;
+      }
+    }
+
+    if (haveVectors)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        mag = 1.0; // vec will be set later
+      }
+      else
+      {
+        vec[0] = 0;
+        vec[1] = 0;
+        vec[2] = 0;
+        array3D->GetTuple(ptId, vec);
+        mag = vtkMath::Norm(vec);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        {
+          scale[0] = vec[0];
+          scale[1] = vec[1];
+          scale[2] = vec[2];
+        }
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+        {
+          scale[0] = scale[1] = scale[2] = mag;
+        }
+      }
+    }
+
+    // Clamp data scale if enabled
+    if (this->Clamping)
+    {
+      for (int c = 0; c < 3; c++)
+      {
+        scale[c] = (scale[c] < this->Range[0]
+            ? this->Range[0]
+            : (scale[c] > this->Range[1] ? this->Range[1] : scale[c]));
+        scale[c] = (scale[c] - this->Range[0]) / den;
+      }
+    }
+  };
+
+  // Compute the index into the table of glyphs
+  auto computeSourceIndex = [&](double scalar, double mag) {
+    const double indexValue = this->IndexMode == VTK_INDEXING_BY_SCALAR ? scalar : mag;
+    int index = static_cast<int>((indexValue - this->Range[0]) * numberOfSources / den);
+    return (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+  };
+
+  // Check ghost points, blanking and visibility. If we are processing a
+  // piece, we do not want to duplicate glyphs on the borders.
+  auto isPointSkipped = [&](vtkIdType ptId) {
+    return (inGhostLevels &&
+             inGhostLevels[ptId] &
+               (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT)) ||
+      (inputUG && !inputUG->IsPointVisible(ptId)) || !this->IsPointVisible(input, ptId);
+  };
+
+  // Set the transform translating the glyph to the point px, orienting it
+  // along vec and scaling it.
+  auto computeTransform = [&](vtkTransform* t, const double px[3], double vec[3], double mag,
+                            const double dataScale[3]) {
+    t->Identity();
+    t->Translate(px[0], px[1], px[2]);
+
+    if (haveVectors && this->Orient)
+    {
+      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      {
+        // vec = glyphNormal_World (glyph normal direction in World coordinate system)
+        vec[0] = this->FollowedCameraPosition[0] - px[0];
+        vec[1] = this->FollowedCameraPosition[1] - px[1];
+        vec[2] = this->FollowedCameraPosition[2] - px[2];
+        vtkMath::Normalize(vec);
+        double glyphRight_World[3]; // glyph right direction in World coordinate system
+        vtkMath::Cross(this->FollowedCameraViewUp, vec, glyphRight_World);
+        // glyph up direction in World coordinate system
+        // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
+        // orthogonal to the normal direction)
+        double glyphUp_World[3];
+        vtkMath::Cross(vec, glyphRight_World, glyphUp_World);
+        double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], vec[0], 0.0,
+          glyphRight_World[1], glyphUp_World[1], vec[1], 0.0, glyphRight_World[2],
+          glyphUp_World[2], vec[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
+        t->Concatenate(glyphToWorld);
+      }
+      else if (mag > 0.0)
+      {
+        // if there is no y or z component
+        if (vec[1] == 0.0 && vec[2] == 0.0)
+        {
+          if (vec[0] < 0) // just flip x if we need to
+          {
+            t->RotateWXYZ(180.0, 0, 1, 0);
+          }
+        }
+        else
+        {
+          double vNew[3];
+          vNew[0] = (vec[0] + mag) / 2.0;
+          vNew[1] = vec[1] / 2.0;
+          vNew[2] = vec[2] / 2.0;
+          t->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
+        }
+      }
+    }
+
+    // scale data if appropriate
+    if (this->Scaling)
+    {
+      double sx, sy, sz;
+      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+      {
+        sx = sy = sz = this->ScaleFactor;
+      }
+      else
+      {
+        sx = dataScale[0] * this->ScaleFactor;
+        sy = dataScale[1] * this->ScaleFactor;
+        sz = dataScale[2] * this->ScaleFactor;
+      }
+
+      if (sx == 0.0)
+      {
+        sx = 1.0e-10;
+      }
+      if (sy == 0.0)
+      {
+        sy = 1.0e-10;
+      }
+      if (sz == 0.0)
+      {
+        sz = 1.0e-10;
+      }
+      t->Scale(sx, sy, sz);
+    }
+  };
+
+  if (this->GenerateInstances)
+  {
+    // Select the points to glyph. This is done serially as IsPointVisible
+    // may be overridden by subclasses.
+    std::vector<vtkIdType> glyphPtIds;
+    glyphPtIds.reserve(numPts);
+    for (inPtId = 0; inPtId < numPts; inPtId++)
+    {
+      if (this->IndexMode != VTK_INDEXING_OFF)
+      {
+        double scale[3];
+        computeDataScale(inPtId, scale, v, s, vMag);
+        if (this->GetSource(computeSourceIndex(s, vMag), sourceVector) == nullptr)
+        {
+          continue;
+        }
+      }
+      if (!isPointSkipped(inPtId))
+      {
+        glyphPtIds.push_back(inPtId);
+      }
+    }
+    const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPtIds.size());
+
+    newPts = vtkPoints::New();
+    newPts->SetDataType(
+      this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION ? VTK_DOUBLE : VTK_FLOAT);
+    newPts->SetNumberOfPoints(numGlyphs);
+
+    pd = input->GetPointData();
+    outputPD->CopyAllocate(pd, numGlyphs);
+    outputPD->SetNumberOfTuples(numGlyphs);
+
+    vtkNew<vtkDoubleArray> transforms;
+    transforms->SetName("GlyphTransform");
+    transforms->SetNumberOfComponents(16);
+    transforms->SetNumberOfTuples(numGlyphs);
+    vtkNew<vtkIntArray> sourceIndices;
+    sourceIndices->SetName("GlyphSourceIndex");
+    sourceIndices->SetNumberOfTuples(this->IndexMode != VTK_INDEXING_OFF ? numGlyphs : 0);
+    if (this->GeneratePointIds)
+    {
+      pointIds = vtkIdTypeArray::New();
+      pointIds->SetName(this->PointIdsName);
+      pointIds->SetNumberOfTuples(numGlyphs);
+      outputPD->AddArray(pointIds);
+      pointIds->Delete();
+    }
+    if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
+    {
+      newScalars = inCScalars->NewInstance();
+      newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
+      newScalars->SetName(inCScalars->GetName());
+    }
+    else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
+    {
+      newScalars = vtkFloatArray::New();
+      newScalars->SetName(
+        this->ScaleMode == VTK_SCALE_BY_SCALAR ? inSScalars->GetName() : "GlyphScale");
+    }
+    else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
+    {
+      newScalars = vtkFloatArray::New();
+      newScalars->SetName("VectorMagnitude");
+    }
+    if (newScalars)
+    {
+      newScalars->SetNumberOfTuples(numGlyphs);
+    }
+    if (array3D)
+    {
+      newVectors = vtkFloatArray::New();
+      newVectors->SetNumberOfComponents(3);
+      newVectors->SetNumberOfTuples(numGlyphs);
+      newVectors->SetName("GlyphVector");
+    }
+
+    // The source transform is applied first, as when copying the geometry.
+    double sourceMatrix[16];
+    vtkMatrix4x4::Identity(sourceMatrix);
+    if (this->SourceTransform)
+    {
+      vtkMatrix4x4::DeepCopy(sourceMatrix, this->SourceTransform->GetMatrix());
+    }
+
+    vtkSMPThreadLocalObject<vtkTransform> localTransforms;
+    vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+      vtkTransform* t = localTransforms.Local();
+      double scale[3], vec[3] = { 0.0, 0.0, 0.0 }, px[3], scalar = 0.0, mag = 0.0;
+      double glyphMatrix[16];
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType glyphId = begin; glyphId < end; glyphId++)
+      {
+        if (isFirst && !(glyphId % 10000))
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+
+        const vtkIdType ptId = glyphPtIds[glyphId];
+        computeDataScale(ptId, scale, vec, scalar, mag);
+        input->GetPoint(ptId, px);
+        newPts->SetPoint(glyphId, px);
+        if (newVectors)
+        {
+          newVectors->SetTuple(glyphId, vec);
+        }
+        if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
+        {
+          newScalars->SetTuple(glyphId, scale);
+        }
+        else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
+        {
+          newScalars->SetTuple(glyphId, ptId, inCScalars);
+        }
+        if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+        {
+          newScalars->SetTuple(glyphId, &mag);
+        }
+        if (this->IndexMode != VTK_INDEXING_OFF)
+        {
+          sourceIndices->SetValue(glyphId, computeSourceIndex(scalar, mag));
+        }
+
+        computeTransform(t, px, vec, mag, scale);
+        vtkMatrix4x4::Multiply4x4(t->GetMatrix()->GetData(), sourceMatrix, glyphMatrix);
+        transforms->SetTypedTuple(glyphId, glyphMatrix);
+
+        outputPD->CopyData(pd, ptId, glyphId);
+        if (this->GeneratePointIds)
+        {
+          pointIds->SetValue(glyphId, ptId);
+        }
+      }
+    });
+
+    vtkNew<vtkCellArray> verts;
+    verts->AllocateExact(numGlyphs, numGlyphs);
+    for (vtkIdType glyphId = 0; glyphId < numGlyphs; glyphId++)
+    {
+      verts->InsertNextCell(1, &glyphId);
+    }
+    output->SetVerts(verts);
+    outputPD->AddArray(transforms);
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      outputPD->AddArray(sourceIndices);
+    }
+
+    output->SetPoints(newPts);
+    newPts->Delete();
+    if (newScalars)
+    {
+      int idx = outputPD->AddArray(newScalars);
+      outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+      newScalars->Delete();
+    }
+    if (newVectors)
+    {
+      outputPD->SetVectors(newVectors);
+      newVectors->Delete();
+    }
+    trans->Delete();
+    pts->Delete();
+    return true;
+  }
+
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
@@ -385,328 +782,373 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords->SetName("TCoords");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
-
+  // Glyphs using the same source, without camera following which carries
+  // the vector of a point over to the next one, are generated in parallel
+  // when the source cells can be replicated directly into a cell array of
+  // the output.
   transformedSourcePts->SetDataTypeToDouble();
   transformedSourcePts->Allocate(numSourcePts);
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  vtkCellArray* sourceCells = nullptr;
+  if (this->IndexMode == VTK_INDEXING_OFF && this->VectorMode != VTK_FOLLOW_CAMERA_DIRECTION)
+  {
+    sourceCells = ::GetReplicableCells(source);
+  }
+
+  if (sourceCells)
   {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
+    // Select the points to glyph. This is done serially as IsPointVisible
+    // may be overridden by subclasses.
+    std::vector<vtkIdType> glyphPtIds;
+    glyphPtIds.reserve(numPts);
+    for (inPtId = 0; inPtId < numPts; inPtId++)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->CheckAbort())
+      if (!isPointSkipped(inPtId))
       {
-        break;
+        glyphPtIds.push_back(inPtId);
       }
     }
+    const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphPtIds.size());
+    const vtkIdType numOutPts = numGlyphs * numSourcePts;
+    const vtkIdType numOutCells = numGlyphs * numSourceCells;
+
+    // Every glyph has the same number of points and cells, their offsets
+    // in the output follow from their index.
+    std::vector<vtkIdType> sourceOffsets(numSourceCells + 1);
+    std::vector<vtkIdType> sourceConnectivity;
+    sourceConnectivity.reserve(sourceCells->GetNumberOfConnectivityIds());
+    sourceOffsets[0] = 0;
+    for (cellId = 0; cellId < numSourceCells; cellId++)
+    {
+      source->GetCellPoints(cellId, pointIdList);
+      for (i = 0; i < pointIdList->GetNumberOfIds(); i++)
+      {
+        sourceConnectivity.push_back(pointIdList->GetId(i));
+      }
+      sourceOffsets[cellId + 1] = static_cast<vtkIdType>(sourceConnectivity.size());
+    }
+    const vtkIdType connectivitySize = static_cast<vtkIdType>(sourceConnectivity.size());
 
-    // Get the scalar and vector data
-    if (inSScalars)
+    vtkNew<vtkIdTypeArray> outOffsets;
+    outOffsets->SetNumberOfValues(numOutCells + 1);
+    outOffsets->SetValue(numOutCells, numGlyphs * connectivitySize);
+    vtkNew<vtkIdTypeArray> outConnectivity;
+    outConnectivity->SetNumberOfValues(numGlyphs * connectivitySize);
+
+    newPts->SetNumberOfPoints(numOutPts);
+    if (pd)
     {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      outputPD->SetNumberOfTuples(numOutPts);
+      if (this->FillCellData)
+      {
+        outputCD->SetNumberOfTuples(numOutCells);
+      }
+    }
+    for (vtkDataArray* array : { newScalars, newVectors, newNormals, newTCoords })
+    {
+      if (array)
       {
-        scalex = scaley = scalez = s;
+        array->SetNumberOfTuples(numOutPts);
       }
     }
 
-    if (haveVectors)
+    // The source transform is the same for all glyphs.
+    vtkPoints* glyphPts = sourcePts;
+    if (this->SourceTransform)
     {
-      if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
+      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
+      glyphPts = transformedSourcePts;
+    }
+
+    const int pointTypeSize = newPts->GetData()->GetDataTypeSize();
+    vtkSMPThreadLocalObject<vtkTransform> localTransforms;
+    vtkSMPThreadLocal<vtkSmartPointer<vtkPoints>> localPts;
+    vtkSMPThreadLocalObject<vtkFloatArray> localNormals;
+    vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+      vtkTransform* t = localTransforms.Local();
+      vtkSmartPointer<vtkPoints>& tPts = localPts.Local();
+      if (!tPts)
       {
-        vMag = 1.0; // v will be set later
+        tPts = vtkSmartPointer<vtkPoints>::New();
+        tPts->SetDataType(newPts->GetDataType());
       }
-      else
+      vtkFloatArray* tNormals = localNormals.Local();
+      tNormals->SetNumberOfComponents(3);
+      double scale[3], vec[3] = { 0.0, 0.0, 0.0 }, px[3], tcoord[3], scalar = 0.0, mag = 0.0;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+
+      for (vtkIdType glyphId = begin; glyphId < end; glyphId++)
       {
-        vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-        if (array3D->GetNumberOfComponents() > 3)
+        if (isFirst && !(glyphId % 10000))
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+
+        const vtkIdType ptId = glyphPtIds[glyphId];
+        const vtkIdType ptOffset = glyphId * numSourcePts;
+        const vtkIdType cellOffset = glyphId * numSourceCells;
+        const vtkIdType connectivityOffset = glyphId * connectivitySize;
+
+        // Copy all topology (transformation independent)
+        for (vtkIdType id = 0; id < numSourceCells; id++)
+        {
+          outOffsets->SetValue(cellOffset + id, connectivityOffset + sourceOffsets[id]);
+        }
+        for (vtkIdType id = 0; id < connectivitySize; id++)
         {
-          vtkErrorMacro(<< "vtkDataArray " << array3D->GetName()
-                        << " has more than 3 components.\n");
-          pts->Delete();
-          trans->Delete();
-          if (newPts)
+          outConnectivity->SetValue(connectivityOffset + id, sourceConnectivity[id] + ptOffset);
+        }
+
+        computeDataScale(ptId, scale, vec, scalar, mag);
+        input->GetPoint(ptId, px);
+
+        for (vtkIdType id = 0; id < numSourcePts; id++)
+        {
+          if (newVectors)
           {
-            newPts->Delete();
+            newVectors->SetTuple(ptOffset + id, vec);
           }
-          if (newVectors)
+          if (newTCoords)
+          {
+            sourceTCoords->GetTuple(id, tcoord);
+            newTCoords->SetTuple(ptOffset + id, tcoord);
+          }
+          if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
+          {
+            newScalars->SetTuple(ptOffset + id, scale);
+          }
+          else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
           {
-            newVectors->Delete();
+            newScalars->SetTuple(ptOffset + id, ptId, inCScalars);
+          }
+          if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
+          {
+            newScalars->SetTuple(ptOffset + id, &mag);
           }
-          return false;
         }
 
-        v[0] = 0;
-        v[1] = 0;
-        v[2] = 0;
-        array3D->GetTuple(inPtId, v);
-        vMag = vtkMath::Norm(v);
-        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
+        // multiply points and normals by resulting matrix
+        computeTransform(t, px, vec, mag, scale);
+        tPts->Reset();
+        t->TransformPoints(glyphPts, tPts);
+        memcpy(static_cast<char*>(newPts->GetVoidPointer(0)) + 3 * ptOffset * pointTypeSize,
+          tPts->GetVoidPointer(0), 3 * numSourcePts * pointTypeSize);
+        if (newNormals)
         {
-          scalex = v[0];
-          scaley = v[1];
-          scalez = v[2];
+          tNormals->Reset();
+          t->TransformNormals(sourceNormals, tNormals);
+          std::copy_n(tNormals->GetPointer(0), 3 * numSourcePts,
+            static_cast<vtkFloatArray*>(newNormals)->GetPointer(3 * ptOffset));
         }
-        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
+
+        // Copy point data from source (if possible)
+        if (pd)
         {
-          scalex = scaley = scalez = vMag;
+          for (vtkIdType id = 0; id < numSourcePts; id++)
+          {
+            outputPD->CopyData(pd, ptId, ptOffset + id);
+          }
+          if (this->FillCellData)
+          {
+            for (vtkIdType id = 0; id < numSourceCells; id++)
+            {
+              outputCD->CopyData(pd, ptId, cellOffset + id);
+            }
+          }
         }
-      }
-    }
-
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
 
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
-      {
-        value = s;
-      }
-      else
-      {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
-
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
-      {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
+        // If point ids are to be generated, do it here
+        if (this->GeneratePointIds)
+        {
+          for (vtkIdType id = 0; id < numSourcePts; id++)
+          {
+            pointIds->SetValue(ptOffset + id, ptId);
+          }
+        }
       }
-    }
+    });
 
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
+    vtkNew<vtkCellArray> outCells;
+    outCells->SetData(outOffsets, outConnectivity);
+    if (sourceCells == source->GetVerts())
     {
-      continue;
+      output->SetVerts(outCells);
     }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate glyphs on the borders.
-    if (inGhostLevels &&
-      inGhostLevels[inPtId] &
-        (vtkDataSetAttributes::DUPLICATEPOINT | vtkDataSetAttributes::HIDDENPOINT))
+    else if (sourceCells == source->GetLines())
     {
-      continue;
+      output->SetLines(outCells);
     }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
+    else if (sourceCells == source->GetPolys())
     {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
+      output->SetPolys(outCells);
     }
-
-    if (!this->IsPointVisible(input, inPtId))
+    else
     {
-      continue;
+      output->SetStrips(outCells);
     }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
+  }
+  else
+  {
+    // Setting up for calls to PolyData::InsertNextCell()
+    output->AllocateEstimate(numPts * numSourceCells, 3);
+
+    // Traverse all Input points, transforming Source points and copying
+    // point attributes.
+    //
+    ptIncr = 0;
+    cellIncr = 0;
+    for (inPtId = 0; inPtId < numPts; inPtId++)
     {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
+      if (!(inPtId % 10000))
       {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
+        this->UpdateProgress(static_cast<double>(inPtId) / numPts);
+        if (this->CheckAbort())
+        {
+          break;
+        }
       }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+      // Get the scalar and vector data
+      double scale[3];
+      computeDataScale(inPtId, scale, v, s, vMag);
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
+      // Compute index into table of glyphs
+      if (this->IndexMode != VTK_INDEXING_OFF)
       {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient)
-      {
-        if (this->VectorMode == VTK_FOLLOW_CAMERA_DIRECTION)
-        {
-          // v = glyphNormal_World (glyph normal direction in World coordinate system)
-          v[0] = this->FollowedCameraPosition[0] - x[0];
-          v[1] = this->FollowedCameraPosition[1] - x[1];
-          v[2] = this->FollowedCameraPosition[2] - x[2];
-          vtkMath::Normalize(v);
-          double glyphRight_World[3]; // glyph right direction in World coordinate system
-          vtkMath::Cross(this->FollowedCameraViewUp, v, glyphRight_World);
-          // glyph up direction in World coordinate system
-          // (approximately the same as this->FollowedCameraViewUp, but slightly adjusted to be
-          // orthogonal to the normal direction)
-          double glyphUp_World[3];
-          vtkMath::Cross(v, glyphRight_World, glyphUp_World);
-          double glyphToWorld[16] = { glyphRight_World[0], glyphUp_World[0], v[0], 0.0,
-            glyphRight_World[1], glyphUp_World[1], v[1], 0.0, glyphRight_World[2], glyphUp_World[2],
-            v[2], 0.0, 0.0, 0.0, 0.0, 1.0 };
-          trans->Concatenate(glyphToWorld);
-        }
-        else if (vMag > 0.0)
+        source = this->GetSource(computeSourceIndex(s, vMag), sourceVector);
+        if (source != nullptr)
         {
-          // if there is no y or z component
-          if (v[1] == 0.0 && v[2] == 0.0)
-          {
-            if (v[0] < 0) // just flip x if we need to
-            {
-              trans->RotateWXYZ(180.0, 0, 1, 0);
-            }
-          }
-          else
-          {
-            vNew[0] = (v[0] + vMag) / 2.0;
-            vNew[1] = v[1] / 2.0;
-            vNew[2] = v[2] / 2.0;
-            trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
-          }
+          sourcePts = source->GetPoints();
+          sourceNormals = source->GetPointData()->GetNormals();
+          numSourcePts = sourcePts->GetNumberOfPoints();
+          numSourceCells = source->GetNumberOfCells();
         }
       }
-    }
 
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
+      // Make sure we're not indexing into empty glyph
+      if (source == nullptr)
       {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
+        continue;
       }
-    }
 
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
+      if (isPointSkipped(inPtId))
       {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
+        continue;
       }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
+
+      // Copy all topology (transformation independent)
+      for (cellId = 0; cellId < numSourceCells; cellId++)
       {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
+        source->GetCellPoints(cellId, pointIdList);
+        cellPts = pointIdList;
+        npts = cellPts->GetNumberOfIds();
+        for (pts->Reset(), i = 0; i < npts; i++)
+        {
+          pts->InsertId(i, cellPts->GetId(i) + ptIncr);
+        }
+        output->InsertNextCell(source->GetCellType(cellId), pts);
       }
-    }
 
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+      input->GetPoint(inPtId, x);
+
+      if (haveVectors)
       {
-        scalex = scaley = scalez = this->ScaleFactor;
+        // Copy Input vector
+        for (i = 0; i < numSourcePts; i++)
+        {
+          newVectors->InsertTuple(i + ptIncr, v);
+        }
       }
-      else
+
+      if (haveTCoords)
       {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
+        for (i = 0; i < numSourcePts; i++)
+        {
+          sourceTCoords->GetTuple(i, tc);
+          newTCoords->InsertTuple(i + ptIncr, tc);
+        }
       }
 
-      if (scalex == 0.0)
+      // determine scale factor from scalars if appropriate
+      // Copy scalar value
+      if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
       {
-        scalex = 1.0e-10;
+        for (i = 0; i < numSourcePts; i++)
+        {
+          newScalars->InsertTuple(i + ptIncr, scale);
+        }
       }
-      if (scaley == 0.0)
+      else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
       {
-        scaley = 1.0e-10;
+        for (i = 0; i < numSourcePts; i++)
+        {
+          outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
+        }
       }
-      if (scalez == 0.0)
+      if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
       {
-        scalez = 1.0e-10;
+        for (i = 0; i < numSourcePts; i++)
+        {
+          newScalars->InsertTuple(i + ptIncr, &vMag);
+        }
       }
-      trans->Scale(scalex, scaley, scalez);
-    }
 
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
+      // Translate, orient and scale the glyph
+      computeTransform(trans, x, v, vMag, scale);
 
-    if (haveNormals)
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
+      // multiply points and normals by resulting matrix
+      if (this->SourceTransform)
+      {
+        transformedSourcePts->Reset();
+        this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
+        trans->TransformPoints(transformedSourcePts, newPts);
+      }
+      else
+      {
+        trans->TransformPoints(sourcePts, newPts);
+      }
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (i = 0; i < numSourcePts; ++i)
+      if (haveNormals)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
+        trans->TransformNormals(sourceNormals, newNormals);
       }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
+
+      // Copy point data from source (if possible)
+      if (pd)
       {
-        for (i = 0; i < numSourceCells; ++i)
+        for (i = 0; i < numSourcePts; ++i)
+        {
+          srcPointIdList->SetId(i, inPtId);
+          dstPointIdList->SetId(i, ptIncr + i);
+        }
+        outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
+        if (this->FillCellData)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          for (i = 0; i < numSourceCells; ++i)
+          {
+            srcCellIdList->SetId(i, inPtId);
+            dstCellIdList->SetId(i, cellIncr + i);
+          }
+          outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
       }
-    }
 
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
+      // If point ids are to be generated, do it here
+      if (this->GeneratePointIds)
       {
-        pointIds->InsertNextValue(inPtId);
+        for (i = 0; i < numSourcePts; i++)
+        {
+          pointIds->InsertNextValue(inPtId);
+        }
       }
-    }
 
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
+      ptIncr += numSourcePts;
+      cellIncr += numSourceCells;
+    }
   }
 
   // Update ourselves and release memory
@@ -893,6 +1335,7 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Generate Instances: " << (this->GenerateInstances ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
@@ -61,6 +61,12 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Glyphs are generated in
+ * parallel when a single source made of one kind of cells is used and the
+ * glyphs do not follow the camera; other configurations run serially. The
+ * GenerateInstances option skips the copy of the source geometry altogether.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -290,6 +296,22 @@ public:
   vtkBooleanMacro(FillCellData, vtkTypeBool);
   ///@}
 
+  ///@{
+  /**
+   * Enable/disable the generation of glyph instances instead of glyph
+   * geometry. When on, the output holds one vertex per glyphed point rather
+   * than a copy of the source, and the point data carries what is needed to
+   * draw the glyphs with instancing: a 16-component "GlyphTransform" array
+   * holding the row-major 4x4 matrix transforming the source to the glyph,
+   * SourceTransform included, a "GlyphSourceIndex" array when indexing is
+   * on, the color scalars, the "GlyphVector" array and the input point data.
+   * Off by default.
+   */
+  vtkSetMacro(GenerateInstances, vtkTypeBool);
+  vtkGetMacro(GenerateInstances, vtkTypeBool);
+  vtkBooleanMacro(GenerateInstances, vtkTypeBool);
+  ///@}
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
@@ -357,6 +379,7 @@ protected:
   int IndexMode;                  // what to use to index into glyph table
   vtkTypeBool GeneratePointIds;   // produce input points ids for each output point
   vtkTypeBool FillCellData;       // whether to fill output cell data
+  vtkTypeBool GenerateInstances;  // whether to output one vertex per glyph
   char* PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
@@ -9,6 +9,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTriangleFilter.h"
 
@@ -130,6 +131,62 @@ void vtkImplicitPolyDataDistance::EvaluateGradient(double x[3], double g[3])
     x, g, p); // get normal, returned distance value not used and closest point not used
 }
 
+//------------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::EvaluateFunctionAndGetClosestPoint(
+  vtkDataArray* input, vtkDataArray* output, vtkDataArray* closestPoints, vtkDataArray* gradients)
+{
+  const vtkIdType numPts = input->GetNumberOfTuples();
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(numPts);
+  if (closestPoints)
+  {
+    closestPoints->SetNumberOfComponents(3);
+    closestPoints->SetNumberOfTuples(numPts);
+  }
+  if (gradients)
+  {
+    gradients->SetNumberOfComponents(3);
+    gradients->SetNumberOfTuples(numPts);
+  }
+
+  // Check once here rather than reporting the error from every thread
+  if (this->Input == nullptr || this->Input->GetNumberOfCells() == 0)
+  {
+    vtkErrorMacro(<< "No polygons to evaluate function!");
+    output->Fill(this->NoValue);
+    for (int i = 0; i < 3; i++)
+    {
+      if (closestPoints)
+      {
+        closestPoints->FillComponent(i, this->NoClosestPoint[i]);
+      }
+      if (gradients)
+      {
+        gradients->FillComponent(i, this->NoGradient[i]);
+      }
+    }
+    return;
+  }
+
+  // SharedEvaluate() only uses thread local cells and id lists.
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3], g[3], p[3];
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      input->GetTuple(ptId, x);
+      output->SetTuple1(ptId, this->SharedEvaluate(x, g, p));
+      if (closestPoints)
+      {
+        closestPoints->SetTuple(ptId, p);
+      }
+      if (gradients)
+      {
+        gradients->SetTuple(ptId, g);
+      }
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], double closestPoint[3])
 {
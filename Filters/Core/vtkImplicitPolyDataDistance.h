@@ -35,6 +35,7 @@
 
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCellLocator;
+class vtkDataArray;
 class vtkPolyData;
 
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
@@ -66,6 +67,16 @@ public:
    */
   double EvaluateFunctionAndGetClosestPoint(double x[3], double closestPoint[3]);
 
+  /**
+   * Evaluate the function at all the points of the input array in parallel
+   * with vtkSMPTools. The closest points on the input vtkPolyData and the
+   * gradients are also stored when the corresponding arrays are given. The
+   * output arrays are resized to the number of input points. As with the
+   * single point version, the Transform is not applied.
+   */
+  void EvaluateFunctionAndGetClosestPoint(vtkDataArray* input, vtkDataArray* output,
+    vtkDataArray* closestPoints, vtkDataArray* gradients = nullptr);
+
   /**
    * Set the input vtkPolyData used for the implicit function
    * evaluation.  Passes input through an internal instance of
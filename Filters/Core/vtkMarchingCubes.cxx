@@ -9,6 +9,8 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkImageTransform.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -20,7 +22,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredPoints.h"
 #include "vtkUnsignedCharArray.h"
@@ -28,6 +33,11 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkMarchingCubes);
 
@@ -143,41 +153,70 @@ void vtkMarchingCubesComputePointGradient(
   }
 }
 
+// The edges of a voxel, as used by the case table: the offset of their first
+// point in the voxel and their axis. Edges go along increasing coordinates.
+const int EdgeOrigins[12][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 0 }, { 0, 0, 1 },
+  { 1, 0, 1 }, { 0, 1, 1 }, { 0, 0, 1 }, { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } };
+const int EdgeAxes[12] = { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 };
+
+// Whether the voxel ijk is the first voxel of the traversal to use one of
+// its edges, i.e. the lowest voxel around the edge.
+bool IsFirstVoxel(int edge, const int ijk[3])
+{
+  for (int d = 0; d < 3; d++)
+  {
+    if (d != EdgeAxes[edge] && EdgeOrigins[edge][d] == 0 && ijk[d] > 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The intersections of the contours with the voxel edges of a layer of
+// voxels. An intersection is identified by its key, (3 * first point of the
+// edge + axis) * number of contour values + contour number. Vertices lists the
+// intersections created by the layer, in the order the traversal first uses
+// them, and TriangleVertices the three intersections of each triangle.
+struct vtkMarchingCubesLayer
+{
+  std::vector<vtkIdType> Vertices;
+  std::vector<vtkIdType> TriangleVertices;
+};
+
+// Decode the key of an intersection into the first point of its edge, the
+// axis of the edge and the interpolation parameter along the edge.
+template <class ScalarRangeT>
+double vtkMarchingCubesDecodeVertex(vtkIdType key, const ScalarRangeT& scalars, const int dims[3],
+  const double* values, vtkIdType numValues, int ijk[3], int& axis)
+{
+  const vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+  const vtkIdType edgeId = key / numValues;
+  const vtkIdType ptId = edgeId / 3;
+  axis = static_cast<int>(edgeId % 3);
+  ijk[0] = static_cast<int>(ptId % dims[0]);
+  ijk[1] = static_cast<int>((ptId / dims[0]) % dims[1]);
+  ijk[2] = static_cast<int>(ptId / sliceSize);
+  const vtkIdType increments[3] = { 1, dims[0], sliceSize };
+  const double s1 = scalars[ptId];
+  const double s2 = scalars[ptId + increments[axis]];
+  return (values[key % numValues] - s1) / (s2 - s1);
+}
+
 //
 // Contouring filter specialized for volumes and "short int" data values.
+// The layers of voxels are processed in parallel.
 //
-struct ComputeGradientWorker
+struct ContourLayersWorker
 {
   template <class ScalarArrayT>
   void operator()(ScalarArrayT* scalarsArray, vtkMarchingCubes* self, int dims[3],
-    vtkIncrementalPointLocator* locator, vtkDataArray* newScalars, vtkDataArray* newGradients,
-    vtkDataArray* newNormals, vtkCellArray* newPolys, double* values, vtkIdType numValues) const
+    const double* values, vtkIdType numValues, std::vector<vtkMarchingCubesLayer>& layers) const
   {
     const auto scalars = vtk::DataArrayValueRange<1>(scalarsArray);
 
-    double s[8], value;
-    int i, j, k;
-    vtkIdType sliceSize;
     static const int CASE_MASK[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
-    vtkMarchingCubesTriangleCases *triCase, *triCases;
-    int* edge;
-    int contNum, jOffset, ii, index, *vert;
-    vtkIdType kOffset, idx;
-    vtkIdType ptIds[3];
-    vtkTypeBool ComputeNormals = newNormals != nullptr;
-    vtkTypeBool ComputeGradients = newGradients != nullptr;
-    vtkTypeBool ComputeScalars = newScalars != nullptr;
-    int NeedGradients;
-    int extent[6];
-    double t, *x1, *x2, x[3], *n1, *n2, n[3], min, max;
-    double pts[8][3], gradients[8][3], xp, yp, zp;
-    static int edges[12][2] = { { 0, 1 }, { 1, 2 }, { 3, 2 }, { 0, 3 }, { 4, 5 }, { 5, 6 },
-      { 7, 6 }, { 4, 7 }, { 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 } };
-
-    vtkInformation* inInfo = self->GetExecutive()->GetInputInformation(0, 0);
-    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
-
-    triCases = vtkMarchingCubesTriangleCases::GetCases();
+    const vtkMarchingCubesTriangleCases* triCases = vtkMarchingCubesTriangleCases::GetCases();
 
     //
     // Get min/max contour values
@@ -186,179 +225,178 @@ struct ComputeGradientWorker
     {
       return;
     }
+    double min = values[0];
+    double max = values[0];
+    for (vtkIdType i = 1; i < numValues; i++)
+    {
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+    }
 
-    for (min = max = values[0], i = 1; i < numValues; i++)
+    const vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+    vtkIdType edgeOffsets[12];
+    for (int e = 0; e < 12; e++)
     {
-      if (values[i] < min)
-      {
-        min = values[i];
-      }
-      if (values[i] > max)
-      {
-        max = values[i];
-      }
+      edgeOffsets[e] =
+        EdgeOrigins[e][0] + EdgeOrigins[e][1] * dims[0] + EdgeOrigins[e][2] * sliceSize;
     }
+
     //
-    // Traverse all voxel cells, generating triangles and point gradients
-    // using marching cubes algorithm.
+    // Traverse all voxel cells, generating triangles using marching cubes
+    // algorithm. Each intersection is created by the first voxel using it.
     //
-    sliceSize = dims[0] * dims[1];
-    int checkAbortInterval = std::min((dims[2] - 1) / 10 + 1, 1000);
-    for (k = 0; k < (dims[2] - 1); k++)
-    {
-      self->UpdateProgress(k / static_cast<double>(dims[2] - 1));
-      if (k % checkAbortInterval == 0 && self->CheckAbort())
+    vtkSMPTools::For(0, dims[2] - 1, [&](vtkIdType beginK, vtkIdType endK) {
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      double s[8];
+      for (int k = static_cast<int>(beginK); k < endK; k++)
       {
-        break;
-      }
-      kOffset = k * sliceSize;
-      pts[0][2] = k + extent[4];
-      zp = pts[0][2] + 1;
-      for (j = 0; j < (dims[1] - 1); j++)
-      {
-        jOffset = j * dims[0];
-        pts[0][1] = j + extent[2];
-        yp = pts[0][1] + 1;
-        for (i = 0; i < (dims[0] - 1); i++)
+        if (isFirst)
         {
-          // get scalar values
-          idx = i + jOffset + kOffset;
-          s[0] = scalars[idx];
-          s[1] = scalars[idx + 1];
-          s[2] = scalars[idx + 1 + dims[0]];
-          s[3] = scalars[idx + dims[0]];
-          s[4] = scalars[idx + sliceSize];
-          s[5] = scalars[idx + 1 + sliceSize];
-          s[6] = scalars[idx + 1 + dims[0] + sliceSize];
-          s[7] = scalars[idx + dims[0] + sliceSize];
-
-          if ((s[0] < min && s[1] < min && s[2] < min && s[3] < min && s[4] < min && s[5] < min &&
-                s[6] < min && s[7] < min) ||
-            (s[0] > max && s[1] > max && s[2] > max && s[3] > max && s[4] > max && s[5] > max &&
-              s[6] > max && s[7] > max))
-          {
-            continue; // no contours possible
-          }
-
-          // create voxel points
-          pts[0][0] = i + extent[0];
-          xp = pts[0][0] + 1;
-
-          pts[1][0] = xp;
-          pts[1][1] = pts[0][1];
-          pts[1][2] = pts[0][2];
-
-          pts[2][0] = xp;
-          pts[2][1] = yp;
-          pts[2][2] = pts[0][2];
-
-          pts[3][0] = pts[0][0];
-          pts[3][1] = yp;
-          pts[3][2] = pts[0][2];
-
-          pts[4][0] = pts[0][0];
-          pts[4][1] = pts[0][1];
-          pts[4][2] = zp;
-
-          pts[5][0] = xp;
-          pts[5][1] = pts[0][1];
-          pts[5][2] = zp;
-
-          pts[6][0] = xp;
-          pts[6][1] = yp;
-          pts[6][2] = zp;
-
-          pts[7][0] = pts[0][0];
-          pts[7][1] = yp;
-          pts[7][2] = zp;
-
-          NeedGradients = ComputeGradients || ComputeNormals;
-
-          // create gradients if needed
-          if (NeedGradients)
-          {
-            vtkMarchingCubesComputePointGradient(i, j, k, scalars, dims, sliceSize, gradients[0]);
-            vtkMarchingCubesComputePointGradient(
-              i + 1, j, k, scalars, dims, sliceSize, gradients[1]);
-            vtkMarchingCubesComputePointGradient(
-              i + 1, j + 1, k, scalars, dims, sliceSize, gradients[2]);
-            vtkMarchingCubesComputePointGradient(
-              i, j + 1, k, scalars, dims, sliceSize, gradients[3]);
-            vtkMarchingCubesComputePointGradient(
-              i, j, k + 1, scalars, dims, sliceSize, gradients[4]);
-            vtkMarchingCubesComputePointGradient(
-              i + 1, j, k + 1, scalars, dims, sliceSize, gradients[5]);
-            vtkMarchingCubesComputePointGradient(
-              i + 1, j + 1, k + 1, scalars, dims, sliceSize, gradients[6]);
-            vtkMarchingCubesComputePointGradient(
-              i, j + 1, k + 1, scalars, dims, sliceSize, gradients[7]);
-          }
-          for (contNum = 0; contNum < numValues; contNum++)
+          self->CheckAbort();
+        }
+        if (self->GetAbortOutput())
+        {
+          break;
+        }
+        vtkMarchingCubesLayer& layer = layers[k];
+        const vtkIdType kOffset = k * sliceSize;
+        for (int j = 0; j < (dims[1] - 1); j++)
+        {
+          const vtkIdType jOffset = j * dims[0];
+          for (int i = 0; i < (dims[0] - 1); i++)
           {
-            value = values[contNum];
-            // Build the case table
-            for (ii = 0, index = 0; ii < 8; ii++)
+            // get scalar values
+            const vtkIdType idx = i + jOffset + kOffset;
+            s[0] = scalars[idx];
+            s[1] = scalars[idx + 1];
+            s[2] = scalars[idx + 1 + dims[0]];
+            s[3] = scalars[idx + dims[0]];
+            s[4] = scalars[idx + sliceSize];
+            s[5] = scalars[idx + 1 + sliceSize];
+            s[6] = scalars[idx + 1 + dims[0] + sliceSize];
+            s[7] = scalars[idx + dims[0] + sliceSize];
+
+            if ((s[0] < min && s[1] < min && s[2] < min && s[3] < min && s[4] < min &&
+                  s[5] < min && s[6] < min && s[7] < min) ||
+              (s[0] > max && s[1] > max && s[2] > max && s[3] > max && s[4] > max && s[5] > max &&
+                s[6] > max && s[7] > max))
             {
-              if (s[ii] >= value)
-              {
-                index |= CASE_MASK[ii];
-              }
+              continue; // no contours possible
             }
-            if (index == 0 || index == 255) // no surface
-            {
-              continue;
-            }
-            triCase = triCases + index;
-            edge = triCase->edges;
 
-            for (; edge[0] > -1; edge += 3)
+            const int ijk[3] = { i, j, k };
+            for (int contNum = 0; contNum < numValues; contNum++)
             {
-              for (ii = 0; ii < 3; ii++) // insert triangle
+              const double value = values[contNum];
+              // Build the case table
+              int index = 0;
+              for (int ii = 0; ii < 8; ii++)
               {
-                vert = edges[edge[ii]];
-                t = (value - s[vert[0]]) / (s[vert[1]] - s[vert[0]]);
-                x1 = pts[vert[0]];
-                x2 = pts[vert[1]];
-                x[0] = x1[0] + t * (x2[0] - x1[0]);
-                x[1] = x1[1] + t * (x2[1] - x1[1]);
-                x[2] = x1[2] + t * (x2[2] - x1[2]);
-
-                // check for a new point
-                if (locator->InsertUniquePoint(x, ptIds[ii]))
+                if (s[ii] >= value)
                 {
-                  if (NeedGradients)
-                  {
-                    n1 = gradients[vert[0]];
-                    n2 = gradients[vert[1]];
-                    n[0] = n1[0] + t * (n2[0] - n1[0]);
-                    n[1] = n1[1] + t * (n2[1] - n1[1]);
-                    n[2] = n1[2] + t * (n2[2] - n1[2]);
-                  }
-                  if (ComputeScalars)
-                  {
-                    newScalars->InsertTuple(ptIds[ii], &value);
-                  }
-                  if (ComputeGradients)
-                  {
-                    newGradients->InsertTuple(ptIds[ii], n);
-                  }
-                  if (ComputeNormals)
-                  {
-                    vtkMath::Normalize(n);
-                    newNormals->InsertTuple(ptIds[ii], n);
-                  }
+                  index |= CASE_MASK[ii];
                 }
               }
-              // check for degenerate triangle
-              if (ptIds[0] != ptIds[1] && ptIds[0] != ptIds[2] && ptIds[1] != ptIds[2])
+              if (index == 0 || index == 255) // no surface
               {
-                newPolys->InsertNextCell(3, ptIds);
+                continue;
               }
-            } // for each triangle
-          }   // for all contours
-        }     // for i
-      }       // for j
-    }         // for k
+
+              int usedEdges = 0;
+              for (const int* edge = triCases[index].edges; edge[0] > -1; edge += 3)
+              {
+                for (int ii = 0; ii < 3; ii++) // insert triangle
+                {
+                  const int e = edge[ii];
+                  const vtkIdType key =
+                    (3 * (idx + edgeOffsets[e]) + EdgeAxes[e]) * numValues + contNum;
+                  if (!(usedEdges & (1 << e)))
+                  {
+                    usedEdges |= 1 << e;
+                    if (::IsFirstVoxel(e, ijk))
+                    {
+                      layer.Vertices.push_back(key);
+                    }
+                  }
+                  layer.TriangleVertices.push_back(key);
+                }
+              } // for each triangle
+            }   // for all contours
+          }     // for i
+        }       // for j
+      }         // for k
+    });
+  }
+};
+
+// Compute the coordinates of the intersections.
+struct InterpolatePointsWorker
+{
+  template <class ScalarArrayT>
+  void operator()(ScalarArrayT* scalarsArray, int dims[3], const int extent[6],
+    const double* values, vtkIdType numValues, vtkIdTypeArray* vertexKeys,
+    vtkDoubleArray* vertexPoints) const
+  {
+    const auto scalars = vtk::DataArrayValueRange<1>(scalarsArray);
+    vtkSMPTools::For(0, vertexKeys->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+      int ijk[3], axis;
+      double x1[3], x2[3];
+      for (vtkIdType vertex = begin; vertex < end; ++vertex)
+      {
+        const double t = vtkMarchingCubesDecodeVertex(
+          vertexKeys->GetValue(vertex), scalars, dims, values, numValues, ijk, axis);
+        for (int d = 0; d < 3; d++)
+        {
+          x1[d] = x2[d] = ijk[d] + extent[2 * d];
+        }
+        x2[axis] += 1;
+        double* x = vertexPoints->GetPointer(3 * vertex);
+        x[0] = x1[0] + t * (x2[0] - x1[0]);
+        x[1] = x1[1] + t * (x2[1] - x1[1]);
+        x[2] = x1[2] + t * (x2[2] - x1[2]);
+      }
+    });
+  }
+};
+
+// Interpolate the gradients of the output points from the gradients of the
+// points of their edge.
+struct InterpolateGradientsWorker
+{
+  template <class ScalarArrayT>
+  void operator()(ScalarArrayT* scalarsArray, int dims[3], const double* values,
+    vtkIdType numValues, vtkIdTypeArray* vertexKeys, vtkIdList* pointVertices,
+    vtkDataArray* newGradients, vtkDataArray* newNormals) const
+  {
+    const auto scalars = vtk::DataArrayValueRange<1>(scalarsArray);
+    const vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+    vtkSMPTools::For(0, pointVertices->GetNumberOfIds(), [&](vtkIdType begin, vtkIdType end) {
+      int ijk[3], axis;
+      double n1[3], n2[3], n[3];
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        const double t = vtkMarchingCubesDecodeVertex(
+          vertexKeys->GetValue(pointVertices->GetId(ptId)), scalars, dims, values, numValues, ijk,
+          axis);
+        vtkMarchingCubesComputePointGradient(
+          ijk[0], ijk[1], ijk[2], scalars, dims, sliceSize, n1);
+        ijk[axis]++;
+        vtkMarchingCubesComputePointGradient(
+          ijk[0], ijk[1], ijk[2], scalars, dims, sliceSize, n2);
+        n[0] = n1[0] + t * (n2[0] - n1[0]);
+        n[1] = n1[1] + t * (n2[1] - n1[1]);
+        n[2] = n1[2] + t * (n2[2] - n1[2]);
+        if (newGradients)
+        {
+          newGradients->SetTuple(ptId, n);
+        }
+        if (newNormals)
+        {
+          vtkMath::Normalize(n);
+          newNormals->SetTuple(ptId, n);
+        }
+      }
+    });
   }
 };
 
@@ -378,15 +416,9 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
   vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
-  vtkPoints* newPts;
-  vtkCellArray* newPolys;
-  vtkFloatArray* newScalars;
-  vtkFloatArray* newNormals;
-  vtkFloatArray* newGradients;
   vtkPointData* pd;
   vtkDataArray* inScalars;
   int dims[3], extent[6];
-  vtkIdType estimatedSize;
   double bounds[6];
   vtkIdType numContours = this->ContourValues->GetNumberOfContours();
   double* values = this->ContourValues->GetValues();
@@ -432,109 +464,289 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
 
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
 
-  // estimate the number of points from the volume dimensions
-  estimatedSize = static_cast<vtkIdType>(pow(1.0 * dims[0] * dims[1] * dims[2], 0.75));
-  estimatedSize = estimatedSize / 1024 * 1024; // multiple of 1024
-  if (estimatedSize < 1024)
-  {
-    estimatedSize = 1024;
-  }
-  vtkDebugMacro(<< "Estimated allocation size is " << estimatedSize);
-  newPts = vtkPoints::New();
-  newPts->Allocate(estimatedSize, estimatedSize / 2);
   // compute bounds for merging points
   for (int i = 0; i < 3; i++)
   {
     bounds[2 * i] = extent[2 * i];
     bounds[2 * i + 1] = extent[2 * i + 1];
   }
-  if (this->Locator == nullptr)
-  {
-    this->CreateDefaultLocator();
-  }
-  this->Locator->InitPointInsertion(newPts, bounds, estimatedSize);
 
-  if (this->ComputeNormals)
-  {
-    newNormals = vtkFloatArray::New();
-    newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * estimatedSize, 3 * estimatedSize / 2);
-  }
-  else
-  {
-    newNormals = nullptr;
-  }
+  // Generate the triangles of each layer of voxels in parallel.
+  std::vector<vtkMarchingCubesLayer> layers(dims[2] - 1);
+  using Dispatcher = vtkArrayDispatch::Dispatch;
+  ContourLayersWorker worker;
+  if (!Dispatcher::Execute(inScalars, worker, this, dims, values, numContours, layers))
+  { // Fallback to slow path for unknown arrays:
+    worker(inScalars, this, dims, values, numContours, layers);
+  }
+  this->UpdateProgress(0.5);
+
+  // Gather the layers, in traversal order.
+  std::vector<vtkIdType> vertexOffsets(layers.size() + 1, 0);
+  std::vector<vtkIdType> cornerOffsets(layers.size() + 1, 0);
+  for (size_t layerId = 0; layerId < layers.size(); ++layerId)
+  {
+    vertexOffsets[layerId + 1] =
+      vertexOffsets[layerId] + static_cast<vtkIdType>(layers[layerId].Vertices.size());
+    cornerOffsets[layerId + 1] =
+      cornerOffsets[layerId] + static_cast<vtkIdType>(layers[layerId].TriangleVertices.size());
+  }
+  vtkNew<vtkIdTypeArray> vertexKeys;
+  vertexKeys->SetNumberOfValues(vertexOffsets.back());
+  vtkNew<vtkIdTypeArray> triangleKeys;
+  triangleKeys->SetNumberOfValues(cornerOffsets.back());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(layers.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType layerId = begin; layerId < end; ++layerId)
+    {
+      vtkMarchingCubesLayer& layer = layers[layerId];
+      std::copy(layer.Vertices.begin(), layer.Vertices.end(),
+        vertexKeys->GetPointer(vertexOffsets[layerId]));
+      std::copy(layer.TriangleVertices.begin(), layer.TriangleVertices.end(),
+        triangleKeys->GetPointer(cornerOffsets[layerId]));
+      layer = vtkMarchingCubesLayer();
+    }
+  });
 
-  if (this->ComputeGradients)
+  vtkNew<vtkDoubleArray> vertexPoints;
+  vertexPoints->SetNumberOfComponents(3);
+  vertexPoints->SetNumberOfTuples(vertexKeys->GetNumberOfValues());
+  InterpolatePointsWorker pointsWorker;
+  if (!Dispatcher::Execute(inScalars, pointsWorker, dims, extent, values, numContours,
+        vertexKeys.Get(), vertexPoints.Get()))
   {
-    newGradients = vtkFloatArray::New();
-    newGradients->SetNumberOfComponents(3);
-    newGradients->Allocate(3 * estimatedSize, 3 * estimatedSize / 2);
-  }
-  else
-  {
-    newGradients = nullptr;
+    pointsWorker(
+      inScalars, dims, extent, values, numContours, vertexKeys.Get(), vertexPoints.Get());
   }
 
-  newPolys = vtkCellArray::New();
-  newPolys->AllocateEstimate(estimatedSize, 3);
+  vtkNew<vtkPoints> newPts;
+  vtkNew<vtkCellArray> newPolys;
+  vtkNew<vtkIdList> pointVertices;
+  vtkNew<vtkIdList> triangles;
+  this->MergeTriangles(
+    vertexKeys, vertexPoints, triangleKeys, bounds, newPts, newPolys, pointVertices, triangles);
+  const vtkIdType numNewPts = newPts->GetNumberOfPoints();
 
+  // The attributes of the points come from the intersections creating them.
   if (this->ComputeScalars)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(estimatedSize, estimatedSize / 2);
+    vtkNew<vtkFloatArray> newScalars;
+    newScalars->SetNumberOfTuples(numNewPts);
+    vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        const vtkIdType key = vertexKeys->GetValue(pointVertices->GetId(ptId));
+        newScalars->SetValue(ptId, static_cast<float>(values[key % numContours]));
+      }
+    });
+    int idx = output->GetPointData()->AddArray(newScalars);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
-  else
+  if (this->ComputeGradients || this->ComputeNormals)
   {
-    newScalars = nullptr;
-  }
-
-  using Dispatcher = vtkArrayDispatch::Dispatch;
-  ComputeGradientWorker worker;
-  if (!Dispatcher::Execute(inScalars, worker, this, dims, this->Locator, newScalars, newGradients,
-        newNormals, newPolys, values, numContours))
-  { // Fallback to slow path for unknown arrays:
-    worker(inScalars, this, dims, this->Locator, newScalars, newGradients, newNormals, newPolys,
-      values, numContours);
+    vtkSmartPointer<vtkFloatArray> newGradients;
+    if (this->ComputeGradients)
+    {
+      newGradients = vtkSmartPointer<vtkFloatArray>::New();
+      newGradients->SetNumberOfComponents(3);
+      newGradients->SetNumberOfTuples(numNewPts);
+      output->GetPointData()->SetVectors(newGradients);
+    }
+    vtkSmartPointer<vtkFloatArray> newNormals;
+    if (this->ComputeNormals)
+    {
+      newNormals = vtkSmartPointer<vtkFloatArray>::New();
+      newNormals->SetNumberOfComponents(3);
+      newNormals->SetNumberOfTuples(numNewPts);
+      output->GetPointData()->SetNormals(newNormals);
+    }
+    InterpolateGradientsWorker gradientsWorker;
+    if (!Dispatcher::Execute(inScalars, gradientsWorker, dims, values, numContours,
+          vertexKeys.Get(), pointVertices.Get(), newGradients.Get(), newNormals.Get()))
+    {
+      gradientsWorker(inScalars, dims, values, numContours, vertexKeys.Get(),
+        pointVertices.Get(), newGradients.Get(), newNormals.Get());
+    }
   }
 
   vtkDebugMacro(<< "Created: " << newPts->GetNumberOfPoints() << " points, "
                 << newPolys->GetNumberOfCells() << " triangles");
   //
-  // Update ourselves.  Because we don't know up front how many triangles
-  // we've created, take care to reclaim memory.
+  // Update ourselves.
   //
   output->SetPoints(newPts);
-  newPts->Delete();
-
   output->SetPolys(newPolys);
-  newPolys->Delete();
 
-  if (newScalars)
+  vtkImageTransform::TransformPointSet(input, output);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkMarchingCubes::MergeTriangles(vtkIdTypeArray* vertexKeys, vtkDoubleArray* vertexPoints,
+  vtkIdTypeArray* triangleKeys, const double bounds[6], vtkPoints* newPts, vtkCellArray* newPolys,
+  vtkIdList* pointVertices, vtkIdList* triangles)
+{
+  const vtkIdType numVerts = vertexKeys->GetNumberOfValues();
+  const vtkIdType numCorners = triangleKeys->GetNumberOfValues();
+  const vtkIdType numTris = numCorners / 3;
+
+  // Find the intersection at each corner of the triangles.
+  std::vector<vtkIdType> corners(numCorners);
   {
-    int idx = output->GetPointData()->AddArray(newScalars);
-    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newScalars->Delete();
+    std::vector<std::pair<vtkIdType, vtkIdType>> sortedKeys(numVerts);
+    vtkSMPTools::For(0, numVerts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType vertex = begin; vertex < end; ++vertex)
+      {
+        sortedKeys[vertex] = std::make_pair(vertexKeys->GetValue(vertex), vertex);
+      }
+    });
+    vtkSMPTools::Sort(sortedKeys.begin(), sortedKeys.end());
+    vtkSMPTools::For(0, numCorners, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType corner = begin; corner < end; ++corner)
+      {
+        const auto keyPair = std::make_pair(triangleKeys->GetValue(corner), vtkIdType(0));
+        corners[corner] =
+          std::lower_bound(sortedKeys.begin(), sortedKeys.end(), keyPair)->second;
+      }
+    });
   }
-  if (newGradients)
+
+  if (this->Locator == nullptr)
   {
-    output->GetPointData()->SetVectors(newGradients);
-    newGradients->Delete();
+    this->CreateDefaultLocator();
   }
-  if (newNormals)
-  {
-    output->GetPointData()->SetNormals(newNormals);
-    newNormals->Delete();
+  pointVertices->Reset();
+  if (this->Locator->IsA("vtkMergePoints"))
+  {
+    // vtkMergePoints merges the intersections whose coordinates are the same
+    // once stored in newPts, which is done here in parallel. Each group of
+    // coincident intersections is numbered by its first intersection.
+    vtkNew<vtkPoints> allPts;
+    allPts->SetDataType(newPts->GetDataType());
+    allPts->SetNumberOfPoints(numVerts);
+    vtkSMPTools::For(0, numVerts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType vertex = begin; vertex < end; ++vertex)
+      {
+        allPts->SetPoint(vertex, vertexPoints->GetPointer(3 * vertex));
+      }
+    });
+    std::vector<vtkIdType> mergeMap(numVerts);
+    if (numVerts > 0)
+    {
+      vtkNew<vtkPolyData> pointSet;
+      pointSet->SetPoints(allPts);
+      vtkNew<vtkStaticPointLocator> locator;
+      locator->SetDataSet(pointSet);
+      locator->BuildLocator();
+      locator->MergePoints(0.0, mergeMap.data());
+    }
+
+    std::unique_ptr<std::atomic<vtkIdType>[]> firstIds(new std::atomic<vtkIdType>[numVerts]);
+    vtkSMPTools::For(0, numVerts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType vertex = begin; vertex < end; ++vertex)
+      {
+        firstIds[vertex].store(VTK_ID_MAX, std::memory_order_relaxed);
+      }
+    });
+    vtkSMPTools::For(0, numVerts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType vertex = begin; vertex < end; ++vertex)
+      {
+        std::atomic<vtkIdType>& firstId = firstIds[mergeMap[vertex]];
+        vtkIdType current = firstId.load(std::memory_order_relaxed);
+        while (vertex < current && !firstId.compare_exchange_weak(current, vertex))
+        {
+        }
+      }
+    });
+    std::vector<vtkIdType> vertexMap(numVerts);
+    for (vtkIdType vertex = 0; vertex < numVerts; ++vertex)
+    {
+      if (firstIds[mergeMap[vertex]].load(std::memory_order_relaxed) == vertex)
+      {
+        vertexMap[vertex] = pointVertices->InsertNextId(vertex);
+      }
+    }
+    newPts->SetNumberOfPoints(pointVertices->GetNumberOfIds());
+    vtkSMPTools::For(0, numVerts, [&](vtkIdType begin, vtkIdType end) {
+      double x[3];
+      for (vtkIdType vertex = begin; vertex < end; ++vertex)
+      {
+        const vtkIdType firstId = firstIds[mergeMap[vertex]].load(std::memory_order_relaxed);
+        if (firstId == vertex)
+        {
+          allPts->GetPoint(vertex, x);
+          newPts->SetPoint(vertexMap[vertex], x);
+        }
+        else
+        {
+          vertexMap[vertex] = vertexMap[firstId];
+        }
+      }
+    });
+    vtkSMPTools::For(0, numCorners, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType corner = begin; corner < end; ++corner)
+      {
+        corners[corner] = vertexMap[corners[corner]];
+      }
+    });
   }
-  output->Squeeze();
-  if (this->Locator)
+  else
   {
+    // Other locators insert the corners one at a time, in traversal order.
+    const vtkIdType estimatedSize = std::max<vtkIdType>(numVerts / 1024 * 1024, 1024);
+    this->Locator->InitPointInsertion(newPts, bounds, estimatedSize);
+    for (vtkIdType corner = 0; corner < numCorners; ++corner)
+    {
+      const vtkIdType vertex = corners[corner];
+      if (this->Locator->InsertUniquePoint(vertexPoints->GetPointer(3 * vertex), corners[corner]))
+      {
+        pointVertices->InsertNextId(vertex);
+      }
+    }
     this->Locator->Initialize(); // free storage
   }
+  this->UpdateProgress(0.75);
 
-  vtkImageTransform::TransformPointSet(input, output);
-
-  return 1;
+  // Drop the degenerate triangles.
+  std::vector<vtkIdType> triMap(numTris + 1);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      const vtkIdType* ptIds = corners.data() + 3 * triId;
+      triMap[triId] = ptIds[0] != ptIds[1] && ptIds[0] != ptIds[2] && ptIds[1] != ptIds[2];
+    }
+  });
+  vtkIdType numNewTris = 0;
+  for (vtkIdType triId = 0; triId < numTris; ++triId)
+  {
+    const vtkIdType kept = triMap[triId];
+    triMap[triId] = numNewTris;
+    numNewTris += kept;
+  }
+  triMap[numTris] = numNewTris;
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewTris + 1);
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(3 * numNewTris);
+  triangles->SetNumberOfIds(numNewTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      const vtkIdType newTriId = triMap[triId];
+      if (triMap[triId + 1] != newTriId)
+      {
+        offsets->SetValue(newTriId, 3 * newTriId);
+        for (int i = 0; i < 3; ++i)
+        {
+          conn->SetValue(3 * newTriId + i, corners[3 * triId + i]);
+        }
+        triangles->SetId(newTriId, triId);
+      }
+    }
+  });
+  offsets->SetValue(numNewTris, 3 * numNewTris);
+  newPolys->SetData(offsets, conn);
 }
 
 // Description:
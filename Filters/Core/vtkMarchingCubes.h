@@ -10,6 +10,13 @@
  * Alternatively, you can specify a min/max scalar range and the number of
  * contours to generate a series of evenly spaced contour values.
  *
+ * The layers of voxels are processed in parallel with vtkSMPTools. Each
+ * intersection of a contour with a voxel edge is created once, by the first
+ * voxel using it, and the coincident points are then merged in traversal
+ * order, so the output does not depend on the number of threads. With a
+ * locator other than vtkMergePoints, the points are merged serially by the
+ * locator.
+ *
  * @warning
  * This filter is specialized to volumes. If you are interested in
  * contouring other types of data, use the general vtkContourFilter. If you
@@ -41,7 +48,12 @@
 #include "vtkContourValues.h" // Needed for direct access to ContourValues
 
 VTK_ABI_NAMESPACE_BEGIN
+class vtkCellArray;
+class vtkDoubleArray;
+class vtkIdList;
+class vtkIdTypeArray;
 class vtkIncrementalPointLocator;
+class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkMarchingCubes : public vtkPolyDataAlgorithm
 {
@@ -120,6 +132,21 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
+  /**
+   * Merge the intersections of the contours with the voxel edges into newPts
+   * and build the output triangles, dropping the degenerate ones. vertexKeys
+   * identifies the intersections in the order the voxel traversal creates them
+   * and vertexPoints holds their coordinates. triangleKeys gives the three
+   * intersections of each triangle, in traversal order. When the locator is a
+   * vtkMergePoints, coincident intersections are merged in parallel; other
+   * locators insert the corners of the triangles one at a time. On return,
+   * pointVertices holds the intersection each output point comes from, and
+   * triangles the triangle each output cell comes from.
+   */
+  void MergeTriangles(vtkIdTypeArray* vertexKeys, vtkDoubleArray* vertexPoints,
+    vtkIdTypeArray* triangleKeys, const double bounds[6], vtkPoints* newPts,
+    vtkCellArray* newPolys, vtkIdList* pointVertices, vtkIdList* triangles);
+
   vtkContourValues* ContourValues;
   vtkTypeBool ComputeNormals;
   vtkTypeBool ComputeGradients;
@@ -3,9 +3,11 @@
 
 #include "vtkMaskPoints.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkBoundingBox.h"
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -15,11 +17,15 @@
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkReservoirSampler.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <random>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
@@ -215,6 +221,48 @@ double GetNearestPointRadius(double bounds[3], vtkIdType maximumNumberOfPoints)
   }
 }
 
+//------------------------------------------------------------------------------
+// For CHUNKED_RESERVOIR_SAMPLING only,
+// Number of input points per chunk. The chunks do not depend on the number of
+// threads, so that the sample is reproducible.
+constexpr vtkIdType ReservoirChunkSize = 65536;
+
+//------------------------------------------------------------------------------
+// For CHUNKED_RESERVOIR_SAMPLING only,
+// Seed of the sampler of a chunk, derived from the user seed and the chunk.
+vtkReservoirSamplerBase::SeedType GetChunkSeed(int seed, vtkIdType chunk)
+{
+  const unsigned long long chunkBits = static_cast<unsigned long long>(chunk);
+  std::seed_seq sequence{ static_cast<unsigned int>(seed), static_cast<unsigned int>(chunkBits),
+    static_cast<unsigned int>(chunkBits >> 32) };
+  vtkReservoirSamplerBase::SeedType chunkSeed;
+  sequence.generate(&chunkSeed, &chunkSeed + 1);
+  return chunkSeed;
+}
+
+//------------------------------------------------------------------------------
+// Copy the masked points and their attributes in parallel. The functor gives
+// the input id of each output point.
+template <typename InputIdT>
+void CopyPoints(vtkDataSet* input, vtkPointData* inPD, vtkPoints* outPts, vtkPointData* outPD,
+  vtkIdType numOutPts, InputIdT inputId)
+{
+  outPts->SetNumberOfPoints(numOutPts);
+  ArrayList arrays;
+  arrays.AddArrays(numOutPts, inPD, outPD, 0.0, false);
+
+  vtkSMPTools::For(0, numOutPts, [&](vtkIdType outId, vtkIdType endOutId) {
+    double x[3];
+    for (; outId < endOutId; ++outId)
+    {
+      const vtkIdType ptId = inputId(outId);
+      input->GetPoint(ptId, x);
+      outPts->SetPoint(outId, x);
+      arrays.Copy(ptId, outId);
+    }
+  });
+}
+
 }
 
 //------------------------------------------------------------------------------
@@ -354,7 +402,6 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkPointData* pd = input->GetPointData();
   vtkIdType numNewPts;
-  double x[3];
   vtkIdType id = 0;
   vtkPointData* outputPD = output->GetPointData();
   vtkIdType numPts = input->GetNumberOfPoints();
@@ -416,11 +463,15 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numNewPts);
   // Mask points preserves all attributes of the points, so copy all of them.
   outputPD->CopyAllOn();
   outputPD->CopyAllocate(pd, numNewPts);
 
+  // The sampling modes select the ids of the input points in output order,
+  // then the points and their attributes are copied in parallel.
+  std::vector<vtkIdType> ptIds;
+  vtkIdType numSelectedPts = 0;
+
   // stride size
   vtkIdType progressInterval = numPts / 20 + 1;
   // Traverse points and copy
@@ -445,9 +496,8 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
         for (vtkIdType ptId = this->Offset; (ptId < numPts) && (id < localMaxPts) && !abort;
              ptId += (1 + static_cast<int>(static_cast<double>(vtkMath::Random()) * cap)))
         {
-          input->GetPoint(ptId, x);
-          id = newPts->InsertNextPoint(x);
-          outputPD->CopyData(pd, ptId, id);
+          ptIds.push_back(ptId);
+          id = static_cast<vtkIdType>(ptIds.size()) - 1;
           if (!(id % progressInterval)) // abort/progress
           {
             this->UpdateProgress(0.5 * id / numPts);
@@ -465,6 +515,7 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
         vtkIdType size = numPts;
         vtkIdType samplesize = localMaxPts;
         vtkIdType q1 = size - samplesize + 1;
+        ptIds.reserve(localMaxPts);
 
         while (samplesize > 1)
         {
@@ -526,9 +577,7 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
 
           // add a point
           ptId = ptId + s + 1;
-          input->GetPoint(ptId, x);
-          id = newPts->InsertNextPoint(x);
-          outputPD->CopyData(pd, ptId, id);
+          ptIds.push_back(ptId);
 
           size = size - s - 1;
           samplesize = samplesize - 1;
@@ -537,50 +586,22 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
 
         // add last point
         ptId = ptId + (vtkIdType)(d_rand() * size) + 1;
-        input->GetPoint(ptId, x);
-        id = newPts->InsertNextPoint(x);
-        outputPD->CopyData(pd, ptId, id);
+        ptIds.push_back(ptId);
         break;
       }
       case SPATIALLY_STRATIFIED:
       {
         // need to copy the entire data to sort it, to leave original intact
-        vtkPoints* pointCopy = vtkPoints::New();
-
-        // Set the desired precision for the points.
-        if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-        {
-          vtkPointSet* inputPointSet = vtkPointSet::SafeDownCast(input);
-          if (inputPointSet)
-          {
-            pointCopy->SetDataType(inputPointSet->GetPoints()->GetDataType());
-          }
-          else
-          {
-            pointCopy->SetDataType(VTK_FLOAT);
-          }
-        }
-        else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-        {
-          pointCopy->SetDataType(VTK_FLOAT);
-        }
-        else if (this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-        {
-          pointCopy->SetDataType(VTK_DOUBLE);
-        }
-
-        vtkPointData* dataCopy = vtkPointData::New();
+        vtkNew<vtkPolyData> copy;
+        vtkNew<vtkPoints> pointCopy;
+        pointCopy->SetDataType(newPts->GetDataType());
+        copy->SetPoints(pointCopy);
+        vtkPointData* dataCopy = copy->GetPointData();
         vtkPointData* tempData = vtkPointData::New();
 
-        pointCopy->Allocate(numPts);
         dataCopy->CopyAllOn();
         dataCopy->CopyAllocate(pd, numPts);
-        for (vtkIdType i = 0; i < numPts; i = i + 1)
-        {
-          input->GetPoint(i, x);
-          id = pointCopy->InsertNextPoint(x);
-          dataCopy->CopyData(pd, i, id);
-        }
+        ::CopyPoints(input, pd, pointCopy, dataCopy, numPts, [](vtkIdType i) { return i; });
         tempData->CopyAllOn();
         tempData->CopyAllocate(dataCopy, 1);
 
@@ -588,16 +609,10 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
         SortAndSample(pointCopy, dataCopy, tempData, 0, numPts, numNewPts, 0);
 
         // copy the results back
-        for (vtkIdType i = 0; i < numNewPts; i++)
-        {
-          pointCopy->GetPoint(i, x);
-          id = newPts->InsertNextPoint(x);
-          outputPD->CopyData(dataCopy, i, id);
-        }
+        ::CopyPoints(copy, dataCopy, newPts, outputPD, numNewPts, [](vtkIdType i) { return i; });
+        numSelectedPts = numNewPts;
 
         tempData->Delete();
-        dataCopy->Delete();
-        pointCopy->Delete();
         this->CheckAbort();
         break;
       }
@@ -646,9 +661,7 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
             pointLocator->FindClosestPointWithinRadius(nearestPointRadius, pos, dist2);
           if (ptId >= 0)
           {
-            input->GetPoint(ptId, x);
-            id = newPts->InsertNextPoint(x);
-            outputPD->CopyData(pd, ptId, id);
+            ptIds.push_back(ptId);
           }
         }
         break;
@@ -732,9 +745,7 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
               const vtkIdType randPtId = idList->GetId(i);
               if (!maskedPoints[randPtId])
               {
-                input->GetPoint(randPtId, x);
-                id = newPts->InsertNextPoint(x);
-                outputPD->CopyData(pd, ptId, id);
+                ptIds.push_back(randPtId);
                 maskedPoints[randPtId] = true;
                 break;
               }
@@ -747,6 +758,55 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
         }
         break;
       }
+      case CHUNKED_RESERVOIR_SAMPLING:
+      {
+        // Each chunk of points gets its share of the sample, rounded down
+        // at the chunk boundaries so that the shares add up to the sample size.
+        const vtkIdType numChunks = (numPts - 1) / ReservoirChunkSize + 1;
+        std::vector<vtkIdType> sampleOffsets(numChunks + 1, 0);
+        vtkIdType quotient = 0;
+        vtkIdType remainder = 0;
+        for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+        {
+          const vtkIdType chunkSize =
+            std::min(ReservoirChunkSize, numPts - chunk * ReservoirChunkSize);
+          remainder += localMaxPts * chunkSize;
+          quotient += remainder / numPts;
+          remainder %= numPts;
+          sampleOffsets[chunk + 1] = quotient;
+        }
+
+        // Sample the chunks in parallel, each with its own seeded sampler.
+        ptIds.resize(localMaxPts);
+        const int seed = this->RandomSeed;
+        vtkReservoirSampler<vtkIdType> sampler;
+        vtkSMPTools::For(0, numChunks, [&](vtkIdType chunk, vtkIdType endChunk) {
+          bool isFirst = vtkSMPTools::GetSingleThread();
+          for (; chunk < endChunk; ++chunk)
+          {
+            if (isFirst)
+            {
+              this->CheckAbort();
+            }
+            if (this->GetAbortOutput())
+            {
+              break;
+            }
+            const vtkIdType chunkStart = chunk * ReservoirChunkSize;
+            const vtkIdType chunkSize = std::min(ReservoirChunkSize, numPts - chunkStart);
+            const std::vector<vtkIdType>& sample =
+              sampler(sampleOffsets[chunk + 1] - sampleOffsets[chunk], chunkSize,
+                ::GetChunkSeed(seed, chunk));
+            vtkIdType* chunkIds = ptIds.data() + sampleOffsets[chunk];
+            for (vtkIdType ptId : sample)
+            {
+              *chunkIds++ = chunkStart + ptId;
+            }
+          }
+        });
+        abort = this->GetAbortOutput();
+        break;
+      }
       default:
         vtkWarningMacro("Unsupported random mode type.");
         break;
@@ -754,48 +814,49 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
   }
   else // striding mode
   {
-    for (vtkIdType ptId = this->Offset; (ptId < numPts) && (id < localMaxPts) && !abort;
-         ptId += this->OnRatio)
+    // The stride loop stops once more than localMaxPts points are masked.
+    if (this->Offset < numPts)
     {
-      input->GetPoint(ptId, x);
-      id = newPts->InsertNextPoint(x);
-      outputPD->CopyData(pd, ptId, id);
-      if (!(id % progressInterval)) // abort/progress
-      {
-        this->UpdateProgress(0.5 * id / numPts);
-        abort = this->CheckAbort();
-      }
+      numSelectedPts = std::min((numPts - this->Offset - 1) / this->OnRatio + 1, localMaxPts + 1);
+      const vtkIdType offset = this->Offset;
+      const vtkIdType onRatio = this->OnRatio;
+      ::CopyPoints(input, pd, newPts, outputPD, numSelectedPts,
+        [offset, onRatio](vtkIdType i) { return offset + i * onRatio; });
     }
   }
 
+  // Copy the points selected by their ids
+  if (!ptIds.empty())
+  {
+    numSelectedPts = static_cast<vtkIdType>(ptIds.size());
+    ::CopyPoints(
+      input, pd, newPts, outputPD, numSelectedPts, [&ptIds](vtkIdType i) { return ptIds[i]; });
+  }
+  this->UpdateProgress(0.5);
+  abort = abort || this->CheckAbort();
+
   // Generate vertices if requested
-  if (this->GenerateVertices)
+  if (this->GenerateVertices && !abort)
   {
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(numSelectedPts);
+    vtkSMPTools::For(0, numSelectedPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        connectivity->SetValue(ptId, ptId);
+      }
+    });
     vtkNew<vtkCellArray> verts;
     if (this->SingleVertexPerCell)
     {
-      verts->AllocateEstimate(id, 1);
+      verts->SetData(1, connectivity);
     }
     else
     {
-      verts->AllocateEstimate(1, id + 1);
-      verts->InsertNextCell(id + 1);
-    }
-    for (vtkIdType ptId = 0; ptId < (id + 1) && !abort; ptId++)
-    {
-      if (!(ptId % progressInterval)) // abort/progress
-      {
-        this->UpdateProgress(0.5 + 0.5 * ptId / (id + 1));
-        abort = this->CheckAbort();
-      }
-      if (this->SingleVertexPerCell)
-      {
-        verts->InsertNextCell(1, &ptId);
-      }
-      else
-      {
-        verts->InsertCellPoint(ptId);
-      }
+      vtkNew<vtkIdTypeArray> offsets;
+      offsets->InsertNextValue(0);
+      offsets->InsertNextValue(numSelectedPts);
+      verts->SetData(offsets, connectivity);
     }
     output->SetVerts(verts);
   }
@@ -805,7 +866,7 @@ int vtkMaskPoints::RequestData(vtkInformation* vtkNotUsed(request),
 
   output->Squeeze();
 
-  vtkDebugMacro(<< "Masked " << numPts << " original points to " << id + 1 << " points");
+  vtkDebugMacro(<< "Masked " << numPts << " original points to " << numSelectedPts << " points");
 
   this->InternalResetController();
 
@@ -14,6 +14,12 @@
  * The filter can also generate vertices (topological
  * primitives) as well as points. This is useful because vertices are
  * rendered while points are not.
+ *
+ * Once the points to pass through are selected, they are copied to the
+ * output with their attributes in parallel with vtkSMPTools, as well as the
+ * vertices. The chunked reservoir sampling mode also selects the points in
+ * parallel, and its sample depends on the random seed only, not on the
+ * number of threads.
  */
 
 #ifndef vtkMaskPoints_h
@@ -34,7 +40,8 @@ public:
     SPATIALLY_STRATIFIED,
     UNIFORM_SPATIAL_BOUNDS,
     UNIFORM_SPATIAL_SURFACE,
-    UNIFORM_SPATIAL_VOLUME
+    UNIFORM_SPATIAL_VOLUME,
+    CHUNKED_RESERVOIR_SAMPLING
   };
 
   static vtkMaskPoints* New();
@@ -77,8 +84,8 @@ public:
 
   ///@{
   /**
-   * Set/Get Seed used for generating a spatially uniform distributions.
-   * default is 1.
+   * Set/Get Seed used for generating a spatially uniform distributions
+   * and the chunked reservoir sampling. default is 1.
    */
   vtkSetMacro(RandomSeed, int);
   vtkGetMacro(RandomSeed, int);
@@ -114,8 +121,14 @@ public:
    * 5 - spatially uniform (volume based): points randomly sampled via an
    * inverse transform on volume area of each cell.
    * Note that 2D cells are ignored.
+   * 6 - chunked reservoir sampling: the point ids are split in fixed chunks,
+   * each chunk gets its share of the sample, rounded at the chunk boundaries,
+   * and is sampled in parallel with vtkReservoirSampler seeded from
+   * RandomSeed and the chunk index. The sample is reproducible, and the
+   * selected points keep the order of the input points.
+   * (OnRatio and Offset are ignored) O(N / chunk size + sample size)
    */
-  vtkSetClampMacro(RandomModeType, int, RANDOMIZED_ID_STRIDES, UNIFORM_SPATIAL_VOLUME);
+  vtkSetClampMacro(RandomModeType, int, RANDOMIZED_ID_STRIDES, CHUNKED_RESERVOIR_SAMPLING);
   vtkGetMacro(RandomModeType, int);
   ///@}
 
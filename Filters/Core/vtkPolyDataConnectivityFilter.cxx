@@ -5,6 +5,7 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
@@ -14,8 +15,10 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
@@ -47,6 +50,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->LabelingMode = WAVE_PROPAGATION;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -122,7 +126,10 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (this->LabelingMode == WAVE_PROPAGATION)
+  {
+    this->Mesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -174,7 +181,12 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   this->PointIds->Allocate(8, VTK_CELL_SIZE);
   vtkIdType checkAbortInterval = 0;
 
-  if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
+  if (this->LabelingMode == UNION_FIND)
+  {
+    largestRegionId = this->LabelRegionsInParallel();
+    this->UpdateProgress(0.9);
+  }
+  else if (this->ExtractionMode != VTK_EXTRACT_POINT_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
@@ -306,6 +318,8 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // if coloring regions; send down new scalar data
   if (this->ColorRegions)
   {
+    // Only the extracted points have a region id
+    this->NewScalars->SetNumberOfTuples(this->PointNumber);
     int idx = outputPD->AddArray(this->NewScalars);
     outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
@@ -532,6 +546,140 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+//------------------------------------------------------------------------------
+// Label all the regions at once with a parallel union-find, or only the region
+// grown from the seeds if regions are seeded.
+vtkIdType vtkPolyDataConnectivityFilter::LabelRegionsInParallel()
+{
+  vtkPolyData* mesh = this->Mesh;
+  const vtkIdType numPts = mesh->GetNumberOfPoints();
+  const vtkIdType numCells = mesh->GetNumberOfCells();
+
+  // Make sure the cells are built before accessing them from several threads
+  if (mesh->NeedToBuildCells())
+  {
+    mesh->BuildCells();
+  }
+  auto cellPoints = [mesh](vtkIdType cellId, vtkIdList* ptIds) {
+    mesh->GetCellPoints(cellId, ptIds);
+  };
+  vtkDataArray* inScalars = this->InScalars;
+  auto connectable = [this, inScalars](vtkIdType, vtkIdList* ptIds) {
+    if (!inScalars)
+    {
+      return true;
+    }
+    double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); i++)
+    {
+      const double s = inScalars->GetComponent(ptIds->GetId(i), 0);
+      range[0] = std::min(range[0], s);
+      range[1] = std::max(range[1], s);
+    }
+    if (this->FullScalarConnectivity)
+    {
+      return range[0] >= this->ScalarRange[0] && range[1] <= this->ScalarRange[1];
+    }
+    return range[1] >= this->ScalarRange[0] && range[0] <= this->ScalarRange[1];
+  };
+
+  vtkIdType largestRegionId = 0;
+  if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    // Gather the seed cells
+    std::vector<char> seedCells(numCells, 0);
+    if (this->ExtractionMode == VTK_EXTRACT_CELL_SEEDED_REGIONS)
+    {
+      for (vtkIdType i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+      {
+        const vtkIdType seedId = this->Seeds->GetId(i);
+        if (seedId >= 0 && seedId < numCells)
+        {
+          seedCells[seedId] = 1;
+        }
+      }
+    }
+    else
+    {
+      std::vector<char> seedPoints(numPts, 0);
+      if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS)
+      {
+        for (vtkIdType i = 0; i < this->Seeds->GetNumberOfIds(); i++)
+        {
+          const vtkIdType seedId = this->Seeds->GetId(i);
+          if (seedId >= 0 && seedId < numPts)
+          {
+            seedPoints[seedId] = 1;
+          }
+        }
+      }
+      else
+      {
+        double minDist2 = VTK_DOUBLE_MAX, x[3];
+        vtkIdType minId = 0;
+        for (vtkIdType i = 0; i < numPts; i++)
+        {
+          mesh->GetPoint(i, x);
+          const double dist2 = vtkMath::Distance2BetweenPoints(x, this->ClosestPoint);
+          if (dist2 < minDist2)
+          {
+            minId = i;
+            minDist2 = dist2;
+          }
+        }
+        seedPoints[minId] = 1;
+      }
+
+      ::MarkCellsUsingPoints(numCells, cellPoints, seedPoints, seedCells);
+    }
+
+    // Everything connected to the seeds is in the same region
+    const vtkIdType numCellsInRegion = ::LabelSeededRegion(
+      numPts, numCells, cellPoints, connectable, seedCells, this->Visited);
+    this->RegionNumber = 0;
+    this->RegionSizes->InsertValue(0, numCellsInRegion);
+  }
+  else
+  {
+    std::vector<vtkIdType> regionSizes;
+    const vtkIdType numRegions = ::LabelConnectedRegions(
+      numPts, numCells, cellPoints, connectable, this->Visited, regionSizes);
+    vtkIdType maxCellsInRegion = 0;
+    this->RegionSizes->SetNumberOfValues(numRegions);
+    for (vtkIdType regionId = 0; regionId < numRegions; regionId++)
+    {
+      this->RegionSizes->SetValue(regionId, regionSizes[regionId]);
+      if (regionSizes[regionId] > maxCellsInRegion)
+      {
+        maxCellsInRegion = regionSizes[regionId];
+        largestRegionId = regionId;
+      }
+    }
+    this->RegionNumber = numRegions;
+  }
+
+  // Points used by the labeled cells are kept in their input order. A point
+  // shared by several regions is given the lowest one.
+  std::vector<vtkIdType> pointRegions(numPts);
+  ::ComputePointRegions(numPts, numCells, cellPoints, this->Visited, pointRegions.data());
+  std::copy(pointRegions.begin(), pointRegions.end(), this->PointMap);
+  this->PointNumber = ::NumberNonNegativeIds(numPts, this->PointMap);
+  vtkIdTypeArray* newScalars = vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      if (this->PointMap[ptId] >= 0)
+      {
+        newScalars->SetValue(this->PointMap[ptId], pointRegions[ptId]);
+      }
+    }
+  });
+
+  return largestRegionId;
+}
+
 //------------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -675,5 +823,7 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Labeling Mode: "
+     << (this->LabelingMode == UNION_FIND ? "UNION_FIND" : "WAVE_PROPAGATION") << "\n";
 }
 VTK_ABI_NAMESPACE_END
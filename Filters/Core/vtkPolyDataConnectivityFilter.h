@@ -216,6 +216,33 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  /**
+   * Enumeration of the algorithms labeling the connected regions.
+   */
+  enum LabelingModes
+  {
+    WAVE_PROPAGATION,
+    UNION_FIND
+  };
+
+  ///@{
+  /**
+   * Set/get the algorithm labeling the connected regions. WAVE_PROPAGATION
+   * (the default) grows each region from a seed cell serially using the
+   * point to cell links. UNION_FIND joins the points of the cells in
+   * parallel with a lock-free union-find and does not build the links. Both
+   * find the same regions, with the same sizes and ids, including with
+   * ScalarConnectivity on, where a cell that is not scalar connected is never
+   * reached from its neighbors but still seeds a region grown to its scalar
+   * connected neighbors. With UNION_FIND, the output points keep their input
+   * order instead of the traversal order.
+   */
+  vtkSetClampMacro(LabelingMode, int, WAVE_PROPAGATION, UNION_FIND);
+  vtkGetMacro(LabelingMode, int);
+  void SetLabelingModeToWavePropagation() { this->SetLabelingMode(WAVE_PROPAGATION); }
+  void SetLabelingModeToUnionFind() { this->SetLabelingMode(UNION_FIND); }
+  ///@}
+
 protected:
   vtkPolyDataConnectivityFilter();
   ~vtkPolyDataConnectivityFilter() override;
@@ -241,6 +268,10 @@ protected:
 
   void TraverseAndMark();
 
+  // Label the regions with a parallel union-find, filling the same
+  // execution data as TraverseAndMark. Returns the largest region id.
+  vtkIdType LabelRegionsInParallel();
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -260,6 +291,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  int LabelingMode;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
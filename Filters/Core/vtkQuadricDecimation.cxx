@@ -41,8 +41,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkQuadricDecimation);
 
@@ -264,6 +271,11 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->Mesh->SetPoints(points);
   points->Delete();
   polys->DeepCopy(input->GetPolys());
+  if (this->ParallelCollapses && !polys->IsStorageShareable())
+  {
+    // The concurrent collapses read the cells without a buffer per thread.
+    polys->ConvertToDefaultStorage();
+  }
   this->Mesh->SetPolys(polys);
   polys->Delete();
   if (this->AttributeErrorMetric || this->MapPointData)
@@ -337,73 +349,104 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   this->UpdateProgress(0.15);
 
   vtkDebugMacro(<< "Computing Costs");
-  // Compute the cost of and target point for collapsing each edge.
-  for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
-  {
-    if (this->AttributeErrorMetric)
+  // Compute the cost of and target point for collapsing each edge in
+  // parallel, then fill the priority queue in edge order.
+  const vtkIdType numEdges = this->Edges->GetNumberOfEdges();
+  const int dimension = 3 + this->NumberOfComponents + this->VolumePreservation;
+  std::vector<double> edgeCosts(numEdges);
+  this->TargetPoints->SetNumberOfTuples(numEdges);
+  vtkSMPThreadLocal<std::vector<double>> localWork;
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType begin, vtkIdType end) {
+    // target point, quadric, right hand side and matrix
+    std::vector<double>& work = localWork.Local();
+    work.resize(dimension + (11 + 4 * this->NumberOfComponents + this->VolumePreservation) +
+      dimension + dimension * dimension);
+    double* target = work.data();
+    double* tempQuad = target + dimension;
+    double* tempB = tempQuad + 11 + 4 * this->NumberOfComponents + this->VolumePreservation;
+    std::vector<double*> tempA(dimension);
+    for (int row = 0; row < dimension; row++)
     {
-      cost = this->ComputeCost2(i, x);
+      tempA[row] = tempB + dimension + row * dimension;
     }
-    else
+
+    for (vtkIdType edge = begin; edge < end; edge++)
     {
-      cost = this->ComputeCost(i, x);
+      if (this->AttributeErrorMetric)
+      {
+        edgeCosts[edge] = this->ComputeCost2(edge, target, tempQuad, tempB, tempA.data());
+      }
+      else
+      {
+        edgeCosts[edge] = this->ComputeCost(edge, target, tempQuad);
+      }
+      this->TargetPoints->SetTypedTuple(edge, target);
     }
-    this->EdgeCosts->Insert(cost, i);
-    this->TargetPoints->InsertTuple(i, x);
+  });
+  for (i = 0; i < numEdges; i++)
+  {
+    this->EdgeCosts->Insert(edgeCosts[i], i);
   }
   this->UpdateProgress(0.20);
 
   // Okay collapse edges until desired reduction is reached
   this->ActualReduction = 0.0;
   this->NumberOfEdgeCollapses = 0;
-  edgeId = this->EdgeCosts->Pop(0, cost);
-
-  bool abort = false;
-  while (
-    !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX && this->ActualReduction < this->TargetReduction)
+  if (this->ParallelCollapses)
+  {
+    numDeletedTris = this->CollapseEdgesInParallel(numTris);
+  }
+  else
   {
-    if (!(this->NumberOfEdgeCollapses % 10000))
+    edgeId = this->EdgeCosts->Pop(0, cost);
+
+    bool abort = false;
+    while (!abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
+      this->ActualReduction < this->TargetReduction)
     {
-      vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
-      this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
-      abort = this->CheckAbort();
-    }
+      if (!(this->NumberOfEdgeCollapses % 10000))
+      {
+        vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
+        this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
+        abort = this->CheckAbort();
+      }
 
-    endPtIds[0] = this->EndPoint1List->GetId(edgeId);
-    endPtIds[1] = this->EndPoint2List->GetId(edgeId);
-    this->TargetPoints->GetTuple(edgeId, x);
+      endPtIds[0] = this->EndPoint1List->GetId(edgeId);
+      endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+      this->TargetPoints->GetTuple(edgeId, x);
 
-    // check for a poorly placed point
-    if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
-    {
-      vtkDebugMacro(<< "Poor placement detected " << edgeId << " " << cost);
-      // return the point to the queue but with the max cost so that
-      // when it is recomputed it will be reconsidered
-      this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
+      // check for a poorly placed point
+      if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+      {
+        vtkDebugMacro(<< "Poor placement detected " << edgeId << " " << cost);
+        // return the point to the queue but with the max cost so that
+        // when it is recomputed it will be reconsidered
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
 
-      edgeId = this->EdgeCosts->Pop(0, cost);
-      continue;
-    }
+        edgeId = this->EdgeCosts->Pop(0, cost);
+        continue;
+      }
 
-    this->NumberOfEdgeCollapses++;
+      this->NumberOfEdgeCollapses++;
 
-    // Set the new coordinates of point0.
-    this->SetPointAttributeArray(endPtIds, x);
-    vtkDebugMacro(<< "Cost: " << cost << " Edge: " << endPtIds[0] << " " << endPtIds[1]);
+      // Set the new coordinates of point0.
+      this->SetPointAttributeArray(endPtIds, x);
+      vtkDebugMacro(<< "Cost: " << cost << " Edge: " << endPtIds[0] << " " << endPtIds[1]);
 
-    // Merge the quadrics of the two points.
-    this->AddQuadric(endPtIds[1], endPtIds[0]);
+      // Merge the quadrics of the two points.
+      this->AddQuadric(endPtIds[1], endPtIds[0]);
 
-    this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+      this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
 
-    // Update the output triangles.
-    numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
-    this->ActualReduction = (double)numDeletedTris / numTris;
-    edgeId = this->EdgeCosts->Pop(0, cost);
-  }
+      // Update the output triangles.
+      numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
+      this->ActualReduction = (double)numDeletedTris / numTris;
+      edgeId = this->EdgeCosts->Pop(0, cost);
+    }
 
-  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
-                << " Cost: " << cost);
+    vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses
+                  << " Cost: " << cost);
+  }
 
   // clean up working data
   for (i = 0; i < numPts; i++)
@@ -460,22 +503,9 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
   vtkPolyData* input = this->Mesh;
-  double* QEM;
-  vtkIdType ptId;
-  int i, j;
-  vtkCellArray* polys;
-  vtkIdType npts;
-  const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
-  double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
+  const int quadricSize = 11 + 4 * this->NumberOfComponents;
+  // the QEM of a face, followed by its volume constraint values if needed
+  const int faceQuadricSize = quadricSize + (this->VolumePreservation ? 4 : 0);
 
   double regularizationVariance = 0.0;
   if (this->Regularize)
@@ -483,23 +513,22 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
     regularizationVariance = std::pow(this->Regularization, 2);
   }
 
-  // allocate local QEM sparse matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
-
-  // clear and allocate global QEM array
-  for (ptId = 0; ptId < numPts; ptId++)
-  {
-    this->ErrorQuadrics[ptId].Quadric = new double[11 + 4 * this->NumberOfComponents];
-    for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
-    {
-      this->ErrorQuadrics[ptId].Quadric[i] = 0.0;
-    }
-  }
+  // Compute the QEM of a face weighted by half its area into QEM, followed by
+  // the volume constraint values g_vol and d_vol of the face.
+  auto computeFaceQuadric = [this, input, regularizationVariance, quadricSize](
+                              const vtkIdType* pts, double* QEM) {
+    double point0[3], point1[3], point2[3];
+    double n[3], d;
+    double tempP1[3], tempP2[3], triArea2;
+    double data[16];
+    double *A[4], x[4];
+    int index[4];
+    int i;
+    A[0] = data;
+    A[1] = data + 4;
+    A[2] = data + 8;
+    A[3] = data + 12;
 
-  polys = input->GetPolys();
-  // compute the QEM for each face
-  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
-  {
     input->GetPoint(pts[0], point0);
     input->GetPoint(pts[1], point1);
     input->GetPoint(pts[2], point2);
@@ -653,31 +682,105 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
       }
     }
 
-    // add the QEM to all points of the face
-    for (i = 0; i < 3; i++)
+    for (i = 0; i < quadricSize; i++)
+    {
+      QEM[i] *= triArea2;
+    }
+
+    if (this->VolumePreservation)
+    {
+      // Vector g_vol
+      for (i = 0; i < 3; i++)
+      {
+        QEM[quadricSize + i] = n[i] * triArea2 * 2.0; // triangle normal with length triArea * 2
+      }
+      // Scalar d_vol
+      QEM[quadricSize + 3] =
+        -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
+    }
+  };
+
+  // Add the weighted QEM and the volume constraint values of a face to one of
+  // its points.
+  auto addFaceQuadric = [this, quadricSize](vtkIdType ptId, const double* QEM) {
+    int j;
+    for (j = 0; j < quadricSize; j++)
+    {
+      this->ErrorQuadrics[ptId].Quadric[j] += QEM[j];
+    }
+
+    if (this->VolumePreservation)
     {
-      for (j = 0; j < 11 + 4 * this->NumberOfComponents; j++)
+      for (j = 0; j < 4; j++)
       {
-        this->ErrorQuadrics[pts[i]].Quadric[j] += QEM[j] * triArea2;
+        this->VolumeConstraints[ptId * 4 + j] += QEM[quadricSize + j];
       }
+    }
+  };
 
-      // Set volume constraint values g_vol and d_vol
-      if (this->VolumePreservation)
+  if (vtkSMPTools::GetEstimatedNumberOfThreads() > 1)
+  {
+    // Compute the QEM of each face once, then gather the QEM of the faces
+    // using each point in the order of the cell links. They list the faces by
+    // increasing ids, so the sums are performed in the same order as the
+    // serial scatter below and the result does not depend on the number of
+    // threads.
+    const vtkIdType numFaces = input->GetNumberOfCells();
+    std::vector<double> faceQuadrics(numFaces * faceQuadricSize);
+    vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+    vtkSMPTools::For(0, numFaces, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = localPtIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType faceId = begin; faceId < end; faceId++)
       {
-        // Vector g_vol
-        for (j = 0; j < 3; j++)
+        input->GetCellPoints(faceId, npts, pts, ptIds);
+        computeFaceQuadric(pts, faceQuadrics.data() + faceId * faceQuadricSize);
+      }
+    });
+
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType ncells;
+      vtkIdType* cells;
+      for (vtkIdType ptId = begin; ptId < end; ptId++)
+      {
+        this->ErrorQuadrics[ptId].Quadric = new double[quadricSize];
+        std::fill_n(this->ErrorQuadrics[ptId].Quadric, quadricSize, 0.0);
+
+        input->GetPointCells(ptId, ncells, cells);
+        for (vtkIdType i = 0; i < ncells; i++)
         {
-          this->VolumeConstraints[pts[i] * 4 + j] +=
-            n[j] * triArea2 * 2.0; // triangle normal with length triArea * 2
+          addFaceQuadric(ptId, faceQuadrics.data() + cells[i] * faceQuadricSize);
         }
-        // Scalar d_vol
-        this->VolumeConstraints[pts[i] * 4 + 3] +=
-          -d * triArea2 * 2.0; // (triangle normal with length triArea * 2) * (pts[0] position)
       }
+    });
+    return;
+  }
+
+  // allocate local QEM sparse matrix
+  std::vector<double> QEM(faceQuadricSize);
+
+  // clear and allocate global QEM array
+  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
+  {
+    this->ErrorQuadrics[ptId].Quadric = new double[quadricSize];
+    std::fill_n(this->ErrorQuadrics[ptId].Quadric, quadricSize, 0.0);
+  }
+
+  // compute the QEM for each face
+  vtkCellArray* polys = input->GetPolys();
+  vtkIdType npts;
+  const vtkIdType* pts = nullptr;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    computeFaceQuadric(pts, QEM.data());
+
+    // add the QEM to all points of the face
+    for (int i = 0; i < 3; i++)
+    {
+      addFaceQuadric(pts[i], QEM.data());
     }
   } // for all triangles
-
-  delete[] QEM;
 }
 
 void vtkQuadricDecimation::AddBoundaryConstraints()
@@ -690,19 +793,46 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   const vtkIdType* pts;
   double t0[3], t1[3], t2[3];
   double e0[3], e1[3], n[3], c, w;
-  vtkIdList* cellIds = vtkIdList::New();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Looking for the edge neighbors is the expensive part, flag the boundary
+  // edges of each face in parallel then accumulate their constraints in order.
+  std::vector<unsigned char> boundaryEdges(numCells, 0);
+  vtkSMPThreadLocalObject<vtkIdList> localCellIds;
+  vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellIds = localCellIds.Local();
+    vtkIdList* ptIds = localPtIds.Local();
+    vtkIdType cellNpts;
+    const vtkIdType* cellPts;
+    for (vtkIdType id = begin; id < end; id++)
+    {
+      input->GetCellPoints(id, cellNpts, cellPts, ptIds);
+      for (int edge = 0; edge < 3; edge++)
+      {
+        input->GetCellEdgeNeighbors(id, cellPts[edge], cellPts[(edge + 1) % 3], cellIds);
+        if (cellIds->GetNumberOfIds() == 0)
+        {
+          boundaryEdges[id] |= 1 << edge;
+        }
+      }
+    }
+  });
 
   // allocate local QEM space matrix
   QEM = new double[11 + 4 * this->NumberOfComponents];
 
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  for (cellId = 0; cellId < numCells; cellId++)
   {
+    if (!boundaryEdges[cellId])
+    {
+      continue;
+    }
     input->GetCellPoints(cellId, npts, pts);
 
     for (i = 0; i < 3; i++)
     {
-      input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
-      if (cellIds->GetNumberOfIds() == 0)
+      if (boundaryEdges[cellId] & (1 << i))
       {
         // this is a boundary
         input->GetPoint(pts[(i + 2) % 3], t0);
@@ -784,7 +914,6 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
       }
     }
   }
-  cellIds->Delete();
   delete[] QEM;
 }
 
@@ -846,6 +975,241 @@ void vtkQuadricDecimation::FindAffectedEdges(vtkIdType p1Id, vtkIdType p2Id, vtk
   }
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::CollapseEdgesInParallel(vtkIdType numTris)
+{
+  const vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  const int dimension = 3 + this->NumberOfComponents + this->VolumePreservation;
+  const int quadricSize = 11 + 4 * this->NumberOfComponents + this->VolumePreservation;
+  vtkIdType numDeletedTris = 0;
+
+  // Gather the points of the triangles using either end point of an edge,
+  // the neighborhood modified by its collapse. Points may be repeated.
+  auto getNeighborhood = [this](vtkIdType edgeId, std::vector<vtkIdType>& neighborhood) {
+    neighborhood.clear();
+    const vtkIdType endPtIds[2] = { this->EndPoint1List->GetId(edgeId),
+      this->EndPoint2List->GetId(edgeId) };
+    for (vtkIdType ptId : endPtIds)
+    {
+      neighborhood.push_back(ptId);
+      vtkIdType ncells;
+      vtkIdType* cells;
+      this->Mesh->GetPointCells(ptId, ncells, cells);
+      for (vtkIdType i = 0; i < ncells; i++)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        this->Mesh->GetCellPoints(cells[i], npts, pts);
+        neighborhood.insert(neighborhood.end(), pts, pts + npts);
+      }
+    }
+  };
+
+  // The points of the neighborhoods of the edges selected for a pass.
+  std::vector<unsigned char> locked(numPts, 0);
+  std::vector<vtkIdType> lockedPts;
+
+  struct Candidate
+  {
+    vtkIdType EdgeId;
+    double Cost;
+    bool Selected;
+    bool Collapsed;
+    int NumberOfDeletedTris;
+    std::vector<vtkIdType> AffectedEdges;
+  };
+  std::vector<Candidate> batch;
+  std::vector<vtkIdType> recomputedEdges;
+  std::vector<double> recomputedCosts;
+  vtkSMPThreadLocalObject<vtkIdList> localIds;
+  std::vector<vtkIdType> neighborhood;
+  vtkSMPThreadLocal<std::vector<double>> localWork;
+  const vtkIdType targetDeletedTris =
+    static_cast<vtkIdType>(std::ceil(this->TargetReduction * numTris));
+
+  bool abort = false;
+  while (!abort && this->ActualReduction < this->TargetReduction)
+  {
+    vtkDebugMacro(<< "Collapsing edge#" << this->NumberOfEdgeCollapses);
+    this->UpdateProgress(0.20 + 0.80 * this->NumberOfEdgeCollapses / numPts);
+    abort = this->CheckAbort();
+
+    // Take the cheapest edges, at most an eighth of the queue so that the
+    // order of the collapses stays close to the serial one, and not more than
+    // needed to reach the target as most collapses delete two triangles.
+    const vtkIdType batchSize = std::max<vtkIdType>(1,
+      std::min((targetDeletedTris - numDeletedTris + 1) / 2,
+        this->EdgeCosts->GetNumberOfItems() / 8));
+    batch.clear();
+    while (static_cast<vtkIdType>(batch.size()) < batchSize)
+    {
+      double cost;
+      vtkIdType edgeId = this->EdgeCosts->Pop(0, cost);
+      if (edgeId < 0)
+      {
+        break;
+      }
+      if (cost >= VTK_DOUBLE_MAX)
+      {
+        this->EdgeCosts->Insert(cost, edgeId);
+        break;
+      }
+      batch.push_back(Candidate{ edgeId, cost, false, false, 0, {} });
+    }
+    if (batch.empty())
+    {
+      break;
+    }
+    const vtkIdType numCandidates = static_cast<vtkIdType>(batch.size());
+
+    // Select the edges in order of cost, skipping those whose neighborhood
+    // overlaps the one of an already selected edge. The cheapest edge is
+    // always selected and the selected edges modify disjoint parts of the
+    // mesh, the points of their neighborhoods being locked for the pass.
+    for (Candidate& candidate : batch)
+    {
+      getNeighborhood(candidate.EdgeId, neighborhood);
+      candidate.Selected = std::none_of(
+        neighborhood.begin(), neighborhood.end(), [&](vtkIdType ptId) { return locked[ptId]; });
+      if (candidate.Selected)
+      {
+        for (vtkIdType ptId : neighborhood)
+        {
+          locked[ptId] = 1;
+        }
+        lockedPts.insert(lockedPts.end(), neighborhood.begin(), neighborhood.end());
+      }
+    }
+    for (vtkIdType ptId : lockedPts)
+    {
+      locked[ptId] = 0;
+    }
+    lockedPts.clear();
+
+    // Collapse the selected edges.
+    vtkSMPTools::For(0, numCandidates, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ids = localIds.Local();
+      std::vector<double>& x = localWork.Local();
+      x.resize(dimension);
+      for (vtkIdType rank = begin; rank < end; rank++)
+      {
+        Candidate& candidate = batch[rank];
+        if (!candidate.Selected)
+        {
+          continue;
+        }
+        vtkIdType endPtIds[2] = { this->EndPoint1List->GetId(candidate.EdgeId),
+          this->EndPoint2List->GetId(candidate.EdgeId) };
+        this->TargetPoints->GetTuple(candidate.EdgeId, x.data());
+        if (!this->IsGoodPlacement(endPtIds[0], endPtIds[1], x.data()))
+        {
+          continue;
+        }
+        candidate.Collapsed = true;
+        this->SetPointAttributeArray(endPtIds, x.data());
+        this->AddQuadric(endPtIds[1], endPtIds[0]);
+        this->FindAffectedEdges(endPtIds[0], endPtIds[1], ids);
+        candidate.AffectedEdges.assign(ids->begin(), ids->end());
+        candidate.NumberOfDeletedTris = this->CollapseEdge(endPtIds[0], endPtIds[1], ids);
+      }
+    });
+
+    // Return the other edges to the queue, the poorly placed ones with the
+    // max cost as in the serial mode, before updating the affected edges.
+    for (const Candidate& candidate : batch)
+    {
+      if (!candidate.Selected)
+      {
+        this->EdgeCosts->Insert(candidate.Cost, candidate.EdgeId);
+      }
+      else if (!candidate.Collapsed)
+      {
+        vtkDebugMacro(<< "Poor placement detected " << candidate.EdgeId << " " << candidate.Cost);
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, candidate.EdgeId);
+      }
+    }
+
+    // Update the edge table as UpdateEdgeData does, in the order of the batch.
+    recomputedEdges.clear();
+    for (const Candidate& candidate : batch)
+    {
+      if (!candidate.Collapsed)
+      {
+        continue;
+      }
+      const vtkIdType pt0Id = this->EndPoint1List->GetId(candidate.EdgeId);
+      const vtkIdType pt1Id = this->EndPoint2List->GetId(candidate.EdgeId);
+      this->NumberOfEdgeCollapses++;
+      numDeletedTris += candidate.NumberOfDeletedTris;
+      for (vtkIdType edgeId : candidate.AffectedEdges)
+      {
+        this->EdgeCosts->DeleteId(edgeId);
+        vtkIdType edge[2] = { this->EndPoint1List->GetId(edgeId),
+          this->EndPoint2List->GetId(edgeId) };
+        if (edge[0] == pt1Id || edge[1] == pt1Id)
+        {
+          const vtkIdType otherPtId = edge[0] == pt1Id ? edge[1] : edge[0];
+          if (this->Edges->IsEdge(otherPtId, pt0Id) == -1)
+          {
+            // The edge will be completely new, add it.
+            vtkIdType newEdgeId = this->Edges->GetNumberOfEdges();
+            this->Edges->InsertEdge(otherPtId, pt0Id, newEdgeId);
+            this->EndPoint1List->InsertId(newEdgeId, otherPtId);
+            this->EndPoint2List->InsertId(newEdgeId, pt0Id);
+            this->TargetPoints->InsertTuple(newEdgeId, this->TempX);
+            recomputedEdges.push_back(newEdgeId);
+          }
+        }
+        else
+        {
+          recomputedEdges.push_back(edgeId);
+        }
+      }
+    }
+
+    // The quadrics do not change anymore during this pass, compute the new
+    // costs in parallel then queue the edges in order.
+    const vtkIdType numRecomputed = static_cast<vtkIdType>(recomputedEdges.size());
+    recomputedCosts.resize(numRecomputed);
+    vtkSMPTools::For(0, numRecomputed, [&](vtkIdType begin, vtkIdType end) {
+      // target point, quadric, right hand side and matrix
+      std::vector<double>& work = localWork.Local();
+      work.resize(dimension + quadricSize + dimension + dimension * dimension);
+      double* target = work.data();
+      double* tempQuad = target + dimension;
+      double* tempB = tempQuad + quadricSize;
+      std::vector<double*> tempA(dimension);
+      for (int row = 0; row < dimension; row++)
+      {
+        tempA[row] = tempB + dimension + row * dimension;
+      }
+
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        const vtkIdType edgeId = recomputedEdges[i];
+        if (this->AttributeErrorMetric)
+        {
+          recomputedCosts[i] = this->ComputeCost2(edgeId, target, tempQuad, tempB, tempA.data());
+        }
+        else
+        {
+          recomputedCosts[i] = this->ComputeCost(edgeId, target, tempQuad);
+        }
+        this->TargetPoints->SetTypedTuple(edgeId, target);
+      }
+    });
+    for (vtkIdType i = 0; i < numRecomputed; i++)
+    {
+      this->EdgeCosts->Insert(recomputedCosts[i], recomputedEdges[i]);
+    }
+
+    this->ActualReduction = static_cast<double>(numDeletedTris) / numTris;
+  }
+
+  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses);
+  return numDeletedTris;
+}
+
 // FIXME: memory allocation clean up
 void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 {
@@ -932,6 +1296,12 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost(edgeId, x, this->TempQuad);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x, double* tempQuad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
@@ -948,20 +1318,20 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    tempQuad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = tempQuad[0];
+  A[0][1] = A[1][0] = tempQuad[1];
+  A[0][2] = A[2][0] = tempQuad[2];
+  A[1][1] = tempQuad[4];
+  A[1][2] = A[2][1] = tempQuad[5];
+  A[2][2] = tempQuad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -tempQuad[3];
+  b[1] = -tempQuad[6];
+  b[2] = -tempQuad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -1013,7 +1383,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = tempQuad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++) * newPoint[i] * newPoint[i];
@@ -1028,6 +1398,13 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 
 //------------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
+{
+  return this->ComputeCost2(edgeId, x, this->TempQuad, this->TempB, this->TempA);
+}
+
+//------------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(
+  vtkIdType edgeId, double* x, double* tempQuad, double* tempB, double** tempA)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
@@ -1043,29 +1420,29 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] =
+    tempQuad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
   // copy the temp quad into TempA
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  tempA[0][0] = tempQuad[0];
+  tempA[0][1] = tempA[1][0] = tempQuad[1];
+  tempA[0][2] = tempA[2][0] = tempQuad[2];
+  tempA[1][1] = tempQuad[4];
+  tempA[1][2] = tempA[2][1] = tempQuad[5];
+  tempA[2][2] = tempQuad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  tempB[0] = -tempQuad[3];
+  tempB[1] = -tempQuad[6];
+  tempB[2] = -tempQuad[8];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-    this->TempB[i] = -this->TempQuad[11 + 4 * (i - 3) + 3];
+    tempA[0][i] = tempA[i][0] = tempQuad[11 + 4 * (i - 3)];
+    tempA[1][i] = tempA[i][1] = tempQuad[11 + 4 * (i - 3) + 1];
+    tempA[2][i] = tempA[i][2] = tempQuad[11 + 4 * (i - 3) + 2];
+    tempB[i] = -tempQuad[11 + 4 * (i - 3) + 3];
   }
 
   // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
@@ -1075,11 +1452,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        tempA[i][j] = tempQuad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        tempA[i][j] = 0;
       }
     }
   }
@@ -1090,48 +1467,48 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        tempA[i][3 + this->NumberOfComponents] = 0;
+        tempA[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        tempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        tempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        tempA[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        tempA[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
+    tempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
+    tempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = tempB[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
   solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+    tempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  tempA[0][0] = tempQuad[0];
+  tempA[0][1] = tempA[1][0] = tempQuad[1];
+  tempA[0][2] = tempA[2][0] = tempQuad[2];
+  tempA[1][1] = tempQuad[4];
+  tempA[1][2] = tempA[2][1] = tempQuad[5];
+  tempA[2][2] = tempQuad[7];
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
+    tempA[0][i] = tempA[i][0] = tempQuad[11 + 4 * (i - 3)];
+    tempA[1][i] = tempA[i][1] = tempQuad[11 + 4 * (i - 3) + 1];
+    tempA[2][i] = tempA[i][2] = tempQuad[11 + 4 * (i - 3) + 2];
   }
 
   for (i = 3; i < 3 + this->NumberOfComponents; i++)
@@ -1140,11 +1517,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        tempA[i][j] = tempQuad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        tempA[i][j] = 0;
       }
     }
   }
@@ -1155,16 +1532,16 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        tempA[i][3 + this->NumberOfComponents] = 0;
+        tempA[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
+        tempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        tempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        tempA[i][3 + this->NumberOfComponents] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
+        tempA[3 + this->NumberOfComponents][i] +=
           this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
@@ -1198,7 +1575,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j] * v[j];
+        temp2[i] += tempA[i][j] * v[j];
       }
     }
 
@@ -1216,13 +1593,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j] * pt1[j];
+          temp[i] += tempA[i][j] * pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = tempB[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1256,33 +1633,39 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i] * x[i] * x[i];
+    cost += tempA[i][i] * x[i] * x[i];
     for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      cost += 2.0 * tempA[i][j] * x[i] * x[j];
     }
   }
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -= 2.0 * this->TempB[i] * x[i];
+    cost -= 2.0 * tempB[i] * x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += tempQuad[9];
 
   return cost;
 }
 
 int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
+{
+  return this->CollapseEdge(pt0Id, pt1Id, this->CollapseCellIds);
+}
+
+//------------------------------------------------------------------------------
+int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList* cellIds)
 {
   int j, numDeleted = 0;
   vtkIdType i, cellId;
   vtkIdType npts;
   const vtkIdType* pts;
 
-  this->Mesh->GetPointCells(pt0Id, this->CollapseCellIds);
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt0Id, cellIds);
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     for (j = 0; j < 3; j++)
     {
@@ -1295,11 +1678,11 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
     }
   }
 
-  this->Mesh->GetPointCells(pt1Id, this->CollapseCellIds);
-  this->Mesh->ResizeCellList(pt0Id, this->CollapseCellIds->GetNumberOfIds());
-  for (i = 0; i < this->CollapseCellIds->GetNumberOfIds(); i++)
+  this->Mesh->GetPointCells(pt1Id, cellIds);
+  this->Mesh->ResizeCellList(pt0Id, cellIds->GetNumberOfIds());
+  for (i = 0; i < cellIds->GetNumberOfIds(); i++)
   {
-    cellId = this->CollapseCellIds->GetId(i);
+    cellId = cellIds->GetId(i);
     this->Mesh->GetCellPoints(cellId, npts, pts);
     // making sure we don't already have the triangle we're about to
     // change this one to
@@ -1537,6 +1920,7 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Attribute Error Metric: " << (this->AttributeErrorMetric ? "On\n" : "Off\n");
   os << indent << "Volume Preservation: " << (this->VolumePreservation ? "On\n" : "Off\n");
+  os << indent << "Parallel Collapses: " << (this->ParallelCollapses ? "On\n" : "Off\n");
   os << indent << "Scalars Attribute: " << (this->ScalarsAttribute ? "On\n" : "Off\n");
   os << indent << "Vectors Attribute: " << (this->VectorsAttribute ? "On\n" : "Off\n");
   os << indent << "Normals Attribute: " << (this->NormalsAttribute ? "On\n" : "Off\n");
@@ -135,6 +135,22 @@ public:
   vtkGetMacro(BoundaryWeightFactor, double);
   ///@}
 
+  ///@{
+  /**
+   * Collapse batches of edges concurrently with vtkSMPTools instead of one
+   * edge at a time. Each pass takes the cheapest edges of the queue and
+   * collapses those whose neighborhood, the points of the triangles using
+   * either end point, does not overlap the neighborhood of a cheaper edge
+   * of the batch. The edges are then not collapsed in strict order of cost,
+   * so the output differs from the serial decimation, but it does not depend
+   * on the number of threads. The attribute error options apply to both
+   * modes. Off by default.
+   */
+  vtkSetMacro(ParallelCollapses, bool);
+  vtkGetMacro(ParallelCollapses, bool);
+  vtkBooleanMacro(ParallelCollapses, bool);
+  ///@}
+
   ///@{
   /**
    * Getter/Setter for mapping point data to the output during decimation.
@@ -206,6 +222,19 @@ protected:
    */
   int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id);
 
+  /**
+   * Same as above, using the given list to gather the cells of the points
+   * so that edges with disjoint neighborhoods can be collapsed concurrently.
+   */
+  int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdList* cellIds);
+
+  /**
+   * Collapse batches of independent edges in parallel until the target
+   * reduction is reached, see ParallelCollapses. Return the number of
+   * triangles deleted.
+   */
+  vtkIdType CollapseEdgesInParallel(vtkIdType numTris);
+
   /**
    * Compute quadric for all vertices
    */
@@ -236,6 +265,17 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double* x);
   ///@}
 
+  ///@{
+  /**
+   * Same as above, using the given work buffers instead of the temporary
+   * member variables so that the costs of several edges can be computed
+   * concurrently. tempQuad, tempB and tempA have the sizes of TempQuad, TempB
+   * and TempA.
+   */
+  double ComputeCost(vtkIdType edgeId, double* x, double* tempQuad);
+  double ComputeCost2(vtkIdType edgeId, double* x, double* tempQuad, double* tempB, double** tempA);
+  ///@}
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -279,6 +319,7 @@ protected:
   vtkTypeBool VolumePreservation;
 
   bool MapPointData = false;
+  bool ParallelCollapses = false;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
@@ -3,9 +3,11 @@
 #include "vtkSmoothPolyDataFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -13,11 +15,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
@@ -119,6 +126,7 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorVectors = 0;
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->IterationMode = GAUSS_SEIDEL_ITERATIONS;
 
   this->SmoothPoints = nullptr;
 
@@ -179,6 +187,7 @@ struct vtkSPDF_InternalParams
   vtkSmoothPoints* SmoothPoints;
   double* w;
   vtkCellLocator* cellLocator;
+  int maxCellSize;
 };
 
 template <typename T>
@@ -274,6 +283,124 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// Same as vtkSPDF_MovePoints, but each iteration moves all the points from
+// their positions at the previous iteration. The new positions are written
+// in a second buffer, so the points can be moved in parallel.
+template <typename T>
+void vtkSPDF_MovePointsJacobi(vtkSPDF_InternalParams<T>& params)
+{
+  T* coords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> buffer(3 * params.numPts);
+  T* current = coords;
+  T* next = buffer.data();
+
+  vtkSMPThreadLocal<T> localMaxDist(0);
+  vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+  vtkSMPThreadLocal<std::vector<double>> localWeights;
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
+      if (params.spdf->CheckAbort())
+      {
+        break;
+      }
+    }
+
+    for (auto& dist : localMaxDist)
+    {
+      dist = 0.0;
+    }
+    vtkSMPTools::For(0, params.numPts, [&](vtkIdType begin, vtkIdType end) {
+      T& threadMaxDist = localMaxDist.Local();
+      vtkGenericCell* cell = localCell.Local();
+      std::vector<double>& weights = localWeights.Local();
+      weights.resize(params.maxCellSize);
+      T deltaX[3];
+      double xNew[3], closestPt[3], dist2;
+
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const T* x = current + 3 * i;
+        T* xNext = next + 3 * i;
+        vtkMeshVertexPtr vertsPtr = params.vertexPtr + i;
+        vtkIdType npts;
+        if (vertsPtr->type == VTK_FIXED_VERTEX || !vertsPtr->edges ||
+          (npts = vertsPtr->edges->GetNumberOfIds()) <= 0)
+        {
+          std::copy(x, x + 3, xNext);
+          continue;
+        }
+
+        // Compute the mean (cumulated) direction vector
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+        const vtkIdType* edgeIdPtr = vertsPtr->edges->GetPointer(0);
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          for (int k = 0; k < 3; ++k)
+          {
+            deltaX[k] += current[3 * edgeIdPtr[j] + k];
+          }
+        }
+
+        // Move the point
+        for (int k = 0; k < 3; ++k)
+        {
+          xNext[k] = x[k] + params.factor * (deltaX[k] / npts - x[k]);
+          xNew[k] = xNext[k];
+        }
+
+        // Constrain point to surface
+        if (params.source)
+        {
+          vtkSmoothPoint* sPtr = params.SmoothPoints->GetSmoothPoint(i);
+          bool inCell = false;
+          if (sPtr->cellId >= 0) // in cell
+          {
+            params.source->GetCell(sPtr->cellId, cell);
+            inCell = cell->EvaluatePosition(
+                       xNew, closestPt, sPtr->subId, sPtr->p, dist2, weights.data()) != 0;
+          }
+          if (!inCell) // not in cell anymore
+          {
+            params.cellLocator->FindClosestPoint(
+              xNew, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+          }
+          for (int k = 0; k < 3; ++k)
+          {
+            xNext[k] = static_cast<T>(closestPt[k]);
+          }
+        }
+
+        T dist = vtkMath::Norm(deltaX);
+        if (dist > threadMaxDist)
+        {
+          threadMaxDist = dist;
+        }
+      } // for all points
+    });
+
+    std::swap(current, next);
+    maxDist = 0.0;
+    for (const auto& dist : localMaxDist)
+    {
+      maxDist = std::max(maxDist, dist);
+    }
+  } // for not converged or within iteration count
+
+  if (current != coords)
+  {
+    std::copy(current, current + 3 * params.numPts, coords);
+  }
+  params.newPts->Modified();
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
 } // namespace
 
 //------------------------------------------------------------------------------
@@ -303,7 +430,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; // Cosine of angle between adjacent polys
   double CosEdgeAngle;    // Cosine of angle between adjacent edges
-  double closestPt[3], dist2;
   vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
   vtkPolyData* Mesh;
   vtkPoints* inPts;
@@ -421,13 +547,7 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   { // build cell structure
     vtkCellArray* polys;
     vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-
-    vtkNew<vtkIdList> neighbors;
-    neighbors->Allocate(VTK_CELL_SIZE);
+    int edge;
 
     vtkNew<vtkPolyData> inMesh;
     inMesh->SetPoints(inPts);
@@ -448,7 +568,96 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     polys = Mesh->GetPolys();
     this->UpdateProgress(0.375);
 
-    checkAbortInterval = std::min(polys->GetNumberOfCells() / 10 + 1, (vtkIdType)1000);
+    // Classify the edges of the cells. This only reads the mesh, so it is
+    // done in parallel; the classification of each cell edge is stored at
+    // the connectivity offset of the edge, -1 meaning an already visited
+    // edge. The vertices are then updated in cell order.
+    vtkIdType numMeshCells = polys->GetNumberOfCells();
+    std::vector<signed char> edgeTypes(polys->GetNumberOfConnectivityIds());
+    vtkTypeBool featureEdgeSmoothing = this->FeatureEdgeSmoothing;
+    vtkSMPThreadLocalObject<vtkIdList> localNeighbors;
+    vtkSMPThreadLocalObject<vtkIdList> localNeiPtIds;
+    vtkSMPTools::For(0, numMeshCells, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+      vtkIdList* cellNeighbors = localNeighbors.Local();
+      vtkIdList* neiPtIds = localNeiPtIds.Local();
+      vtkSmartPointer<vtkCellArrayIterator> iter;
+      iter.TakeReference(polys->NewIterator());
+      vtkIdType cellNpts, neiNpts;
+      const vtkIdType* cellPts;
+      const vtkIdType* neiCellPts;
+      double cellNormal[3], neighborNormal[3];
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      vtkIdType checkAbortInterval = std::min((endCellId - beginCellId) / 10 + 1, (vtkIdType)1000);
+
+      for (vtkIdType cId = beginCellId; cId < endCellId; cId++)
+      {
+        if (cId % checkAbortInterval == 0)
+        {
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
+          {
+            break;
+          }
+        }
+        iter->GetCellAtId(cId, cellNpts, cellPts);
+        signed char* cellEdgeTypes = edgeTypes.data() + polys->GetOffset(cId);
+        for (vtkIdType e = 0; e < cellNpts; e++)
+        {
+          vtkIdType q1 = cellPts[e];
+          vtkIdType q2 = cellPts[(e + 1) % cellNpts];
+          Mesh->GetCellEdgeNeighbors(cId, q1, q2, cellNeighbors);
+          vtkIdType numNeighbors = cellNeighbors->GetNumberOfIds();
+
+          signed char edgeType = VTK_SIMPLE_VERTEX;
+          if (numNeighbors == 0)
+          {
+            edgeType = VTK_BOUNDARY_EDGE_VERTEX;
+          }
+
+          else if (numNeighbors >= 2)
+          {
+            // check to make sure that this edge hasn't been marked already
+            vtkIdType n;
+            for (n = 0; n < numNeighbors; n++)
+            {
+              if (cellNeighbors->GetId(n) < cId)
+              {
+                break;
+              }
+            }
+            if (n >= numNeighbors)
+            {
+              edgeType = VTK_FEATURE_EDGE_VERTEX;
+            }
+          }
+
+          else if (numNeighbors == 1 && cellNeighbors->GetId(0) > cId)
+          {
+            if (featureEdgeSmoothing)
+            {
+              vtkPolygon::ComputeNormal(inPts, cellNpts, cellPts, cellNormal);
+              Mesh->GetCellPoints(cellNeighbors->GetId(0), neiNpts, neiCellPts, neiPtIds);
+              vtkPolygon::ComputeNormal(inPts, neiNpts, neiCellPts, neighborNormal);
+
+              if (vtkMath::Dot(cellNormal, neighborNormal) <= CosFeatureAngle)
+              {
+                edgeType = VTK_FEATURE_EDGE_VERTEX;
+              }
+            }
+          }
+          else // a visited edge; skip rest of analysis
+          {
+            edgeType = -1;
+          }
+          cellEdgeTypes[e] = edgeType;
+        }
+      }
+    });
+
+    checkAbortInterval = std::min(numMeshCells / 10 + 1, (vtkIdType)1000);
 
     for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
     {
@@ -456,6 +665,7 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       {
         break;
       }
+      const signed char* cellEdgeTypes = edgeTypes.data() + polys->GetOffset(cellId);
       for (i = 0; i < npts; i++)
       {
         p1 = pts[i];
@@ -472,46 +682,8 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
           Verts[p2].edges->Allocate(16, 6);
         }
 
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j = 0; j < numNei; j++)
-          {
-            if (neighbors->GetId(j) < cellId)
-            {
-              break;
-            }
-          }
-          if (j >= numNei)
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
+        edge = cellEdgeTypes[i];
+        if (edge < 0) // a visited edge
         {
           continue;
         }
@@ -655,47 +827,73 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // constrained to the surface of the mesh object).
   std::unique_ptr<double[]> w;
   vtkSmartPointer<vtkCellLocator> cellLocator;
+  int maxCellSize = 0;
   if (source)
   {
     this->SmoothPoints = std::unique_ptr<vtkSmoothPoints>(new vtkSmoothPoints);
-    vtkSmoothPoint* sPtr;
     cellLocator.TakeReference(vtkCellLocator::New());
-    auto maxCellSize = source->GetMaxCellSize();
+    maxCellSize = source->GetMaxCellSize();
     w.reset(new double[maxCellSize]);
     cellLocator->SetDataSet(source);
     cellLocator->BuildLocator();
 
-    for (i = 0; i < numPts; i++)
-    {
-      sPtr = this->SmoothPoints->InsertSmoothPoint(i);
-      cellLocator->FindClosestPoint(
-        inPts->GetPoint(i), closestPt, sPtr->cellId, sPtr->subId, dist2);
-      newPts->SetPoint(i, closestPt);
-    }
+    this->SmoothPoints->InsertSmoothPoint(numPts - 1); // allocate all the points
+    vtkSmoothPoints* smoothPoints = this->SmoothPoints.get();
+    vtkSMPThreadLocalObject<vtkGenericCell> localCell;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      vtkGenericCell* cell = localCell.Local();
+      double x[3], closest[3], d2;
+      for (; ptId < endPtId; ptId++)
+      {
+        vtkSmoothPoint* sPtr = smoothPoints->GetSmoothPoint(ptId);
+        inPts->GetPoint(ptId, x);
+        cellLocator->FindClosestPoint(x, closest, cell, sPtr->cellId, sPtr->subId, d2);
+        newPts->SetPoint(ptId, closest);
+      }
+    });
   }
   else // smooth normally
   {
-    for (i = 0; i < numPts; i++) // initialize to old coordinates
-    {
-      newPts->SetPoint(i, inPts->GetPoint(i));
-    }
+    // initialize to old coordinates
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ptId++)
+      {
+        inPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptId, x);
+      }
+    });
   }
 
   if (newPts->GetDataType() == VTK_DOUBLE)
   {
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
       this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints.get(), w.get(),
-      cellLocator };
+      cellLocator, maxCellSize };
 
-    vtkSPDF_MovePoints(params);
+    if (this->IterationMode == JACOBI_ITERATIONS)
+    {
+      vtkSPDF_MovePointsJacobi(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
   else
   {
     vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
       static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
-      this->SmoothPoints.get(), w.get(), cellLocator };
+      this->SmoothPoints.get(), w.get(), cellLocator, maxCellSize };
 
-    vtkSPDF_MovePoints(params);
+    if (this->IterationMode == JACOBI_ITERATIONS)
+    {
+      vtkSPDF_MovePointsJacobi(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
 
   // Release memory if it's been allocated
@@ -710,12 +908,15 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     vtkNew<vtkFloatArray> newScalars;
     newScalars->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      newScalars->SetComponent(i, 0, sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
-    }
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double xIn[3], xOut[3];
+      for (; ptId < endPtId; ptId++)
+      {
+        inPts->GetPoint(ptId, xIn);
+        newPts->GetPoint(ptId, xOut);
+        newScalars->SetValue(ptId, sqrt(vtkMath::Distance2BetweenPoints(xIn, xOut)));
+      }
+    });
     int idx = output->GetPointData()->AddArray(newScalars);
     output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
@@ -725,16 +926,19 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     vtkNew<vtkFloatArray> newVectors;
     newVectors->SetNumberOfComponents(3);
     newVectors->SetNumberOfTuples(numPts);
-    for (i = 0; i < numPts; i++)
-    {
-      inPts->GetPoint(i, x1);
-      newPts->GetPoint(i, x2);
-      for (j = 0; j < 3; j++)
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double xIn[3], xOut[3], delta[3];
+      for (; ptId < endPtId; ptId++)
       {
-        x3[j] = x2[j] - x1[j];
+        inPts->GetPoint(ptId, xIn);
+        newPts->GetPoint(ptId, xOut);
+        for (int comp = 0; comp < 3; comp++)
+        {
+          delta[comp] = xOut[comp] - xIn[comp];
+        }
+        newVectors->SetTuple(ptId, delta);
       }
-      newVectors->SetTuple(i, x3);
-    }
+    });
     output->GetPointData()->SetVectors(newVectors);
   }
 
@@ -797,5 +1001,6 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << "\n";
+  os << indent << "Iteration Mode: " << this->IterationMode << "\n";
 }
 VTK_ABI_NAMESPACE_END
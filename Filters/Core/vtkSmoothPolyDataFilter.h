@@ -65,6 +65,15 @@
  * second input: the Source. If defined, the input mesh is constrained to
  * lie on the surface defined by the Source ivar.
  *
+ * By default each iteration moves the vertices in place, one after the
+ * other, so that a vertex is moved using the already moved positions of
+ * its neighbors (Gauss-Seidel iterations). This is inherently serial. When
+ * the IterationMode is set to JACOBI_ITERATIONS, every vertex is moved
+ * using the positions of the previous iteration, which are kept in a second
+ * buffer. The vertices are then moved in parallel with vtkSMPTools, and the
+ * result does not depend on the number of threads. The topological analysis
+ * of the mesh is threaded in both modes.
+ *
  *
  * @warning
  * The Laplacian operation reduces high frequency information in the geometry
@@ -193,6 +202,30 @@ public:
   vtkBooleanMacro(GenerateErrorVectors, vtkTypeBool);
   ///@}
 
+  /**
+   * Iteration modes, see SetIterationMode().
+   */
+  enum IterationModes
+  {
+    GAUSS_SEIDEL_ITERATIONS = 0,
+    JACOBI_ITERATIONS = 1
+  };
+
+  ///@{
+  /**
+   * Specify how the vertices are moved during an iteration. With
+   * GAUSS_SEIDEL_ITERATIONS (the default), the vertices are moved in place
+   * and in order. With JACOBI_ITERATIONS, all the vertices are moved from
+   * their positions at the previous iteration, in parallel. Jacobi
+   * iterations smooth slightly less per iteration, so a few more iterations
+   * may be needed to obtain the same result.
+   */
+  vtkSetClampMacro(IterationMode, int, GAUSS_SEIDEL_ITERATIONS, JACOBI_ITERATIONS);
+  vtkGetMacro(IterationMode, int);
+  void SetIterationModeToGaussSeidel() { this->SetIterationMode(GAUSS_SEIDEL_ITERATIONS); }
+  void SetIterationModeToJacobi() { this->SetIterationMode(JACOBI_ITERATIONS); }
+  ///@}
+
   ///@{
   /**
    * Specify the source object which is used to constrain smoothing. The
@@ -230,6 +263,7 @@ protected:
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
   int OutputPointsPrecision;
+  int IterationMode;
 
   std::unique_ptr<vtkSmoothPoints> SmoothPoints;
 
@@ -12,9 +12,14 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkStripper);
 
@@ -47,7 +52,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType numLinePts = 0;
   vtkIdList* cellIds;
   int foundOne;
-  vtkIdType *pts, neighbor = 0;
+  vtkIdType *pts, neighbor = 0, nextNeighbor;
   vtkPolyData* mesh;
   char* visited;
   vtkIdType numStripPts = 0;
@@ -210,6 +215,38 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // The first neighbor across each triangle edge is looked up in parallel.
+  // The strips are then grown serially from this table, since the greedy
+  // growth depends on the cells visited so far. The smallest neighbor id is
+  // kept so that the strips do not depend on the order of the cell links.
+  std::vector<vtkIdType> edgeNeighbors(3 * numCells, -1);
+  vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbors;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType beginCellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = tlCellPts.Local();
+    vtkIdList* neighbors = tlNeighbors.Local();
+    vtkIdType numCellPts;
+    const vtkIdType* cellPtIds;
+    for (vtkIdType triId = beginCellId; triId < endCellId; ++triId)
+    {
+      if (mesh->GetCellType(triId) != VTK_TRIANGLE)
+      {
+        continue;
+      }
+      mesh->GetCellPoints(triId, numCellPts, cellPtIds, cellPts);
+      for (int edgeId = 0; edgeId < 3; ++edgeId)
+      {
+        mesh->GetCellEdgeNeighbors(
+          triId, cellPtIds[edgeId], cellPtIds[(edgeId + 1) % 3], neighbors);
+        if (neighbors->GetNumberOfIds() > 0)
+        {
+          edgeNeighbors[3 * triId + edgeId] =
+            *std::min_element(neighbors->begin(), neighbors->end());
+        }
+      }
+    }
+  });
+
   // array keeps track of data that's been visited
   visited = new char[numCells];
   for (i = 0; i < numCells; i++)
@@ -259,8 +296,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
           pts[1] = triPts[i];
           pts[2] = triPts[(i + 1) % 3];
 
-          mesh->GetCellEdgeNeighbors(cellId, pts[1], pts[2], cellIds);
-          if (cellIds->GetNumberOfIds() > 0 && !visited[neighbor = cellIds->GetId(0)] &&
+          if ((neighbor = edgeNeighbors[3 * cellId + i]) >= 0 && !visited[neighbor] &&
             mesh->GetCellType(neighbor) == VTK_TRIANGLE)
           {
             pts[0] = triPts[(i + 2) % 3];
@@ -296,6 +332,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
           {
             origStripIds->InsertNextValue(cellId);
           }
+          nextNeighbor = neighbor;
           while (neighbor >= 0)
           {
             visited[neighbor] = 1;
@@ -319,8 +356,10 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
             // only add the triangle to the strip if it isn't degenerate.
             if (i < 3)
             {
+              // the edge from the new point to the last one
               pts[numPts] = triPts[i];
-              mesh->GetCellEdgeNeighbors(neighbor, pts[numPts], pts[numPts - 1], cellIds);
+              nextNeighbor = edgeNeighbors[3 * neighbor +
+                (triPts[(i + 1) % 3] == pts[numPts - 1] ? i : (i + 2) % 3)];
               numPts++;
             }
 
@@ -333,7 +372,7 @@ int vtkStripper::RequestData(vtkInformation* vtkNotUsed(request),
             // Note2: for a degenerate triangle this test will
             // correctly fail because the visited[neighbor] will
             // now be visited
-            if (cellIds->GetNumberOfIds() <= 0 || visited[neighbor = cellIds->GetId(0)] ||
+            if (nextNeighbor < 0 || visited[neighbor = nextNeighbor] ||
               mesh->GetCellType(neighbor) != VTK_TRIANGLE || numPts >= (this->MaximumLength + 2))
             {
               newStrips->InsertNextCell(numPts, pts);
@@ -35,6 +35,10 @@
  * If there is a ghost cell array in the input, the ghost array is discarded.
  * Any cell tagged as ghost is skipped when stripping. Ghost points are kept.
  *
+ * The neighbors across the triangle edges are looked up in parallel with
+ * vtkSMPTools before the strips are grown. The growth itself is greedy and
+ * serial, so the strips do not depend on the number of threads.
+ *
  * @warning
  * If triangle strips or poly-lines exist in the input data they will
  * be passed through to the output data. This filter will only construct
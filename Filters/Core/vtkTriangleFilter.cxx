@@ -5,17 +5,42 @@
 #include "vtkCellArray.h"
 #include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
-#include "vtkTriangleStrip.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTriangleFilter);
 
+namespace
+{
+//-------------------------------------------------------------------------
+// Grow the cell data arrays to numTuples tuples so that they can be written
+// concurrently. SetNumberOfTuples alone discards the values already copied
+// when an array has to be reallocated.
+void GrowCellData(vtkCellData* cd, vtkIdType numTuples)
+{
+  for (int i = 0; i < cd->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = cd->GetAbstractArray(i);
+    if (numTuples > array->GetNumberOfTuples())
+    {
+      array->Resize(numTuples);
+      array->SetNumberOfTuples(numTuples);
+    }
+  }
+}
+}
+
 //-------------------------------------------------------------------------
 int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -213,57 +238,105 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
     else
     {
       outCellId = output->GetNumberOfCells();
-      newPolys->AllocateCopy(inPolys);
 
-      vtkNew<vtkIdList> ptIds;
-      ptIds->Allocate(VTK_CELL_SIZE);
-      vtkIdType triPts[3];
-      // It may be necessary to specify a custom tessellation
-      // tolerance.
-      vtkNew<vtkPolygon> poly;
-      if (this->Tolerance > 0.0)
+      // A polygon of n points gives at most n - 2 triangles. The polygons
+      // are triangulated in parallel, each one in its own slot, and the
+      // triangles are then gathered in the polygon order.
+      std::vector<vtkIdType> slots(numInPolys + 1);
+      slots[0] = 0;
+      for (vtkIdType polyId = 0; polyId < numInPolys; ++polyId)
       {
-        poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
+        slots[polyId + 1] =
+          slots[polyId] + std::max<vtkIdType>(inPolys->GetCellSize(polyId) - 2, 0);
       }
+      std::vector<vtkIdType> slotTris(3 * slots[numInPolys]);
+      std::vector<vtkIdType> triOffsets(numInPolys + 1, 0);
 
-      auto iter = vtk::TakeSmartPointer(inPolys->NewIterator());
-      for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal() && !abort;
-           iter->GoToNextCell(), ++inCellId)
-      {
-        if (!(inCellId % updateInterval)) // manage progress reports / early abort
-        {
-          this->UpdateProgress((float)inCellId / numInCells);
-          abort = this->CheckAbort();
-        }
-        iter->GetCurrentCell(npts, pts);
-        if (npts == 3)
+      vtkSMPThreadLocalObject<vtkPolygon> tlPolygon;
+      vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+      vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+      vtkSMPTools::For(0, numInPolys, [&](vtkIdType beginPolyId, vtkIdType endPolyId) {
+        // It may be necessary to specify a custom tessellation
+        // tolerance.
+        vtkPolygon* poly = tlPolygon.Local();
+        if (this->Tolerance > 0.0)
         {
-          newPolys->InsertNextCell(3, pts);
-          outCD->CopyData(inCD, inCellId, outCellId++);
+          poly->SetTolerance(this->Tolerance); // Tighten tessellation tolerance
         }
-        else // triangulate polygon
+        vtkIdList* ptIds = tlPtIds.Local();
+        vtkIdList* cellPts = tlCellPts.Local();
+        double x[3];
+        bool isFirst = vtkSMPTools::GetSingleThread();
+
+        for (vtkIdType polyId = beginPolyId; polyId < endPolyId; ++polyId)
         {
-          // initialize polygon
-          poly->PointIds->SetNumberOfIds(npts);
-          poly->Points->SetNumberOfPoints(npts);
-          for (vtkIdType i = 0; i < npts; i++)
+          if (isFirst)
+          {
+            this->CheckAbort();
+          }
+          if (this->GetAbortOutput())
           {
-            poly->PointIds->SetId(i, pts[i]);
-            poly->Points->SetPoint(i, inPts->GetPoint(pts[i]));
+            break;
+          }
+          vtkIdType numPolyPts;
+          const vtkIdType* polyPts;
+          inPolys->GetCellAtId(polyId, numPolyPts, polyPts, cellPts);
+          vtkIdType* tris = slotTris.data() + 3 * slots[polyId];
+          if (numPolyPts == 3)
+          {
+            std::copy(polyPts, polyPts + 3, tris);
+            triOffsets[polyId] = 1;
+            continue;
+          }
+
+          // triangulate polygon
+          poly->PointIds->SetNumberOfIds(numPolyPts);
+          poly->Points->SetNumberOfPoints(numPolyPts);
+          for (vtkIdType i = 0; i < numPolyPts; i++)
+          {
+            poly->PointIds->SetId(i, polyPts[i]);
+            inPts->GetPoint(polyPts[i], x);
+            poly->Points->SetPoint(i, x);
           }
           poly->TriangulateLocalIds(0, ptIds);
-          const int numSimplices = ptIds->GetNumberOfIds() / 3;
-          for (vtkIdType i = 0; i < numSimplices; i++)
+          const vtkIdType numSimplices =
+            std::min(ptIds->GetNumberOfIds() / 3, slots[polyId + 1] - slots[polyId]);
+          for (vtkIdType i = 0; i < 3 * numSimplices; i++)
           {
-            for (vtkIdType j = 0; j < 3; j++)
-            {
-              triPts[j] = poly->PointIds->GetId(ptIds->GetId(3 * i + j));
-            }
-            newPolys->InsertNextCell(3, triPts);
-            outCD->CopyData(inCD, inCellId, outCellId++);
-          } // for each simplex
-        }   // triangulate polygon
+            tris[i] = poly->PointIds->GetId(ptIds->GetId(i));
+          }
+          triOffsets[polyId] = numSimplices;
+        }
+      });
+      abort = this->GetAbortOutput();
+
+      // Turn the numbers of triangles into offsets in the output
+      vtkIdType numOutTris = 0;
+      for (vtkIdType polyId = 0; polyId < numInPolys; ++polyId)
+      {
+        const vtkIdType numPolyTris = triOffsets[polyId];
+        triOffsets[polyId] = numOutTris;
+        numOutTris += numPolyTris;
       }
+      triOffsets[numInPolys] = numOutTris;
+
+      vtkNew<vtkIdTypeArray> conn;
+      conn->SetNumberOfValues(3 * numOutTris);
+      GrowCellData(outCD, outCellId + numOutTris);
+      vtkSMPTools::For(0, numInPolys, [&](vtkIdType beginPolyId, vtkIdType endPolyId) {
+        for (vtkIdType polyId = beginPolyId; polyId < endPolyId; ++polyId)
+        {
+          const vtkIdType* tris = slotTris.data() + 3 * slots[polyId];
+          std::copy(tris, tris + 3 * (triOffsets[polyId + 1] - triOffsets[polyId]),
+            conn->GetPointer(3 * triOffsets[polyId]));
+          for (vtkIdType triId = triOffsets[polyId]; triId < triOffsets[polyId + 1]; ++triId)
+          {
+            outCD->CopyData(inCD, inCellId + polyId, outCellId + triId);
+          }
+        }
+      });
+      inCellId += numInPolys;
+      newPolys->SetData(3, conn);
       output->SetPolys(newPolys);
     }
   }
@@ -287,28 +360,63 @@ int vtkTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
   if (!abort && numInStrips > 0)
   {
     outCellId = output->GetNumberOfCells();
-    if (newPolys == nullptr)
+
+    // A strip of n points gives n - 2 triangles, so the strips can be
+    // decomposed in parallel directly in the output.
+    std::vector<vtkIdType> triOffsets(numInStrips + 1);
+    triOffsets[0] = 0;
+    for (vtkIdType stripId = 0; stripId < numInStrips; ++stripId)
     {
-      newPolys = vtkSmartPointer<vtkCellArray>::New();
-      newPolys->AllocateCopy(inStrips);
+      triOffsets[stripId + 1] =
+        triOffsets[stripId] + std::max<vtkIdType>(inStrips->GetCellSize(stripId) - 2, 0);
     }
+    const vtkIdType numStripTris = triOffsets[numInStrips];
 
-    auto iter = vtk::TakeSmartPointer(inStrips->NewIterator());
-    for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal() && !abort;
-         iter->GoToNextCell(), ++inCellId)
-    {
-      if (!(inCellId % updateInterval)) // manage progress reports / early abort
-      {
-        this->UpdateProgress((float)inCellId / numInCells);
-        abort = this->CheckAbort();
-      }
-      iter->GetCurrentCell(npts, pts);
-      vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
-      for (vtkIdType i = 0; i < (npts - 2); i++)
+    vtkNew<vtkIdTypeArray> conn;
+    conn->SetNumberOfValues(3 * numStripTris);
+    GrowCellData(outCD, outCellId + numStripTris);
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+    vtkSMPTools::For(0, numInStrips, [&](vtkIdType beginStripId, vtkIdType endStripId) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType stripId = beginStripId; stripId < endStripId; ++stripId)
       {
-        outCD->CopyData(inCD, inCellId, outCellId++);
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        vtkIdType numStripPts;
+        const vtkIdType* stripPts;
+        inStrips->GetCellAtId(stripId, numStripPts, stripPts, cellPts);
+        vtkIdType* tris = conn->GetPointer(3 * triOffsets[stripId]);
+        for (vtkIdType i = 0; i < (numStripPts - 2); i++)
+        {
+          // flip ordering to preserve consistency, as in
+          // vtkTriangleStrip::DecomposeStrip
+          tris[3 * i] = stripPts[(i % 2) ? i + 1 : i];
+          tris[3 * i + 1] = stripPts[(i % 2) ? i : i + 1];
+          tris[3 * i + 2] = stripPts[i + 2];
+          outCD->CopyData(inCD, inCellId + stripId, outCellId + triOffsets[stripId] + i);
+        }
       }
-    } // for all strips
+    });
+    abort = this->GetAbortOutput();
+    inCellId += numInStrips;
+
+    vtkNew<vtkCellArray> stripTris;
+    stripTris->SetData(3, conn);
+    if (newPolys == nullptr)
+    {
+      newPolys = stripTris;
+    }
+    else
+    {
+      newPolys->Append(stripTris);
+    }
     output->SetPolys(newPolys);
   }
 
@@ -8,6 +8,9 @@
  * strips.  It also generates line segments from polylines unless PassLines
  * is off, and generates individual vertex cells from vtkVertex point lists
  * unless PassVerts is off.
+ *
+ * Polygons are triangulated and triangle strips are decomposed in parallel
+ * with vtkSMPTools. The output triangles keep the order of the input cells.
  */
 
 #ifndef vtkTriangleFilter_h
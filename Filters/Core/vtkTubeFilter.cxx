@@ -3,17 +3,27 @@
 #include "vtkTubeFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTubeFilter);
@@ -225,11 +235,38 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   this->Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
+
+  // Once the degenerate points are removed, the number of points and strips
+  // of each tube is known. The tubes are then generated in parallel, each
+  // one at its place in the output. Should a polyline fail to be tubed the
+  // places of the following ones are wrong, so the serial loop below is run
+  // instead.
+  bool generated = false;
+  if (!(inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR && range[0] < 0.0))
+  {
+    generated = this->GenerateTubesInParallel(input, output, inScalars, range, inVectors, maxSpeed,
+      generateNormals ? nullptr : inNormals, newPts, newNormals, newTCoords, newStrips);
+    abort = this->GetAbortOutput();
+    if (!generated && !abort)
+    {
+      newPts->Reset();
+      newNormals->Reset();
+      if (newTCoords)
+      {
+        newTCoords->Reset();
+      }
+      outPD->Reset();
+      outCD->Reset();
+      newStrips->Reset();
+    }
+  }
+
   // the line cellIds start after the last vert cellId
   inCellId = input->GetNumberOfVerts();
   int checkAbortInterval = std::min(numLines / 10 + 1, (vtkIdType)1000);
   int progressCounter = 0;
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
+  for (inLines->InitTraversal(); !generated && !abort && inLines->GetNextCell(npts, ptsOrig);
+       inCellId++)
   {
     this->UpdateProgress((double)inCellId / numLines);
     if (progressCounter % checkAbortInterval == 0 && this->CheckAbort())
@@ -326,10 +363,207 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+bool vtkTubeFilter::GenerateTubesInParallel(vtkPolyData* input, vtkPolyData* output,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+  vtkDataArray* inNormals, vtkPoints* newPts, vtkFloatArray* newNormals,
+  vtkFloatArray* newTCoords, vtkCellArray* newStrips)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inLines = input->GetLines();
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+  const vtkIdType numVerts = input->GetNumberOfVerts();
+
+  // Copy the point ids of a polyline without its degenerate segments.
+  auto getLinePoints = [&](vtkCellArrayIterator* iter, vtkIdType lineId,
+                         std::vector<vtkIdType>& pts) {
+    vtkIdType npts;
+    const vtkIdType* ptsOrig;
+    iter->GetCellAtId(lineId, npts, ptsOrig);
+    pts.assign(ptsOrig, ptsOrig + npts);
+    if (npts < 2)
+    {
+      return npts;
+    }
+    return static_cast<vtkIdType>(
+      std::unique(pts.begin(), pts.end(), IdPointsEqual(inPts)) - pts.begin());
+  };
+
+  // Count the points, strips and strip connectivity of each tube.
+  vtkIdType numSideStrips = 0;
+  for (int k = this->Offset; k < (this->NumberOfSides + this->Offset); k += this->OnRatio)
+  {
+    numSideStrips++;
+  }
+  std::vector<vtkIdType> lineNumPts(numLines);
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localPts;
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkSmartPointer<vtkCellArrayIterator> iter;
+    iter.TakeReference(inLines->NewIterator());
+    std::vector<vtkIdType>& pts = localPts.Local();
+    for (vtkIdType lineId = begin; lineId < end; lineId++)
+    {
+      const vtkIdType npts = getLinePoints(iter, lineId, pts);
+      lineNumPts[lineId] = npts < 2 ? 0 : npts;
+    }
+  });
+
+  std::vector<vtkIdType> ptOffsets(numLines + 1);
+  std::vector<vtkIdType> cellOffsets(numLines + 1);
+  std::vector<vtkIdType> connOffsets(numLines + 1);
+  ptOffsets[0] = cellOffsets[0] = connOffsets[0] = 0;
+  for (vtkIdType lineId = 0; lineId < numLines; lineId++)
+  {
+    const vtkIdType npts = lineNumPts[lineId];
+    ptOffsets[lineId + 1] = ptOffsets[lineId];
+    cellOffsets[lineId + 1] = cellOffsets[lineId];
+    connOffsets[lineId + 1] = connOffsets[lineId];
+    if (npts > 0)
+    {
+      ptOffsets[lineId + 1] = this->ComputeOffset(ptOffsets[lineId], npts);
+      cellOffsets[lineId + 1] += numSideStrips + (this->Capping ? 2 : 0);
+      connOffsets[lineId + 1] +=
+        2 * npts * numSideStrips + (this->Capping ? 2 * this->NumberOfSides : 0);
+    }
+  }
+  const vtkIdType numNewPts = ptOffsets[numLines];
+  const vtkIdType numNewCells = cellOffsets[numLines];
+
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  if (newTCoords)
+  {
+    newTCoords->SetNumberOfTuples(numNewPts);
+  }
+  outPD->SetNumberOfTuples(numNewPts);
+  outCD->SetNumberOfTuples(numNewCells);
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numNewCells + 1);
+  stripOffsets->SetValue(numNewCells, connOffsets[numLines]);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(connOffsets[numLines]);
+
+  // Generate the tubes. Normals are generated per polyline in thread local
+  // arrays since polylines may share points.
+  std::atomic<bool> failed(false);
+  vtkSMPThreadLocalObject<vtkCellArray> localStrips;
+  vtkSMPThreadLocalObject<vtkPoints> localLinePts;
+  vtkSMPThreadLocalObject<vtkCellArray> localLine;
+  vtkSMPThreadLocalObject<vtkFloatArray> localNormals;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localNormalIds;
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkSmartPointer<vtkCellArrayIterator> iter;
+    iter.TakeReference(inLines->NewIterator());
+    std::vector<vtkIdType>& pts = localPts.Local();
+    vtkCellArray* strips = localStrips.Local();
+    vtkPoints* linePts = localLinePts.Local();
+    linePts->SetDataTypeToDouble();
+    vtkCellArray* line = localLine.Local();
+    vtkFloatArray* lineNormals = localNormals.Local();
+    lineNormals->SetNumberOfComponents(3);
+    std::vector<vtkIdType>& normalIds = localNormalIds.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (vtkIdType lineId = begin; lineId < end && !failed; lineId++)
+    {
+      if (isFirst && !(lineId % 1000))
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+
+      const vtkIdType npts = lineNumPts[lineId];
+      if (npts == 0)
+      {
+        continue; // skip tubing this polyline
+      }
+      getLinePoints(iter, lineId, pts);
+      const vtkIdType offset = ptOffsets[lineId];
+      const vtkIdType inCellId = numVerts + lineId;
+
+      // If necessary calculate the normals of the polyline on a copy of
+      // its points.
+      vtkDataArray* normals = inNormals;
+      const vtkIdType* ids = pts.data();
+      if (!inNormals)
+      {
+        normalIds.resize(npts);
+        std::iota(normalIds.begin(), normalIds.end(), 0);
+        linePts->SetNumberOfPoints(npts);
+        for (vtkIdType i = 0; i < npts; i++)
+        {
+          double x[3];
+          inPts->GetPoint(pts[i], x);
+          linePts->SetPoint(i, x);
+        }
+        line->Reset();
+        line->InsertNextCell(npts, normalIds.data());
+        lineNormals->SetNumberOfTuples(npts);
+        vtkPolyLine::GenerateSlidingNormals(linePts, line, lineNormals);
+        normals = lineNormals;
+        ids = normalIds.data();
+      }
+
+      if (!this->GeneratePoints(offset, npts, pts.data(), inPts, newPts, pd, outPD, newNormals,
+            inScalars, range, inVectors, maxSpeed, normals, ids))
+      {
+        failed = true;
+        break;
+      }
+
+      // Generate the strips in a local cell array and copy them at their
+      // place in the output.
+      strips->Reset();
+      this->GenerateStrips(offset, npts, pts.data(), inCellId, cd, nullptr, strips);
+      vtkIdType cellId = cellOffsets[lineId];
+      vtkIdType connId = connOffsets[lineId];
+      for (vtkIdType stripId = 0; stripId < strips->GetNumberOfCells(); stripId++, cellId++)
+      {
+        vtkIdType nStripPts;
+        const vtkIdType* stripPts;
+        strips->GetCellAtId(stripId, nStripPts, stripPts);
+        stripOffsets->SetValue(cellId, connId);
+        for (vtkIdType i = 0; i < nStripPts; i++)
+        {
+          stripConnectivity->SetValue(connId++, stripPts[i]);
+        }
+        outCD->CopyData(cd, inCellId, cellId);
+      }
+
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts.data(), inPts, inScalars, newTCoords);
+      }
+    }
+  });
+
+  if (failed || this->GetAbortOutput())
+  {
+    return false;
+  }
+  newStrips->SetData(stripOffsets, stripConnectivity);
+  return true;
+}
+
 int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
   double maxSpeed, vtkDataArray* inNormals)
+{
+  return this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
+    range, inVectors, maxSpeed, inNormals, pts);
+}
+
+int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
+  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
+  double maxSpeed, vtkDataArray* inNormals, const vtkIdType* normalIds)
 {
   vtkIdType j;
   int i, k;
@@ -388,7 +622,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
       }
     }
 
-    inNormals->GetTuple(pts[j], n);
+    inNormals->GetTuple(normalIds[j], n);
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
@@ -447,7 +681,9 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
     {
-      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(inVectors->GetTuple(pts[j])));
+      double vector[3];
+      inVectors->GetTuple(pts[j], vector);
+      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(vector));
       if (sFactor > this->RadiusFactor)
       {
         sFactor = this->RadiusFactor;
@@ -455,8 +691,9 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR_NORM)
     {
-      sFactor =
-        1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(inVectors->GetTuple(pts[j])) / maxSpeed;
+      double vector[3];
+      inVectors->GetTuple(pts[j], vector);
+      sFactor = 1.0 + (this->RadiusFactor - 1.0) * vtkMath::Norm(vector) / maxSpeed;
     }
     else if (inScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
     {
@@ -570,7 +807,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
       i1 = k % this->NumberOfSides;
       i2 = (k + 1) % this->NumberOfSides;
       outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      if (outCD)
+      {
+        outCD->CopyData(cd, inCellId, outCellId);
+      }
       for (i = 0; i < npts; i++)
       {
         i3 = i * this->NumberOfSides;
@@ -586,7 +826,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
       i1 = 2 * (k % this->NumberOfSides) + 1;
       i2 = 2 * ((k + 1) % this->NumberOfSides);
       outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      if (outCD)
+      {
+        outCD->CopyData(cd, inCellId, outCellId);
+      }
       for (i = 0; i < npts; i++)
       {
         i3 = i * 2 * this->NumberOfSides;
@@ -610,7 +853,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
 
     // The start cap
     outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
+    if (outCD)
+    {
+      outCD->CopyData(cd, inCellId, outCellId);
+    }
     newStrips->InsertCellPoint(startIdx);
     newStrips->InsertCellPoint(startIdx + 1);
     for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
@@ -632,7 +878,10 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     // The end cap - reversed order to be consistent with normal
     startIdx += this->NumberOfSides;
     outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
+    if (outCD)
+    {
+      outCD->CopyData(cd, inCellId, outCellId);
+    }
     newStrips->InsertCellPoint(startIdx);
     newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
     for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
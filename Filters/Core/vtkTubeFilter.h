@@ -33,6 +33,12 @@
  * can be removed with vtkCleanPolyData.) If a line does not meet this
  * criteria, then that line is not tubed.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The tubes of the polylines
+ * are generated in parallel and the output does not depend on the number of
+ * threads. If a polyline cannot be tubed, the filter falls back to serial
+ * execution.
+ *
  * @sa
  * vtkRibbonFilter vtkStreamTracer vtkTubeBender
  *
@@ -246,11 +252,24 @@ protected:
     vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
     vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
     vtkDataArray* inNormals);
+  // Same as above, the normal of the j-th point being looked up at
+  // normalIds[j] in inNormals.
+  int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
+    vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
+    vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+    vtkDataArray* inNormals, const vtkIdType* normalIds);
   void GenerateStrips(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
     vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
   void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
+  // Generate all the tubes with vtkSMPTools, normals being generated per
+  // polyline when inNormals is nullptr. Returns false if a polyline could
+  // not be tubed or if the execution was aborted.
+  bool GenerateTubesInParallel(vtkPolyData* input, vtkPolyData* output, vtkDataArray* inScalars,
+    double range[2], vtkDataArray* inVectors, double maxSpeed, vtkDataArray* inNormals,
+    vtkPoints* newPts, vtkFloatArray* newNormals, vtkFloatArray* newTCoords,
+    vtkCellArray* newStrips);
 
   // Helper data members
   double Theta;
@@ -59,8 +59,13 @@
 #include "vtkBezierWedge.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
 #include "vtkMath.h"
 #include "vtkMathUtilities.h"
+#include "vtkNew.h"
 #include "vtkPoints.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -130,6 +135,8 @@ static vtkSmartPointer<vtkBezierQuadrilateral> MakeBezierQuadrilateral();
 static vtkSmartPointer<vtkBezierTetra> MakeBezierTetra();
 static vtkSmartPointer<vtkBezierHexahedron> MakeBezierHexahedron();
 static vtkSmartPointer<vtkBezierWedge> MakeBezierWedge();
+
+static bool ValidatesFloatPointCells();
 //------------------------------------------------------------------------------
 
 int TestCellValidator(int, char*[])
@@ -274,6 +281,11 @@ int TestCellValidator(int, char*[])
     return EXIT_FAILURE;
   }
 
+  if (!ValidatesFloatPointCells())
+  {
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -1279,3 +1291,32 @@ vtkSmartPointer<vtkBezierWedge> MakeBezierWedge()
 
   return wedge;
 }
+
+// The filter must give the same states for float and double points, the
+// checks of most nonlinear and 3D cells evaluating them in double precision.
+bool ValidatesFloatPointCells()
+{
+  const int cellTypes[] = { VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID, VTK_QUADRATIC_TETRA,
+    VTK_QUADRATIC_HEXAHEDRON };
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(2, 2, 2);
+    source->SetOutputPrecision(vtkAlgorithm::SINGLE_PRECISION);
+    vtkNew<vtkCellValidator> validator;
+    validator->SetInputConnection(source->GetOutputPort());
+    validator->Update();
+    vtkDataArray* states = validator->GetOutput()->GetCellData()->GetArray("ValidityState");
+    for (vtkIdType cellId = 0; cellId < states->GetNumberOfTuples(); ++cellId)
+    {
+      if (states->GetTuple1(cellId) != static_cast<double>(vtkCellValidator::State::Valid))
+      {
+        std::cout << "Cell " << cellId << " of type " << cellType
+                  << " with float points is not valid." << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Measure the time vtkCellValidator takes to check a mesh of linear,
+// nonlinear and polyhedral cells with one thread and with the default number
+// of threads, and report them as CDash measurements.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkCellValidator.h"
+#include "vtkDataArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// Number of validations over which the time is averaged.
+constexpr int NumberOfRuns = 3;
+
+// Report the time of one validation, in seconds.
+void Report(const std::string& name, double seconds)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">"
+            << seconds / NumberOfRuns << "</DartMeasurement>" << std::endl;
+}
+
+// Validate the mesh with a given maximum number of threads, 0 meaning the
+// default of the SMP backend.
+double TimeValidation(vtkCellValidator* validator, int numberOfThreads)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      timer->StartTimer();
+      for (int run = 0; run < NumberOfRuns; ++run)
+      {
+        validator->Modified();
+        validator->Update();
+      }
+      timer->StopTimer();
+    });
+  return timer->GetElapsedTime();
+}
+}
+
+int TestCellValidatorPerformance(int, char*[])
+{
+  // Cells whose checks cost from a few to many parametric evaluations, all
+  // valid so that nothing is reported.
+  const int cellTypes[] = { VTK_TETRA, VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID,
+    VTK_HEXAGONAL_PRISM, VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON, VTK_LAGRANGE_HEXAHEDRON,
+    VTK_BEZIER_TETRAHEDRON, VTK_BEZIER_WEDGE };
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(6, 6, 6);
+    append->AddInputConnection(source->GetOutputPort());
+  }
+  append->Update();
+
+  vtkNew<vtkCellValidator> validator;
+  validator->SetInputData(append->GetOutput());
+
+  ::Report("CellValidatorOneThread", ::TimeValidation(validator, 1));
+  vtkNew<vtkUnstructuredGrid> serial;
+  serial->DeepCopy(validator->GetOutput());
+  ::Report("CellValidatorDefaultThreads", ::TimeValidation(validator, 0));
+  std::cout << "<DartMeasurement name=\"NumberOfThreads\" type=\"numeric/integer\">"
+            << vtkSMPTools::GetEstimatedDefaultNumberOfThreads() << "</DartMeasurement>"
+            << std::endl;
+
+  if (!vtkTestUtilities::CompareDataObjectsExactly(serial, validator->GetOutput()))
+  {
+    vtkLog(ERROR, "The states differ with one and the default number of threads.");
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* states = serial->GetCellData()->GetArray("ValidityState");
+  for (vtkIdType cellId = 0; cellId < serial->GetNumberOfCells(); ++cellId)
+  {
+    if (states->GetComponent(cellId, 0) != vtkCellValidator::Valid)
+    {
+      vtkLog(ERROR, "Cell " << cellId << " is not valid.");
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
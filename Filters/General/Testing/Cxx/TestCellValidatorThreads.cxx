@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel vtkCellValidator gives the states of the serial
+// checks for linear, nonlinear and polyhedral cells with any number of
+// threads, and that only the cells with moved points become invalid.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkCellValidator.h"
+#include "vtkDataArray.h"
+#include "vtkGenericCell.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkOutputWindow.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Validate with 1 and 4 threads, silencing the report of the invalid cells.
+bool Validate(vtkCellValidator* validator, vtkUnstructuredGrid* output)
+{
+  vtkOutputWindow* outputWindow = vtkOutputWindow::GetInstance();
+  int displayMode = outputWindow->GetDisplayMode();
+  outputWindow->SetDisplayModeToNever();
+  const bool same = vtkTestUtilities::CompareThreadedOutputs(validator, 4, output);
+  outputWindow->SetDisplayMode(displayMode);
+  return same && output->GetCellData()->GetArray("ValidityState");
+}
+
+// The validator reports the faces of the quadratic wedges and of the
+// polyhedra of vtkCellTypeSource as oriented incorrectly.
+bool IsReportedInvalid(int cellType)
+{
+  return cellType == VTK_QUADRATIC_WEDGE || cellType == VTK_POLYHEDRON;
+}
+
+// Blocks of cells of many types. Moving every 211th point makes some of the
+// cells using it invalid.
+vtkSmartPointer<vtkUnstructuredGrid> MakeMesh(bool movePoints)
+{
+  const int cellTypes[] = { VTK_TRIANGLE, VTK_QUAD, VTK_POLYGON, VTK_TETRA, VTK_HEXAHEDRON,
+    VTK_WEDGE, VTK_PYRAMID, VTK_PENTAGONAL_PRISM, VTK_HEXAGONAL_PRISM, VTK_POLYHEDRON,
+    VTK_QUADRATIC_TRIANGLE, VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON, VTK_QUADRATIC_WEDGE,
+    VTK_LAGRANGE_TRIANGLE, VTK_LAGRANGE_HEXAHEDRON, VTK_BEZIER_TETRAHEDRON, VTK_BEZIER_WEDGE };
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(5, 5, 5);
+    source->Update();
+    append->AddInputData(source->GetOutput());
+  }
+  append->Update();
+
+  vtkSmartPointer<vtkUnstructuredGrid> mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  mesh->DeepCopy(append->GetOutput());
+  if (!movePoints)
+  {
+    return mesh;
+  }
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2024);
+  vtkPoints* points = mesh->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ptId += 211)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] += random->GetNextRangeValue(-1.0, 1.0);
+    }
+    points->SetPoint(ptId, x);
+  }
+  return mesh;
+}
+}
+
+int TestCellValidatorThreads(int, char*[])
+{
+  // The other cells of the sources are valid.
+  vtkNew<vtkCellValidator> validator;
+  validator->SetInputData(MakeMesh(false));
+  vtkNew<vtkUnstructuredGrid> output;
+  if (!Validate(validator, output))
+  {
+    vtkLog(ERROR, "The states differ with 1 and 4 threads.");
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* states = output->GetCellData()->GetArray("ValidityState");
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    if (states->GetComponent(cellId, 0) != vtkCellValidator::Valid &&
+      !IsReportedInvalid(output->GetCellType(cellId)))
+    {
+      vtkLog(ERROR,
+        "Cell " << cellId << " of type " << output->GetCellType(cellId) << " is not valid.");
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Only the cells using a moved point may become invalid, and their states
+  // are those of the serial checks.
+  vtkSmartPointer<vtkUnstructuredGrid> mesh = MakeMesh(true);
+  validator->SetInputData(mesh);
+  if (!Validate(validator, output))
+  {
+    vtkLog(ERROR, "The states differ with 1 and 4 threads.");
+    return EXIT_FAILURE;
+  }
+  states = output->GetCellData()->GetArray("ValidityState");
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType numInvalid = 0;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    mesh->GetCell(cellId, cell);
+    bool moved = false;
+    for (vtkIdType i = 0; i < cell->GetNumberOfPoints(); ++i)
+    {
+      moved |= cell->GetPointId(i) % 211 == 0;
+    }
+    const double state = vtkCellValidator::Check(cell, validator->GetTolerance());
+    if (states->GetComponent(cellId, 0) != state ||
+      (!moved && state != vtkCellValidator::Valid && !IsReportedInvalid(cell->GetCellType())))
+    {
+      vtkLog(ERROR, "Unexpected state of cell " << cellId << " of type " << cell->GetCellType());
+      return EXIT_FAILURE;
+    }
+    numInvalid += state != vtkCellValidator::Valid ? 1 : 0;
+  }
+  if (numInvalid == 0)
+  {
+    vtkLog(ERROR, "Expected invalid cells.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
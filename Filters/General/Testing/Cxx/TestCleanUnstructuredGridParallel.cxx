@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel merging of vtkCleanUnstructuredGrid produces the
+// same output as the incremental insertion, whatever the number of threads.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkCleanUnstructuredGrid.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <array>
+#include <cstdlib>
+#include <set>
+
+namespace
+{
+// Tetrahedra and triangles over a small set of points, each point being
+// duplicated several times. Some points are not used by any cell.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  unsigned int seed = 54321;
+  auto random = [&seed](int n) {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<int>((seed >> 16) % n);
+  };
+
+  const int numDistinct = 50;
+  const int numPts = 4 * numDistinct;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfValues(numPts);
+  for (int i = 0; i < numPts; ++i)
+  {
+    const int p = random(numDistinct);
+    points->SetPoint(i, 0.1 * (p % 5), 0.1 * ((p / 5) % 5), 0.1 * (p / 25));
+    pointIds->SetValue(i, i);
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(pointIds);
+  grid->AllocateEstimate(300, 4);
+  vtkIdType ids[4];
+  for (int cell = 0; cell < 300; ++cell)
+  {
+    const bool tetra = random(2) != 0;
+    for (int i = 0; i < (tetra ? 4 : 3); ++i)
+    {
+      // Only use three quarters of the points
+      ids[i] = random(3 * numPts / 4);
+    }
+    grid->InsertNextCell(tetra ? VTK_TETRA : VTK_TRIANGLE, tetra ? 4 : 3, ids);
+  }
+  return grid;
+}
+
+// Number of distinct coordinates among the first numPts points.
+size_t CountDistinctPoints(vtkUnstructuredGrid* grid, vtkIdType numPts)
+{
+  std::set<std::array<double, 3>> coordinates;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    std::array<double, 3> p;
+    grid->GetPoint(ptId, p.data());
+    coordinates.insert(p);
+  }
+  return coordinates.size();
+}
+}
+
+int TestCleanUnstructuredGridParallel(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> input = MakeGrid();
+
+  bool success = true;
+  for (bool removePointsWithoutCells : { false, true })
+  {
+    // A vtkPointLocator keeps the incremental insertion.
+    vtkNew<vtkCleanUnstructuredGrid> serialClean;
+    serialClean->SetInputData(input);
+    serialClean->SetRemovePointsWithoutCells(removePointsWithoutCells);
+    vtkNew<vtkPointLocator> locator;
+    serialClean->SetLocator(locator);
+    serialClean->Update();
+
+    vtkNew<vtkCleanUnstructuredGrid> clean;
+    clean->SetInputData(input);
+    clean->SetRemovePointsWithoutCells(removePointsWithoutCells);
+    vtkNew<vtkUnstructuredGrid> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(clean, 4, output) ||
+      !vtkTestUtilities::CompareDataObjectsExactly(serialClean->GetOutput(), output))
+    {
+      vtkLog(ERROR,
+        "Parallel merging differs when " << (removePointsWithoutCells ? "removing" : "keeping")
+                                         << " points without cells.");
+      success = false;
+    }
+
+    // The cells only use the first three quarters of the points.
+    const vtkIdType numUsedPts = removePointsWithoutCells ? 3 * input->GetNumberOfPoints() / 4
+                                                          : input->GetNumberOfPoints();
+    if (static_cast<size_t>(output->GetNumberOfPoints()) !=
+      ::CountDistinctPoints(input, numUsedPts))
+    {
+      vtkLog(ERROR,
+        "Expected " << ::CountDistinctPoints(input, numUsedPts) << " merged points, got "
+                    << output->GetNumberOfPoints());
+      success = false;
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
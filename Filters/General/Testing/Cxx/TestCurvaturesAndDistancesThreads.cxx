@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel vtkCurvatures and vtkHausdorffDistancePointSetFilter
+// do not depend on the number of threads and match the analytic values on
+// spheres, and that the batched evaluation of vtkImplicitPolyDataDistance
+// matches the evaluation point by point.
+
+#include "vtkCurvatures.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkHausdorffDistancePointSetFilter.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Mean of an array over the points.
+double Mean(vtkDataArray* array)
+{
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+  {
+    sum += array->GetTuple1(i);
+  }
+  return sum / array->GetNumberOfTuples();
+}
+
+bool TestCurvatures(vtkSphereSource* sphere)
+{
+  bool success = true;
+  const int types[] = { VTK_CURVATURE_GAUSS, VTK_CURVATURE_MEAN, VTK_CURVATURE_MAXIMUM,
+    VTK_CURVATURE_MINIMUM };
+  const char* names[] = { "Gauss_Curvature", "Mean_Curvature", "Maximum_Curvature",
+    "Minimum_Curvature" };
+  // A sphere of radius r has a Gaussian curvature of 1 / r^2 and principal
+  // curvatures of 1 / r.
+  const double radius = sphere->GetRadius();
+  const double expected[] = { 1.0 / (radius * radius), 1.0 / radius, 1.0 / radius,
+    1.0 / radius };
+  for (int i = 0; i < 4; ++i)
+  {
+    vtkNew<vtkCurvatures> curvatures;
+    curvatures->SetInputConnection(sphere->GetOutputPort());
+    curvatures->SetCurvatureType(types[i]);
+    vtkNew<vtkPolyData> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(curvatures, 4, output))
+    {
+      vtkLog(ERROR, << names[i] << " differs with 1 and 4 threads.");
+      success = false;
+      continue;
+    }
+    const double mean = ::Mean(output->GetPointData()->GetArray(names[i]));
+    if (std::abs(mean - expected[i]) > 0.05 * expected[i])
+    {
+      vtkLog(ERROR, "Mean " << names[i] << " is " << mean << ", expected " << expected[i]);
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool TestHausdorffDistance(vtkSphereSource* sphereA, vtkSphereSource* sphereB)
+{
+  // Sphere B, of radius 0.6, is offset by 0.1 from sphere A, of radius 0.5:
+  // the farthest points of each sphere are 0.2 away from the other one.
+  const double expected = 0.2;
+  bool success = true;
+  for (int method : { vtkHausdorffDistancePointSetFilter::POINT_TO_POINT,
+         vtkHausdorffDistancePointSetFilter::POINT_TO_CELL })
+  {
+    vtkNew<vtkHausdorffDistancePointSetFilter> hausdorff;
+    hausdorff->SetInputConnection(0, sphereA->GetOutputPort());
+    hausdorff->SetInputConnection(1, sphereB->GetOutputPort());
+    hausdorff->SetTargetDistanceMethod(method);
+    for (int port = 0; port < 2; ++port)
+    {
+      vtkNew<vtkPolyData> output;
+      if (!vtkTestUtilities::CompareThreadedOutputs(hausdorff, 4, output, port))
+      {
+        vtkLog(ERROR,
+          "Hausdorff distance differs with 1 and 4 threads for method "
+            << method << " and output " << port);
+        success = false;
+      }
+      const double relativeDistance = hausdorff->GetRelativeDistance()[port];
+      if (std::abs(relativeDistance - expected) > 0.02)
+      {
+        vtkLog(ERROR,
+          "Relative distance " << relativeDistance << " for method " << method << " and output "
+                               << port << ", expected " << expected);
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+
+bool TestImplicitPolyDataDistance(vtkSphereSource* sphere)
+{
+  sphere->Update();
+  vtkNew<vtkImplicitPolyDataDistance> distance;
+  distance->SetInput(sphere->GetOutput());
+
+  vtkNew<vtkPointSource> pointSource;
+  pointSource->SetNumberOfPoints(1000);
+  pointSource->SetRadius(1.0);
+  pointSource->Update();
+  vtkDataArray* points = pointSource->GetOutput()->GetPoints()->GetData();
+
+  vtkNew<vtkDoubleArray> values;
+  vtkNew<vtkDoubleArray> closestPoints;
+  vtkNew<vtkDoubleArray> gradients;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() {
+    distance->EvaluateFunctionAndGetClosestPoint(points, values, closestPoints, gradients);
+  });
+
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfTuples(); ++ptId)
+  {
+    double x[3], closestPoint[3], gradient[3];
+    points->GetTuple(ptId, x);
+    const double value = distance->EvaluateFunctionAndGetClosestPoint(x, closestPoint);
+    distance->EvaluateGradient(x, gradient);
+    const double* batchClosestPoint = closestPoints->GetTuple3(ptId);
+    const double* batchGradient = gradients->GetTuple3(ptId);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (closestPoint[i] != batchClosestPoint[i] || gradient[i] != batchGradient[i])
+      {
+        vtkLog(ERROR, "Batched evaluation differs at point " << ptId);
+        return false;
+      }
+    }
+    if (value != values->GetValue(ptId))
+    {
+      vtkLog(ERROR, "Batched evaluation differs at point " << ptId);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestCurvaturesAndDistancesThreads(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphereA;
+  sphereA->SetThetaResolution(48);
+  sphereA->SetPhiResolution(48);
+
+  vtkNew<vtkSphereSource> sphereB;
+  sphereB->SetCenter(0.1, 0.0, 0.0);
+  sphereB->SetRadius(0.6);
+  sphereB->SetThetaResolution(32);
+  sphereB->SetPhiResolution(24);
+
+  bool success = TestCurvatures(sphereA);
+  success &= TestHausdorffDistance(sphereA, sphereB);
+  success &= TestImplicitPolyDataDistance(sphereB);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
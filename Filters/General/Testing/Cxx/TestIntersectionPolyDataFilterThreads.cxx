@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel triangle intersections of
+// vtkIntersectionPolyDataFilter give the same intersection lines and split
+// surfaces whatever the number of threads, for two spheres and for a sphere
+// and an open plane, and that the intersection lines lie on both spheres.
+
+#include "vtkIntersectionPolyDataFilter.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkTriangleFilter.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// The intersection points lie on the facets of both spheres.
+bool OnBothSpheres(vtkPolyData* lines, const double centers[2][3])
+{
+  for (vtkIdType ptId = 0; ptId < lines->GetNumberOfPoints(); ++ptId)
+  {
+    double p[3];
+    lines->GetPoint(ptId, p);
+    for (int i = 0; i < 2; ++i)
+    {
+      const double radius = std::sqrt(vtkMath::Distance2BetweenPoints(p, centers[i]));
+      if (radius < 0.49 || radius > 0.5 + 1e-6)
+      {
+        vtkLog(ERROR,
+          "Intersection point " << ptId << " is off sphere " << i << ", at radius " << radius);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameThreadedOutputs(vtkIntersectionPolyDataFilter* intersection, vtkPolyData* outputs[3])
+{
+  const char* names[3] = { "intersection lines", "first split surface", "second split surface" };
+  bool success = true;
+  for (int port = 0; port < 3; ++port)
+  {
+    if (!vtkTestUtilities::CompareThreadedOutputs(intersection, 4, outputs[port], port))
+    {
+      vtkLog(ERROR, "Different " << names[port] << " with 1 and 4 threads.");
+      success = false;
+    }
+  }
+  if (outputs[0]->GetNumberOfLines() == 0)
+  {
+    vtkLog(ERROR, "No intersection lines found.");
+    success = false;
+  }
+  return success;
+}
+}
+
+int TestIntersectionPolyDataFilterThreads(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere0;
+  sphere0->SetThetaResolution(40);
+  sphere0->SetPhiResolution(30);
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetCenter(0.23, 0.11, 0.07);
+  sphere1->SetThetaResolution(35);
+  sphere1->SetPhiResolution(25);
+
+  vtkNew<vtkIntersectionPolyDataFilter> intersection;
+  intersection->SetInputConnection(0, sphere0->GetOutputPort());
+  intersection->SetInputConnection(1, sphere1->GetOutputPort());
+
+  vtkSmartPointer<vtkPolyData> outputs[3];
+  vtkPolyData* outputPointers[3];
+  for (int port = 0; port < 3; ++port)
+  {
+    outputs[port] = vtkSmartPointer<vtkPolyData>::New();
+    outputPointers[port] = outputs[port];
+  }
+  bool success = ::SameThreadedOutputs(intersection, outputPointers);
+  const double centers[2][3] = { { 0.0, 0.0, 0.0 }, { 0.23, 0.11, 0.07 } };
+  success &= ::OnBothSpheres(outputs[0], centers);
+
+  // An open surface crossing the first sphere.
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(-0.7, -0.6, 0.05);
+  plane->SetPoint1(0.8, -0.6, 0.15);
+  plane->SetPoint2(-0.7, 0.9, 0.1);
+  plane->SetResolution(13, 10);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(plane->GetOutputPort());
+  intersection->SetInputConnection(1, triangles->GetOutputPort());
+  success &= ::SameThreadedOutputs(intersection, outputPointers);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkMarchingCubes and vtkDiscreteMarchingCubes do
+// not depend on the number of threads, that they merge the points as the
+// serial insertion with a locator does, and that the points lie on the
+// contours.
+
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkDiscreteMarchingCubes.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMarchingCubes.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+bool TestContour(vtkAlgorithm* contour, vtkPolyData* output, const char* name)
+{
+  if (!vtkTestUtilities::CompareThreadedOutputs(contour, 4, output) ||
+    output->GetNumberOfCells() == 0)
+  {
+    vtkLog(ERROR, << name << " differs with 1 and 4 threads.");
+    return false;
+  }
+  return true;
+}
+
+// Each point lies on a voxel edge, where the linear interpolation of the
+// input scalars gives one of the contour values.
+bool OnContourValues(vtkPolyData* output, vtkImageData* image, vtkMarchingCubes* contour)
+{
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkNew<vtkIdList> cellPts;
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], pcoords[3], weights[8];
+    output->GetPoint(ptId, x);
+    int subId;
+    const vtkIdType cellId =
+      image->FindCell(x, nullptr, -1, 1e-6, subId, pcoords, weights);
+    if (cellId < 0)
+    {
+      vtkLog(ERROR, "Point " << ptId << " is outside the image.");
+      return false;
+    }
+    image->GetCellPoints(cellId, cellPts);
+    double value = 0.0;
+    for (vtkIdType i = 0; i < cellPts->GetNumberOfIds(); ++i)
+    {
+      value += weights[i] * scalars->GetTuple1(cellPts->GetId(i));
+    }
+    bool found = false;
+    for (int i = 0; i < contour->GetNumberOfContours(); ++i)
+    {
+      found |= std::abs(value - contour->GetValue(i)) < 1e-3;
+    }
+    if (!found)
+    {
+      vtkLog(ERROR, "Point " << ptId << " has the value " << value);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Each point of a discrete surface lies half-way between 2 voxel points.
+bool HalfWay(vtkPolyData* output)
+{
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    int numHalves = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+      numHalves += x[i] - std::floor(x[i]) == 0.5;
+    }
+    if (numHalves != 1)
+    {
+      vtkLog(ERROR, "Point " << ptId << " is not half-way between 2 voxel points.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Each output point must be unique.
+bool HasUniquePoints(vtkPolyData* output)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkMergePoints> locator;
+  locator->InitPointInsertion(points, output->GetBounds());
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    vtkIdType id;
+    if (!locator->InsertUniquePoint(output->GetPoint(ptId), id))
+    {
+      vtkLog(ERROR, "Point " << ptId << " is duplicated.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Blocks of labels 1 to 3, surrounded by a background of label 0.
+vtkSmartPointer<vtkImageData> MakeLabels()
+{
+  const int size = 24;
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(-2, size - 3, 0, size - 1, 5, size + 4);
+  vtkNew<vtkUnsignedCharArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfValues(size * size * size);
+  vtkIdType idx = 0;
+  for (int k = 0; k < size; ++k)
+  {
+    for (int j = 0; j < size; ++j)
+    {
+      for (int i = 0; i < size; ++i, ++idx)
+      {
+        const bool inside = i > 1 && j > 1 && k > 1 && i < size - 2 && j < size - 2 && k < size - 2;
+        labels->SetValue(idx, inside ? 1 + (i / 7 + j / 5 + k / 6) % 3 : 0);
+      }
+    }
+  }
+  image->GetPointData()->SetScalars(labels);
+  return image;
+}
+}
+
+int TestMarchingCubesThreads(int, char*[])
+{
+  bool success = true;
+
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+
+  vtkNew<vtkMarchingCubes> marchingCubes;
+  marchingCubes->SetInputConnection(wavelet->GetOutputPort());
+  marchingCubes->SetValue(0, 100.0);
+  marchingCubes->SetValue(1, 150.0);
+  marchingCubes->SetValue(2, 200.0);
+  marchingCubes->ComputeGradientsOn();
+  vtkNew<vtkPolyData> output;
+  success &= TestContour(marchingCubes, output, "vtkMarchingCubes") &&
+    ::HasUniquePoints(output) && ::OnContourValues(output, wavelet->GetOutput(), marchingCubes);
+
+  // With another locator, the points are merged serially.
+  vtkNew<vtkPointLocator> marchingCubesLocator;
+  marchingCubes->SetLocator(marchingCubesLocator);
+  success &= TestContour(marchingCubes, output, "vtkMarchingCubes with a vtkPointLocator");
+
+  // The vertices of the discrete surfaces lie half-way between voxel points,
+  // so a vtkPointLocator merges them exactly as the parallel merging does.
+  vtkSmartPointer<vtkImageData> labels = MakeLabels();
+  vtkNew<vtkDiscreteMarchingCubes> discrete;
+  discrete->SetInputData(labels);
+  discrete->GenerateValues(3, 1.0, 3.0);
+  discrete->ComputeAdjacentScalarsOn();
+  vtkNew<vtkPolyData> discreteOutput;
+  success &= TestContour(discrete, discreteOutput, "vtkDiscreteMarchingCubes") &&
+    ::HasUniquePoints(discreteOutput) && ::HalfWay(discreteOutput);
+
+  vtkNew<vtkPointLocator> discreteLocator;
+  discrete->SetLocator(discreteLocator);
+  discrete->Update();
+  if (!vtkTestUtilities::CompareDataObjectsExactly(discrete->GetOutput(), discreteOutput))
+  {
+    vtkLog(ERROR, "vtkDiscreteMarchingCubes differs from the serial merging.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkMultiThreshold does not depend on the number of
+// threads and outputs the cells of each set in the order of the input cells,
+// for structured grids and for grids mixing linear, quadratic and polyhedral
+// cells.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdFilter.h"
+#include "vtkIdList.h"
+#include "vtkImageDataToPointSet.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreshold.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+vtkUnstructuredGrid* GetOutputMesh(vtkMultiBlockDataSet* output, unsigned int block)
+{
+  vtkMultiBlockDataSet* set = vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(block));
+  return set ? vtkUnstructuredGrid::SafeDownCast(set->GetBlock(0)) : nullptr;
+}
+
+// The input cells of each output of TestThreshold, found by evaluating the
+// sets on each cell.
+std::vector<std::vector<vtkIdType>> ExpectedCells(vtkDataSet* input)
+{
+  vtkDataArray* field = input->GetPointData()->GetArray("Field");
+  vtkDataArray* vector = input->GetPointData()->GetArray("Vector");
+  std::vector<std::vector<vtkIdType>> cells(8);
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCellPoints(cellId, pts);
+    bool anyInBand = false;
+    bool allInBand = true;
+    bool anyHighNorm = false;
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+    {
+      const double value = field->GetTuple1(pts->GetId(i));
+      const bool inBand = value >= -0.5 && value <= 0.5;
+      anyInBand |= inBand;
+      allInBand &= inBand;
+      anyHighNorm |= vtkMath::Norm(vector->GetTuple3(pts->GetId(i))) >= 1.0;
+    }
+    const bool lowId = cellId <= input->GetNumberOfCells() / 2.0;
+    const int count = anyInBand + anyHighNorm + lowId;
+    const bool outputs[8] = { anyInBand, allInBand, anyHighNorm, count == 3, count > 0,
+      count == 1, count % 2 == 1, count < 3 };
+    for (int i = 0; i < 8; ++i)
+    {
+      if (outputs[i])
+      {
+        cells[i].push_back(cellId);
+      }
+    }
+  }
+  return cells;
+}
+
+// Threshold the input with interval sets combined by each boolean operation,
+// check the output against a single thread, and check that each output has
+// the expected cells in the order of the input cells.
+bool TestThreshold(vtkDataSet* input, const char* name)
+{
+  vtkNew<vtkMultiThreshold> threshold;
+  threshold->SetInputData(input);
+  int sets[4];
+  sets[0] = threshold->AddBandpassIntervalSet(
+    -0.5, 0.5, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Field", 0, 0);
+  sets[1] = threshold->AddBandpassIntervalSet(
+    -0.5, 0.5, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Field", 0, 1);
+  sets[2] = threshold->AddHighpassIntervalSet(
+    1.0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "Vector", vtkMultiThreshold::L2_NORM, 0);
+  sets[3] = threshold->AddLowpassIntervalSet(
+    input->GetNumberOfCells() / 2.0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "CellIds", 0, 0);
+  threshold->OutputSet(sets[0]);
+  threshold->OutputSet(sets[1]);
+  threshold->OutputSet(sets[2]);
+  for (int operation :
+    { vtkMultiThreshold::AND, vtkMultiThreshold::OR, vtkMultiThreshold::XOR,
+      vtkMultiThreshold::WOR, vtkMultiThreshold::NAND })
+  {
+    int inputs[3] = { sets[0], sets[2], sets[3] };
+    threshold->OutputSet(threshold->AddBooleanSet(operation, 3, inputs));
+  }
+
+  vtkNew<vtkMultiBlockDataSet> output;
+  if (!vtkTestUtilities::CompareThreadedOutputs(threshold, 4, output) ||
+    output->GetNumberOfBlocks() != 8)
+  {
+    vtkLog(ERROR, "Thresholds of " << name << " differ with 1 and 4 threads.");
+    return false;
+  }
+
+  std::vector<std::vector<vtkIdType>> expectedCells = ExpectedCells(input);
+  for (unsigned int block = 0; block < output->GetNumberOfBlocks(); ++block)
+  {
+    vtkUnstructuredGrid* mesh = GetOutputMesh(output, block);
+    const std::vector<vtkIdType>& expected = expectedCells[block];
+    vtkDataArray* cellIds = mesh ? mesh->GetCellData()->GetArray("CellIds") : nullptr;
+    bool same = cellIds && !expected.empty() &&
+      cellIds->GetNumberOfTuples() == static_cast<vtkIdType>(expected.size());
+    for (vtkIdType i = 0; same && i < cellIds->GetNumberOfTuples(); ++i)
+    {
+      same = cellIds->GetTuple1(i) == expected[i];
+    }
+    if (!same)
+    {
+      vtkLog(ERROR, "Wrong cells in output " << block << " for " << name);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Blocks of cells of the given types side by side, with a field to threshold
+// and a vector to threshold on its norm.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  vtkNew<vtkAppendFilter> append;
+  double shift = 0.0;
+  for (int cellType : { VTK_HEXAHEDRON, VTK_TETRA, VTK_QUADRATIC_WEDGE, VTK_POLYHEDRON, VTK_QUAD })
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetBlocksDimensions(12, 10, 8);
+    source->Update();
+    vtkNew<vtkUnstructuredGrid> block;
+    block->DeepCopy(source->GetOutput());
+    vtkPoints* points = block->GetPoints();
+    for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+    {
+      double x[3];
+      points->GetPoint(ptId, x);
+      x[0] += shift;
+      points->SetPoint(ptId, x);
+    }
+    shift += 13.0;
+    append->AddInputData(block);
+  }
+  append->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->ShallowCopy(append->GetOutput());
+  return grid;
+}
+
+// Add the fields to threshold to the input.
+vtkSmartPointer<vtkDataSet> AddFields(vtkDataSet* input)
+{
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputData(input);
+  ids->SetCellIdsArrayName("CellIds");
+  ids->PointIdsOff();
+  ids->Update();
+
+  vtkSmartPointer<vtkDataSet> output;
+  output.TakeReference(ids->GetOutput()->NewInstance());
+  output->ShallowCopy(ids->GetOutput());
+  vtkNew<vtkDoubleArray> field;
+  field->SetName("Field");
+  field->SetNumberOfTuples(output->GetNumberOfPoints());
+  vtkNew<vtkDoubleArray> vector;
+  vector->SetName("Vector");
+  vector->SetNumberOfComponents(3);
+  vector->SetNumberOfTuples(output->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    field->SetValue(ptId, std::sin(x[0]) * std::cos(x[1]) + 0.1 * x[2]);
+    vector->SetTuple3(ptId, std::cos(x[1]), std::sin(x[2]), 0.5 * std::sin(x[0]));
+  }
+  output->GetPointData()->AddArray(field);
+  output->GetPointData()->AddArray(vector);
+  return output;
+}
+}
+
+int TestMultiThresholdThreads(int, char*[])
+{
+  bool success = TestThreshold(AddFields(MakeGrid()), "a grid");
+
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-20, 20, -20, 20, -10, 10);
+  vtkNew<vtkImageDataToPointSet> structuredGrid;
+  structuredGrid->SetInputConnection(wavelet->GetOutputPort());
+  structuredGrid->Update();
+  success &= TestThreshold(AddFields(structuredGrid->GetOutput()), "a structured grid");
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkDataSetTriangleFilter and vtkTessellatorFilter
+// do not depend on the number of threads, that their simplices fill the
+// input cells, and that the parallel merging of the points of
+// vtkTessellatorFilter leaves each point once.
+
+#include "vtkAlgorithm.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkCellTypes.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdFilter.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTessellatorFilter.h"
+#include "vtkTestUtilities.h"
+#include "vtkTetra.h"
+#include "vtkTriangle.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Check that the outputs with 1 and 4 threads are identical.
+bool TestThreads(vtkAlgorithm* filter, vtkUnstructuredGrid* output)
+{
+  if (!vtkTestUtilities::CompareThreadedOutputs(filter, 4, output))
+  {
+    return false;
+  }
+  vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+  if (!cellIds || cellIds->GetDataType() != VTK_ID_TYPE)
+  {
+    vtkLog(ERROR, "The type of the cell data changed.");
+    return false;
+  }
+  return true;
+}
+
+// Total length, area and volume of the simplices.
+void Measure(vtkUnstructuredGrid* output, double measures[3])
+{
+  measures[0] = measures[1] = measures[2] = 0.0;
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, pts);
+    double x[4][3];
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds() && i < 4; ++i)
+    {
+      output->GetPoint(pts->GetId(i), x[i]);
+    }
+    switch (output->GetCellType(cellId))
+    {
+      case VTK_LINE:
+        measures[0] += std::sqrt(vtkMath::Distance2BetweenPoints(x[0], x[1]));
+        break;
+      case VTK_TRIANGLE:
+        measures[1] += vtkTriangle::TriangleArea(x[0], x[1], x[2]);
+        break;
+      case VTK_TETRA:
+        measures[2] += std::abs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]));
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// Each output point must be unique.
+bool HasUniquePoints(vtkUnstructuredGrid* output)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkMergePoints> locator;
+  locator->InitPointInsertion(points, output->GetBounds());
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    vtkIdType id;
+    if (!locator->InsertUniquePoint(output->GetPoint(ptId), id))
+    {
+      vtkLog(ERROR, "Point " << ptId << " is duplicated.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Cells of the given type with a nonlinear field, so that the tessellator
+// subdivides them.
+vtkSmartPointer<vtkUnstructuredGrid> MakeCells(int cellType)
+{
+  vtkNew<vtkCellTypeSource> source;
+  source->SetCellType(cellType);
+  source->SetCellOrder(2);
+  source->SetBlocksDimensions(5, 4, 3);
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(source->GetOutputPort());
+  ids->SetCellIdsArrayName("CellIds");
+  ids->PointIdsOff();
+  ids->Update();
+
+  vtkSmartPointer<vtkUnstructuredGrid> cells = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  cells->ShallowCopy(ids->GetOutput());
+  vtkNew<vtkDoubleArray> field;
+  field->SetName("Field");
+  field->SetNumberOfTuples(cells->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < cells->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    cells->GetPoint(ptId, x);
+    field->SetValue(ptId, std::sin(3.0 * x[0]) * x[1] + x[2] * x[2]);
+  }
+  cells->GetPointData()->SetScalars(field);
+  return cells;
+}
+
+// The cells of MakeCells fill unit blocks, so their simplices have a total
+// length, area or volume equal to the number of blocks.
+bool HasMeasure(vtkUnstructuredGrid* output, int cellType)
+{
+  static const double blockMeasures[3] = { 5.0, 5.0 * 4.0, 5.0 * 4.0 * 3.0 };
+  const int dim = vtkCellTypes::GetDimension(cellType);
+  double measures[3];
+  Measure(output, measures);
+  if (std::abs(measures[dim - 1] - blockMeasures[dim - 1]) > 1e-6)
+  {
+    vtkLog(ERROR,
+      "The simplices of " << vtkCellTypes::GetClassNameFromTypeId(cellType) << " measure "
+                          << measures[dim - 1] << " instead of " << blockMeasures[dim - 1]);
+    return false;
+  }
+  return true;
+}
+
+bool TestDataSetTriangleFilter()
+{
+  bool success = true;
+  // Hexahedra are triangulated with templates, which are created by the
+  // first hexahedron of each thread using them.
+  for (int cellType : { VTK_HEXAHEDRON, VTK_WEDGE, VTK_PYRAMID, VTK_QUADRATIC_TETRA,
+         VTK_QUADRATIC_HEXAHEDRON, VTK_QUAD, VTK_TRIANGLE })
+  {
+    for (int tetrahedraOnly = 0; tetrahedraOnly < 2; ++tetrahedraOnly)
+    {
+      vtkNew<vtkDataSetTriangleFilter> triangulate;
+      triangulate->SetInputData(MakeCells(cellType));
+      triangulate->SetTetrahedraOnly(tetrahedraOnly);
+      vtkNew<vtkUnstructuredGrid> output;
+      if (!TestThreads(triangulate, output))
+      {
+        vtkLog(ERROR,
+          "Triangulation of " << vtkCellTypes::GetClassNameFromTypeId(cellType)
+                              << " differs with 1 and 4 threads.");
+        success = false;
+      }
+      else if (tetrahedraOnly && vtkCellTypes::GetDimension(cellType) < 3)
+      {
+        success &= output->GetNumberOfCells() == 0;
+      }
+      else
+      {
+        success &= HasMeasure(output, cellType);
+      }
+    }
+  }
+
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-10, 10, -10, 10, -10, 10);
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputConnection(wavelet->GetOutputPort());
+  ids->SetCellIdsArrayName("CellIds");
+  ids->PointIdsOff();
+  vtkNew<vtkDataSetTriangleFilter> triangulate;
+  triangulate->SetInputConnection(ids->GetOutputPort());
+  vtkNew<vtkUnstructuredGrid> output;
+  double measures[3] = { 0.0, 0.0, 0.0 };
+  if (TestThreads(triangulate, output))
+  {
+    Measure(output, measures);
+  }
+  if (output->GetNumberOfCells() != 5 * 20 * 20 * 20 ||
+    std::abs(measures[2] - 20.0 * 20.0 * 20.0) > 1e-6)
+  {
+    vtkLog(ERROR, "Wrong triangulation of an image.");
+    success = false;
+  }
+  return success;
+}
+
+bool TestTessellatorFilter()
+{
+  bool success = true;
+  for (int cellType : { VTK_QUADRATIC_HEXAHEDRON, VTK_QUADRATIC_TETRA, VTK_LAGRANGE_WEDGE,
+         VTK_QUADRATIC_QUAD, VTK_QUADRATIC_EDGE })
+  {
+    for (int outputDimension = 1; outputDimension <= 3; ++outputDimension)
+    {
+      vtkNew<vtkTessellatorFilter> tessellate;
+      tessellate->SetInputData(MakeCells(cellType));
+      tessellate->SetOutputDimension(outputDimension);
+      tessellate->SetFieldCriterion(0, 0.01);
+      tessellate->SetMaximumNumberOfSubdivisions(1);
+
+      tessellate->MergePointsOff();
+      vtkNew<vtkUnstructuredGrid> output;
+      if (!TestThreads(tessellate, output) || output->GetNumberOfCells() == 0)
+      {
+        vtkLog(ERROR,
+          "Tessellation of " << vtkCellTypes::GetClassNameFromTypeId(cellType)
+                             << " differs with 1 and 4 threads, dimension " << outputDimension);
+        success = false;
+      }
+      // Lower dimensions output the boundaries of the cells.
+      else if (outputDimension >= vtkCellTypes::GetDimension(cellType))
+      {
+        success &= HasMeasure(output, cellType);
+      }
+
+      tessellate->MergePointsOn();
+      vtkNew<vtkUnstructuredGrid> merged;
+      if (!TestThreads(tessellate, merged) ||
+        merged->GetNumberOfCells() != output->GetNumberOfCells() || !HasUniquePoints(merged))
+      {
+        vtkLog(ERROR,
+          "Merged tessellation of " << vtkCellTypes::GetClassNameFromTypeId(cellType)
+                                    << " differs with 1 and 4 threads, dimension "
+                                    << outputDimension);
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+}
+
+int TestTessellationThreads(int, char*[])
+{
+  bool success = TestDataSetTriangleFilter();
+  success &= TestTessellatorFilter();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
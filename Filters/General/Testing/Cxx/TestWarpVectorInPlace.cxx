@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+// Check that vtkWarpVector and vtkWarpScalar reuse the input points only when
+// the input is released once consumed and has no other consumer.
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+#include "vtkWarpScalar.h"
+#include "vtkWarpVector.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+constexpr vtkIdType NumberOfPoints = 100;
+
+vtkSmartPointer<vtkPolyData> MakeInput()
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(NumberOfPoints);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->SetPoint(i, i, 2 * i, 3 * i);
+    vectors->SetTuple3(i, 1, -1, 0.5);
+    scalars->SetValue(i, i);
+  }
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->SetScalars(scalars);
+  return input;
+}
+
+bool CheckPoints(vtkPointSet* output, double scalarFactor, const double direction[3])
+{
+  if (output->GetNumberOfPoints() != NumberOfPoints)
+  {
+    std::cerr << "Wrong number of output points: " << output->GetNumberOfPoints() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double p[3];
+    output->GetPoint(i, p);
+    const double s = scalarFactor * i + (1.0 - scalarFactor);
+    const double expected[3] = { i + s * direction[0], 2.0 * i + s * direction[1],
+      3.0 * i + s * direction[2] };
+    for (int c = 0; c < 3; ++c)
+    {
+      if (p[c] != expected[c])
+      {
+        std::cerr << "Wrong output point " << i << ": " << p[0] << " " << p[1] << " " << p[2]
+                  << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestWarpVector(bool releaseData, bool secondConsumer)
+{
+  vtkSmartPointer<vtkPolyData> input = MakeInput();
+  vtkPoints* inputPoints = input->GetPoints();
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(input);
+  producer->SetReleaseDataFlag(releaseData);
+
+  vtkNew<vtkWarpVector> warp;
+  warp->SetInputConnection(producer->GetOutputPort());
+  vtkNew<vtkWarpVector> otherWarp;
+  if (secondConsumer)
+  {
+    otherWarp->SetInputConnection(producer->GetOutputPort());
+  }
+  warp->Update();
+
+  const bool expectInPlace = releaseData && !secondConsumer;
+  vtkPointSet* output = warp->GetOutput();
+  if ((output->GetPoints() == inputPoints) != expectInPlace)
+  {
+    std::cerr << "vtkWarpVector " << (expectInPlace ? "did not reuse" : "reused")
+              << " the input points." << std::endl;
+    return false;
+  }
+  if (!releaseData && input->GetPoint(1)[0] != 1.0)
+  {
+    std::cerr << "vtkWarpVector modified its input." << std::endl;
+    return false;
+  }
+  const double direction[3] = { 1.0, -1.0, 0.5 };
+  return CheckPoints(output, 0.0, direction);
+}
+
+bool TestWarpScalar(bool releaseData)
+{
+  vtkSmartPointer<vtkPolyData> input = MakeInput();
+  vtkPoints* inputPoints = input->GetPoints();
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(input);
+  producer->SetReleaseDataFlag(releaseData);
+
+  vtkNew<vtkWarpScalar> warp;
+  warp->SetInputConnection(producer->GetOutputPort());
+  warp->UseNormalOn();
+  warp->SetNormal(0.0, 0.0, 1.0);
+  warp->Update();
+
+  vtkPointSet* output = warp->GetOutput();
+  if ((output->GetPoints() == inputPoints) != releaseData)
+  {
+    std::cerr << "vtkWarpScalar " << (releaseData ? "did not reuse" : "reused")
+              << " the input points." << std::endl;
+    return false;
+  }
+  const double direction[3] = { 0.0, 0.0, 1.0 };
+  return CheckPoints(output, 1.0, direction);
+}
+}
+
+int TestWarpVectorInPlace(int, char*[])
+{
+  bool success = TestWarpVector(false, false);
+  success &= TestWarpVector(true, false);
+  success &= TestWarpVector(true, true);
+  success &= TestWarpScalar(false);
+  success &= TestWarpScalar(true);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
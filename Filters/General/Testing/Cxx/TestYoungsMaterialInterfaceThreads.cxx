@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded vtkYoungsMaterialInterface does not depend on the
+// number of threads, for 2D and 3D meshes spanning several batches of cells,
+// and that the filled materials cover the volume fractions of the cells.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkTetra.h"
+#include "vtkTriangle.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkYoungsMaterialInterface.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Total area or volume of the cells of a material.
+double Measure(vtkMultiBlockDataSet* output, unsigned int material)
+{
+  vtkMultiBlockDataSet* matBlock = vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(material));
+  vtkDataSet* mesh = matBlock ? vtkDataSet::SafeDownCast(matBlock->GetBlock(0)) : nullptr;
+  if (!mesh)
+  {
+    return 0.0;
+  }
+  double measure = 0.0;
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkPoints> pts;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    mesh->GetCell(cellId, cell);
+    cell->Triangulate(0, ptIds, pts);
+    const int numSimplexPts = cell->GetCellDimension() + 1;
+    for (vtkIdType i = 0; i + numSimplexPts <= pts->GetNumberOfPoints(); i += numSimplexPts)
+    {
+      double x[4][3];
+      for (int j = 0; j < numSimplexPts; ++j)
+      {
+        pts->GetPoint(i + j, x[j]);
+      }
+      measure += numSimplexPts == 4 ? std::abs(vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]))
+        : numSimplexPts == 3        ? vtkTriangle::TriangleArea(x[0], x[1], x[2])
+                                    : 0.0;
+    }
+  }
+  return measure;
+}
+
+// With the filled materials, both materials together cover the whole domain,
+// and the first material covers the volume fractions of the cells. The
+// planes are fitted to the fractions approximately, more so in 3D.
+bool FillsFractions(vtkMultiBlockDataSet* input, vtkMultiBlockDataSet* output, int dimension)
+{
+  vtkDataSet* mesh = vtkDataSet::SafeDownCast(input->GetBlock(0));
+  vtkDataArray* fraction = mesh->GetCellData()->GetArray("Fraction1");
+  // All the cells of MakeMaterials have the same size.
+  const double cellMeasure = 4.0 / mesh->GetNumberOfCells();
+  double expected = 0.0;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    double f = fraction->GetTuple1(cellId);
+    f = f < 0.001 ? 0.0 : (f > 0.999 ? 1.0 : f);
+    expected += f * cellMeasure;
+  }
+  const double measure1 = Measure(output, 0);
+  const double measure2 = Measure(output, 1);
+  const double tolerance = dimension == 3 ? 0.06 : 0.01;
+  if (std::abs(measure1 - expected) > tolerance * expected ||
+    std::abs(measure1 + measure2 - 4.0) > 1e-3)
+  {
+    vtkLog(ERROR,
+      "The materials measure " << measure1 << " and " << measure2 << ", expected " << expected
+                               << " and " << 4.0 - expected);
+    return false;
+  }
+  return true;
+}
+
+// Two materials separated by a line in a mesh of triangles, or by a sphere in
+// a mesh of voxels, with the normals of the interface and point and cell
+// values to interpolate.
+vtkSmartPointer<vtkMultiBlockDataSet> MakeMaterials(int dimension)
+{
+  vtkNew<vtkImageData> image;
+  int resolution = dimension == 3 ? 30 : 80;
+  image->SetDimensions(resolution + 1, resolution + 1, dimension == 3 ? 11 : 1);
+  image->SetSpacing(2.0 / resolution, 2.0 / resolution, 0.1);
+
+  vtkNew<vtkDoubleArray> pointValue;
+  pointValue->SetName("PointValue");
+  pointValue->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < image->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    image->GetPoint(ptId, x);
+    pointValue->SetValue(ptId, x[0] * x[1] - x[2]);
+  }
+  image->GetPointData()->AddArray(pointValue);
+
+  vtkIdType numberOfCells = image->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> cellValue;
+  cellValue->SetName("CellValue");
+  cellValue->SetNumberOfTuples(numberOfCells);
+  vtkNew<vtkDoubleArray> fraction1;
+  fraction1->SetName("Fraction1");
+  fraction1->SetNumberOfTuples(numberOfCells);
+  vtkNew<vtkDoubleArray> fraction2;
+  fraction2->SetName("Fraction2");
+  fraction2->SetNumberOfTuples(numberOfCells);
+  vtkNew<vtkDoubleArray> normal;
+  normal->SetName("Normal");
+  normal->SetNumberOfComponents(3);
+  normal->SetNumberOfTuples(numberOfCells);
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    double pcoords[3] = { 0.5, 0.5, 0.5 };
+    double weights[8];
+    double x[3];
+    int subId = 0;
+    image->GetCell(cellId)->EvaluateLocation(subId, pcoords, x, weights);
+    double n[3] = { 0.6, 0.8, 0.0 };
+    double d = n[0] * x[0] + n[1] * x[1] - 1.4;
+    if (dimension == 3)
+    {
+      n[0] = 1.0 - x[0];
+      n[1] = 1.0 - x[1];
+      n[2] = 0.5 - x[2];
+      d = 0.6 - std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    }
+    double f = std::min(1.0, std::max(0.0, 0.5 + d / 0.1));
+    cellValue->SetValue(cellId, static_cast<double>(cellId));
+    fraction1->SetValue(cellId, f);
+    fraction2->SetValue(cellId, 1.0 - f);
+    normal->SetTuple3(cellId, n[0], n[1], n[2]);
+  }
+  image->GetCellData()->AddArray(cellValue);
+  image->GetCellData()->AddArray(fraction1);
+  image->GetCellData()->AddArray(fraction2);
+  image->GetCellData()->AddArray(normal);
+
+  vtkSmartPointer<vtkMultiBlockDataSet> materials = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  materials->SetNumberOfBlocks(1);
+  materials->SetBlock(0, image);
+  if (dimension == 2)
+  {
+    vtkNew<vtkDataSetTriangleFilter> triangles;
+    triangles->SetInputData(image);
+    triangles->Update();
+    materials->SetBlock(0, triangles->GetOutput());
+  }
+  return materials;
+}
+}
+
+int TestYoungsMaterialInterfaceThreads(int, char*[])
+{
+  bool success = true;
+  for (int configuration = 0; configuration < 8; ++configuration)
+  {
+    int dimension = configuration < 4 ? 2 : 3;
+    vtkNew<vtkYoungsMaterialInterface> youngs;
+    youngs->SetInputData(MakeMaterials(dimension));
+    youngs->SetNumberOfMaterials(2);
+    youngs->SetMaterialVolumeFractionArray(0, "Fraction1");
+    youngs->SetMaterialVolumeFractionArray(1, "Fraction2");
+    youngs->SetMaterialNormalArray(0, "Normal");
+    youngs->SetMaterialNormalArray(1, "Normal");
+    youngs->SetVolumeFractionRange(0.001, 0.999);
+    youngs->SetFillMaterial(configuration % 2);
+    youngs->SetOnionPeel((configuration / 2) % 2);
+    youngs->UseAllBlocksOn();
+
+    vtkNew<vtkMultiBlockDataSet> output;
+    if (!vtkTestUtilities::CompareThreadedOutputs(youngs, 4, output) ||
+      output->GetNumberOfBlocks() != 2)
+    {
+      vtkLog(ERROR, "Interfaces differ with 1 and 4 threads, configuration " << configuration);
+      success = false;
+    }
+    else if (youngs->GetFillMaterial())
+    {
+      success &= FillsFractions(
+        vtkMultiBlockDataSet::SafeDownCast(youngs->GetInputDataObject(0, 0)), output, dimension);
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -6,7 +6,6 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
-#include "vtkCellIterator.h"
 #include "vtkPointData.h"
 #include "vtkShortArray.h"
 
@@ -14,6 +13,8 @@
 #include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include "vtkBezierCurve.h"
 #include "vtkBezierHexahedron.h"
@@ -69,6 +70,7 @@
 #include "vtkInformationVector.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <map>
@@ -265,7 +267,7 @@ namespace
 void Centroid(vtkCell* cell, double* centroid)
 {
   // Return the centroid of a cell in world coordinates.
-  static std::vector<double> weights;
+  static thread_local std::vector<double> weights;
   if (weights.size() < static_cast<size_t>(cell->GetNumberOfPoints()))
   {
     weights.resize(cell->GetNumberOfPoints());
@@ -1892,30 +1894,52 @@ int vtkCellValidator::RequestData(vtkInformation* vtkNotUsed(request),
   stateArray->SetName("ValidityState"); // set the name of the value
   stateArray->SetNumberOfTuples(input->GetNumberOfCells());
 
-  vtkGenericCell* cell = vtkGenericCell::New();
-  vtkCellIterator* it = input->NewCellIterator();
-  vtkIdType counter = 0;
-  State state;
-  for (it->InitTraversal(); !it->IsDoneWithTraversal(); it->GoToNextCell())
-  {
-    if (this->CheckAbort())
+  // check the cells in parallel, each thread with its own cell
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (numCells > 0)
+  {
+    // instantiate any data-structure that needs to be cached for parallel execution.
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+  }
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  const double tolerance = this->Tolerance;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkGenericCell* cell = tlCell.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endCellId - cellId) / 10 + 1, (vtkIdType)1000);
+    for (vtkIdType counter = 0; cellId < endCellId; ++cellId, ++counter)
     {
-      break;
+      if (counter % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      input->GetCell(cellId, cell);
+      stateArray->SetValue(cellId, static_cast<short>(Check(cell, tolerance)));
     }
-    it->GetCell(cell);
-    state = Check(cell, this->Tolerance);
-    stateArray->SetValue(counter, static_cast<short>(state));
+  });
+
+  // report the invalid cells in order
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType cellId = 0; cellId < numCells && !this->GetAbortOutput(); ++cellId)
+  {
+    State state = static_cast<State>(stateArray->GetValue(cellId));
     if (state != State::Valid)
     {
+      input->GetCell(cellId, cell);
       std::stringstream s;
       cell->Print(s);
       vtkCellValidator::PrintState(state, s, vtkIndent(0));
       vtkOutputWindowDisplayText(s.str().c_str());
     }
-    ++counter;
   }
-  cell->Delete();
-  it->Delete();
 
   output->GetCellData()->AddArray(stateArray.GetPointer());
 
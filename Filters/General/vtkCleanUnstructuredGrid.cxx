@@ -7,6 +7,7 @@
 #include "vtkArrayDispatchArrayList.h"
 #include "vtkBitArray.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellSizeFilter.h"
 #include "vtkCellTypes.h"
@@ -26,9 +27,12 @@
 #include "vtkRectilinearGrid.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStringArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <atomic>
+#include <memory>
 #include <unordered_set>
 
 namespace
@@ -52,6 +56,102 @@ void AllocatePointAttributes(vtkPointData* inPD, vtkPointData* outPD, vtkIdType
   }
 }
 
+//------------------------------------------------------------------------------
+// Merge the exactly coincident points of a point set in parallel. Points are
+// numbered as with an incremental vtkMergePoints inserting them in order:
+// each group of coincident points gets the rank of its lowest (used) point id.
+// Returns the number of merged points.
+vtkIdType MergeCoincidentPoints(vtkPointSet* input, bool removePointsWithoutCells,
+  vtkPoints* newPts, std::vector<vtkIdType>& ptMap)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+
+  // Map each point to a representative of its group of coincident points.
+  std::vector<vtkIdType> mergeMap(numPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  locator->MergePoints(0.0, mergeMap.data());
+
+  // Points without cells are not inserted.
+  std::vector<unsigned char> used(numPts, removePointsWithoutCells ? 0 : 1);
+  if (removePointsWithoutCells)
+  {
+    vtkNew<vtkIdList> warmUp;
+    input->GetCellPoints(0, warmUp);
+    vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = localPtIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, ptIds);
+        for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+          used[ptIds->GetId(i)] = 1;
+        }
+      }
+    });
+  }
+
+  // Find the lowest used point of each group.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstIds(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstIds[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (used[ptId])
+      {
+        std::atomic<vtkIdType>& firstId = firstIds[mergeMap[ptId]];
+        vtkIdType current = firstId.load(std::memory_order_relaxed);
+        while (ptId < current && !firstId.compare_exchange_weak(current, ptId))
+        {
+        }
+      }
+    }
+  });
+
+  // Number the groups in the order of their lowest point, then map the
+  // other points of the groups.
+  vtkIdType numNewPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    ptMap[ptId] = -1;
+    if (used[ptId] && firstIds[mergeMap[ptId]].load(std::memory_order_relaxed) == ptId)
+    {
+      ptMap[ptId] = numNewPts++;
+    }
+  }
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (!used[ptId])
+      {
+        continue;
+      }
+      const vtkIdType firstId = firstIds[mergeMap[ptId]].load(std::memory_order_relaxed);
+      if (firstId == ptId)
+      {
+        input->GetPoint(ptId, x);
+        newPts->SetPoint(ptMap[ptId], x);
+      }
+      else
+      {
+        ptMap[ptId] = ptMap[firstId];
+      }
+    }
+  });
+  return numNewPts;
+}
+
+//------------------------------------------------------------------------------
 unsigned char GetTopologicalDimension(vtkDataSet* ds)
 {
   vtkNew<vtkCellTypes> cTypes;
@@ -529,9 +629,6 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
   {
     this->Locator->SetTolerance(this->Tolerance * input->GetLength());
   }
-  double bounds[6];
-  input->GetBounds(bounds);
-  this->Locator->InitPointInsertion(newPts, bounds);
 
   vtkIdType progressStep = num / 100;
   if (progressStep == 0)
@@ -539,36 +636,54 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
     progressStep = 1;
   }
 
-  vtkNew<vtkIdList> pointCells;
-  for (id = 0; id < num; ++id)
+  // Merging exactly coincident points does not depend on the insertion
+  // order, so it is done in parallel with the same result.
+  vtkPointSet* psInput = vtkPointSet::SafeDownCast(input);
+  const bool mergeInParallel = psInput && psInput->GetPoints() &&
+    psInput->GetPoints()->GetDataType() == newPts->GetDataType() &&
+    this->Locator->IsA("vtkMergePoints") && this->Locator->GetTolerance() == 0.0;
+  if (mergeInParallel)
   {
-    if (id % progressStep == 0)
-    {
-      this->UpdateProgress(0.8 * ((float)id / num));
-    }
+    ::MergeCoincidentPoints(psInput, this->RemovePointsWithoutCells, newPts, ptMap);
+    this->UpdateProgress(0.8);
+  }
+  else
+  {
+    double bounds[6];
+    input->GetBounds(bounds);
+    this->Locator->InitPointInsertion(newPts, bounds);
 
-    bool insert = true;
-    if (this->RemovePointsWithoutCells)
+    vtkNew<vtkIdList> pointCells;
+    for (id = 0; id < num; ++id)
     {
-      input->GetPointCells(id, pointCells);
-      if (pointCells->GetNumberOfIds() == 0)
+      if (id % progressStep == 0)
       {
-        insert = false;
+        this->UpdateProgress(0.8 * ((float)id / num));
       }
-    }
 
-    if (insert)
-    {
-      input->GetPoint(id, pt);
-      this->Locator->InsertUniquePoint(pt, newId);
-      ptMap[id] = newId;
-    }
-    else
-    {
-      // Strictly speaking, this is not needed
-      // as this is never accessed, but better not let
-      // an id undefined.
-      ptMap[id] = -1;
+      bool insert = true;
+      if (this->RemovePointsWithoutCells)
+      {
+        input->GetPointCells(id, pointCells);
+        if (pointCells->GetNumberOfIds() == 0)
+        {
+          insert = false;
+        }
+      }
+
+      if (insert)
+      {
+        input->GetPoint(id, pt);
+        this->Locator->InsertUniquePoint(pt, newId);
+        ptMap[id] = newId;
+      }
+      else
+      {
+        // Strictly speaking, this is not needed
+        // as this is never accessed, but better not let
+        // an id undefined.
+        ptMap[id] = -1;
+      }
     }
   }
   output->SetPoints(newPts);
@@ -581,6 +696,38 @@ int vtkCleanUnstructuredGrid::RequestData(vtkInformation* vtkNotUsed(request),
   ::AllocatePointAttributes(inPD, outPD, output->GetNumberOfPoints());
   ::WeightAttributes(inPD, outPD, weights, ptMap);
 
+  // Without polyhedra, the cells keep their types and sizes, so only the
+  // connectivity has to be renumbered.
+  vtkUnstructuredGrid* ugInput = vtkUnstructuredGrid::SafeDownCast(input);
+  if (ugInput && !ugInput->GetPolyhedronFaces())
+  {
+    vtkNew<vtkCellArray> outCells;
+    outCells->DeepCopy(ugInput->GetCells());
+    const vtkIdType numConn = outCells->GetNumberOfConnectivityIds();
+    if (outCells->IsStorage64Bit())
+    {
+      vtkTypeInt64* conn = outCells->GetConnectivityArray64()->GetPointer(0);
+      vtkSMPTools::For(0, numConn, [&](vtkIdType connId, vtkIdType endId) {
+        for (; connId < endId; ++connId)
+        {
+          conn[connId] = ptMap[conn[connId]];
+        }
+      });
+    }
+    else
+    {
+      vtkTypeInt32* conn = outCells->GetConnectivityArray32()->GetPointer(0);
+      vtkSMPTools::For(0, numConn, [&](vtkIdType connId, vtkIdType endId) {
+        for (; connId < endId; ++connId)
+        {
+          conn[connId] = static_cast<vtkTypeInt32>(ptMap[conn[connId]]);
+        }
+      });
+    }
+    output->SetCells(ugInput->GetCellTypesArray(), outCells);
+    return 1;
+  }
+
   // Now copy the cells.
   vtkNew<vtkIdList> cellPoints;
   vtkNew<vtkCellArray> cellFaces;
@@ -11,6 +11,12 @@
  * merge duplicate points (with coincident coordinates) using the vtkMergePoints object
  * to merge points.
  *
+ * When the tolerance is zero and the default vtkMergePoints locator is used,
+ * the points of a vtkPointSet input are merged in parallel with a
+ * vtkStaticPointLocator, and the connectivity of an unstructured grid input
+ * without polyhedra is renumbered in parallel. The output is the same as
+ * with the incremental insertion.
+ *
  * @sa
  * vtkCleanPolyData
  */
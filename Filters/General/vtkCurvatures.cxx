@@ -16,11 +16,14 @@
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkTriangleStrip.h"
 
 #include <memory> // For unique_ptr
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkCurvatures);
@@ -64,10 +67,6 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
 
   int numPts = polyData->GetNumberOfPoints();
 
-  //     create-allocate
-  const vtkNew<vtkIdList> vertices;
-  const vtkNew<vtkIdList> vertices_n;
-  const vtkNew<vtkIdList> neighbours;
   const vtkNew<vtkDoubleArray> meanCurvature;
   meanCurvature->SetName("Mean_Curvature");
   meanCurvature->SetNumberOfComponents(1);
@@ -75,21 +74,9 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   // Get the array so we can write to it directly
   double* meanCurvatureData = meanCurvature->GetPointer(0);
 
-  //     create-allocate
-  double n_f[3]; // normal of facet (could be stored for later?)
-  double n_n[3]; // normal of edge
-  double t[3];   // to store the cross product of n_f n_n
-  double ore[3]; // origin of e
-  double end[3]; // end of e
-  double oth[3]; //     third vertex necessary for comp of n
-  double vn0[3];
-  double vn1[3]; // vertices for computation of neighbour's n
-  double vn2[3];
-  double e[3]; // edge (oriented)
-
   polyData->BuildLinks();
   // data init
-  const int F = polyData->GetNumberOfCells();
+  const vtkIdType F = polyData->GetNumberOfCells();
   // init, preallocate the mean curvature
   const std::unique_ptr<int[]> num_neighb(new int[numPts]);
   for (int v = 0; v < numPts; v++)
@@ -98,81 +85,136 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
     num_neighb[v] = 0;
   }
 
+  // The contribution of each facet edge is computed in parallel and stored
+  // at the edge location. The contributions are then accumulated serially
+  // in the facet order, so the sums do not depend on the number of threads.
+  std::vector<vtkIdType> edgeOffsets(F + 1);
+  edgeOffsets[0] = 0;
+  for (vtkIdType f = 0; f < F; ++f)
+  {
+    edgeOffsets[f + 1] = edgeOffsets[f] + polyData->GetCellSize(f);
+  }
+  std::vector<double> edgeHf(edgeOffsets[F]);
+  std::vector<unsigned char> hasEdgeHf(edgeOffsets[F], 0);
+
   //     main loop
   vtkDebugMacro(<< "Main loop: loop over facets such that id > id of neighb");
   vtkDebugMacro(<< "so that every edge comes only once");
 
-  for (vtkIdType f = 0; f < F; ++f)
-  {
-    if (this->CheckAbort())
+  vtkSMPThreadLocalObject<vtkIdList> tlVertices;
+  vtkSMPThreadLocalObject<vtkIdList> tlVerticesN;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbours;
+  vtkSMPTools::For(0, F, [&](vtkIdType beginFacet, vtkIdType endFacet) {
+    vtkIdList* vertices = tlVertices.Local();
+    vtkIdList* vertices_n = tlVerticesN.Local();
+    vtkIdList* neighbours = tlNeighbours.Local();
+
+    //     create-allocate
+    double n_f[3]; // normal of facet (could be stored for later?)
+    double n_n[3]; // normal of edge
+    double t[3];   // to store the cross product of n_f n_n
+    double ore[3]; // origin of e
+    double end[3]; // end of e
+    double oth[3]; //     third vertex necessary for comp of n
+    double vn0[3];
+    double vn1[3]; // vertices for computation of neighbour's n
+    double vn2[3];
+    double e[3]; // edge (oriented)
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (vtkIdType f = beginFacet; f < endFacet; ++f)
     {
-      break;
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      polyData->GetCellPoints(f, vertices);
+      const vtkIdType nv = vertices->GetNumberOfIds();
+
+      for (vtkIdType v = 0; v < nv; v++)
+      {
+        // get neighbour
+        const vtkIdType v_l = vertices->GetId(v);
+        const vtkIdType v_r = vertices->GetId((v + 1) % nv);
+        const vtkIdType v_o = vertices->GetId((v + 2) % nv);
+        polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
+
+        vtkIdType n; // n short for neighbor
+
+        // compute only if there is really ONE neighbour
+        // AND meanCurvature has not been computed yet!
+        // (ensured by n > f)
+        if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
+        {
+          double Hf; // temporary store
+
+          // find 3 corners of f: in order!
+          polyData->GetPoint(v_l, ore);
+          polyData->GetPoint(v_r, end);
+          polyData->GetPoint(v_o, oth);
+          // compute normal of f
+          vtkTriangle::ComputeNormal(ore, end, oth, n_f);
+          // compute common edge
+          e[0] = end[0];
+          e[1] = end[1];
+          e[2] = end[2];
+          e[0] -= ore[0];
+          e[1] -= ore[1];
+          e[2] -= ore[2];
+          const double length = vtkMath::Normalize(e);
+          double Af = vtkTriangle::TriangleArea(ore, end, oth);
+          // find 3 corners of n: in order!
+          polyData->GetCellPoints(n, vertices_n);
+          polyData->GetPoint(vertices_n->GetId(0), vn0);
+          polyData->GetPoint(vertices_n->GetId(1), vn1);
+          polyData->GetPoint(vertices_n->GetId(2), vn2);
+          Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
+          // compute normal of n
+          vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
+          // the cosine is n_f * n_n
+          const double cs = vtkMath::Dot(n_f, n_n);
+          // the sin is (n_f x n_n) * e
+          vtkMath::Cross(n_f, n_n, t);
+          const double sn = vtkMath::Dot(t, e);
+          // signed angle in [-pi,pi]
+          if (sn != 0.0 || cs != 0.0)
+          {
+            const double angle = atan2(sn, cs);
+            Hf = length * angle;
+          }
+          else
+          {
+            Hf = 0.0;
+          }
+          // weighted Hf to add to scalar at v_l and v_r
+          if (Af != 0.0)
+          {
+            (Hf /= Af) *= 3.0;
+          }
+          edgeHf[edgeOffsets[f] + v] = Hf;
+          hasEdgeHf[edgeOffsets[f] + v] = 1;
+        }
+      }
     }
+  });
+
+  vtkNew<vtkIdList> vertices;
+  for (vtkIdType f = 0; f < F && !this->GetAbortOutput(); ++f)
+  {
     polyData->GetCellPoints(f, vertices);
     const vtkIdType nv = vertices->GetNumberOfIds();
-
     for (vtkIdType v = 0; v < nv; v++)
     {
-      // get neighbour
-      const vtkIdType v_l = vertices->GetId(v);
-      const vtkIdType v_r = vertices->GetId((v + 1) % nv);
-      const vtkIdType v_o = vertices->GetId((v + 2) % nv);
-      polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
-
-      vtkIdType n; // n short for neighbor
-
-      // compute only if there is really ONE neighbour
-      // AND meanCurvature has not been computed yet!
-      // (ensured by n > f)
-      if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
+      if (hasEdgeHf[edgeOffsets[f] + v])
       {
-        double Hf; // temporary store
-
-        // find 3 corners of f: in order!
-        polyData->GetPoint(v_l, ore);
-        polyData->GetPoint(v_r, end);
-        polyData->GetPoint(v_o, oth);
-        // compute normal of f
-        vtkTriangle::ComputeNormal(ore, end, oth, n_f);
-        // compute common edge
-        e[0] = end[0];
-        e[1] = end[1];
-        e[2] = end[2];
-        e[0] -= ore[0];
-        e[1] -= ore[1];
-        e[2] -= ore[2];
-        const double length = vtkMath::Normalize(e);
-        double Af = vtkTriangle::TriangleArea(ore, end, oth);
-        // find 3 corners of n: in order!
-        polyData->GetCellPoints(n, vertices_n);
-        polyData->GetPoint(vertices_n->GetId(0), vn0);
-        polyData->GetPoint(vertices_n->GetId(1), vn1);
-        polyData->GetPoint(vertices_n->GetId(2), vn2);
-        Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
-        // compute normal of n
-        vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
-        // the cosine is n_f * n_n
-        const double cs = vtkMath::Dot(n_f, n_n);
-        // the sin is (n_f x n_n) * e
-        vtkMath::Cross(n_f, n_n, t);
-        const double sn = vtkMath::Dot(t, e);
-        // signed angle in [-pi,pi]
-        if (sn != 0.0 || cs != 0.0)
-        {
-          const double angle = atan2(sn, cs);
-          Hf = length * angle;
-        }
-        else
-        {
-          Hf = 0.0;
-        }
-        // add weighted Hf to scalar at v_l and v_r
-        if (Af != 0.0)
-        {
-          (Hf /= Af) *= 3.0;
-        }
-        meanCurvatureData[v_l] += Hf;
-        meanCurvatureData[v_r] += Hf;
+        const vtkIdType v_l = vertices->GetId(v);
+        const vtkIdType v_r = vertices->GetId((v + 1) % nv);
+        meanCurvatureData[v_l] += edgeHf[edgeOffsets[f] + v];
+        meanCurvatureData[v_r] += edgeHf[edgeOffsets[f] + v];
         num_neighb[v_l] += 1;
         num_neighb[v_r] += 1;
       }
@@ -261,13 +303,6 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
 void vtkCurvatures::ComputeGaussCurvature(
   vtkCellArray* facets, vtkPolyData* output, double* gaussCurvatureData)
 {
-  double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
-
-  double A, alpha0, alpha1, alpha2;
-
-  vtkIdType f;
-  const vtkIdType* vert = nullptr;
-
   // other data
   vtkIdType Nv = output->GetNumberOfPoints();
 
@@ -280,51 +315,81 @@ void vtkCurvatures::ComputeGaussCurvature(
     dA[k] = 0.0;
   }
 
-  facets->InitTraversal();
-  while (facets->GetNextCell(f, vert))
-  {
-    if (this->CheckAbort())
+  // The area and the angles of each facet are computed in parallel, then
+  // accumulated serially at the vertices in the facet order, so the sums do
+  // not depend on the number of threads.
+  const vtkIdType numFacets = facets->GetNumberOfCells();
+  std::vector<double> facetTerms(4 * numFacets);
+  vtkSMPThreadLocalObject<vtkIdList> tlVert;
+  vtkSMPTools::For(0, numFacets, [&](vtkIdType beginFacet, vtkIdType endFacet) {
+    vtkIdList* vertList = tlVert.Local();
+    double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
+    vtkIdType nVert;
+    const vtkIdType* vert;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (vtkIdType facetId = beginFacet; facetId < endFacet; ++facetId)
     {
-      break;
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      facets->GetCellAtId(facetId, nVert, vert, vertList);
+      output->GetPoint(vert[0], v0);
+      output->GetPoint(vert[1], v1);
+      output->GetPoint(vert[2], v2);
+      // edges
+      e0[0] = v1[0];
+      e0[1] = v1[1];
+      e0[2] = v1[2];
+      e0[0] -= v0[0];
+      e0[1] -= v0[1];
+      e0[2] -= v0[2];
+
+      e1[0] = v2[0];
+      e1[1] = v2[1];
+      e1[2] = v2[2];
+      e1[0] -= v1[0];
+      e1[1] -= v1[1];
+      e1[2] -= v1[2];
+
+      e2[0] = v0[0];
+      e2[1] = v0[1];
+      e2[2] = v0[2];
+      e2[0] -= v2[0];
+      e2[1] -= v2[1];
+      e2[2] -= v2[2];
+
+      double* terms = facetTerms.data() + 4 * facetId;
+      // alpha0, alpha1, alpha2
+      terms[0] = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2);
+      terms[1] = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0);
+      terms[2] = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1);
+
+      // surf. area
+      terms[3] = double(vtkTriangle::TriangleArea(v0, v1, v2));
     }
-    output->GetPoint(vert[0], v0);
-    output->GetPoint(vert[1], v1);
-    output->GetPoint(vert[2], v2);
-    // edges
-    e0[0] = v1[0];
-    e0[1] = v1[1];
-    e0[2] = v1[2];
-    e0[0] -= v0[0];
-    e0[1] -= v0[1];
-    e0[2] -= v0[2];
-
-    e1[0] = v2[0];
-    e1[1] = v2[1];
-    e1[2] = v2[2];
-    e1[0] -= v1[0];
-    e1[1] -= v1[1];
-    e1[2] -= v1[2];
-
-    e2[0] = v0[0];
-    e2[1] = v0[1];
-    e2[2] = v0[2];
-    e2[0] -= v2[0];
-    e2[1] -= v2[1];
-    e2[2] -= v2[2];
-
-    alpha0 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e1, e2);
-    alpha1 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e2, e0);
-    alpha2 = vtkMath::Pi() - vtkMath::AngleBetweenVectors(e0, e1);
-
-    // surf. area
-    A = double(vtkTriangle::TriangleArea(v0, v1, v2));
+  });
+
+  vtkIdType facetId = 0;
+  vtkIdType f;
+  const vtkIdType* vert = nullptr;
+  facets->InitTraversal();
+  while (!this->GetAbortOutput() && facets->GetNextCell(f, vert))
+  {
+    const double* terms = facetTerms.data() + 4 * facetId++;
+    const double A = terms[3];
     // UPDATE
     dA[vert[0]] += A;
     dA[vert[1]] += A;
     dA[vert[2]] += A;
-    K[vert[0]] -= alpha1;
-    K[vert[1]] -= alpha2;
-    K[vert[2]] -= alpha0;
+    K[vert[0]] -= terms[1];
+    K[vert[1]] -= terms[2];
+    K[vert[2]] -= terms[0];
   }
 
   // put curvature in vtkArray
@@ -355,33 +420,45 @@ void vtkCurvatures::GetMaximumCurvature(vtkPolyData* input, vtkPolyData* output)
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Gauss_Curvature"));
   vtkDoubleArray* mean =
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Mean_Curvature"));
-  double k, h, k_max, tmp;
-
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    if (this->CheckAbort())
+  // Points with a large computation error, reported after the parallel loop
+  std::vector<unsigned char> largeError(numPts, 0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double k, h, k_max, tmp;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType i = begin; i < end; i++)
     {
-      break;
-    }
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
 
-    k = gauss->GetComponent(i, 0);
-    h = mean->GetComponent(i, 0);
-    tmp = h * h - k;
-    if (tmp >= 0)
-    {
-      k_max = h + sqrt(tmp);
-    }
-    else
-    {
-      k_max = h;
-      if (tmp < -0.1)
+      k = gauss->GetValue(i);
+      h = mean->GetValue(i);
+      tmp = h * h - k;
+      if (tmp >= 0)
+      {
+        k_max = h + sqrt(tmp);
+      }
+      else
       {
-        vtkWarningMacro(
-          << "The Gaussian or mean curvature at point " << i
-          << " have a large computation error... The maximum curvature is likely off.");
+        k_max = h;
+        largeError[i] = tmp < -0.1;
       }
+      maximumCurvature->SetValue(i, k_max);
+    }
+  });
+
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    if (largeError[i])
+    {
+      vtkWarningMacro(<< "The Gaussian or mean curvature at point " << i
+                      << " have a large computation error... The maximum curvature is likely off.");
     }
-    maximumCurvature->SetComponent(i, 0, k_max);
   }
 }
 
@@ -403,33 +480,45 @@ void vtkCurvatures::GetMinimumCurvature(vtkPolyData* input, vtkPolyData* output)
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Gauss_Curvature"));
   vtkDoubleArray* mean =
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Mean_Curvature"));
-  double k, h, k_min, tmp;
-
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    if (this->CheckAbort())
+  // Points with a large computation error, reported after the parallel loop
+  std::vector<unsigned char> largeError(numPts, 0);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double k, h, k_min, tmp;
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType i = begin; i < end; i++)
     {
-      break;
-    }
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
 
-    k = gauss->GetComponent(i, 0);
-    h = mean->GetComponent(i, 0);
-    tmp = h * h - k;
-    if (tmp >= 0)
-    {
-      k_min = h - sqrt(tmp);
-    }
-    else
-    {
-      k_min = h;
-      if (tmp < -0.1)
+      k = gauss->GetValue(i);
+      h = mean->GetValue(i);
+      tmp = h * h - k;
+      if (tmp >= 0)
+      {
+        k_min = h - sqrt(tmp);
+      }
+      else
       {
-        vtkWarningMacro(
-          << "The Gaussian or mean curvature at point " << i
-          << " have a large computation error... The minimum curvature is likely off.");
+        k_min = h;
+        largeError[i] = tmp < -0.1;
       }
+      minimumCurvature->SetValue(i, k_min);
+    }
+  });
+
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    if (largeError[i])
+    {
+      vtkWarningMacro(<< "The Gaussian or mean curvature at point " << i
+                      << " have a large computation error... The minimum curvature is likely off.");
     }
-    minimumCurvature->SetComponent(i, 0, k_min);
   }
 }
 
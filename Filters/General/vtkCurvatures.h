@@ -41,6 +41,10 @@
  *  can be set and the Curvature reported by the Mean calculation will
  * be inverted.
  *
+ * The per facet terms of the curvatures are computed in parallel with
+ * vtkSMPTools, then summed at the points in the facet order, so the
+ * results do not depend on the number of threads.
+ *
  * For a little more information see
  * <a href="https://public.kitware.com/pipermail/vtkusers/2002-July/012198.html"
  * >Computing curvature of a surface</a>
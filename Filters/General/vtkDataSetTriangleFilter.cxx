@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkDataSetTriangleFilter.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellType.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -13,14 +16,312 @@
 #include "vtkOrderedTriangulator.h"
 #include "vtkPointData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredData.h"
 #include "vtkStructuredGrid.h"
 #include "vtkStructuredPoints.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDataSetTriangleFilter);
 
+namespace
+{
+// Number of input cells triangulated together. The simplices of each batch
+// are gathered in order, so the output does not depend on the number of
+// threads.
+const vtkIdType TriangulationBatchSize = 1024;
+
+// The simplices produced by a batch of input cells.
+struct vtkSimplexBatch
+{
+  std::vector<unsigned char> Types;
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> CellIds; // input cell of each simplex
+};
+
+// Add the simplices of dimension dim-1 listed in ptIds to the batch.
+void AddSimplices(vtkSimplexBatch& batch, vtkIdType cellId, int dim, vtkIdList* ptIds)
+{
+  static const unsigned char types[4] = { VTK_VERTEX, VTK_LINE, VTK_TRIANGLE, VTK_TETRA };
+  const vtkIdType numSimplices = ptIds->GetNumberOfIds() / dim;
+  const vtkIdType* ids = ptIds->GetPointer(0);
+  for (vtkIdType i = 0; i < numSimplices; i++)
+  {
+    batch.Types.push_back(types[dim - 1]);
+    batch.CellIds.push_back(cellId);
+    batch.Connectivity.insert(batch.Connectivity.end(), ids + dim * i, ids + dim * (i + 1));
+  }
+}
+
+// Number of points of the simplices added by AddSimplices.
+int NumberOfSimplexPoints(unsigned char type)
+{
+  switch (type)
+  {
+    case VTK_TETRA:
+      return 4;
+    case VTK_TRIANGLE:
+      return 3;
+    case VTK_LINE:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+// Concatenate the simplices of the batches into the output, copying the cell
+// data of the input cells they come from.
+void BuildOutput(
+  std::vector<vtkSimplexBatch>& batches, vtkCellData* inCD, vtkUnstructuredGrid* output)
+{
+  const vtkIdType numBatches = static_cast<vtkIdType>(batches.size());
+  std::vector<vtkIdType> cellOffsets(numBatches + 1, 0);
+  std::vector<vtkIdType> connOffsets(numBatches + 1, 0);
+  for (vtkIdType i = 0; i < numBatches; i++)
+  {
+    cellOffsets[i + 1] = cellOffsets[i] + static_cast<vtkIdType>(batches[i].Types.size());
+    connOffsets[i + 1] =
+      connOffsets[i] + static_cast<vtkIdType>(batches[i].Connectivity.size());
+  }
+  const vtkIdType numCells = cellOffsets[numBatches];
+  const vtkIdType connSize = connOffsets[numBatches];
+
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connSize);
+
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numCells);
+  ArrayList arrays;
+  arrays.AddArrays(numCells, inCD, outCD, 0.0, false);
+
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      vtkSimplexBatch& batch = batches[i];
+      vtkIdType cellId = cellOffsets[i];
+      vtkIdType offset = connOffsets[i];
+      std::copy(batch.Connectivity.begin(), batch.Connectivity.end(),
+        connectivity->GetPointer(offset));
+      for (size_t j = 0; j < batch.Types.size(); j++, cellId++)
+      {
+        types->SetValue(cellId, batch.Types[j]);
+        offsets->SetValue(cellId, offset);
+        offset += NumberOfSimplexPoints(batch.Types[j]);
+        arrays.Copy(batch.CellIds[j], cellId);
+      }
+      // release the memory as soon as the batch is copied
+      batch = vtkSimplexBatch();
+    }
+  });
+  offsets->SetValue(numCells, connSize);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(types, cells);
+}
+
+// Triangulate rows of structured cells, alternating the triangulation of
+// adjacent cells so that their faces match.
+struct TriangulateStructuredCells
+{
+  vtkDataSet* Input;
+  const int* PointDimensions;
+  const int* CellDimensions;
+  vtkTypeBool TetrahedraOnly;
+  std::vector<vtkSimplexBatch>& Batches;
+  vtkDataSetTriangleFilter* Filter;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  TriangulateStructuredCells(vtkDataSet* input, const int* pointDims, const int* cellDims,
+    vtkTypeBool tetrahedraOnly, std::vector<vtkSimplexBatch>& batches,
+    vtkDataSetTriangleFilter* filter)
+    : Input(input)
+    , PointDimensions(pointDims)
+    , CellDimensions(cellDims)
+    , TetrahedraOnly(tetrahedraOnly)
+    , Batches(batches)
+    , Filter(filter)
+  {
+  }
+
+  void operator()(vtkIdType beginRow, vtkIdType endRow)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* cellPtIds = this->PtIds.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType row = beginRow; row < endRow; row++)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      vtkSimplexBatch& batch = this->Batches[row];
+      int ijk[3];
+      ijk[1] = static_cast<int>(row % this->CellDimensions[1]);
+      ijk[2] = static_cast<int>(row / this->CellDimensions[1]);
+      for (ijk[0] = 0; ijk[0] < this->CellDimensions[0]; ijk[0]++)
+      {
+        vtkIdType inId = ijk[0] + row * this->CellDimensions[0];
+        this->Input->GetCell(vtkStructuredData::ComputeCellId(this->PointDimensions, ijk), cell);
+        cell->TriangulateIds((ijk[0] + ijk[1] + ijk[2]) % 2, cellPtIds);
+
+        int dim = cell->GetCellDimension() + 1;
+        if (!this->TetrahedraOnly || dim == 4)
+        {
+          AddSimplices(batch, inId, dim, cellPtIds);
+        }
+      } // i dimension
+    }
+  }
+};
+
+// Triangulate batches of cells of an unstructured dataset. 3D cells use
+// ordered triangulators, one per thread, configured as the filter's one.
+struct TriangulateUnstructuredCells
+{
+  vtkDataSet* Input;
+  vtkTypeBool TetrahedraOnly;
+  std::vector<vtkSimplexBatch>& Batches;
+  vtkDataSetTriangleFilter* Filter;
+  vtkOrderedTriangulator* Prototype;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+  vtkSMPThreadLocalObject<vtkOrderedTriangulator> Triangulator;
+
+  TriangulateUnstructuredCells(vtkDataSet* input, vtkTypeBool tetrahedraOnly,
+    std::vector<vtkSimplexBatch>& batches, vtkDataSetTriangleFilter* filter,
+    vtkOrderedTriangulator* prototype)
+    : Input(input)
+    , TetrahedraOnly(tetrahedraOnly)
+    , Batches(batches)
+    , Filter(filter)
+    , Prototype(prototype)
+  {
+  }
+
+  void Initialize()
+  {
+    vtkOrderedTriangulator* triangulator = this->Triangulator.Local();
+    triangulator->SetPreSorted(this->Prototype->GetPreSorted());
+    triangulator->SetUseTemplates(this->Prototype->GetUseTemplates());
+    triangulator->SetUseTwoSortIds(this->Prototype->GetUseTwoSortIds());
+  }
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* cellPtIds = this->PtIds.Local();
+    vtkOrderedTriangulator* triangulator = this->Triangulator.Local();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    double x[3];
+
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; batchId++)
+    {
+      if (isFirst)
+      {
+        this->Filter->CheckAbort();
+      }
+      if (this->Filter->GetAbortOutput())
+      {
+        break;
+      }
+      vtkSimplexBatch& batch = this->Batches[batchId];
+      const vtkIdType endCellId = std::min((batchId + 1) * TriangulationBatchSize, numCells);
+      for (vtkIdType cellId = batchId * TriangulationBatchSize; cellId < endCellId; cellId++)
+      {
+        this->Input->GetCell(cellId, cell);
+        int dim = cell->GetCellDimension();
+
+        if (cell->GetCellType() == VTK_POLYHEDRON) // polyhedron
+        {
+          cell->TriangulateIds(0, cellPtIds);
+          AddSimplices(batch, cellId, 4, cellPtIds);
+        }
+
+        else if (dim == 3) // use ordered triangulation
+        {
+          int numPts = cell->GetNumberOfPoints();
+          double* p = cell->GetParametricCoords();
+          int type = cell->GetCellType();
+          triangulator->InitTriangulation(0.0, 1.0, 0.0, 1.0, 0.0, 1.0, numPts);
+          for (int j = 0; j < numPts; j++, p += 3)
+          {
+            // the wedge is "flipped" compared to other cells in that
+            // the normal of the first face points out instead of in
+            // so we flip the way we pass the points to the triangulator
+            static const vtkIdType wedgemap[18] = { 3, 4, 5, 0, 1, 2, 9, 10, 11, 6, 7, 8, 12, 13,
+              14, 15, 16, 17 };
+            vtkIdType ptId;
+            if (type == VTK_WEDGE || type == VTK_QUADRATIC_WEDGE ||
+              type == VTK_QUADRATIC_LINEAR_WEDGE || type == VTK_BIQUADRATIC_QUADRATIC_WEDGE)
+            {
+              ptId = cell->PointIds->GetId(wedgemap[j]);
+              cell->Points->GetPoint(wedgemap[j], x);
+            }
+            else
+            {
+              ptId = cell->PointIds->GetId(j);
+              cell->Points->GetPoint(j, x);
+            }
+            triangulator->InsertPoint(ptId, x, p, 0);
+          }                          // for all cell points
+          if (cell->IsPrimaryCell()) // use templates if topology is fixed
+          {
+            int numEdges = cell->GetNumberOfEdges();
+            triangulator->TemplateTriangulate(type, numPts, numEdges);
+          }
+          else // use ordered triangulator
+          {
+            triangulator->Triangulate();
+          }
+
+          cellPtIds->Reset();
+          vtkIdType numTetras = triangulator->AddTetras(0, cellPtIds);
+          if (type == VTK_HEXAHEDRON && triangulator->GetUseTemplates() &&
+            !triangulator->GetTemplateUsed())
+          {
+            // A template replays the tetras in reverse order of the triangulation
+            // that created it. Which hexahedra create the templates depends on
+            // how the cells are distributed over the threads, so use the replay
+            // order for all of them.
+            vtkIdType* ids = cellPtIds->GetPointer(0);
+            for (vtkIdType i = 0, j = numTetras - 1; i < j; i++, j--)
+            {
+              std::swap_ranges(ids + 4 * i, ids + 4 * i + 4, ids + 4 * j);
+            }
+          }
+          AddSimplices(batch, cellId, 4, cellPtIds);
+        }
+
+        else if (!this->TetrahedraOnly) // 2D or lower dimension
+        {
+          cell->TriangulateIds(0, cellPtIds);
+          AddSimplices(batch, cellId, dim + 1, cellPtIds);
+        } // if 2D or less cell
+      }   // for all cells
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
 vtkDataSetTriangleFilter::vtkDataSetTriangleFilter()
 {
   this->Triangulator = vtkOrderedTriangulator::New();
@@ -64,26 +365,21 @@ int vtkDataSetTriangleFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
 void vtkDataSetTriangleFilter::StructuredExecute(vtkDataSet* input, vtkUnstructuredGrid* output)
 {
-  int dimensions[3], i, j, k, l, m;
-  vtkIdType newCellId, inId;
-  vtkCellData* inCD = input->GetCellData();
-  vtkCellData* outCD = output->GetCellData();
+  int dimensions[3], cellDimensions[3];
   vtkPoints* newPoints = vtkPoints::New();
-  vtkIdList* cellPtIds = vtkIdList::New();
-  int numSimplices, numPts, dim, type;
-  vtkIdType pts[4], num;
 
   // Create an array of points. This does an explicit creation
   // of each point.
-  num = input->GetNumberOfPoints();
+  vtkIdType num = input->GetNumberOfPoints();
   newPoints->SetNumberOfPoints(num);
-  for (i = 0; i < num; ++i)
-  {
-    newPoints->SetPoint(i, input->GetPoint(i));
-  }
-
-  outCD->CopyAllocate(inCD, input->GetNumberOfCells() * 5);
-  output->Allocate(input->GetNumberOfCells() * 5);
+  vtkSMPTools::For(0, num, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      input->GetPoint(i, x);
+      newPoints->SetPoint(i, x);
+    }
+  });
 
   if (input->IsA("vtkStructuredPoints"))
   {
@@ -112,68 +408,22 @@ void vtkDataSetTriangleFilter::StructuredExecute(vtkDataSet* input, vtkUnstructu
     dimensions[2] = 1;
   }
 
-  dimensions[0] = dimensions[0] - 1;
-  dimensions[1] = dimensions[1] - 1;
-  dimensions[2] = dimensions[2] - 1;
+  cellDimensions[0] = dimensions[0] - 1;
+  cellDimensions[1] = dimensions[1] - 1;
+  cellDimensions[2] = dimensions[2] - 1;
 
-  vtkIdType numSlices = (dimensions[2] > 0 ? dimensions[2] : 1);
-  bool abort = false;
-  for (k = 0; k < numSlices && !abort; k++)
-  {
-    this->UpdateProgress(static_cast<double>(k) / numSlices);
-    abort = this->CheckAbort();
+  // Rows of cells along the i axis are triangulated in parallel.
+  vtkIdType numSlices = (cellDimensions[2] > 0 ? cellDimensions[2] : 1);
+  vtkIdType numRows = cellDimensions[0] > 0 && cellDimensions[1] > 0
+    ? numSlices * cellDimensions[1]
+    : 0;
+  std::vector<vtkSimplexBatch> rows(numRows);
+  TriangulateStructuredCells triangulate(
+    input, dimensions, cellDimensions, this->TetrahedraOnly, rows, this);
+  vtkSMPTools::For(0, numRows, triangulate);
+  this->UpdateProgress(0.8);
 
-    for (j = 0; j < dimensions[1]; j++)
-    {
-      for (i = 0; i < dimensions[0]; i++)
-      {
-        inId = i + (j + (k * dimensions[1])) * dimensions[0];
-        vtkCell* cell = input->GetCell(i, j, k);
-        if ((i + j + k) % 2 == 0)
-        {
-          cell->TriangulateIds(0, cellPtIds);
-        }
-        else
-        {
-          cell->TriangulateIds(1, cellPtIds);
-        }
-
-        dim = cell->GetCellDimension() + 1;
-
-        numPts = cellPtIds->GetNumberOfIds();
-        numSimplices = numPts / dim;
-        type = 0;
-        switch (dim)
-        {
-          case 1:
-            type = VTK_VERTEX;
-            break;
-          case 2:
-            type = VTK_LINE;
-            break;
-          case 3:
-            type = VTK_TRIANGLE;
-            break;
-          case 4:
-            type = VTK_TETRA;
-            break;
-        }
-        if (!this->TetrahedraOnly || type == VTK_TETRA)
-        {
-          for (l = 0; l < numSimplices; l++)
-          {
-            for (m = 0; m < dim; m++)
-            {
-              pts[m] = cellPtIds->GetId(dim * l + m);
-            }
-            // copy cell data
-            newCellId = output->InsertNextCell(type, dim, pts);
-            outCD->CopyData(inCD, inId, newCellId);
-          } // for all simplices
-        }
-      } // i dimension
-    }   // j dimension
-  }     // k dimension
+  BuildOutput(rows, input->GetCellData(), output);
 
   // Update output
   output->SetPoints(newPoints);
@@ -181,7 +431,6 @@ void vtkDataSetTriangleFilter::StructuredExecute(vtkDataSet* input, vtkUnstructu
   output->Squeeze();
 
   newPoints->Delete();
-  cellPtIds->Delete();
 }
 
 // 3D cells use the ordered triangulator. The ordered triangulator is used
@@ -193,17 +442,8 @@ void vtkDataSetTriangleFilter::UnstructuredExecute(
 {
   vtkPointSet* input = static_cast<vtkPointSet*>(dataSetInput); // has to be
   vtkIdType numCells = input->GetNumberOfCells();
-  vtkGenericCell* cell;
-  vtkIdType newCellId, j;
-  int k;
   vtkCellData* inCD = input->GetCellData();
   vtkCellData* outCD = output->GetCellData();
-  vtkIdList* cellPtIds;
-  vtkIdType ptId, numTets, ncells;
-  int numPts, type;
-  int numSimplices, dim;
-  vtkIdType pts[4];
-  double x[3];
 
   if (numCells == 0)
   {
@@ -247,141 +487,34 @@ void vtkDataSetTriangleFilter::UnstructuredExecute(
     }
   }
 
-  cell = vtkGenericCell::New();
-  cellPtIds = vtkIdList::New();
-
   // Create an array of points
   vtkCellData* tempCD = vtkCellData::New();
   tempCD->ShallowCopy(inCD);
   tempCD->SetActiveGlobalIds(nullptr);
 
-  outCD->CopyAllocate(tempCD, input->GetNumberOfCells() * 5);
-  output->Allocate(input->GetNumberOfCells() * 5);
-
   // Points are passed through
   output->SetPoints(input->GetPoints());
   output->GetPointData()->PassData(input->GetPointData());
 
-  int abort = 0;
-  vtkIdType updateTime = numCells / 20 + 1; // update roughly every 5%
-  for (vtkIdType cellId = 0; cellId < numCells && !abort; cellId++)
-  {
-    if (!(cellId % updateTime))
-    {
-      this->UpdateProgress(static_cast<double>(cellId) / numCells);
-      abort = this->CheckAbort();
-    }
-
-    input->GetCell(cellId, cell);
-    dim = cell->GetCellDimension();
+  // Build the cells of the input, if needed, before accessing them from
+  // several threads.
+  vtkNew<vtkGenericCell> cell;
+  input->GetCell(0, cell);
 
-    if (cell->GetCellType() == VTK_POLYHEDRON) // polyhedron
-    {
-      dim = 4;
-      cell->TriangulateIds(0, cellPtIds);
-      numPts = cellPtIds->GetNumberOfIds();
-
-      numSimplices = numPts / dim;
-      type = VTK_TETRA;
+  // The cells are triangulated in batches, in parallel.
+  vtkIdType numBatches = (numCells - 1) / TriangulationBatchSize + 1;
+  std::vector<vtkSimplexBatch> batches(numBatches);
+  TriangulateUnstructuredCells triangulate(
+    input, this->TetrahedraOnly, batches, this, this->Triangulator);
+  vtkSMPTools::For(0, numBatches, 1, triangulate);
+  this->UpdateProgress(0.8);
 
-      for (j = 0; j < numSimplices; j++)
-      {
-        for (k = 0; k < dim; k++)
-        {
-          pts[k] = cellPtIds->GetId(dim * j + k);
-        }
-        // copy cell data
-        newCellId = output->InsertNextCell(type, dim, pts);
-        outCD->CopyData(tempCD, cellId, newCellId);
-      }
-    }
-
-    else if (dim == 3) // use ordered triangulation
-    {
-      numPts = cell->GetNumberOfPoints();
-      double *p, *pPtr = cell->GetParametricCoords();
-      this->Triangulator->InitTriangulation(0.0, 1.0, 0.0, 1.0, 0.0, 1.0, numPts);
-      for (p = pPtr, j = 0; j < numPts; j++, p += 3)
-      {
-        // the wedge is "flipped" compared to other cells in that
-        // the normal of the first face points out instead of in
-        // so we flip the way we pass the points to the triangulator
-        const vtkIdType wedgemap[18] = { 3, 4, 5, 0, 1, 2, 9, 10, 11, 6, 7, 8, 12, 13, 14, 15, 16,
-          17 };
-        type = cell->GetCellType();
-        if (type == VTK_WEDGE || type == VTK_QUADRATIC_WEDGE ||
-          type == VTK_QUADRATIC_LINEAR_WEDGE || type == VTK_BIQUADRATIC_QUADRATIC_WEDGE)
-        {
-          ptId = cell->PointIds->GetId(wedgemap[j]);
-          cell->Points->GetPoint(wedgemap[j], x);
-        }
-        else
-        {
-          ptId = cell->PointIds->GetId(j);
-          cell->Points->GetPoint(j, x);
-        }
-        this->Triangulator->InsertPoint(ptId, x, p, 0);
-      }                          // for all cell points
-      if (cell->IsPrimaryCell()) // use templates if topology is fixed
-      {
-        int numEdges = cell->GetNumberOfEdges();
-        this->Triangulator->TemplateTriangulate(cell->GetCellType(), numPts, numEdges);
-      }
-      else // use ordered triangulator
-      {
-        this->Triangulator->Triangulate();
-      }
-
-      ncells = output->GetNumberOfCells();
-      numTets = this->Triangulator->AddTetras(0, output);
-
-      for (j = 0; j < numTets; j++)
-      {
-        outCD->CopyData(tempCD, cellId, ncells + j);
-      }
-    }
-
-    else if (!this->TetrahedraOnly) // 2D or lower dimension
-    {
-      dim++;
-      cell->TriangulateIds(0, cellPtIds);
-      numPts = cellPtIds->GetNumberOfIds();
-
-      numSimplices = numPts / dim;
-      type = 0;
-      switch (dim)
-      {
-        case 1:
-          type = VTK_VERTEX;
-          break;
-        case 2:
-          type = VTK_LINE;
-          break;
-        case 3:
-          type = VTK_TRIANGLE;
-          break;
-      }
-
-      for (j = 0; j < numSimplices; j++)
-      {
-        for (k = 0; k < dim; k++)
-        {
-          pts[k] = cellPtIds->GetId(dim * j + k);
-        }
-        // copy cell data
-        newCellId = output->InsertNextCell(type, dim, pts);
-        outCD->CopyData(tempCD, cellId, newCellId);
-      }
-    } // if 2D or less cell
-  }   // for all cells
+  BuildOutput(batches, tempCD, output);
 
   // Update output
   output->Squeeze();
 
   tempCD->Delete();
-
-  cellPtIds->Delete();
-  cell->Delete();
 }
 
 int vtkDataSetTriangleFilter::FillInputPortInformation(int, vtkInformation* info)
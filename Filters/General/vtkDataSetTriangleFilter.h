@@ -15,6 +15,10 @@
  * This approach produces templates on the fly for triangulating the
  * cells. The templates are then used to do the actual triangulation.
  *
+ * The cells are triangulated in parallel with vtkSMPTools, in batches of
+ * consecutive cells whose simplices are concatenated in order, so the output
+ * does not depend on the number of threads.
+ *
  * @sa
  * vtkOrderedTriangulator vtkTriangleFilter
  */
@@ -54,7 +58,7 @@ protected:
 
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
-  // Used to triangulate 3D cells
+  // Used to configure the triangulators of the threads
   vtkOrderedTriangulator* Triangulator;
 
   // Different execute methods depending on whether input is structured or not
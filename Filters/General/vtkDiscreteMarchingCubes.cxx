@@ -8,6 +8,8 @@
 #include "vtkCharArray.h"
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageTransform.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -19,7 +21,9 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredPoints.h"
 #include "vtkUnsignedCharArray.h"
@@ -27,6 +31,9 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <algorithm>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkDiscreteMarchingCubes);
 
@@ -50,34 +57,50 @@ vtkDiscreteMarchingCubes::vtkDiscreteMarchingCubes()
 
 vtkDiscreteMarchingCubes::~vtkDiscreteMarchingCubes() = default;
 
+namespace
+{
+// The edges of a voxel, as used by the case table: the offset of their first
+// point in the voxel and their axis. Edges go along increasing coordinates.
+const int EdgeOrigins[12][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 0 }, { 0, 0, 1 },
+  { 1, 0, 1 }, { 0, 1, 1 }, { 0, 0, 1 }, { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } };
+const int EdgeAxes[12] = { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 };
+
+// Whether the voxel ijk is the first voxel of the traversal to use one of
+// its edges, i.e. the lowest voxel around the edge.
+bool IsFirstVoxel(int edge, const int ijk[3])
+{
+  for (int d = 0; d < 3; d++)
+  {
+    if (d != EdgeAxes[edge] && EdgeOrigins[edge][d] == 0 && ijk[d] > 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The boundaries of the labels on the voxel edges of a layer of voxels. A
+// boundary point is identified by its key, (3 * first point of the edge +
+// axis) * number of labels + label number. Vertices lists the points created
+// by the layer, in the order the traversal first uses them, and
+// TriangleVertices the three points of each triangle.
+struct vtkDiscreteMarchingCubesLayer
+{
+  std::vector<vtkIdType> Vertices;
+  std::vector<vtkIdType> TriangleVertices;
+};
+}
+
 //
 // Contouring filter specialized for volumes and "short int" data values.
+// The layers of voxels are processed in parallel.
 //
 template <class T>
 void vtkDiscreteMarchingCubesComputeGradient(vtkDiscreteMarchingCubes* self, T* scalars,
-  int dims[3], vtkIncrementalPointLocator* locator, vtkDataArray* newCellScalars,
-  vtkDataArray* newPointScalars, vtkCellArray* newPolys, double* values, int numValues)
+  int dims[3], double* values, int numValues, std::vector<vtkDiscreteMarchingCubesLayer>& layers)
 {
-  double s[8], value;
-  int i, j, k, pts[8][3], xp, yp, zp, *x1, *x2;
-  vtkIdType sliceSize, rowSize;
   static const int CASE_MASK[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
-  vtkMarchingCubesTriangleCases *triCase, *triCases;
-  int* edge;
-  int contNum, ii, index, *vert;
-  vtkIdType jOffset, kOffset, idx;
-  vtkIdType ptIds[3];
-  int extent[6];
-  vtkTypeBool ComputeScalars = newCellScalars != nullptr;
-  int ComputeAdjacentScalars = newPointScalars != nullptr;
-  double t, x[3], min, max;
-  static int edges[12][2] = { { 0, 1 }, { 1, 2 }, { 3, 2 }, { 0, 3 }, { 4, 5 }, { 5, 6 }, { 7, 6 },
-    { 4, 7 }, { 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 } };
-
-  vtkInformation* inInfo = self->GetExecutive()->GetInputInformation(0, 0);
-  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
-
-  triCases = vtkMarchingCubesTriangleCases::GetCases();
+  const vtkMarchingCubesTriangleCases* triCases = vtkMarchingCubesTriangleCases::GetCases();
 
   //
   // Get min/max contour values
@@ -86,161 +109,157 @@ void vtkDiscreteMarchingCubesComputeGradient(vtkDiscreteMarchingCubes* self, T*
   {
     return;
   }
-  for (min = max = values[0], i = 1; i < numValues; i++)
+  double min = values[0];
+  double max = values[0];
+  for (int i = 1; i < numValues; i++)
   {
-    if (values[i] < min)
-    {
-      min = values[i];
-    }
-    if (values[i] > max)
-    {
-      max = values[i];
-    }
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+  }
+
+  const vtkIdType rowSize = dims[0];
+  const vtkIdType sliceSize = rowSize * dims[1];
+  vtkIdType edgeOffsets[12];
+  for (int e = 0; e < 12; e++)
+  {
+    edgeOffsets[e] =
+      EdgeOrigins[e][0] + EdgeOrigins[e][1] * rowSize + EdgeOrigins[e][2] * sliceSize;
   }
+
   //
   // Traverse all voxel cells, generating triangles
   // using marching cubes algorithm.
   //
-  rowSize = dims[0];
-  sliceSize = rowSize * dims[1];
-  for (k = 0; k < (dims[2] - 1); k++)
-  {
-    self->UpdateProgress(static_cast<double>(k) / (dims[2] - 1));
-    if (self->CheckAbort())
+  vtkSMPTools::For(0, dims[2] - 1, [&](vtkIdType beginK, vtkIdType endK) {
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    double s[8];
+    for (int k = static_cast<int>(beginK); k < endK; k++)
     {
-      break;
-    }
-    kOffset = k * sliceSize;
-    pts[0][2] = k + extent[4];
-    zp = pts[0][2] + 1;
-    for (j = 0; j < (dims[1] - 1); j++)
-    {
-      jOffset = j * rowSize;
-      pts[0][1] = j + extent[2];
-      yp = pts[0][1] + 1;
-      for (i = 0; i < (dims[0] - 1); i++)
+      if (isFirst)
+      {
+        self->CheckAbort();
+      }
+      if (self->GetAbortOutput())
+      {
+        break;
+      }
+      vtkDiscreteMarchingCubesLayer& layer = layers[k];
+      const vtkIdType kOffset = k * sliceSize;
+      for (int j = 0; j < (dims[1] - 1); j++)
       {
-        // get scalar values
-        idx = i + jOffset + kOffset;
-        s[0] = scalars[idx];
-        s[1] = scalars[idx + 1];
-        s[2] = scalars[idx + 1 + dims[0]];
-        s[3] = scalars[idx + dims[0]];
-        s[4] = scalars[idx + sliceSize];
-        s[5] = scalars[idx + 1 + sliceSize];
-        s[6] = scalars[idx + 1 + dims[0] + sliceSize];
-        s[7] = scalars[idx + dims[0] + sliceSize];
-
-        if ((s[0] < min && s[1] < min && s[2] < min && s[3] < min && s[4] < min && s[5] < min &&
-              s[6] < min && s[7] < min) ||
-          (s[0] > max && s[1] > max && s[2] > max && s[3] > max && s[4] > max && s[5] > max &&
-            s[6] > max && s[7] > max))
+        const vtkIdType jOffset = j * rowSize;
+        for (int i = 0; i < (dims[0] - 1); i++)
         {
-          continue; // no contours possible
-        }
-
-        // create voxel points
-        pts[0][0] = i + extent[0];
-        xp = pts[0][0] + 1;
-
-        pts[1][0] = xp;
-        pts[1][1] = pts[0][1];
-        pts[1][2] = pts[0][2];
-
-        pts[2][0] = xp;
-        pts[2][1] = yp;
-        pts[2][2] = pts[0][2];
-
-        pts[3][0] = pts[0][0];
-        pts[3][1] = yp;
-        pts[3][2] = pts[0][2];
-
-        pts[4][0] = pts[0][0];
-        pts[4][1] = pts[0][1];
-        pts[4][2] = zp;
-
-        pts[5][0] = xp;
-        pts[5][1] = pts[0][1];
-        pts[5][2] = zp;
-
-        pts[6][0] = xp;
-        pts[6][1] = yp;
-        pts[6][2] = zp;
-
-        pts[7][0] = pts[0][0];
-        pts[7][1] = yp;
-        pts[7][2] = zp;
+          // get scalar values
+          const vtkIdType idx = i + jOffset + kOffset;
+          s[0] = scalars[idx];
+          s[1] = scalars[idx + 1];
+          s[2] = scalars[idx + 1 + dims[0]];
+          s[3] = scalars[idx + dims[0]];
+          s[4] = scalars[idx + sliceSize];
+          s[5] = scalars[idx + 1 + sliceSize];
+          s[6] = scalars[idx + 1 + dims[0] + sliceSize];
+          s[7] = scalars[idx + dims[0] + sliceSize];
+
+          if ((s[0] < min && s[1] < min && s[2] < min && s[3] < min && s[4] < min && s[5] < min &&
+                s[6] < min && s[7] < min) ||
+            (s[0] > max && s[1] > max && s[2] > max && s[3] > max && s[4] > max && s[5] > max &&
+              s[6] > max && s[7] > max))
+          {
+            continue; // no contours possible
+          }
 
-        for (contNum = 0; contNum < numValues; contNum++)
-        {
-          value = values[contNum];
-          // Build the case table
-          for (ii = 0, index = 0; ii < 8; ii++)
+          const int ijk[3] = { i, j, k };
+          for (int contNum = 0; contNum < numValues; contNum++)
           {
-            // for discrete marching cubes, we are looking for an
-            // exact match of a scalar at a vertex to a value
-            if (s[ii] == value)
+            const double value = values[contNum];
+            // Build the case table
+            int index = 0;
+            for (int ii = 0; ii < 8; ii++)
             {
-              index |= CASE_MASK[ii];
+              // for discrete marching cubes, we are looking for an
+              // exact match of a scalar at a vertex to a value
+              if (s[ii] == value)
+              {
+                index |= CASE_MASK[ii];
+              }
+            }
+            if (index == 0 || index == 255) // no surface
+            {
+              continue;
             }
-          }
-          if (index == 0 || index == 255) // no surface
-          {
-            continue;
-          }
-
-          triCase = triCases + index;
-          edge = triCase->edges;
 
-          for (; edge[0] > -1; edge += 3)
-          {
-            for (ii = 0; ii < 3; ii++) // insert triangle
+            // Each boundary point is created by the first voxel using it.
+            int usedEdges = 0;
+            for (const int* edge = triCases[index].edges; edge[0] > -1; edge += 3)
             {
-              vert = edges[edge[ii]];
-              // for discrete marching cubes, the interpolation point
-              // is always 0.5.
-              t = 0.5;
-              x1 = pts[vert[0]];
-              x2 = pts[vert[1]];
-              x[0] = x1[0] + t * (x2[0] - x1[0]);
-              x[1] = x1[1] + t * (x2[1] - x1[1]);
-              x[2] = x1[2] + t * (x2[2] - x1[2]);
-
-              // add point
-              if (locator->InsertUniquePoint(x, ptIds[ii]))
+              for (int ii = 0; ii < 3; ii++) // insert triangle
               {
-                if (ComputeAdjacentScalars)
+                const int e = edge[ii];
+                const vtkIdType key =
+                  (3 * (idx + edgeOffsets[e]) + EdgeAxes[e]) * numValues + contNum;
+                if (!(usedEdges & (1 << e)))
                 {
-                  // check which vert holds the neighbour value
-                  if (s[vert[0]] == value)
-                  {
-                    newPointScalars->InsertTuple(ptIds[ii], &s[vert[1]]);
-                  }
-                  else
+                  usedEdges |= 1 << e;
+                  if (IsFirstVoxel(e, ijk))
                   {
-                    newPointScalars->InsertTuple(ptIds[ii], &s[vert[0]]);
+                    layer.Vertices.push_back(key);
                   }
                 }
+                layer.TriangleVertices.push_back(key);
               }
-            }
-            // check for degenerate triangle
-            if (ptIds[0] != ptIds[1] && ptIds[0] != ptIds[2] && ptIds[1] != ptIds[2])
-            {
-              newPolys->InsertNextCell(3, ptIds);
-              // Note that DiscreteMarchingCubes stores the scalar
-              // data in the cells. It does not use the point data
-              // since cells from different labeled segments may use
-              // the same point.
-              if (ComputeScalars)
-              {
-                newCellScalars->InsertNextTuple(&value);
-              }
-            }
-          } // for each triangle
-        }   // for all contours
-      }     // for i
-    }       // for j
-  }         // for k
+            } // for each triangle
+          }   // for all contours
+        }     // for i
+      }       // for j
+    }         // for k
+  });
+}
+
+//
+// Compute the boundary points half-way along their edge and, if requested,
+// the label on the other side of the boundary.
+//
+template <class T>
+void vtkDiscreteMarchingCubesInterpolate(T* scalars, int dims[3], const int extent[6],
+  double* values, int numValues, vtkIdTypeArray* vertexKeys, vtkDoubleArray* vertexPoints,
+  std::vector<double>& adjacentScalars)
+{
+  const vtkIdType rowSize = dims[0];
+  const vtkIdType sliceSize = rowSize * dims[1];
+  const vtkIdType increments[3] = { 1, rowSize, sliceSize };
+  vtkSMPTools::For(0, vertexKeys->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+    double x1[3], x2[3];
+    for (vtkIdType vertex = begin; vertex < end; ++vertex)
+    {
+      const vtkIdType key = vertexKeys->GetValue(vertex);
+      const vtkIdType edgeId = key / numValues;
+      const vtkIdType ptId = edgeId / 3;
+      const int axis = static_cast<int>(edgeId % 3);
+      const int ijk[3] = { static_cast<int>(ptId % rowSize),
+        static_cast<int>((ptId / rowSize) % dims[1]), static_cast<int>(ptId / sliceSize) };
+      for (int d = 0; d < 3; d++)
+      {
+        x1[d] = x2[d] = ijk[d] + extent[2 * d];
+      }
+      x2[axis] += 1;
+      // for discrete marching cubes, the interpolation point
+      // is always 0.5.
+      const double t = 0.5;
+      double* x = vertexPoints->GetPointer(3 * vertex);
+      x[0] = x1[0] + t * (x2[0] - x1[0]);
+      x[1] = x1[1] + t * (x2[1] - x1[1]);
+      x[2] = x1[2] + t * (x2[2] - x1[2]);
+
+      if (!adjacentScalars.empty())
+      {
+        // check which point holds the neighbour value
+        const double s1 = scalars[ptId];
+        const double s2 = scalars[ptId + increments[axis]];
+        adjacentScalars[vertex] = s1 == values[key % numValues] ? s2 : s1;
+      }
+    }
+  });
 }
 
 //
@@ -252,15 +271,10 @@ int vtkDiscreteMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
-  vtkPoints* newPts;
-  vtkCellArray* newPolys;
-  vtkFloatArray* newCellScalars;
-  vtkFloatArray* newPointScalars;
   vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkPointData* pd;
   vtkDataArray* inScalars;
   int dims[3], extent[6];
-  vtkIdType estimatedSize;
   double bounds[6];
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkIdType numContours = this->ContourValues->GetNumberOfContours();
@@ -299,111 +313,122 @@ int vtkDiscreteMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
 
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
 
-  // estimate the number of points from the volume dimensions
-  estimatedSize = dims[0];
-  estimatedSize *= dims[1]; // The "*=" ensures coercion to vtkIdType,
-  estimatedSize *= dims[2]; // which might be wider than "int"
-  estimatedSize = static_cast<vtkIdType>(pow(static_cast<double>(estimatedSize), .75));
-  estimatedSize = estimatedSize / 1024 * 1024; // multiple of 1024
-  if (estimatedSize < 1024)
-  {
-    estimatedSize = 1024;
-  }
-  vtkDebugMacro(<< "Estimated allocation size is " << estimatedSize);
-  newPts = vtkPoints::New();
-  newPts->Allocate(estimatedSize, estimatedSize / 2);
-
   // compute bounds for merging points
   for (int i = 0; i < 3; i++)
   {
     bounds[2 * i] = extent[2 * i];
     bounds[2 * i + 1] = extent[2 * i + 1];
   }
-  if (this->Locator == nullptr)
-  {
-    this->CreateDefaultLocator();
-  }
-  this->Locator->InitPointInsertion(newPts, bounds, estimatedSize);
 
-  newPolys = vtkCellArray::New();
-  newPolys->AllocateEstimate(estimatedSize, 3);
-
-  if (this->ComputeScalars)
+  vtkSmartPointer<vtkDataArray> labels = inScalars;
+  if (inScalars->GetNumberOfComponents() != 1) // multiple components - have to convert
   {
-    newCellScalars = vtkFloatArray::New();
-    newCellScalars->SetName("Scalars");
-    newCellScalars->Allocate(estimatedSize, 3);
-  }
-  else
-  {
-    newCellScalars = nullptr;
+    vtkIdType dataSize = dims[0];
+    dataSize *= dims[1]; // The "*=" ensures coercion to vtkIdType,
+    dataSize *= dims[2]; // which might be wider than "int".
+    vtkNew<vtkDoubleArray> image;
+    image->SetNumberOfComponents(inScalars->GetNumberOfComponents());
+    image->SetNumberOfTuples(image->GetNumberOfComponents() * dataSize);
+    inScalars->GetTuples(0, dataSize, image);
+    labels = image;
   }
+  void* scalars = labels->GetVoidPointer(0);
 
-  if (this->ComputeAdjacentScalars)
+  // Generate the triangles of each layer of voxels in parallel.
+  std::vector<vtkDiscreteMarchingCubesLayer> layers(dims[2] - 1);
+  switch (labels->GetDataType())
   {
-    newPointScalars = vtkFloatArray::New();
-    newPointScalars->SetName("AdjacentScalars");
-    newPointScalars->Allocate(estimatedSize, estimatedSize / 2);
-  }
-  else
+    vtkTemplateMacro(vtkDiscreteMarchingCubesComputeGradient(
+      this, static_cast<VTK_TT*>(scalars), dims, values, numContours, layers));
+  } // switch
+  this->UpdateProgress(0.5);
+
+  // Gather the layers, in traversal order.
+  std::vector<vtkIdType> vertexOffsets(layers.size() + 1, 0);
+  std::vector<vtkIdType> cornerOffsets(layers.size() + 1, 0);
+  for (size_t layerId = 0; layerId < layers.size(); ++layerId)
   {
-    newPointScalars = nullptr;
+    vertexOffsets[layerId + 1] =
+      vertexOffsets[layerId] + static_cast<vtkIdType>(layers[layerId].Vertices.size());
+    cornerOffsets[layerId + 1] =
+      cornerOffsets[layerId] + static_cast<vtkIdType>(layers[layerId].TriangleVertices.size());
   }
-
-  if (inScalars->GetNumberOfComponents() == 1)
-  {
-    void* scalars = inScalars->GetVoidPointer(0);
-    switch (inScalars->GetDataType())
+  vtkNew<vtkIdTypeArray> vertexKeys;
+  vertexKeys->SetNumberOfValues(vertexOffsets.back());
+  vtkNew<vtkIdTypeArray> triangleKeys;
+  triangleKeys->SetNumberOfValues(cornerOffsets.back());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(layers.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType layerId = begin; layerId < end; ++layerId)
     {
-      vtkTemplateMacro(vtkDiscreteMarchingCubesComputeGradient(this, static_cast<VTK_TT*>(scalars),
-        dims, this->Locator, newCellScalars, newPointScalars, newPolys, values, numContours));
-    } // switch
+      vtkDiscreteMarchingCubesLayer& layer = layers[layerId];
+      std::copy(layer.Vertices.begin(), layer.Vertices.end(),
+        vertexKeys->GetPointer(vertexOffsets[layerId]));
+      std::copy(layer.TriangleVertices.begin(), layer.TriangleVertices.end(),
+        triangleKeys->GetPointer(cornerOffsets[layerId]));
+      layer = vtkDiscreteMarchingCubesLayer();
+    }
+  });
+
+  vtkNew<vtkDoubleArray> vertexPoints;
+  vertexPoints->SetNumberOfComponents(3);
+  vertexPoints->SetNumberOfTuples(vertexKeys->GetNumberOfValues());
+  std::vector<double> adjacentScalars(
+    this->ComputeAdjacentScalars ? vertexKeys->GetNumberOfValues() : 0);
+  switch (labels->GetDataType())
+  {
+    vtkTemplateMacro(vtkDiscreteMarchingCubesInterpolate(static_cast<VTK_TT*>(scalars), dims,
+      extent, values, numContours, vertexKeys, vertexPoints, adjacentScalars));
+  } // switch
+
+  vtkNew<vtkPoints> newPts;
+  vtkNew<vtkCellArray> newPolys;
+  vtkNew<vtkIdList> pointVertices;
+  vtkNew<vtkIdList> triangles;
+  this->MergeTriangles(
+    vertexKeys, vertexPoints, triangleKeys, bounds, newPts, newPolys, pointVertices, triangles);
+
+  // Note that DiscreteMarchingCubes stores the scalar data in the cells. It
+  // does not use the point data since cells from different labeled segments
+  // may use the same point.
+  if (this->ComputeScalars)
+  {
+    vtkNew<vtkFloatArray> newCellScalars;
+    newCellScalars->SetName("Scalars");
+    newCellScalars->SetNumberOfTuples(triangles->GetNumberOfIds());
+    vtkSMPTools::For(0, triangles->GetNumberOfIds(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        const vtkIdType key = triangleKeys->GetValue(3 * triangles->GetId(cellId));
+        newCellScalars->SetValue(cellId, static_cast<float>(values[key % numContours]));
+      }
+    });
+    output->GetCellData()->SetScalars(newCellScalars);
   }
 
-  else // multiple components - have to convert
+  // The adjacent scalars of the points come from the boundary points creating them.
+  if (this->ComputeAdjacentScalars)
   {
-    vtkIdType dataSize = dims[0];
-    dataSize *= dims[1]; // The "*=" ensures coercion to vtkIdType,
-    dataSize *= dims[2]; // which might be wider than "int".
-    vtkDoubleArray* image = vtkDoubleArray::New();
-    image->SetNumberOfComponents(inScalars->GetNumberOfComponents());
-    image->SetNumberOfTuples(image->GetNumberOfComponents() * dataSize);
-    inScalars->GetTuples(0, dataSize, image);
-
-    double* scalars = image->GetPointer(0);
-    vtkDiscreteMarchingCubesComputeGradient(this, scalars, dims, this->Locator, newCellScalars,
-      newPointScalars, newPolys, values, numContours);
-    image->Delete();
+    vtkNew<vtkFloatArray> newPointScalars;
+    newPointScalars->SetName("AdjacentScalars");
+    newPointScalars->SetNumberOfTuples(pointVertices->GetNumberOfIds());
+    vtkSMPTools::For(0, pointVertices->GetNumberOfIds(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        newPointScalars->SetValue(
+          ptId, static_cast<float>(adjacentScalars[pointVertices->GetId(ptId)]));
+      }
+    });
+    int idx = output->GetPointData()->AddArray(newPointScalars);
+    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
   }
 
   vtkDebugMacro(<< "Created: " << newPts->GetNumberOfPoints() << " points, "
                 << newPolys->GetNumberOfCells() << " triangles");
   //
-  // Update ourselves.  Because we don't know up front how many triangles
-  // we've created, take care to reclaim memory.
+  // Update ourselves.
   //
   output->SetPoints(newPts);
-  newPts->Delete();
-
   output->SetPolys(newPolys);
-  newPolys->Delete();
-
-  if (newCellScalars)
-  {
-    output->GetCellData()->SetScalars(newCellScalars);
-    newCellScalars->Delete();
-  }
-  if (newPointScalars)
-  {
-    int idx = output->GetPointData()->AddArray(newPointScalars);
-    output->GetPointData()->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
-    newPointScalars->Delete();
-  }
-  output->Squeeze();
-  if (this->Locator)
-  {
-    this->Locator->Initialize(); // free storage
-  }
 
   vtkImageTransform::TransformPointSet(input, output);
 
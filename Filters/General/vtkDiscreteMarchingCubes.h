@@ -47,6 +47,9 @@
  * http://hdl.handle.net/10380/3559
  * http://www.vtkjournal.org/browse/publication/975
  *
+ * As in vtkMarchingCubes, the layers of voxels are processed in parallel and
+ * the output does not depend on the number of threads.
+ *
  * @warning
  * This filter is specialized to volumes. If you are interested in contouring
  * other types of data, use the general vtkContourFilter. If you want to
@@ -12,6 +12,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkLongArray.h"
+#include "vtkNew.h"
 #include "vtkOBBTree.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
@@ -20,16 +21,23 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkTransform.h"
 #include "vtkTransformPolyDataFilter.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <set>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -49,6 +57,95 @@ struct simPolygon
   int orientation;
 };
 
+// Non coplanar intersection of a triangle of each input
+struct TriangleIntersectionType
+{
+  vtkIdType CellId0;
+  vtkIdType CellId1;
+  double Point0[3];
+  double Point1[3];
+  double SurfaceId[2];
+};
+
+typedef std::pair<vtkOBBNode*, vtkOBBNode*> NodePairType;
+
+// New cell of a split cell that lies along the intersection lines: its index
+// among the new cells of the split cell, and its points on the lines
+struct NewCellType
+{
+  int CellIndex;
+  int InterPtCount;
+  int InterPts[3];
+};
+
+// Split of a cell of an input. The writes to the boundary points and to the
+// new cell ids of the intersection lines are recorded, so that they can be
+// applied in the order of the cells once the cells are split in parallel.
+struct SplitCellType
+{
+  vtkSmartPointer<vtkCellArray> Cells;
+  std::vector<std::pair<vtkIdType, int>> BoundaryPoints;
+  std::vector<NewCellType> NewCells;
+};
+
+// Builds the links of a polydata serially. The threaded build of
+// vtkStaticCellLinks lists the cells using a point in an arbitrary order.
+// The splitting of the cells depends on that order: GetLoops starts each
+// loop with the first line using a point, which sets the direction in which
+// the loop is walked, hence the loops and their triangulation. The split
+// surfaces would then change from one execution to the next. The polydata
+// linked while splitting hold the lines of a single cell, so building their
+// links serially costs nothing.
+void BuildLinksSerially(vtkPolyData* pd)
+{
+  if (pd->NeedToBuildCells())
+  {
+    pd->BuildCells();
+  }
+  if (!pd->GetPoints())
+  {
+    return;
+  }
+  vtkNew<vtkStaticCellLinks> links;
+  links->SequentialProcessingOn();
+  links->SetDataSet(pd);
+  links->BuildLinks();
+  pd->SetLinks(links);
+}
+
+// Appends the pairs of kids of two overlapping nodes in the order in which
+// vtkOBBTree::IntersectWithOBBTree pushes them on its stack
+void PushKidPairs(vtkOBBNode* node0, vtkOBBNode* node1, std::vector<NodePairType>& stack)
+{
+  if (node0->Kids == nullptr)
+  {
+    stack.emplace_back(node0, node1->Kids[0]);
+    stack.emplace_back(node0, node1->Kids[1]);
+  }
+  else if (node1->Kids == nullptr)
+  {
+    stack.emplace_back(node0->Kids[0], node1);
+    stack.emplace_back(node0->Kids[1], node1);
+  }
+  else
+  {
+    stack.emplace_back(node0->Kids[0], node1->Kids[0]);
+    stack.emplace_back(node0->Kids[1], node1->Kids[0]);
+    stack.emplace_back(node0->Kids[0], node1->Kids[1]);
+    stack.emplace_back(node0->Kids[1], node1->Kids[1]);
+  }
+}
+
+// Whether the calling thread may check for abort through the filter. The
+// check updates the filter, so only one thread of a parallel loop does it.
+bool IsAbortCheckingThread()
+{
+  return !vtkSMPTools::IsParallelScope() || vtkSMPTools::GetSingleThread();
+}
+
+// Minimum number of subtree pairs traversed in parallel
+constexpr std::size_t MinNumberOfSubtreePairs = 1024;
+
 }
 
 typedef std::multimap<vtkIdType, vtkIdType> IntersectionMapType;
@@ -73,17 +170,27 @@ public:
   Impl();
   virtual ~Impl();
 
-  // Finds all triangle triangle intersections between two input OOBTrees
-  static int FindTriangleIntersections(
-    vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
+  // Records the pairs of leaf nodes of the two input OBBTrees that may
+  // contain intersecting triangles, in the order of
+  // vtkOBBTree::IntersectWithOBBTree. Subtrees are traversed in parallel.
+  void FindNodePairs(vtkOBBTree* obbTree0, vtkOBBTree* obbTree1);
+
+  // Computes the triangle triangle intersections of all the recorded node
+  // pairs in parallel, then adds them to the intersection lines and maps in
+  // the order of the tree traversal
+  void ComputeTriangleIntersections();
 
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
 protected:
+  // Adds a triangle triangle intersection to the intersection lines and maps
+  void AddTriangleIntersection(const TriangleIntersectionType& intersection);
+
   // Split cells into polygons created by intersection lines
-  vtkCellArray* SplitCell(vtkPolyData* input, vtkIdType cellId, const vtkIdType* cellPts,
-    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, int numCurrCells);
+  vtkCellArray* SplitCell(vtkPolyData* input, const double bounds[6], vtkIdType cellId,
+    const vtkIdType* cellPts, IntersectionMapType* map, vtkPolyData* interLines, int inputIndex,
+    SplitCellType& split);
 
   // Function to add point to check edge list for remeshing step
   int AddToPointEdgeMap(int index, vtkIdType ptId, double x[3], vtkPolyData* mesh, vtkIdType cellId,
@@ -126,6 +233,12 @@ public:
   vtkPolyData* Mesh[2];
   vtkOBBTree* OBBTree1;
 
+  // Leaf node pairs found by the tree traversal
+  std::vector<NodePairType> NodePairs;
+
+  // Intersection lines already added, as sorted point id pairs
+  std::set<std::pair<vtkIdType, vtkIdType>> LineSet;
+
   // Stores the intersection lines.
   vtkCellArray* IntersectionLines;
 
@@ -159,9 +272,9 @@ public:
   PointEdgeMapType* PointEdgeMap[2];
 
   // vtkPolyData to hold current splitting cell. Used to double check area
-  // of small area cells
-  vtkPolyData* SplittingPD;
-  int TransformSign;
+  // of small area cells. Each thread splits its own cells.
+  vtkSMPThreadLocalObject<vtkPolyData> SplittingPD;
+  vtkSMPThreadLocal<int> TransformSign;
   double Tolerance;
   double RelativeSubtriangleArea;
 
@@ -189,8 +302,6 @@ vtkIntersectionPolyDataFilter::Impl::Impl()
     this->PointEdgeMap[i] = new PointEdgeMapType();
   }
   this->PointMapper = new IntersectionMapType();
-  this->SplittingPD = vtkPolyData::New();
-  this->TransformSign = 0;
   this->Tolerance = 1e-6;
   this->RelativeSubtriangleArea = 1e-4;
 }
@@ -205,250 +316,364 @@ vtkIntersectionPolyDataFilter::Impl::~Impl()
     delete this->PointEdgeMap[i];
   }
   delete this->PointMapper;
-  this->SplittingPD->Delete();
 }
 
 //------------------------------------------------------------------------------
-int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
-  vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg)
+void vtkIntersectionPolyDataFilter::Impl::FindNodePairs(
+  vtkOBBTree* obbTree0, vtkOBBTree* obbTree1)
 {
-  vtkIntersectionPolyDataFilter::Impl* info =
-    reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
+  this->NodePairs.clear();
+  if (obbTree0->GetRoot() == nullptr || obbTree1->GetRoot() == nullptr)
+  {
+    return;
+  }
 
-  // Set up local structures to hold Impl array information
-  vtkPolyData* mesh0 = info->Mesh[0];
-  vtkPolyData* mesh1 = info->Mesh[1];
-  vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
-  double tolerance = info->Tolerance;
-
-  // The number of cells in OBBTree
-  int numCells0 = node0->Cells->GetNumberOfIds();
-
-  for (vtkIdType id0 = 0; id0 < numCells0; id0++)
-  {
-    vtkIdType cellId0 = node0->Cells->GetId(id0);
-    int type0 = mesh0->GetCellType(cellId0);
-
-    // Make sure the cell is a triangle
-    if (type0 == VTK_TRIANGLE)
-    {
-      vtkIdType npts0;
-      const vtkIdType* triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
-      double triPts0[3][3];
-      for (vtkIdType id = 0; id < npts0; id++)
+  // Expand the traversal serially until there are enough subtree pairs to
+  // share between the threads. The kids of an overlapping pair replace it in
+  // the reverse of their stack order, so the subtree pairs stay in the order
+  // of the traversal.
+  std::vector<NodePairType> subtreePairs(1, NodePairType(obbTree0->GetRoot(), obbTree1->GetRoot()));
+  std::vector<NodePairType> nextPairs;
+  std::vector<NodePairType> kidPairs;
+  bool expanded = true;
+  while (expanded && subtreePairs.size() < MinNumberOfSubtreePairs)
+  {
+    expanded = false;
+    nextPairs.clear();
+    for (const NodePairType& pair : subtreePairs)
+    {
+      if (obbTree0->DisjointOBBNodes(pair.first, pair.second, nullptr))
+      {
+        continue;
+      }
+      if (pair.first->Kids == nullptr && pair.second->Kids == nullptr)
+      {
+        nextPairs.push_back(pair);
+        continue;
+      }
+      kidPairs.clear();
+      PushKidPairs(pair.first, pair.second, kidPairs);
+      nextPairs.insert(nextPairs.end(), kidPairs.rbegin(), kidPairs.rend());
+      expanded = true;
+    }
+    subtreePairs.swap(nextPairs);
+  }
+
+  // Traverse each subtree pair like vtkOBBTree::IntersectWithOBBTree, and
+  // concatenate their leaf node pairs in the order of the subtree pairs.
+  vtkIdType numSubtreePairs = static_cast<vtkIdType>(subtreePairs.size());
+  std::vector<std::vector<NodePairType>> leafPairs(numSubtreePairs);
+  vtkSMPTools::For(0, numSubtreePairs, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<NodePairType> stack;
+    for (vtkIdType pairId = begin; pairId < end; pairId++)
+    {
+      stack.push_back(subtreePairs[pairId]);
+      while (!stack.empty())
       {
-        mesh0->GetPoint(triPtIds0[id], triPts0[id]);
+        NodePairType pair = stack.back();
+        stack.pop_back();
+        if (obbTree0->DisjointOBBNodes(pair.first, pair.second, nullptr))
+        {
+          continue;
+        }
+        if (pair.first->Kids == nullptr && pair.second->Kids == nullptr)
+        {
+          leafPairs[pairId].push_back(pair);
+        }
+        else
+        {
+          PushKidPairs(pair.first, pair.second, stack);
+        }
       }
+    }
+  });
+
+  for (const auto& subtreeLeafPairs : leafPairs)
+  {
+    this->NodePairs.insert(this->NodePairs.end(), subtreeLeafPairs.begin(), subtreeLeafPairs.end());
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::ComputeTriangleIntersections()
+{
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkOBBTree* obbTree1 = this->OBBTree1;
+  double tolerance = this->Tolerance;
 
-      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], transform))
+  // Cells must be built before being accessed from several threads
+  if (mesh0->NeedToBuildCells())
+  {
+    mesh0->BuildCells();
+  }
+  if (mesh1->NeedToBuildCells())
+  {
+    mesh1->BuildCells();
+  }
+
+  // Each node pair gets its own list of intersections, so that they can
+  // be added in the same order as a serial traversal.
+  vtkIdType numNodePairs = static_cast<vtkIdType>(this->NodePairs.size());
+  std::vector<std::vector<TriangleIntersectionType>> intersections(numNodePairs);
+  vtkSMPThreadLocalObject<vtkIdList> localCellPts0;
+  vtkSMPThreadLocalObject<vtkIdList> localCellPts1;
+  vtkSMPTools::For(0, numNodePairs, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* cellPts0 = localCellPts0.Local();
+    vtkIdList* cellPts1 = localCellPts1.Local();
+    for (vtkIdType pairId = begin; pairId < end; pairId++)
+    {
+      vtkOBBNode* node0 = this->NodePairs[pairId].first;
+      vtkOBBNode* node1 = this->NodePairs[pairId].second;
+
+      // The number of cells in OBBTree
+      vtkIdType numCells0 = node0->Cells->GetNumberOfIds();
+      for (vtkIdType id0 = 0; id0 < numCells0; id0++)
       {
-        int numCells1 = node1->Cells->GetNumberOfIds();
+        vtkIdType cellId0 = node0->Cells->GetId(id0);
+
+        // Make sure the cell is a triangle
+        if (mesh0->GetCellType(cellId0) != VTK_TRIANGLE)
+        {
+          continue;
+        }
+        vtkIdType npts0;
+        const vtkIdType* triPtIds0;
+        mesh0->GetCellPoints(cellId0, npts0, triPtIds0, cellPts0);
+        double triPts0[3][3];
+        for (vtkIdType id = 0; id < npts0; id++)
+        {
+          mesh0->GetPoint(triPtIds0[id], triPts0[id]);
+        }
+
+        if (!obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], nullptr))
+        {
+          continue;
+        }
+        vtkIdType numCells1 = node1->Cells->GetNumberOfIds();
         for (vtkIdType id1 = 0; id1 < numCells1; id1++)
         {
           vtkIdType cellId1 = node1->Cells->GetId(id1);
-          int type1 = mesh1->GetCellType(cellId1);
-          if (type1 == VTK_TRIANGLE)
+          if (mesh1->GetCellType(cellId1) != VTK_TRIANGLE)
           {
-            // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
-            vtkIdType npts1;
-            const vtkIdType* triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
-
-            double triPts1[3][3];
-            for (vtkIdType id = 0; id < npts1; id++)
-            {
-              mesh1->GetPoint(triPtIds1[id], triPts1[id]);
-            }
+            continue;
+          }
+          // See if the two cells actually intersect.
+          vtkIdType npts1;
+          const vtkIdType* triPtIds1;
+          mesh1->GetCellPoints(cellId1, npts1, triPtIds1, cellPts1);
 
-            int coplanar = 0;
-            double outpt0[3], outpt1[3];
-            double surfaceid[2];
-            int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
-              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, outpt0, outpt1,
-              surfaceid, tolerance);
+          double triPts1[3][3];
+          for (vtkIdType id = 0; id < npts1; id++)
+          {
+            mesh1->GetPoint(triPtIds1[id], triPts1[id]);
+          }
 
-            if (coplanar)
-            {
-              // Coplanar triangle intersection is not handled.
-              // This intersection will not be included in the output. TODO
-              // vtkDebugMacro(<<"Coplanar");
-              intersects = 0;
-              continue;
-            }
+          TriangleIntersectionType intersection;
+          int coplanar = 0;
+          int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
+            triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar,
+            intersection.Point0, intersection.Point1, intersection.SurfaceId, tolerance);
 
-            // If actual intersection, add point and cell to edge, line,
-            // and surface maps!
-            if (intersects)
-            {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+          // Coplanar triangle intersection is not handled.
+          // This intersection will not be included in the output. TODO
+          if (intersects && !coplanar)
+          {
+            intersection.CellId0 = cellId0;
+            intersection.CellId1 = cellId1;
+            intersections[pairId].push_back(intersection);
+          }
+        }
+      }
+    }
+  });
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+  for (const auto& nodeIntersections : intersections)
+  {
+    for (const auto& intersection : nodeIntersections)
+    {
+      this->AddTriangleIntersection(intersection);
+    }
+  }
+  this->NodePairs.clear();
+}
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::AddTriangleIntersection(
+  const TriangleIntersectionType& intersection)
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  vtkIdType cellId0 = intersection.CellId0;
+  vtkIdType cellId1 = intersection.CellId1;
+  double outpt0[3] = { intersection.Point0[0], intersection.Point0[1], intersection.Point0[2] };
+  double outpt1[3] = { intersection.Point1[0], intersection.Point1[1], intersection.Point1[2] };
+  const double* surfaceid = intersection.SurfaceId;
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  vtkIdType npts0, npts1;
+  const vtkIdType* triPtIds0;
+  const vtkIdType* triPtIds1;
+  mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
+  mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
-        }
+  // If actual intersection, add point and cell to edge, line,
+  // and surface maps!
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
+
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
+
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
       }
     }
   }
 
-  return 1;
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    if (this->LineSet.count(std::make_pair(std::min(ptId0, ptId1), std::max(ptId0, ptId1))))
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+    this->LineSet.insert(std::make_pair(std::min(ptId0, ptId1), std::max(ptId0, ptId1)));
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -527,10 +752,85 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
     newPolys->AllocateEstimate(cells->GetNumberOfCells(), 3);
     output->SetPolys(newPolys);
 
-    vtkSmartPointer<vtkIdList> edgeNeighbors = vtkSmartPointer<vtkIdList>::New();
+    // Collect the cells relevant for splitting each cell. If the cell is in
+    // the intersection map, split. If not, one of its edges may be split by
+    // an intersection line that splits a neighbor cell. Mark the cell as
+    // needing a split if this is the case.
+    vtkIdType numPolys = cells->GetNumberOfCells();
+    std::vector<unsigned char> needsSplit(numPolys, 0);
+    vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+    vtkSMPThreadLocalObject<vtkIdList> localEdgeNeighbors;
+    vtkSMPTools::For(0, numPolys, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPts = localCellPts.Local();
+      vtkIdList* edgeNeighbors = localEdgeNeighbors.Local();
+      for (vtkIdType cellId = begin; cellId < end; cellId++)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cells->GetCellAtId(cellId, npts, pts, cellPts);
+        if (npts != 3)
+        {
+          continue;
+        }
+        bool split = intersectionMap->find(cellId) != intersectionMap->end();
+        for (vtkIdType ptId = 0; ptId < npts && !split; ptId++)
+        {
+          edgeNeighbors->Reset();
+          input->GetCellEdgeNeighbors(cellId, pts[ptId], pts[(ptId + 1) % npts], edgeNeighbors);
+          for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds() && !split; nbr++)
+          {
+            split = intersectionMap->find(edgeNeighbors->GetId(nbr)) != intersectionMap->end();
+          }
+        }
+        needsSplit[cellId] = split;
+      }
+    });
+
+    // Split the cells in parallel. Their new cells, and their writes to the
+    // boundary points and to the new cell ids, are added in the order of the
+    // cells below.
+    std::vector<vtkIdType> splitCellIds;
+    for (vtkIdType cellId = 0; cellId < numPolys; cellId++)
+    {
+      if (needsSplit[cellId])
+      {
+        splitCellIds.push_back(cellId);
+      }
+    }
+    double bounds[6];
+    input->GetBounds(bounds);
+    BuildLinksSerially(splitLines);
+    vtkIdType numSplitCells = static_cast<vtkIdType>(splitCellIds.size());
+    std::vector<SplitCellType> splits(numSplitCells);
+    vtkSMPTools::For(0, numSplitCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPts = localCellPts.Local();
+      bool isFirst = IsAbortCheckingThread();
+      for (vtkIdType splitId = begin; splitId < end; splitId++)
+      {
+        if (isFirst)
+        {
+          this->ParentFilter->CheckAbort();
+        }
+        if (this->ParentFilter->GetAbortOutput())
+        {
+          break;
+        }
+        vtkIdType cellId = splitCellIds[splitId];
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cells->GetCellAtId(cellId, npts, pts, cellPts);
+        splits[splitId].Cells.TakeReference(this->SplitCell(
+          input, bounds, cellId, pts, intersectionMap, splitLines, inputIndex, splits[splitId]));
+      }
+    });
+    if (this->ParentFilter->GetAbortOutput())
+    {
+      return 1;
+    }
+
     vtkIdType nptsX = 0;
     const vtkIdType* pts = nullptr;
-    vtkSmartPointer<vtkIdList> cellsToCheck = vtkSmartPointer<vtkIdList>::New();
+    std::vector<SplitCellType>::iterator split = splits.begin();
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
     {
       if (nptsX != 3)
@@ -540,36 +840,8 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
         continue;
       }
 
-      cellsToCheck->Reset();
-      cellsToCheck->Allocate(nptsX + 1);
-      cellsToCheck->InsertNextId(cellIdX);
-
-      // Collect the cells relevant for splitting this cell.  If the
-      // cell is in the intersection map, split. If not, one of its
-      // edges may be split by an intersection line that splits a
-      // neighbor cell. Mark the cell as needing a split if this is
-      // the case.
-      bool needsSplit = intersectionMap->find(cellIdX) != intersectionMap->end();
-      for (vtkIdType ptId = 0; ptId < nptsX; ptId++)
-      {
-        vtkIdType pt0Id = pts[ptId];
-        vtkIdType pt1Id = pts[(ptId + 1) % nptsX];
-        edgeNeighbors->Reset();
-        input->GetCellEdgeNeighbors(cellIdX, pt0Id, pt1Id, edgeNeighbors);
-        for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
-        {
-          vtkIdType nbrId = edgeNeighbors->GetId(nbr);
-          cellsToCheck->InsertNextId(nbrId);
-
-          if (intersectionMap->find(nbrId) != intersectionMap->end())
-          {
-            needsSplit = true;
-          }
-        } // for (vtkIdType nbr = 0; ...
-      }   // for (vtkIdType pt = 0; ...
-
       // Splitting occurs here
-      if (!needsSplit)
+      if (!needsSplit[cellIdX])
       {
         // Just insert the cell and copy the cell data
         newId = newPolys->InsertNextCell(3, pts);
@@ -577,17 +849,27 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
       }
       else
       {
-        // Total number of cells so that we know the id numbers of the new
-        // cells added and we can add it to the new cell id mapping
-        int numCurrCells = newPolys->GetNumberOfCells();
-        vtkCellArray* splitCells = this->SplitCell(
-          input, cellIdX, pts, intersectionMap, splitLines, inputIndex, numCurrCells);
+        for (const auto& boundaryPoint : split->BoundaryPoints)
+        {
+          this->BoundaryPoints[inputIndex]->InsertValue(boundaryPoint.first, boundaryPoint.second);
+        }
+        vtkCellArray* splitCells = split->Cells;
         if (splitCells == nullptr)
         {
           vtkDebugWithObjectMacro(this->ParentFilter, << "Error in splitting cell!");
           return 0;
         }
 
+        // Total number of cells so that we know the id numbers of the new
+        // cells added and we can add it to the new cell id mapping
+        int numCurrCells = newPolys->GetNumberOfCells();
+        for (auto& newCell : split->NewCells)
+        {
+          this->AddToNewCellMap(inputIndex, newCell.InterPtCount, newCell.InterPts, splitLines,
+            numCurrCells + newCell.CellIndex);
+        }
+        ++split;
+
         double pt0[3], pt1[3], pt2[3], normal[3];
         points->GetPoint(pts[0], pt0);
         points->GetPoint(pts[1], pt1);
@@ -624,7 +906,6 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
           outCD->CopyData(inCD, cellIdX, newId); // Duplicate cell data
         }
-        splitCells->Delete();
       }
     } // for (cells->InitTraversal(); ...
   }   // if inputGetPolys()->GetNumberOfCells() > 1 ...
@@ -632,9 +913,9 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
   return 1;
 }
 
-vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input, vtkIdType cellId,
-  const vtkIdType* cellPts, IntersectionMapType* map, vtkPolyData* interLines, int inputIndex,
-  int numCurrCells)
+vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input,
+  const double bounds[6], vtkIdType cellId, const vtkIdType* cellPts, IntersectionMapType* map,
+  vtkPolyData* interLines, int inputIndex, SplitCellType& split)
 {
   // Copy down the SurfaceID array that tells which surface the point belongs
   // to
@@ -651,7 +932,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
   vtkSmartPointer<vtkPointLocator> merger = vtkSmartPointer<vtkPointLocator>::New();
   merger->SetTolerance(this->Tolerance);
-  merger->InitPointInsertion(points, input->GetBounds());
+  merger->InitPointInsertion(points, bounds);
 
   double xyz[3];
   for (int i = 0; i < 3; i++)
@@ -680,6 +961,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   // point IDs from the cell are not stored here.
   std::map<vtkIdType, vtkIdType> ptIdMap;
 
+  vtkNew<vtkIdList> linePtIdList;
   IntersectionMapIteratorType iterLower = map->lower_bound(cellId);
   IntersectionMapIteratorType iterUpper = map->upper_bound(cellId);
   // Get all the lines associated with the original cell
@@ -688,7 +970,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     vtkIdType lineId = iterLower->second;
     vtkIdType nLinePts;
     const vtkIdType* linePtIds;
-    interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds);
+    interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds, linePtIdList);
 
     interceptlines->InsertNextCell(2);
     lines->InsertNextCell(2);
@@ -784,7 +1066,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         vtkIdType lineId = iterLower->second;
         vtkIdType nLinePts;
         const vtkIdType* linePtIds;
-        interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds);
+        interLines->GetLines()->GetCellAtId(lineId, nLinePts, linePtIds, linePtIdList);
         for (vtkIdType k = 0; k < nLinePts; k++)
         {
           if (linePtIds[k] >= interLines->GetNumberOfPoints())
@@ -917,15 +1199,15 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     // Setting the boundary points
     if (ptId > 2)
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(reverseIdMap[ptId], 1);
+      split.BoundaryPoints.emplace_back(reverseIdMap[ptId], 1);
     }
     else if (CellPointOnInterLine[ptId])
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 1);
+      split.BoundaryPoints.emplace_back(cellPts[ptId], 1);
     }
     else
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 0);
+      split.BoundaryPoints.emplace_back(cellPts[ptId], 0);
     }
   }
   // Sort the edgePtIdList according to the angle list. The starting
@@ -936,7 +1218,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   vtkSmartPointer<vtkPolyData> checkPD = vtkSmartPointer<vtkPolyData>::New();
   checkPD->SetPoints(points);
   checkPD->SetLines(lines);
-  checkPD->BuildLinks();
+  BuildLinksSerially(checkPD);
   vtkIdType id;
   // Check to see if the lines are unique
   for (id = 0; id < edgePtIdList->GetNumberOfTuples() - 1; id++)
@@ -962,18 +1244,20 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   // Set up a transform that will rotate the points to the
   // XY-plane (normal aligned with z-axis).
   vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
-  this->TransformSign = this->GetTransform(transform, points);
+  this->TransformSign.Local() = this->GetTransform(transform, points);
 
   vtkCellArray* splitCells = vtkCellArray::New();
+  // Index of the next new cell, to record the new cells along the lines
+  int numCurrCells = 0;
   vtkSmartPointer<vtkPolyData> interpd = vtkSmartPointer<vtkPolyData>::New();
   interpd->SetPoints(points);
   interpd->SetLines(interceptlines);
-  interpd->BuildLinks();
+  BuildLinksSerially(interpd);
 
   vtkSmartPointer<vtkPolyData> fullpd = vtkSmartPointer<vtkPolyData>::New();
   fullpd->SetPoints(points);
   fullpd->SetLines(lines);
-  SplittingPD->DeepCopy(fullpd);
+  this->SplittingPD.Local()->DeepCopy(fullpd);
 
   vtkSmartPointer<vtkTransformPolyDataFilter> transformer =
     vtkSmartPointer<vtkTransformPolyDataFilter>::New();
@@ -982,7 +1266,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   transformer->SetTransform(transform);
   transformer->Update();
   transformedpd = transformer->GetOutput();
-  transformedpd->BuildLinks();
+  BuildLinksSerially(transformedpd);
 
   // If the triangle has intersecting lines and new points
   if (interPtIdList->GetNumberOfTuples() > 0 && interceptlines->GetNumberOfCells() > 0)
@@ -1038,9 +1322,12 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       int success = boundaryPoly->BoundedTriangulate(idList, this->RelativeSubtriangleArea);
 
       vtkSmartPointer<vtkDelaunay2D> del2D = vtkSmartPointer<vtkDelaunay2D>::New();
-      del2D->SetContainerAlgorithm(this->ParentFilter);
       vtkSmartPointer<vtkTriangleFilter> triangulator = vtkSmartPointer<vtkTriangleFilter>::New();
-      triangulator->SetContainerAlgorithm(this->ParentFilter);
+      if (IsAbortCheckingThread())
+      {
+        del2D->SetContainerAlgorithm(this->ParentFilter);
+        triangulator->SetContainerAlgorithm(this->ParentFilter);
+      }
 
       vtkSmartPointer<vtkCellArray> triangulatedPolyCells = vtkSmartPointer<vtkCellArray>::New();
       if (success)
@@ -1110,7 +1397,6 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       // Renumber the point IDs.
       vtkIdType npts;
       const vtkIdType* ptIds;
-      interLines->BuildLinks();
       for (polys->InitTraversal(); polys->GetNextCell(npts, ptIds);)
       {
         if (pointMapper[ptIds[0]] >= points->GetNumberOfPoints() ||
@@ -1145,7 +1431,9 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         if (interPtCount >= 2) // If there are more than two, inter line
         {
           // Add the information to new cell mapping on intersection lines
-          this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+          NewCellType newCell = { numCurrCells, interPtCount, { interPts[0], interPts[1],
+            interPts[2] } };
+          split.NewCells.push_back(newCell);
         }
         numCurrCells++;
       }
@@ -1203,7 +1491,9 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       }
       if (interPtCount >= 2)
       {
-        this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+        NewCellType newCell = { numCurrCells, interPtCount, { interPts[0], interPts[1],
+          interPts[2] } };
+        split.NewCells.push_back(newCell);
       }
       numCurrCells++;
     }
@@ -1459,7 +1749,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
       currentpd->SetLines(currentcells);
       currentpd->SetPoints(pd->GetPoints());
       pd->DeepCopy(currentpd);
-      pd->BuildLinks();
+      BuildLinksSerially(pd);
     }
     // Normal number of lines, simply follow around triangle loop
     else
@@ -1696,12 +1986,13 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
     vtkDebugWithObjectMacro(this->ParentFilter, << "Very Small Area Triangle");
     vtkDebugWithObjectMacro(
       this->ParentFilter, << "Double check area with more accurate transform");
+    vtkPolyData* splittingPD = this->SplittingPD.Local();
     vtkSmartPointer<vtkPoints> testPoints = vtkSmartPointer<vtkPoints>::New();
     vtkSmartPointer<vtkPolyData> testPD = vtkSmartPointer<vtkPolyData>::New();
     vtkSmartPointer<vtkCellArray> testCells = vtkSmartPointer<vtkCellArray>::New();
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId1));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId2));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId3));
+    testPoints->InsertNextPoint(splittingPD->GetPoint(ptId1));
+    testPoints->InsertNextPoint(splittingPD->GetPoint(ptId2));
+    testPoints->InsertNextPoint(splittingPD->GetPoint(ptId3));
     for (int i = 0; i < 3; i++)
     {
       testCells->InsertNextCell(2);
@@ -1710,17 +2001,17 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
     }
     testPD->SetPoints(testPoints);
     testPD->SetLines(testCells);
-    testPD->BuildLinks();
+    BuildLinksSerially(testPD);
 
     vtkSmartPointer<vtkTransform> newTransform = vtkSmartPointer<vtkTransform>::New();
     int sign = this->GetTransform(newTransform, testPoints);
-    if (sign != this->TransformSign)
+    if (sign != this->TransformSign.Local())
     {
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId2));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(0, splittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(1, splittingPD->GetPoint(ptId1));
       this->GetTransform(newTransform, testPoints);
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId1));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(0, splittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(1, splittingPD->GetPoint(ptId2));
     }
 
     vtkSmartPointer<vtkTransformPolyDataFilter> newTransformer =
@@ -2137,7 +2428,7 @@ void vtkIntersectionPolyDataFilter::CleanAndCheckSurface(
   cleaner->SetAbsoluteTolerance(tolerance);
   cleaner->Update();
   pd->DeepCopy(cleaner->GetOutput());
-  pd->BuildLinks();
+  BuildLinksSerially(pd);
 
   // Loop through the surface and find edges with cells that have either more
   // than one neighbor or no neighbors. No neighbors can be okay,as this can
@@ -2370,8 +2661,8 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   }
 
   // This performs the triangle intersection search
-  obbTree0->IntersectWithOBBTree(
-    obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  impl->FindNodePairs(obbTree0, obbTree1);
+  impl->ComputeTriangleIntersections();
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
@@ -2389,7 +2680,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // or points. To account for this, this simple clean retains what we need.
   vtkSmartPointer<vtkPolyData> tmpLines = vtkSmartPointer<vtkPolyData>::New();
   tmpLines->DeepCopy(outputIntersection);
-  tmpLines->BuildLinks();
+  BuildLinksSerially(tmpLines);
 
   vtkSmartPointer<vtkCleanPolyData> lineCleaner = vtkSmartPointer<vtkCleanPolyData>::New();
   lineCleaner->SetInputData(outputIntersection);
@@ -2442,7 +2733,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // Split the first output if so desired, needed if performing boolean op
   if (this->SplitFirstOutput)
   {
-    mesh0->BuildLinks();
+    BuildLinksSerially(mesh0);
     if (impl->SplitMesh(0, outputPolyData0, outputIntersection) != 1)
     {
       this->Status = 0;
@@ -2472,7 +2763,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
       CleanAndCheckSurface(outputPolyData0, dummy, this->Tolerance);
     }
 
-    outputPolyData0->BuildLinks();
+    BuildLinksSerially(outputPolyData0);
   }
   else
   {
@@ -2488,7 +2779,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // Split the second output if desired
   if (this->SplitSecondOutput)
   {
-    mesh1->BuildLinks();
+    BuildLinksSerially(mesh1);
     if (impl->SplitMesh(1, outputPolyData1, outputIntersection) != 1)
     {
       this->Status = 0;
@@ -2518,7 +2809,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
       CleanAndCheckSurface(outputPolyData1, dummy, this->Tolerance);
     }
 
-    outputPolyData1->BuildLinks();
+    BuildLinksSerially(outputPolyData1);
   }
   else
   {
@@ -42,6 +42,11 @@
  * indicating if the cell has any free edges. A watertight surface will have
  * 0 everywhere for this array!
  *
+ * The leaf node pairs of the two vtkOBBTree are first collected, then the
+ * triangles of each pair are intersected in parallel with vtkSMPTools. The
+ * intersections are added to the output in the order of the tree
+ * traversal, so the output does not depend on the number of threads.
+ *
  * @author Adam Updegrove updega2@gmail.com
  *
  * @warning This filter is not designed to perform 2D boolean operations,
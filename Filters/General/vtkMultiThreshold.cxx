@@ -4,27 +4,38 @@
 
 #include "vtkMultiThreshold.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkMultiThreshold);
 
 // Prevent lots of error messages on the inner loop of the filter by keeping track of how many we
-// have: (Note that this can fail in exquisitely confusing ways with multiple threads)
-static int vtkMultiThresholdLimitErrorCount = 0;
+// have. The cells are processed by several threads, so the count is only approximate.
+static std::atomic<int> vtkMultiThresholdLimitErrorCount(0);
 
 static const char* vtkMultiThresholdSetOperationNames[] = { "AND", "OR", "XOR", "WOR", "NAND" };
 
@@ -35,21 +46,22 @@ static const char* vtkMultiThresholdNormNames[] = {
   "LInfinityNorm",
 };
 
+// The norms read the components one by one, since they are evaluated
+// concurrently for different cells.
 static double vtkMultiThresholdSingleComponentNorm(
   vtkDataArray* arr, vtkIdType tuple, int component)
 {
-  return arr->GetTuple(tuple)[component];
+  return arr->GetComponent(tuple, component);
 }
 
 static double vtkMultiThresholdL1ComponentNorm(
   vtkDataArray* arr, vtkIdType tuple, int vtkNotUsed(component))
 {
-  double* x = arr->GetTuple(tuple);
   double norm = 0.;
   int nc = arr->GetNumberOfComponents();
   for (int i = 0; i < nc; ++i)
   {
-    norm += fabs(x[i]);
+    norm += fabs(arr->GetComponent(tuple, i));
   }
   return norm;
 }
@@ -57,12 +69,12 @@ static double vtkMultiThresholdL1ComponentNorm(
 static double vtkMultiThresholdL2ComponentNorm(
   vtkDataArray* arr, vtkIdType tuple, int vtkNotUsed(component))
 {
-  double* x = arr->GetTuple(tuple);
   double norm = 0.;
   int nc = arr->GetNumberOfComponents();
   for (int i = 0; i < nc; ++i)
   {
-    norm += x[i] * x[i];
+    double x = arr->GetComponent(tuple, i);
+    norm += x * x;
   }
   return sqrt(norm);
 }
@@ -70,13 +82,12 @@ static double vtkMultiThresholdL2ComponentNorm(
 static double vtkMultiThresholdLinfComponentNorm(
   vtkDataArray* arr, vtkIdType tuple, int vtkNotUsed(component))
 {
-  double* x = arr->GetTuple(tuple);
   double norm = 0.;
   double xabs;
   int nc = arr->GetNumberOfComponents();
   for (int i = 0; i < nc; ++i)
   {
-    xabs = fabs(x[i]);
+    xabs = fabs(arr->GetComponent(tuple, i));
     if (xabs > norm)
       norm = xabs;
   }
@@ -419,6 +430,115 @@ int vtkMultiThreshold::AddIntervalSet(NormKey& nk, double xmin, double xmax, int
   return entry;
 }
 
+namespace
+{
+// Number of cells per batch of the parallel thresholding.
+constexpr vtkIdType MultiThresholdBatchSize = 1024;
+
+// The cells of a batch that belong to each output set, in order, and the size
+// of their connectivity.
+struct vtkMultiThresholdBatch
+{
+  std::vector<std::vector<vtkIdType>> OutputCells;
+  std::vector<vtkIdType> ConnectivitySizes;
+};
+
+// Copy the input cells selected for an output by the batches, in the order of
+// the batches, along with their cell data.
+void BuildOutputCells(vtkPointSet* input, const std::vector<vtkMultiThresholdBatch>& batches,
+  int outputId, vtkUnstructuredGrid* output)
+{
+  const vtkIdType numBatches = static_cast<vtkIdType>(batches.size());
+  std::vector<vtkIdType> cellOffsets(numBatches + 1, 0);
+  std::vector<vtkIdType> connOffsets(numBatches + 1, 0);
+  for (vtkIdType i = 0; i < numBatches; i++)
+  {
+    const vtkMultiThresholdBatch& batch = batches[i];
+    const bool empty = batch.OutputCells.empty();
+    cellOffsets[i + 1] = cellOffsets[i] +
+      (empty ? 0 : static_cast<vtkIdType>(batch.OutputCells[outputId].size()));
+    connOffsets[i + 1] = connOffsets[i] + (empty ? 0 : batch.ConnectivitySizes[outputId]);
+  }
+  const vtkIdType numCells = cellOffsets[numBatches];
+  const vtkIdType connSize = connOffsets[numBatches];
+
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid && grid->GetPolyhedronFaces())
+  {
+    // Polyhedra are inserted serially, with their faces.
+    output->AllocateEstimate(numCells, 1);
+    vtkNew<vtkIdList> ptIds;
+    for (const vtkMultiThresholdBatch& batch : batches)
+    {
+      if (!batch.OutputCells.empty())
+      {
+        for (vtkIdType cellId : batch.OutputCells[outputId])
+        {
+          grid->GetFaceStream(cellId, ptIds);
+          output->InsertNextCell(grid->GetCellType(cellId), ptIds);
+        }
+      }
+    }
+  }
+  else
+  {
+    vtkNew<vtkUnsignedCharArray> types;
+    types->SetNumberOfValues(numCells);
+    vtkNew<vtkIdTypeArray> offsets;
+    offsets->SetNumberOfValues(numCells + 1);
+    vtkNew<vtkIdTypeArray> connectivity;
+    connectivity->SetNumberOfValues(connSize);
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+      vtkGenericCell* cell = tlCell.Local();
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        if (batches[i].OutputCells.empty())
+        {
+          continue;
+        }
+        vtkIdType outCellId = cellOffsets[i];
+        vtkIdType connId = connOffsets[i];
+        for (vtkIdType cellId : batches[i].OutputCells[outputId])
+        {
+          input->GetCell(cellId, cell);
+          types->SetValue(outCellId, static_cast<unsigned char>(cell->GetCellType()));
+          offsets->SetValue(outCellId++, connId);
+          vtkIdList* ptIds = cell->GetPointIds();
+          for (vtkIdType j = 0; j < ptIds->GetNumberOfIds(); j++)
+          {
+            connectivity->SetValue(connId++, ptIds->GetId(j));
+          }
+        }
+      }
+    });
+    offsets->SetValue(numCells, connSize);
+    vtkNew<vtkCellArray> cells;
+    cells->SetData(offsets, connectivity);
+    output->SetCells(types, cells);
+  }
+
+  vtkCellData* outCd = output->GetCellData();
+  ArrayList arrays;
+  outCd->CopyAllocate(input->GetCellData(), numCells);
+  arrays.AddArrays(numCells, input->GetCellData(), outCd, 0.0, false);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      if (batches[i].OutputCells.empty())
+      {
+        continue;
+      }
+      vtkIdType outCellId = cellOffsets[i];
+      for (vtkIdType cellId : batches[i].OutputCells[outputId])
+      {
+        arrays.Copy(cellId, outCellId++);
+      }
+    }
+  });
+}
+}
+
 // User adds intervals
 //   - as intervals are added, a unique list of the (assoc/array/comp) to which they refer is
 //   updated
@@ -467,7 +587,6 @@ int vtkMultiThreshold::RequestData(
     ds->SetPoints(in->GetPoints());
     ds->GetPointData()->PassData(in->GetPointData());
     ds->GetCellData()->CopyGlobalIdsOn();
-    ds->GetCellData()->CopyAllocate(in->GetCellData());
 
     block->SetBlock(updatePiece, ds);
     ds->FastDelete();
@@ -478,16 +597,11 @@ int vtkMultiThreshold::RequestData(
   // II. Prepare to loop over all the cells.
   //     A. Create a vector that we'll copy into setStates each time we start processing a new cell.
   //        Creating this summary ahead of time saves a lot of work in the big loop.
-  vtkIdType inCell;
-  vtkCellData* inCellData = in->GetCellData();
-
-  std::set<int> unresolvedOutputs;
   // setStates is a vector of the same length as this->Sets.
   // Entries are INCONCLUSIVE, INCLUDE, or EXCLUDE for each interval set, and
   // some number between 0 and the number of entries in DependentSets[i] for each boolean set.
   // Since we have to reset setStates for each cell in the input mesh, we precompute its initial
   // state as setStatesInit.
-  TruthTreeValues setStates;
   TruthTreeValues setStatesInit;
   for (i = 0; i < (int)this->Sets.size(); ++i)
   {
@@ -517,10 +631,18 @@ int vtkMultiThreshold::RequestData(
     NormArrays.push_back(arr);
   }
 
-  // II. C. Keep a generic cell handy for when we need to copy the input to the output
-  vtkGenericCell* cell = vtkGenericCell::New();
+  // II. C. Keep a generic cell handy in each thread. The first call to GetCell() is not thread
+  //        safe.
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocal<TruthTreeValues> tlSetStates;
+  vtkSMPThreadLocal<std::set<int>> tlUnresolvedOutputs;
+  const vtkIdType numCells = in->GetNumberOfCells();
+  if (numCells > 0)
+  {
+    in->GetCell(0, tlCell.Local());
+  }
 
-  // III. Loop over each cell, copying it to output meshes as required. The strategy here is:
+  // III. Loop over each cell, finding the output meshes it belongs to. The strategy here is:
   //      For each cell C_i in the mesh,
   //         setStates <- setStatesInit
   //         unresolvedOutputs <- unresolvedOutputsInit
@@ -533,80 +655,92 @@ int vtkMultiThreshold::RequestData(
   //                  decision <- false
   //               If I_k is an output
   //                  If decision is true
-  //                     Copy C_i to output associated with I_k
+  //                     Add C_i to the cells of the output associated with I_k
   //                  Remove output associated with I_k from unresolvedOutputs
   //               Update sets whose values are dependent on the decision for I_k (recursively)
   //       All loops except the outermost will terminate early if unresolvedOutputs is empty.
-
-  // For each cell in the mesh:
-  for (inCell = 0; inCell < in->GetNumberOfCells(); ++inCell)
-  {
-    if (this->CheckAbort())
+  //      The cells are processed in parallel by batches, which collect the cells of each output
+  //      in order.
+  const vtkIdType numBatches = (numCells + MultiThresholdBatchSize - 1) / MultiThresholdBatchSize;
+  std::vector<vtkMultiThresholdBatch> batches(numBatches);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    vtkGenericCell* cell = tlCell.Local();
+    TruthTreeValues& setStates = tlSetStates.Local();
+    std::set<int>& unresolvedOutputs = tlUnresolvedOutputs.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      break;
-    }
-    in->GetCell(inCell, cell);
-    unresolvedOutputs.clear();
-    for (i = 0; i < this->NumberOfOutputs; ++i)
-    {
-      unresolvedOutputs.insert(i);
-    }
-    setStates = setStatesInit;
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      vtkMultiThresholdBatch& batch = batches[batchId];
+      batch.OutputCells.resize(this->NumberOfOutputs);
+      batch.ConnectivitySizes.assign(this->NumberOfOutputs, 0);
+      const vtkIdType endCell = std::min((batchId + 1) * MultiThresholdBatchSize, numCells);
+      for (vtkIdType inCell = batchId * MultiThresholdBatchSize; inCell < endCell; ++inCell)
+      {
+        in->GetCell(inCell, cell);
+        unresolvedOutputs.clear();
+        for (int o = 0; o < this->NumberOfOutputs; ++o)
+        {
+          unresolvedOutputs.insert(o);
+        }
+        setStates = setStatesInit;
 
-    // For each norm of an attribute defined over the mesh:
-    int normIdx = 0;
-    for (aacn = this->IntervalRules.begin();
-         !unresolvedOutputs.empty() && (aacn != this->IntervalRules.end()); ++aacn, ++normIdx)
-    {
-      double cellNorm[2]; // min,max used if aacn is a point array. otherwise, just min is used.
-      Interval* ival;
-      int iival;
-      aacn->first.ComputeNorm(inCell, cell, NormArrays[normIdx], cellNorm);
+        // For each norm of an attribute defined over the mesh:
+        int normIdx = 0;
+        for (auto rule = this->IntervalRules.begin();
+             !unresolvedOutputs.empty() && (rule != this->IntervalRules.end()); ++rule, ++normIdx)
+        {
+          double cellNorm[2]; // min,max used if rule is a point array. otherwise, just min is used.
+          rule->first.ComputeNorm(inCell, cell, NormArrays[normIdx], cellNorm);
 
-      // For each interval test associated with the current norm:
-      for (iival = 0; !unresolvedOutputs.empty() && (iival < (int)aacn->second.size()); ++iival)
-      {
-        ival = aacn->second[iival];
-        // See if the intervals overlap properly
-        int match = ival->Match(cellNorm);
-#if 0
-        fprintf( stderr, "Cell %5llu [%10.4f,%10.4f] in [%10.4f,%10.4f]: %d\n",
-          inCell, cellNorm[0], cellNorm[1], ival->EndpointValues[0], ival->EndpointValues[1], match );
-#endif // 0
-        setStates[ival->Id] = match ? INCLUDE : EXCLUDE;
-        if (ival->OutputId >= 0)
+          // For each interval test associated with the current norm:
+          for (int iival = 0;
+               !unresolvedOutputs.empty() && (iival < (int)rule->second.size()); ++iival)
+          {
+            Interval* ival = rule->second[iival];
+            // See if the intervals overlap properly
+            int match = ival->Match(cellNorm);
+            setStates[ival->Id] = match ? INCLUDE : EXCLUDE;
+            if (ival->OutputId >= 0)
+            {
+              if (match)
+              {
+                // Note that we could eliminate points not referenced in the output meshes as we
+                // go, but that's an optimization for later.
+                batch.OutputCells[ival->OutputId].push_back(inCell);
+              }
+              unresolvedOutputs.erase(ival->OutputId);
+            }
+            this->UpdateDependents(
+              ival->Id, unresolvedOutputs, setStates, inCell, batch.OutputCells);
+          } // ival
+        }
+
+        // The output cells are copied from the cells, whose sizes give the connectivity.
+        for (int o = 0; o < this->NumberOfOutputs; ++o)
         {
-          if (match)
+          if (!batch.OutputCells[o].empty() && batch.OutputCells[o].back() == inCell)
           {
-            // Note that we could eliminate points not referenced in the output meshes as we go,
-            // but that's an optimization for later. Don't forget to modify UpdateDependents as well
-            // if you do this.
-
-            // copy cell to output
-            vtkIdType outCell =
-              outv[ival->OutputId]->InsertNextCell(cell->GetCellType(), cell->GetPointIds());
-            // copy cell data to output
-            outv[ival->OutputId]->GetCellData()->CopyData(inCellData, inCell, outCell);
+            batch.ConnectivitySizes[o] += cell->GetNumberOfPoints();
           }
-          unresolvedOutputs.erase(ival->OutputId);
         }
-        this->UpdateDependents(
-          ival->Id, unresolvedOutputs, setStates, inCellData, inCell, cell, outv);
-      } // ival
+      }
     }
+  });
 
-#if 0
-    fprintf( stderr, "Cell %5lld [", inCell );
-    for ( i = 0; i < (int)this->Sets.size(); ++i )
-    {
-      fprintf( stderr, "%d", setStates[i] == INCLUDE ? 1 : 0 );
-    }
-    fprintf( stderr, "]\n" );
-#endif // 0
+  // IV. Copy the cells of each output.
+  for (i = 0; i < this->NumberOfOutputs && !this->CheckAbort(); ++i)
+  {
+    ::BuildOutputCells(in, batches, i, outv[i]);
   }
 
-  cell->Delete();
-
   return 1;
 }
 
@@ -617,8 +751,7 @@ int vtkMultiThreshold::FillInputPortInformation(int vtkNotUsed(port), vtkInforma
 }
 
 void vtkMultiThreshold::UpdateDependents(int id, std::set<int>& unresolvedOutputs,
-  TruthTreeValues& setStates, vtkCellData* inCellData, vtkIdType inCell, vtkGenericCell* cell,
-  std::vector<vtkUnstructuredGrid*>& outv)
+  TruthTreeValues& setStates, vtkIdType inCell, std::vector<std::vector<vtkIdType>>& outputCells)
 {
   int lastMatch = setStates[id];
   // See if we can take care of boolean sets now.
@@ -740,22 +873,37 @@ void vtkMultiThreshold::UpdateDependents(int id, std::set<int>& unresolvedOutput
       {
         if (decision == INCLUDE)
         {
-          // copy cell to output
-          vtkIdType outCell =
-            outv[bset->OutputId]->InsertNextCell(cell->GetCellType(), cell->GetPointIds());
-          // copy cell data to output
-          outv[bset->OutputId]->GetCellData()->CopyData(inCellData, inCell, outCell);
+          outputCells[bset->OutputId].push_back(inCell);
         }
         unresolvedOutputs.erase(bset->OutputId);
       }
       if (!unresolvedOutputs.empty())
       { // ignore parts of the graph that will not influence output
-        this->UpdateDependents(*dit, unresolvedOutputs, setStates, inCellData, inCell, cell, outv);
+        this->UpdateDependents(*dit, unresolvedOutputs, setStates, inCell, outputCells);
       }
     }
   }
 }
 
+void vtkMultiThreshold::UpdateDependents(int id, std::set<int>& unresolvedOutputs,
+  TruthTreeValues& setStates, vtkCellData* inCellData, vtkIdType inCell, vtkGenericCell* cell,
+  std::vector<vtkUnstructuredGrid*>& outv)
+{
+  std::vector<std::vector<vtkIdType>> outputCells(outv.size());
+  this->UpdateDependents(id, unresolvedOutputs, setStates, inCell, outputCells);
+  for (size_t outputId = 0; outputId < outv.size(); ++outputId)
+  {
+    if (!outputCells[outputId].empty())
+    {
+      // copy cell to output
+      vtkIdType outCell =
+        outv[outputId]->InsertNextCell(cell->GetCellType(), cell->GetPointIds());
+      // copy cell data to output
+      outv[outputId]->GetCellData()->CopyData(inCellData, inCell, outCell);
+    }
+  }
+}
+
 void vtkMultiThreshold::PrintGraph(ostream& os)
 {
   os << "digraph MultiThreshold {" << endl;
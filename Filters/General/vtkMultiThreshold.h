@@ -83,11 +83,15 @@
  * \enddot
  *
  * The filled rectangles represent sets that are output.
+ *
+ * The cells of the input are classified in parallel with vtkSMPTools. The cells of each output
+ * mesh are in the order of the input cells, whatever the number of threads.
  */
 
 #ifndef vtkMultiThreshold_h
 #define vtkMultiThreshold_h
 
+#include "vtkDeprecation.h"          // For VTK_DEPRECATED_IN_9_4_0
 #include "vtkFiltersGeneralModule.h" // For export macro
 #include "vtkMath.h"                 // for Inf() and NegInf()
 #include "vtkMultiBlockDataSetAlgorithm.h"
@@ -440,12 +444,19 @@ protected:
    */
   TruthTree DependentSets;
 
+  ///@{
   /**
    * Recursively update the setStates and unresolvedOutputs vectors based on this->DependentSets.
+   * The cell is appended to the list of cells of each output set it belongs to. This method
+   * may be called concurrently for different cells.
    */
+  void UpdateDependents(int id, std::set<int>& unresolvedOutputs, TruthTreeValues& setStates,
+    vtkIdType inCell, std::vector<std::vector<vtkIdType>>& outputCells);
+  VTK_DEPRECATED_IN_9_4_0("Use the version collecting the cells of each output set instead.")
   void UpdateDependents(int id, std::set<int>& unresolvedOutputs, TruthTreeValues& setStates,
     vtkCellData* inCellData, vtkIdType inCell, vtkGenericCell* cell,
     std::vector<vtkUnstructuredGrid*>& outv);
+  ///@}
 
   /**
    * A utility method called by the public AddInterval members.
@@ -152,6 +152,11 @@ public:
    */
   int DisjointOBBNodes(vtkOBBNode* nodeA, vtkOBBNode* nodeB, vtkMatrix4x4* XformBtoA);
 
+  /**
+   * Returns the root node of the tree, or nullptr if the tree is not built.
+   */
+  vtkOBBNode* GetRoot() { return this->Tree; }
+
   /**
    * Returns true if line intersects node.
    */
@@ -63,6 +63,8 @@ protected:
   vtkQuantizePolyDataPoints();
   ~vtkQuantizePolyDataPoints() override = default;
 
+  bool OperatesOnPoints() override { return true; }
+
   double QFactor;
 
 private:
@@ -3,9 +3,12 @@
 // SPDX-License-Identifier: LicenseRef-BSD-3-Clause-Sandia-NVIDIA-USGov
 #include "vtkObjectFactory.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellType.h"
+#include "vtkCellTypes.h"
 #include "vtkCommand.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
@@ -14,27 +17,255 @@
 #include "vtkEdgeSubdivisionCriterion.h"
 #include "vtkFieldData.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
-#include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingTessellator.h"
 #include "vtkTessellatorFilter.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkTessellatorFilter);
 
 namespace
 {
-void vtkCopyTuples(vtkDataSetAttributes* inDSA, vtkIdType inId, vtkDataSetAttributes* outDSA,
-  vtkIdType beginId, vtkIdType endId)
+// Number of input cells tessellated together. The simplices of each batch
+// are gathered in order, so the output does not depend on the number of
+// threads.
+const vtkIdType TessellationBatchSize = 128;
+
+// The simplices produced by a batch of input cells. Each simplex has its own
+// points, which are merged afterwards if requested.
+struct vtkTessellatorBatch
 {
-  for (vtkIdType cc = beginId; cc < endId; ++cc)
+  vtkIdType CellId = -1; // input cell being tessellated
+  int FieldSize = 0;     // number of field values of each point
+  std::vector<double> Points;
+  std::vector<double> Fields;
+  std::vector<unsigned char> Types;
+  std::vector<vtkIdType> CellIds; // input cell of each simplex
+  // Warnings are reported once the batches are processed.
+  bool HasUnparameterizedCells = false;
+  int UnsupportedCellType = -1;
+
+  void AddCell(unsigned char type)
+  {
+    this->Types.push_back(type);
+    this->CellIds.push_back(this->CellId);
+  }
+
+  void AddPoint(const double* x)
   {
-    outDSA->CopyData(inDSA, inId, cc);
+    this->Points.insert(this->Points.end(), x, x + 3);
+    // Skip the geometric and parametric coordinates to get to the field values.
+    this->Fields.insert(this->Fields.end(), x + 6, x + 6 + this->FieldSize);
   }
+};
+
+// ========================================
+// callbacks for simplex output
+void AddATetrahedron(const double* a, const double* b, const double* c, const double* d,
+  vtkEdgeSubdivisionCriterion*, void* pd, const void*)
+{
+  vtkTessellatorBatch* batch = static_cast<vtkTessellatorBatch*>(pd);
+  batch->AddCell(VTK_TETRA);
+  batch->AddPoint(a);
+  batch->AddPoint(b);
+  batch->AddPoint(c);
+  batch->AddPoint(d);
+}
+
+void AddATriangle(const double* a, const double* b, const double* c,
+  vtkEdgeSubdivisionCriterion*, void* pd, const void*)
+{
+  vtkTessellatorBatch* batch = static_cast<vtkTessellatorBatch*>(pd);
+  batch->AddCell(VTK_TRIANGLE);
+  batch->AddPoint(a);
+  batch->AddPoint(b);
+  batch->AddPoint(c);
+}
+
+void AddALine(
+  const double* a, const double* b, vtkEdgeSubdivisionCriterion*, void* pd, const void*)
+{
+  vtkTessellatorBatch* batch = static_cast<vtkTessellatorBatch*>(pd);
+  batch->AddCell(VTK_LINE);
+  batch->AddPoint(a);
+  batch->AddPoint(b);
+}
+
+void AddAPoint(const double* a, vtkEdgeSubdivisionCriterion*, void* pd, const void*)
+{
+  vtkTessellatorBatch* batch = static_cast<vtkTessellatorBatch*>(pd);
+  batch->AddCell(VTK_VERTEX);
+  batch->AddPoint(a);
+}
+
+void SetCallbacks(vtkStreamingTessellator* tessellator)
+{
+  tessellator->SetVertexCallback(AddAPoint);
+  tessellator->SetEdgeCallback(AddALine);
+  tessellator->SetTriangleCallback(AddATriangle);
+  tessellator->SetTetrahedronCallback(AddATetrahedron);
+}
+
+// Concatenate the simplices of the batches into the output mesh, with the
+// field values of their points in attributes, and copy the cell data of the
+// input cells they come from.
+void BuildOutput(std::vector<vtkTessellatorBatch>& batches,
+  vtkDataSetEdgeSubdivisionCriterion* subdivider, vtkDataArray** attributes, vtkCellData* inCD,
+  vtkUnstructuredGrid* output)
+{
+  const vtkIdType numBatches = static_cast<vtkIdType>(batches.size());
+  std::vector<vtkIdType> cellOffsets(numBatches + 1, 0);
+  std::vector<vtkIdType> pointOffsets(numBatches + 1, 0);
+  for (vtkIdType i = 0; i < numBatches; ++i)
+  {
+    cellOffsets[i + 1] = cellOffsets[i] + static_cast<vtkIdType>(batches[i].Types.size());
+    pointOffsets[i + 1] = pointOffsets[i] + static_cast<vtkIdType>(batches[i].Points.size() / 3);
+  }
+  const vtkIdType numCells = cellOffsets[numBatches];
+  const vtkIdType numPts = pointOffsets[numBatches];
+
+  vtkPoints* points = output->GetPoints();
+  points->SetNumberOfPoints(numPts);
+  const int numFields = subdivider->GetNumberOfFields();
+  const int* fieldOffsets = subdivider->GetFieldOffsets();
+  for (int at = 0; at < numFields; ++at)
+  {
+    attributes[at]->SetNumberOfTuples(numPts);
+  }
+
+  // Each simplex has its own points, so the connectivity is sequential.
+  vtkNew<vtkUnsignedCharArray> types;
+  types->SetNumberOfValues(numCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numPts);
+
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numCells);
+  ArrayList arrays;
+  arrays.AddArrays(numCells, inCD, outCD, 0.0, false);
+
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkTessellatorBatch& batch = batches[i];
+      const vtkIdType numBatchPts = pointOffsets[i + 1] - pointOffsets[i];
+      for (vtkIdType j = 0; j < numBatchPts; ++j)
+      {
+        const vtkIdType ptId = pointOffsets[i] + j;
+        points->SetPoint(ptId, batch.Points.data() + 3 * j);
+        const double* fields = batch.Fields.data() + j * batch.FieldSize;
+        for (int at = 0; at < numFields; ++at)
+        {
+          attributes[at]->SetTuple(ptId, fields + fieldOffsets[at]);
+        }
+        connectivity->SetValue(ptId, ptId);
+      }
+      vtkIdType cellId = cellOffsets[i];
+      vtkIdType offset = pointOffsets[i];
+      for (size_t j = 0; j < batch.Types.size(); ++j, ++cellId)
+      {
+        types->SetValue(cellId, batch.Types[j]);
+        offsets->SetValue(cellId, offset);
+        offset += vtkCellTypes::GetDimension(batch.Types[j]) + 1;
+        arrays.Copy(batch.CellIds[j], cellId);
+      }
+      // release the memory as soon as the batch is copied
+      batch = vtkTessellatorBatch();
+    }
+  });
+  offsets->SetValue(numCells, numPts);
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(types, cells);
+}
+
+// Merge the exactly coincident points of allPts in parallel into newPts.
+// Points are numbered as with an incremental locator inserting them in
+// order: each group of coincident points gets the rank of its lowest point
+// id. ptMap maps the points of allPts to the points of newPts, and firstPtIds
+// maps the points of newPts to their lowest point in allPts.
+void MergeCoincidentPoints(vtkPoints* allPts, vtkPoints* newPts, std::vector<vtkIdType>& ptMap,
+  std::vector<vtkIdType>& firstPtIds)
+{
+  const vtkIdType numPts = allPts->GetNumberOfPoints();
+  vtkNew<vtkPolyData> pointSet;
+  pointSet->SetPoints(allPts);
+
+  // Map each point to a representative of its group of coincident points.
+  std::vector<vtkIdType> mergeMap(numPts);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(pointSet);
+  locator->BuildLocator();
+  locator->MergePoints(0.0, mergeMap.data());
+
+  // Find the lowest point of each group.
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstIds(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      firstIds[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      std::atomic<vtkIdType>& firstId = firstIds[mergeMap[ptId]];
+      vtkIdType current = firstId.load(std::memory_order_relaxed);
+      while (ptId < current && !firstId.compare_exchange_weak(current, ptId))
+      {
+      }
+    }
+  });
+
+  // Number the groups in the order of their lowest point, then map the
+  // other points of the groups.
+  firstPtIds.clear();
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (firstIds[mergeMap[ptId]].load(std::memory_order_relaxed) == ptId)
+    {
+      ptMap[ptId] = static_cast<vtkIdType>(firstPtIds.size());
+      firstPtIds.push_back(ptId);
+    }
+  }
+  newPts->SetNumberOfPoints(static_cast<vtkIdType>(firstPtIds.size()));
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const vtkIdType firstId = firstIds[mergeMap[ptId]].load(std::memory_order_relaxed);
+      if (firstId == ptId)
+      {
+        allPts->GetPoint(ptId, x);
+        newPts->SetPoint(ptMap[ptId], x);
+      }
+      else
+      {
+        ptMap[ptId] = ptMap[firstId];
+      }
+    }
+  });
 }
 }
 
@@ -85,138 +316,6 @@ double vtkTessellatorFilter::GetChordError()
   return tmp > 0. ? sqrt(tmp) : tmp;
 }
 
-// ========================================
-// callbacks for simplex output
-void vtkTessellatorFilter::AddATetrahedron(const double* a, const double* b, const double* c,
-  const double* d, vtkEdgeSubdivisionCriterion*, void* pd, const void*)
-{
-  vtkTessellatorFilter* self = (vtkTessellatorFilter*)pd;
-  self->OutputTetrahedron(a, b, c, d);
-}
-
-void vtkTessellatorFilter::OutputTetrahedron(
-  const double* a, const double* b, const double* c, const double* d)
-{
-  vtkIdType cellIds[4];
-
-  cellIds[0] = this->OutputPoints->InsertNextPoint(a);
-  cellIds[1] = this->OutputPoints->InsertNextPoint(b);
-  cellIds[2] = this->OutputPoints->InsertNextPoint(c);
-  cellIds[3] = this->OutputPoints->InsertNextPoint(d);
-
-  this->OutputMesh->InsertNextCell(VTK_TETRA, 4, cellIds);
-
-  const int* off = this->Subdivider->GetFieldOffsets();
-  vtkDataArray** att = this->OutputAttributes;
-
-  // Move a, b, & c past the geometric and parametric coordinates to the
-  // beginning of the field values.
-  a += 6;
-  b += 6;
-  c += 6;
-  d += 6;
-
-  for (int at = 0; at < this->Subdivider->GetNumberOfFields(); ++at, ++att, ++off)
-  {
-    (*att)->InsertTuple(cellIds[0], a + *off);
-    (*att)->InsertTuple(cellIds[1], b + *off);
-    (*att)->InsertTuple(cellIds[2], c + *off);
-    (*att)->InsertTuple(cellIds[3], d + *off);
-  }
-}
-
-void vtkTessellatorFilter::AddATriangle(const double* a, const double* b, const double* c,
-  vtkEdgeSubdivisionCriterion*, void* pd, const void*)
-{
-  vtkTessellatorFilter* self = (vtkTessellatorFilter*)pd;
-  self->OutputTriangle(a, b, c);
-}
-
-void vtkTessellatorFilter::OutputTriangle(const double* a, const double* b, const double* c)
-{
-  vtkIdType cellIds[3];
-
-  cellIds[0] = this->OutputPoints->InsertNextPoint(a);
-  cellIds[1] = this->OutputPoints->InsertNextPoint(b);
-  cellIds[2] = this->OutputPoints->InsertNextPoint(c);
-
-  this->OutputMesh->InsertNextCell(VTK_TRIANGLE, 3, cellIds);
-
-  const int* off = this->Subdivider->GetFieldOffsets();
-  vtkDataArray** att = this->OutputAttributes;
-
-  // Move a, b, & c past the geometric and parametric coordinates to the
-  // beginning of the field values.
-  a += 6;
-  b += 6;
-  c += 6;
-
-  for (int at = 0; at < this->Subdivider->GetNumberOfFields(); ++at, ++att, ++off)
-  {
-    (*att)->InsertTuple(cellIds[0], a + *off);
-    (*att)->InsertTuple(cellIds[1], b + *off);
-    (*att)->InsertTuple(cellIds[2], c + *off);
-  }
-}
-
-void vtkTessellatorFilter::AddALine(
-  const double* a, const double* b, vtkEdgeSubdivisionCriterion*, void* pd, const void*)
-{
-  vtkTessellatorFilter* self = (vtkTessellatorFilter*)pd;
-  self->OutputLine(a, b);
-}
-
-void vtkTessellatorFilter::OutputLine(const double* a, const double* b)
-{
-  vtkIdType cellIds[2];
-
-  cellIds[0] = this->OutputPoints->InsertNextPoint(a);
-  cellIds[1] = this->OutputPoints->InsertNextPoint(b);
-
-  this->OutputMesh->InsertNextCell(VTK_LINE, 2, cellIds);
-
-  const int* off = this->Subdivider->GetFieldOffsets();
-  vtkDataArray** att = this->OutputAttributes;
-
-  // Move a, b, & c past the geometric and parametric coordinates to the
-  // beginning of the field values.
-  a += 6;
-  b += 6;
-
-  for (int at = 0; at < this->Subdivider->GetNumberOfFields(); ++at, ++att, ++off)
-  {
-    (*att)->InsertTuple(cellIds[0], a + *off);
-    (*att)->InsertTuple(cellIds[1], b + *off);
-  }
-}
-
-void vtkTessellatorFilter::AddAPoint(
-  const double* a, vtkEdgeSubdivisionCriterion*, void* pd, const void*)
-{
-  vtkTessellatorFilter* self = (vtkTessellatorFilter*)pd;
-  self->OutputPoint(a);
-}
-
-void vtkTessellatorFilter::OutputPoint(const double* a)
-{
-  vtkIdType cellId;
-
-  cellId = this->OutputPoints->InsertNextPoint(a);
-  this->OutputMesh->InsertNextCell(VTK_VERTEX, 1, &cellId);
-
-  const int* off = this->Subdivider->GetFieldOffsets();
-  vtkDataArray** att = this->OutputAttributes;
-
-  // Move a, b, & c past the geometric and parametric coordinates to the
-  // beginning of the field values.
-  a += 6;
-
-  for (int at = 0; at < this->Subdivider->GetNumberOfFields(); ++at, ++att, ++off)
-  {
-    (*att)->InsertTuple(cellId, a + *off);
-  }
-}
-
 // ========================================
 
 // constructor/boilerplate members
@@ -230,7 +329,6 @@ vtkTessellatorFilter::vtkTessellatorFilter()
   this->SetSubdivider(vtkDataSetEdgeSubdivisionCriterion::New());
   this->Subdivider->Delete();
   this->MergePoints = 1;
-  this->Locator = vtkMergePoints::New();
 
   this->Tessellator->SetEmbeddingDimension(1, 3);
   this->Tessellator->SetEmbeddingDimension(2, 3);
@@ -240,8 +338,6 @@ vtkTessellatorFilter::~vtkTessellatorFilter()
 {
   this->SetSubdivider(nullptr);
   this->SetTessellator(nullptr);
-  this->Locator->Delete();
-  this->Locator = nullptr;
 }
 
 void vtkTessellatorFilter::PrintSelf(ostream& os, vtkIndent indent)
@@ -252,8 +348,7 @@ void vtkTessellatorFilter::PrintSelf(ostream& os, vtkIndent indent)
      << indent << "Subdivider: " << this->Subdivider << " (" << this->Subdivider->GetClassName()
      << ")"
      << "\n"
-     << indent << "MergePoints: " << this->MergePoints << "\n"
-     << indent << "Locator: " << this->Locator << "\n";
+     << indent << "MergePoints: " << this->MergePoints << "\n";
 }
 
 // override for proper Update() behavior
@@ -405,8 +500,6 @@ void vtkTessellatorFilter::SetupOutput(vtkDataSet* input, vtkUnstructuredGrid* o
 
     ++attrib;
   }
-
-  output->GetCellData()->CopyAllocate(input->GetCellData(), input->GetNumberOfCells());
 }
 
 void vtkTessellatorFilter::MergeOutputPoints(
@@ -427,63 +520,48 @@ void vtkTessellatorFilter::MergeOutputPoints(
     return;
   }
 
-  output->GetPointData()->CopyAllocate(input->GetPointData());
   output->GetCellData()->PassData(input->GetCellData());
 
   // First, create a new points array that eliminate duplicate points.
   // Also create a mapping from the old point id to the new.
-  vtkPoints* newPts = vtkPoints::New();
   vtkIdType num = input->GetNumberOfPoints();
-  vtkIdType id;
-  vtkIdType newId;
-  vtkIdType* ptMap = new vtkIdType[num];
-  double pt[3];
-
-  this->Locator->InitPointInsertion(newPts, input->GetBounds(), num);
-
-  vtkIdType progressStep = num / 100;
-  if (progressStep == 0)
-  {
-    progressStep = 1;
-  }
-  for (id = 0; id < num; ++id)
-  {
-    if (id % progressStep == 0)
-    {
-      this->UpdateProgress(0.5 * (1. + id * 0.8 / num));
-    }
-    input->GetPoint(id, pt);
-    if (this->Locator->InsertUniquePoint(pt, newId))
-    {
-      output->GetPointData()->CopyData(input->GetPointData(), id, newId);
-    }
-    ptMap[id] = newId;
-  }
+  std::vector<vtkIdType> ptMap(num);
+  std::vector<vtkIdType> firstPtIds;
+  vtkNew<vtkPoints> newPts;
+  MergeCoincidentPoints(input->GetPoints(), newPts, ptMap, firstPtIds);
   output->SetPoints(newPts);
-  newPts->Delete();
-
-  // New copy the cells.
-  vtkIdList* cellPoints = vtkIdList::New();
-  num = input->GetNumberOfCells();
-  output->Allocate(num);
-  for (id = 0; id < num; ++id)
-  {
-    if (id % progressStep == 0)
+  this->UpdateProgress(0.9);
+
+  // Each merged point takes the data of its first occurrence.
+  const vtkIdType numNewPts = newPts->GetNumberOfPoints();
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numNewPts);
+  ArrayList arrays;
+  arrays.AddArrays(numNewPts, inPD, outPD, 0.0, false);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType newId = begin; newId < end; ++newId)
     {
-      this->UpdateProgress(0.9 + 0.1 * ((float)id / num));
+      arrays.Copy(firstPtIds[newId], newId);
     }
-    input->GetCellPoints(id, cellPoints);
-    for (int i = 0; i < cellPoints->GetNumberOfIds(); i++)
+  });
+
+  // Now renumber the points of the cells.
+  vtkCellArray* inCells = input->GetCells();
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->DeepCopy(inCells->GetOffsetsArray());
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->DeepCopy(inCells->GetConnectivityArray());
+  vtkSMPTools::For(0, connectivity->GetNumberOfValues(), [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType* conn = connectivity->GetPointer(0);
+    for (vtkIdType i = begin; i < end; ++i)
     {
-      int cellPtId = cellPoints->GetId(i);
-      newId = ptMap[cellPtId];
-      cellPoints->SetId(i, newId);
+      conn[i] = ptMap[conn[i]];
     }
-    output->InsertNextCell(input->GetCellType(id), cellPoints);
-  }
-
-  delete[] ptMap;
-  cellPoints->Delete();
+  });
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  output->SetCells(input->GetCellTypesArray(), cells);
 }
 
 void vtkTessellatorFilter::Teardown()
@@ -1156,521 +1234,615 @@ static vtkIdType quadVoxEdges[][2] = {
   { 19, 2 },
 };
 
-// This is used by the Execute() method to avoid printing out one
-// "Not Supported" error message per cell. Instead, we print one
-// per Execute().
-static int vtkNotSupportedErrorPrinted = 0;
-static int vtkTessellatorHasPolys = 0;
-
-// ========================================
-// the meat of the class: execution!
-int vtkTessellatorFilter::RequestData(
-  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+namespace
 {
-  int dummySubId = -1;
-  int p;
-
-  vtkNotSupportedErrorPrinted = 0;
-
-  // get the output info object
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
-  vtkUnstructuredGrid* output =
-    vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkDataSet* mesh = vtkDataSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+// Tessellate batches of cells. Each thread uses its own subdivision
+// criterion and tessellator, configured as the ones of the filter.
+struct TessellateCells
+{
+  vtkTessellatorFilter* Filter;
+  vtkDataSet* Mesh;
+  int OutputDimension;
+  vtkDataSetEdgeSubdivisionCriterion* Subdivider;
+  vtkStreamingTessellator* Tessellator;
+  std::vector<vtkTessellatorBatch>& Batches;
+  vtkSMPThreadLocalObject<vtkDataSetEdgeSubdivisionCriterion> LocalSubdivider;
+  vtkSMPThreadLocalObject<vtkStreamingTessellator> LocalTessellator;
+
+  TessellateCells(vtkTessellatorFilter* filter, vtkDataSet* mesh, int outputDimension,
+    vtkDataSetEdgeSubdivisionCriterion* subdivider, vtkStreamingTessellator* tessellator,
+    std::vector<vtkTessellatorBatch>& batches)
+    : Filter(filter)
+    , Mesh(mesh)
+    , OutputDimension(outputDimension)
+    , Subdivider(subdivider)
+    , Tessellator(tessellator)
+    , Batches(batches)
+  {
+  }
 
-  vtkSmartPointer<vtkUnstructuredGrid> tmpOut;
-  if (this->MergePoints)
+  void Initialize()
   {
-    tmpOut = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    vtkDataSetEdgeSubdivisionCriterion* subdivider = this->LocalSubdivider.Local();
+    vtkStreamingTessellator* tessellator = this->LocalTessellator.Local();
+    tessellator->SetSubdivisionAlgorithm(subdivider);
+    tessellator->SetMaximumNumberOfSubdivisions(
+      this->Tessellator->GetMaximumNumberOfSubdivisions());
+    for (int k = 1; k < 4; ++k)
+    {
+      tessellator->SetEmbeddingDimension(k, this->Tessellator->GetEmbeddingDimension(k));
+    }
+    SetCallbacks(tessellator);
+
+    subdivider->SetChordError2(this->Subdivider->GetChordError2());
+    // Only the first fields may be used as subdivision criteria.
+    for (int s = 0; s < static_cast<int>(sizeof(int) * 8); ++s)
+    {
+      if (this->Subdivider->GetFieldError2(s) > 0.)
+      {
+        subdivider->SetFieldError2(s, this->Subdivider->GetFieldError2(s));
+      }
+    }
+    const int* fieldIds = this->Subdivider->GetFieldIds();
+    const int* offsets = this->Subdivider->GetFieldOffsets();
+    for (int f = 0; f < this->Subdivider->GetNumberOfFields(); ++f)
+    {
+      subdivider->PassField(fieldIds[f], offsets[f + 1] - offsets[f], tessellator);
+    }
+    subdivider->SetMesh(this->Mesh);
   }
-  else
+
+  void operator()(vtkIdType beginBatch, vtkIdType endBatch)
   {
-    tmpOut = output;
+    this->Execute(this->LocalSubdivider.Local(), this->LocalTessellator.Local(), beginBatch,
+      endBatch, vtkSMPTools::GetSingleThread());
   }
 
-  this->SetupOutput(mesh, tmpOut);
+  void Reduce() {}
 
-  this->Subdivider->SetMesh(mesh);
-  this->Tessellator->SetVertexCallback(AddAPoint);
-  this->Tessellator->SetEdgeCallback(AddALine);
-  this->Tessellator->SetTriangleCallback(AddATriangle);
-  this->Tessellator->SetTetrahedronCallback(AddATetrahedron);
-  this->Tessellator->SetPrivateData(this);
-
-  vtkIdType cell = 0;
-  int nprim = 0;
-  vtkIdType* outconn = nullptr;
-  double pts[27][11 + vtkStreamingTessellator::MaxFieldSize];
-  int c;
-  vtkIdType numCells = mesh->GetNumberOfCells();
-  int progress = 0;
-  int progMax = this->MergePoints ? 50 : 100;
-  vtkIdType deltaProg = numCells / progMax + 1; // the extra + 1 means we always reach the end
-  vtkIdType progCells = 0;
-
-  vtkTessellatorHasPolys = 0; // print error message once per invocation, if needed
-  for (progress = 0; progress < progMax && !this->CheckAbort(); ++progress)
+  void Execute(vtkDataSetEdgeSubdivisionCriterion* subdivider,
+    vtkStreamingTessellator* tessellator, vtkIdType beginBatch, vtkIdType endBatch,
+    bool isFirst)
   {
-    progCells += deltaProg;
-    for (; (cell < progCells) && (cell < numCells); ++cell)
+    int dummySubId = -1;
+    int p;
+    int nprim = 0;
+    vtkIdType* outconn = nullptr;
+    double pts[27][11 + vtkStreamingTessellator::MaxFieldSize];
+    int c;
+    std::vector<double> weights;
+    const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+    vtkPointData* inPD = this->Mesh->GetPointData();
+    const int* fieldIds = subdivider->GetFieldIds();
+    const int* offsets = subdivider->GetFieldOffsets();
+    const int numFields = subdivider->GetNumberOfFields();
+
+    for (vtkIdType batchId = beginBatch; batchId < endBatch; ++batchId)
     {
-      if (this->CheckAbort())
+      if (isFirst)
       {
-        break;
+        this->Filter->CheckAbort();
       }
-      const vtkIdType nextOutCellId = this->OutputMesh->GetNumberOfCells();
-
-      this->Subdivider->SetCellId(cell);
-
-      vtkCell* cp = this->Subdivider->GetCell(); // We set the cell ID, get the vtkCell pointer
-      int np = cp->GetCellType();
-      std::vector<double> weights(cp->GetNumberOfPoints());
-      double* pcoord = cp->GetParametricCoords();
-      if (!pcoord || np == VTK_POLYGON || np == VTK_TRIANGLE_STRIP || np == VTK_CONVEX_POINT_SET ||
-        np == VTK_POLY_LINE || np == VTK_POLY_VERTEX || np == VTK_POLYHEDRON ||
-        np == VTK_QUADRATIC_POLYGON)
+      if (this->Filter->GetAbortOutput())
       {
-        if (!vtkTessellatorHasPolys)
-        {
-          vtkWarningMacro("Input dataset has cells without parameterizations "
-                          "(VTK_POLYGON,VTK_POLY_LINE,VTK_POLY_VERTEX,VTK_TRIANGLE_STRIP,VTK_"
-                          "CONVEX_POINT_SET,VTK_QUADRATIC_POLYGON). "
-                          "They will be ignored. Use vtkTriangleFilter, vtkTetrahedralize, etc. to "
-                          "parameterize them first.");
-          vtkTessellatorHasPolys = 1;
-        }
-        continue;
+        break;
       }
-      double* gcoord;
-      vtkDataArray* field;
-      for (p = 0; p < (cp->GetNumberOfPoints() < 27 ? cp->GetNumberOfPoints() : 27); ++p)
+      vtkTessellatorBatch& batch = this->Batches[batchId];
+      batch.FieldSize = offsets[numFields];
+      tessellator->SetPrivateData(&batch);
+      const vtkIdType endCell = std::min((batchId + 1) * TessellationBatchSize, numCells);
+      for (vtkIdType cell = batchId * TessellationBatchSize; cell < endCell; ++cell)
       {
-        gcoord = cp->Points->GetPoint(p);
-        for (c = 0; c < 3; ++c, ++gcoord, ++pcoord)
+        batch.CellId = cell;
+        subdivider->SetCellId(cell);
+
+        vtkCell* cp = subdivider->GetCell(); // We set the cell ID, get the vtkCell pointer
+        int np = cp->GetCellType();
+        weights.resize(cp->GetNumberOfPoints());
+        double* pcoord = cp->GetParametricCoords();
+        if (!pcoord || np == VTK_POLYGON || np == VTK_TRIANGLE_STRIP ||
+          np == VTK_CONVEX_POINT_SET || np == VTK_POLY_LINE || np == VTK_POLY_VERTEX ||
+          np == VTK_POLYHEDRON || np == VTK_QUADRATIC_POLYGON)
         {
-          pts[p][c] = *gcoord;
-          pts[p][c + 3] = *pcoord;
+          batch.HasUnparameterizedCells = true;
+          continue;
         }
-        // fill in field data
-        const int* offsets = this->Subdivider->GetFieldOffsets();
-        for (int f = 0; f < this->Subdivider->GetNumberOfFields(); ++f)
+        double* gcoord;
+        vtkDataArray* field;
+        for (p = 0; p < (cp->GetNumberOfPoints() < 27 ? cp->GetNumberOfPoints() : 27); ++p)
         {
-          field = mesh->GetPointData()->GetArray(this->Subdivider->GetFieldIds()[f]);
-          double* tuple = field->GetTuple(cp->GetPointId(p));
-          for (c = 0; c < field->GetNumberOfComponents(); ++c)
-          {
-            pts[p][6 + offsets[f] + c] = tuple[c];
-          }
-        }
-      }
-      int dim = this->OutputDimension;
-      // Tessellate each cell:
-      switch (cp->GetCellType())
-      {
-        case VTK_VERTEX:
-          dim = 0;
-          outconn = nullptr;
-          nprim = 1;
-          break;
-        case VTK_LINE:
-          dim = 1;
-          outconn = &linEdgeEdges[0][0];
-          nprim = sizeof(linEdgeEdges) / sizeof(linEdgeEdges[0]);
-          break;
-        case VTK_TRIANGLE:
-          if (dim > 1)
-          {
-            dim = 2;
-            outconn = &linTriTris[0][0];
-            nprim = sizeof(linTriTris) / sizeof(linTriTris[0]);
-          }
-          else
-          {
-            outconn = &linTriEdges[0][0];
-            nprim = sizeof(linTriEdges) / sizeof(linTriEdges[0]);
-          }
-          break;
-        case VTK_QUAD:
-          if (dim > 1)
-          {
-            dim = 2;
-            outconn = &linQuadTris[0][0];
-            nprim = sizeof(linQuadTris) / sizeof(linQuadTris[0]);
-          }
-          else
+          gcoord = cp->Points->GetPoint(p);
+          for (c = 0; c < 3; ++c, ++gcoord, ++pcoord)
           {
-            outconn = &linQuadEdges[0][0];
-            nprim = sizeof(linQuadEdges) / sizeof(linQuadEdges[0]);
+            pts[p][c] = *gcoord;
+            pts[p][c + 3] = *pcoord;
           }
-          break;
-        case VTK_TETRA:
-          if (dim == 3)
+          // fill in field data
+          for (int f = 0; f < numFields; ++f)
           {
-            outconn = &linTetTetrahedra[0][0];
-            nprim = sizeof(linTetTetrahedra) / sizeof(linTetTetrahedra[0]);
+            field = inPD->GetArray(fieldIds[f]);
+            field->GetTuple(cp->GetPointId(p), pts[p] + 6 + offsets[f]);
           }
-          else if (dim == 2)
-          {
-            outconn = &linTetTris[0][0];
-            nprim = sizeof(linTetTris) / sizeof(linTetTris[0]);
-          }
-          else
-          {
-            outconn = &linTetEdges[0][0];
-            nprim = sizeof(linTetEdges) / sizeof(linTetEdges[0]);
-          }
-          break;
-        case VTK_WEDGE:
-        case VTK_LAGRANGE_WEDGE:
-        case VTK_BEZIER_WEDGE:
-          // We sample additional points to get compatible triangulations
-          // with neighboring hexes, tets, etc.
-          for (p = 6; p < 21; ++p)
-          {
-            dummySubId = -1;
-            for (int y = 0; y < 3; ++y)
+        }
+        int dim = this->OutputDimension;
+        // Tessellate each cell:
+        switch (cp->GetCellType())
+        {
+          case VTK_VERTEX:
+            dim = 0;
+            outconn = nullptr;
+            nprim = 1;
+            break;
+          case VTK_LINE:
+            dim = 1;
+            outconn = &linEdgeEdges[0][0];
+            nprim = sizeof(linEdgeEdges) / sizeof(linEdgeEdges[0]);
+            break;
+          case VTK_TRIANGLE:
+            if (dim > 1)
             {
-              pts[p][y + 3] = extraWedgeParams[p - 6][y];
+              dim = 2;
+              outconn = &linTriTris[0][0];
+              nprim = sizeof(linTriTris) / sizeof(linTriTris[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          if (dim == 3)
-          {
-            outconn = &quadWedgeTetrahedra[0][0];
-            nprim = sizeof(quadWedgeTetrahedra) / sizeof(quadWedgeTetrahedra[0]);
-          }
-          else if (dim == 2)
-          {
-            outconn = &quadWedgeTris[0][0];
-            nprim = sizeof(quadWedgeTris) / sizeof(quadWedgeTris[0]);
-          }
-          else
-          {
-            outconn = &quadWedgeEdges[0][0];
-            nprim = sizeof(quadWedgeEdges) / sizeof(quadWedgeEdges[0]);
-          }
-          break;
-        case VTK_PYRAMID:
-          if (dim == 3)
-          {
-            outconn = &linPyrTetrahedra[0][0];
-            nprim = sizeof(linPyrTetrahedra) / sizeof(linPyrTetrahedra[0]);
-          }
-          else if (dim == 2)
-          {
-            outconn = &linPyrTris[0][0];
-            nprim = sizeof(linPyrTris) / sizeof(linPyrTris[0]);
-          }
-          else
-          {
-            outconn = &linPyrEdges[0][0];
-            nprim = sizeof(linPyrEdges) / sizeof(linPyrEdges[0]);
-          }
-          break;
-        case VTK_LAGRANGE_CURVE:
-        case VTK_BEZIER_CURVE:
-          // Lagrange/Bezier curves may bound other elements which we
-          // normally only divide in 2 along an axis, so only
-          // start by dividing the curve in 2 instead of adding
-          // each interior point to the approximation:
-          dummySubId = -1;
-          for (int y = 0; y < 3; ++y)
-          {
-            pts[2][y + 3] = extraLagrangeCurveParams[y];
-          }
-          cp->EvaluateLocation(dummySubId, pts[2] + 3, pts[2], weights.data());
-          this->Subdivider->EvaluateFields(pts[2], weights.data(), 6);
-          VTK_FALLTHROUGH;
-        case VTK_QUADRATIC_EDGE:
-          dim = 1;
-          outconn = &quadEdgeEdges[0][0];
-          nprim = sizeof(quadEdgeEdges) / sizeof(quadEdgeEdges[0]);
-          break;
-        case VTK_CUBIC_LINE:
-          dim = 1;
-          outconn = &cubicLinEdges[0][0];
-          nprim = sizeof(cubicLinEdges) / sizeof(cubicLinEdges[0]);
-          break;
-        case VTK_LAGRANGE_TRIANGLE:
-        case VTK_BEZIER_TRIANGLE:
-          for (p = 3; p < 6; ++p)
-          {
-            dummySubId = -1;
-            for (int y = 0; y < 3; ++y)
+            else
             {
-              pts[p][y + 3] = extraLagrangeTriParams[p - 3][y];
+              outconn = &linTriEdges[0][0];
+              nprim = sizeof(linTriEdges) / sizeof(linTriEdges[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          VTK_FALLTHROUGH;
-        case VTK_QUADRATIC_TRIANGLE:
-          if (dim > 1)
-          {
-            dim = 2;
-            outconn = &quadTriTris[0][0];
-            nprim = sizeof(quadTriTris) / sizeof(quadTriTris[0]);
-          }
-          else
-          {
-            outconn = &quadTriEdges[0][0];
-            nprim = sizeof(quadTriEdges) / sizeof(quadTriEdges[0]);
-          }
-          break;
-        case VTK_BIQUADRATIC_TRIANGLE:
-          if (dim > 1)
-          {
-            dim = 2;
-            outconn = &biQuadTriTris[0][0];
-            nprim = sizeof(biQuadTriTris) / sizeof(biQuadTriTris[0]);
-          }
-          else
-          {
-            outconn = &biQuadTriEdges[0][0];
-            nprim = sizeof(biQuadTriEdges) / sizeof(biQuadTriEdges[0]);
-          }
-          break;
-        case VTK_LAGRANGE_QUADRILATERAL:
-        case VTK_BEZIER_QUADRILATERAL:
-          // Arbitrary-order Lagrange elements may not have mid-edge nodes
-          // (they may be more finely divided), so evaluate to match fixed
-          // connectivity of our starting output.
-          {
-            int mm = static_cast<int>(
-              sizeof(extraLagrangeQuadParams) / sizeof(extraLagrangeQuadParams[0]));
-            for (int nn = 0; nn < mm; ++nn)
+            break;
+          case VTK_QUAD:
+            if (dim > 1)
             {
-              for (c = 0; c < 3; ++c)
+              dim = 2;
+              outconn = &linQuadTris[0][0];
+              nprim = sizeof(linQuadTris) / sizeof(linQuadTris[0]);
+            }
+            else
+            {
+              outconn = &linQuadEdges[0][0];
+              nprim = sizeof(linQuadEdges) / sizeof(linQuadEdges[0]);
+            }
+            break;
+          case VTK_TETRA:
+            if (dim == 3)
+            {
+              outconn = &linTetTetrahedra[0][0];
+              nprim = sizeof(linTetTetrahedra) / sizeof(linTetTetrahedra[0]);
+            }
+            else if (dim == 2)
+            {
+              outconn = &linTetTris[0][0];
+              nprim = sizeof(linTetTris) / sizeof(linTetTris[0]);
+            }
+            else
+            {
+              outconn = &linTetEdges[0][0];
+              nprim = sizeof(linTetEdges) / sizeof(linTetEdges[0]);
+            }
+            break;
+          case VTK_WEDGE:
+          case VTK_LAGRANGE_WEDGE:
+          case VTK_BEZIER_WEDGE:
+            // We sample additional points to get compatible triangulations
+            // with neighboring hexes, tets, etc.
+            for (p = 6; p < 21; ++p)
+            {
+              dummySubId = -1;
+              for (int y = 0; y < 3; ++y)
               {
-                pts[4 + nn][c + 3] = extraLagrangeQuadParams[nn][c];
+                pts[p][y + 3] = extraWedgeParams[p - 6][y];
               }
-              cp->EvaluateLocation(dummySubId, pts[4 + nn] + 3, pts[4 + nn], weights.data());
-              this->Subdivider->EvaluateFields(pts[4 + nn], weights.data(), 6);
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
             }
-          }
-          VTK_FALLTHROUGH;
-        case VTK_BIQUADRATIC_QUAD:
-        case VTK_QUADRATIC_QUAD:
-          for (c = 0; c < 3; ++c)
-          {
-            pts[8][c + 3] = extraQuadQuadParams[0][c];
-          }
-          cp->EvaluateLocation(dummySubId, pts[8] + 3, pts[8], weights.data());
-          this->Subdivider->EvaluateFields(pts[8], weights.data(), 6);
-          if (dim > 1)
-          {
-            dim = 2;
-            outconn = &quadQuadTris[0][0];
-            nprim = sizeof(quadQuadTris) / sizeof(quadQuadTris[0]);
-          }
-          else
-          {
-            outconn = &quadQuadEdges[0][0];
-            nprim = sizeof(quadQuadEdges) / sizeof(quadQuadEdges[0]);
-          }
-          break;
-        case VTK_LAGRANGE_TETRAHEDRON:
-        case VTK_BEZIER_TETRAHEDRON:
-          for (p = 4; p < 10; ++p)
-          {
-            dummySubId = -1;
-            for (int y = 0; y < 3; ++y)
+            if (dim == 3)
             {
-              pts[p][y + 3] = extraLagrangeTetraParams[p - 4][y];
+              outconn = &quadWedgeTetrahedra[0][0];
+              nprim = sizeof(quadWedgeTetrahedra) / sizeof(quadWedgeTetrahedra[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          VTK_FALLTHROUGH;
-        case VTK_QUADRATIC_TETRA:
-          if (dim == 3)
-          {
-            outconn = &quadTetTetrahedra[0][0];
-            nprim = sizeof(quadTetTetrahedra) / sizeof(quadTetTetrahedra[0]);
-          }
-          else if (dim == 2)
-          {
-            outconn = &quadTetTris[0][0];
-            nprim = sizeof(quadTetTris) / sizeof(quadTetTris[0]);
-          }
-          else
-          {
-            outconn = &quadTetEdges[0][0];
-            nprim = sizeof(quadTetEdges) / sizeof(quadTetEdges[0]);
-          }
-          break;
-        case VTK_HEXAHEDRON:
-        case VTK_LAGRANGE_HEXAHEDRON:
-        case VTK_BEZIER_HEXAHEDRON:
-          // we sample 19 extra points to guarantee a compatible tetrahedralization
-          for (p = 8; p < 20; ++p)
-          {
-            dummySubId = -1;
-            for (int y = 0; y < 3; ++y)
+            else if (dim == 2)
             {
-              pts[p][y + 3] = extraLinHexParams[p - 8][y];
+              outconn = &quadWedgeTris[0][0];
+              nprim = sizeof(quadWedgeTris) / sizeof(quadWedgeTris[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          VTK_FALLTHROUGH;
-        case VTK_QUADRATIC_HEXAHEDRON:
-          for (p = 20; p < 27; ++p)
-          {
-            dummySubId = -1;
-            for (int x = 0; x < 3; ++x)
+            else
             {
-              pts[p][x + 3] = extraQuadHexParams[p - 20][x];
+              outconn = &quadWedgeEdges[0][0];
+              nprim = sizeof(quadWedgeEdges) / sizeof(quadWedgeEdges[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          if (dim == 3)
-          {
-            outconn = &quadHexTetrahedra[0][0];
-            nprim = sizeof(quadHexTetrahedra) / sizeof(quadHexTetrahedra[0]);
-          }
-          else if (dim == 2)
-          {
-            outconn = &quadHexTris[0][0];
-            nprim = sizeof(quadHexTris) / sizeof(quadHexTris[0]);
-          }
-          else
-          {
-            outconn = &quadHexEdges[0][0];
-            nprim = sizeof(quadHexEdges) / sizeof(quadHexEdges[0]);
-          }
-          break;
-        case VTK_VOXEL:
-          // we sample 19 extra points to guarantee a compatible tetrahedralization
-          for (p = 8; p < 20; ++p)
-          {
-            dummySubId = -1;
-            for (int y = 0; y < 3; ++y)
+            break;
+          case VTK_PYRAMID:
+            if (dim == 3)
             {
-              pts[p][y + 3] = extraLinHexParams[p - 8][y];
+              outconn = &linPyrTetrahedra[0][0];
+              nprim = sizeof(linPyrTetrahedra) / sizeof(linPyrTetrahedra[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          for (p = 20; p < 27; ++p)
-          {
-            dummySubId = -1;
-            for (int x = 0; x < 3; ++x)
+            else if (dim == 2)
             {
-              pts[p][x + 3] = extraQuadHexParams[p - 20][x];
+              outconn = &linPyrTris[0][0];
+              nprim = sizeof(linPyrTris) / sizeof(linPyrTris[0]);
             }
-            cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
-            this->Subdivider->EvaluateFields(pts[p], weights.data(), 6);
-          }
-          if (dim == 3)
-          {
-            outconn = &quadVoxTetrahedra[0][0];
-            nprim = sizeof(quadVoxTetrahedra) / sizeof(quadVoxTetrahedra[0]);
-          }
-          else if (dim == 2)
-          {
-            outconn = &quadVoxTris[0][0];
-            nprim = sizeof(quadVoxTris) / sizeof(quadVoxTris[0]);
-          }
-          else
-          {
-            outconn = &quadVoxEdges[0][0];
-            nprim = sizeof(quadVoxEdges) / sizeof(quadVoxEdges[0]);
-          }
-          break;
-        case VTK_PIXEL:
-          dim = -1;
-          if (!vtkNotSupportedErrorPrinted)
-          {
-            vtkNotSupportedErrorPrinted = 1;
-            vtkWarningMacro("Oops, pixels are not supported");
-          }
-          break;
-        default:
-          dim = -1;
-          if (!vtkNotSupportedErrorPrinted)
-          {
-            vtkNotSupportedErrorPrinted = 1;
-            vtkWarningMacro("Oops, some cell type (" << cp->GetCellType() << ") not supported");
-          }
-      }
-
-      // OK, now output the primitives
-      if (cp->IsLinear())
-      {
-        switch (dim)
-        {
-          case 3:
-            for (int tet = 0; tet < nprim; ++tet, outconn += 4)
+            else
             {
-              this->Tessellator->AdaptivelySample3FacetLinear(
-                pts[outconn[0]], pts[outconn[1]], pts[outconn[2]], pts[outconn[3]]);
+              outconn = &linPyrEdges[0][0];
+              nprim = sizeof(linPyrEdges) / sizeof(linPyrEdges[0]);
             }
             break;
-          case 2:
-            for (int tri = 0; tri < nprim; ++tri, outconn += 3)
+          case VTK_LAGRANGE_CURVE:
+          case VTK_BEZIER_CURVE:
+            // Lagrange/Bezier curves may bound other elements which we
+            // normally only divide in 2 along an axis, so only
+            // start by dividing the curve in 2 instead of adding
+            // each interior point to the approximation:
+            dummySubId = -1;
+            for (int y = 0; y < 3; ++y)
             {
-              this->Tessellator->AdaptivelySample2FacetLinear(
-                pts[outconn[0]], pts[outconn[1]], pts[outconn[2]]);
+              pts[2][y + 3] = extraLagrangeCurveParams[y];
             }
+            cp->EvaluateLocation(dummySubId, pts[2] + 3, pts[2], weights.data());
+            subdivider->EvaluateFields(pts[2], weights.data(), 6);
+            VTK_FALLTHROUGH;
+          case VTK_QUADRATIC_EDGE:
+            dim = 1;
+            outconn = &quadEdgeEdges[0][0];
+            nprim = sizeof(quadEdgeEdges) / sizeof(quadEdgeEdges[0]);
+            break;
+          case VTK_CUBIC_LINE:
+            dim = 1;
+            outconn = &cubicLinEdges[0][0];
+            nprim = sizeof(cubicLinEdges) / sizeof(cubicLinEdges[0]);
             break;
-          case 1:
-            for (int edg = 0; edg < nprim; ++edg, outconn += 2)
+          case VTK_LAGRANGE_TRIANGLE:
+          case VTK_BEZIER_TRIANGLE:
+            for (p = 3; p < 6; ++p)
             {
-              this->Tessellator->AdaptivelySample1FacetLinear(pts[outconn[0]], pts[outconn[1]]);
+              dummySubId = -1;
+              for (int y = 0; y < 3; ++y)
+              {
+                pts[p][y + 3] = extraLagrangeTriParams[p - 3][y];
+              }
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
+            }
+            VTK_FALLTHROUGH;
+          case VTK_QUADRATIC_TRIANGLE:
+            if (dim > 1)
+            {
+              dim = 2;
+              outconn = &quadTriTris[0][0];
+              nprim = sizeof(quadTriTris) / sizeof(quadTriTris[0]);
+            }
+            else
+            {
+              outconn = &quadTriEdges[0][0];
+              nprim = sizeof(quadTriEdges) / sizeof(quadTriEdges[0]);
             }
             break;
-          case 0:
-            this->Tessellator->AdaptivelySample0Facet(pts[0]);
-            break;
-          default:
-            // do nothing
+          case VTK_BIQUADRATIC_TRIANGLE:
+            if (dim > 1)
+            {
+              dim = 2;
+              outconn = &biQuadTriTris[0][0];
+              nprim = sizeof(biQuadTriTris) / sizeof(biQuadTriTris[0]);
+            }
+            else
+            {
+              outconn = &biQuadTriEdges[0][0];
+              nprim = sizeof(biQuadTriEdges) / sizeof(biQuadTriEdges[0]);
+            }
             break;
-        }
-      }
-      else
-      {
-        switch (dim)
-        {
-          case 3:
-            for (int tet = 0; tet < nprim; ++tet, outconn += 4)
+          case VTK_LAGRANGE_QUADRILATERAL:
+          case VTK_BEZIER_QUADRILATERAL:
+            // Arbitrary-order Lagrange elements may not have mid-edge nodes
+            // (they may be more finely divided), so evaluate to match fixed
+            // connectivity of our starting output.
             {
-              this->Tessellator->AdaptivelySample3Facet(
-                pts[outconn[0]], pts[outconn[1]], pts[outconn[2]], pts[outconn[3]]);
+              int mm = static_cast<int>(
+                sizeof(extraLagrangeQuadParams) / sizeof(extraLagrangeQuadParams[0]));
+              for (int nn = 0; nn < mm; ++nn)
+              {
+                for (c = 0; c < 3; ++c)
+                {
+                  pts[4 + nn][c + 3] = extraLagrangeQuadParams[nn][c];
+                }
+                cp->EvaluateLocation(dummySubId, pts[4 + nn] + 3, pts[4 + nn], weights.data());
+                subdivider->EvaluateFields(pts[4 + nn], weights.data(), 6);
+              }
+            }
+            VTK_FALLTHROUGH;
+          case VTK_BIQUADRATIC_QUAD:
+          case VTK_QUADRATIC_QUAD:
+            for (c = 0; c < 3; ++c)
+            {
+              pts[8][c + 3] = extraQuadQuadParams[0][c];
+            }
+            cp->EvaluateLocation(dummySubId, pts[8] + 3, pts[8], weights.data());
+            subdivider->EvaluateFields(pts[8], weights.data(), 6);
+            if (dim > 1)
+            {
+              dim = 2;
+              outconn = &quadQuadTris[0][0];
+              nprim = sizeof(quadQuadTris) / sizeof(quadQuadTris[0]);
+            }
+            else
+            {
+              outconn = &quadQuadEdges[0][0];
+              nprim = sizeof(quadQuadEdges) / sizeof(quadQuadEdges[0]);
             }
             break;
-          case 2:
-            for (int tri = 0; tri < nprim; ++tri, outconn += 3)
+          case VTK_LAGRANGE_TETRAHEDRON:
+          case VTK_BEZIER_TETRAHEDRON:
+            for (p = 4; p < 10; ++p)
+            {
+              dummySubId = -1;
+              for (int y = 0; y < 3; ++y)
+              {
+                pts[p][y + 3] = extraLagrangeTetraParams[p - 4][y];
+              }
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
+            }
+            VTK_FALLTHROUGH;
+          case VTK_QUADRATIC_TETRA:
+            if (dim == 3)
+            {
+              outconn = &quadTetTetrahedra[0][0];
+              nprim = sizeof(quadTetTetrahedra) / sizeof(quadTetTetrahedra[0]);
+            }
+            else if (dim == 2)
             {
-              this->Tessellator->AdaptivelySample2Facet(
-                pts[outconn[0]], pts[outconn[1]], pts[outconn[2]]);
+              outconn = &quadTetTris[0][0];
+              nprim = sizeof(quadTetTris) / sizeof(quadTetTris[0]);
+            }
+            else
+            {
+              outconn = &quadTetEdges[0][0];
+              nprim = sizeof(quadTetEdges) / sizeof(quadTetEdges[0]);
             }
             break;
-          case 1:
-            for (int edg = 0; edg < nprim; ++edg, outconn += 2)
+          case VTK_HEXAHEDRON:
+          case VTK_LAGRANGE_HEXAHEDRON:
+          case VTK_BEZIER_HEXAHEDRON:
+            // we sample 19 extra points to guarantee a compatible tetrahedralization
+            for (p = 8; p < 20; ++p)
+            {
+              dummySubId = -1;
+              for (int y = 0; y < 3; ++y)
+              {
+                pts[p][y + 3] = extraLinHexParams[p - 8][y];
+              }
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
+            }
+            VTK_FALLTHROUGH;
+          case VTK_QUADRATIC_HEXAHEDRON:
+            for (p = 20; p < 27; ++p)
             {
-              this->Tessellator->AdaptivelySample1Facet(pts[outconn[0]], pts[outconn[1]]);
+              dummySubId = -1;
+              for (int x = 0; x < 3; ++x)
+              {
+                pts[p][x + 3] = extraQuadHexParams[p - 20][x];
+              }
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
+            }
+            if (dim == 3)
+            {
+              outconn = &quadHexTetrahedra[0][0];
+              nprim = sizeof(quadHexTetrahedra) / sizeof(quadHexTetrahedra[0]);
+            }
+            else if (dim == 2)
+            {
+              outconn = &quadHexTris[0][0];
+              nprim = sizeof(quadHexTris) / sizeof(quadHexTris[0]);
+            }
+            else
+            {
+              outconn = &quadHexEdges[0][0];
+              nprim = sizeof(quadHexEdges) / sizeof(quadHexEdges[0]);
             }
             break;
-          case 0:
-            this->Tessellator->AdaptivelySample0Facet(pts[0]);
+          case VTK_VOXEL:
+            // we sample 19 extra points to guarantee a compatible tetrahedralization
+            for (p = 8; p < 20; ++p)
+            {
+              dummySubId = -1;
+              for (int y = 0; y < 3; ++y)
+              {
+                pts[p][y + 3] = extraLinHexParams[p - 8][y];
+              }
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
+            }
+            for (p = 20; p < 27; ++p)
+            {
+              dummySubId = -1;
+              for (int x = 0; x < 3; ++x)
+              {
+                pts[p][x + 3] = extraQuadHexParams[p - 20][x];
+              }
+              cp->EvaluateLocation(dummySubId, pts[p] + 3, pts[p], weights.data());
+              subdivider->EvaluateFields(pts[p], weights.data(), 6);
+            }
+            if (dim == 3)
+            {
+              outconn = &quadVoxTetrahedra[0][0];
+              nprim = sizeof(quadVoxTetrahedra) / sizeof(quadVoxTetrahedra[0]);
+            }
+            else if (dim == 2)
+            {
+              outconn = &quadVoxTris[0][0];
+              nprim = sizeof(quadVoxTris) / sizeof(quadVoxTris[0]);
+            }
+            else
+            {
+              outconn = &quadVoxEdges[0][0];
+              nprim = sizeof(quadVoxEdges) / sizeof(quadVoxEdges[0]);
+            }
             break;
           default:
-            // do nothing
-            break;
+            dim = -1;
+            if (batch.UnsupportedCellType < 0)
+            {
+              batch.UnsupportedCellType = cp->GetCellType();
+            }
+        }
+
+        // OK, now output the primitives
+        if (cp->IsLinear())
+        {
+          switch (dim)
+          {
+            case 3:
+              for (int tet = 0; tet < nprim; ++tet, outconn += 4)
+              {
+                tessellator->AdaptivelySample3FacetLinear(
+                  pts[outconn[0]], pts[outconn[1]], pts[outconn[2]], pts[outconn[3]]);
+              }
+              break;
+            case 2:
+              for (int tri = 0; tri < nprim; ++tri, outconn += 3)
+              {
+                tessellator->AdaptivelySample2FacetLinear(
+                  pts[outconn[0]], pts[outconn[1]], pts[outconn[2]]);
+              }
+              break;
+            case 1:
+              for (int edg = 0; edg < nprim; ++edg, outconn += 2)
+              {
+                tessellator->AdaptivelySample1FacetLinear(pts[outconn[0]], pts[outconn[1]]);
+              }
+              break;
+            case 0:
+              tessellator->AdaptivelySample0Facet(pts[0]);
+              break;
+            default:
+              // do nothing
+              break;
+          }
+        }
+        else
+        {
+          switch (dim)
+          {
+            case 3:
+              for (int tet = 0; tet < nprim; ++tet, outconn += 4)
+              {
+                tessellator->AdaptivelySample3Facet(
+                  pts[outconn[0]], pts[outconn[1]], pts[outconn[2]], pts[outconn[3]]);
+              }
+              break;
+            case 2:
+              for (int tri = 0; tri < nprim; ++tri, outconn += 3)
+              {
+                tessellator->AdaptivelySample2Facet(
+                  pts[outconn[0]], pts[outconn[1]], pts[outconn[2]]);
+              }
+              break;
+            case 1:
+              for (int edg = 0; edg < nprim; ++edg, outconn += 2)
+              {
+                tessellator->AdaptivelySample1Facet(pts[outconn[0]], pts[outconn[1]]);
+              }
+              break;
+            case 0:
+              tessellator->AdaptivelySample0Facet(pts[0]);
+              break;
+            default:
+              // do nothing
+              break;
+          }
         }
       }
+    }
+  }
+};
+}
+
+// ========================================
+// the meat of the class: execution!
+int vtkTessellatorFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // get the output info object
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkUnstructuredGrid* output =
+    vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkDataSet* mesh = vtkDataSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkSmartPointer<vtkUnstructuredGrid> tmpOut;
+  if (this->MergePoints)
+  {
+    tmpOut = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  }
+  else
+  {
+    tmpOut = output;
+  }
+
+  this->SetupOutput(mesh, tmpOut);
+
+  this->Subdivider->SetMesh(mesh);
+  SetCallbacks(this->Tessellator);
+
+  const vtkIdType numCells = mesh->GetNumberOfCells();
+  const vtkIdType numBatches = (numCells + TessellationBatchSize - 1) / TessellationBatchSize;
+  std::vector<vtkTessellatorBatch> batches(numBatches);
+  TessellateCells tessellate(
+    this, mesh, this->OutputDimension, this->Subdivider, this->Tessellator, batches);
+
+  // Subclasses of the subdivision criterion or the tessellator may hold
+  // state that cannot be copied to the threads, so they are used serially.
+  if (numCells > 0 &&
+    !strcmp(this->Subdivider->GetClassName(), "vtkDataSetEdgeSubdivisionCriterion") &&
+    !strcmp(this->Tessellator->GetClassName(), "vtkStreamingTessellator"))
+  {
+    // Build the cell structures of the mesh once, before the threads get
+    // their cells.
+    vtkNew<vtkGenericCell> cell;
+    mesh->GetCell(0, cell);
+    vtkSMPTools::For(0, numBatches, tessellate);
+  }
+  else
+  {
+    tessellate.Execute(this->Subdivider, this->Tessellator, 0, numBatches, true);
+  }
+  this->Tessellator->SetPrivateData(nullptr);
 
-      // Copy cell data.
-      vtkCopyTuples(mesh->GetCellData(), cell, this->OutputMesh->GetCellData(), nextOutCellId,
-        this->OutputMesh->GetNumberOfCells());
+  // Report the problems of the cells once per execution.
+  bool hasUnparameterizedCells = false;
+  int unsupportedCellType = -1;
+  for (const vtkTessellatorBatch& batch : batches)
+  {
+    hasUnparameterizedCells |= batch.HasUnparameterizedCells;
+    if (unsupportedCellType < 0)
+    {
+      unsupportedCellType = batch.UnsupportedCellType;
     }
-    this->UpdateProgress((double)(progress / 100.));
   }
+  if (hasUnparameterizedCells)
+  {
+    vtkWarningMacro("Input dataset has cells without parameterizations "
+                    "(VTK_POLYGON,VTK_POLY_LINE,VTK_POLY_VERTEX,VTK_TRIANGLE_STRIP,VTK_"
+                    "CONVEX_POINT_SET,VTK_QUADRATIC_POLYGON). "
+                    "They will be ignored. Use vtkTriangleFilter, vtkTetrahedralize, etc. to "
+                    "parameterize them first.");
+  }
+  if (unsupportedCellType == VTK_PIXEL)
+  {
+    vtkWarningMacro("Oops, pixels are not supported");
+  }
+  else if (unsupportedCellType >= 0)
+  {
+    vtkWarningMacro("Oops, some cell type (" << unsupportedCellType << ") not supported");
+  }
+
+  BuildOutput(
+    batches, this->Subdivider, this->OutputAttributes, mesh->GetCellData(), this->OutputMesh);
+  this->UpdateProgress(this->MergePoints ? 0.5 : 1.0);
 
   if (this->MergePoints)
   {
@@ -19,23 +19,28 @@
  * approximate the nonlinear mesh using some approximation metric (encoded
  * in the particular vtkDataSetEdgeSubdivisionCriterion::EvaluateLocationAndFields
  * implementation). The simplices are placed into the filter's output
- * vtkDataSet object by the callback routines AddATetrahedron,
- * AddATriangle, and AddALine, which are registered with the triangulator.
+ * vtkDataSet object by callback routines which are registered with the
+ * triangulator.
  *
  * The output mesh will have geometry and any fields specified as
  * attributes in the input mesh's point data.  The attribute's copy flags
  * are honored, except for normals.
  *
+ * The cells are tessellated in parallel with vtkSMPTools when the
+ * tessellator and the subdivider are a vtkStreamingTessellator and a
+ * vtkDataSetEdgeSubdivisionCriterion: each thread works with copies of them.
+ * The cells are processed in batches whose simplices are concatenated in
+ * order, so the output does not depend on the number of threads. Subclasses
+ * of the tessellator or the subdivider are used serially.
+ *
  *
  * @par Internals:
  * The filter's main member function is RequestData(). This function first
- * calls SetupOutput() which allocates arrays and some temporary variables
- * for the primitive callbacks (OutputTriangle and OutputLine which are
- * called by AddATriangle and AddALine, respectively).  Each cell is given
- * an initial tessellation, which results in one or more calls to
- * OutputTetrahedron, OutputTriangle or OutputLine to add elements to the
- * OutputMesh. Finally, Teardown() is called to free the filter's working
- * space.
+ * calls SetupOutput() which allocates the output arrays. Each cell is given
+ * an initial tessellation, which results in one or more calls to the
+ * primitive callbacks to add simplices to a batch of the output. The
+ * batches are then gathered into the OutputMesh. Finally, Teardown() is
+ * called to free the filter's working space.
  *
  * @sa
  * vtkDataSetToUnstructuredGridFilter vtkDataSet vtkStreamingTessellator
@@ -49,10 +54,8 @@ VTK_ABI_NAMESPACE_BEGIN
 class vtkDataArray;
 class vtkDataSet;
 class vtkDataSetEdgeSubdivisionCriterion;
-class vtkPointLocator;
 class vtkPoints;
 class vtkStreamingTessellator;
-class vtkEdgeSubdivisionCriterion;
 class vtkUnstructuredGrid;
 
 class VTKFILTERSGENERAL_EXPORT vtkTessellatorFilter : public vtkUnstructuredGridAlgorithm
@@ -128,14 +131,14 @@ protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
 
   /**
-   * Called by RequestData to set up a multitude of member variables used by
-   * the per-primitive output functions (OutputLine, OutputTriangle, and
-   * maybe one day... OutputTetrahedron).
+   * Called by RequestData to set up the output mesh and the arrays of the
+   * fields passed to it.
    */
   void SetupOutput(vtkDataSet* input, vtkUnstructuredGrid* output);
 
   /**
-   * Called by RequestData to merge output points.
+   * Called by RequestData to merge output points. Coincident points are
+   * merged in parallel and numbered in the order of their first occurrence.
    */
   void MergeOutputPoints(vtkUnstructuredGrid* input, vtkUnstructuredGrid* output);
 
@@ -154,12 +157,11 @@ protected:
   vtkDataSetEdgeSubdivisionCriterion* Subdivider;
   int OutputDimension;
   vtkTypeBool MergePoints;
-  vtkPointLocator* Locator;
 
   ///@{
   /**
-   * These member variables are set by SetupOutput for use inside the
-   * callback members OutputLine and OutputTriangle.
+   * These member variables are set by SetupOutput and filled once the
+   * cells are tessellated.
    */
   vtkUnstructuredGrid* OutputMesh;
   vtkPoints* OutputPoints;
@@ -167,18 +169,6 @@ protected:
   int* OutputAttributeIndices;
   ///@}
 
-  static void AddAPoint(const double*, vtkEdgeSubdivisionCriterion*, void*, const void*);
-  static void AddALine(
-    const double*, const double*, vtkEdgeSubdivisionCriterion*, void*, const void*);
-  static void AddATriangle(
-    const double*, const double*, const double*, vtkEdgeSubdivisionCriterion*, void*, const void*);
-  static void AddATetrahedron(const double*, const double*, const double*, const double*,
-    vtkEdgeSubdivisionCriterion*, void*, const void*);
-  void OutputPoint(const double*);
-  void OutputLine(const double*, const double*);
-  void OutputTriangle(const double*, const double*, const double*);
-  void OutputTetrahedron(const double*, const double*, const double*, const double*);
-
 private:
   vtkTessellatorFilter(const vtkTessellatorFilter&) = delete;
   void operator=(const vtkTessellatorFilter&) = delete;
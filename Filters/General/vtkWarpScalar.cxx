@@ -8,6 +8,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkGenericCell.h"
 #include "vtkImageData.h"
 #include "vtkImageDataToPointSet.h"
@@ -252,10 +253,26 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkDebugMacro(<< "Warping data with scalars");
 
+  // Backward compatibility requires the output type to be float - this can
+  // be overridden.
+  const int outputType = this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION
+    ? VTK_DOUBLE
+    : VTK_FLOAT;
+
+  // When the input is consumed by this filter only and released afterwards,
+  // and its points are not shared with any other data object, the points are
+  // warped in place instead of being copied into a new array. The enclosure
+  // needs the original points, so it always works on a copy.
+  inPts = input->GetPoints();
+  const bool inPlace = inPts && !this->GenerateEnclosure &&
+    input == vtkPointSet::GetData(inputVector[0]) &&
+    vtkDemandDrivenPipeline::CanReuseInputData(inputVector[0]->GetInformationObject(0)) &&
+    inPts->GetReferenceCount() == 1 && inPts->GetData()->GetReferenceCount() == 1 &&
+    inPts->GetDataType() == outputType;
+
   // First, copy the input to the output as a starting point
   output->CopyStructure(input);
 
-  inPts = input->GetPoints();
   inNormals = input->GetPointData()->GetNormals();
   inScalars = this->GetInputArrayToProcess(0, inputVector);
   if (!inPts || !inScalars)
@@ -266,20 +283,15 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
 
   numPts = inPts->GetNumberOfPoints();
 
-  // Create the output points. Backward compatibility requires the
-  // output type to be float - this can be overridden.
-  vtkNew<vtkPoints> newPts;
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION ||
-    this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  // Create the output points.
+  vtkSmartPointer<vtkPoints> newPts = inPts;
+  if (!inPlace)
   {
-    newPts->SetDataType(VTK_FLOAT);
+    newPts = vtkSmartPointer<vtkPoints>::New();
+    newPts->SetDataType(outputType);
+    newPts->SetNumberOfPoints(numPts);
+    output->SetPoints(newPts);
   }
-  else
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-  newPts->SetNumberOfPoints(numPts);
-  output->SetPoints(newPts);
 
   // Figure out what normal to use
   double normal[3] = { 0.0, 0.0, 0.0 };
@@ -312,6 +324,10 @@ int vtkWarpScalar::RequestData(vtkInformation* vtkNotUsed(request),
     scaleWorker(inPts->GetData(), newPts->GetData(), inScalars, this, this->ScaleFactor,
       this->XYPlane, inNormals, normal);
   }
+  if (inPlace)
+  {
+    newPts->Modified();
+  }
 
   // Update ourselves and release memory
   //
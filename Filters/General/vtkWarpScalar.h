@@ -21,6 +21,13 @@
  * Note that the filter passes both its point data and cell data to
  * its output, except for normals, since these are distorted by the
  * warping.
+ *
+ * When the input is released once consumed (see
+ * vtkAlgorithm::SetReleaseDataFlag()), has no other consumer and does not
+ * share its points with another data object, the points are warped in place
+ * and moved to the output instead of being copied. This requires the input
+ * points to already have the output precision, and is disabled when
+ * GenerateEnclosure is on.
  */
 
 #ifndef vtkWarpScalar_h
@@ -6,6 +6,7 @@
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
+#include "vtkDemandDrivenPipeline.h"
 #include "vtkImageData.h"
 #include "vtkImageDataToPointSet.h"
 #include "vtkInformation.h"
@@ -157,14 +158,27 @@ int vtkWarpVector::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
 
-  // First, copy the input to the output as a starting point
-  output->CopyStructure(input);
-
-  vtkPoints* inPts;
-  if (input == nullptr || (inPts = input->GetPoints()) == nullptr)
+  vtkPoints* inPts = input->GetPoints();
+  if (inPts == nullptr)
   {
+    output->CopyStructure(input);
     return 1;
   }
+
+  // When the input is consumed by this filter only and released afterwards,
+  // and its points are not shared with any other data object, the points are
+  // warped in place instead of being copied into a new array.
+  const int outputType =
+    this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION ? VTK_FLOAT : VTK_DOUBLE;
+  const bool inPlace = input == vtkPointSet::GetData(inputVector[0]) &&
+    vtkDemandDrivenPipeline::CanReuseInputData(inputVector[0]->GetInformationObject(0)) &&
+    inPts->GetReferenceCount() == 1 && inPts->GetData()->GetReferenceCount() == 1 &&
+    (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION ||
+      inPts->GetDataType() == outputType);
+
+  // First, copy the input to the output as a starting point
+  output->CopyStructure(input);
+
   vtkIdType numPts = inPts->GetNumberOfPoints();
   vtkDataArray* vectors = this->GetInputArrayToProcess(0, inputVector);
 
@@ -176,21 +190,21 @@ int vtkWarpVector::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Create the output points. By default, the output type is the
   // same as the input type.
-  vtkNew<vtkPoints> newPts;
-  if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(inPts->GetDataType());
-  }
-  else if (this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  vtkSmartPointer<vtkPoints> newPts = inPts;
+  if (!inPlace)
   {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else
-  {
-    newPts->SetDataType(VTK_DOUBLE);
+    newPts = vtkSmartPointer<vtkPoints>::New();
+    if (this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+      newPts->SetDataType(inPts->GetDataType());
+    }
+    else
+    {
+      newPts->SetDataType(outputType);
+    }
+    newPts->SetNumberOfPoints(numPts);
+    output->SetPoints(newPts);
   }
-  newPts->SetNumberOfPoints(numPts);
-  output->SetPoints(newPts);
 
   assert(vectors->GetNumberOfComponents() == 3);
   assert(inPts->GetData()->GetNumberOfComponents() == 3);
@@ -207,6 +221,10 @@ int vtkWarpVector::RequestData(vtkInformation* vtkNotUsed(request),
   { // fallback to slowpath
     warpWorker(inPts->GetData(), newPts->GetData(), vectors, this, this->ScaleFactor);
   }
+  if (inPlace)
+  {
+    newPts->Modified();
+  }
 
   // now pass the data.
   output->GetPointData()->CopyNormalsOff(); // distorted geometry
@@ -9,6 +9,11 @@
  * profiles or mechanical deformation.
  *
  * The filter passes both its point data and cell data to its output.
+ *
+ * When the input is released once consumed (see
+ * vtkAlgorithm::SetReleaseDataFlag()), has no other consumer and does not
+ * share its points with another data object, the points are warped in place
+ * and moved to the output instead of being copied.
  */
 
 #ifndef vtkWarpVector_h
@@ -18,6 +18,7 @@
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkEmptyCell.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
@@ -25,10 +26,14 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -38,9 +43,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -392,20 +399,22 @@ struct vtkYoungsMaterialInterface_Mat
   vtkDataArray* orderingArray;
 
   // temporary
-  vtkIdType numberOfCells;
-  vtkIdType numberOfPoints;
   vtkIdType cellCount;
   vtkIdType cellArrayCount;
   vtkIdType pointCount;
-  vtkIdType* pointMap;
+  std::unordered_map<vtkIdType, vtkIdType> pointMap;
+  std::vector<vtkIdType> pointInputIds; // input point of each output point, -1 if new
 
   // output
   std::vector<unsigned char> cellTypes;
   std::vector<vtkIdType> cells;
-  vtkDataArray** outCellArrays;
-  vtkDataArray** outPointArrays; // last point array is point coords
+  std::vector<vtkIdType> cellIds; // input cell of each output cell
+  std::vector<vtkSmartPointer<vtkDataArray>> outPointArrays; // last point array is point coords
 };
 
+// Number of consecutive cells processed together by a thread.
+static constexpr vtkIdType vtkYoungsMaterialInterface_BatchSize = 4096;
+
 static inline void vtkYoungsMaterialInterface_GetPointData(int nPointData,
   vtkDataArray** inPointArrays, vtkDataSet* input,
   std::vector<std::pair<int, vtkIdType>>& prevPointsMap, int vtkNotUsed(nmat),
@@ -441,6 +450,159 @@ static inline void vtkYoungsMaterialInterface_GetPointData(int nPointData,
   vtkYoungsMaterialInterface_GetPointData(                                                         \
     nPointData, inPointArrays, input, prevPointsMap, nmat, Mats, a, i, t)
 
+// Concatenate the outputs of material m computed by the batches of cells in
+// ugOutput. An input point copied by several batches is kept in the first one
+// only, so that the output is the one of a serial processing of the cells.
+static void vtkYoungsMaterialInterface_MergeBatches(
+  std::vector<std::vector<vtkYoungsMaterialInterface_Mat>>& batchMats, int m, vtkIdType nPoints,
+  int nPointData, int nCellData, vtkDataArray** inCellArrays, vtkUnstructuredGrid* ugOutput)
+{
+  const vtkIdType nBatches = static_cast<vtkIdType>(batchMats.size());
+
+  // first batch copying each input point
+  std::vector<vtkIdType> firstBatch(nPoints, -1);
+  for (vtkIdType b = 0; b < nBatches; ++b)
+  {
+    for (vtkIdType ptId : batchMats[b][m].pointInputIds)
+    {
+      if (ptId >= 0 && firstBatch[ptId] < 0)
+      {
+        firstBatch[ptId] = b;
+      }
+    }
+  }
+
+  // number of points, cells and connectivity entries of each batch
+  std::vector<vtkIdType> pointOffsets(nBatches + 1, 0);
+  std::vector<vtkIdType> cellOffsets(nBatches + 1, 0);
+  std::vector<vtkIdType> connectivityOffsets(nBatches + 1, 0);
+  vtkSMPTools::For(0, nBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType b = beginBatch; b < endBatch; ++b)
+    {
+      const vtkYoungsMaterialInterface_Mat& mat = batchMats[b][m];
+      pointOffsets[b + 1] = std::count_if(mat.pointInputIds.begin(), mat.pointInputIds.end(),
+        [&](vtkIdType ptId) { return ptId < 0 || firstBatch[ptId] == b; });
+      cellOffsets[b + 1] = mat.cellCount;
+      connectivityOffsets[b + 1] = mat.cellArrayCount - mat.cellCount;
+    }
+  });
+  for (vtkIdType b = 0; b < nBatches; ++b)
+  {
+    pointOffsets[b + 1] += pointOffsets[b];
+    cellOffsets[b + 1] += cellOffsets[b];
+    connectivityOffsets[b + 1] += connectivityOffsets[b];
+  }
+  const vtkIdType numberOfPoints = pointOffsets[nBatches];
+  const vtkIdType numberOfCells = cellOffsets[nBatches];
+
+  // output ids of the points of each batch
+  std::vector<vtkIdType> inputToOutput(nPoints, -1);
+  std::vector<std::vector<vtkIdType>> outputIds(nBatches);
+  vtkSMPTools::For(0, nBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType b = beginBatch; b < endBatch; ++b)
+    {
+      const std::vector<vtkIdType>& pointInputIds = batchMats[b][m].pointInputIds;
+      outputIds[b].resize(pointInputIds.size());
+      vtkIdType nextId = pointOffsets[b];
+      for (size_t i = 0; i < pointInputIds.size(); ++i)
+      {
+        vtkIdType ptId = pointInputIds[i];
+        if (ptId < 0 || firstBatch[ptId] == b)
+        {
+          outputIds[b][i] = nextId++;
+          if (ptId >= 0)
+          {
+            inputToOutput[ptId] = outputIds[b][i];
+          }
+        }
+      }
+    }
+  });
+
+  std::vector<vtkSmartPointer<vtkDataArray>> outPointArrays(nPointData);
+  for (int a = 0; a < nPointData; a++)
+  {
+    outPointArrays[a].TakeReference(batchMats[0][m].outPointArrays[a]->NewInstance());
+    outPointArrays[a]->SetName(batchMats[0][m].outPointArrays[a]->GetName());
+    outPointArrays[a]->SetNumberOfComponents(
+      batchMats[0][m].outPointArrays[a]->GetNumberOfComponents());
+    outPointArrays[a]->SetNumberOfTuples(numberOfPoints);
+  }
+  std::vector<vtkSmartPointer<vtkDataArray>> outCellArrays(nCellData);
+  for (int a = 0; a < nCellData; a++)
+  {
+    outCellArrays[a].TakeReference(vtkDataArray::CreateDataArray(inCellArrays[a]->GetDataType()));
+    outCellArrays[a]->SetName(inCellArrays[a]->GetName());
+    outCellArrays[a]->SetNumberOfComponents(inCellArrays[a]->GetNumberOfComponents());
+    outCellArrays[a]->SetNumberOfTuples(numberOfCells);
+  }
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfValues(numberOfCells);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numberOfCells + 1);
+  offsets->SetValue(numberOfCells, connectivityOffsets[nBatches]);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(connectivityOffsets[nBatches]);
+
+  // gather the points, the cells and the cell data of the batches
+  vtkSMPTools::For(0, nBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+    for (vtkIdType b = beginBatch; b < endBatch; ++b)
+    {
+      const vtkYoungsMaterialInterface_Mat& mat = batchMats[b][m];
+      for (size_t i = 0; i < mat.pointInputIds.size(); ++i)
+      {
+        vtkIdType ptId = mat.pointInputIds[i];
+        if (ptId < 0 || firstBatch[ptId] == b)
+        {
+          for (int a = 0; a < nPointData; a++)
+          {
+            outPointArrays[a]->SetTuple(outputIds[b][i], i, mat.outPointArrays[a]);
+          }
+        }
+        else
+        {
+          outputIds[b][i] = inputToOutput[ptId];
+        }
+      }
+
+      vtkIdType cellId = cellOffsets[b];
+      vtkIdType connectivityId = connectivityOffsets[b];
+      for (size_t i = 0; i < mat.cells.size(); cellId++)
+      {
+        cellTypes->SetValue(cellId, mat.cellTypes[cellId - cellOffsets[b]]);
+        offsets->SetValue(cellId, connectivityId);
+        vtkIdType npts = mat.cells[i++];
+        for (vtkIdType p = 0; p < npts; ++p, ++i)
+        {
+          vtkIdType nptId = mat.cells[i];
+          connectivity->SetValue(connectivityId++, nptId >= 0 ? outputIds[b][nptId] : -1);
+        }
+        for (int a = 0; a < nCellData; a++)
+        {
+          outCellArrays[a]->SetTuple(cellId, mat.cellIds[cellId - cellOffsets[b]], inCellArrays[a]);
+        }
+      }
+    }
+  });
+
+  vtkNew<vtkPoints> points;
+  points->SetData(outPointArrays[nPointData - 1]);
+  ugOutput->SetPoints(points);
+
+  vtkNew<vtkCellArray> cellArray;
+  cellArray->SetData(offsets, connectivity);
+  ugOutput->SetCells(cellTypes, cellArray);
+
+  for (int a = 0; a < nPointData - 1; a++)
+  {
+    ugOutput->GetPointData()->AddArray(outPointArrays[a]);
+  }
+  for (int a = 0; a < nCellData; a++)
+  {
+    ugOutput->GetCellData()->AddArray(outCellArrays[a]);
+  }
+}
+
 struct CellInfo
 {
   double points[vtkYoungsMaterialInterface::MAX_CELL_POINTS][3];
@@ -554,10 +716,10 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // debug statistics
-  vtkIdType debugStats_PrimaryTriangulationfailed = 0;
-  vtkIdType debugStats_Triangulationfailed = 0;
-  vtkIdType debugStats_NullNormal = 0;
-  vtkIdType debugStats_NoInterfaceFound = 0;
+  std::atomic<vtkIdType> debugStats_PrimaryTriangulationfailed(0);
+  std::atomic<vtkIdType> debugStats_Triangulationfailed(0);
+  std::atomic<vtkIdType> debugStats_NullNormal(0);
+  std::atomic<vtkIdType> debugStats_NoInterfaceFound(0);
 
   // Initialize number of materials
   int nmat = static_cast<int>(this->Internals->Materials.size());
@@ -703,109 +865,25 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
             nullptr; // TODO: we certainly can do better to avoid material calculations
         }
 
-        Mats[m].numberOfCells = 0;
         Mats[m].cellCount = 0;
         Mats[m].cellArrayCount = 0;
-
-        Mats[m].outCellArrays = new vtkDataArray*[nCellData];
-        for (int i = 0; i < nCellData; ++i)
-        {
-          Mats[m].outCellArrays[i] = vtkDataArray::CreateDataArray(inCellArrays[i]->GetDataType());
-          Mats[m].outCellArrays[i]->SetName(inCellArrays[i]->GetName());
-          Mats[m].outCellArrays[i]->SetNumberOfComponents(inCellArrays[i]->GetNumberOfComponents());
-        }
-
-        Mats[m].numberOfPoints = 0;
         Mats[m].pointCount = 0;
-        Mats[m].outPointArrays = new vtkDataArray*[nPointData];
-
-        for (int i = 0; i < (nPointData - 1); i++)
-        {
-          Mats[m].outPointArrays[i] =
-            vtkDataArray::CreateDataArray(inPointArrays[i]->GetDataType());
-          Mats[m].outPointArrays[i]->SetName(inPointArrays[i]->GetName());
-          Mats[m].outPointArrays[i]->SetNumberOfComponents(
-            inPointArrays[i]->GetNumberOfComponents());
-        }
-        Mats[m].outPointArrays[nPointData - 1] = vtkDoubleArray::New();
-        Mats[m].outPointArrays[nPointData - 1]->SetName("Points");
-        Mats[m].outPointArrays[nPointData - 1]->SetNumberOfComponents(3);
-      }
-    }
-
-    // --------------- per material number of interfaces estimation ------------
-    for (vtkIdType c = 0; c < nCells; c++)
-    {
-      vtkCell* vtkcell = input->GetCell(c);
-      int cellDim = vtkcell->GetCellDimension();
-      int np = vtkcell->GetNumberOfPoints();
-      int nf = vtkcell->GetNumberOfFaces();
-
-      for (int m = 0; m < nmat; m++)
-      {
-        double fraction =
-          (Mats[m].fractionArray != nullptr) ? Mats[m].fractionArray->GetTuple1(c) : 0;
-        if (this->CellProduceInterface(
-              cellDim, np, fraction, this->VolumeFractionRange[0], this->VolumeFractionRange[1]))
-        {
-          if (cellDim == 2)
-          {
-            Mats[m].numberOfPoints += 2;
-          }
-          else
-          {
-            Mats[m].numberOfPoints += nf;
-          }
-          if (this->FillMaterial)
-          {
-            Mats[m].numberOfPoints += np - 1;
-          }
-          Mats[m].numberOfCells++;
-        }
-      }
-    }
-
-    // allocation of output arrays
-    for (int m = 0; m < nmat; m++)
-    {
-      vtkDebugMacro(<< "Mat #" << m << " : cells=" << Mats[m].numberOfCells << ", points="
-                    << Mats[m].numberOfPoints << ", FillMaterial=" << this->FillMaterial << "\n");
-      for (int i = 0; i < nCellData; i++)
-      {
-        Mats[m].outCellArrays[i]->Allocate(
-          Mats[m].numberOfCells * Mats[m].outCellArrays[i]->GetNumberOfComponents());
-      }
-      for (int i = 0; i < nPointData; i++)
-      {
-        Mats[m].outPointArrays[i]->Allocate(
-          Mats[m].numberOfPoints * Mats[m].outPointArrays[i]->GetNumberOfComponents());
-      }
-      Mats[m].cellTypes.reserve(Mats[m].numberOfCells);
-      Mats[m].cells.reserve(Mats[m].numberOfCells + Mats[m].numberOfPoints);
-      Mats[m].pointMap = new vtkIdType[nPoints];
-      for (vtkIdType i = 0; i < nPoints; i++)
-      {
-        Mats[m].pointMap[i] = -1;
       }
     }
 
     // --------------------------- core computation --------------------------
-    vtkIdList* ptIds = vtkIdList::New();
-    vtkConvexPointSet* cpsCell = vtkConvexPointSet::New();
-
-    double* interpolatedValues = new double[MAX_CELL_POINTS * pointDataComponents];
-    vtkYoungsMaterialInterface_IndexedValue* matOrdering =
-      new vtkYoungsMaterialInterface_IndexedValue[nmat];
-
-    std::vector<std::pair<int, vtkIdType>> prevPointsMap;
-    prevPointsMap.reserve(MAX_CELL_POINTS * nmat);
-
-    for (vtkIdType ci = 0; ci < nCells; ci++)
-    {
-      if (this->CheckAbort())
-      {
-        break;
-      }
+    // The cells are processed in parallel by batches of consecutive cells.
+    // Each batch fills its own material outputs, which are concatenated in
+    // the order of the batches once all the cells are processed.
+    const vtkIdType nBatches =
+      (nCells + vtkYoungsMaterialInterface_BatchSize - 1) / vtkYoungsMaterialInterface_BatchSize;
+    std::vector<std::vector<vtkYoungsMaterialInterface_Mat>> batchMats(nBatches);
+
+    auto processCell = [&](vtkIdType ci, vtkYoungsMaterialInterface_Mat* Mats,
+                         vtkGenericCell* genericCell, vtkIdList* ptIds, vtkConvexPointSet* cpsCell,
+                         double* interpolatedValues,
+                         vtkYoungsMaterialInterface_IndexedValue* matOrdering,
+                         std::vector<std::pair<int, vtkIdType>>& prevPointsMap) {
       int interfaceEdges[MAX_CELL_POINTS * 2];
       double interfaceWeights[MAX_CELL_POINTS];
       int nInterfaceEdges;
@@ -842,7 +920,8 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
 
       // read cell information for the first iteration
       // a temporary cell will then be generated after each iteration for the next one.
-      vtkCell* vtkcell = input->GetCell(ci);
+      input->GetCell(ci, genericCell);
+      vtkCell* vtkcell = genericCell->GetRepresentativeCell();
       CellInfo cell;
       cell.dim = vtkcell->GetCellDimension();
       cell.np = vtkcell->GetNumberOfPoints();
@@ -1245,6 +1324,7 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
                 Mats[m].outPointArrays[a]->InsertNextTuple(
                   interpolatedValues + e * pointDataComponents + pointArrayOffset[a]);
               }
+              Mats[m].pointInputIds.push_back(-1);
             }
             int pointsCopied = 0;
             int prevMatInterfToBeAdded = 0;
@@ -1255,10 +1335,11 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
                 vtkIdType ptId = cell.pointIds[insidePointIds[p]];
                 if (ptId >= 0)
                 {
-                  if (Mats[m].pointMap[ptId] == -1)
+                  if (Mats[m].pointMap.find(ptId) == Mats[m].pointMap.end())
                   {
                     vtkIdType nptId = Mats[m].pointCount + nInterfaceEdges + pointsCopied;
                     Mats[m].pointMap[ptId] = nptId;
+                    Mats[m].pointInputIds.push_back(ptId);
                     pointsCopied++;
                     for (int a = 0; a < nPointData; a++)
                     {
@@ -1294,12 +1375,14 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
                 {
                   // Interface from a previous iteration
                   DBG_ASSERT(ptId >= 0 && ptId < nPoints);
-                  nptId = Mats[m].pointMap[ptId];
+                  auto mappedId = Mats[m].pointMap.find(ptId);
+                  nptId = mappedId != Mats[m].pointMap.end() ? mappedId->second : -1;
                 }
                 else
                 {
                   nptId = Mats[m].pointCount + nInterfaceEdges + pointsCopied + prevMatInterfAdded;
                   prevMatInterfAdded++;
+                  Mats[m].pointInputIds.push_back(-1);
                   for (int a = 0; a < nPointData; a++)
                   {
                     DBG_ASSERT(nptId == Mats[m].outPointArrays[a]->GetNumberOfTuples());
@@ -1325,11 +1408,8 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
 
             Mats[m].pointCount += nInterfaceEdges + pointsCopied + prevMatInterfAdded;
 
-            // Copy cell arrays
-            for (int a = 0; a < nCellData; a++)
-            {
-              Mats[m].outCellArrays[a]->InsertNextTuple(inCellArrays[a]->GetTuple(ci));
-            }
+            // Keep the input cell, its cell data is copied with the output
+            Mats[m].cellIds.push_back(ci);
             Mats[m].cellCount++;
 
             // Check for equivalence between counters and container sizes
@@ -1419,84 +1499,90 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
 
       } // for materials
 
-    } // for cells
-    delete[] pointArrayOffset;
-    delete[] inPointArrays;
-    delete[] inCellArrays;
-
-    ptIds->Delete();
-    cpsCell->Delete();
-    delete[] interpolatedValues;
-    delete[] matOrdering;
+    };
 
-    // finish output creation
-    //       output->SetNumberOfBlocks( nmat );
-    for (int m = 0; m < nmat; m++)
+    // GetCell is not thread safe until it has been called once
+    if (nCells > 0)
     {
-      if (Mats[m].cellCount > 0 && Mats[m].pointCount > 0)
+      vtkNew<vtkGenericCell> cell;
+      input->GetCell(0, cell);
+    }
+
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+    vtkSMPThreadLocalObject<vtkConvexPointSet> tlCpsCell;
+    vtkSMPThreadLocal<std::vector<double>> tlInterpolatedValues;
+    vtkSMPThreadLocal<std::vector<vtkYoungsMaterialInterface_IndexedValue>> tlMatOrdering;
+    vtkSMPThreadLocal<std::vector<std::pair<int, vtkIdType>>> tlPrevPointsMap;
+    vtkSMPTools::For(0, nBatches, [&](vtkIdType beginBatch, vtkIdType endBatch) {
+      vtkGenericCell* genericCell = tlCell.Local();
+      vtkIdList* ptIds = tlPtIds.Local();
+      vtkConvexPointSet* cpsCell = tlCpsCell.Local();
+      std::vector<double>& interpolatedValues = tlInterpolatedValues.Local();
+      interpolatedValues.resize(MAX_CELL_POINTS * pointDataComponents);
+      std::vector<vtkYoungsMaterialInterface_IndexedValue>& matOrdering = tlMatOrdering.Local();
+      matOrdering.resize(nmat);
+      std::vector<std::pair<int, vtkIdType>>& prevPointsMap = tlPrevPointsMap.Local();
+      prevPointsMap.reserve(MAX_CELL_POINTS * nmat);
+
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType batch = beginBatch; batch < endBatch; ++batch)
       {
-        vtkDebugMacro(<< "Mat #" << m << " : cellCount=" << Mats[m].cellCount << ", numberOfCells="
-                      << Mats[m].numberOfCells << ", pointCount=" << Mats[m].pointCount
-                      << ", numberOfPoints=" << Mats[m].numberOfPoints << "\n");
+        std::vector<vtkYoungsMaterialInterface_Mat>& mats = batchMats[batch];
+        mats.assign(Mats, Mats + nmat);
+        for (vtkYoungsMaterialInterface_Mat& mat : mats)
+        {
+          mat.outPointArrays.resize(nPointData);
+          for (int i = 0; i < (nPointData - 1); i++)
+          {
+            mat.outPointArrays[i].TakeReference(
+              vtkDataArray::CreateDataArray(inPointArrays[i]->GetDataType()));
+            mat.outPointArrays[i]->SetName(inPointArrays[i]->GetName());
+            mat.outPointArrays[i]->SetNumberOfComponents(inPointArrays[i]->GetNumberOfComponents());
+          }
+          mat.outPointArrays[nPointData - 1] = vtkSmartPointer<vtkDoubleArray>::New();
+          mat.outPointArrays[nPointData - 1]->SetName("Points");
+          mat.outPointArrays[nPointData - 1]->SetNumberOfComponents(3);
+        }
+
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          continue;
+        }
+        vtkIdType beginCell = batch * vtkYoungsMaterialInterface_BatchSize;
+        vtkIdType endCell = std::min(nCells, beginCell + vtkYoungsMaterialInterface_BatchSize);
+        for (vtkIdType ci = beginCell; ci < endCell; ci++)
+        {
+          processCell(ci, mats.data(), genericCell, ptIds, cpsCell, interpolatedValues.data(),
+            matOrdering.data(), prevPointsMap);
+        }
       }
+    });
 
-      delete[] Mats[m].pointMap;
 
+    // finish output creation
+    //       output->SetNumberOfBlocks( nmat );
+    for (int m = 0; m < nmat; m++)
+    {
       vtkSmartPointer<vtkUnstructuredGrid> ugOutput = vtkSmartPointer<vtkUnstructuredGrid>::New();
 
-      // set points
-      Mats[m].outPointArrays[nPointData - 1]->Squeeze();
-      vtkPoints* points = vtkPoints::New();
-      points->SetDataTypeToDouble();
-      points->SetNumberOfPoints(Mats[m].pointCount);
-      points->SetData(Mats[m].outPointArrays[nPointData - 1]);
-      Mats[m].outPointArrays[nPointData - 1]->Delete();
-      ugOutput->SetPoints(points);
-      points->Delete();
-
-      // set cell connectivity
-      vtkIdTypeArray* cellArrayData = vtkIdTypeArray::New();
-      cellArrayData->SetNumberOfValues(Mats[m].cellArrayCount);
-      vtkIdType* cellArrayDataPtr = cellArrayData->WritePointer(0, Mats[m].cellArrayCount);
-      for (vtkIdType i = 0; i < Mats[m].cellArrayCount; i++)
-        cellArrayDataPtr[i] = Mats[m].cells[i];
-
-      vtkCellArray* cellArray = vtkCellArray::New();
-      cellArray->AllocateExact(Mats[m].cellCount, Mats[m].cellArrayCount - Mats[m].cellCount);
-      cellArray->ImportLegacyFormat(cellArrayData);
-      cellArrayData->Delete();
-
-      // set cell types
-      vtkUnsignedCharArray* cellTypes = vtkUnsignedCharArray::New();
-      cellTypes->SetNumberOfValues(Mats[m].cellCount);
-      unsigned char* cellTypesPtr = cellTypes->WritePointer(0, Mats[m].cellCount);
-      for (vtkIdType i = 0; i < Mats[m].cellCount; i++)
-        cellTypesPtr[i] = Mats[m].cellTypes[i];
-
-      // attach connectivity arrays to data set
-      ugOutput->SetCells(cellTypes, cellArray);
-      cellArray->Delete();
-      cellTypes->Delete();
-
-      // attach point arrays
-      for (int i = 0; i < nPointData - 1; i++)
+      vtkIdType cellCount = 0;
+      for (const std::vector<vtkYoungsMaterialInterface_Mat>& mats : batchMats)
       {
-        Mats[m].outPointArrays[i]->Squeeze();
-        ugOutput->GetPointData()->AddArray(Mats[m].outPointArrays[i]);
-        Mats[m].outPointArrays[i]->Delete();
+        cellCount += mats[m].cellCount;
       }
-
-      // attach cell arrays
-      for (int i = 0; i < nCellData; i++)
+      if (cellCount > 0)
       {
-        Mats[m].outCellArrays[i]->Squeeze();
-        ugOutput->GetCellData()->AddArray(Mats[m].outCellArrays[i]);
-        Mats[m].outCellArrays[i]->Delete();
+        vtkYoungsMaterialInterface_MergeBatches(
+          batchMats, m, nPoints, nPointData, nCellData, inCellArrays, ugOutput);
+        vtkDebugMacro(<< "Mat #" << m << " : cellCount=" << ugOutput->GetNumberOfCells()
+                      << ", pointCount=" << ugOutput->GetNumberOfPoints() << "\n");
       }
 
-      delete[] Mats[m].outCellArrays;
-      delete[] Mats[m].outPointArrays;
-
       // activate attributes similarly to input
       for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
       {
@@ -1523,27 +1609,31 @@ int vtkYoungsMaterialInterface::RequestData(vtkInformation* vtkNotUsed(request),
         ++inputsPerMaterial[m];
       }
     }
+    delete[] pointArrayOffset;
+    delete[] inPointArrays;
+    delete[] inCellArrays;
     delete[] Mats;
+
   } // Iterate over input blocks
 
   delete[] inputsPerMaterial;
 
   if (debugStats_PrimaryTriangulationfailed)
   {
-    vtkDebugMacro(<< "PrimaryTriangulationfailed " << debugStats_PrimaryTriangulationfailed
+    vtkDebugMacro(<< "PrimaryTriangulationfailed " << debugStats_PrimaryTriangulationfailed.load()
                   << "\n");
   }
   if (debugStats_Triangulationfailed)
   {
-    vtkDebugMacro(<< "Triangulationfailed " << debugStats_Triangulationfailed << "\n");
+    vtkDebugMacro(<< "Triangulationfailed " << debugStats_Triangulationfailed.load() << "\n");
   }
   if (debugStats_NullNormal)
   {
-    vtkDebugMacro(<< "NullNormal " << debugStats_NullNormal << "\n");
+    vtkDebugMacro(<< "NullNormal " << debugStats_NullNormal.load() << "\n");
   }
   if (debugStats_NoInterfaceFound)
   {
-    vtkDebugMacro(<< "NoInterfaceFound " << debugStats_NoInterfaceFound << "\n");
+    vtkDebugMacro(<< "NoInterfaceFound " << debugStats_NoInterfaceFound.load() << "\n");
   }
   // Build final composite output. also tagging blocks with their associated Id
   vtkDebugMacro(<< this->NumberOfDomains << " Domains, " << nmat << " Materials\n");
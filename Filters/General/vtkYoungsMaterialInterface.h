@@ -11,6 +11,10 @@
  * the material volume correctness. for 2D meshes, the AxisSymetric flag allows to switch between a
  * pure 2D (planar) algorithm and an axis symmetric 2D algorithm handling volumes of revolution.
  *
+ * The cells of each block are processed in parallel with vtkSMPTools, by batches of consecutive
+ * cells. The outputs of the batches are concatenated in the order of the cells, so that the output
+ * does not depend on the number of threads.
+ *
  * @par Thanks:
  * This file is part of the generalized Youngs material interface reconstruction algorithm
  * contributed by <br> CEA/DIF - Commissariat a l'Energie Atomique, Centre DAM Ile-De-France <br>
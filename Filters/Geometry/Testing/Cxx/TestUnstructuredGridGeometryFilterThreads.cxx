@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the threaded extraction of the faces of vtkUnstructuredGridGeometryFilter
+// does not depend on the number of threads, for linear, quadratic and higher
+// order cells, and that it only extracts the faces on the boundary.
+
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkCellTypes.h"
+#include "vtkIdList.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridGeometryFilter.h"
+
+#include <cstdlib>
+
+namespace
+{
+// The faces of the blocks all lie on the sides of their bounding box.
+bool OnBoundingBox(vtkUnstructuredGrid* output, const double bounds[6])
+{
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    output->GetCellPoints(cellId, pts);
+    for (vtkIdType i = 0; i < pts->GetNumberOfIds(); ++i)
+    {
+      double p[3];
+      output->GetPoint(pts->GetId(i), p);
+      bool onSide = false;
+      for (int j = 0; j < 3; ++j)
+      {
+        onSide |= p[j] == bounds[2 * j] || p[j] == bounds[2 * j + 1];
+      }
+      if (!onSide)
+      {
+        vtkLog(ERROR, "Face " << cellId << " is inside the blocks.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestUnstructuredGridGeometryFilterThreads(int, char*[])
+{
+  const int cellTypes[] = { VTK_TETRA, VTK_HEXAHEDRON, VTK_VOXEL, VTK_WEDGE, VTK_PYRAMID,
+    VTK_HEXAGONAL_PRISM, VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON,
+    VTK_TRIQUADRATIC_HEXAHEDRON, VTK_QUADRATIC_WEDGE, VTK_QUADRATIC_PYRAMID,
+    VTK_LAGRANGE_TETRAHEDRON, VTK_LAGRANGE_HEXAHEDRON, VTK_LAGRANGE_WEDGE, VTK_BEZIER_HEXAHEDRON,
+    VTK_QUADRATIC_TRIANGLE };
+
+  bool success = true;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(4, 4, 4);
+
+    for (int configuration = 0; configuration < 4; ++configuration)
+    {
+      vtkNew<vtkUnstructuredGridGeometryFilter> filter;
+      filter->SetInputConnection(source->GetOutputPort());
+      filter->SetMerging(configuration % 2);
+      filter->SetMatchBoundariesIgnoringCellOrder(configuration / 2);
+      filter->PassThroughPointIdsOn();
+      filter->PassThroughCellIdsOn();
+
+      vtkNew<vtkUnstructuredGrid> output;
+      // Hexagonal prisms do not fill their blocks.
+      if (!vtkTestUtilities::CompareThreadedOutputs(filter, 4, output) ||
+        output->GetNumberOfCells() == 0 ||
+        (cellType != VTK_HEXAGONAL_PRISM &&
+          !::OnBoundingBox(output, source->GetOutput()->GetBounds())))
+      {
+        vtkLog(ERROR,
+          "Faces of " << vtkCellTypes::GetClassNameFromTypeId(cellType)
+                      << " are wrong or differ with 1 and 4 threads, configuration "
+                      << configuration);
+        success = false;
+      }
+
+      // 6 sides of 4 x 4 blocks.
+      const bool hexahedral = cellType == VTK_HEXAHEDRON || cellType == VTK_VOXEL ||
+        cellType == VTK_QUADRATIC_HEXAHEDRON || cellType == VTK_TRIQUADRATIC_HEXAHEDRON ||
+        cellType == VTK_LAGRANGE_HEXAHEDRON || cellType == VTK_BEZIER_HEXAHEDRON;
+      if (hexahedral && output->GetNumberOfCells() != 96)
+      {
+        vtkLog(ERROR,
+          "Expected 96 faces for " << vtkCellTypes::GetClassNameFromTypeId(cellType) << ", got "
+                                   << output->GetNumberOfCells());
+        success = false;
+      }
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
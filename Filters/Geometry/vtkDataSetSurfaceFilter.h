@@ -25,6 +25,10 @@
  * vtkGeometryFilter will delegate to vtkDataSetSurfaceFilter when it
  * encounters nonlinear cells.)
  *
+ * The faces of the nonlinear 3D cells are extracted by
+ * vtkUnstructuredGridGeometryFilter before the subdivision, which is threaded
+ * for vtkUnstructuredGrid inputs.
+ *
  * @section FastMode Fast Mode
  *
  * vtkDataSetSurfaceFilter is sometimes used to simply render a 3D
@@ -37,6 +37,8 @@
 #include "vtkQuadraticPyramid.h"
 #include "vtkQuadraticTetra.h"
 #include "vtkQuadraticWedge.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -48,7 +50,9 @@
 #include "vtkVoxel.h"
 #include "vtkWedge.h"
 
+#include <algorithm>
 #include <cassert>
+#include <map>
 #include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -367,132 +371,289 @@ public:
 };
 
 //------------------------------------------------------------------------------
-// Hashtable of surfels.
+// Hashing of the faces, shared by the hashtable of surfels and by the threaded
+// extraction of the faces of a vtkUnstructuredGrid.
 const int VTK_HASH_PRIME = 31;
-class vtkHashTableOfSurfels
+
+namespace
 {
-public:
-  // Constructor for the number of points in the dataset and an initialized
-  // pool.
-  // \pre positive_number: numberOfPoints>0
-  // \pre pool_exists: pool!=0
-  // \pre initialized_pool: pool->IsInitialized()
-  vtkHashTableOfSurfels(int numberOfPoints, vtkPoolManager<vtkSurfel>* pool)
-    : HashTable(numberOfPoints)
+// Properties of a face used to compute its hash key and to compare it with
+// the other faces of the same key.
+struct vtkFaceHash
+{
+  vtkIdType TypeUsedToHash;
+  int NumberOfCornerPoints;
+  // Index of the corner point used to compute the key, and its point Id.
+  int SmallestIdx;
+  vtkIdType SmallestId;
+};
+
+//------------------------------------------------------------------------------
+// Compute the hashing properties of a face defined by its cell type
+// 'faceType', its number of points and its list of points.
+// \pre positive number of points
+vtkFaceHash ComputeFaceHash(vtkIdType faceType, int numberOfPoints, const vtkIdType* points,
+  int matchBoundariesIgnoringCellOrder)
+{
+  assert("pre: positive number of points" && numberOfPoints >= 0);
+
+  vtkFaceHash hash;
+  hash.TypeUsedToHash = faceType;
+  switch (faceType)
   {
-    assert("pre: positive_number" && numberOfPoints > 0);
-    assert("pre: pool_exists" && pool != nullptr);
-    assert("pre: initialized_pool" && pool->IsInitialized());
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_BIQUADRATIC_TRIANGLE:
+    case VTK_LAGRANGE_TRIANGLE:
+    case VTK_BEZIER_TRIANGLE:
+      if (matchBoundariesIgnoringCellOrder)
+      {
+        hash.TypeUsedToHash = VTK_TRIANGLE;
+      }
+      hash.NumberOfCornerPoints = 3;
+      break;
+    case VTK_QUADRATIC_QUAD:
+    case VTK_QUADRATIC_LINEAR_QUAD:
+    case VTK_BIQUADRATIC_QUAD:
+    case VTK_LAGRANGE_QUADRILATERAL:
+    case VTK_BEZIER_QUADRILATERAL:
+      if (matchBoundariesIgnoringCellOrder)
+      {
+        hash.TypeUsedToHash = VTK_QUAD;
+      }
+      hash.NumberOfCornerPoints = 4;
+      break;
+    default:
+      hash.NumberOfCornerPoints = numberOfPoints;
+      break;
+  }
 
-    this->Pool = pool;
-    int i = 0;
-    int c = numberOfPoints;
-    while (i < c)
+  // Compute the smallest id among the corner points.
+  int smallestIdx = 0;
+  bool isPointIdUnique = true;
+  vtkIdType smallestId = points[smallestIdx];
+  for (int i = 1; i < hash.NumberOfCornerPoints; ++i)
+  {
+    if (points[i] < smallestId)
     {
-      this->HashTable[i] = nullptr;
-      ++i;
+      smallestIdx = i;
+      smallestId = points[i];
+      isPointIdUnique = true;
+    }
+    else if (points[i] == smallestId)
+    {
+      isPointIdUnique = false;
     }
   }
-  std::vector<vtkSurfel*> HashTable;
 
-  // Add faces of cell type FaceType
-  template <typename CellType, int FirstFace, int LastFace, int NumPoints, int FaceType>
-  void InsertFaces(vtkIdType* pts, vtkIdType cellId, int MatchBoundariesIgnoringCellOrder)
+  // If smallestId is not unique, the cell is degenerated. smallestId can't be used for the key as
+  // its index won't be unique. So we look for the smallest unique id.
+  if (!isPointIdUnique && hash.NumberOfCornerPoints > 2)
   {
-    vtkIdType points[NumPoints];
-    for (int face = FirstFace; face < LastFace; ++face)
+    std::map<int, std::pair<int, int>> occurrences; // map<pointId, pair<count, index>>
+    for (int i = 0; i < hash.NumberOfCornerPoints; ++i)
     {
-      const vtkIdType* faceIndices = CellType::GetFaceArray(face);
-      for (int pt = 0; pt < NumPoints; ++pt)
+      occurrences[points[i]].first++;
+      occurrences[points[i]].second = i;
+    }
+    for (const auto& idx_count : occurrences)
+    {
+      if (idx_count.second.first == 1) // Smallest unique
       {
-        points[pt] = pts[faceIndices[pt]];
+        smallestIdx = idx_count.second.second;
+        smallestId = idx_count.first;
+        break;
       }
-      int degrees[2]{ 0, 0 };
-      this->InsertFace(
-        cellId, FaceType, NumPoints, points, degrees, MatchBoundariesIgnoringCellOrder);
     }
   }
+  hash.SmallestIdx = smallestIdx;
+  hash.SmallestId = smallestId;
+  return hash;
+}
 
-  // Add a face defined by its cell type 'faceType', its number of points,
-  // its list of points and the cellId of the 3D cell it belongs to.
-  // \pre positive number of points
+//------------------------------------------------------------------------------
+// Compute the hashkey/code of a face for a table of size 'tableSize'.
+size_t ComputeFaceKey(const vtkFaceHash& hash, size_t tableSize)
+{
+  return (hash.TypeUsedToHash * VTK_HASH_PRIME + hash.SmallestId) % tableSize;
+}
 
-  void InsertFace(vtkIdType cellId, vtkIdType faceType, int numberOfPoints, const vtkIdType* points,
-    int degrees[2], int matchBoundariesIgnoringCellOrder)
-  {
-    assert("pre: positive number of points" && numberOfPoints >= 0);
+//------------------------------------------------------------------------------
+// Return whether a face, given by its type, its points and its hashing
+// properties, is the same as a surfel with the same hashkey, i.e. whether
+// the face is shared by the 3D cell of the surfel and by another 3D cell.
+bool IsSameFace(vtkIdType surfelType, vtkIdType surfelNumberOfPoints,
+  const vtkIdType* surfelPoints, vtkIdType surfelSmallestIdx, vtkIdType faceType,
+  int numberOfPoints, const vtkIdType* points, const vtkFaceHash& hash,
+  int matchBoundariesIgnoringCellOrder)
+{
+  const vtkIdType faceTypeUsedToHash = hash.TypeUsedToHash;
+  const int numberOfCornerPoints = hash.NumberOfCornerPoints;
+  const int smallestIdx = hash.SmallestIdx;
 
-    int numberOfCornerPoints;
-    vtkIdType faceTypeUsedToHash = faceType;
-    switch (faceType)
+  int found;
+  if (!matchBoundariesIgnoringCellOrder)
+  {
+    found = surfelType == faceTypeUsedToHash;
+  }
+  else
+  {
+    // vtkSurfel stores the cell type with the highest order.
+    // so we need to found its linear counterpart before comparing to faceTypeUsedToHash
+    switch (surfelType)
     {
+      case VTK_TRIANGLE:
       case VTK_QUADRATIC_TRIANGLE:
       case VTK_BIQUADRATIC_TRIANGLE:
       case VTK_LAGRANGE_TRIANGLE:
       case VTK_BEZIER_TRIANGLE:
-        if (matchBoundariesIgnoringCellOrder)
-        {
-          faceTypeUsedToHash = VTK_TRIANGLE;
-        }
-        numberOfCornerPoints = 3;
+        found = (faceTypeUsedToHash == VTK_TRIANGLE);
         break;
+      case VTK_QUAD:
       case VTK_QUADRATIC_QUAD:
       case VTK_QUADRATIC_LINEAR_QUAD:
       case VTK_BIQUADRATIC_QUAD:
       case VTK_LAGRANGE_QUADRILATERAL:
       case VTK_BEZIER_QUADRILATERAL:
-        if (matchBoundariesIgnoringCellOrder)
-        {
-          faceTypeUsedToHash = VTK_QUAD;
-        }
-        numberOfCornerPoints = 4;
+        found = (faceTypeUsedToHash == VTK_QUAD);
         break;
       default:
-        numberOfCornerPoints = numberOfPoints;
-        break;
+        // Linear faces without higher order counterpart: pixels and polygons
+        found = surfelType == faceTypeUsedToHash;
     }
+  }
+  if (!found)
+  {
+    return false;
+  }
 
-    // Compute the smallest id among the corner points.
-    int smallestIdx = 0;
-    bool isPointIdUnique = true;
-    vtkIdType smallestId = points[smallestIdx];
-    for (int i = 1; i < numberOfCornerPoints; ++i)
-    {
-      if (points[i] < smallestId)
-      {
-        smallestIdx = i;
-        smallestId = points[i];
-        isPointIdUnique = true;
-      }
-      else if (points[i] == smallestId)
-      {
-        isPointIdUnique = false;
-      }
-    }
+  if ((faceTypeUsedToHash == VTK_QUADRATIC_LINEAR_QUAD) && (!matchBoundariesIgnoringCellOrder))
+  {
+    // weird case
+    // the following four combinations are equivalent
+    // 01 23, 45, smallestIdx=0, go->
+    // 10 32, 45, smallestIdx=1, go<-
+    // 23 01, 54, smallestIdx=2, go->
+    // 32 10, 54, smallestIdx=3, go<-
+
+    // if current=0 or 2, other face has to be 1 or 3
+    // if current=1 or 3, other face has to be 0 or 2
+    return (points[0] == surfelPoints[1] && points[1] == surfelPoints[0] &&
+             points[2] == surfelPoints[3] && points[3] == surfelPoints[2] &&
+             points[4] == surfelPoints[4] && points[5] == surfelPoints[5]) ||
+      (points[0] == surfelPoints[3] && points[1] == surfelPoints[2] &&
+        points[2] == surfelPoints[1] && points[3] == surfelPoints[0] &&
+        points[4] == surfelPoints[5] && points[5] == surfelPoints[4]);
+  }
+
+  // If the face is already from another cell. The first
+  // corner point with smallest id will match.
+
+  // The other corner points
+  // will be given in reverse order (opposite orientation)
+  int i = 1; // i = 0 is skipped because it corresponds to smallestId, and smallestId is
+             // already used to create a key that is already contained in the HashTable.
+  while (found && i < numberOfCornerPoints)
+  {
+    // we add numberOfPoints before modulo. Modulo does not work
+    // with negative values.
+    found = surfelPoints[(surfelSmallestIdx - i + numberOfCornerPoints) % numberOfCornerPoints] ==
+      points[(smallestIdx + i) % numberOfCornerPoints];
+    ++i;
+  }
 
-    // If smallestId is not unique, the cell is degenerated. smallestId can't be used for the key as
-    // its index won't be unique. So we look for the smallest unique id.
-    if (!isPointIdUnique && numberOfCornerPoints > 2)
+  // Check for other kind of points for nonlinear faces.
+  if (found && (!matchBoundariesIgnoringCellOrder))
+  {
+    switch (faceType)
     {
-      std::map<int, std::pair<int, int>> occurrences; // map<pointId, pair<count, index>>
-      for (int i = 0; i < numberOfCornerPoints; ++i)
-      {
-        occurrences[points[i]].first++;
-        occurrences[points[i]].second = i;
-      }
-      for (const auto& idx_count : occurrences)
-      {
-        if (idx_count.second.first == 1) // Smallest unique
+      case VTK_QUADRATIC_TRIANGLE:
+      case VTK_QUADRATIC_QUAD:
+        // the mid-edge points
+        i = 0;
+        while (found && i < numberOfCornerPoints)
         {
-          smallestIdx = idx_count.second.second;
-          smallestId = idx_count.first;
-          break;
+          // we add numberOfPoints before modulo. Modulo does not work
+          // with negative values.
+          // -1: start at the end in reverse order.
+          found = surfelPoints[numberOfCornerPoints +
+                    ((surfelSmallestIdx - i + numberOfCornerPoints - 1) % numberOfCornerPoints)] ==
+            points[numberOfCornerPoints + ((smallestIdx + i) % numberOfCornerPoints)];
+          ++i;
         }
-      }
+        break;
+      case VTK_BIQUADRATIC_TRIANGLE:
+      case VTK_BIQUADRATIC_QUAD:
+        // the center point
+        found = surfelPoints[numberOfPoints - 1] == points[numberOfPoints - 1];
+
+        // the mid-edge points
+        i = 0;
+        while (found && i < numberOfCornerPoints)
+        {
+          // we add numberOfPoints before modulo. Modulo does not work
+          // with negative values.
+          // -1: start at the end in reverse order.
+          found = surfelPoints[numberOfCornerPoints +
+                    ((surfelSmallestIdx - i + numberOfCornerPoints - 1) % numberOfCornerPoints)] ==
+            points[numberOfCornerPoints + ((smallestIdx + i) % numberOfCornerPoints)];
+          ++i;
+        }
+        break;
+      case VTK_LAGRANGE_TRIANGLE:
+      case VTK_BEZIER_TRIANGLE:
+      case VTK_LAGRANGE_QUADRILATERAL:
+      case VTK_BEZIER_QUADRILATERAL:
+        found &= (surfelNumberOfPoints == numberOfPoints);
+        // TODO: Compare all higher order points.
+        break;
+      default: // other faces are linear: we are done.
+        break;
     }
+  }
+  return found != 0;
+}
+}
 
-    // Compute the hashkey/code
-    size_t key = (faceTypeUsedToHash * VTK_HASH_PRIME + smallestId) % (this->HashTable.size());
+//------------------------------------------------------------------------------
+// Hashtable of surfels.
+class vtkHashTableOfSurfels
+{
+public:
+  // Constructor for the number of points in the dataset and an initialized
+  // pool.
+  // \pre positive_number: numberOfPoints>0
+  // \pre pool_exists: pool!=0
+  // \pre initialized_pool: pool->IsInitialized()
+  vtkHashTableOfSurfels(int numberOfPoints, vtkPoolManager<vtkSurfel>* pool)
+    : HashTable(numberOfPoints)
+  {
+    assert("pre: positive_number" && numberOfPoints > 0);
+    assert("pre: pool_exists" && pool != nullptr);
+    assert("pre: initialized_pool" && pool->IsInitialized());
+
+    this->Pool = pool;
+    int i = 0;
+    int c = numberOfPoints;
+    while (i < c)
+    {
+      this->HashTable[i] = nullptr;
+      ++i;
+    }
+  }
+  std::vector<vtkSurfel*> HashTable;
+
+  // Add a face defined by its cell type 'faceType', its number of points,
+  // its list of points and the cellId of the 3D cell it belongs to.
+  // \pre positive number of points
+
+  void InsertFace(vtkIdType cellId, vtkIdType faceType, int numberOfPoints, const vtkIdType* points,
+    const int degrees[2], int matchBoundariesIgnoringCellOrder)
+  {
+    assert("pre: positive number of points" && numberOfPoints >= 0);
+
+    vtkFaceHash hash =
+      ComputeFaceHash(faceType, numberOfPoints, points, matchBoundariesIgnoringCellOrder);
+    size_t key = ComputeFaceKey(hash, this->HashTable.size());
 
     // Get the list at this key (several not equal faces can share the
     // same hashcode). This is the first element in the list.
@@ -508,132 +669,14 @@ public:
     }
     else
     {
-      int found = 0;
+      bool found = false;
       vtkSurfel* current = first;
       vtkSurfel* previous = current;
       while (!found && current != nullptr)
       {
-        if (!matchBoundariesIgnoringCellOrder)
-        {
-          found = current->Type == faceTypeUsedToHash;
-        }
-        else
-        {
-          // vtkSurfel stores the cell type with the highest order.
-          // so we need to found its linear counterpart before comparing to faceTypeUsedToHash
-          switch (current->Type)
-          {
-            case VTK_TRIANGLE:
-            case VTK_QUADRATIC_TRIANGLE:
-            case VTK_BIQUADRATIC_TRIANGLE:
-            case VTK_LAGRANGE_TRIANGLE:
-            case VTK_BEZIER_TRIANGLE:
-              found = (faceTypeUsedToHash == VTK_TRIANGLE);
-              break;
-            case VTK_QUAD:
-            case VTK_QUADRATIC_QUAD:
-            case VTK_QUADRATIC_LINEAR_QUAD:
-            case VTK_BIQUADRATIC_QUAD:
-            case VTK_LAGRANGE_QUADRILATERAL:
-            case VTK_BEZIER_QUADRILATERAL:
-              found = (faceTypeUsedToHash == VTK_QUAD);
-              break;
-            default:
-              found = 0;
-          }
-        }
-        if (found)
-        {
-          if ((faceTypeUsedToHash == VTK_QUADRATIC_LINEAR_QUAD) &&
-            (!matchBoundariesIgnoringCellOrder))
-          {
-            // weird case
-            // the following four combinations are equivalent
-            // 01 23, 45, smallestIdx=0, go->
-            // 10 32, 45, smallestIdx=1, go<-
-            // 23 01, 54, smallestIdx=2, go->
-            // 32 10, 54, smallestIdx=3, go<-
-
-            // if current=0 or 2, other face has to be 1 or 3
-            // if current=1 or 3, other face has to be 0 or 2
-            found = (points[0] == current->Points[1] && points[1] == current->Points[0] &&
-                      points[2] == current->Points[3] && points[3] == current->Points[2] &&
-                      points[4] == current->Points[4] && points[5] == current->Points[5]) ||
-              (points[0] == current->Points[3] && points[1] == current->Points[2] &&
-                points[2] == current->Points[1] && points[3] == current->Points[0] &&
-                points[4] == current->Points[5] && points[5] == current->Points[4]);
-          }
-          else
-          {
-            // If the face is already from another cell. The first
-            // corner point with smallest id will match.
-
-            // The other corner points
-            // will be given in reverse order (opposite orientation)
-            int i = 1; // i = 0 is skipped because it corresponds to smallestId, and smallestId is
-                       // already used to create a key that is already contained in the HashTable.
-            while (found && i < numberOfCornerPoints)
-            {
-              // we add numberOfPoints before modulo. Modulo does not work
-              // with negative values.
-              found = current->Points[(current->SmallestIdx - i + numberOfCornerPoints) %
-                        numberOfCornerPoints] == points[(smallestIdx + i) % numberOfCornerPoints];
-              ++i;
-            }
-
-            // Check for other kind of points for nonlinear faces.
-            if (found && (!matchBoundariesIgnoringCellOrder))
-            {
-              switch (faceType)
-              {
-                case VTK_QUADRATIC_TRIANGLE:
-                case VTK_QUADRATIC_QUAD:
-                  // the mid-edge points
-                  i = 0;
-                  while (found && i < numberOfCornerPoints)
-                  {
-                    // we add numberOfPoints before modulo. Modulo does not work
-                    // with negative values.
-                    // -1: start at the end in reverse order.
-                    found = current->Points[numberOfCornerPoints +
-                              ((current->SmallestIdx - i + numberOfCornerPoints - 1) %
-                                numberOfCornerPoints)] ==
-                      points[numberOfCornerPoints + ((smallestIdx + i) % numberOfCornerPoints)];
-                    ++i;
-                  }
-                  break;
-                case VTK_BIQUADRATIC_TRIANGLE:
-                case VTK_BIQUADRATIC_QUAD:
-                  // the center point
-                  found = current->Points[numberOfPoints - 1] == points[numberOfPoints - 1];
-
-                  // the mid-edge points
-                  i = 0;
-                  while (found && i < numberOfCornerPoints)
-                  {
-                    // we add numberOfPoints before modulo. Modulo does not work
-                    // with negative values.
-                    // -1: start at the end in reverse order.
-                    found = current->Points[numberOfCornerPoints +
-                              ((current->SmallestIdx - i + numberOfCornerPoints - 1) %
-                                numberOfCornerPoints)] ==
-                      points[numberOfCornerPoints + ((smallestIdx + i) % numberOfCornerPoints)];
-                    ++i;
-                  }
-                  break;
-                case VTK_LAGRANGE_TRIANGLE:
-                case VTK_BEZIER_TRIANGLE:
-                case VTK_LAGRANGE_QUADRILATERAL:
-                case VTK_BEZIER_QUADRILATERAL:
-                  found &= (current->NumberOfPoints == numberOfPoints);
-                  // TODO: Compare all higher order points.
-                  break;
-                default: // other faces are linear: we are done.
-                  break;
-              }
-            }
-          }
-        }
+        found = IsSameFace(current->Type, current->NumberOfPoints, current->Points,
+          current->SmallestIdx, faceType, numberOfPoints, points, hash,
+          matchBoundariesIgnoringCellOrder);
         previous = current;
         current = current->Next;
       }
@@ -656,7 +699,7 @@ public:
       surfel->Type = faceType;
       surfel->NumberOfPoints = numberOfPoints;
       surfel->Points = new vtkIdType[numberOfPoints];
-      surfel->SmallestIdx = smallestIdx;
+      surfel->SmallestIdx = hash.SmallestIdx;
       surfel->Cell3DId = cellId;
       for (int i = 0; i < numberOfPoints; ++i)
       {
@@ -757,6 +800,243 @@ protected:
   int AtEnd;
 };
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Return whether a cell is not a 3D cell, i.e. whether it is just copied to
+// the output instead of having its faces hashed.
+bool IsCopiedCell(int cellType)
+{
+  return (cellType >= VTK_EMPTY_CELL && cellType <= VTK_QUAD) ||
+    (cellType >= VTK_QUADRATIC_EDGE && cellType <= VTK_QUADRATIC_QUAD) ||
+    (cellType == VTK_BIQUADRATIC_QUAD) || (cellType == VTK_QUADRATIC_LINEAR_QUAD) ||
+    (cellType == VTK_BIQUADRATIC_TRIANGLE) || (cellType == VTK_CUBIC_LINE) ||
+    (cellType == VTK_QUADRATIC_POLYGON) || (cellType == VTK_LAGRANGE_CURVE) ||
+    (cellType == VTK_LAGRANGE_QUADRILATERAL) || (cellType == VTK_LAGRANGE_TRIANGLE) ||
+    (cellType == VTK_BEZIER_CURVE) || (cellType == VTK_BEZIER_QUADRILATERAL) ||
+    (cellType == VTK_BEZIER_TRIANGLE);
+}
+
+//------------------------------------------------------------------------------
+// Pass the faces FirstFace to LastFace of a cell of type CellType, all of
+// type FaceType, to insertFace.
+template <typename CellType, int FirstFace, int LastFace, int NumPoints, int FaceType,
+  typename TInsertFace>
+void InsertFaces(TInsertFace& insertFace, const vtkIdType* pts, vtkIdType cellId)
+{
+  vtkIdType points[NumPoints];
+  const int degrees[2]{ 0, 0 };
+  for (int face = FirstFace; face < LastFace; ++face)
+  {
+    const vtkIdType* faceIndices = CellType::GetFaceArray(face);
+    for (int pt = 0; pt < NumPoints; ++pt)
+    {
+      points[pt] = pts[faceIndices[pt]];
+    }
+    insertFace(cellId, FaceType, NumPoints, points, degrees);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Pass all the faces of a 3D cell to insertFace, a functor taking the cell
+// id, the face type, its number of points, its points and its degrees.
+// 'faces' are the faces of the cell if it is a polyhedron, 'faceIds' is a
+// work list. Return false if the cell type is not supported.
+template <typename TInsertFace>
+bool InsertCellFaces(TInsertFace& insertFace, vtkIdType cellId, int cellType, vtkIdType npts,
+  const vtkIdType* pts, vtkCellArray* faces, vtkIdList* faceIds, vtkCellData* cd)
+{
+  switch (cellType)
+  {
+    case VTK_TETRA:
+      InsertFaces<vtkTetra, 0, 4, 3, VTK_TRIANGLE>(insertFace, pts, cellId);
+      break;
+    case VTK_VOXEL:
+      // note, faces are PIXEL not QUAD. We don't need to convert
+      //  to QUAD because PIXEL exist in an UnstructuredGrid.
+      InsertFaces<vtkVoxel, 0, 6, 4, VTK_PIXEL>(insertFace, pts, cellId);
+      break;
+    case VTK_HEXAHEDRON:
+      InsertFaces<vtkHexahedron, 0, 6, 4, VTK_QUAD>(insertFace, pts, cellId);
+      break;
+    case VTK_WEDGE:
+      InsertFaces<vtkWedge, 0, 2, 3, VTK_TRIANGLE>(insertFace, pts, cellId);
+      InsertFaces<vtkWedge, 2, 5, 4, VTK_QUAD>(insertFace, pts, cellId);
+      break;
+    case VTK_PYRAMID:
+      InsertFaces<vtkPyramid, 0, 1, 4, VTK_QUAD>(insertFace, pts, cellId);
+      InsertFaces<vtkPyramid, 1, 5, 3, VTK_TRIANGLE>(insertFace, pts, cellId);
+      break;
+    case VTK_PENTAGONAL_PRISM:
+      InsertFaces<vtkPentagonalPrism, 0, 2, 5, VTK_POLYGON>(insertFace, pts, cellId);
+      InsertFaces<vtkPentagonalPrism, 2, 7, 4, VTK_QUAD>(insertFace, pts, cellId);
+      break;
+    case VTK_HEXAGONAL_PRISM:
+      InsertFaces<vtkHexagonalPrism, 0, 2, 6, VTK_POLYGON>(insertFace, pts, cellId);
+      InsertFaces<vtkHexagonalPrism, 2, 8, 4, VTK_QUAD>(insertFace, pts, cellId);
+      break;
+    case VTK_QUADRATIC_TETRA:
+      InsertFaces<vtkQuadraticTetra, 0, 4, 6, VTK_QUADRATIC_TRIANGLE>(insertFace, pts, cellId);
+      break;
+    case VTK_QUADRATIC_HEXAHEDRON:
+      InsertFaces<vtkQuadraticHexahedron, 0, 6, 8, VTK_QUADRATIC_QUAD>(insertFace, pts, cellId);
+      break;
+    case VTK_QUADRATIC_WEDGE:
+      InsertFaces<vtkQuadraticWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(insertFace, pts, cellId);
+      InsertFaces<vtkQuadraticWedge, 2, 5, 8, VTK_QUADRATIC_QUAD>(insertFace, pts, cellId);
+      break;
+    case VTK_QUADRATIC_PYRAMID:
+      InsertFaces<vtkQuadraticPyramid, 0, 1, 8, VTK_QUADRATIC_QUAD>(insertFace, pts, cellId);
+      InsertFaces<vtkQuadraticPyramid, 1, 5, 6, VTK_QUADRATIC_TRIANGLE>(insertFace, pts, cellId);
+      break;
+    case VTK_TRIQUADRATIC_PYRAMID:
+      InsertFaces<vtkTriQuadraticPyramid, 0, 1, 9, VTK_BIQUADRATIC_QUAD>(insertFace, pts, cellId);
+      InsertFaces<vtkTriQuadraticPyramid, 1, 5, 7, VTK_BIQUADRATIC_TRIANGLE>(
+        insertFace, pts, cellId);
+      break;
+    case VTK_TRIQUADRATIC_HEXAHEDRON:
+      InsertFaces<vtkTriQuadraticHexahedron, 0, 6, 9, VTK_BIQUADRATIC_QUAD>(
+        insertFace, pts, cellId);
+      break;
+    case VTK_QUADRATIC_LINEAR_WEDGE:
+      InsertFaces<vtkQuadraticLinearWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
+        insertFace, pts, cellId);
+      InsertFaces<vtkQuadraticLinearWedge, 2, 5, 6, VTK_QUADRATIC_LINEAR_QUAD>(
+        insertFace, pts, cellId);
+      break;
+    case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
+      InsertFaces<vtkBiQuadraticQuadraticWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
+        insertFace, pts, cellId);
+      InsertFaces<vtkBiQuadraticQuadraticWedge, 2, 5, 9, VTK_BIQUADRATIC_QUAD>(
+        insertFace, pts, cellId);
+      break;
+    case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
+      InsertFaces<vtkBiQuadraticQuadraticHexahedron, 0, 4, 9, VTK_BIQUADRATIC_QUAD>(
+        insertFace, pts, cellId);
+      InsertFaces<vtkBiQuadraticQuadraticHexahedron, 4, 6, 8, VTK_QUADRATIC_QUAD>(
+        insertFace, pts, cellId);
+      break;
+    case VTK_POLYHEDRON:
+    {
+      const int degrees[2]{ 0, 0 };
+      for (vtkIdType face = 0; face < faces->GetNumberOfCells(); ++face)
+      {
+        vtkIdType nFacePts;
+        const vtkIdType* fptr;
+        faces->GetCellAtId(face, nFacePts, fptr, faceIds);
+        insertFace(cellId, VTK_POLYGON, static_cast<int>(nFacePts), fptr, degrees);
+      }
+      break;
+    }
+    case VTK_LAGRANGE_HEXAHEDRON:
+    case VTK_BEZIER_HEXAHEDRON:
+    {
+      int order[4];
+      int faceOrder[2];
+      vtkHigherOrderHexahedron::SetOrderFromCellData(cd, npts, cellId, order);
+      vtkIdType nPoints = 0;
+      std::vector<vtkIdType> points;
+      const auto set_number_of_ids_and_points = [&](const vtkIdType& numFacePoints) -> void {
+        points.resize(numFacePoints);
+        nPoints = numFacePoints;
+      };
+      const auto set_ids_and_points = [&](const vtkIdType& face_id,
+                                        const vtkIdType& vol_id) -> void {
+        points[face_id] = pts[vol_id];
+      };
+
+      int faceCellType = (cellType == VTK_LAGRANGE_HEXAHEDRON) ? VTK_LAGRANGE_QUADRILATERAL
+                                                               : VTK_BEZIER_QUADRILATERAL;
+      for (int faceId = 0; faceId < 6; ++faceId)
+      {
+        vtkHigherOrderHexahedron::SetFaceIdsAndPoints(
+          faceId, order, set_number_of_ids_and_points, set_ids_and_points, faceOrder);
+        insertFace(cellId, faceCellType, static_cast<int>(nPoints), points.data(), faceOrder);
+      }
+      break;
+    }
+    case VTK_BEZIER_TETRAHEDRON:
+    case VTK_LAGRANGE_TETRAHEDRON:
+    {
+      vtkIdType order = vtkHigherOrderTetra::ComputeOrder(npts);
+      const int faceOrder[2] = { 0, 0 };
+      vtkIdType nPoints = 0;
+      std::vector<vtkIdType> points;
+      const auto set_number_of_ids_and_points = [&](const vtkIdType& numFacePoints) -> void {
+        points.resize(numFacePoints);
+        nPoints = numFacePoints;
+      };
+      const auto set_ids_and_points = [&](const vtkIdType& face_id,
+                                        const vtkIdType& vol_id) -> void {
+        points[face_id] = pts[vol_id];
+      };
+
+      int faceCellType =
+        (cellType == VTK_LAGRANGE_TETRAHEDRON) ? VTK_LAGRANGE_TRIANGLE : VTK_BEZIER_TRIANGLE;
+      for (int faceId = 0; faceId < 4; ++faceId)
+      {
+        vtkHigherOrderTetra::SetFaceIdsAndPoints(
+          faceId, order, npts, set_number_of_ids_and_points, set_ids_and_points);
+        insertFace(cellId, faceCellType, static_cast<int>(nPoints), points.data(), faceOrder);
+      }
+      break;
+    }
+    case VTK_LAGRANGE_WEDGE:
+    case VTK_BEZIER_WEDGE:
+    {
+      int order[4];
+      int faceOrder[2] = { 0, 0 };
+      vtkHigherOrderWedge::SetOrderFromCellData(cd, npts, cellId, order);
+      vtkIdType nPoints = 0;
+      std::vector<vtkIdType> points;
+      const auto set_number_of_ids_and_points = [&](const vtkIdType& numFacePoints) -> void {
+        points.resize(numFacePoints);
+        nPoints = numFacePoints;
+      };
+      const auto set_ids_and_points = [&](const vtkIdType& face_id,
+                                        const vtkIdType& vol_id) -> void {
+        points[face_id] = pts[vol_id];
+      };
+
+      int faceCellType =
+        (cellType == VTK_LAGRANGE_WEDGE) ? VTK_LAGRANGE_TRIANGLE : VTK_BEZIER_TRIANGLE;
+      for (int faceId = 0; faceId < 2; ++faceId)
+      {
+        vtkHigherOrderWedge::GetTriangularFace(
+          faceId, order, set_number_of_ids_and_points, set_ids_and_points);
+        insertFace(cellId, faceCellType, static_cast<int>(nPoints), points.data(), faceOrder);
+      }
+      faceCellType = (cellType == VTK_LAGRANGE_WEDGE) ? VTK_LAGRANGE_QUADRILATERAL
+                                                      : VTK_BEZIER_QUADRILATERAL;
+      for (int faceId = 2; faceId < 5; ++faceId)
+      {
+        vtkHigherOrderWedge::GetQuadrilateralFace(
+          faceId, order, set_number_of_ids_and_points, set_ids_and_points, faceOrder);
+        insertFace(cellId, faceCellType, static_cast<int>(nPoints), points.data(), faceOrder);
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Face of a 3D cell gathered by the threaded extraction. Its points are
+// stored in a separate array, starting at PointsOffset.
+struct vtkCellFace
+{
+  vtkIdType Key;
+  vtkIdType Cell3DId;
+  vtkIdType Type;
+  vtkIdType PointsOffset;
+  int NumberOfPoints;
+  int SmallestIdx;
+  int Degrees[2];
+};
+}
+
 //------------------------------------------------------------------------------
 // Construct with all types of clipping turned off.
 vtkUnstructuredGridGeometryFilter::vtkUnstructuredGridGeometryFilter()
@@ -994,380 +1274,364 @@ int vtkUnstructuredGridGeometryFilter::RequestData(vtkInformation* vtkNotUsed(re
     }
   }
 
-  // Traverse cells to extract geometry
-  int progressCount = 0;
-  bool abort = false;
-  vtkIdType progressInterval = numCells / 20 + 1;
-
-  vtkPoolManager<vtkSurfel>* pool = new vtkPoolManager<vtkSurfel>;
-  pool->Init();
-  this->HashTable = new vtkHashTableOfSurfels(numPts, pool);
-
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal() && !abort;
-       cellIter->GoToNextCell())
-  {
-    vtkIdType cellId = cellIter->GetCellId();
-    // Progress and abort method support
-    if (progressCount >= progressInterval)
+  // Insert a cell that is not 3D, or a boundary face of a 3D cell, with its
+  // points and its data.
+  auto insertCell = [&](int cellType, vtkIdType npts, const vtkIdType* pts, vtkIdType cellId) {
+    cellIds->Reset();
+    if (this->Merging)
     {
-      vtkDebugMacro(<< "Process cell #" << cellId);
-      this->UpdateProgress((double)cellId / numCells);
-      abort = this->CheckAbort();
-      progressCount = 0;
-    }
-    progressCount++;
-
-    vtkIdType npts = cellIter->GetNumberOfPoints();
-    vtkIdType* pts = cellIter->GetPointIds()->GetPointer(0);
-    if (allVisible || cellVis[cellId])
-    {
-      int cellType = cellIter->GetCellType();
-      if ((cellType >= VTK_EMPTY_CELL && cellType <= VTK_QUAD) ||
-        (cellType >= VTK_QUADRATIC_EDGE && cellType <= VTK_QUADRATIC_QUAD) ||
-        (cellType == VTK_BIQUADRATIC_QUAD) || (cellType == VTK_QUADRATIC_LINEAR_QUAD) ||
-        (cellType == VTK_BIQUADRATIC_TRIANGLE) || (cellType == VTK_CUBIC_LINE) ||
-        (cellType == VTK_QUADRATIC_POLYGON) || (cellType == VTK_LAGRANGE_CURVE) ||
-        (cellType == VTK_LAGRANGE_QUADRILATERAL) || (cellType == VTK_LAGRANGE_TRIANGLE) ||
-        (cellType == VTK_BEZIER_CURVE) || (cellType == VTK_BEZIER_QUADRILATERAL) ||
-        (cellType == VTK_BEZIER_TRIANGLE))
+      double x[3];
+      for (int i = 0; i < npts; ++i)
       {
-        vtkDebugMacro(<< "not 3D cell. type=" << cellType);
-        // not 3D: just copy it
-        cellIds->Reset();
-        if (this->Merging)
+        vtkIdType ptId = pts[i];
+        input->GetPoint(ptId, x);
+        vtkIdType newPtId;
+        if (this->Locator->InsertUniquePoint(x, newPtId))
         {
-          double x[3];
-          for (int i = 0; i < npts; ++i)
+          outputPD->CopyData(pd, ptId, newPtId);
+          if (this->PassThroughPointIds)
           {
-            vtkIdType ptId = pts[i];
-            input->GetPoint(ptId, x);
-            vtkIdType newPtId;
-            if (this->Locator->InsertUniquePoint(x, newPtId))
-            {
-              outputPD->CopyData(pd, ptId, newPtId);
-              if (this->PassThroughPointIds)
-              {
-                originalPointIds->InsertValue(newPtId, ptId);
-              }
-            }
-            cellIds->InsertNextId(newPtId);
+            originalPointIds->InsertValue(newPtId, ptId);
           }
-        } // merging coincident points
-        else
+        }
+        cellIds->InsertNextId(newPtId);
+      }
+    } // merging coincident points
+    else
+    {
+      for (int i = 0; i < npts; ++i)
+      {
+        vtkIdType ptId = pts[i];
+        if (pointMap[ptId] < 0)
         {
-          for (int i = 0; i < npts; ++i)
+          vtkIdType newPtId = newPts->InsertNextPoint(inPts->GetPoint(ptId));
+          pointMap[ptId] = newPtId;
+          outputPD->CopyData(pd, ptId, newPtId);
+          if (this->PassThroughPointIds)
           {
-            vtkIdType ptId = pts[i];
-            if (pointMap[ptId] < 0)
-            {
-              vtkIdType newPtId = newPts->InsertNextPoint(inPts->GetPoint(ptId));
-              pointMap[ptId] = newPtId;
-              outputPD->CopyData(pd, ptId, newPtId);
-              if (this->PassThroughPointIds)
-              {
-                originalPointIds->InsertValue(newPtId, ptId);
-              }
-            }
-            cellIds->InsertNextId(pointMap[ptId]);
+            originalPointIds->InsertValue(newPtId, ptId);
           }
-        } // keeping original point list
+        }
+        cellIds->InsertNextId(pointMap[ptId]);
+      }
+    } // keeping original point list
+
+    vtkIdType newCellId = output->InsertNextCell(cellType, cellIds);
+    outputCD->CopyData(cd, cellId, newCellId);
+    if (this->PassThroughCellIds)
+    {
+      originalCellIds->InsertValue(newCellId, cellId);
+    }
+    return newCellId;
+  };
+
+  // Set the degrees of a boundary face.
+  auto setDegrees = [&](vtkIdType newCellId, const int degrees[2]) {
+    vtkDataArray* v = outputCD->GetHigherOrderDegrees();
+    if (v)
+    {
+      double faceDegrees[3];
+      faceDegrees[0] = degrees[0];
+      faceDegrees[1] = degrees[1];
+      faceDegrees[2] = 0;
+      v->SetTuple(newCellId, faceDegrees);
+    }
+  };
+
+  auto reportUnsupportedCell = [&](int cellType) {
+    vtkErrorMacro(<< "Cell type " << vtkCellTypes::GetClassNameFromTypeId(cellType) << "("
+                  << cellType << ")"
+                  << " is not a 3D cell.");
+  };
+
+  // Traverse cells to extract geometry
+  int progressCount = 0;
+  bool abort = false;
+  vtkIdType progressInterval = numCells / 20 + 1;
 
-        vtkIdType newCellId = output->InsertNextCell(cellType, cellIds);
-        outputCD->CopyData(cd, cellId, newCellId);
-        if (this->PassThroughCellIds)
+  vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid)
+  {
+    // The cells of a vtkUnstructuredGrid can be accessed from several threads.
+    // The faces of the 3D cells are gathered in parallel, grouped by hashkey
+    // and matched in parallel, key by key. Within a key, the faces are
+    // processed in the order the hashtable of surfels would process them, so
+    // that the output does not depend on the number of threads.
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+    vtkSMPThreadLocalObject<vtkIdList> tlFaceIds;
+    vtkSMPThreadLocalObject<vtkCellArray> tlFaces;
+    vtkCellData* inCD = input->GetCellData();
+    const int match = this->MatchBoundariesIgnoringCellOrder;
+
+    // Count the faces of the 3D cells and their points.
+    std::vector<vtkIdType> faceOffsets(numCells + 1, 0);
+    std::vector<vtkIdType> pointOffsets(numCells + 1, 0);
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdList* faceIds = tlFaceIds.Local();
+      vtkCellArray* faces = tlFaces.Local();
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
         {
-          originalCellIds->InsertValue(newCellId, cellId);
+          break;
+        }
+        int cellType = grid->GetCellType(cellId);
+        if (!(allVisible || cellVis[cellId]) || IsCopiedCell(cellType))
+        {
+          continue;
+        }
+        vtkIdType npts;
+        const vtkIdType* pts;
+        grid->GetCellPoints(cellId, npts, pts, cellPts);
+        if (cellType == VTK_POLYHEDRON)
+        {
+          grid->GetPolyhedronFaces(cellId, faces);
         }
+        vtkIdType numFaces = 0;
+        vtkIdType numFacePts = 0;
+        auto countFace = [&](vtkIdType, vtkIdType, int numberOfPoints, const vtkIdType*,
+                           const int*) {
+          ++numFaces;
+          numFacePts += numberOfPoints;
+        };
+        if (!InsertCellFaces(countFace, cellId, cellType, npts, pts, faces, faceIds, inCD))
+        {
+          // Reported below, in order.
+          numFaces = -1;
+        }
+        faceOffsets[cellId] = numFaces;
+        pointOffsets[cellId] = numFacePts;
+      }
+    });
+    abort = this->GetAbortOutput();
+
+    // Copy the cells that are not 3D, in order, and turn the counts into
+    // offsets.
+    vtkNew<vtkIdList> cellPts;
+    vtkIdType numFaces = 0;
+    vtkIdType numFacePts = 0;
+    for (vtkIdType cellId = 0; cellId < numCells && !abort; ++cellId)
+    {
+      // Progress and abort method support
+      if (progressCount >= progressInterval)
+      {
+        vtkDebugMacro(<< "Process cell #" << cellId);
+        this->UpdateProgress((double)cellId / numCells);
+        abort = this->CheckAbort();
+        progressCount = 0;
       }
-      else // added the faces to the hashtable
+      progressCount++;
+
+      int cellType = grid->GetCellType(cellId);
+      if ((allVisible || cellVis[cellId]) && IsCopiedCell(cellType))
       {
-        vtkDebugMacro(<< "3D cell. type=" << cellType);
-        switch (cellType)
+        vtkDebugMacro(<< "not 3D cell. type=" << cellType);
+        vtkIdType npts;
+        const vtkIdType* pts;
+        grid->GetCellPoints(cellId, npts, pts, cellPts);
+        insertCell(cellType, npts, pts, cellId);
+      }
+      else if (faceOffsets[cellId] < 0)
+      {
+        reportUnsupportedCell(cellType);
+        faceOffsets[cellId] = 0;
+      }
+      vtkIdType cellFaces = faceOffsets[cellId];
+      faceOffsets[cellId] = numFaces;
+      numFaces += cellFaces;
+      vtkIdType cellFacePts = pointOffsets[cellId];
+      pointOffsets[cellId] = numFacePts;
+      numFacePts += cellFacePts;
+    }
+    faceOffsets[numCells] = numFaces;
+    pointOffsets[numCells] = numFacePts;
+
+    // Gather the faces with their hashkeys.
+    std::vector<vtkCellFace> faces(abort ? 0 : numFaces);
+    std::vector<vtkIdType> facePoints(abort ? 0 : numFacePts);
+    if (!abort)
+    {
+      vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+        vtkIdList* cellPts = tlCellPts.Local();
+        vtkIdList* faceIds = tlFaceIds.Local();
+        vtkCellArray* polyFaces = tlFaces.Local();
+        for (vtkIdType cellId = begin; cellId < end; ++cellId)
         {
-          case VTK_TETRA:
-            this->HashTable->InsertFaces<vtkTetra, 0, 4, 3, VTK_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_VOXEL:
-            // note, faces are PIXEL not QUAD. We don't need to convert
-            //  to QUAD because PIXEL exist in an UnstructuredGrid.
-            this->HashTable->InsertFaces<vtkVoxel, 0, 6, 4, VTK_PIXEL>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_HEXAHEDRON:
-            this->HashTable->InsertFaces<vtkHexahedron, 0, 6, 4, VTK_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_WEDGE:
-            this->HashTable->InsertFaces<vtkWedge, 0, 2, 3, VTK_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkWedge, 2, 5, 4, VTK_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_PYRAMID:
-            this->HashTable->InsertFaces<vtkPyramid, 0, 1, 4, VTK_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkPyramid, 1, 5, 3, VTK_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_PENTAGONAL_PRISM:
-            this->HashTable->InsertFaces<vtkPentagonalPrism, 0, 2, 5, VTK_POLYGON>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkPentagonalPrism, 2, 7, 4, VTK_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_HEXAGONAL_PRISM:
-            this->HashTable->InsertFaces<vtkHexagonalPrism, 0, 2, 6, VTK_POLYGON>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkHexagonalPrism, 2, 8, 4, VTK_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_QUADRATIC_TETRA:
-            this->HashTable->InsertFaces<vtkQuadraticTetra, 0, 4, 6, VTK_QUADRATIC_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_QUADRATIC_HEXAHEDRON:
-            this->HashTable->InsertFaces<vtkQuadraticHexahedron, 0, 6, 8, VTK_QUADRATIC_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_QUADRATIC_WEDGE:
-            this->HashTable->InsertFaces<vtkQuadraticWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkQuadraticWedge, 2, 5, 8, VTK_QUADRATIC_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_QUADRATIC_PYRAMID:
-            this->HashTable->InsertFaces<vtkQuadraticPyramid, 0, 1, 8, VTK_QUADRATIC_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkQuadraticPyramid, 1, 5, 6, VTK_QUADRATIC_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_TRIQUADRATIC_PYRAMID:
-            this->HashTable->InsertFaces<vtkTriQuadraticPyramid, 0, 1, 9, VTK_BIQUADRATIC_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable->InsertFaces<vtkTriQuadraticPyramid, 1, 5, 7, VTK_BIQUADRATIC_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_TRIQUADRATIC_HEXAHEDRON:
-            this->HashTable->InsertFaces<vtkTriQuadraticHexahedron, 0, 6, 9, VTK_BIQUADRATIC_QUAD>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_QUADRATIC_LINEAR_WEDGE:
-            this->HashTable->InsertFaces<vtkQuadraticLinearWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
-              pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable
-              ->InsertFaces<vtkQuadraticLinearWedge, 2, 5, 6, VTK_QUADRATIC_LINEAR_QUAD>(
-                pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_BIQUADRATIC_QUADRATIC_WEDGE:
-            this->HashTable
-              ->InsertFaces<vtkBiQuadraticQuadraticWedge, 0, 2, 6, VTK_QUADRATIC_TRIANGLE>(
-                pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable
-              ->InsertFaces<vtkBiQuadraticQuadraticWedge, 2, 5, 9, VTK_BIQUADRATIC_QUAD>(
-                pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_BIQUADRATIC_QUADRATIC_HEXAHEDRON:
-            this->HashTable
-              ->InsertFaces<vtkBiQuadraticQuadraticHexahedron, 0, 4, 9, VTK_BIQUADRATIC_QUAD>(
-                pts, cellId, MatchBoundariesIgnoringCellOrder);
-            this->HashTable
-              ->InsertFaces<vtkBiQuadraticQuadraticHexahedron, 4, 6, 8, VTK_QUADRATIC_QUAD>(
-                pts, cellId, MatchBoundariesIgnoringCellOrder);
-            break;
-          case VTK_POLYHEDRON:
-          {
-            vtkCellArray* faces = cellIter->GetCellFaces();
-            int nFaces = cellIter->GetNumberOfFaces();
-            vtkNew<vtkIdList> tmpIds;
-            for (int face = 0; face < nFaces; ++face)
-            {
-              vtkIdType nFacePts;
-              const vtkIdType* fptr;
-              faces->GetCellAtId(face, nFacePts, fptr, tmpIds);
-              int pt = static_cast<int>(nFacePts);
-              int degrees[2]{ 0, 0 };
-              this->HashTable->InsertFace(
-                cellId, VTK_POLYGON, pt, fptr, degrees, MatchBoundariesIgnoringCellOrder);
-              fptr += pt;
-            }
-            break;
-          }
-          case VTK_LAGRANGE_HEXAHEDRON:
-          case VTK_BEZIER_HEXAHEDRON:
+          if (faceOffsets[cellId] == faceOffsets[cellId + 1])
           {
-            int order[4];
-            int faceOrder[2];
-            vtkHigherOrderHexahedron::SetOrderFromCellData(
-              input->GetCellData(), npts, cellId, order);
-            vtkIdType nPoints = 0;
-            std::vector<vtkIdType> points;
-            const auto set_number_of_ids_and_points = [&](const vtkIdType& numFacePoints) -> void {
-              points.resize(numFacePoints);
-              nPoints = numFacePoints;
-            };
-            const auto set_ids_and_points = [&](const vtkIdType& face_id,
-                                              const vtkIdType& vol_id) -> void {
-              points[face_id] = pts[vol_id];
-            };
-
-            int faceCellType = (cellType == VTK_LAGRANGE_HEXAHEDRON) ? VTK_LAGRANGE_QUADRILATERAL
-                                                                     : VTK_BEZIER_QUADRILATERAL;
-            for (int faceId = 0; faceId < 6; ++faceId)
-            {
-              vtkHigherOrderHexahedron::SetFaceIdsAndPoints(
-                faceId, order, set_number_of_ids_and_points, set_ids_and_points, faceOrder);
-              this->HashTable->InsertFace(cellId, faceCellType, nPoints, points.data(), faceOrder,
-                MatchBoundariesIgnoringCellOrder);
-            }
-            break;
+            continue;
           }
-          case VTK_BEZIER_TETRAHEDRON:
-          case VTK_LAGRANGE_TETRAHEDRON:
+          int cellType = grid->GetCellType(cellId);
+          vtkIdType npts;
+          const vtkIdType* pts;
+          grid->GetCellPoints(cellId, npts, pts, cellPts);
+          if (cellType == VTK_POLYHEDRON)
           {
-            vtkIdType order = vtkHigherOrderTetra::ComputeOrder(npts);
-            int faceOrder[2] = { 0, 0 };
-            vtkIdType nPoints = 0;
-            std::vector<vtkIdType> points;
-            const auto set_number_of_ids_and_points = [&](const vtkIdType& numFacePoints) -> void {
-              points.resize(numFacePoints);
-              nPoints = numFacePoints;
-            };
-            const auto set_ids_and_points = [&](const vtkIdType& face_id,
-                                              const vtkIdType& vol_id) -> void {
-              points[face_id] = pts[vol_id];
-            };
-
-            int faceCellType =
-              (cellType == VTK_LAGRANGE_TETRAHEDRON) ? VTK_LAGRANGE_TRIANGLE : VTK_BEZIER_TRIANGLE;
-            for (int faceId = 0; faceId < 4; ++faceId)
-            {
-              vtkHigherOrderTetra::SetFaceIdsAndPoints(
-                faceId, order, npts, set_number_of_ids_and_points, set_ids_and_points);
-              this->HashTable->InsertFace(cellId, faceCellType, nPoints, points.data(), faceOrder,
-                MatchBoundariesIgnoringCellOrder);
-            }
-            break;
+            grid->GetPolyhedronFaces(cellId, polyFaces);
           }
-          case VTK_LAGRANGE_WEDGE:
-          case VTK_BEZIER_WEDGE:
+          vtkIdType faceId = faceOffsets[cellId];
+          vtkIdType pointsOffset = pointOffsets[cellId];
+          auto addFace = [&](vtkIdType cell3DId, vtkIdType faceType, int numberOfPoints,
+                           const vtkIdType* points, const int* degrees) {
+            vtkFaceHash hash = ComputeFaceHash(faceType, numberOfPoints, points, match);
+            vtkCellFace& face = faces[faceId++];
+            face.Key = static_cast<vtkIdType>(ComputeFaceKey(hash, numPts));
+            face.Cell3DId = cell3DId;
+            face.Type = faceType;
+            face.PointsOffset = pointsOffset;
+            face.NumberOfPoints = numberOfPoints;
+            face.SmallestIdx = hash.SmallestIdx;
+            face.Degrees[0] = degrees[0];
+            face.Degrees[1] = degrees[1];
+            std::copy(points, points + numberOfPoints, facePoints.begin() + pointsOffset);
+            pointsOffset += numberOfPoints;
+          };
+          InsertCellFaces(addFace, cellId, cellType, npts, pts, polyFaces, faceIds, inCD);
+        }
+      });
+    }
+
+    // Group the faces by hashkey, keeping their order within a key.
+    std::vector<vtkIdType> keyOffsets(numFaces > 0 ? numPts + 1 : 1, 0);
+    for (const vtkCellFace& face : faces)
+    {
+      ++keyOffsets[face.Key + 1];
+    }
+    for (size_t key = 1; key < keyOffsets.size(); ++key)
+    {
+      keyOffsets[key] += keyOffsets[key - 1];
+    }
+    std::vector<vtkCellFace> sortedFaces(faces.size());
+    {
+      std::vector<vtkIdType> keyInsertion(keyOffsets.begin(), keyOffsets.end() - 1);
+      for (const vtkCellFace& face : faces)
+      {
+        sortedFaces[keyInsertion[face.Key]++] = face;
+      }
+    }
+    faces.clear();
+    faces.shrink_to_fit();
+
+    // Match the faces of each key: a face is a surfel unless it matches a
+    // previous surfel of its key, which is then no longer on the boundary.
+    // -1: the face matched a surfel, 0: surfel shared by several cells,
+    // 1: surfel on the dataset boundary.
+    std::vector<signed char> faceStatus(sortedFaces.size(), 1);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(keyOffsets.size() - 1),
+      [&](vtkIdType beginKey, vtkIdType endKey) {
+        for (vtkIdType key = beginKey; key < endKey; ++key)
+        {
+          for (vtkIdType i = keyOffsets[key]; i < keyOffsets[key + 1]; ++i)
           {
-            int order[4];
-            int faceOrder[2] = { 0, 0 };
-            vtkHigherOrderWedge::SetOrderFromCellData(input->GetCellData(), npts, cellId, order);
-            vtkIdType nPoints = 0;
-            std::vector<vtkIdType> points;
-            const auto set_number_of_ids_and_points = [&](const vtkIdType& numFacePoints) -> void {
-              points.resize(numFacePoints);
-              nPoints = numFacePoints;
-            };
-            const auto set_ids_and_points = [&](const vtkIdType& face_id,
-                                              const vtkIdType& vol_id) -> void {
-              points[face_id] = pts[vol_id];
-            };
-
-            int faceCellType =
-              (cellType == VTK_LAGRANGE_WEDGE) ? VTK_LAGRANGE_TRIANGLE : VTK_BEZIER_TRIANGLE;
-            for (int faceId = 0; faceId < 2; ++faceId)
-            {
-              vtkHigherOrderWedge::GetTriangularFace(
-                faceId, order, set_number_of_ids_and_points, set_ids_and_points);
-              this->HashTable->InsertFace(cellId, faceCellType, nPoints, points.data(), faceOrder,
-                MatchBoundariesIgnoringCellOrder);
-            }
-            faceCellType = (cellType == VTK_LAGRANGE_WEDGE) ? VTK_LAGRANGE_QUADRILATERAL
-                                                            : VTK_BEZIER_QUADRILATERAL;
-            for (int faceId = 2; faceId < 5; ++faceId)
+            const vtkCellFace& face = sortedFaces[i];
+            const vtkIdType* points = facePoints.data() + face.PointsOffset;
+            vtkFaceHash hash = ComputeFaceHash(face.Type, face.NumberOfPoints, points, match);
+            for (vtkIdType j = keyOffsets[key]; j < i; ++j)
             {
-              vtkHigherOrderWedge::GetQuadrilateralFace(
-                faceId, order, set_number_of_ids_and_points, set_ids_and_points, faceOrder);
-              this->HashTable->InsertFace(cellId, faceCellType, nPoints, points.data(), faceOrder,
-                MatchBoundariesIgnoringCellOrder);
+              const vtkCellFace& surfel = sortedFaces[j];
+              if (faceStatus[j] >= 0 &&
+                IsSameFace(surfel.Type, surfel.NumberOfPoints,
+                  facePoints.data() + surfel.PointsOffset, surfel.SmallestIdx, face.Type,
+                  face.NumberOfPoints, points, hash, match))
+              {
+                faceStatus[j] = 0;
+                faceStatus[i] = -1;
+                break;
+              }
             }
-            break;
           }
-          default:
-            vtkErrorMacro(<< "Cell type " << vtkCellTypes::GetClassNameFromTypeId(cellType) << "("
-                          << cellType << ")"
-                          << " is not a 3D cell.");
         }
+      });
+
+    // Loop over visible surfels (coming from a unique cell), in hashkey order.
+    for (size_t i = 0; i < sortedFaces.size() && !abort; ++i)
+    {
+      if (faceStatus[i] == 1)
+      {
+        const vtkCellFace& face = sortedFaces[i];
+        vtkIdType newCellId = insertCell(face.Type, face.NumberOfPoints,
+          facePoints.data() + face.PointsOffset, face.Cell3DId);
+        setDegrees(newCellId, face.Degrees);
       }
-    } // if cell is visible
-  }   // for all cells
-
-  // Loop over visible surfel (coming from a unique cell) in the hashtable:
-  vtkHashTableOfSurfelsCursor cursor;
-  cursor.Init(this->HashTable);
-  cursor.Start();
-  while (!cursor.IsAtEnd() && !abort)
+    }
+  }
+  else
   {
-    vtkSurfel* surfel = cursor.GetCurrentSurfel();
-    vtkIdType cellId = surfel->Cell3DId;
-    if (cellId >= 0) // on dataset boundary
+    vtkPoolManager<vtkSurfel>* pool = new vtkPoolManager<vtkSurfel>;
+    pool->Init();
+    this->HashTable = new vtkHashTableOfSurfels(numPts, pool);
+    auto insertFace = [&](vtkIdType cellId, vtkIdType faceType, int numberOfPoints,
+                        const vtkIdType* points, const int* degrees) {
+      this->HashTable->InsertFace(cellId, faceType, numberOfPoints, points, degrees,
+        this->MatchBoundariesIgnoringCellOrder);
+    };
+    vtkNew<vtkIdList> faceIds;
+
+    for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal() && !abort;
+         cellIter->GoToNextCell())
     {
-      vtkIdType cellType2D = surfel->Type;
-      vtkIdType npts = surfel->NumberOfPoints;
-      // Dataset point Ids that form the surfel.
-      vtkIdType* pts = surfel->Points;
+      vtkIdType cellId = cellIter->GetCellId();
+      // Progress and abort method support
+      if (progressCount >= progressInterval)
+      {
+        vtkDebugMacro(<< "Process cell #" << cellId);
+        this->UpdateProgress((double)cellId / numCells);
+        abort = this->CheckAbort();
+        progressCount = 0;
+      }
+      progressCount++;
 
-      cellIds->Reset();
-      if (this->Merging)
+      vtkIdType npts = cellIter->GetNumberOfPoints();
+      vtkIdType* pts = cellIter->GetPointIds()->GetPointer(0);
+      if (allVisible || cellVis[cellId])
       {
-        double x[3];
-        for (int i = 0; i < npts; ++i)
+        int cellType = cellIter->GetCellType();
+        if (IsCopiedCell(cellType))
         {
-          vtkIdType ptId = pts[i];
-          input->GetPoint(ptId, x);
-          vtkIdType newPtId;
-          if (this->Locator->InsertUniquePoint(x, newPtId))
-          {
-            outputPD->CopyData(pd, ptId, newPtId);
-            if (this->PassThroughPointIds)
-            {
-              originalPointIds->InsertValue(newPtId, ptId);
-            }
-          }
-          cellIds->InsertNextId(newPtId);
+          vtkDebugMacro(<< "not 3D cell. type=" << cellType);
+          // not 3D: just copy it
+          insertCell(cellType, npts, pts, cellId);
         }
-      } // merging coincident points
-      else
-      {
-        for (int i = 0; i < npts; ++i)
+        else // added the faces to the hashtable
         {
-          vtkIdType ptId = pts[i];
-          if (pointMap[ptId] < 0)
+          vtkDebugMacro(<< "3D cell. type=" << cellType);
+          vtkCellArray* faces =
+            cellType == VTK_POLYHEDRON ? cellIter->GetCellFaces() : nullptr;
+          if (!InsertCellFaces(insertFace, cellId, cellType, npts, pts, faces, faceIds,
+                input->GetCellData()))
           {
-            vtkIdType newPtId = newPts->InsertNextPoint(inPts->GetPoint(ptId));
-            pointMap[ptId] = newPtId;
-            outputPD->CopyData(pd, ptId, newPtId);
-            if (this->PassThroughPointIds)
-            {
-              originalPointIds->InsertValue(newPtId, ptId);
-            }
+            reportUnsupportedCell(cellType);
           }
-          cellIds->InsertNextId(pointMap[ptId]);
         }
-      } // keeping original point list
-
-      vtkIdType newCellId = output->InsertNextCell(cellType2D, cellIds);
-      outputCD->CopyData(cd, cellId, newCellId);
-
-      vtkDataArray* v = outputCD->GetHigherOrderDegrees();
-      if (v)
-      {
-        double degrees[3];
-        degrees[0] = surfel->Degrees[0];
-        degrees[1] = surfel->Degrees[1];
-        degrees[2] = 0;
-        v->SetTuple(newCellId, degrees);
-      }
-
-      if (this->PassThroughCellIds)
+      } // if cell is visible
+    }   // for all cells
+
+    // Loop over visible surfel (coming from a unique cell) in the hashtable:
+    vtkHashTableOfSurfelsCursor cursor;
+    cursor.Init(this->HashTable);
+    cursor.Start();
+    while (!cursor.IsAtEnd() && !abort)
+    {
+      vtkSurfel* surfel = cursor.GetCurrentSurfel();
+      vtkIdType cellId = surfel->Cell3DId;
+      if (cellId >= 0) // on dataset boundary
       {
-        originalCellIds->InsertValue(newCellId, cellId);
+        vtkIdType newCellId = insertCell(static_cast<int>(surfel->Type),
+          surfel->NumberOfPoints, surfel->Points, cellId);
+        setDegrees(newCellId, surfel->Degrees);
       }
+      cursor.Next();
     }
-    cursor.Next();
+
+    delete this->HashTable;
+    this->HashTable = nullptr;
+    delete pool;
   }
   if (!this->Merging)
   {
@@ -1375,8 +1639,6 @@ int vtkUnstructuredGridGeometryFilter::RequestData(vtkInformation* vtkNotUsed(re
   }
 
   cellIds->Delete();
-  delete this->HashTable;
-  delete pool;
 
   // Set the output.
   output->SetPoints(newPts);
@@ -17,6 +17,12 @@
  * and on bounding box (referred to as "Extent") to control the extraction
  * process.
  *
+ * When the input is a vtkUnstructuredGrid, the faces of the 3D cells, linear
+ * or not, are gathered and matched using vtkSMPTools. The faces are processed
+ * in the same order as in the serial traversal, so the output does not depend
+ * on the number of threads. Other vtkUnstructuredGridBase inputs are
+ * processed serially through their cell iterator.
+ *
  * @warning
  * When vtkUnstructuredGridGeometryFilter extracts cells (or boundaries of
  * cells) it will (by default) merge duplicate vertices. This may cause
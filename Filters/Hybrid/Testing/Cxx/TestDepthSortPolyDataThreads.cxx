@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel sort of vtkDepthSortPolyData does not depend on
+// the number of threads, that it sorts the cells by depth and then by id,
+// and that reusing the order of the previous execution gives the same result.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDepthSortPolyData.h"
+#include "vtkGenericCell.h"
+#include "vtkIdFilter.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// The order of the cells computed with a serial stable sort of their depths
+// along the vector from the origin.
+std::vector<vtkIdType> ReferenceOrder(
+  vtkPolyData* input, int mode, const double* vector, bool frontToBack)
+{
+  std::vector<double> depths(input->GetNumberOfCells());
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCell(cellId, cell);
+    double x[3];
+    if (mode == vtkDepthSortPolyData::VTK_SORT_FIRST_POINT)
+    {
+      cell->GetPoints()->GetPoint(0, x);
+    }
+    else if (mode == vtkDepthSortPolyData::VTK_SORT_BOUNDS_CENTER)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        float mn = static_cast<float>(cell->GetPoints()->GetPoint(0)[c]);
+        float mx = mn;
+        for (vtkIdType i = 1; i < cell->GetNumberOfPoints(); ++i)
+        {
+          mn = std::min(mn, static_cast<float>(cell->GetPoints()->GetPoint(i)[c]));
+          mx = std::max(mx, static_cast<float>(cell->GetPoints()->GetPoint(i)[c]));
+        }
+        x[c] = (mn + mx) / 2.0f;
+      }
+    }
+    else
+    {
+      double p[3];
+      std::vector<double> weights(cell->GetNumberOfPoints());
+      int subId = cell->GetParametricCenter(p);
+      cell->EvaluateLocation(subId, p, x, weights.data());
+    }
+    if (mode == vtkDepthSortPolyData::VTK_SORT_PARAMETRIC_CENTER)
+    {
+      depths[cellId] = x[0] * vector[0] + x[1] * vector[1] + x[2] * vector[2];
+    }
+    else
+    {
+      // The points are floats, and so are the depths.
+      depths[cellId] = static_cast<float>(x[0]) * static_cast<float>(vector[0]) +
+        static_cast<float>(x[1]) * static_cast<float>(vector[1]) +
+        static_cast<float>(x[2]) * static_cast<float>(vector[2]);
+    }
+  }
+  std::vector<vtkIdType> order(input->GetNumberOfCells());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](vtkIdType a, vtkIdType b) {
+    return frontToBack ? depths[a] < depths[b] : depths[a] > depths[b];
+  });
+  return order;
+}
+}
+
+int TestDepthSortPolyDataThreads(int, char*[])
+{
+  // Overlapping spheres, with vertices, lines and triangle strips, so that
+  // there are cells of equal depths.
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetThetaResolution(200);
+  sphere1->SetPhiResolution(200);
+  vtkNew<vtkSphereSource> sphere2;
+  sphere2->SetThetaResolution(200);
+  sphere2->SetPhiResolution(200);
+  sphere2->SetCenter(0.25, 0.0, 0.0);
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(sphere1->GetOutputPort());
+  append->AddInputConnection(sphere2->GetOutputPort());
+  append->AddInputConnection(sphere2->GetOutputPort());
+  append->Update();
+
+  vtkSmartPointer<vtkPolyData> spheres = vtkSmartPointer<vtkPolyData>::New();
+  spheres->DeepCopy(append->GetOutput());
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> strips;
+  for (vtkIdType ptId = 0; ptId + 3 < spheres->GetNumberOfPoints(); ptId += 97)
+  {
+    verts->InsertNextCell({ ptId });
+    lines->InsertNextCell({ ptId, ptId + 1, ptId + 2 });
+    strips->InsertNextCell({ ptId, ptId + 1, ptId + 2, ptId + 3 });
+  }
+  spheres->SetVerts(verts);
+  spheres->SetLines(lines);
+  spheres->SetStrips(strips);
+  vtkNew<vtkIdFilter> ids;
+  ids->SetInputData(spheres);
+  ids->SetCellIdsArrayName("CellIds");
+  ids->PointIdsOff();
+  ids->Update();
+  vtkPolyData* input = vtkPolyData::SafeDownCast(ids->GetOutput());
+
+  bool success = true;
+  const double vector[3] = { 0.3, -0.5, 0.8 };
+  for (int mode = vtkDepthSortPolyData::VTK_SORT_FIRST_POINT;
+       mode <= vtkDepthSortPolyData::VTK_SORT_PARAMETRIC_CENTER; ++mode)
+  {
+    for (int direction = vtkDepthSortPolyData::VTK_DIRECTION_BACK_TO_FRONT;
+         direction <= vtkDepthSortPolyData::VTK_DIRECTION_SPECIFIED_VECTOR; ++direction)
+    {
+      // The camera looks along the vector from the origin, so that the depths
+      // are the same for all the directions.
+      vtkNew<vtkCamera> camera;
+      camera->SetPosition(0.0, 0.0, 0.0);
+      camera->SetFocalPoint(vector);
+      vtkNew<vtkDepthSortPolyData> sort;
+      sort->SetInputData(input);
+      sort->SetDepthSortMode(mode);
+      sort->SetDirection(direction);
+      sort->SetCamera(camera);
+      sort->SetVector(vector[0], vector[1], vector[2]);
+      sort->SortScalarsOn();
+
+      // The threaded execution reuses the order of the serial one.
+      vtkNew<vtkPolyData> output;
+      if (!vtkTestUtilities::CompareThreadedOutputs(sort, 4, output) ||
+        output->GetNumberOfCells() != input->GetNumberOfCells())
+      {
+        vtkLog(ERROR, "Sorts differ with 1 and 4 threads, mode " << mode);
+        success = false;
+      }
+
+      // The cells are sorted from back to front, or front to back, along the
+      // vector.
+      bool frontToBack = direction == vtkDepthSortPolyData::VTK_DIRECTION_FRONT_TO_BACK;
+      std::vector<vtkIdType> reference = ReferenceOrder(input, mode, vector, frontToBack);
+      vtkDataArray* order = output->GetCellData()->GetArray("originalCellIds");
+      for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+      {
+        if (order->GetComponent(i, 0) != reference[i])
+        {
+          vtkLog(ERROR, "Unexpected order at " << i << ", mode " << mode);
+          success = false;
+          break;
+        }
+      }
+
+      // Reuse the nearly sorted order of the previous execution, for a small
+      // and a large change of the view.
+      for (double delta : { 0.0, 1e-5, 2.0 })
+      {
+        double focalPoint[3] = { vector[0], vector[1] + delta, vector[2] };
+        camera->SetFocalPoint(focalPoint);
+        sort->SetVector(focalPoint);
+        sort->Modified();
+        sort->Update();
+        vtkNew<vtkDepthSortPolyData> fresh;
+        fresh->SetInputData(input);
+        fresh->SetDepthSortMode(mode);
+        fresh->SetDirection(direction);
+        fresh->SetCamera(camera);
+        fresh->SetVector(focalPoint);
+        fresh->SortScalarsOn();
+        fresh->Update();
+        if (!vtkTestUtilities::CompareDataObjectsExactly(fresh->GetOutput(), sort->GetOutput()))
+        {
+          vtkLog(ERROR, "Reused order differs, mode " << mode << ", change " << delta);
+          success = false;
+        }
+      }
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
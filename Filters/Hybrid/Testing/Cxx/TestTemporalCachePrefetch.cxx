@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTemporalDataSetCache.h"
+#include "vtkTestErrorObserver.h"
+
+#include <cstdlib>
+#include <thread>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Source producing a single point located at (t + Offset, 0, 0) for the time
+// steps 0 to 9, counting how many times it executed. It fails to produce the
+// time step FailingTime.
+class vtkTimeStepSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTimeStepSource* New();
+  vtkTypeMacro(vtkTimeStepSource, vtkPolyDataAlgorithm);
+
+  vtkSetMacro(Offset, double);
+  vtkSetMacro(FailingTime, double);
+
+  int NumberOfExecutions = 0;
+  std::thread::id ExecutionThread = std::this_thread::get_id();
+  double Offset = 0.0;
+  double FailingTime = -1.0;
+
+protected:
+  vtkTimeStepSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double timeSteps[10];
+    for (int i = 0; i < 10; ++i)
+    {
+      timeSteps[i] = i;
+    }
+    double timeRange[2] = { 0.0, 9.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timeSteps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), timeRange, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    if (std::this_thread::get_id() != this->ExecutionThread)
+    {
+      vtkErrorMacro("Executed on another thread than the one updating the pipeline.");
+      return 0;
+    }
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    if (time == this->FailingTime)
+    {
+      return 0;
+    }
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(time + this->Offset, 0.0, 0.0);
+    output->SetPoints(points);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+private:
+  vtkTimeStepSource(const vtkTimeStepSource&) = delete;
+  void operator=(const vtkTimeStepSource&) = delete;
+};
+vtkStandardNewMacro(vtkTimeStepSource);
+
+//------------------------------------------------------------------------------
+bool CheckTime(vtkTemporalDataSetCache* cache, double time, double offset = 0.0)
+{
+  cache->UpdateTimeStep(time);
+  vtkPolyData* output = vtkPolyData::SafeDownCast(cache->GetOutputDataObject(0));
+  if (!output || output->GetNumberOfPoints() != 1 || output->GetPoint(0)[0] != time + offset)
+  {
+    vtkLog(ERROR, "Wrong output for time " << time);
+    return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Prefetch the queued time steps, as an application would between frames.
+void Prefetch(vtkTemporalDataSetCache* cache)
+{
+  while (cache->PrefetchNextTimeStep())
+  {
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+int TestTemporalCachePrefetch(int, char*[])
+{
+  vtkNew<vtkTimeStepSource> source;
+  vtkNew<vtkTemporalDataSetCache> cache;
+  cache->SetInputConnection(source->GetOutputPort());
+  cache->SetCacheSize(4);
+  cache->SetNumberOfPrefetchedTimeSteps(3);
+
+  // Requesting the first time step queues the 3 following ones, which are
+  // only fetched when asked for.
+  if (!::CheckTime(cache, 0.0))
+  {
+    return EXIT_FAILURE;
+  }
+  if (source->NumberOfExecutions != 1 || cache->GetNumberOfPendingTimeSteps() != 3)
+  {
+    vtkLog(ERROR,
+      "Expected 1 execution of the source and 3 pending time steps, got "
+        << source->NumberOfExecutions << " and " << cache->GetNumberOfPendingTimeSteps());
+    return EXIT_FAILURE;
+  }
+  ::Prefetch(cache);
+  if (source->NumberOfExecutions != 4 || cache->GetNumberOfPendingTimeSteps() != 0)
+  {
+    vtkLog(ERROR, "Expected 4 executions of the source, got " << source->NumberOfExecutions);
+    return EXIT_FAILURE;
+  }
+
+  // Prefetched time steps are served from the cache, the following ones being
+  // prefetched between the requests.
+  for (int time = 1; time < 10; ++time)
+  {
+    const int numberOfExecutions = source->NumberOfExecutions;
+    if (!::CheckTime(cache, time))
+    {
+      return EXIT_FAILURE;
+    }
+    if (source->NumberOfExecutions != numberOfExecutions)
+    {
+      vtkLog(ERROR, "Time step " << time << " was not prefetched.");
+      return EXIT_FAILURE;
+    }
+    ::Prefetch(cache);
+  }
+  if (source->NumberOfExecutions != 10)
+  {
+    vtkLog(ERROR, "Expected 10 executions of the source, got " << source->NumberOfExecutions);
+    return EXIT_FAILURE;
+  }
+
+  // Going backward prefetches the previous time steps.
+  for (int time = 9; time >= 0; --time)
+  {
+    if (!::CheckTime(cache, time))
+    {
+      return EXIT_FAILURE;
+    }
+    ::Prefetch(cache);
+  }
+
+  // Modifying the source discards the prefetched time steps, which were
+  // computed with the previous offset.
+  if (!::CheckTime(cache, 3.0))
+  {
+    return EXIT_FAILURE;
+  }
+  ::Prefetch(cache);
+  source->SetOffset(0.5);
+  for (int time = 4; time < 8; ++time)
+  {
+    if (!::CheckTime(cache, time, 0.5))
+    {
+      return EXIT_FAILURE;
+    }
+    ::Prefetch(cache);
+  }
+
+  // A failed prefetch does not evict the cached time steps.
+  vtkNew<vtkTimeStepSource> failingSource;
+  failingSource->SetFailingTime(4.0);
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  failingSource->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  vtkNew<vtkTemporalDataSetCache> failingCache;
+  failingCache->SetInputConnection(failingSource->GetOutputPort());
+  failingCache->SetCacheSize(3);
+  failingCache->SetNumberOfPrefetchedTimeSteps(2);
+  // The time steps 1 and 2 are prefetched from 0, 3 from 1, and 4 fails from 3.
+  for (double time : { 0.0, 1.0, 3.0 })
+  {
+    if (!::CheckTime(failingCache, time))
+    {
+      return EXIT_FAILURE;
+    }
+    ::Prefetch(failingCache);
+  }
+  if (failingSource->NumberOfExecutions != 5 || !errorObserver->GetError())
+  {
+    vtkLog(ERROR, "Expected the prefetch of the time step 4 to fail");
+    return EXIT_FAILURE;
+  }
+  // Going backward only prefetches the time step 0, the time steps 1 and 2
+  // are still cached.
+  for (double time : { 2.0, 1.0 })
+  {
+    if (!::CheckTime(failingCache, time))
+    {
+      return EXIT_FAILURE;
+    }
+    ::Prefetch(failingCache);
+  }
+  if (failingSource->NumberOfExecutions != 6)
+  {
+    vtkLog(ERROR, "Cached time steps were evicted by the failed prefetch");
+    return EXIT_FAILURE;
+  }
+
+  // Without exclusive access to the upstream pipeline, nothing is prefetched.
+  vtkNew<vtkTimeStepSource> sharedSource;
+  vtkNew<vtkTemporalDataSetCache> sharedCache;
+  vtkNew<vtkTemporalDataSetCache> otherConsumer;
+  sharedCache->SetInputConnection(sharedSource->GetOutputPort());
+  otherConsumer->SetInputConnection(sharedSource->GetOutputPort());
+  sharedCache->SetNumberOfPrefetchedTimeSteps(3);
+  if (!::CheckTime(sharedCache, 0.0))
+  {
+    return EXIT_FAILURE;
+  }
+  ::Prefetch(sharedCache);
+  if (sharedSource->NumberOfExecutions != 1 || sharedCache->GetNumberOfPendingTimeSteps() != 0)
+  {
+    vtkLog(ERROR, "Shared upstream pipeline should not be prefetched");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkDepthSortPolyData.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCamera.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
@@ -20,8 +21,12 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProp3D.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkSignedCharArray.h"
+#include "vtkSmartPointer.h"
 #include "vtkTransform.h"
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedLongArray.h"
@@ -29,34 +34,21 @@
 #include "vtkUnsignedShortArray.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 namespace
 {
 
-template <typename T>
-struct greaterf
-{
-  greaterf(const T* az)
-    : z(az)
-  {
-  }
-  bool operator()(vtkIdType l, vtkIdType r) const { return z[l] > z[r]; }
-  const T* z;
-};
-
-template <typename T>
-struct lessf
-{
-  lessf(const T* az)
-    : z(az)
-  {
-  }
-  bool operator()(vtkIdType l, vtkIdType r) const { return z[l] < z[r]; }
-  const T* z;
-};
+// Number of cells per block of the parallel radix sort and of the parallel
+// construction of the output. The output does not depend on the blocks.
+constexpr vtkIdType SortBlockSize = 65536;
 
 template <typename T>
 T getCellBoundsCenter(const vtkIdType* pids, vtkIdType nPids, const T* px)
@@ -72,115 +64,271 @@ T getCellBoundsCenter(const vtkIdType* pids, vtkIdType nPids, const T* px)
   return (mn + mx) / T(2);
 }
 
+//------------------------------------------------------------------------------
+// Unsigned sort keys of the depths, which compare as the depths (or in the
+// reverse order when sorting back to front), so that the cells may be radix
+// sorted. Cells of equal depth are kept in the order of their ids.
 template <typename T>
-void getCellCenterDepth(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells, double* origin,
-  double* direction, T*& depth)
+using DepthKeyType =
+  typename std::conditional<(sizeof(T) > 4), vtkTypeUInt64, vtkTypeUInt32>::type;
+
+// Bits of the floating point depths, flipped so that they compare as unsigned
+// integers in the same order as the depths. -0 and +0 get the same key.
+vtkTypeUInt32 getOrderedBits(float depth)
 {
-  if (nCells < 1)
-  {
-    return;
-  }
+  vtkTypeUInt32 bits;
+  depth = depth + 0.0f;
+  memcpy(&bits, &depth, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
 
-  T* ppts = static_cast<T*>(gpts->GetVoidPointer(0));
-  T* px = ppts;
-  T* py = ppts + 1;
-  T* pz = ppts + 2;
+vtkTypeUInt64 getOrderedBits(double depth)
+{
+  vtkTypeUInt64 bits;
+  depth = depth + 0.0;
+  memcpy(&bits, &depth, sizeof(bits));
+  const vtkTypeUInt64 signBit = vtkTypeUInt64(1) << 63;
+  return (bits & signBit) ? ~bits : (bits | signBit);
+}
 
-  // this call insures that BuildCells gets done if it's
-  // needed and we can use the faster GetCellPoints api
-  // that doesn't check
-  if (pds->NeedToBuildCells())
-  {
-    pds->BuildCells();
-  }
+template <typename T>
+DepthKeyType<T> getOrderedBits(T depth)
+{
+  using KeyT = DepthKeyType<T>;
+  const KeyT signBit = KeyT(1) << (8 * sizeof(KeyT) - 1);
+  return static_cast<KeyT>(depth) ^ (std::is_signed<T>::value ? signBit : KeyT(0));
+}
 
-  // compute cell centers
-  T* cx = new T[nCells];
-  T* cy = new T[nCells];
-  T* cz = new T[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    // get the cell point ids using the fast api
-    const vtkIdType* pids = nullptr;
-    vtkIdType nPids = 0;
-    pds->GetCellPoints(cid, nPids, pids);
+template <typename T>
+DepthKeyType<T> getSortKey(T depth, bool reverse)
+{
+  DepthKeyType<T> key = getOrderedBits(depth);
+  return reverse ? ~key : key;
+}
 
-    // compute the center of the cell bounds
-    cx[cid] = getCellBoundsCenter(pids, nPids, px);
-    cy[cid] = getCellBoundsCenter(pids, nPids, py);
-    cz[cid] = getCellBoundsCenter(pids, nPids, pz);
-  }
+//------------------------------------------------------------------------------
+// Compute the sort keys of the cells from the depth of their first point or
+// of the center of their bounds.
+template <typename T>
+void getCellKeys(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells, bool boundsCenter,
+  const double* origin, const double* direction, bool reverse, DepthKeyType<T>* keys)
+{
+  const T* ppts = static_cast<T*>(gpts->GetVoidPointer(0));
+  const T* px = ppts;
+  const T* py = ppts + 1;
+  const T* pz = ppts + 2;
+
+  const T x0 = static_cast<T>(origin[0]);
+  const T y0 = static_cast<T>(origin[1]);
+  const T z0 = static_cast<T>(origin[2]);
+  const T vx = static_cast<T>(direction[0]);
+  const T vy = static_cast<T>(direction[1]);
+  const T vz = static_cast<T>(direction[2]);
+
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkSMPTools::For(0, nCells, [&](vtkIdType cid, vtkIdType endCid) {
+    vtkIdList* ptIds = cellPointIds.Local();
+    for (; cid < endCid; ++cid)
+    {
+      // get the cell point ids using the thread-safe api
+      const vtkIdType* pids = nullptr;
+      vtkIdType nPids = 0;
+      pds->GetCellPoints(cid, nPids, pids, ptIds);
+
+      T cx = x0;
+      T cy = y0;
+      T cz = z0;
+      if (boundsCenter)
+      {
+        // compute the center of the cell bounds
+        cx = getCellBoundsCenter(pids, nPids, px);
+        cy = getCellBoundsCenter(pids, nPids, py);
+        cz = getCellBoundsCenter(pids, nPids, pz);
+      }
+      else if (nPids > 0)
+      {
+        vtkIdType ii = pids[0];
+        cx = px[3 * ii];
+        cy = py[3 * ii];
+        cz = pz[3 * ii];
+      }
 
-  // compute the distance to the cell center
-  T x0 = static_cast<T>(origin[0]);
-  T y0 = static_cast<T>(origin[1]);
-  T z0 = static_cast<T>(origin[2]);
-  T vx = static_cast<T>(direction[0]);
-  T vy = static_cast<T>(direction[1]);
-  T vz = static_cast<T>(direction[2]);
-  depth = new T[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    depth[cid] = (cx[cid] - x0) * vx + (cy[cid] - y0) * vy + (cz[cid] - z0) * vz;
-  }
+      // compute the distance to the cell center or first point
+      T depth = (cx - x0) * vx + (cy - y0) * vy + (cz - z0) * vz;
+      keys[cid] = getSortKey(depth, reverse);
+    }
+  });
+}
 
-  delete[] cx;
-  delete[] cy;
-  delete[] cz;
+//------------------------------------------------------------------------------
+// Compute the sort keys of the cells from the depth of their parametric
+// center.
+template <typename KeyT>
+void getCellParametricCenterKeys(vtkPolyData* pds, vtkIdType nCells, const double* origin,
+  const double* direction, bool reverse, KeyT* keys)
+{
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPThreadLocal<std::vector<double>> weights;
+  size_t maxCellSize = pds->GetMaxCellSize();
+
+  vtkSMPTools::For(0, nCells, [&](vtkIdType cid, vtkIdType endCid) {
+    vtkGenericCell* genericCell = cells.Local();
+    std::vector<double>& weight = weights.Local();
+    weight.resize(maxCellSize);
+    double x[3];
+    double p[3];
+    for (; cid < endCid; ++cid)
+    {
+      std::fill_n(x, 3, 0.0);
+      std::fill_n(p, 3, 0.0);
+      pds->GetCell(cid, genericCell);
+      int subId = genericCell->GetParametricCenter(p);
+      genericCell->EvaluateLocation(subId, p, x, weight.data());
+
+      // compute the distance
+      double depth = (x[0] - origin[0]) * direction[0] + (x[1] - origin[1]) * direction[1] +
+        (x[2] - origin[2]) * direction[2];
+      keys[cid] = getSortKey(depth, reverse);
+    }
+  });
 }
 
-template <typename T>
-void getCellPoint0Depth(vtkPolyData* pds, vtkDataArray* gpts, vtkIdType nCells, double* origin,
-  double* direction, T*& depth)
+//------------------------------------------------------------------------------
+// Whether cell a comes before cell b in the sorted order.
+template <typename KeyT>
+bool isBefore(const KeyT* keys, vtkIdType a, vtkIdType b)
 {
-  if (nCells < 1)
+  return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+}
+
+//------------------------------------------------------------------------------
+// Reuse the order of the previous execution when it is still sorted, or
+// nearly sorted for a moving camera. The nearly sorted order is finished
+// with an insertion sort, which gives up after a number of moves linear in
+// the number of cells.
+template <typename KeyT>
+bool reuseOrder(const KeyT* keys, vtkIdType nCells, std::vector<vtkIdType>& order)
+{
+  if (static_cast<vtkIdType>(order.size()) != nCells)
   {
-    return;
+    return false;
   }
 
-  T* ppts = static_cast<T*>(gpts->GetVoidPointer(0));
-  T* px = ppts;
-  T* py = ppts + 1;
-  T* pz = ppts + 2;
-
-  // this call insures that BuildCells gets done if it's
-  // needed and we can use the faster GetCellPoints api
-  if (pds->NeedToBuildCells())
+  std::atomic<vtkIdType> numUnsorted(0);
+  vtkSMPTools::For(1, nCells, [&](vtkIdType i, vtkIdType end) {
+    vtkIdType count = 0;
+    for (; i < end; ++i)
+    {
+      count += isBefore(keys, order[i], order[i - 1]) ? 1 : 0;
+    }
+    numUnsorted += count;
+  });
+  if (numUnsorted == 0)
   {
-    pds->BuildCells();
+    return true;
   }
 
-  T* cx = new T[nCells];
-  T* cy = new T[nCells];
-  T* cz = new T[nCells];
-  const vtkIdType* pids = nullptr;
-  vtkIdType nPids = 0;
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
+  vtkIdType maxMoves = nCells;
+  for (vtkIdType i = 1; i < nCells; ++i)
   {
-    // get the cell point ids using the fast api
-    pds->GetCellPoints(cid, nPids, pids);
-    vtkIdType ii = pids[0];
-    cx[cid] = px[3 * ii];
-    cy[cid] = py[3 * ii];
-    cz[cid] = pz[3 * ii];
+    vtkIdType cid = order[i];
+    vtkIdType j = i;
+    for (; j > 0 && isBefore(keys, cid, order[j - 1]); --j)
+    {
+      order[j] = order[j - 1];
+    }
+    order[j] = cid;
+    maxMoves -= i - j;
+    if (maxMoves < 0)
+    {
+      return false;
+    }
   }
+  return true;
+}
 
-  // compute the distance to the cell's first point
-  T x0 = static_cast<T>(origin[0]);
-  T y0 = static_cast<T>(origin[1]);
-  T z0 = static_cast<T>(origin[2]);
-  T vx = static_cast<T>(direction[0]);
-  T vy = static_cast<T>(direction[1]);
-  T vz = static_cast<T>(direction[2]);
-  depth = new T[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
-  {
-    depth[cid] = (cx[cid] - x0) * vx + (cy[cid] - y0) * vy + (cz[cid] - z0) * vz;
+//------------------------------------------------------------------------------
+// Stable least significant digit radix sort of the cells by their keys, by
+// bytes, in parallel over blocks of cells. The keys are overwritten.
+template <typename KeyT>
+void radixSort(KeyT* keys, vtkIdType nCells, std::vector<vtkIdType>& order)
+{
+  order.resize(nCells);
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<KeyT> keysBuffer(nCells);
+  std::vector<vtkIdType> orderBuffer(nCells);
+  KeyT* inKeys = keys;
+  KeyT* outKeys = keysBuffer.data();
+  vtkIdType* inOrder = order.data();
+  vtkIdType* outOrder = orderBuffer.data();
+
+  const vtkIdType numBlocks = (nCells - 1) / SortBlockSize + 1;
+  std::vector<vtkIdType> offsets(numBlocks * 256);
+  for (size_t shift = 0; shift < 8 * sizeof(KeyT); shift += 8)
+  {
+    // count the digits of each block
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      for (; block < endBlock; ++block)
+      {
+        vtkIdType* counts = offsets.data() + 256 * block;
+        std::fill_n(counts, 256, 0);
+        vtkIdType end = std::min((block + 1) * SortBlockSize, nCells);
+        for (vtkIdType i = block * SortBlockSize; i < end; ++i)
+        {
+          ++counts[(inKeys[i] >> shift) & 0xff];
+        }
+      }
+    });
+
+    // skip the passes where all the keys have the same digit
+    bool sameDigit = false;
+    for (int digit = 0; digit < 256 && !sameDigit; ++digit)
+    {
+      vtkIdType count = 0;
+      for (vtkIdType block = 0; block < numBlocks; ++block)
+      {
+        count += offsets[256 * block + digit];
+      }
+      sameDigit = count == nCells;
+    }
+    if (sameDigit)
+    {
+      continue;
+    }
+
+    // the cells of a digit are ordered by blocks, so that the sort is stable
+    vtkIdType offset = 0;
+    for (int digit = 0; digit < 256; ++digit)
+    {
+      for (vtkIdType block = 0; block < numBlocks; ++block)
+      {
+        vtkIdType count = offsets[256 * block + digit];
+        offsets[256 * block + digit] = offset;
+        offset += count;
+      }
+    }
+
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+      for (; block < endBlock; ++block)
+      {
+        vtkIdType* blockOffsets = offsets.data() + 256 * block;
+        vtkIdType end = std::min((block + 1) * SortBlockSize, nCells);
+        for (vtkIdType i = block * SortBlockSize; i < end; ++i)
+        {
+          vtkIdType pos = blockOffsets[(inKeys[i] >> shift) & 0xff]++;
+          outKeys[pos] = inKeys[i];
+          outOrder[pos] = inOrder[i];
+        }
+      }
+    });
+    std::swap(inKeys, outKeys);
+    std::swap(inOrder, outOrder);
   }
 
-  delete[] cx;
-  delete[] cy;
-  delete[] cz;
+  if (inOrder != order.data())
+  {
+    std::copy(inOrder, inOrder + nCells, order.begin());
+  }
 }
 }
 
@@ -261,195 +409,237 @@ int vtkDepthSortPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdType nStrips = input->GetStrips()->GetNumberOfCells();
   vtkIdType nCells = nVerts + nLines + nPolys + nStrips;
 
-  vtkIdType* order = new vtkIdType[nCells];
-  for (vtkIdType cid = 0; cid < nCells; ++cid)
+  // this call insures that BuildCells gets done before the cells are
+  // accessed concurrently
+  if (nCells && tmpInput->NeedToBuildCells())
   {
-    order[cid] = cid;
-  }
-
-  vtkIdTypeArray* newCellIds = nullptr;
-  if (this->SortScalars)
-  {
-    newCellIds = vtkIdTypeArray::New();
-    newCellIds->SetName("sortedCellIds");
-    newCellIds->SetNumberOfTuples(nCells);
-    memcpy(newCellIds->GetPointer(0), order, nCells * sizeof(vtkIdType));
+    tmpInput->BuildCells();
   }
 
+  // sort the cell ids by depth, reusing the order of the previous execution
+  // when possible
+  std::vector<vtkIdType>& order = this->PreviousOrder;
+  const bool reverse = this->Direction != VTK_DIRECTION_FRONT_TO_BACK;
   if (nCells)
   {
     if ((this->DepthSortMode == VTK_SORT_FIRST_POINT) ||
       (this->DepthSortMode == VTK_SORT_BOUNDS_CENTER))
     {
       vtkDataArray* pts = tmpInput->GetPoints()->GetData();
+      const bool boundsCenter = this->DepthSortMode == VTK_SORT_BOUNDS_CENTER;
       switch (pts->GetDataType())
       {
         vtkTemplateMacro(
 
           // compute the cell's depth
-          VTK_TT* depth = nullptr; if (this->DepthSortMode == VTK_SORT_FIRST_POINT) {
-            ::getCellPoint0Depth(tmpInput, pts, nCells, origin, direction, depth);
-          } else { ::getCellCenterDepth(tmpInput, pts, nCells, origin, direction, depth); }
+          std::vector<::DepthKeyType<VTK_TT>> keys(nCells);
+          ::getCellKeys<VTK_TT>(
+            tmpInput, pts, nCells, boundsCenter, origin, direction, reverse, keys.data());
 
           // sort cell ids by depth
-          if (this->Direction == VTK_DIRECTION_FRONT_TO_BACK) {
-            ::lessf<VTK_TT> comp(depth);
-            std::sort(order, order + nCells, comp);
-          } else {
-            ::greaterf<VTK_TT> comp(depth);
-            std::sort(order, order + nCells, comp);
-          }
-
-          delete[] depth;);
+          if (!::reuseOrder(keys.data(), nCells, order)) {
+            ::radixSort(keys.data(), nCells, order);
+          });
       }
     }
     else // VTK_SORT_PARAMETRIC_CENTER
     {
-      vtkGenericCell* cell = vtkGenericCell::New();
-
-      double x[3] = { 0.0 };
-      double p[3] = { 0.0 };
-
-      size_t maxCellSize = input->GetMaxCellSize();
-      double* weight = new double[maxCellSize];
-      double* depth = new double[nCells];
-
-      for (vtkIdType cid = 0; cid < nCells; ++cid)
+      std::vector<vtkTypeUInt64> keys(nCells);
+      ::getCellParametricCenterKeys(tmpInput, nCells, origin, direction, reverse, keys.data());
+      if (!::reuseOrder(keys.data(), nCells, order))
       {
-        tmpInput->GetCell(cid, cell);
-        int subId = cell->GetParametricCenter(p);
-        cell->EvaluateLocation(subId, p, x, weight);
-
-        // compute the distance
-        depth[cid] = (x[0] - origin[0]) * direction[0] + (x[1] - origin[1]) * direction[1] +
-          (x[2] - origin[2]) * direction[2];
+        ::radixSort(keys.data(), nCells, order);
       }
-
-      // sort
-      if (this->Direction == VTK_DIRECTION_FRONT_TO_BACK)
-      {
-        ::lessf<double> comp(depth);
-        std::sort(order, order + nCells, comp);
-      }
-      else
-      {
-        ::greaterf<double> comp(depth);
-        std::sort(order, order + nCells, comp);
-      }
-
-      delete[] weight;
-      delete[] depth;
-      cell->Delete();
     }
   }
+  else
+  {
+    order.clear();
+  }
 
   // construct the output
   vtkCellData* inCD = input->GetCellData();
   vtkCellData* outCD = output->GetCellData();
-  outCD->CopyAllocate(inCD);
+  outCD->CopyAllocate(inCD, nCells);
 
   // pass point through
   output->SetPoints(input->GetPoints());
   output->GetPointData()->PassData(input->GetPointData());
 
-  // allocate the cells for the output
-  vtkCellArray* outputVerts = nullptr;
-  if (nVerts)
+  // count the cells and their point ids for each output cell array, by
+  // blocks of sorted cells
+  const vtkIdType nBlocks = nCells ? (nCells - 1) / ::SortBlockSize + 1 : 0;
+  std::vector<signed char> cellArrays(nCells);
+  std::vector<vtkIdType> cellOffsets(4 * (nBlocks + 1), 0);
+  std::vector<vtkIdType> connOffsets(4 * (nBlocks + 1), 0);
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+  vtkSMPTools::For(0, nBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    vtkIdList* ptIds = cellPointIds.Local();
+    for (; block < endBlock; ++block)
+    {
+      vtkIdType end = std::min((block + 1) * ::SortBlockSize, nCells);
+      for (vtkIdType i = block * ::SortBlockSize; i < end; ++i)
+      {
+        vtkIdType cid = order[i];
+        int cellArray = -1;
+        switch (tmpInput->GetCellType(cid))
+        {
+          case VTK_VERTEX:
+          case VTK_POLY_VERTEX:
+            cellArray = 0;
+            break;
+
+          case VTK_LINE:
+          case VTK_POLY_LINE:
+            cellArray = 1;
+            break;
+
+          case VTK_TRIANGLE:
+          case VTK_QUAD:
+          case VTK_POLYGON:
+            cellArray = 2;
+            break;
+
+          case VTK_TRIANGLE_STRIP:
+            cellArray = 3;
+            break;
+        }
+        cellArrays[i] = static_cast<signed char>(cellArray);
+        if (cellArray >= 0)
+        {
+          vtkIdType nids;
+          const vtkIdType* pids;
+          tmpInput->GetCellPoints(cid, nids, pids, ptIds);
+          ++cellOffsets[4 * (block + 1) + cellArray];
+          connOffsets[4 * (block + 1) + cellArray] += nids;
+        }
+      }
+    }
+  });
+  for (vtkIdType block = 0; block < nBlocks; ++block)
   {
-    vtkCellArray* inVerts = input->GetVerts();
-    outputVerts = vtkCellArray::New();
-    outputVerts->AllocateExact(inVerts->GetNumberOfCells(), inVerts->GetNumberOfConnectivityIds());
-    output->SetVerts(outputVerts);
-    outputVerts->Delete();
+    for (int cellArray = 0; cellArray < 4; ++cellArray)
+    {
+      cellOffsets[4 * (block + 1) + cellArray] += cellOffsets[4 * block + cellArray];
+      connOffsets[4 * (block + 1) + cellArray] += connOffsets[4 * block + cellArray];
+    }
   }
 
-  vtkCellArray* outputLines = nullptr;
-  if (nLines)
-  {
-    vtkCellArray* inLines = input->GetLines();
-    outputLines = vtkCellArray::New();
-    outputLines->AllocateExact(inLines->GetNumberOfCells(), inLines->GetNumberOfConnectivityIds());
-    output->SetLines(outputLines);
-    outputLines->Delete();
+  // allocate the cells for the output
+  const vtkIdType nInputCells[4] = { nVerts, nLines, nPolys, nStrips };
+  vtkSmartPointer<vtkIdTypeArray> offsets[4];
+  vtkSmartPointer<vtkIdTypeArray> connectivity[4];
+  vtkIdType* offsetsPtr[4] = { nullptr };
+  vtkIdType* connectivityPtr[4] = { nullptr };
+  for (int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    if (nInputCells[cellArray])
+    {
+      offsets[cellArray] = vtkSmartPointer<vtkIdTypeArray>::New();
+      offsets[cellArray]->SetNumberOfValues(cellOffsets[4 * nBlocks + cellArray] + 1);
+      offsetsPtr[cellArray] = offsets[cellArray]->GetPointer(0);
+      offsetsPtr[cellArray][cellOffsets[4 * nBlocks + cellArray]] =
+        connOffsets[4 * nBlocks + cellArray];
+      connectivity[cellArray] = vtkSmartPointer<vtkIdTypeArray>::New();
+      connectivity[cellArray]->SetNumberOfValues(connOffsets[4 * nBlocks + cellArray]);
+      connectivityPtr[cellArray] = connectivity[cellArray]->GetPointer(0);
+    }
   }
 
-  vtkCellArray* outputPolys = nullptr;
-  if (nPolys)
+  // build the cells and copy over their data
+  ArrayList arrays;
+  arrays.AddArrays(nCells, inCD, outCD, 0.0, false);
+  vtkSMPTools::For(0, nBlocks, [&](vtkIdType block, vtkIdType endBlock) {
+    vtkIdList* ptIds = cellPointIds.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    for (; block < endBlock; ++block)
+    {
+      if (isFirst)
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+      vtkIdType cellIds[4];
+      vtkIdType connIds[4];
+      std::copy_n(cellOffsets.data() + 4 * block, 4, cellIds);
+      std::copy_n(connOffsets.data() + 4 * block, 4, connIds);
+      vtkIdType end = std::min((block + 1) * ::SortBlockSize, nCells);
+      for (vtkIdType i = block * ::SortBlockSize; i < end; ++i)
+      {
+        vtkIdType cid = order[i];
+        int cellArray = cellArrays[i];
+        if (cellArray >= 0)
+        {
+          vtkIdType nids;
+          const vtkIdType* pids;
+          tmpInput->GetCellPoints(cid, nids, pids, ptIds);
+          offsetsPtr[cellArray][cellIds[cellArray]++] = connIds[cellArray];
+          std::copy_n(pids, nids, connectivityPtr[cellArray] + connIds[cellArray]);
+          connIds[cellArray] += nids;
+        }
+        // copy over data
+        arrays.Copy(cid, i);
+      }
+    }
+  });
+
+  vtkCellArray* outputCells[4] = { nullptr };
+  for (int cellArray = 0; cellArray < 4; ++cellArray)
   {
-    vtkCellArray* inPolys = input->GetPolys();
-    outputPolys = vtkCellArray::New();
-    outputPolys->AllocateExact(inPolys->GetNumberOfCells(), inPolys->GetNumberOfConnectivityIds());
-    output->SetPolys(outputPolys);
-    outputPolys->Delete();
+    if (nInputCells[cellArray])
+    {
+      outputCells[cellArray] = vtkCellArray::New();
+      outputCells[cellArray]->SetData(offsets[cellArray], connectivity[cellArray]);
+    }
   }
-
-  vtkCellArray* outputStrips = nullptr;
-  if (nStrips)
+  if (outputCells[0])
   {
-    vtkCellArray* inStrips = input->GetStrips();
-    outputStrips = vtkCellArray::New();
-    outputStrips->AllocateExact(
-      inStrips->GetNumberOfCells(), inStrips->GetNumberOfConnectivityIds());
-    output->SetStrips(outputStrips);
-    outputStrips->Delete();
+    output->SetVerts(outputCells[0]);
   }
-
-  for (vtkIdType i = 0; i < nCells; ++i)
+  if (outputCells[1])
   {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    // get the cell points using the fast api
-    vtkIdType cid = order[i];
-    vtkIdType nids;
-    const vtkIdType* pids;
-    tmpInput->GetCellPoints(cid, nids, pids);
-    int ctype = tmpInput->GetCellType(cid);
-
-    // build the cell
-    switch (ctype)
+    output->SetLines(outputCells[1]);
+  }
+  if (outputCells[2])
+  {
+    output->SetPolys(outputCells[2]);
+  }
+  if (outputCells[3])
+  {
+    output->SetStrips(outputCells[3]);
+  }
+  for (int cellArray = 0; cellArray < 4; ++cellArray)
+  {
+    if (outputCells[cellArray])
     {
-      case VTK_VERTEX:
-      case VTK_POLY_VERTEX:
-        outputVerts->InsertNextCell(nids, pids);
-        break;
-
-      case VTK_LINE:
-      case VTK_POLY_LINE:
-        outputLines->InsertNextCell(nids, pids);
-        break;
-
-      case VTK_TRIANGLE:
-      case VTK_QUAD:
-      case VTK_POLYGON:
-        outputPolys->InsertNextCell(nids, pids);
-        break;
-
-      case VTK_TRIANGLE_STRIP:
-        outputStrips->InsertNextCell(nids, pids);
-        break;
+      outputCells[cellArray]->Delete();
     }
-    // copy over data
-    outCD->CopyData(inCD, cid, i);
   }
 
   if (this->SortScalars)
   {
     // add the sort indices
-    output->GetCellData()->AddArray(newCellIds);
-    newCellIds->Delete();
-
+    vtkIdTypeArray* newCellIds = vtkIdTypeArray::New();
+    newCellIds->SetName("sortedCellIds");
+    newCellIds->SetNumberOfTuples(nCells);
     vtkIdTypeArray* oldCellIds = vtkIdTypeArray::New();
     oldCellIds->SetName("originalCellIds");
-    oldCellIds->SetArray(order, nCells, 0, 1);
+    oldCellIds->SetNumberOfTuples(nCells);
+    vtkSMPTools::For(0, nCells, [&](vtkIdType i, vtkIdType end) {
+      for (; i < end; ++i)
+      {
+        newCellIds->SetValue(i, i);
+        oldCellIds->SetValue(i, order[i]);
+      }
+    });
+    output->GetCellData()->AddArray(newCellIds);
+    newCellIds->Delete();
     output->GetCellData()->AddArray(oldCellIds);
     oldCellIds->Delete();
   }
-  else
-  {
-    delete[] order;
-  }
 
   tmpInput->Delete();
 
@@ -11,6 +11,14 @@
  * specifying a camera and/or prop to define a view direction; or
  * explicitly set a view direction.
  *
+ * The depths of the cells are computed, and the cells sorted by a radix sort
+ * of their depths and copied to the output, in parallel using vtkSMPTools.
+ * Cells of equal depth keep the order of their ids, so that the output does
+ * not depend on the number of threads. The order of the previous execution
+ * is reused as a starting point when the number of cells is unchanged: it is
+ * kept as is when still sorted, and finished with an insertion sort when
+ * nearly sorted, which makes sorting cheap for a slowly moving camera.
+ *
  * @warning
  * The sort operation will not work well for long, thin primitives, or cells
  * that intersect, overlap, or interpenetrate each other.
@@ -22,6 +30,8 @@
 #include "vtkFiltersHybridModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+#include <vector> // For std::vector
+
 VTK_ABI_NAMESPACE_BEGIN
 class vtkCamera;
 class vtkProp3D;
@@ -152,6 +162,9 @@ protected:
   double Origin[3];
   vtkTypeBool SortScalars;
 
+  // The order of the cells of the previous execution
+  std::vector<vtkIdType> PreviousOrder;
+
 private:
   vtkDepthSortPolyData(const vtkDepthSortPolyData&) = delete;
   void operator=(const vtkDepthSortPolyData&) = delete;
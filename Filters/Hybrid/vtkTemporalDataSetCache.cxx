@@ -2,18 +2,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkTemporalDataSetCache.h"
 
+#include "vtkAlgorithmOutput.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkFeatures.h" // for VTK_USE_MEMKIND
 #include "vtkImageData.h"
 #include "vtkInformation.h"
+#include "vtkInformationExecutivePortVectorKey.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStamp.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 // A helper class to to turn on memkind, if enabled, while ensuring it always is restored
@@ -45,11 +50,64 @@ public:
   vtkTDSCMemkindRAII(vtkTDSCMemkindRAII const&) = default;
 };
 
+//------------------------------------------------------------------------------
+// State of the prefetch, which only happens on the thread updating the
+// pipeline, between two requests.
+struct vtkTemporalDataSetCache::vtkPrefetchInternals
+{
+  bool HasLastRequestedTime = false;
+  double LastRequestedTime = 0.0;
+  bool Backward = false;
+  // True when the input holds the data of the last prefetch rather than the
+  // data of a request, which may have failed.
+  bool InputFromPrefetch = false;
+  // The current time step and the prefetch window, which are not evicted to
+  // store the prefetched time steps.
+  std::vector<double> Window;
+  // The time steps of the window that remain to be fetched, in order.
+  std::vector<double> Pending;
+};
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Return true if no algorithm upstream of the given one feeds another
+// consumer, i.e. if the upstream pipeline can be updated from another thread
+// without affecting other pipeline branches.
+bool IsUpstreamExclusive(vtkAlgorithm* algorithm)
+{
+  for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+  {
+    for (int idx = 0; idx < algorithm->GetNumberOfInputConnections(port); ++idx)
+    {
+      vtkAlgorithm* producer = algorithm->GetInputAlgorithm(port, idx);
+      if (!producer)
+      {
+        continue;
+      }
+      vtkExecutive* executive = producer->GetExecutive();
+      int numberOfConsumers = 0;
+      for (int outPort = 0; outPort < producer->GetNumberOfOutputPorts(); ++outPort)
+      {
+        numberOfConsumers +=
+          vtkExecutive::CONSUMERS()->Length(executive->GetOutputInformation(outPort));
+      }
+      if (numberOfConsumers != 1 || !::IsUpstreamExclusive(producer))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkStandardNewMacro(vtkTemporalDataSetCache);
 
 //------------------------------------------------------------------------------
 vtkTemporalDataSetCache::vtkTemporalDataSetCache()
+  : Prefetch(new vtkPrefetchInternals())
 {
   this->CacheSize = 10;
   this->SetNumberOfInputPorts(1);
@@ -128,6 +186,8 @@ void vtkTemporalDataSetCache::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "NumberOfPrefetchedTimeSteps: " << this->NumberOfPrefetchedTimeSteps << endl;
+  os << indent << "PrefetchMemoryLimit: " << this->PrefetchMemoryLimit << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -432,9 +492,22 @@ int vtkTemporalDataSetCache::RequestData(vtkInformation* vtkNotUsed(request),
   outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
   output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), upTime);
 
+  // keep track of the animation direction for prefetching
+  auto& prefetch = *this->Prefetch;
+  if (prefetch.HasLastRequestedTime && upTime != prefetch.LastRequestedTime)
+  {
+    prefetch.Backward = upTime < prefetch.LastRequestedTime;
+  }
+  prefetch.HasLastRequestedTime = true;
+  prefetch.LastRequestedTime = upTime;
+  if (inTime == upTime)
+  {
+    prefetch.InputFromPrefetch = false;
+  }
+
   // now we need to update the cache, based on the new data and the cache
   // size add the requested data to the cache first
-  if (input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+  if (input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()) && !prefetch.InputFromPrefetch)
   {
     // nothing to do if the input time is already in the cache
     CacheType::iterator pos1 = this->Cache.find(inTime);
@@ -475,6 +548,8 @@ int vtkTemporalDataSetCache::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  this->QueuePrefetch(inInfo);
+
   this->CheckAbort();
   return 1;
 }
@@ -496,6 +571,160 @@ void vtkTemporalDataSetCache::ReplaceCacheItem(
   this->Cache[inTime] = std::pair<unsigned long, vtkDataObject*>(outputUpdateTime, cachedData);
 }
 
+//------------------------------------------------------------------------------
+void vtkTemporalDataSetCache::QueuePrefetch(vtkInformation* inInfo)
+{
+  auto& prefetch = *this->Prefetch;
+  prefetch.Window.clear();
+  prefetch.Pending.clear();
+  if (this->NumberOfPrefetchedTimeSteps == 0 || this->IsASource || this->CacheInMemkind ||
+    this->GetNumberOfInputConnections(0) != 1 ||
+    !inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) || !::IsUpstreamExclusive(this))
+  {
+    return;
+  }
+
+  // The time steps following the current one in the animation direction.
+  const double* timeSteps = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const int numberOfTimeSteps = inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  const double current = prefetch.LastRequestedTime;
+  if (prefetch.Backward)
+  {
+    for (auto it = std::lower_bound(timeSteps, timeSteps + numberOfTimeSteps, current);
+         it != timeSteps &&
+         static_cast<int>(prefetch.Window.size()) < this->NumberOfPrefetchedTimeSteps;)
+    {
+      prefetch.Window.push_back(*--it);
+    }
+  }
+  else
+  {
+    for (auto it = std::upper_bound(timeSteps, timeSteps + numberOfTimeSteps, current);
+         it != timeSteps + numberOfTimeSteps &&
+         static_cast<int>(prefetch.Window.size()) < this->NumberOfPrefetchedTimeSteps;
+         ++it)
+    {
+      prefetch.Window.push_back(*it);
+    }
+  }
+
+  for (double time : prefetch.Window)
+  {
+    if (this->Cache.find(time) == this->Cache.end())
+    {
+      prefetch.Pending.push_back(time);
+    }
+  }
+  prefetch.Window.push_back(current);
+}
+
+//------------------------------------------------------------------------------
+int vtkTemporalDataSetCache::GetNumberOfPendingTimeSteps()
+{
+  return static_cast<int>(this->Prefetch->Pending.size());
+}
+
+//------------------------------------------------------------------------------
+bool vtkTemporalDataSetCache::PrefetchNextTimeStep()
+{
+  auto& prefetch = *this->Prefetch;
+  if (prefetch.Pending.empty())
+  {
+    return false;
+  }
+  const double time = prefetch.Pending.front();
+  prefetch.Pending.erase(prefetch.Pending.begin());
+
+  // The current time step and the prefetch window stay in the cache, the
+  // other time steps may be evicted to make room for the prefetched one.
+  size_t numberOfKept = 0;
+  unsigned long used = 0;
+  for (const auto& item : this->Cache)
+  {
+    if (std::find(prefetch.Window.begin(), prefetch.Window.end(), item.first) !=
+      prefetch.Window.end())
+    {
+      ++numberOfKept;
+      used += item.second.second->GetActualMemorySize();
+    }
+  }
+  if (numberOfKept >= static_cast<size_t>(this->CacheSize) ||
+    (this->PrefetchMemoryLimit > 0 && used >= this->PrefetchMemoryLimit))
+  {
+    prefetch.Pending.clear();
+    return false;
+  }
+
+  // The prefetched data is newer than the pipeline modification time, it is
+  // discarded by the next request if an upstream algorithm is modified.
+  vtkTimeStamp fetchTime;
+  fetchTime.Modified();
+  auto producer = vtkStreamingDemandDrivenPipeline::SafeDownCast(this->GetInputExecutive(0, 0));
+  const int port = this->GetInputConnection(0, 0)->GetIndex();
+  prefetch.InputFromPrefetch = true;
+  vtkNew<vtkInformation> request;
+  request->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), time);
+  vtkNew<vtkInformationVector> requests;
+  requests->SetInformationObject(port, request);
+  if (!producer || !producer->Update(port, requests))
+  {
+    prefetch.Pending.clear();
+    return false;
+  }
+  vtkDataObject* data = producer->GetOutputData(port);
+  if (!data || !data->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()) ||
+    data->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) != time)
+  {
+    prefetch.Pending.clear();
+    return false;
+  }
+  const unsigned long size = this->PrefetchMemoryLimit > 0 ? data->GetActualMemorySize() : 0;
+  if (this->PrefetchMemoryLimit > 0 && used + size > this->PrefetchMemoryLimit)
+  {
+    prefetch.Pending.clear();
+    return false;
+  }
+
+  // Make room by evicting the least recently used time steps out of the
+  // window.
+  while (true)
+  {
+    unsigned long cached = 0;
+    auto oldest = this->Cache.end();
+    for (auto pos = this->Cache.begin(); pos != this->Cache.end(); ++pos)
+    {
+      if (this->PrefetchMemoryLimit > 0)
+      {
+        cached += pos->second.second->GetActualMemorySize();
+      }
+      if (std::find(prefetch.Window.begin(), prefetch.Window.end(), pos->first) ==
+          prefetch.Window.end() &&
+        (oldest == this->Cache.end() || pos->second.first < oldest->second.first))
+      {
+        oldest = pos;
+      }
+    }
+    if (this->Cache.size() < static_cast<size_t>(this->CacheSize) &&
+      (this->PrefetchMemoryLimit == 0 || cached + size <= this->PrefetchMemoryLimit))
+    {
+      break;
+    }
+    if (oldest == this->Cache.end())
+    {
+      prefetch.Pending.clear();
+      return false;
+    }
+    oldest->second.second->UnRegister(this);
+    this->Cache.erase(oldest);
+  }
+
+  vtkDataObject* cachedData = data->NewInstance();
+  cachedData->DeepCopy(data);
+  cachedData->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+  this->Cache[time] = std::pair<unsigned long, vtkDataObject*>(fetchTime.GetMTime(), cachedData);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 void vtkTemporalDataSetCache::SetEjected(vtkDataObject* victim)
 {
@@ -6,6 +6,10 @@
  *
  * vtkTemporalDataSetCache cache time step requests of a temporal dataset,
  * when cached data is requested it is returned using a shallow copy.
+ *
+ * The cache can also prefetch the time steps that follow the last requested
+ * one (see NumberOfPrefetchedTimeSteps and PrefetchNextTimeStep), so that
+ * animating through time is not limited by the latency of upstream readers.
  * @par Thanks:
  * Ken Martin (Kitware) and John Bidiscombe of
  * CSCS - Swiss National Supercomputing Centre
@@ -23,6 +27,7 @@
 
 #include "vtkAlgorithm.h"
 #include <map>    // used for the cache
+#include <memory> // used for the prefetch internals
 #include <vector> // used for the timestep records
 
 VTK_ABI_NAMESPACE_BEGIN
@@ -62,6 +67,49 @@ public:
   vtkBooleanMacro(IsASource, bool);
   ///@}
 
+  ///@{
+  /**
+   * Number of input time steps following the last requested one, in the
+   * direction of the last two distinct requests (forward by default), that
+   * are queued for prefetching once a request has been served. They are
+   * fetched by PrefetchNextTimeStep() and added to the cache so that the next
+   * requests do not wait for the upstream pipeline. 0 disables prefetching.
+   * Default is 0.
+   *
+   * Prefetching only happens when the pipeline upstream of this filter has no
+   * other consumer, and is disabled when IsASource or CacheInMemkind is on.
+   */
+  vtkSetClampMacro(NumberOfPrefetchedTimeSteps, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfPrefetchedTimeSteps, int);
+  ///@}
+
+  ///@{
+  /**
+   * Memory budget, in kibibytes, of the cached time steps beyond which no
+   * more time steps are prefetched. 0 means that prefetching is only bounded
+   * by the cache size. Default is 0.
+   */
+  vtkSetMacro(PrefetchMemoryLimit, unsigned long);
+  vtkGetMacro(PrefetchMemoryLimit, unsigned long);
+  ///@}
+
+  /**
+   * Update the input for the next queued time step and add it to the cache.
+   * Returns false when there is nothing left to prefetch, or when the time
+   * step could not be fetched or stored, in which case the queue is cleared.
+   *
+   * The upstream pipeline is updated on the calling thread, which must be the
+   * one updating this filter, since executives are not thread safe. It is
+   * meant to be called between two requests, e.g. from an idle or timer
+   * callback of the application event loop once a frame has been rendered.
+   */
+  bool PrefetchNextTimeStep();
+
+  /**
+   * Number of time steps queued for prefetching by the last request.
+   */
+  int GetNumberOfPendingTimeSteps();
+
 protected:
   vtkTemporalDataSetCache();
   ~vtkTemporalDataSetCache() override;
@@ -102,6 +150,12 @@ private:
   void SetEjected(vtkDataObject*);
   vtkGetObjectMacro(Ejected, vtkDataObject);
   vtkDataObject* Ejected;
+
+  void QueuePrefetch(vtkInformation* inInfo);
+  int NumberOfPrefetchedTimeSteps = 0;
+  unsigned long PrefetchMemoryLimit = 0;
+  struct vtkPrefetchInternals;
+  std::unique_ptr<vtkPrefetchInternals> Prefetch;
 };
 
 VTK_ABI_NAMESPACE_END
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkRibbonFilter produces the same output whatever the number of
+// threads, on polylines sharing points, and that the ribbons are placed
+// around the polylines.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRibbonFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+// Helices starting from a shared seed point, optionally with a repeated
+// point in each of them, plus a polyline made of a single point.
+vtkSmartPointer<vtkPolyData> MakeLines(
+  vtkIdType numLines, vtkIdType numPtsPerLine, bool repeatPoint)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIntArray> lineIds;
+  lineIds->SetName("LineIds");
+
+  const vtkIdType seedId = points->InsertNextPoint(0.0, 0.0, 0.0);
+  scalars->InsertNextValue(1.0);
+  for (vtkIdType lineId = 0; lineId < numLines; lineId++)
+  {
+    const double angle = 2.0 * vtkMath::Pi() * lineId / numLines;
+    lines->InsertNextCell(numPtsPerLine + (repeatPoint ? 2 : 1));
+    lines->InsertCellPoint(seedId);
+    for (vtkIdType i = 1; i <= numPtsPerLine; i++)
+    {
+      const double t = 0.1 * i;
+      const vtkIdType ptId = points->InsertNextPoint(
+        t * std::cos(angle) + 0.05 * std::cos(5.0 * t), t * std::sin(angle), 0.2 * std::sin(t));
+      scalars->InsertNextValue(1.0 + t);
+      lines->InsertCellPoint(ptId);
+      if (repeatPoint && i == numPtsPerLine / 2)
+      {
+        lines->InsertCellPoint(ptId);
+      }
+    }
+    lineIds->InsertNextValue(static_cast<int>(lineId));
+  }
+  lines->InsertNextCell(1, &seedId);
+  lineIds->InsertNextValue(static_cast<int>(numLines));
+
+  vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->SetLines(lines);
+  polyData->GetPointData()->SetScalars(scalars);
+  polyData->GetCellData()->AddArray(lineIds);
+  return polyData;
+}
+
+// Each of the `numLines` helices of `numPtsPerLine + 1` distinct points gets
+// `pointsPerLinePoint` points around each of its points, at `distance` from it.
+bool CheckPlacement(vtkPolyData* lines, vtkPolyData* output, vtkIdType numLines,
+  vtkIdType numPtsPerLine, int pointsPerLinePoint, double distance)
+{
+  if (output->GetNumberOfPoints() != numLines * (numPtsPerLine + 1) * pointsPerLinePoint)
+  {
+    vtkLog(ERROR, "Unexpected number of ribbon points: " << output->GetNumberOfPoints());
+    return false;
+  }
+  vtkIdType outPtId = 0;
+  for (vtkIdType lineId = 0; lineId < numLines; lineId++)
+  {
+    for (vtkIdType i = 0; i <= numPtsPerLine; i++)
+    {
+      double center[3];
+      lines->GetPoint(i == 0 ? 0 : 1 + lineId * numPtsPerLine + i - 1, center);
+      for (int j = 0; j < pointsPerLinePoint; j++, outPtId++)
+      {
+        double p[3];
+        output->GetPoint(outPtId, p);
+        if (std::abs(std::sqrt(vtkMath::Distance2BetweenPoints(p, center)) - distance) > 1e-6)
+        {
+          vtkLog(ERROR, "Point " << outPtId << " is not at the expected distance of its line.");
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestRibbonFilterThreads(int, char*[])
+{
+  // vtkRibbonFilter does not skip repeated points.
+  vtkSmartPointer<vtkPolyData> lines = ::MakeLines(200, 50, false);
+
+  vtkNew<vtkRibbonFilter> ribbons;
+  ribbons->SetInputData(lines);
+  ribbons->SetWidth(0.01);
+  ribbons->VaryWidthOn();
+  ribbons->SetGenerateTCoordsToUseLength();
+  if (!vtkTestUtilities::CompareThreadedOutputs(ribbons) ||
+    ribbons->GetOutput()->GetNumberOfStrips() == 0)
+  {
+    vtkLog(ERROR, "Threaded ribbons differ.");
+    return EXIT_FAILURE;
+  }
+
+  // With a constant width, each polyline point gets one ribbon point on each
+  // side, at the half width from it.
+  ribbons->VaryWidthOff();
+  vtkNew<vtkPolyData> output;
+  if (!vtkTestUtilities::CompareThreadedOutputs(ribbons, 4, output) ||
+    output->GetNumberOfStrips() != 200 || !::CheckPlacement(lines, output, 200, 50, 2, 0.01))
+  {
+    vtkLog(ERROR, "Unexpected ribbons.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
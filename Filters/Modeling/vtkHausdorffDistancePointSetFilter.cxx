@@ -9,11 +9,17 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 
-#include "vtkCellLocator.h"
 #include "vtkGenericCell.h"
-#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
 #include "vtkPointSet.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkHausdorffDistancePointSetFilter);
@@ -68,15 +74,15 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
   this->RelativeDistance[1] = 0.0;
   this->HausdorffDistance = 0.0;
 
-  // TODO: using vtkStaticCellLocator, vtkStaticPointLocator is going to be much faster.
-  // Need to investigate and replace if appropriate.
-  vtkSmartPointer<vtkKdTreePointLocator> pointLocatorA =
-    vtkSmartPointer<vtkKdTreePointLocator>::New();
-  vtkSmartPointer<vtkKdTreePointLocator> pointLocatorB =
-    vtkSmartPointer<vtkKdTreePointLocator>::New();
+  vtkSmartPointer<vtkStaticPointLocator> pointLocatorA =
+    vtkSmartPointer<vtkStaticPointLocator>::New();
+  vtkSmartPointer<vtkStaticPointLocator> pointLocatorB =
+    vtkSmartPointer<vtkStaticPointLocator>::New();
 
-  vtkSmartPointer<vtkCellLocator> cellLocatorA = vtkSmartPointer<vtkCellLocator>::New();
-  vtkSmartPointer<vtkCellLocator> cellLocatorB = vtkSmartPointer<vtkCellLocator>::New();
+  vtkSmartPointer<vtkStaticCellLocator> cellLocatorA =
+    vtkSmartPointer<vtkStaticCellLocator>::New();
+  vtkSmartPointer<vtkStaticCellLocator> cellLocatorB =
+    vtkSmartPointer<vtkStaticCellLocator>::New();
 
   if (this->TargetDistanceMethod == POINT_TO_POINT)
   {
@@ -93,13 +99,6 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
     cellLocatorB->BuildLocator();
   }
 
-  double dist;
-  double currentPoint[3];
-  double closestPoint[3];
-  vtkIdType cellId;
-  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
-  int subId;
-
   vtkSmartPointer<vtkDoubleArray> distanceAToB = vtkSmartPointer<vtkDoubleArray>::New();
   distanceAToB->SetNumberOfComponents(1);
   distanceAToB->SetNumberOfTuples(inputA->GetNumberOfPoints());
@@ -110,63 +109,66 @@ int vtkHausdorffDistancePointSetFilter::RequestData(vtkInformation* vtkNotUsed(r
   distanceBToA->SetNumberOfTuples(inputB->GetNumberOfPoints());
   distanceBToA->SetName("Distance");
 
-  // Find the nearest neighbors to each point and add edges between them,
-  // if they do not already exist and they are not self loops
-  for (int i = 0; i < inputA->GetNumberOfPoints(); i++)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    inputA->GetPoint(i, currentPoint);
-    if (this->TargetDistanceMethod == POINT_TO_POINT)
-    {
-      vtkIdType closestPointId = pointLocatorB->FindClosestPoint(currentPoint);
-      inputB->GetPoint(closestPointId, closestPoint);
-    }
-    else
-    {
-      cellLocatorB->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist);
-    }
-
-    dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
-      std::pow(currentPoint[1] - closestPoint[1], 2) +
-      std::pow(currentPoint[2] - closestPoint[2], 2));
-    distanceAToB->SetValue(i, dist);
-
-    if (dist > this->RelativeDistance[0])
-    {
-      this->RelativeDistance[0] = dist;
-    }
-  }
-
-  for (int i = 0; i < inputB->GetNumberOfPoints(); i++)
-  {
-    if (this->CheckAbort())
-    {
-      break;
-    }
-    inputB->GetPoint(i, currentPoint);
-    if (this->TargetDistanceMethod == POINT_TO_POINT)
+  // Find the distance from each point of the source to the target in
+  // parallel, and the largest of these distances. The static locators are
+  // thread safe once built.
+  auto computeDistances = [this](vtkPointSet* source, vtkPointSet* target,
+                            vtkStaticPointLocator* pointLocator, vtkStaticCellLocator* cellLocator,
+                            vtkDoubleArray* distances) {
+    vtkSMPThreadLocal<double> tlMaxDist(0.0);
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPTools::For(0, source->GetNumberOfPoints(), [&](vtkIdType begin, vtkIdType end) {
+      double& maxDist = tlMaxDist.Local();
+      vtkGenericCell* cell = tlCell.Local();
+      double currentPoint[3];
+      double closestPoint[3];
+      double dist2;
+      vtkIdType cellId;
+      int subId;
+      bool isFirst = vtkSMPTools::GetSingleThread();
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        if (isFirst)
+        {
+          this->CheckAbort();
+        }
+        if (this->GetAbortOutput())
+        {
+          break;
+        }
+        source->GetPoint(i, currentPoint);
+        if (this->TargetDistanceMethod == POINT_TO_POINT)
+        {
+          vtkIdType closestPointId = pointLocator->FindClosestPoint(currentPoint);
+          target->GetPoint(closestPointId, closestPoint);
+        }
+        else
+        {
+          cellLocator->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist2);
+        }
+
+        const double dist = std::sqrt(vtkMath::Distance2BetweenPoints(currentPoint, closestPoint));
+        distances->SetValue(i, dist);
+
+        if (dist > maxDist)
+        {
+          maxDist = dist;
+        }
+      }
+    });
+
+    double maxDist = 0.0;
+    for (double threadMaxDist : tlMaxDist)
     {
-      vtkIdType closestPointId = pointLocatorA->FindClosestPoint(currentPoint);
-      inputA->GetPoint(closestPointId, closestPoint);
+      maxDist = std::max(maxDist, threadMaxDist);
     }
-    else
-    {
-      cellLocatorA->FindClosestPoint(currentPoint, closestPoint, cell, cellId, subId, dist);
-    }
-
-    dist = std::sqrt(std::pow(currentPoint[0] - closestPoint[0], 2) +
-      std::pow(currentPoint[1] - closestPoint[1], 2) +
-      std::pow(currentPoint[2] - closestPoint[2], 2));
-    distanceBToA->SetValue(i, dist);
+    return maxDist;
+  };
 
-    if (dist > this->RelativeDistance[1])
-    {
-      this->RelativeDistance[1] = dist;
-    }
-  }
+  this->RelativeDistance[0] =
+    computeDistances(inputA, inputB, pointLocatorB, cellLocatorB, distanceAToB);
+  this->RelativeDistance[1] =
+    computeDistances(inputB, inputA, pointLocatorA, cellLocatorA, distanceBToA);
 
   if (this->RelativeDistance[0] >= RelativeDistance[1])
   {
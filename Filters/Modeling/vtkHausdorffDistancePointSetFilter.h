@@ -17,6 +17,10 @@
  * latter may differ. A PointData containing the specific point minimal
  * distance is also added to both outputs.
  *
+ * The closest points are searched in parallel with vtkSMPTools, using
+ * vtkStaticPointLocator or vtkStaticCellLocator depending on the
+ * TargetDistanceMethod.
+ *
  * @author Frederic Commandeur
  * @author Jerome Velut
  * @author LTSI
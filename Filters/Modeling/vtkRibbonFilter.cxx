@@ -3,16 +3,27 @@
 #include "vtkRibbonFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <atomic>
+#include <numeric>
+#include <vector>
 
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkRibbonFilter);
@@ -163,8 +174,29 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
   vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
+
+  // The number of points of each ribbon is known up front, so the ribbons
+  // are generated in parallel, each one at its place in the output. Should
+  // a polyline fail to be ribboned the places of the following ones are
+  // wrong, so the serial loop below is run instead.
+  bool generated = this->GenerateRibbonsInParallel(input, output, inScalars, range,
+    generateNormals ? nullptr : inNormals, newPts, newNormals, newTCoords, newStrips);
+  abort = this->GetAbortOutput();
+  if (!generated && !abort)
+  {
+    newPts->Reset();
+    newNormals->Reset();
+    if (newTCoords)
+    {
+      newTCoords->Reset();
+    }
+    outPD->Reset();
+    outCD->Reset();
+    newStrips->Reset();
+  }
+
+  for (inCellId = 0, inLines->InitTraversal();
+       !generated && !abort && inLines->GetNextCell(npts, pts); inCellId++)
   {
     this->UpdateProgress((double)inCellId / numLines);
     abort = this->CheckAbort();
@@ -244,9 +276,155 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+bool vtkRibbonFilter::GenerateRibbonsInParallel(vtkPolyData* input, vtkPolyData* output,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals, vtkPoints* newPts,
+  vtkFloatArray* newNormals, vtkFloatArray* newTCoords, vtkCellArray* newStrips)
+{
+  vtkPoints* inPts = input->GetPoints();
+  vtkCellArray* inLines = input->GetLines();
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  vtkCellData* cd = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  const vtkIdType numLines = inLines->GetNumberOfCells();
+
+  // Each polyline of at least two points produces one strip with two
+  // points per polyline point.
+  std::vector<vtkIdType> ptOffsets(numLines + 1);
+  std::vector<vtkIdType> cellIds(numLines);
+  ptOffsets[0] = 0;
+  vtkIdType numNewCells = 0;
+  for (vtkIdType lineId = 0; lineId < numLines; lineId++)
+  {
+    const vtkIdType npts = inLines->GetCellSize(lineId);
+    ptOffsets[lineId + 1] = ptOffsets[lineId];
+    cellIds[lineId] = numNewCells;
+    if (npts >= 2)
+    {
+      ptOffsets[lineId + 1] = this->ComputeOffset(ptOffsets[lineId], npts);
+      numNewCells++;
+    }
+  }
+  const vtkIdType numNewPts = ptOffsets[numLines];
+
+  newPts->SetNumberOfPoints(numNewPts);
+  newNormals->SetNumberOfTuples(numNewPts);
+  if (newTCoords)
+  {
+    newTCoords->SetNumberOfTuples(numNewPts);
+  }
+  outPD->SetNumberOfTuples(numNewPts);
+  outCD->SetNumberOfTuples(numNewCells);
+  vtkNew<vtkIdTypeArray> stripOffsets;
+  stripOffsets->SetNumberOfValues(numNewCells + 1);
+  stripOffsets->SetValue(numNewCells, numNewPts);
+  vtkNew<vtkIdTypeArray> stripConnectivity;
+  stripConnectivity->SetNumberOfValues(numNewPts);
+
+  // Generate the ribbons. Normals are generated per polyline in thread
+  // local arrays since polylines may share points.
+  std::atomic<bool> failed(false);
+  vtkSMPThreadLocalObject<vtkPoints> localLinePts;
+  vtkSMPThreadLocalObject<vtkCellArray> localLine;
+  vtkSMPThreadLocalObject<vtkFloatArray> localNormals;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> localNormalIds;
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end) {
+    vtkSmartPointer<vtkCellArrayIterator> iter;
+    iter.TakeReference(inLines->NewIterator());
+    vtkPoints* linePts = localLinePts.Local();
+    linePts->SetDataTypeToDouble();
+    vtkCellArray* line = localLine.Local();
+    vtkFloatArray* lineNormals = localNormals.Local();
+    lineNormals->SetNumberOfComponents(3);
+    std::vector<vtkIdType>& normalIds = localNormalIds.Local();
+    bool isFirst = vtkSMPTools::GetSingleThread();
+
+    for (vtkIdType lineId = begin; lineId < end && !failed; lineId++)
+    {
+      if (isFirst && !(lineId % 1000))
+      {
+        this->CheckAbort();
+      }
+      if (this->GetAbortOutput())
+      {
+        break;
+      }
+
+      vtkIdType npts;
+      const vtkIdType* pts;
+      iter->GetCellAtId(lineId, npts, pts);
+      if (npts < 2)
+      {
+        vtkWarningMacro(<< "Less than two points in line!");
+        continue; // skip tubing this polyline
+      }
+      const vtkIdType offset = ptOffsets[lineId];
+
+      // If necessary calculate the normals of the polyline on a copy of
+      // its points.
+      vtkDataArray* normals = inNormals;
+      const vtkIdType* ids = pts;
+      if (!inNormals)
+      {
+        normalIds.resize(npts);
+        std::iota(normalIds.begin(), normalIds.end(), 0);
+        linePts->SetNumberOfPoints(npts);
+        for (vtkIdType i = 0; i < npts; i++)
+        {
+          double x[3];
+          inPts->GetPoint(pts[i], x);
+          linePts->SetPoint(i, x);
+        }
+        line->Reset();
+        line->InsertNextCell(npts, normalIds.data());
+        lineNormals->SetNumberOfTuples(npts);
+        vtkPolyLine::GenerateSlidingNormals(linePts, line, lineNormals);
+        normals = lineNormals;
+        ids = normalIds.data();
+      }
+
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, normals, ids))
+      {
+        failed = true;
+        break;
+      }
+
+      const vtkIdType cellId = cellIds[lineId];
+      stripOffsets->SetValue(cellId, offset);
+      for (vtkIdType i = 0; i < 2 * npts; i++)
+      {
+        stripConnectivity->SetValue(offset + i, offset + i);
+      }
+      outCD->CopyData(cd, lineId, cellId);
+
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
+    }
+  });
+
+  if (failed || this->GetAbortOutput())
+  {
+    return false;
+  }
+  newStrips->SetData(stripOffsets, stripConnectivity);
+  return true;
+}
+
 int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
   vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
   vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
+{
+  return this->GeneratePoints(
+    offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals, pts);
+}
+
+int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
+  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
+  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals,
+  const vtkIdType* normalIds)
 {
   vtkIdType j;
   int i;
@@ -299,7 +477,7 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
       }
     }
 
-    inNormals->GetTuple(pts[j], n);
+    inNormals->GetTuple(normalIds[j], n);
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
@@ -0,0 +1,242 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the parallel clustering of vtkEuclideanClusterExtraction does
+// not depend on the number of threads, that it finds the clusters of the
+// serial traversal, with and without scalar connectivity, and that without
+// it the clusters are the connected components of a brute force search.
+
+#include "vtkDataArray.h"
+#include "vtkEuclideanClusterExtraction.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace
+{
+// The cluster of each extracted input point.
+std::map<vtkIdType, vtkIdType> GetClusters(vtkPolyData* output)
+{
+  std::map<vtkIdType, vtkIdType> clusters;
+  vtkDataArray* ids = output->GetPointData()->GetArray("Ids");
+  vtkDataArray* clusterIds = output->GetPointData()->GetArray("ClusterId");
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    clusters[static_cast<vtkIdType>(ids->GetComponent(ptId, 0))] =
+      static_cast<vtkIdType>(clusterIds->GetComponent(ptId, 0));
+  }
+  return clusters;
+}
+
+// Label the connected components of the points closer than the radius by
+// comparing the points of a sliding window along x.
+std::vector<vtkIdType> LabelComponents(vtkPolyData* cloud, double radius)
+{
+  const vtkIdType numPts = cloud->GetNumberOfPoints();
+  std::vector<vtkIdType> order(numPts);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+    [cloud](vtkIdType a, vtkIdType b) { return cloud->GetPoint(a)[0] < cloud->GetPoint(b)[0]; });
+
+  std::vector<vtkIdType> parents(numPts);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find = [&parents](vtkIdType id)
+  {
+    while (parents[id] != id)
+    {
+      id = parents[id] = parents[parents[id]];
+    }
+    return id;
+  };
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    cloud->GetPoint(order[i], x);
+    for (vtkIdType j = i + 1; j < numPts; ++j)
+    {
+      double y[3];
+      cloud->GetPoint(order[j], y);
+      if (y[0] - x[0] > radius)
+      {
+        break;
+      }
+      if (vtkMath::Distance2BetweenPoints(x, y) <= radius * radius)
+      {
+        parents[find(order[i])] = find(order[j]);
+      }
+    }
+  }
+  for (vtkIdType id = 0; id < numPts; ++id)
+  {
+    parents[id] = find(id);
+  }
+  return parents;
+}
+
+// Check that the extracted points are the points of the given components,
+// and that the points of a component are in the same cluster.
+bool HasComponents(vtkPolyData* output, const std::vector<vtkIdType>& components,
+  const std::set<vtkIdType>& expectedComponents)
+{
+  std::map<vtkIdType, vtkIdType> clusters = GetClusters(output);
+  vtkIdType expectedNumPts = 0;
+  for (vtkIdType component : components)
+  {
+    expectedNumPts += expectedComponents.count(component);
+  }
+  if (static_cast<vtkIdType>(clusters.size()) != expectedNumPts)
+  {
+    vtkLog(ERROR, << clusters.size() << " points extracted instead of " << expectedNumPts);
+    return false;
+  }
+  std::map<vtkIdType, vtkIdType> componentClusters;
+  for (const auto& ptCluster : clusters)
+  {
+    const vtkIdType component = components[ptCluster.first];
+    if (!expectedComponents.count(component) ||
+      componentClusters.emplace(component, ptCluster.second).first->second != ptCluster.second)
+    {
+      vtkLog(ERROR, "Point " << ptCluster.first << " is in the wrong cluster.");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Blobs of random points on a lattice, with random scalars.
+vtkSmartPointer<vtkPolyData> MakePointCloud()
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1177);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  for (int blob = 0; blob < 27; ++blob)
+  {
+    double center[3] = { 10.0 * (blob % 3), 10.0 * ((blob / 3) % 3), 10.0 * (blob / 9) };
+    for (int i = 0; i < 400 + 50 * blob; ++i)
+    {
+      double x[3];
+      for (int c = 0; c < 3; ++c)
+      {
+        x[c] = random->GetNextRangeValue(center[c] - 2.0, center[c] + 2.0);
+      }
+      ids->InsertNextValue(points->InsertNextPoint(x));
+      scalars->InsertNextValue(random->GetNextValue());
+    }
+  }
+  vtkSmartPointer<vtkPolyData> cloud = vtkSmartPointer<vtkPolyData>::New();
+  cloud->SetPoints(points);
+  cloud->GetPointData()->SetScalars(scalars);
+  cloud->GetPointData()->AddArray(ids);
+  return cloud;
+}
+}
+
+int TestEuclideanClusterExtractionThreads(int, char*[])
+{
+  vtkSmartPointer<vtkPolyData> cloud = MakePointCloud();
+
+  // A seed satisfying the scalar connectivity criterion, also used as the
+  // closest point.
+  vtkIdType seedId = 5000;
+  while (cloud->GetPointData()->GetScalars()->GetComponent(seedId, 0) < 0.2)
+  {
+    ++seedId;
+  }
+
+  const std::vector<vtkIdType> components = LabelComponents(cloud, 0.6);
+  std::map<vtkIdType, vtkIdType> componentSizes;
+  for (vtkIdType component : components)
+  {
+    ++componentSizes[component];
+  }
+  auto largest = std::max_element(componentSizes.begin(), componentSizes.end(),
+    [](const std::pair<const vtkIdType, vtkIdType>& a,
+      const std::pair<const vtkIdType, vtkIdType>& b) { return a.second < b.second; });
+  std::map<int, std::set<vtkIdType>> expectedComponents;
+  expectedComponents[VTK_EXTRACT_POINT_SEEDED_CLUSTERS] = { components[17], components[seedId] };
+  expectedComponents[VTK_EXTRACT_LARGEST_CLUSTER] = { largest->first };
+  expectedComponents[VTK_EXTRACT_CLOSEST_POINT_CLUSTER] = { components[seedId] };
+  for (const auto& componentSize : componentSizes)
+  {
+    expectedComponents[VTK_EXTRACT_ALL_CLUSTERS].insert(componentSize.first);
+  }
+
+  bool success = true;
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_CLUSTERS; mode <= VTK_EXTRACT_CLOSEST_POINT_CLUSTER;
+       ++mode)
+  {
+    for (int scalarConnectivity = 0; scalarConnectivity < 2; ++scalarConnectivity)
+    {
+      vtkNew<vtkEuclideanClusterExtraction> extract;
+      extract->SetInputData(cloud);
+      extract->SetRadius(0.6);
+      extract->SetExtractionMode(mode);
+      extract->SetScalarConnectivity(scalarConnectivity);
+      extract->SetScalarRange(0.2, 1.0);
+      extract->AddSeed(17);
+      extract->AddSeed(seedId);
+      extract->AddSpecifiedCluster(1);
+      extract->AddSpecifiedCluster(4);
+      extract->SetClosestPoint(cloud->GetPoint(seedId));
+      extract->ColorClustersOn();
+      extract->ParallelClusteringOn();
+
+      vtkNew<vtkPolyData> output;
+      if (!vtkTestUtilities::CompareThreadedOutputs(extract, 4, output) ||
+        output->GetNumberOfPoints() == 0 || extract->GetNumberOfExtractedClusters() == 0)
+      {
+        vtkLog(ERROR,
+          "Clusters differ with 1 and 4 threads, mode " << mode << ", scalar connectivity "
+                                                        << scalarConnectivity);
+        success = false;
+      }
+      const int numClusters = extract->GetNumberOfExtractedClusters();
+
+      // Without scalar connectivity, the clusters are the connected components.
+      if (!scalarConnectivity && mode != VTK_EXTRACT_SPECIFIED_CLUSTERS &&
+        (!HasComponents(output, components, expectedComponents[mode]) ||
+          (mode == VTK_EXTRACT_ALL_CLUSTERS &&
+            numClusters != static_cast<int>(componentSizes.size()))))
+      {
+        vtkLog(ERROR, "Wrong clusters with mode " << mode);
+        success = false;
+      }
+
+      // The serial traversal outputs the points in another order, and leaves
+      // holes in the output when extracting the largest or specified clusters.
+      extract->ParallelClusteringOff();
+      extract->Update();
+      vtkPolyData* serialOutput = extract->GetOutput();
+      if (extract->GetNumberOfExtractedClusters() != numClusters ||
+        (mode != VTK_EXTRACT_LARGEST_CLUSTER && mode != VTK_EXTRACT_SPECIFIED_CLUSTERS &&
+          GetClusters(output) != GetClusters(serialOutput)))
+      {
+        vtkLog(ERROR,
+          "Clusters differ from the serial traversal, mode "
+            << mode << ", scalar connectivity " << scalarConnectivity);
+        success = false;
+      }
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,22 +3,265 @@
 #include "vtkEuclideanClusterExtraction.h"
 
 #include "vtkAbstractPointLocator.h"
+#include "vtkArrayDispatch.h"
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkDataArrayRange.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStaticPointLocator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
 VTK_ABI_NAMESPACE_BEGIN
 vtkStandardNewMacro(vtkEuclideanClusterExtraction);
 vtkCxxSetObjectMacro(vtkEuclideanClusterExtraction, Locator, vtkAbstractPointLocator);
 
+//------------------------------------------------------------------------------
+// Helper classes to support the parallel clustering.
+namespace
+{
+
+// Number of points per batch when numbering the clusters and the extracted
+// points, so that the numbering does not depend on the number of threads.
+constexpr vtkIdType ClusterBatchSize = 16384;
+
+//------------------------------------------------------------------------------
+// Disjoint sets of points, which may be merged concurrently. The root of a
+// set is always linked under the root of smaller id, so that the root of a
+// set is its smallest point id whatever the order of the merges.
+class PointSets
+{
+public:
+  PointSets(vtkIdType numPts)
+    : Parents(numPts)
+  {
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        this->Parents[ptId].store(ptId, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  // Find the root of the set of a point, halving the path to the root.
+  vtkIdType Find(vtkIdType ptId)
+  {
+    for (;;)
+    {
+      vtkIdType parent = this->Parents[ptId].load();
+      if (parent == ptId)
+      {
+        return ptId;
+      }
+      vtkIdType grandParent = this->Parents[parent].load();
+      if (grandParent != parent)
+      {
+        this->Parents[ptId].compare_exchange_weak(parent, grandParent);
+      }
+      ptId = grandParent;
+    }
+  }
+
+  // Merge the sets of two points.
+  void Merge(vtkIdType ptId0, vtkIdType ptId1)
+  {
+    for (;;)
+    {
+      vtkIdType root0 = this->Find(ptId0);
+      vtkIdType root1 = this->Find(ptId1);
+      if (root0 == root1)
+      {
+        return;
+      }
+      if (root0 < root1)
+      {
+        std::swap(root0, root1);
+      }
+      if (this->Parents[root0].compare_exchange_strong(root0, root1))
+      {
+        return;
+      }
+    }
+  }
+
+  // Once all the sets are merged, make each point refer to its root.
+  void Flatten()
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Parents.size()),
+      [&](vtkIdType ptId, vtkIdType endPtId) {
+        for (; ptId < endPtId; ++ptId)
+        {
+          this->Parents[ptId].store(this->Find(ptId));
+        }
+      });
+  }
+
+  vtkIdType GetRoot(vtkIdType ptId) const
+  {
+    return this->Parents[ptId].load(std::memory_order_relaxed);
+  }
+
+private:
+  std::vector<std::atomic<vtkIdType>> Parents;
+};
+
+//------------------------------------------------------------------------------
+// Merge the sets of the candidate points within the radius of each other.
+// Each pair of neighbors is merged once, from the point of larger id.
+struct MergeNeighbors
+{
+  vtkEuclideanClusterExtraction* Filter;
+  vtkPoints* Points;
+  vtkAbstractPointLocator* Locator;
+  double Radius;
+  const unsigned char* Candidates;
+  PointSets* Sets;
+
+  // Don't want to allocate working arrays on every thread invocation.
+  vtkSMPThreadLocalObject<vtkIdList> PIds;
+
+  MergeNeighbors(vtkEuclideanClusterExtraction* filter, vtkPoints* points,
+    const unsigned char* candidates, PointSets* sets)
+    : Filter(filter)
+    , Points(points)
+    , Locator(filter->GetLocator())
+    , Radius(filter->GetRadius())
+    , Candidates(candidates)
+    , Sets(sets)
+  {
+  }
+
+  void Initialize()
+  {
+    vtkIdList*& pIds = this->PIds.Local();
+    pIds->Allocate(128); // allocate some memory
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkIdList*& pIds = this->PIds.Local();
+    double x[3];
+    bool isFirst = vtkSMPTools::GetSingleThread();
+    vtkIdType checkAbortInterval = std::min((endPtId - ptId) / 10 + 1, (vtkIdType)1000);
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (ptId % checkAbortInterval == 0)
+      {
+        if (isFirst)
+        {
+          this->Filter->CheckAbort();
+        }
+        if (this->Filter->GetAbortOutput())
+        {
+          break;
+        }
+      }
+      if (!this->Candidates[ptId])
+      {
+        continue;
+      }
+
+      this->Points->GetPoint(ptId, x);
+      this->Locator->FindPointsWithinRadius(this->Radius, x, pIds);
+      vtkIdType numNeighbors = pIds->GetNumberOfIds();
+      for (vtkIdType i = 0; i < numNeighbors; ++i)
+      {
+        vtkIdType neighborId = pIds->GetId(i);
+        if (neighborId < ptId && this->Candidates[neighborId])
+        {
+          this->Sets->Merge(ptId, neighborId);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  static void Execute(vtkEuclideanClusterExtraction* filter, vtkPoints* points,
+    const unsigned char* candidates, PointSets* sets)
+  {
+    MergeNeighbors merge(filter, points, candidates, sets);
+    vtkSMPTools::For(0, points->GetNumberOfPoints(), merge);
+  }
+}; // MergeNeighbors
+
+//------------------------------------------------------------------------------
+// Count the points of each batch satisfying a predicate, and return the
+// offsets of the batches.
+template <typename PredicateT>
+std::vector<vtkIdType> CountByBatches(vtkIdType numPts, PredicateT predicate)
+{
+  vtkIdType numBatches = (numPts - 1) / ClusterBatchSize + 1;
+  std::vector<vtkIdType> offsets(numBatches + 1, 0);
+  vtkSMPTools::For(0, numBatches, [&](vtkIdType batch, vtkIdType endBatch) {
+    for (; batch < endBatch; ++batch)
+    {
+      vtkIdType ptId = batch * ClusterBatchSize;
+      vtkIdType endPtId = std::min(ptId + ClusterBatchSize, numPts);
+      vtkIdType count = 0;
+      for (; ptId < endPtId; ++ptId)
+      {
+        count += predicate(ptId) ? 1 : 0;
+      }
+      offsets[batch + 1] = count;
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  return offsets;
+}
+
+//------------------------------------------------------------------------------
+// Copy the extracted points, their attributes and their cluster ids to the
+// output.
+struct MapClusterPoints
+{
+  template <typename InPointsT, typename OutPointsT>
+  void operator()(InPointsT* inPointsArray, OutPointsT* outPointsArray, const vtkIdType* map,
+    const vtkIdType* clusterIds, vtkIdTypeArray* outClusterIds, vtkPointData* inPD,
+    vtkPointData* outPD)
+  {
+    const auto inPts = vtk::DataArrayTupleRange<3>(inPointsArray);
+    auto outPts = vtk::DataArrayTupleRange<3>(outPointsArray);
+
+    ArrayList arrays;
+    arrays.AddArrays(outPts.size(), inPD, outPD, 0.0, false);
+
+    vtkSMPTools::For(0, inPts.size(), [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        const vtkIdType outPtId = map[ptId];
+        if (outPtId != -1)
+        {
+          outPts[outPtId] = inPts[ptId];
+          arrays.Copy(ptId, outPtId);
+          if (outClusterIds)
+          {
+            outClusterIds->SetValue(outPtId, clusterIds ? clusterIds[ptId] : 0);
+          }
+        }
+      }
+    });
+  }
+}; // MapClusterPoints
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct with default extraction mode to extract largest cluster.
 vtkEuclideanClusterExtraction::vtkEuclideanClusterExtraction()
@@ -34,6 +277,7 @@ vtkEuclideanClusterExtraction::vtkEuclideanClusterExtraction()
   this->ClosestPoint[0] = this->ClosestPoint[1] = this->ClosestPoint[2] = 0.0;
 
   this->Locator = vtkStaticPointLocator::New();
+  this->ParallelClustering = false;
 
   this->NeighborScalars = vtkFloatArray::New();
   this->NeighborScalars->Allocate(64);
@@ -111,6 +355,12 @@ int vtkEuclideanClusterExtraction::RequestData(vtkInformation* vtkNotUsed(reques
     }
   }
 
+  // The static point locator may be queried concurrently.
+  if (this->ParallelClustering && vtkStaticPointLocator::SafeDownCast(this->Locator))
+  {
+    return this->ExtractClustersInParallel(input, output);
+  }
+
   // Initialize.  Keep track of the points visited.
   //
   this->Visited = new char[numPts];
@@ -297,6 +547,207 @@ int vtkEuclideanClusterExtraction::RequestData(vtkInformation* vtkNotUsed(reques
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Merge the neighboring points into clusters in parallel, number the clusters
+// in the order of their smallest point id, and extract the selected clusters
+// in the order of the input points.
+int vtkEuclideanClusterExtraction::ExtractClustersInParallel(
+  vtkPointSet* input, vtkPolyData* output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPoints* inPts = input->GetPoints();
+  vtkPointData* pd = input->GetPointData();
+  vtkPointData* outputPD = output->GetPointData();
+
+  // Mark the points satisfying the scalar connectivity criterion, if enabled.
+  std::vector<unsigned char> candidates(numPts, 1);
+  if (this->InScalars)
+  {
+    vtkDataArray* inScalars = this->InScalars;
+    const double* range = this->ScalarRange;
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        double s = inScalars->GetComponent(ptId, 0);
+        candidates[ptId] = (s >= range[0] && s <= range[1]) ? 1 : 0;
+      }
+    });
+  }
+
+  // Merge the candidate points within the radius of each other.
+  PointSets sets(numPts);
+  MergeNeighbors::Execute(this, inPts, candidates.data(), &sets);
+  if (this->GetAbortOutput())
+  {
+    return 1;
+  }
+  sets.Flatten();
+  this->UpdateProgress(0.8);
+
+  // Number the clusters in the order of their roots, which are their
+  // smallest point ids, as the serial traversal does.
+  std::vector<vtkIdType> rootOffsets = CountByBatches(
+    numPts, [&](vtkIdType ptId) { return candidates[ptId] && sets.GetRoot(ptId) == ptId; });
+  vtkIdType numClusters = rootOffsets.back();
+  std::vector<vtkIdType> clusterIds(numPts, -1);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(rootOffsets.size() - 1),
+    [&](vtkIdType batch, vtkIdType endBatch) {
+      for (; batch < endBatch; ++batch)
+      {
+        vtkIdType clusterId = rootOffsets[batch];
+        vtkIdType ptId = batch * ClusterBatchSize;
+        vtkIdType endPtId = std::min(ptId + ClusterBatchSize, numPts);
+        for (; ptId < endPtId; ++ptId)
+        {
+          if (candidates[ptId] && sets.GetRoot(ptId) == ptId)
+          {
+            clusterIds[ptId] = clusterId++;
+          }
+        }
+      }
+    });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType rootId = sets.GetRoot(ptId);
+      if (candidates[ptId] && rootId != ptId)
+      {
+        clusterIds[ptId] = clusterIds[rootId];
+      }
+    }
+  });
+
+  std::vector<vtkIdType> clusterSizes(numClusters, 0);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (clusterIds[ptId] >= 0)
+    {
+      ++clusterSizes[clusterIds[ptId]];
+    }
+  }
+
+  // Select the clusters to extract. Seeded clusters are considered as a
+  // single cluster, as with the serial traversal.
+  std::vector<unsigned char> selected(numClusters, 0);
+  bool seeded = false;
+  if (this->ExtractionMode == VTK_EXTRACT_ALL_CLUSTERS)
+  {
+    std::fill(selected.begin(), selected.end(), 1);
+  }
+  else if (this->ExtractionMode == VTK_EXTRACT_SPECIFIED_CLUSTERS)
+  {
+    for (vtkIdType i = 0; i < this->SpecifiedClusterIds->GetNumberOfIds(); i++)
+    {
+      vtkIdType clusterId = this->SpecifiedClusterIds->GetId(i);
+      if (clusterId >= 0 && clusterId < numClusters)
+      {
+        selected[clusterId] = 1;
+      }
+    }
+  }
+  else if (this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_CLUSTERS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_CLUSTER)
+  {
+    seeded = true;
+    vtkIdList* seeds = this->Seeds;
+    vtkNew<vtkIdList> closestPoint;
+    if (this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_CLUSTER)
+    {
+      closestPoint->InsertNextId(this->Locator->FindClosestPoint(this->ClosestPoint));
+      seeds = closestPoint.Get();
+    }
+    for (vtkIdType i = 0; i < seeds->GetNumberOfIds(); i++)
+    {
+      vtkIdType ptId = seeds->GetId(i);
+      if (ptId >= 0 && ptId < numPts && clusterIds[ptId] >= 0)
+      {
+        selected[clusterIds[ptId]] = 1;
+      }
+    }
+  }
+  else if (numClusters > 0) // extract largest cluster
+  {
+    selected[std::max_element(clusterSizes.begin(), clusterSizes.end()) - clusterSizes.begin()] =
+      1;
+  }
+
+  this->ClusterSizes->Reset();
+  if (seeded)
+  {
+    vtkIdType numPointsInCluster = 0;
+    for (vtkIdType clusterId = 0; clusterId < numClusters; ++clusterId)
+    {
+      numPointsInCluster += selected[clusterId] ? clusterSizes[clusterId] : 0;
+    }
+    this->ClusterSizes->InsertValue(0, numPointsInCluster);
+  }
+  else
+  {
+    this->ClusterSizes->SetNumberOfValues(numClusters);
+    std::copy(clusterSizes.begin(), clusterSizes.end(), this->ClusterSizes->GetPointer(0));
+  }
+  vtkDebugMacro(<< "Extracted " << numClusters << " cluster(s)");
+
+  // Number the extracted points in the order of the input points.
+  std::vector<vtkIdType> pointOffsets = CountByBatches(
+    numPts, [&](vtkIdType ptId) { return clusterIds[ptId] >= 0 && selected[clusterIds[ptId]]; });
+  vtkIdType numNewPts = pointOffsets.back();
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pointOffsets.size() - 1),
+    [&](vtkIdType batch, vtkIdType endBatch) {
+      for (; batch < endBatch; ++batch)
+      {
+        vtkIdType newPtId = pointOffsets[batch];
+        vtkIdType ptId = batch * ClusterBatchSize;
+        vtkIdType endPtId = std::min(ptId + ClusterBatchSize, numPts);
+        for (; ptId < endPtId; ++ptId)
+        {
+          if (clusterIds[ptId] >= 0 && selected[clusterIds[ptId]])
+          {
+            pointMap[ptId] = newPtId++;
+          }
+        }
+      }
+    });
+
+  // Copy the extracted points and their attributes.
+  outputPD->CopyAllocate(pd, numNewPts);
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(inPts->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  output->SetPoints(newPts);
+
+  vtkSmartPointer<vtkIdTypeArray> newScalars;
+  if (this->ColorClusters)
+  {
+    newScalars = vtkSmartPointer<vtkIdTypeArray>::New();
+    newScalars->SetName("ClusterId");
+    newScalars->SetNumberOfTuples(numNewPts);
+  }
+
+  using vtkArrayDispatch::Reals;
+  using Dispatcher = vtkArrayDispatch::Dispatch2BySameValueType<Reals>;
+  MapClusterPoints worker;
+  vtkDataArray* inPtArray = inPts->GetData();
+  vtkDataArray* outPtArray = newPts->GetData();
+  const vtkIdType* outClusterIds = seeded ? nullptr : clusterIds.data();
+  if (!Dispatcher::Execute(inPtArray, outPtArray, worker, pointMap.data(), outClusterIds,
+        newScalars.Get(), pd, outputPD))
+  { // fallback for weird types:
+    worker(inPtArray, outPtArray, pointMap.data(), outClusterIds, newScalars.Get(), pd, outputPD);
+  }
+
+  // if coloring clusters; send down new scalar data
+  if (this->ColorClusters)
+  {
+    int idx = outputPD->AddArray(newScalars);
+    outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+  vtkDebugMacro(<< "Extracted " << numNewPts << " points");
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 // Insert point into connected wave. Check to make sure it satisfies connectivity
 // criterion (if enabled).
@@ -439,5 +890,6 @@ void vtkEuclideanClusterExtraction::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
 
   os << indent << "Locator: " << this->Locator << "\n";
+  os << indent << "Parallel Clustering: " << (this->ParallelClustering ? "On\n" : "Off\n");
 }
 VTK_ABI_NAMESPACE_END
@@ -32,6 +32,13 @@
  * example, by using a seed point in a known cluster, clustering will pull
  * out all points "representing" the local structure.
  *
+ * When ParallelClustering is on and the locator is a vtkStaticPointLocator
+ * (the default), the clusters are built in parallel with vtkSMPTools: the
+ * neighborhoods of the points are searched concurrently, and the points
+ * within the radius of each other are merged into disjoint sets. The
+ * clusters and their numbering are the same as with the serial traversal,
+ * and the output does not depend on the number of threads.
+ *
  * @sa
  * vtkConnectivityFilter vtkPolyDataConnectivityFilter
  */
@@ -54,6 +61,7 @@ class vtkFloatArray;
 class vtkIdList;
 class vtkIdTypeArray;
 class vtkAbstractPointLocator;
+class vtkPointSet;
 
 class VTKFILTERSPOINTS_EXPORT vtkEuclideanClusterExtraction : public vtkPolyDataAlgorithm
 {
@@ -181,6 +189,21 @@ public:
   vtkGetObjectMacro(Locator, vtkAbstractPointLocator);
   ///@}
 
+  ///@{
+  /**
+   * Turn on/off the parallel clustering. It is used only when the locator
+   * is a vtkStaticPointLocator, which is queried concurrently; otherwise the
+   * clusters are traversed serially. The clusters are numbered in the order
+   * of their smallest point id, as with the serial traversal, but the
+   * extracted points are output in the order of the input points rather
+   * than in the order of the traversal. When ColorClusters is on, the
+   * "ClusterId" array has one value per extracted point. Off by default.
+   */
+  vtkSetMacro(ParallelClustering, bool);
+  vtkGetMacro(ParallelClustering, bool);
+  vtkBooleanMacro(ParallelClustering, bool);
+  ///@}
+
 protected:
   vtkEuclideanClusterExtraction();
   ~vtkEuclideanClusterExtraction() override;
@@ -198,6 +221,7 @@ protected:
   double ScalarRange[2];
 
   vtkAbstractPointLocator* Locator;
+  bool ParallelClustering;
 
   // Configure the pipeline
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -207,6 +231,9 @@ protected:
   void InsertIntoWave(vtkIdList* wave, vtkIdType ptId);
   void TraverseAndMark(vtkPoints* pts);
 
+  // Internal method for clustering and extracting the points in parallel.
+  int ExtractClustersInParallel(vtkPointSet* input, vtkPolyData* output);
+
 private:
   vtkEuclideanClusterExtraction(const vtkEuclideanClusterExtraction&) = delete;
   void operator=(const vtkEuclideanClusterExtraction&) = delete;
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Measure the time vtkMeshQuality takes to evaluate the qualities and the
+// statistics of a mesh of linear, nonlinear and polyhedral cells with one
+// thread and with the default number of threads, and report them as CDash
+// measurements.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkLogger.h"
+#include "vtkMeshQuality.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+// Number of evaluations over which the time is averaged.
+constexpr int NumberOfRuns = 3;
+
+// Report the time of one evaluation, in seconds.
+void Report(const std::string& name, double seconds)
+{
+  std::cout << "<DartMeasurement name=\"" << name << "\" type=\"numeric/double\">"
+            << seconds / NumberOfRuns << "</DartMeasurement>" << std::endl;
+}
+
+// Evaluate the qualities with a given maximum number of threads, 0 meaning
+// the default of the SMP backend.
+double TimeQuality(vtkMeshQuality* quality, int numberOfThreads)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      timer->StartTimer();
+      for (int run = 0; run < NumberOfRuns; ++run)
+      {
+        quality->Modified();
+        quality->Update();
+      }
+      timer->StopTimer();
+    });
+  return timer->GetElapsedTime();
+}
+}
+
+int TestMeshQualityPerformance(int, char*[])
+{
+  const int cellTypes[] = { VTK_TRIANGLE, VTK_QUAD, VTK_TETRA, VTK_HEXAHEDRON, VTK_WEDGE,
+    VTK_PYRAMID, VTK_POLYHEDRON, VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON,
+    VTK_LAGRANGE_HEXAHEDRON, VTK_BEZIER_WEDGE };
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(20, 20, 20);
+    append->AddInputConnection(source->GetOutputPort());
+  }
+  append->Update();
+
+  vtkNew<vtkMeshQuality> quality;
+  quality->SetInputData(append->GetOutput());
+  quality->SaveCellQualityOn();
+  quality->LinearApproximationOn();
+  quality->SetTetQualityMeasureToScaledJacobian();
+  quality->SetWedgeQualityMeasureToCondition();
+  quality->SetHexQualityMeasureToShapeAndSize();
+
+  ::Report("MeshQualityOneThread", ::TimeQuality(quality, 1));
+  vtkNew<vtkUnstructuredGrid> serial;
+  serial->DeepCopy(quality->GetOutput());
+  ::Report("MeshQualityDefaultThreads", ::TimeQuality(quality, 0));
+  std::cout << "<DartMeasurement name=\"NumberOfThreads\" type=\"numeric/integer\">"
+            << vtkSMPTools::GetEstimatedDefaultNumberOfThreads() << "</DartMeasurement>"
+            << std::endl;
+
+  if (!vtkTestUtilities::CompareDataObjectsExactly(serial, quality->GetOutput()))
+  {
+    vtkLog(ERROR, "The qualities differ with one and the default number of threads.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
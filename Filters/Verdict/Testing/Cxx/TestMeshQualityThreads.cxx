@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that the qualities and the statistics of vtkMeshQuality do not depend
+// on the number of threads for linear, nonlinear and polyhedral cells, and
+// that the statistics match the qualities of the cells.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkCellTypeSource.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkLogger.h"
+#include "vtkMeshQuality.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+// The linear cell type whose quality measure applies to the cells of the mesh.
+int LinearType(int cellType)
+{
+  switch (cellType)
+  {
+    case VTK_QUADRATIC_TRIANGLE:
+    case VTK_LAGRANGE_TRIANGLE:
+      return VTK_TRIANGLE;
+    case VTK_QUADRATIC_QUAD:
+      return VTK_QUAD;
+    case VTK_QUADRATIC_TETRA:
+    case VTK_BEZIER_TETRAHEDRON:
+      return VTK_TETRA;
+    case VTK_QUADRATIC_HEXAHEDRON:
+    case VTK_LAGRANGE_HEXAHEDRON:
+      return VTK_HEXAHEDRON;
+    case VTK_QUADRATIC_WEDGE:
+    case VTK_BEZIER_WEDGE:
+      return VTK_WEDGE;
+    case VTK_QUADRATIC_PYRAMID:
+      return VTK_PYRAMID;
+    default:
+      return cellType;
+  }
+}
+
+// Check the statistics of a linear cell type against the qualities of the
+// cells. With the linear approximation, the cells of that type count with
+// their quality and their approximated quality, and the nonlinear cells of the
+// same shape with their approximated quality.
+bool SameStatistics(vtkUnstructuredGrid* output, int cellType, const char* name)
+{
+  vtkDataArray* qualities = output->GetCellData()->GetArray("Quality");
+  vtkDataArray* approximations = output->GetCellData()->GetArray("Quality (Linear Approx)");
+  vtkIdType count = 0;
+  double min = VTK_DOUBLE_MAX, max = VTK_DOUBLE_MIN, total = 0.0;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const int type = output->GetCellType(cellId);
+    if (LinearType(type) != cellType)
+    {
+      continue;
+    }
+    const double quality[2] = { qualities->GetComponent(cellId, 0),
+      approximations->GetComponent(cellId, 0) };
+    for (int i = type == cellType ? 0 : 1; i < 2; ++i)
+    {
+      min = std::min(min, quality[i]);
+      max = std::max(max, quality[i]);
+      total += quality[i];
+      ++count;
+    }
+  }
+  double stats[5];
+  output->GetFieldData()->GetArray(name)->GetTuple(0, stats);
+  if (count == 0 || stats[0] != min || stats[2] != max || stats[4] != count ||
+    std::abs(stats[1] - total / count) > 1e-12 * std::abs(total / count))
+  {
+    vtkLog(ERROR,
+      << name << ": min " << stats[0] << ", average " << stats[1] << ", max " << stats[2]
+      << " over " << stats[4] << " qualities, expected " << min << ", " << total / count
+      << ", " << max << " over " << count << ".");
+    return false;
+  }
+  return true;
+}
+
+// Blocks of cells of many types, with some moved points.
+vtkSmartPointer<vtkUnstructuredGrid> MakeMesh()
+{
+  const int cellTypes[] = { VTK_TRIANGLE, VTK_QUAD, VTK_POLYGON, VTK_TETRA, VTK_HEXAHEDRON,
+    VTK_WEDGE, VTK_PYRAMID, VTK_HEXAGONAL_PRISM, VTK_POLYHEDRON, VTK_QUADRATIC_TRIANGLE,
+    VTK_QUADRATIC_QUAD, VTK_QUADRATIC_TETRA, VTK_QUADRATIC_HEXAHEDRON, VTK_QUADRATIC_WEDGE,
+    VTK_QUADRATIC_PYRAMID, VTK_LAGRANGE_TRIANGLE, VTK_LAGRANGE_HEXAHEDRON,
+    VTK_BEZIER_TETRAHEDRON, VTK_BEZIER_WEDGE };
+  vtkNew<vtkAppendFilter> append;
+  for (int cellType : cellTypes)
+  {
+    vtkNew<vtkCellTypeSource> source;
+    source->SetCellType(cellType);
+    source->SetCellOrder(2);
+    source->SetBlocksDimensions(8, 8, 8);
+    source->Update();
+    append->AddInputData(source->GetOutput());
+  }
+  append->Update();
+
+  vtkSmartPointer<vtkUnstructuredGrid> mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  mesh->DeepCopy(append->GetOutput());
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(4242);
+  vtkPoints* points = mesh->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] += random->GetNextRangeValue(-0.1, 0.1);
+    }
+    points->SetPoint(ptId, x);
+  }
+  return mesh;
+}
+}
+
+int TestMeshQualityThreads(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> mesh = MakeMesh();
+  vtkNew<vtkMeshQuality> quality;
+  quality->SetInputData(mesh);
+  quality->SaveCellQualityOn();
+  quality->LinearApproximationOn();
+  quality->SetTriangleQualityMeasureToShapeAndSize();
+  quality->SetQuadQualityMeasureToShearAndSize();
+  quality->SetTetQualityMeasureToRelativeSizeSquared();
+  quality->SetPyramidQualityMeasureToScaledJacobian();
+  quality->SetWedgeQualityMeasureToCondition();
+  quality->SetHexQualityMeasureToShapeAndSize();
+
+  vtkNew<vtkUnstructuredGrid> output;
+  if (!vtkTestUtilities::CompareThreadedOutputs(quality, 4, output))
+  {
+    return EXIT_FAILURE;
+  }
+
+  bool success = true;
+  const std::pair<int, const char*> statistics[] = { { VTK_TRIANGLE, "Mesh Triangle Quality" },
+    { VTK_QUAD, "Mesh Quadrilateral Quality" }, { VTK_TETRA, "Mesh Tetrahedron Quality" },
+    { VTK_PYRAMID, "Mesh Pyramid Quality" }, { VTK_WEDGE, "Mesh Wedge Quality" },
+    { VTK_HEXAHEDRON, "Mesh Hexahedron Quality" } };
+  for (const auto& cellTypeAndName : statistics)
+  {
+    success &= ::SameStatistics(output, cellTypeAndName.first, cellTypeAndName.second);
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
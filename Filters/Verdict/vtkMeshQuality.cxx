@@ -21,7 +21,10 @@
 
 #include "vtk_verdict.h"
 
+#include <algorithm>
+#include <array>
 #include <limits>
+#include <vector>
 
 //----------------------------------------------------------------------------
 VTK_ABI_NAMESPACE_BEGIN
@@ -46,6 +49,10 @@ const char* vtkMeshQuality::QualityMeasureNames[] = { "EdgeRatio", "AspectRatio"
 
 namespace
 {
+// Number of cells per block over which the statistics are accumulated. The
+// statistics do not depend on the number of threads.
+constexpr vtkIdType CellBlockSize = 4096;
+
 //----------------------------------------------------------------------------
 void LinearizeCell(int& cellType)
 {
@@ -127,8 +134,7 @@ class vtkSizeFunctor
 private:
   vtkSMPThreadLocalObject<vtkGenericCell> Cell;
   vtkDataSet* Output;
-  vtkSMPThreadLocal<CellQualityStats> TLTriangleStats, TLQuadStats, TLTetStats, TLPyrStats,
-    TLWedgeStats, TLHexStats;
+  std::vector<std::array<CellQualityStats, 6>> BlockStats;
   CellQualityStats TriangleStats, QuadStats, TetStats, PyrStats, WedgeStats, HexStats;
 
 public:
@@ -136,8 +142,17 @@ public:
     : Output(output)
   {
     // instantiate any data-structure that needs to be cached for parallel execution.
-    vtkNew<vtkGenericCell> cell;
-    this->Output->GetCell(0, cell);
+    vtkIdType numberOfCells = this->Output->GetNumberOfCells();
+    if (numberOfCells > 0)
+    {
+      vtkNew<vtkGenericCell> cell;
+      this->Output->GetCell(0, cell);
+    }
+    // the statistics are accumulated over fixed blocks of cells, and reduced
+    // in the order of the blocks
+    std::array<CellQualityStats, 6> initialStats;
+    initialStats.fill(CellQualityStats{ 0, 0, 0, 0, 0 });
+    this->BlockStats.resize((numberOfCells + CellBlockSize - 1) / CellBlockSize, initialStats);
     // initialize min quality
     this->TriangleStats.Min = this->QuadStats.Min = this->TetStats.Min = this->PyrStats.Min =
       this->WedgeStats.Min = this->HexStats.Min = 0;
@@ -155,182 +170,160 @@ public:
       this->PyrStats.NumCells = this->WedgeStats.NumCells = this->HexStats.NumCells = 0;
   }
 
-  void Initialize()
-  {
-    // initialize min quality
-    this->TLTriangleStats.Local().Min = this->TLQuadStats.Local().Min =
-      this->TLTetStats.Local().Min = this->TLPyrStats.Local().Min = this->TLWedgeStats.Local().Min =
-        this->TLHexStats.Local().Min = 0;
-    // initialize total quality
-    this->TLTriangleStats.Local().Total = this->TLQuadStats.Local().Total =
-      this->TLTetStats.Local().Total = this->TLPyrStats.Local().Total =
-        this->TLWedgeStats.Local().Total = this->TLHexStats.Local().Total = 0;
-    // initialize max quality
-    this->TLTriangleStats.Local().Max = this->TLQuadStats.Local().Max =
-      this->TLTetStats.Local().Max = this->TLPyrStats.Local().Max = this->TLWedgeStats.Local().Max =
-        this->TLHexStats.Local().Max = 0;
-    // initialize total quality squared
-    this->TLTriangleStats.Local().Total2 = this->TLQuadStats.Local().Total2 =
-      this->TLTetStats.Local().Total2 = this->TLPyrStats.Local().Total2 =
-        this->TLWedgeStats.Local().Total2 = this->TLHexStats.Local().Total2 = 0;
-    // initialize number of cells
-    this->TLTriangleStats.Local().NumCells = this->TLQuadStats.Local().NumCells =
-      this->TLTetStats.Local().NumCells = this->TLPyrStats.Local().NumCells =
-        this->TLWedgeStats.Local().NumCells = this->TLHexStats.Local().NumCells = 0;
-  }
-
-  void operator()(vtkIdType begin, vtkIdType end)
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
   {
-    CellQualityStats& triStats = this->TLTriangleStats.Local();
-    CellQualityStats& quadStats = this->TLQuadStats.Local();
-    CellQualityStats& tetStats = this->TLTetStats.Local();
-    CellQualityStats& pyrStats = this->TLPyrStats.Local();
-    CellQualityStats& wedgeStats = this->TLWedgeStats.Local();
-    CellQualityStats& hexStats = this->TLHexStats.Local();
     vtkGenericCell* genericCell = this->Cell.Local();
     vtkCell* cell;
     double area, volume; // area and volume
 
-    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
     {
-      this->Output->GetCell(cellId, genericCell);
-      cell = genericCell->GetRepresentativeCell();
+      std::array<CellQualityStats, 6>& blockStats = this->BlockStats[block];
+      CellQualityStats& triStats = blockStats[0];
+      CellQualityStats& quadStats = blockStats[1];
+      CellQualityStats& tetStats = blockStats[2];
+      CellQualityStats& pyrStats = blockStats[3];
+      CellQualityStats& wedgeStats = blockStats[4];
+      CellQualityStats& hexStats = blockStats[5];
+      vtkIdType begin = block * CellBlockSize;
+      vtkIdType end = std::min(begin + CellBlockSize, this->Output->GetNumberOfCells());
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Output->GetCell(cellId, genericCell);
+        cell = genericCell->GetRepresentativeCell();
 
-      int cellType = cell->GetCellType();
-      LinearizeCell(cellType);
+        int cellType = cell->GetCellType();
+        LinearizeCell(cellType);
 
-      switch (cellType)
-      {
-        case VTK_TRIANGLE:
-          area = vtkMeshQuality::TriangleArea(cell);
-          if (area > triStats.Max)
-          {
-            if (triStats.Min == triStats.Max)
-            { // min == max => min has not been set
+        switch (cellType)
+        {
+          case VTK_TRIANGLE:
+            area = vtkMeshQuality::TriangleArea(cell);
+            if (area > triStats.Max)
+            {
+              if (triStats.Min == triStats.Max)
+              { // min == max => min has not been set
+                triStats.Min = area;
+              }
+              triStats.Max = area;
+            }
+            else if (area < triStats.Min)
+            {
               triStats.Min = area;
             }
-            triStats.Max = area;
-          }
-          else if (area < triStats.Min)
-          {
-            triStats.Min = area;
-          }
-          triStats.Total += area;
-          triStats.Total2 += area * area;
-          ++triStats.NumCells;
-          break;
-        case VTK_QUAD:
-          area = vtkMeshQuality::QuadArea(cell);
-          if (area > quadStats.Max)
-          {
-            if (quadStats.Min == quadStats.Max)
-            { // min == max => min has not been set
+            triStats.Total += area;
+            triStats.Total2 += area * area;
+            ++triStats.NumCells;
+            break;
+          case VTK_QUAD:
+            area = vtkMeshQuality::QuadArea(cell);
+            if (area > quadStats.Max)
+            {
+              if (quadStats.Min == quadStats.Max)
+              { // min == max => min has not been set
+                quadStats.Min = area;
+              }
+              quadStats.Max = area;
+            }
+            else if (area < quadStats.Min)
+            {
               quadStats.Min = area;
             }
-            quadStats.Max = area;
-          }
-          else if (area < quadStats.Min)
-          {
-            quadStats.Min = area;
-          }
-          quadStats.Total += area;
-          quadStats.Total2 += area * area;
-          ++quadStats.NumCells;
-          break;
-        case VTK_TETRA:
-          volume = vtkMeshQuality::TetVolume(cell);
-          if (volume > tetStats.Max)
-          {
-            if (tetStats.Min == tetStats.Max)
-            { // min == max => min has not been set
+            quadStats.Total += area;
+            quadStats.Total2 += area * area;
+            ++quadStats.NumCells;
+            break;
+          case VTK_TETRA:
+            volume = vtkMeshQuality::TetVolume(cell);
+            if (volume > tetStats.Max)
+            {
+              if (tetStats.Min == tetStats.Max)
+              { // min == max => min has not been set
+                tetStats.Min = volume;
+              }
+              tetStats.Max = volume;
+            }
+            else if (volume < tetStats.Min)
+            {
               tetStats.Min = volume;
             }
-            tetStats.Max = volume;
-          }
-          else if (volume < tetStats.Min)
-          {
-            tetStats.Min = volume;
-          }
-          tetStats.Total += volume;
-          tetStats.Total2 += volume * volume;
-          ++tetStats.NumCells;
-          break;
-        case VTK_PYRAMID:
-          volume = vtkMeshQuality::PyramidVolume(cell);
-          if (volume > pyrStats.Max)
-          {
-            if (pyrStats.Min == pyrStats.Max)
-            { // min == max => min has not been set
+            tetStats.Total += volume;
+            tetStats.Total2 += volume * volume;
+            ++tetStats.NumCells;
+            break;
+          case VTK_PYRAMID:
+            volume = vtkMeshQuality::PyramidVolume(cell);
+            if (volume > pyrStats.Max)
+            {
+              if (pyrStats.Min == pyrStats.Max)
+              { // min == max => min has not been set
+                pyrStats.Min = volume;
+              }
+              pyrStats.Max = volume;
+            }
+            else if (volume < pyrStats.Min)
+            {
               pyrStats.Min = volume;
             }
-            pyrStats.Max = volume;
-          }
-          else if (volume < pyrStats.Min)
-          {
-            pyrStats.Min = volume;
-          }
-          pyrStats.Total += volume;
-          pyrStats.Total2 += volume * volume;
-          ++pyrStats.NumCells;
-          break;
-        case VTK_WEDGE:
-          volume = vtkMeshQuality::WedgeVolume(cell);
-          if (volume > wedgeStats.Max)
-          {
-            if (wedgeStats.Min == wedgeStats.Max)
-            { // min == max => min has not been set
+            pyrStats.Total += volume;
+            pyrStats.Total2 += volume * volume;
+            ++pyrStats.NumCells;
+            break;
+          case VTK_WEDGE:
+            volume = vtkMeshQuality::WedgeVolume(cell);
+            if (volume > wedgeStats.Max)
+            {
+              if (wedgeStats.Min == wedgeStats.Max)
+              { // min == max => min has not been set
+                wedgeStats.Min = volume;
+              }
+              wedgeStats.Max = volume;
+            }
+            else if (volume < wedgeStats.Min)
+            {
               wedgeStats.Min = volume;
             }
-            wedgeStats.Max = volume;
-          }
-          else if (volume < wedgeStats.Min)
-          {
-            wedgeStats.Min = volume;
-          }
-          wedgeStats.Total += volume;
-          wedgeStats.Total2 += volume * volume;
-          ++wedgeStats.NumCells;
-          break;
-        case VTK_HEXAHEDRON:
-          volume = vtkMeshQuality::HexVolume(cell);
-          if (volume > hexStats.Max)
-          {
-            if (hexStats.Min == hexStats.Max)
-            { // min == max => min has not been set
+            wedgeStats.Total += volume;
+            wedgeStats.Total2 += volume * volume;
+            ++wedgeStats.NumCells;
+            break;
+          case VTK_HEXAHEDRON:
+            volume = vtkMeshQuality::HexVolume(cell);
+            if (volume > hexStats.Max)
+            {
+              if (hexStats.Min == hexStats.Max)
+              { // min == max => min has not been set
+                hexStats.Min = volume;
+              }
+              hexStats.Max = volume;
+            }
+            else if (volume < hexStats.Min)
+            {
               hexStats.Min = volume;
             }
-            hexStats.Max = volume;
-          }
-          else if (volume < hexStats.Min)
-          {
-            hexStats.Min = volume;
-          }
-          hexStats.Total += volume;
-          hexStats.Total2 += volume * volume;
-          ++hexStats.NumCells;
-          break;
-        default:
-          break;
+            hexStats.Total += volume;
+            hexStats.Total2 += volume * volume;
+            ++hexStats.NumCells;
+            break;
+          default:
+            break;
+        }
       }
     }
   }
   void Reduce()
   {
-    vtkSMPThreadLocal<CellQualityStats>::iterator iter[6] = { this->TLTriangleStats.begin(),
-      this->TLQuadStats.begin(), this->TLTetStats.begin(), this->TLPyrStats.begin(),
-      this->TLWedgeStats.begin(), this->TLHexStats.begin() };
     CellQualityStats* stats[6] = { &this->TriangleStats, &this->QuadStats, &this->TetStats,
       &this->PyrStats, &this->WedgeStats, &this->HexStats };
-    for (; iter[0] != this->TLTriangleStats.end();
-         ++iter[0], ++iter[1], ++iter[2], ++iter[3], ++iter[4], ++iter[5])
+    for (const std::array<CellQualityStats, 6>& blockStats : this->BlockStats)
     {
       for (int i = 0; i < 6; ++i)
       {
-        stats[i]->Min = std::min(iter[i]->Min, stats[i]->Min);
-        stats[i]->Total += iter[i]->Total;
-        stats[i]->Max = std::max(iter[i]->Max, stats[i]->Max);
-        stats[i]->Total2 += iter[i]->Total2;
-        stats[i]->NumCells += iter[i]->NumCells;
+        stats[i]->Min = std::min(blockStats[i].Min, stats[i]->Min);
+        stats[i]->Total += blockStats[i].Total;
+        stats[i]->Max = std::max(blockStats[i].Max, stats[i]->Max);
+        stats[i]->Total2 += blockStats[i].Total2;
+        stats[i]->NumCells += blockStats[i].NumCells;
       }
     }
   }
@@ -358,8 +351,7 @@ private:
   using CellQualityType = vtkMeshQuality::CellQualityType;
   CellQualityType TriangleQuality, QuadQuality, TetQuality, PyramidQuality, WedgeQuality,
     HexQuality;
-  vtkSMPThreadLocal<CellQualityStats> TLTriangleStats, TLQuadStats, TLTetStats, TLPyrStats,
-    TLWedgeStats, TLHexStats;
+  std::vector<std::array<CellQualityStats, 6>> BlockStats;
   CellQualityStats TriangleStats, QuadStats, TetStats, PyrStats, WedgeStats, HexStats;
 
 public:
@@ -381,8 +373,17 @@ public:
     , HexQuality(hexQuality)
   {
     // instantiate any data-structure that needs to be cached for parallel execution.
-    vtkNew<vtkGenericCell> cell;
-    this->Output->GetCell(0, cell);
+    vtkIdType numberOfCells = this->Output->GetNumberOfCells();
+    if (numberOfCells > 0)
+    {
+      vtkNew<vtkGenericCell> cell;
+      this->Output->GetCell(0, cell);
+    }
+    // the statistics are accumulated over fixed blocks of cells, and reduced
+    // in the order of the blocks
+    std::array<CellQualityStats, 6> initialStats;
+    initialStats.fill(CellQualityStats{ VTK_DOUBLE_MAX, 0.0, VTK_DOUBLE_MIN, 0.0, 0 });
+    this->BlockStats.resize((numberOfCells + CellBlockSize - 1) / CellBlockSize, initialStats);
     // initialize min quality
     this->TriangleStats.Min = this->QuadStats.Min = this->TetStats.Min = this->PyrStats.Min =
       this->WedgeStats.Min = this->HexStats.Min = VTK_DOUBLE_MAX;
@@ -400,202 +401,180 @@ public:
       this->PyrStats.NumCells = this->WedgeStats.NumCells = this->HexStats.NumCells = 0;
   }
 
-  void Initialize()
+  void operator()(vtkIdType beginBlock, vtkIdType endBlock)
   {
-    // initialize min quality
-    this->TLTriangleStats.Local().Min = this->TLQuadStats.Local().Min =
-      this->TLTetStats.Local().Min = this->TLPyrStats.Local().Min = this->TLWedgeStats.Local().Min =
-        this->TLHexStats.Local().Min = VTK_DOUBLE_MAX;
-    // initialize total quality
-    this->TLTriangleStats.Local().Total = this->TLQuadStats.Local().Total =
-      this->TLTetStats.Local().Total = this->TLPyrStats.Local().Total =
-        this->TLWedgeStats.Local().Total = this->TLHexStats.Local().Total = 0.0;
-    // initialize max quality
-    this->TLTriangleStats.Local().Max = this->TLQuadStats.Local().Max =
-      this->TLTetStats.Local().Max = this->TLPyrStats.Local().Max = this->TLWedgeStats.Local().Max =
-        this->TLHexStats.Local().Max = VTK_DOUBLE_MIN;
-    // initialize total quality squared
-    this->TLTriangleStats.Local().Total2 = this->TLQuadStats.Local().Total2 =
-      this->TLTetStats.Local().Total2 = this->TLPyrStats.Local().Total2 =
-        this->TLWedgeStats.Local().Total2 = this->TLHexStats.Local().Total2 = 0.0;
-    // initialize number of cells
-    this->TLTriangleStats.Local().NumCells = this->TLQuadStats.Local().NumCells =
-      this->TLTetStats.Local().NumCells = this->TLPyrStats.Local().NumCells =
-        this->TLWedgeStats.Local().NumCells = this->TLHexStats.Local().NumCells = 0;
-  }
-
-  void operator()(vtkIdType begin, vtkIdType end)
-  {
-    CellQualityStats& triStats = this->TLTriangleStats.Local();
-    CellQualityStats& quadStats = this->TLQuadStats.Local();
-    CellQualityStats& tetStats = this->TLTetStats.Local();
-    CellQualityStats& pyrStats = this->TLPyrStats.Local();
-    CellQualityStats& wedgeStats = this->TLWedgeStats.Local();
-    CellQualityStats& hexStats = this->TLHexStats.Local();
     vtkGenericCell* genericCell = this->Cell.Local();
     vtkCell* cell;
     vtkDoubleArray* qualityArrays[2] = { this->QualityArray, this->ApproxQualityArray };
     double quality;
 
-    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
     {
-      this->Output->GetCell(cellId, genericCell);
-      cell = genericCell->GetRepresentativeCell();
+      std::array<CellQualityStats, 6>& blockStats = this->BlockStats[block];
+      CellQualityStats& triStats = blockStats[0];
+      CellQualityStats& quadStats = blockStats[1];
+      CellQualityStats& tetStats = blockStats[2];
+      CellQualityStats& pyrStats = blockStats[3];
+      CellQualityStats& wedgeStats = blockStats[4];
+      CellQualityStats& hexStats = blockStats[5];
+      vtkIdType begin = block * CellBlockSize;
+      vtkIdType end = std::min(begin + CellBlockSize, this->Output->GetNumberOfCells());
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        this->Output->GetCell(cellId, genericCell);
+        cell = genericCell->GetRepresentativeCell();
 
-      int numberOfOutputQualities = this->MeshQuality->LinearApproximation ? 2 : 1;
+        int numberOfOutputQualities = this->MeshQuality->LinearApproximation ? 2 : 1;
 
-      int cellType = cell->GetCellType();
+        int cellType = cell->GetCellType();
 
-      for (int qualityId = 0; qualityId < numberOfOutputQualities; ++qualityId)
-      {
-        switch (cellType)
+        for (int qualityId = 0; qualityId < numberOfOutputQualities; ++qualityId)
         {
-          case VTK_TRIANGLE:
-            quality = this->TriangleQuality(cell);
-            if (quality > triStats.Max)
-            {
-              if (triStats.Min > triStats.Max)
+          switch (cellType)
+          {
+            case VTK_TRIANGLE:
+              quality = this->TriangleQuality(cell);
+              if (quality > triStats.Max)
+              {
+                if (triStats.Min > triStats.Max)
+                {
+                  triStats.Min = quality;
+                }
+                triStats.Max = quality;
+              }
+              else if (quality < triStats.Min)
               {
                 triStats.Min = quality;
               }
-              triStats.Max = quality;
-            }
-            else if (quality < triStats.Min)
-            {
-              triStats.Min = quality;
-            }
-            triStats.Total += quality;
-            triStats.Total2 += quality * quality;
-            ++triStats.NumCells;
-            break;
-          case VTK_QUAD:
-            quality = this->QuadQuality(cell);
-            if (quality > quadStats.Max)
-            {
-              if (quadStats.Min > quadStats.Max)
+              triStats.Total += quality;
+              triStats.Total2 += quality * quality;
+              ++triStats.NumCells;
+              break;
+            case VTK_QUAD:
+              quality = this->QuadQuality(cell);
+              if (quality > quadStats.Max)
+              {
+                if (quadStats.Min > quadStats.Max)
+                {
+                  quadStats.Min = quality;
+                }
+                quadStats.Max = quality;
+              }
+              else if (quality < quadStats.Min)
               {
                 quadStats.Min = quality;
               }
-              quadStats.Max = quality;
-            }
-            else if (quality < quadStats.Min)
-            {
-              quadStats.Min = quality;
-            }
-            quadStats.Total += quality;
-            quadStats.Total2 += quality * quality;
-            ++quadStats.NumCells;
-            break;
-          case VTK_TETRA:
-            quality = this->TetQuality(cell);
-            if (quality > tetStats.Max)
-            {
-              if (tetStats.Min > tetStats.Max)
+              quadStats.Total += quality;
+              quadStats.Total2 += quality * quality;
+              ++quadStats.NumCells;
+              break;
+            case VTK_TETRA:
+              quality = this->TetQuality(cell);
+              if (quality > tetStats.Max)
+              {
+                if (tetStats.Min > tetStats.Max)
+                {
+                  tetStats.Min = quality;
+                }
+                tetStats.Max = quality;
+              }
+              else if (quality < tetStats.Min)
               {
                 tetStats.Min = quality;
               }
-              tetStats.Max = quality;
-            }
-            else if (quality < tetStats.Min)
-            {
-              tetStats.Min = quality;
-            }
-            tetStats.Total += quality;
-            tetStats.Total2 += quality * quality;
-            ++tetStats.NumCells;
-            break;
-          case VTK_PYRAMID:
-            quality = this->PyramidQuality(cell);
-            if (quality > pyrStats.Max)
-            {
-              if (pyrStats.Min > pyrStats.Max)
+              tetStats.Total += quality;
+              tetStats.Total2 += quality * quality;
+              ++tetStats.NumCells;
+              break;
+            case VTK_PYRAMID:
+              quality = this->PyramidQuality(cell);
+              if (quality > pyrStats.Max)
+              {
+                if (pyrStats.Min > pyrStats.Max)
+                {
+                  pyrStats.Min = quality;
+                }
+                pyrStats.Max = quality;
+              }
+              else if (quality < pyrStats.Min)
               {
                 pyrStats.Min = quality;
               }
-              pyrStats.Max = quality;
-            }
-            else if (quality < pyrStats.Min)
-            {
-              pyrStats.Min = quality;
-            }
-            pyrStats.Total += quality;
-            pyrStats.Total2 += quality * quality;
-            ++pyrStats.NumCells;
-            break;
-          case VTK_WEDGE:
-            quality = this->WedgeQuality(cell);
-            if (quality > wedgeStats.Max)
-            {
-              if (wedgeStats.Min > wedgeStats.Max)
+              pyrStats.Total += quality;
+              pyrStats.Total2 += quality * quality;
+              ++pyrStats.NumCells;
+              break;
+            case VTK_WEDGE:
+              quality = this->WedgeQuality(cell);
+              if (quality > wedgeStats.Max)
+              {
+                if (wedgeStats.Min > wedgeStats.Max)
+                {
+                  wedgeStats.Min = quality;
+                }
+                wedgeStats.Max = quality;
+              }
+              else if (quality < wedgeStats.Min)
               {
                 wedgeStats.Min = quality;
               }
-              wedgeStats.Max = quality;
-            }
-            else if (quality < wedgeStats.Min)
-            {
-              wedgeStats.Min = quality;
-            }
-            wedgeStats.Total += quality;
-            wedgeStats.Total2 += quality * quality;
-            ++wedgeStats.NumCells;
-            break;
-          case VTK_HEXAHEDRON:
-            quality = this->HexQuality(cell);
-            if (quality > hexStats.Max)
-            {
-              if (hexStats.Min > hexStats.Max)
+              wedgeStats.Total += quality;
+              wedgeStats.Total2 += quality * quality;
+              ++wedgeStats.NumCells;
+              break;
+            case VTK_HEXAHEDRON:
+              quality = this->HexQuality(cell);
+              if (quality > hexStats.Max)
+              {
+                if (hexStats.Min > hexStats.Max)
+                {
+                  hexStats.Min = quality;
+                }
+                hexStats.Max = quality;
+              }
+              else if (quality < hexStats.Min)
               {
                 hexStats.Min = quality;
               }
-              hexStats.Max = quality;
-            }
-            else if (quality < hexStats.Min)
-            {
-              hexStats.Min = quality;
-            }
-            hexStats.Total += quality;
-            hexStats.Total2 += quality * quality;
-            ++hexStats.NumCells;
-            break;
-          default:
-            quality = std::numeric_limits<double>::quiet_NaN();
-        }
+              hexStats.Total += quality;
+              hexStats.Total2 += quality * quality;
+              ++hexStats.NumCells;
+              break;
+            default:
+              quality = std::numeric_limits<double>::quiet_NaN();
+          }
 
-        if (this->MeshQuality->SaveCellQuality)
-        {
-          qualityArrays[qualityId]->SetTypedComponent(cellId, 0, quality);
-        }
+          if (this->MeshQuality->SaveCellQuality)
+          {
+            qualityArrays[qualityId]->SetTypedComponent(cellId, 0, quality);
+          }
 
-        if (qualityId == 1)
-        {
-          break;
-        }
+          if (qualityId == 1)
+          {
+            break;
+          }
 
-        if (this->MeshQuality->LinearApproximation)
-        {
-          LinearizeCell(cellType);
+          if (this->MeshQuality->LinearApproximation)
+          {
+            LinearizeCell(cellType);
+          }
         }
       }
     }
   }
   void Reduce()
   {
-    vtkSMPThreadLocal<CellQualityStats>::iterator iter[6] = { this->TLTriangleStats.begin(),
-      this->TLQuadStats.begin(), this->TLTetStats.begin(), this->TLPyrStats.begin(),
-      this->TLWedgeStats.begin(), this->TLHexStats.begin() };
     CellQualityStats* stats[6] = { &this->TriangleStats, &this->QuadStats, &this->TetStats,
       &this->PyrStats, &this->WedgeStats, &this->HexStats };
-    for (; iter[0] != this->TLTriangleStats.end();
-         ++iter[0], ++iter[1], ++iter[2], ++iter[3], ++iter[4], ++iter[5])
+    for (const std::array<CellQualityStats, 6>& blockStats : this->BlockStats)
     {
       for (int i = 0; i < 6; ++i)
       {
-        stats[i]->Min = std::min(iter[i]->Min, stats[i]->Min);
-        stats[i]->Total += iter[i]->Total;
-        stats[i]->Max = std::max(iter[i]->Max, stats[i]->Max);
-        stats[i]->Total2 += iter[i]->Total2;
-        stats[i]->NumCells += iter[i]->NumCells;
+        stats[i]->Min = std::min(blockStats[i].Min, stats[i]->Min);
+        stats[i]->Total += blockStats[i].Total;
+        stats[i]->Max = std::max(blockStats[i].Max, stats[i]->Max);
+        stats[i]->Total2 += blockStats[i].Total2;
+        stats[i]->NumCells += blockStats[i].NumCells;
       }
     }
   }
@@ -1005,7 +984,8 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
     else
     {
       vtkSizeFunctor sizeFunctor(out);
-      vtkSMPTools::For(0, numberOfCells, sizeFunctor);
+      vtkSMPTools::For(0, (numberOfCells + CellBlockSize - 1) / CellBlockSize, sizeFunctor);
+      sizeFunctor.Reduce();
 
       sizeFunctor.GetTriangleStats().GetStats(triAreaTuple);
       sizeFunctor.GetQuadStats().GetStats(quadAreaTuple);
@@ -1068,7 +1048,8 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkMeshQualityFunctor meshQualityFunctor(this, out, qualityArray, approxQualityArray, volumeArray,
     TriangleQuality, QuadQuality, TetQuality, PyramidQuality, WedgeQuality, HexQuality);
-  vtkSMPTools::For(0, numberOfCells, meshQualityFunctor);
+  vtkSMPTools::For(0, (numberOfCells + CellBlockSize - 1) / CellBlockSize, meshQualityFunctor);
+  meshQualityFunctor.Reduce();
 
   CellQualityStats triangleStats = meshQualityFunctor.GetTriangleStats();
   CellQualityStats quadStats = meshQualityFunctor.GetQuadStats();
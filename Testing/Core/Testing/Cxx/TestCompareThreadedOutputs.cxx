@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Check that vtkTestUtilities::CompareDataObjectsExactly is sensitive to the
+// ordering and to the exact values of the elements, and that
+// vtkTestUtilities::CompareThreadedOutputs reports algorithms whose output
+// changes between two updates.
+
+#include "vtkTestUtilities.h"
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Outputs one more point at each execution.
+class vtkGrowingSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkGrowingSource* New();
+  vtkTypeMacro(vtkGrowingSource, vtkPolyDataAlgorithm);
+
+protected:
+  vtkGrowingSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfo) override
+  {
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    vtkNew<vtkPoints> points;
+    for (int i = 0; i <= this->NumberOfExecutions; ++i)
+    {
+      points->InsertNextPoint(i, 0.0, 0.0);
+    }
+    output->SetPoints(points);
+    ++this->NumberOfExecutions;
+    return 1;
+  }
+
+private:
+  int NumberOfExecutions = 0;
+};
+vtkStandardNewMacro(vtkGrowingSource);
+
+//------------------------------------------------------------------------------
+void TurnOffLogging(std::ostringstream& logStream)
+{
+  auto stream_sink = [](void* userData, const vtkLogger::Message& message)
+  {
+    std::ostream& s = *reinterpret_cast<std::ostream*>(userData);
+    s << message.preamble << message.message << std::endl;
+  };
+  vtkLogger::AddCallback("logStream", stream_sink, &logStream, vtkLogger::VERBOSITY_ERROR);
+  vtkLogger::SetStderrVerbosity(vtkLogger::VERBOSITY_OFF);
+}
+
+//------------------------------------------------------------------------------
+void TurnOnLogging()
+{
+  vtkLogger::RemoveCallback("logStream");
+  vtkLogger::SetStderrVerbosity(vtkLogger::VERBOSITY_INFO);
+}
+
+//------------------------------------------------------------------------------
+// Returns true if `do1` and `do2` are reported different, with an error logged.
+bool ReportedDifferent(vtkDataObject* do1, vtkDataObject* do2)
+{
+  std::ostringstream logStream;
+  ::TurnOffLogging(logStream);
+  const bool same = vtkTestUtilities::CompareDataObjectsExactly(do1, do2);
+  ::TurnOnLogging();
+  return !same && !logStream.str().empty();
+}
+}
+
+//------------------------------------------------------------------------------
+int TestCompareThreadedOutputs(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkPolyData> serial;
+  if (!vtkTestUtilities::CompareThreadedOutputs(sphere, 4, serial) ||
+    serial->GetNumberOfPoints() != sphere->GetOutput()->GetNumberOfPoints() ||
+    serial->GetNumberOfPolys() == 0)
+  {
+    vtkLog(ERROR, "A deterministic source should produce the same outputs.");
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("Values");
+  values->SetNumberOfValues(serial->GetNumberOfPoints());
+  values->Fill(1.0);
+  values->SetValue(0, std::numeric_limits<double>::quiet_NaN());
+  serial->GetPointData()->AddArray(values);
+  vtkNew<vtkPolyData> copy;
+  copy->DeepCopy(serial);
+  if (!vtkTestUtilities::CompareDataObjectsExactly(serial, copy))
+  {
+    vtkLog(ERROR, "Deep copies, NaN values included, should be identical.");
+    return EXIT_FAILURE;
+  }
+
+  // A value that is only slightly different.
+  auto copyValues = vtkDoubleArray::SafeDownCast(copy->GetPointData()->GetArray("Values"));
+  copyValues->SetValue(1, std::nextafter(1.0, 2.0));
+  if (!::ReportedDifferent(serial, copy))
+  {
+    vtkLog(ERROR, "Values differing by one ulp should be reported.");
+    return EXIT_FAILURE;
+  }
+  copyValues->SetValue(1, 1.0);
+
+  // The same cells in another order.
+  vtkNew<vtkCellArray> reversed;
+  for (vtkIdType cellId = serial->GetNumberOfCells() - 1; cellId >= 0; --cellId)
+  {
+    vtkNew<vtkIdList> ptIds;
+    serial->GetCellPoints(cellId, ptIds);
+    reversed->InsertNextCell(ptIds);
+  }
+  copy->SetPolys(reversed);
+  if (!::ReportedDifferent(serial, copy))
+  {
+    vtkLog(ERROR, "Reordered cells should be reported.");
+    return EXIT_FAILURE;
+  }
+
+  // Composite datasets are compared block by block.
+  vtkNew<vtkMultiBlockDataSet> blocks1;
+  blocks1->SetBlock(0, serial);
+  blocks1->SetBlock(2, serial);
+  vtkNew<vtkMultiBlockDataSet> blocks2;
+  blocks2->SetBlock(0, serial);
+  blocks2->SetBlock(2, serial);
+  if (!vtkTestUtilities::CompareDataObjectsExactly(blocks1, blocks2))
+  {
+    vtkLog(ERROR, "Identical multiblock datasets should be identical.");
+    return EXIT_FAILURE;
+  }
+  blocks2->SetBlock(2, copy);
+  if (!::ReportedDifferent(blocks1, blocks2))
+  {
+    vtkLog(ERROR, "Different blocks should be reported.");
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkGrowingSource> growing;
+  std::ostringstream logStream;
+  ::TurnOffLogging(logStream);
+  const bool same = vtkTestUtilities::CompareThreadedOutputs(growing);
+  ::TurnOnLogging();
+  if (same || logStream.str().empty())
+  {
+    vtkLog(ERROR, "An output changing between the updates should be reported.");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
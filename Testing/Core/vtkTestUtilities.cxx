@@ -5,11 +5,13 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkAbstractPointLocator.h"
+#include "vtkAlgorithm.h"
 #include "vtkArrayDispatch.h"
 #include "vtkBitArray.h"
 #include "vtkCellArray.h"
 #include "vtkCellCenters.h"
 #include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
@@ -32,6 +34,7 @@
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkQuaternion.h"
@@ -47,6 +50,7 @@
 #include "vtkUnstructuredGrid.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <numeric>
@@ -1928,4 +1932,299 @@ bool vtkTestUtilities::CompareAbstractArray(vtkAbstractArray* array1, vtkAbstrac
     toleranceFactor, ghosts, ghostsToSkip);
 }
 
+namespace
+{
+//============================================================================
+// Compares the values of 2 data arrays of the same type, NaN values being
+// equal to each other.
+struct ExactArrayWorker
+{
+  template <class ArrayT1, class ArrayT2>
+  void operator()(ArrayT1* array1, ArrayT2* array2)
+  {
+    using ValueType = vtk::GetAPIType<ArrayT1>;
+    auto range1 = vtk::DataArrayValueRange(array1);
+    auto range2 = vtk::DataArrayValueRange(array2);
+    this->Result = std::equal(range1.begin(), range1.end(), range2.begin(),
+      [](ValueType value1, ValueType value2)
+      { return value1 == value2 || (value1 != value1 && value2 != value2); });
+  }
+
+  bool Result = false;
+};
+
+//----------------------------------------------------------------------------
+bool CompareArraysExactly(vtkAbstractArray* array1, vtkAbstractArray* array2)
+{
+  if (!array1 || !array2)
+  {
+    vtkLog(ERROR, "Unexpected nullptr array pointer.");
+    return false;
+  }
+  if (array1->GetDataType() != array2->GetDataType() ||
+    array1->GetNumberOfComponents() != array2->GetNumberOfComponents() ||
+    array1->GetNumberOfTuples() != array2->GetNumberOfTuples())
+  {
+    vtkLog(ERROR,
+      "Arrays " << (array1->GetName() ? array1->GetName() : "(unnamed)")
+                << " differ in type or size: " << array1->GetNumberOfTuples() << " and "
+                << array2->GetNumberOfTuples() << " tuples.");
+    return false;
+  }
+
+  bool same = true;
+  auto dataArray1 = vtkArrayDownCast<vtkDataArray>(array1);
+  auto dataArray2 = vtkArrayDownCast<vtkDataArray>(array2);
+  if (dataArray1 && dataArray2)
+  {
+    ExactArrayWorker worker;
+    if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(dataArray1, dataArray2, worker))
+    {
+      worker(dataArray1, dataArray2);
+    }
+    same = worker.Result;
+  }
+  else
+  {
+    for (vtkIdType id = 0; same && id < array1->GetNumberOfValues(); ++id)
+    {
+      same = array1->GetVariantValue(id) == array2->GetVariantValue(id);
+    }
+  }
+  if (!same)
+  {
+    vtkLog(ERROR,
+      "Values of arrays " << (array1->GetName() ? array1->GetName() : "(unnamed)")
+                          << " differ.");
+  }
+  return same;
+}
+
+//----------------------------------------------------------------------------
+bool CompareFieldDataExactly(vtkFieldData* fd1, vtkFieldData* fd2)
+{
+  if (!fd1 || !fd2 || fd1->GetNumberOfArrays() != fd2->GetNumberOfArrays())
+  {
+    vtkLog(ERROR, "Field data have different numbers of arrays.");
+    return false;
+  }
+  for (int arrayId = 0; arrayId < fd1->GetNumberOfArrays(); ++arrayId)
+  {
+    vtkAbstractArray* array1 = fd1->GetAbstractArray(arrayId);
+    vtkAbstractArray* array2 = fd2->GetAbstractArray(arrayId);
+    const std::string name1 = array1->GetName() ? array1->GetName() : "";
+    const std::string name2 = array2->GetName() ? array2->GetName() : "";
+    if (name1 != name2)
+    {
+      vtkLog(ERROR, "Arrays " << name1 << " and " << name2 << " at index " << arrayId << ".");
+      return false;
+    }
+    if (!::CompareArraysExactly(array1, array2))
+    {
+      return false;
+    }
+  }
+  if (auto dsa1 = vtkDataSetAttributes::SafeDownCast(fd1))
+  {
+    auto dsa2 = vtkDataSetAttributes::SafeDownCast(fd2);
+    for (int attribute = 0; attribute < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attribute)
+    {
+      vtkAbstractArray* array1 = dsa1->GetAbstractAttribute(attribute);
+      vtkAbstractArray* array2 = dsa2 ? dsa2->GetAbstractAttribute(attribute) : nullptr;
+      const char* name1 = array1 ? array1->GetName() : nullptr;
+      const char* name2 = array2 ? array2->GetName() : nullptr;
+      if ((array1 == nullptr) != (array2 == nullptr) ||
+        (array1 && std::string(name1 ? name1 : "") != std::string(name2 ? name2 : "")))
+      {
+        vtkLog(ERROR,
+          "Different " << vtkDataSetAttributes::GetAttributeTypeAsString(attribute)
+                       << " attributes.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool CompareDataSetsExactly(vtkDataSet* ds1, vtkDataSet* ds2)
+{
+  if (ds1->GetNumberOfPoints() != ds2->GetNumberOfPoints() ||
+    ds1->GetNumberOfCells() != ds2->GetNumberOfCells())
+  {
+    vtkLog(ERROR,
+      "Different sizes: " << ds1->GetNumberOfPoints() << " and " << ds2->GetNumberOfPoints()
+                          << " points, " << ds1->GetNumberOfCells() << " and "
+                          << ds2->GetNumberOfCells() << " cells.");
+    return false;
+  }
+
+  auto ps1 = vtkPointSet::SafeDownCast(ds1);
+  auto ps2 = vtkPointSet::SafeDownCast(ds2);
+  if (ps1 && ps2 && ps1->GetPoints() && ps2->GetPoints())
+  {
+    if (!::CompareArraysExactly(ps1->GetPoints()->GetData(), ps2->GetPoints()->GetData()))
+    {
+      vtkLog(ERROR, "Different points.");
+      return false;
+    }
+  }
+  else
+  {
+    for (vtkIdType ptId = 0; ptId < ds1->GetNumberOfPoints(); ++ptId)
+    {
+      std::array<double, 3> p1, p2;
+      ds1->GetPoint(ptId, p1.data());
+      ds2->GetPoint(ptId, p2.data());
+      if (p1 != p2)
+      {
+        vtkLog(ERROR, "Different coordinates for point " << ptId << ".");
+        return false;
+      }
+    }
+  }
+
+  vtkNew<vtkIdList> ptIds1;
+  vtkNew<vtkIdList> ptIds2;
+  auto ug1 = vtkUnstructuredGrid::SafeDownCast(ds1);
+  auto ug2 = vtkUnstructuredGrid::SafeDownCast(ds2);
+  for (vtkIdType cellId = 0; cellId < ds1->GetNumberOfCells(); ++cellId)
+  {
+    const int cellType = ds1->GetCellType(cellId);
+    bool same = cellType == ds2->GetCellType(cellId);
+    if (same)
+    {
+      ds1->GetCellPoints(cellId, ptIds1);
+      ds2->GetCellPoints(cellId, ptIds2);
+      same = ptIds1->GetNumberOfIds() == ptIds2->GetNumberOfIds() &&
+        std::equal(ptIds1->begin(), ptIds1->end(), ptIds2->begin());
+    }
+    if (same && ug1 && ug2 && cellType == VTK_POLYHEDRON)
+    {
+      ug1->GetFaceStream(cellId, ptIds1);
+      ug2->GetFaceStream(cellId, ptIds2);
+      same = ptIds1->GetNumberOfIds() == ptIds2->GetNumberOfIds() &&
+        std::equal(ptIds1->begin(), ptIds1->end(), ptIds2->begin());
+    }
+    if (!same)
+    {
+      vtkLog(ERROR, "Different cell " << cellId << ".");
+      return false;
+    }
+  }
+
+  if (!::CompareFieldDataExactly(ds1->GetPointData(), ds2->GetPointData()))
+  {
+    vtkLog(ERROR, "Different point data.");
+    return false;
+  }
+  if (!::CompareFieldDataExactly(ds1->GetCellData(), ds2->GetCellData()))
+  {
+    vtkLog(ERROR, "Different cell data.");
+    return false;
+  }
+  return true;
+}
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+bool vtkTestUtilities::CompareDataObjectsExactly(vtkDataObject* do1, vtkDataObject* do2)
+{
+  if (!do1 || !do2)
+  {
+    vtkLog(ERROR, "Unexpected nullptr data object.");
+    return do1 == do2;
+  }
+  if (strcmp(do1->GetClassName(), do2->GetClassName()) != 0)
+  {
+    vtkLog(ERROR,
+      "Different data object types: " << do1->GetClassName() << " and " << do2->GetClassName()
+                                      << ".");
+    return false;
+  }
+  if (!::CompareFieldDataExactly(do1->GetFieldData(), do2->GetFieldData()))
+  {
+    vtkLog(ERROR, "Different field data.");
+    return false;
+  }
+
+  if (auto cds1 = vtkCompositeDataSet::SafeDownCast(do1))
+  {
+    auto cds2 = vtkCompositeDataSet::SafeDownCast(do2);
+    vtkSmartPointer<vtkCompositeDataIterator> iter1;
+    iter1.TakeReference(cds1->NewIterator());
+    iter1->SkipEmptyNodesOff();
+    vtkSmartPointer<vtkCompositeDataIterator> iter2;
+    iter2.TakeReference(cds2->NewIterator());
+    iter2->SkipEmptyNodesOff();
+    for (iter1->InitTraversal(), iter2->InitTraversal();
+         !iter1->IsDoneWithTraversal() && !iter2->IsDoneWithTraversal();
+         iter1->GoToNextItem(), iter2->GoToNextItem())
+    {
+      vtkDataObject* block1 = iter1->GetCurrentDataObject();
+      vtkDataObject* block2 = iter2->GetCurrentDataObject();
+      if (iter1->GetCurrentFlatIndex() != iter2->GetCurrentFlatIndex() ||
+        (block1 == nullptr) != (block2 == nullptr) ||
+        (block1 && !vtkTestUtilities::CompareDataObjectsExactly(block1, block2)))
+      {
+        vtkLog(ERROR, "Different blocks at flat index " << iter1->GetCurrentFlatIndex() << ".");
+        return false;
+      }
+    }
+    if (!iter1->IsDoneWithTraversal() || !iter2->IsDoneWithTraversal())
+    {
+      vtkLog(ERROR, "Different numbers of blocks.");
+      return false;
+    }
+    return true;
+  }
+
+  if (auto ds1 = vtkDataSet::SafeDownCast(do1))
+  {
+    return ::CompareDataSetsExactly(ds1, vtkDataSet::SafeDownCast(do2));
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkTestUtilities::CompareThreadedOutputs(
+  vtkAlgorithm* algorithm, int numberOfThreads, vtkDataObject* serialOutput, int port)
+{
+  std::array<vtkSmartPointer<vtkDataObject>, 2> outputs;
+  const std::array<int, 2> threads = { 1, numberOfThreads };
+  for (int run = 0; run < 2; ++run)
+  {
+    int success = 0;
+    vtkSMPTools::LocalScope(vtkSMPTools::Config{ threads[run] },
+      [&]()
+      {
+        algorithm->Modified();
+        success = algorithm->Update(port, nullptr);
+      });
+    vtkDataObject* output = algorithm->GetOutputDataObject(port);
+    if (!success || !output)
+    {
+      vtkLog(ERROR,
+        "" << algorithm->GetClassName() << " failed to update with " << threads[run]
+           << " threads.");
+      return false;
+    }
+    outputs[run].TakeReference(output->NewInstance());
+    outputs[run]->DeepCopy(output);
+  }
+
+  if (serialOutput)
+  {
+    serialOutput->DeepCopy(outputs[0]);
+  }
+  if (!vtkTestUtilities::CompareDataObjectsExactly(outputs[0], outputs[1]))
+  {
+    vtkLog(ERROR,
+      "" << algorithm->GetClassName() << " produced different outputs with 1 and "
+         << numberOfThreads << " threads.");
+    return false;
+  }
+  return true;
+}
+
 VTK_ABI_NAMESPACE_END
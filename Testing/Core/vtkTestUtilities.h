@@ -10,7 +10,9 @@
  * root directory for VTK Data, expanding a filename with this root directory.
  *
  * It also provides methods for testing whether two `vtkDataObjects`,
- * `vtkFieldData`, or `vtkAbstractArray` are equal up to numerical precision.
+ * `vtkFieldData`, or `vtkAbstractArray` are equal up to numerical precision,
+ * and whether an algorithm produces exactly the same output with one thread
+ * and with several threads.
  *
  * Near-equality is defined as follows for floating point tuples u and v represented as vectors:
  *
@@ -36,6 +38,7 @@
 VTK_ABI_NAMESPACE_BEGIN
 
 class vtkAbstractArray;
+class vtkAlgorithm;
 class vtkDataObject;
 class vtkDataSet;
 class vtkFieldData;
@@ -155,6 +158,25 @@ struct VTKTESTINGCORE_EXPORT vtkTestUtilities
   static bool CompareAbstractArray(vtkAbstractArray* array1, vtkAbstractArray* array2,
     double toleranceFactor = 1.0, vtkUnsignedCharArray* ghosts = nullptr,
     unsigned char ghostsToSkip = 0);
+
+  /**
+   * Returns true if the 2 input `vtkDataObject` are exactly identical: same types, same points,
+   * cells, field data, point data and cell data, in the same order and with the same values.
+   * Unlike `CompareDataObjects`, this function depends on the ordering of the elements and does
+   * not tolerate any numerical difference, NaN values being equal to each other. Composite
+   * datasets are compared block by block. The first difference found is logged as an error.
+   */
+  static bool CompareDataObjectsExactly(vtkDataObject* do1, vtkDataObject* do2);
+
+  /**
+   * Updates `algorithm` with a single thread, then with `numberOfThreads` threads, using
+   * `vtkSMPTools::LocalScope`, and returns true if it produced exactly the same data object on
+   * output port `port` both times, as defined by `CompareDataObjectsExactly`. The algorithm is
+   * marked as modified before each update. If `serialOutput` is not nullptr, the output produced
+   * with a single thread is deep copied into it so that its content can be checked further.
+   */
+  static bool CompareThreadedOutputs(vtkAlgorithm* algorithm, int numberOfThreads = 4,
+    vtkDataObject* serialOutput = nullptr, int port = 0);
 };
 
 inline char* vtkTestUtilities::GetDataRoot(int argc, char* argv[])